@@ -788,7 +788,7 @@ vec4 pImage(vec2 fragCoord) {
     // Glows are separated so their alpha doesn't darken adjacent zone fills
     // during blendOver compositing (the division by outA reduces fill brightness
     // wherever a prior zone's glow alpha has accumulated).
-    for (int i = 0; i < zoneCount && i < 64; i++) {
+    for (int i = 0; i < zoneCount && i < PZ_MAX_ZONES; i++) {
         vec4 rect = zoneRects[i];
         if (rect.z <= 0.0 || rect.w <= 0.0) continue;
 
@@ -800,7 +800,7 @@ vec4 pImage(vec2 fragCoord) {
     }
 
     // Pass 2: Outer glows (additive, after all fills are composited).
-    for (int i = 0; i < zoneCount && i < 64; i++) {
+    for (int i = 0; i < zoneCount && i < PZ_MAX_ZONES; i++) {
         vec4 rect = zoneRects[i];
         if (rect.z <= 0.0 || rect.w <= 0.0) continue;
 
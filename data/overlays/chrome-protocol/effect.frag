@@ -906,7 +906,7 @@ vec4 pImage(vec2 fragCoord) {
     // stops at the distance rather than shading, so the duplicate cost is a few
     // ALU ops against up to three raymarches.
     float minDist = 1e30; // distance MINUS each zone's own reach, so < 0 means "in range"
-    for (int i = 0; i < zoneCount && i < 64; i++) {
+    for (int i = 0; i < zoneCount && i < PZ_MAX_ZONES; i++) {
         // Skip degenerate rects, as every sibling pack's loop does. A zero-size
         // zone collapses zoneSdf() to a point, and the distance field around it
         // still drives the glow, so an unguarded loop paints a stray blob where
@@ -932,7 +932,7 @@ vec4 pImage(vec2 fragCoord) {
         vec3 sceneCol = renderGlobalScene(fragCoord, g);
 
         // Per-zone: gate visibility, apply vitality, draw border + glow
-        for (int i = 0; i < zoneCount && i < 64; i++) {
+        for (int i = 0; i < zoneCount && i < PZ_MAX_ZONES; i++) {
             vec4 rect = zoneRects[i];
             if (rect.z <= 0.0 || rect.w <= 0.0) continue;
             result = blendOver(result, renderZoneChrome(
@@ -856,7 +856,7 @@ vec4 pImage(vec2 fragCoord) {
     float mids    = getMidsSoft();
     float treble  = getTrebleSoft();
 
-    for (int i = 0; i < zoneCount && i < 64; i++) {
+    for (int i = 0; i < zoneCount && i < PZ_MAX_ZONES; i++) {
         vec4 rect = zoneRects[i];
         if (rect.z <= 0.0 || rect.w <= 0.0) continue;
         vec4 zoneColor = renderEosZone(fragCoord, rect, zoneFillColors[i],
@@ -337,7 +337,7 @@ vec4 pImage(vec2 fragCoord) {
 
     vec4 result = vec4(0.0);
 
-    for (int i = 0; i < zoneCount && i < 64; i++) {
+    for (int i = 0; i < zoneCount && i < PZ_MAX_ZONES; i++) {
         vec4 rect       = zoneRects[i];
         // Skip degenerate rects, as every sibling pack's loop does. A zero-size
         // zone collapses zoneSdf() to a point, and the rim glow around it still
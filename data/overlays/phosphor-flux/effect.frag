@@ -543,7 +543,7 @@ vec4 pImage(vec2 fragCoord) {
     float overall = getOverallSoft();
 
     // Pass 1: zone fills + gradient frame.
-    for (int i = 0; i < zoneCount && i < 64; i++) {
+    for (int i = 0; i < zoneCount && i < PZ_MAX_ZONES; i++) {
         vec4 rect = zoneRects[i];
         if (rect.z <= 0.0 || rect.w <= 0.0) continue;
 
@@ -555,7 +555,7 @@ vec4 pImage(vec2 fragCoord) {
     }
 
     // Pass 2: outer glows (additive, after all fills are composited).
-    for (int i = 0; i < zoneCount && i < 64; i++) {
+    for (int i = 0; i < zoneCount && i < PZ_MAX_ZONES; i++) {
         vec4 rect = zoneRects[i];
         if (rect.z <= 0.0 || rect.w <= 0.0) continue;
 
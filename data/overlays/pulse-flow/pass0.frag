@@ -46,7 +46,7 @@ float getAudioReact()     { return customParams[1].z >= 0.0 ? customParams[1].z
 // the painted corner at any scale other than 1080p.
 float zoneEdgeSDF(vec2 fragCoord) {
     float minDist = 1e6;
-    for (int i = 0; i < zoneCount && i < 64; i++) {
+    for (int i = 0; i < zoneCount && i < PZ_MAX_ZONES; i++) {
         // Skip degenerate rects, as every other zone loop does. A zero-size
         // zone collapses zoneSdf() to a point field, and this pass feeds a
         // ping-pong feedback buffer, so the phantom emission would persist and
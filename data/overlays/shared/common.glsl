@@ -7,10 +7,26 @@
 //   #include "common.glsl"   (from current shader dir if copied locally)
 //
 // Bindings 0-1: UBO and labels. Channels (2-5) in multipass.glsl.
+// Bindings 13-16: zone storage buffers (PHOSPHOR_STORAGE_BUFFERS only).
 
 #ifndef PLASMAZONES_COMMON_GLSL
 #define PLASMAZONES_COMMON_GLSL
 
+// Storage-buffer zone data. On Vulkan the render node defines
+// PHOSPHOR_STORAGE_BUFFERS in the effect fragment stage (bakes it for SPIR-V
+// only) and binds the four zone arrays as storage buffers (see ZoneShaderNodeRhi), so a
+// layout can exceed the UBO's 64 zones. The UBO block below keeps its exact
+// byte layout either way: these renames only move its four arrays out of the
+// way so the storage-buffer declarations after it can take their names, and
+// packs read zoneRects[i] etc. unchanged. Buffer passes and zone.vert are
+// built without the define and keep reading the UBO arrays.
+#ifdef PHOSPHOR_STORAGE_BUFFERS
+#define zoneRects uboZoneRects
+#define zoneFillColors uboZoneFillColors
+#define zoneBorderColors uboZoneBorderColors
+#define zoneParams uboZoneParams
+#endif
+
 layout(std140, binding = 0) uniform ZoneUniforms {
     // ── Base uniforms (PhosphorShaders::BaseUniforms, 672 bytes) ───────
     mat4 qt_Matrix;
@@ -45,6 +61,25 @@ layout(std140, binding = 0) uniform ZoneUniforms {
     float uZoneScale;
 };
 
+// Loop bound for per-zone loops: `for (int i = 0; i < zoneCount && i <
+// PZ_MAX_ZONES; i++)`. Matches PhosphorRendering::MaxZones (UBO) and
+// MaxStorageZones (storage buffers). zoneCount never exceeds it.
+#ifdef PHOSPHOR_STORAGE_BUFFERS
+#undef zoneRects
+#undef zoneFillColors
+#undef zoneBorderColors
+#undef zoneParams
+// One section of a single buffer each, in UBO order. Bindings must match
+// kZoneStorageFirstBinding in ZoneShaderCommon.h.
+layout(std430, binding = 13) readonly buffer ZoneRectStorage { vec4 zoneRects[]; };
+layout(std430, binding = 14) readonly buffer ZoneFillColorStorage { vec4 zoneFillColors[]; };
+layout(std430, binding = 15) readonly buffer ZoneBorderColorStorage { vec4 zoneBorderColors[]; };
+layout(std430, binding = 16) readonly buffer ZoneParamStorage { vec4 zoneParams[]; };
+#define PZ_MAX_ZONES 1024
+#else
+#define PZ_MAX_ZONES 64
+#endif
+
 // Per-zone context handed to a `vec4 pZone(ZoneCtx z)` entry function (T1.4).
 // When a pack defines pZone instead of main(), the harness generates the
 // dispatch loop: for each visible zone it fills one ZoneCtx and accumulates the
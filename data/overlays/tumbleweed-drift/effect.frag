@@ -954,7 +954,7 @@ vec4 pImage(vec2 fragCoord) {
     // uZoneLabels in screen space and never go through the zone SDF.
     float minDist = 1e30;
     float maxReach = zoneLen(32.0);
-    for (int i = 0; i < zoneCount && i < 64; i++) {
+    for (int i = 0; i < zoneCount && i < PZ_MAX_ZONES; i++) {
         vec4 rect = zoneRects[i];
         if (rect.z <= 0.0 || rect.w <= 0.0) continue;
         minDist = min(minDist, zoneSdf(fragCoord, rect, zoneParams[i].x).d);
@@ -967,7 +967,7 @@ vec4 pImage(vec2 fragCoord) {
         // scene plus its own border/glow/vitality treatment.
         vec3 sceneCol = renderGlobalScene(fragCoord, bassEnv, midsEnv, trebleEnv);
 
-        for (int i = 0; i < zoneCount && i < 64; i++) {
+        for (int i = 0; i < zoneCount && i < PZ_MAX_ZONES; i++) {
             vec4 rect = zoneRects[i];
             if (rect.z <= 0.0 || rect.w <= 0.0) continue;
 
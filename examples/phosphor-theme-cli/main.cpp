@@ -3,11 +3,12 @@
 //
 // phosphor-theme-cli, headless driver for PhosphorTheme.
 //
-// Wraps MatugenRunner + PaletteStore + TemplateEngine so the matugen
-// round-trip and template renderer can be exercised without launching
-// the shell. This is the Phase 1.1 example-CLI acceptance test.
+// Wraps PaletteExtractor / MatugenRunner + PaletteStore + TemplateEngine
+// so the wallpaper round-trip and template renderer can be exercised
+// without launching the shell. This is the Phase 1.1 example-CLI acceptance test.
 
 #include <PhosphorTheme/MatugenRunner.h>
+#include <PhosphorTheme/PaletteExtractor.h>
 #include <PhosphorTheme/PaletteStore.h>
 #include <PhosphorTheme/TemplateEngine.h>
 
@@ -90,20 +91,25 @@ bool writeAtomic(const QString& path, const QByteArray& data)
 int runSetWallpaper(const QStringList& args)
 {
     QCommandLineParser p;
-    p.setApplicationDescription(QStringLiteral("Run matugen on a wallpaper image"));
+    p.setApplicationDescription(QStringLiteral("Derive a palette from a wallpaper image"));
     p.addPositionalArgument(QStringLiteral("wallpaper"), QStringLiteral("Image path"));
     QCommandLineOption modeOpt({QStringLiteral("m"), QStringLiteral("mode")}, QStringLiteral("dark|light"),
                                QStringLiteral("mode"), QStringLiteral("dark"));
     QCommandLineOption preferOpt(
         QStringLiteral("prefer"),
-        QStringLiteral("matugen candidate-color preference (default 'saturation'). One of "
-                       "darkness|lightness|saturation|less-saturation|value|closest-to-fallback"),
+        QStringLiteral("candidate-color preference (default 'saturation'). One of "
+                       "darkness|lightness|saturation|less-saturation; the matugen engine also "
+                       "takes value|closest-to-fallback"),
         QStringLiteral("strategy"), QStringLiteral("saturation"));
+    QCommandLineOption engineOpt(QStringLiteral("engine"),
+                                 QStringLiteral("native (in-process, default) or matugen (external binary)"),
+                                 QStringLiteral("engine"), QStringLiteral("native"));
     QCommandLineOption applyOpt(QStringLiteral("apply"), QStringLiteral("Write the result to current.json"));
     QCommandLineOption outOpt(QStringLiteral("out"), QStringLiteral("Write the result to a specific path"),
                               QStringLiteral("path"));
     p.addOption(modeOpt);
     p.addOption(preferOpt);
+    p.addOption(engineOpt);
     p.addOption(applyOpt);
     p.addOption(outOpt);
     p.process(args);
@@ -124,39 +130,59 @@ int runSetWallpaper(const QStringList& args)
         return 2;
     }
 
-    PhosphorTheme::MatugenRunner runner;
-    runner.setMode(mode);
-    runner.setPrefer(p.value(preferOpt));
+    const auto engine = p.value(engineOpt);
+    if (engine != QLatin1String("native") && engine != QLatin1String("matugen")) {
+        std::cerr << "phosphor-theme-cli: --engine must be 'native' or 'matugen' (got '" << engine.toStdString()
+                  << "')\n";
+        return 2;
+    }
 
     int exitCode = 0;
-    QObject::connect(&runner, &PhosphorTheme::MatugenRunner::paletteReady,
-                     [&](const QVariantMap& tokens, const QString& wp) {
-                         const auto json = serialisePalette(tokens);
-                         if (p.isSet(outOpt)) {
-                             if (!writeAtomic(p.value(outOpt), json)) {
-                                 exitCode = 1;
-                             }
-                         } else if (p.isSet(applyOpt)) {
-                             if (!writeAtomic(defaultPalettePath(), json)) {
-                                 exitCode = 1;
-                             }
-                         } else {
-                             std::cout.write(json.constData(), json.size());
-                             std::cout.put('\n');
-                         }
-                         std::cerr << "phosphor-theme-cli: applied palette from " << wp.toStdString() << " ("
-                                   << tokens.size() << " tokens)\n";
-                         QCoreApplication::quit();
-                     });
-    QObject::connect(&runner, &PhosphorTheme::MatugenRunner::failed, [&](const QString& wp, const QString& reason) {
+    const auto onReady = [&](const QVariantMap& tokens, const QString& wp) {
+        const auto json = serialisePalette(tokens);
+        if (p.isSet(outOpt)) {
+            if (!writeAtomic(p.value(outOpt), json)) {
+                exitCode = 1;
+            }
+        } else if (p.isSet(applyOpt)) {
+            if (!writeAtomic(defaultPalettePath(), json)) {
+                exitCode = 1;
+            }
+        } else {
+            std::cout.write(json.constData(), json.size());
+            std::cout.put('\n');
+        }
+        std::cerr << "phosphor-theme-cli: applied palette from " << wp.toStdString() << " (" << tokens.size()
+                  << " tokens)\n";
+        QCoreApplication::quit();
+    };
+    const auto onFailed = [&](const QString& wp, const QString& reason) {
         std::cerr << "phosphor-theme-cli: failed on " << wp.toStdString() << ": " << reason.toStdString() << '\n';
         exitCode = 1;
         QCoreApplication::quit();
-    });
+    };
 
-    QTimer::singleShot(0, [&]() {
-        runner.run(wallpaper);
-    });
+    // Both engines share the mode / prefer / run surface and the signal
+    // signatures, so only the construction differs.
+    PhosphorTheme::PaletteExtractor extractor;
+    PhosphorTheme::MatugenRunner runner;
+    if (engine == QLatin1String("matugen")) {
+        runner.setMode(mode);
+        runner.setPrefer(p.value(preferOpt));
+        QObject::connect(&runner, &PhosphorTheme::MatugenRunner::paletteReady, onReady);
+        QObject::connect(&runner, &PhosphorTheme::MatugenRunner::failed, onFailed);
+        QTimer::singleShot(0, [&]() {
+            runner.run(wallpaper);
+        });
+    } else {
+        extractor.setMode(mode);
+        extractor.setPrefer(p.value(preferOpt));
+        QObject::connect(&extractor, &PhosphorTheme::PaletteExtractor::paletteReady, onReady);
+        QObject::connect(&extractor, &PhosphorTheme::PaletteExtractor::failed, onFailed);
+        QTimer::singleShot(0, [&]() {
+            extractor.run(wallpaper);
+        });
+    }
     QCoreApplication::exec();
     return exitCode;
 }
@@ -350,7 +376,7 @@ void printUsage()
     std::cerr << "phosphor-theme-cli, drive the PhosphorTheme library headlessly.\n\n"
               << "USAGE\n"
               << "  phosphor-theme-cli set-wallpaper <image> [--mode dark|light] [--prefer <strategy>] "
-                 "[--apply | --out <path>]\n"
+                 "[--engine native|matugen] [--apply | --out <path>]\n"
               << "  phosphor-theme-cli dump [--source <palette.json>]\n"
               << "  phosphor-theme-cli render-template <template> <out> [--palette <palette.json>]\n"
               << "  phosphor-theme-cli cycle <dir> [--interval ms] [--once] [--apply | --out <path>]\n\n"
@@ -367,9 +393,10 @@ void printUsage()
 
 int main(int argc, char* argv[])
 {
-    // MatugenRunner uses QProcess. QCoreApplication is enough for that
-    // and for QColor parsing; QGuiApplication isn't needed here since
-    // there's no UI thread.
+    // MatugenRunner uses QProcess and PaletteExtractor decodes through
+    // QImageReader. QCoreApplication is enough for both and for QColor
+    // parsing; QGuiApplication isn't needed here since there's no UI
+    // thread.
     QCoreApplication app(argc, argv);
     QCoreApplication::setOrganizationName(QStringLiteral("Phosphor"));
     QCoreApplication::setApplicationName(QStringLiteral("phosphor"));
@@ -20,11 +20,15 @@
 #include <opengl/glframebuffer.h>
 #include <opengl/gltexture.h>
 
+#include <cerrno>
 #include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <unistd.h>
 
 #include <QByteArray>
 #include <QDBusConnection>
+#include <QDBusError>
 #include <QDBusMessage>
 #include <QDBusPendingCall>
 #include <QDBusPendingCallWatcher>
@@ -361,6 +365,10 @@ void SnapAssistThumbnailCapture::attemptCapture(Pending p, int delayMs, int retr
 
 void SnapAssistThumbnailCapture::postThumbnail(const QUuid& internalId, const QImage& image)
 {
+    if (m_memfdEnabled && postThumbnailMemfd(internalId, image)) {
+        return;
+    }
+
     // Image is already Format_ARGB32 by the caller. Pack tight (no row
     // padding) so the daemon can reconstruct via QImage(uchar*, w, h,
     // bytesPerLine=w*4, Format_ARGB32) without having to communicate the
@@ -429,6 +437,87 @@ void SnapAssistThumbnailCapture::postThumbnail(const QUuid& internalId, const QI
                      });
 }
 
+bool SnapAssistThumbnailCapture::postThumbnailMemfd(const QUuid& internalId, const QImage& image)
+{
+    // Write the pixels once, at the image's own stride, into an anonymous
+    // memfd and ship only the fd: no QByteArray staging copy here, no
+    // marshalled byte array on the bus, and the daemon wraps the mapping
+    // instead of copying it into a QImage. The seals make the contents
+    // immutable so the daemon can keep referencing the pages for as long as
+    // its LRU holds the thumbnail, which is also why each thumbnail gets a
+    // fresh memfd rather than a slot in a reusable ring.
+    const int width = image.width();
+    const int height = image.height();
+    const int stride = int(image.bytesPerLine());
+    const size_t length = size_t(stride) * size_t(height);
+
+    const int fd = ::memfd_create("plasmazones-thumbnail", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) {
+        qCInfo(lcSnapAssistCapture) << "memfd_create failed:" << strerror(errno)
+                                    << "— posting snap-assist thumbnails as byte arrays for this session";
+        m_memfdEnabled = false;
+        return false;
+    }
+    bool ok = ::ftruncate(fd, off_t(length)) == 0;
+    const auto* src = reinterpret_cast<const char*>(image.constBits());
+    for (size_t written = 0; ok && written < length;) {
+        const ssize_t n = ::pwrite(fd, src + written, length - written, off_t(written));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        ok = n > 0;
+        written += ok ? size_t(n) : 0;
+    }
+    ok = ok && ::fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) == 0;
+    if (!ok) {
+        qCInfo(lcSnapAssistCapture) << "writing/sealing thumbnail memfd failed:" << strerror(errno)
+                                    << "— posting snap-assist thumbnails as byte arrays for this session";
+        ::close(fd);
+        m_memfdEnabled = false;
+        return false;
+    }
+
+    const QString compositorHandle = internalId.toString();
+    QDBusMessage msg = QDBusMessage::createMethodCall(
+        PhosphorProtocol::Service::Name, PhosphorProtocol::Service::ObjectPath,
+        PhosphorProtocol::Service::Interface::Overlay, QStringLiteral("setSnapAssistThumbnailMemfd"));
+    // QDBusUnixFileDescriptor dup()s the fd; close ours once the call is queued.
+    msg << compositorHandle << width << height << stride << QVariant::fromValue(QDBusUnixFileDescriptor(fd));
+    QDBusPendingCall pending =
+        QDBusConnection::sessionBus().asyncCall(msg, PhosphorProtocol::Service::SnapAssistThumbnailPostTimeoutMs);
+    ::close(fd);
+
+    auto* watcher = new QDBusPendingCallWatcher(pending, this);
+    // Same accepted-gated recently-posted contract as the byte-array path.
+    // A daemon predating the memfd method answers UnknownMethod: switch the
+    // session to byte arrays and re-post this image (implicitly shared, so
+    // holding it in the capture is cheap) rather than losing the thumbnail.
+    QObject::connect(watcher, &QDBusPendingCallWatcher::finished, this,
+                     [this, internalId, image, compositorHandle](QDBusPendingCallWatcher* w) {
+                         w->deleteLater();
+                         QDBusPendingReply<bool> reply = *w;
+                         if (reply.isError()) {
+                             if (reply.error().type() == QDBusError::UnknownMethod && m_memfdEnabled) {
+                                 qCInfo(lcSnapAssistCapture) << "daemon lacks setSnapAssistThumbnailMemfd — posting "
+                                                                "snap-assist thumbnails as byte arrays";
+                                 m_memfdEnabled = false;
+                                 postThumbnail(internalId, image);
+                                 return;
+                             }
+                             qCDebug(lcSnapAssistCapture) << "setSnapAssistThumbnailMemfd D-Bus call failed for"
+                                                          << compositorHandle << ":" << reply.error().message();
+                             return;
+                         }
+                         if (!reply.value()) {
+                             qCDebug(lcSnapAssistCapture) << "setSnapAssistThumbnailMemfd rejected by daemon for"
+                                                          << compositorHandle;
+                             return;
+                         }
+                         markRecentlyPosted(internalId);
+                     });
+    return true;
+}
+
 SnapAssistThumbnailCapture::DmabufExport
 SnapAssistThumbnailCapture::exportTextureToDmabuf(KWin::GLTexture* texture) const
 {
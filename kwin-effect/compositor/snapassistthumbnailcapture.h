@@ -43,11 +43,14 @@ namespace PlasmaZones {
  * Captures run sequentially, one render+readback at a time, mirroring the
  * throttling the daemon's previous ScreenShot2 path needed (concurrent
  * CaptureWindow calls could starve KWin's screenshot queue). Each completed
- * image is posted back to the daemon via
- * @c org.plasmazones.Overlay.setSnapAssistThumbnail as raw ARGB32
- * (non-premultiplied) bytes plus dimensions — no PNG encode, no base64. The
- * daemon validates the buffer shape and copies the bytes into a QImage that
- * lands in its bounded LRU cache.
+ * image is written into a sealed memfd and posted back to the daemon via
+ * @c org.plasmazones.Overlay.setSnapAssistThumbnailMemfd as raw ARGB32
+ * (non-premultiplied) pixels plus dimensions and stride — no PNG encode, no
+ * base64, no byte array on the bus. The daemon validates the seals and shape
+ * and maps the pages read-only straight into the QImage that lands in its
+ * bounded LRU cache. If memfds are unavailable, or the daemon predates the
+ * method, the session falls back to @c setSnapAssistThumbnail, which carries
+ * the same pixels as an inline byte array the daemon copies.
  *
  * An opt-in zero-copy GPU path (@c PLASMAZONES_DMABUF_THUMBNAILS) exports the
  * rendered FBO texture as a single-plane dma-buf and ships the fd via
@@ -154,6 +157,10 @@ private:
     KWin::GLTexture* renderWindowToPooledTexture(KWin::EffectWindow* w, QSize box);
 
     void postThumbnail(const QUuid& internalId, const QImage& image);
+    /// Shared-memory leg of @ref postThumbnail. Returns false (and clears
+    /// @ref m_memfdEnabled) if the memfd couldn't be created, filled or
+    /// sealed, in which case the caller posts the byte array instead.
+    bool postThumbnailMemfd(const QUuid& internalId, const QImage& image);
     void postThumbnailDmabuf(const Pending& p, const DmabufExport& exported);
 
     /// Record a dma-buf capture failure (export failure or daemon import
@@ -227,6 +234,11 @@ private:
                   "RecentPostedCapacity must be positive — the eviction loop in markRecentlyPosted "
                   "assumes the just-inserted handle survives the capacity check.");
 
+    /// Pixel thumbnails go through a sealed memfd (@ref postThumbnailMemfd)
+    /// until that fails locally or the daemon turns out not to know
+    /// setSnapAssistThumbnailMemfd; then the session posts byte arrays.
+    bool m_memfdEnabled = true;
+
     /// Opt-in zero-copy GPU path (PLASMAZONES_DMABUF_THUMBNAILS). When set,
     /// each capture renders into a pooled FBO texture, exports it as a dma-buf
     /// and posts via setWindowThumbnailDmabuf instead of the raw-ARGB32
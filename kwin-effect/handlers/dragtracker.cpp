@@ -79,8 +79,10 @@ void DragTracker::updateCursorPosition(const QPointF& cursorPos)
     // device rate (often 1000Hz on gaming mice); sending a D-Bus call for
     // every pixel of movement would add ~10-50μs of message serialization
     // per event on the compositor thread — far more than needed for zone
-    // detection which has no perceptible benefit above 30fps.
-    if (m_dragMovedThrottle.elapsed() >= 32) {
+    // detection which has no perceptible benefit above 30fps. With the
+    // shared-memory drag channel attached the interval is 0: every sample
+    // goes into the ring and the daemon reads the newest once per frame.
+    if (m_dragMovedThrottle.elapsed() >= m_throttleIntervalMs) {
         m_dragMovedThrottle.start();
         Q_EMIT dragMoved(m_draggedWindowId, cursorPos);
     }
@@ -60,7 +60,7 @@ public:
     void handleWindowFinishMoveResize(KWin::EffectWindow* w);
 
     // Event-driven cursor position update during drag. Called from slotMouseChanged.
-    // Throttled to ~30Hz internally to avoid D-Bus flooding.
+    // Throttled to ~30Hz internally to avoid D-Bus flooding (see setThrottleInterval).
     void updateCursorPosition(const QPointF& cursorPos);
 
     // Force-end drag when a relevant mouse button is released.
@@ -75,6 +75,19 @@ public:
     // Reset state (e.g., when effect is reconfigured)
     void reset();
 
+    // Minimum interval between dragMoved emissions. The D-Bus path keeps the
+    // ~30Hz default; the shared-memory drag channel drops it to 0 because a
+    // publish is a few atomic stores and the daemon paces its own reads.
+    static constexpr int DefaultThrottleIntervalMs = 32;
+    void setThrottleInterval(int ms)
+    {
+        m_throttleIntervalMs = qMax(0, ms);
+    }
+    int throttleInterval() const
+    {
+        return m_throttleIntervalMs;
+    }
+
 Q_SIGNALS:
     void dragStarted(KWin::EffectWindow* window, const QString& windowId, const QRectF& geometry);
     void dragMoved(const QString& windowId, const QPointF& cursorPos);
@@ -94,6 +107,7 @@ private:
     // Throttle event-driven dragMoved signals to ~30Hz (32ms intervals).
     // Without throttling, 1000Hz mouse input would flood D-Bus.
     QElapsedTimer m_dragMovedThrottle;
+    int m_throttleIntervalMs = DefaultThrottleIntervalMs;
 };
 
 } // namespace PlasmaZones
@@ -4,6 +4,7 @@
 #include "plasmazoneseffect.h"
 
 #include "autotilehandler/autotilehandler.h"
+#include "handlers/dragtracker.h"
 #include "handlers/navigationhandler.h"
 #include "handlers/screenchangehandler.h"
 #include "handlers/snapassisthandler.h"
@@ -32,6 +33,7 @@
 #include <QDBusPendingCall>
 #include <QDBusPendingCallWatcher>
 #include <QDBusPendingReply>
+#include <QDBusUnixFileDescriptor>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QLoggingCategory>
@@ -133,6 +135,9 @@ void PlasmaZonesEffect::continueDaemonReadySetup()
     // All D-Bus calls use QDBusMessage::createMethodCall + asyncCall (no QDBusInterface)
     // to avoid synchronous D-Bus introspection that blocks the compositor thread.
 
+    attachDragChannel();
+    fetchZoneHitSnapshots();
+
     // Re-push metadata for every live window. KWin's class/desktop/caption
     // change signals fired during session restore are swallowed by
     // pushWindowMetadata's m_daemonGate.serviceRegistered gate, so the daemon's
@@ -334,6 +339,55 @@ void PlasmaZonesEffect::continueDaemonReadySetup()
     // once all async D-Bus replies have arrived.
 }
 
+void PlasmaZonesEffect::attachDragChannel()
+{
+    dropDragChannelAttachment();
+    if (!qEnvironmentVariableIsSet("PLASMAZONES_DRAG_SHM")) {
+        return;
+    }
+    if (!m_dragChannel) {
+        m_dragChannel = PhosphorProtocol::DragSampleChannel::create();
+        if (!m_dragChannel) {
+            qCWarning(lcEffect) << "PLASMAZONES_DRAG_SHM set but the drag channel could not be created — "
+                                   "staying on updateDragCursor";
+            return;
+        }
+    }
+
+    QDBusMessage msg = QDBusMessage::createMethodCall(
+        PhosphorProtocol::Service::Name, PhosphorProtocol::Service::ObjectPath,
+        PhosphorProtocol::Service::Interface::WindowDrag, QStringLiteral("attachDragChannel"));
+    msg << QVariant::fromValue(QDBusUnixFileDescriptor(m_dragChannel->memFd()))
+        << QVariant::fromValue(QDBusUnixFileDescriptor(m_dragChannel->doorbellFd()));
+
+    auto* watcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(msg), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher* w) {
+        w->deleteLater();
+        QDBusPendingReply<bool> reply = *w;
+        if (reply.isError() || !reply.value()) {
+            // Older daemon without the method, or fds rejected: D-Bus path.
+            qCInfo(lcEffect) << "Drag channel not attached:"
+                             << (reply.isError() ? reply.error().message() : QStringLiteral("rejected by daemon"));
+            return;
+        }
+        // The daemon may have gone away while the call was in flight.
+        if (!m_daemonGate.serviceRegistered || !m_dragChannel) {
+            return;
+        }
+        m_dragChannelAttached = true;
+        m_dragTracker->setThrottleInterval(0);
+        qCInfo(lcEffect) << "Drag channel attached — drag samples bypass updateDragCursor";
+    });
+}
+
+void PlasmaZonesEffect::dropDragChannelAttachment()
+{
+    m_dragChannelAttached = false;
+    if (m_dragTracker) {
+        m_dragTracker->setThrottleInterval(DragTracker::DefaultThrottleIntervalMs);
+    }
+}
+
 void PlasmaZonesEffect::processDaemonReadyWindowState()
 {
     if (m_daemonGate.readyWindowStateProcessed) {
@@ -732,6 +786,15 @@ void PlasmaZonesEffect::connectNavigationSignals()
                                           QStringLiteral("snapAssistReady"), m_snapHandler.get(),
                                           SLOT(slotSnapAssistReady(QString, QString, PhosphorProtocol::EmptyZoneList)));
 
+    // WindowDrag: per-screen zone-hit snapshots for the local drag-sample
+    // filter. Seeded at bringup by fetchZoneHitSnapshots; these broadcasts
+    // carry every later compute. A missed subscription only costs the filter:
+    // samples on screens without a snapshot are always forwarded.
+    QDBusConnection::sessionBus().connect(PhosphorProtocol::Service::Name, PhosphorProtocol::Service::ObjectPath,
+                                          PhosphorProtocol::Service::Interface::WindowDrag,
+                                          QStringLiteral("zoneHitSnapshotChanged"), this,
+                                          SLOT(slotZoneHitSnapshotChanged(PhosphorProtocol::ZoneHitSnapshot)));
+
     // LayoutRegistry: a screen's resolved active layout moved. Subscribed here
     // (once, from the constructor) rather than in the daemon-ready setup, so it
     // needs no re-subscribe gate — the bringup pairs it with a bulk
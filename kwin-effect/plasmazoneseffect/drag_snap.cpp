@@ -663,6 +663,10 @@ void PlasmaZonesEffect::slotDragPolicyChanged(const QString& windowId, const Pho
         return;
     }
 
+    // The sample filter's last key was taken under the old policy; make the
+    // next sample reach the daemon whatever it hits.
+    m_dragSampleFilter.resetKey();
+
     const PhosphorProtocol::DragBypassReason oldReason = m_currentDragPolicy.bypassReason;
     const PhosphorProtocol::DragBypassReason newReason = newPolicy.bypassReason;
     if (oldReason == newReason) {
@@ -728,4 +732,105 @@ void PlasmaZonesEffect::slotDragPolicyChanged(const QString& windowId, const Pho
     // endDrag for disabled paths.
 }
 
+void PlasmaZonesEffect::fetchZoneHitSnapshots()
+{
+    if (!isDaemonReady("fetch zone-hit snapshots")) {
+        return;
+    }
+    auto* watcher = new QDBusPendingCallWatcher(
+        PhosphorProtocol::ClientHelpers::asyncCall(PhosphorProtocol::Service::Interface::WindowDrag,
+                                                   QStringLiteral("getZoneHitSnapshots")),
+        this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher* w) {
+        w->deleteLater();
+        const QDBusPendingReply<PhosphorProtocol::ZoneHitSnapshotList> reply = *w;
+        if (!reply.isValid()) {
+            // Older daemon without the method: no snapshots, every sample is
+            // forwarded exactly as before.
+            qCDebug(lcEffect) << "getZoneHitSnapshots failed:" << reply.error().message();
+            return;
+        }
+        // Wholesale replace, except where a zoneHitSnapshotChanged broadcast
+        // that raced ahead of this reply already delivered a newer generation.
+        QHash<QString, PhosphorProtocol::ZoneHitSnapshot> fresh;
+        for (const PhosphorProtocol::ZoneHitSnapshot& snapshot : reply.value()) {
+            if (!snapshot.screenId.isEmpty()) {
+                fresh.insert(snapshot.screenId, snapshot);
+            }
+        }
+        for (auto it = m_dragSampleFilter.snapshots.cbegin(); it != m_dragSampleFilter.snapshots.cend(); ++it) {
+            const auto existing = fresh.constFind(it.key());
+            if (existing == fresh.cend() || existing->generation < it->generation) {
+                fresh.insert(it.key(), it.value());
+            }
+        }
+        m_dragSampleFilter.snapshots = std::move(fresh);
+        m_dragSampleFilter.resetKey();
+    });
+}
+
+void PlasmaZonesEffect::slotZoneHitSnapshotChanged(const PhosphorProtocol::ZoneHitSnapshot& snapshot)
+{
+    if (snapshot.screenId.isEmpty()) {
+        return;
+    }
+    // Same generation is accepted: a layout switch republishes the current
+    // snapshot with tracksCursor forced on until the recompute lands.
+    const auto existing = m_dragSampleFilter.snapshots.constFind(snapshot.screenId);
+    if (existing != m_dragSampleFilter.snapshots.cend() && existing->generation > snapshot.generation) {
+        return;
+    }
+    m_dragSampleFilter.snapshots.insert(snapshot.screenId, snapshot);
+    m_dragSampleFilter.resetKey();
+}
+
+bool PlasmaZonesEffect::shouldForwardDragSample(const QPointF& cursorPos)
+{
+    // Pixels of disagreement tolerated between the published integer rects and
+    // the daemon's float geometry / screen resolution before a sample counts
+    // as ambiguous.
+    constexpr int Slack = 2;
+
+    DragSampleFilterState& filter = m_dragSampleFilter;
+    const QPoint point(qRound(cursorPos.x()), qRound(cursorPos.y()));
+
+    // Exactly one screen may claim the cursor, with a margin: near a screen
+    // seam (or where a stale snapshot overlaps a live one) the daemon's own
+    // screen resolution decides, so the sample goes through.
+    const PhosphorProtocol::ZoneHitSnapshot* snapshot = nullptr;
+    for (const PhosphorProtocol::ZoneHitSnapshot& candidate : std::as_const(filter.snapshots)) {
+        if (!candidate.screenGeometry.toRect().adjusted(-Slack, -Slack, Slack, Slack).contains(point)) {
+            continue;
+        }
+        if (snapshot) {
+            snapshot = nullptr;
+            break;
+        }
+        snapshot = &candidate;
+    }
+
+    PhosphorProtocol::ZoneHitKey hit;
+    const bool stable = snapshot && !snapshot->tracksCursor
+        && snapshot->screenGeometry.toRect().adjusted(Slack, Slack, -Slack, -Slack).contains(point)
+        && snapshot->stableHitAt(point, Slack, hit);
+    if (!stable) {
+        filter.resetKey();
+        return true;
+    }
+
+    const int modifiers = static_cast<int>(m_currentModifiers);
+    const int mouseButtons = static_cast<int>(m_currentMouseButtons);
+    if (filter.keyValid && filter.screenId == snapshot->screenId && filter.generation == snapshot->generation
+        && filter.modifiers == modifiers && filter.mouseButtons == mouseButtons && filter.hit == hit) {
+        return false;
+    }
+    filter.keyValid = true;
+    filter.screenId = snapshot->screenId;
+    filter.generation = snapshot->generation;
+    filter.hit = std::move(hit);
+    filter.modifiers = modifiers;
+    filter.mouseButtons = mouseButtons;
+    return true;
+}
+
 } // namespace PlasmaZones
@@ -12,6 +12,7 @@
 /// resolves here via ordinary namespace lookup. Included by plasmazoneseffect.h.
 
 #include <PhosphorCompositor/DecorationDefaults.h> // WindowAppearanceScope
+#include <PhosphorProtocol/DragTypes.h> // ZoneHitSnapshot
 
 #include <QColor>
 #include <QHash>
@@ -162,6 +163,34 @@ struct DragActivationState
     bool startedFloating = false;
 };
 
+/// Local drag-sample filter state; see PlasmaZonesEffect::shouldForwardDragSample.
+/// The daemon publishes a ZoneHitSnapshot per screen once per layout compute;
+/// the dragMoved path hit-tests each sample against it and skips the
+/// updateDragCursor round trip when the outcome matches the last sample it did
+/// forward. Cleared on daemon loss; the key is reset at every drag start.
+struct DragSampleFilterState
+{
+    /// Latest snapshot per effective screen id (virtual-screen ids included).
+    QHash<QString, PhosphorProtocol::ZoneHitSnapshot> snapshots;
+
+    /// Outcome of the last sample actually sent to the daemon. Only valid
+    /// when that sample's hit was stable — an ambiguous sample leaves
+    /// keyValid false so the next one is forwarded too.
+    bool keyValid = false;
+    QString screenId;
+    quint64 generation = 0;
+    PhosphorProtocol::ZoneHitKey hit;
+    int modifiers = 0;
+    int mouseButtons = 0;
+
+    void resetKey()
+    {
+        keyValid = false;
+        screenId.clear();
+        hit = {};
+    }
+};
+
 /// Daemon readiness / virtual-screen fetch gate state. Grouped from
 /// PlasmaZonesEffect's trailing member block; see PlasmaZonesEffect::m_daemonGate.
 /// Cached daemon D-Bus service registration state, updated via QDBusServiceWatcher
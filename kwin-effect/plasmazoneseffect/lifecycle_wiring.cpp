@@ -307,6 +307,7 @@ void PlasmaZonesEffect::connectDragTracker()
             // already floating is just being moved and must keep its current
             // user-chosen size, not snap back to the stale pre-autotile rect.
             m_dragActivation.startedFloating = isWindowFloating(windowId);
+            m_dragSampleFilter.resetKey();
 
             // Note: `cursor.drag` is intentionally NOT wired here. The
             // OffscreenEffect pipeline operates on window content; firing
@@ -480,17 +481,33 @@ void PlasmaZonesEffect::connectDragTracker()
             if (!bypassed) {
                 // Gate D-Bus calls on activation trigger state so a drag
                 // without any intent to use zones doesn't flood the bus
-                // at 30Hz. This is a local input-event optimization; it
-                // isn't policy and doesn't come from the daemon.
+                // at 30Hz (or the drag channel at input rate). This is a
+                // local input-event optimization; it isn't policy and
+                // doesn't come from the daemon.
                 if (!detectActivationAndGrab() && !m_cachedZoneSelectorEnabled && m_triggersLoaded) {
                     return;
                 }
+                // Skip samples that land in the same zones as the last one
+                // forwarded (hit-tested against the daemon's published
+                // snapshot). The zone selector reacts to raw edge proximity,
+                // so it keeps every sample.
+                if (!m_cachedZoneSelectorEnabled && !shouldForwardDragSample(cursorPos)) {
+                    return;
+                }
             }
 
             // Forward the cursor to the daemon. For snap drags, this
             // drives overlay/zone detection. For bypass drags, the
             // daemon watches the cursor for a cross-VS flip and emits
             // dragPolicyChanged when the policy changes.
+            //
+            // With the shared-memory drag channel attached, the sample
+            // goes into the ring instead; the daemon reads the newest one
+            // per frame and runs the same updateDragCursor logic on it.
+            if (m_dragChannelAttached) {
+                publishDragChannelSample(cursorPos);
+                return;
+            }
             PhosphorProtocol::ClientHelpers::fireAndForget(
                 this, PhosphorProtocol::Service::Interface::WindowDrag, QStringLiteral("updateDragCursor"),
                 {windowId, qRound(cursorPos.x()), qRound(cursorPos.y()), static_cast<int>(m_currentModifiers),
@@ -982,6 +999,11 @@ void PlasmaZonesEffect::connectDaemonSubscriptions()
     connect(serviceWatcher, &QDBusServiceWatcher::serviceUnregistered, this, [this]() {
         qCInfo(lcEffect) << "Daemon service unregistered";
         m_daemonGate.serviceRegistered = false;
+        dropDragChannelAttachment();
+        // Snapshots describe the old daemon's computes; a restarted one
+        // starts its generations over.
+        m_dragSampleFilter.snapshots.clear();
+        m_dragSampleFilter.resetKey();
         // Release the idle latch. m_sessionIdle is daemon-pushed state whose ONLY
         // route back to false is a sessionIdleChanged(false) broadcast — and a
         // restarted daemon arms a fresh ext-idle-notify-v1 notification on a seat
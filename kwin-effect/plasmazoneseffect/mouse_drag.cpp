@@ -85,7 +85,14 @@ void PlasmaZonesEffect::slotMouseChanged(const QPointF& pos, const QPointF& oldp
                 || m_dragBypassedForAutotile;
             const bool shouldForward =
                 bypassed || detectActivationAndGrab() || m_cachedZoneSelectorEnabled || !m_triggersLoaded;
-            if (shouldForward) {
+            if (shouldForward && m_dragChannelAttached) {
+                // With the drag channel attached the change rides the ring
+                // like any other sample. A D-Bus call here would race the
+                // ring: the daemon would apply it at once and then apply the
+                // older ring sample a frame later, reverting the modifiers
+                // and seeing a second trigger edge.
+                publishDragChannelSample(pos);
+            } else if (shouldForward) {
                 PhosphorProtocol::ClientHelpers::fireAndForget(
                     this, PhosphorProtocol::Service::Interface::WindowDrag, QStringLiteral("updateDragCursor"),
                     {m_dragTracker->draggedWindowId(), qRound(pos.x()), qRound(pos.y()),
@@ -137,6 +144,17 @@ void PlasmaZonesEffect::slotMouseChanged(const QPointF& pos, const QPointF& oldp
     }
 }
 
+void PlasmaZonesEffect::publishDragChannelSample(const QPointF& cursorPos)
+{
+    PhosphorProtocol::DragSample sample;
+    sample.cursorX = qRound(cursorPos.x());
+    sample.cursorY = qRound(cursorPos.y());
+    sample.modifiers = static_cast<int>(m_currentModifiers);
+    sample.mouseButtons = static_cast<int>(m_currentMouseButtons);
+    sample.timestampNs = PhosphorProtocol::DragSampleChannel::monotonicNowNs();
+    m_dragChannel->publish(sample);
+}
+
 void PlasmaZonesEffect::applyStaggeredOrImmediate(int count, const std::function<void(int)>& applyFn,
                                                   const std::function<void()>& onComplete)
 {
@@ -18,6 +18,7 @@
 #include <PhosphorCompositor/ICompositorBridge.h>
 #include <PhosphorEngine/EngineTypes.h>
 #include <PhosphorProtocol/DragMarshalling.h>
+#include <PhosphorProtocol/DragSampleChannel.h>
 #include <PhosphorProtocol/WindowMarshalling.h>
 #include <PhosphorCompositor/TriggerParser.h>
 
@@ -251,6 +252,10 @@ private Q_SLOTS:
     // canceling snap overlay, etc.
     void slotDragPolicyChanged(const QString& windowId, const PhosphorProtocol::DragPolicy& newPolicy);
 
+    // Daemon republished a screen's zone-hit snapshot (layout compute landed,
+    // or a layout switch invalidated the previous one).
+    void slotZoneHitSnapshotChanged(const PhosphorProtocol::ZoneHitSnapshot& snapshot);
+
     // Daemon-driven batch operations (rotate, resnap, vs_reconfigure arrive
     // over the wire; the effect-local snap_all path calls this slot directly)
     void slotApplyGeometriesBatch(const PhosphorProtocol::WindowGeometryList& geometries, const QString& action);
@@ -274,6 +279,26 @@ private:
     /// so none of the state-pushing D-Bus calls can fire against a daemon
     /// that rejected the bridge handshake.
     void continueDaemonReadySetup();
+    /// Offer the shared-memory drag channel to the daemon (opt-in via
+    /// PLASMAZONES_DRAG_SHM). Once the daemon accepts it, the dragMoved path
+    /// publishes into the ring instead of calling updateDragCursor.
+    void attachDragChannel();
+    /// Fall back to updateDragCursor until the next successful attach.
+    void dropDragChannelAttachment();
+    /// Publish the cursor at @p cursorPos, with the current modifiers and
+    /// buttons, into the attached drag channel. Callers check
+    /// m_dragChannelAttached first.
+    void publishDragChannelSample(const QPointF& cursorPos);
+    /// Seed m_dragSampleFilter from WindowDrag.getZoneHitSnapshots; the
+    /// zoneHitSnapshotChanged broadcasts carry updates from there.
+    void fetchZoneHitSnapshots();
+    /// Whether a snap-path drag sample at @p cursorPos could change the
+    /// daemon's zone pick. False only when the cursor's screen has a
+    /// snapshot, the daemon does not track the raw cursor there, the hit is
+    /// unambiguous, and it matches the last forwarded sample (same screen,
+    /// generation, zones, modifiers and buttons). Updates the forwarded key
+    /// when it returns true.
+    bool shouldForwardDragSample(const QPointF& cursorPos);
 
 public:
     /**
@@ -1905,6 +1930,14 @@ private:
     void warmUserTextureAsync(const QString& absolutePath);
 
     std::unique_ptr<DragTracker> m_dragTracker;
+    // Shared-memory drag channel. Created once per effect instance and
+    // re-offered to every daemon that registers; only published into while
+    // the current daemon has accepted it (m_dragChannelAttached).
+    std::unique_ptr<PhosphorProtocol::DragSampleChannel> m_dragChannel;
+    bool m_dragChannelAttached = false;
+    // Zone-hit snapshots and the last forwarded drag-sample outcome. Fields +
+    // rationale in effect_state.h (DragSampleFilterState).
+    DragSampleFilterState m_dragSampleFilter;
     std::unique_ptr<ICompositorBridge> m_compositorBridge;
     std::unique_ptr<DecorationManager> m_decorationManager;
 
@@ -307,7 +307,7 @@ inline qreal easeProgress(const PhosphorAnimation::Curve* curve, PhosphorAnimati
         return linear;
     }
     if (!curve->isStateful()) {
-        return clampProgressForCurve(curve->evaluate(linear), curve);
+        return clampProgressForCurve(curve->sample(linear), curve);
     }
     if (stepCurve) {
         const qreal dt = lastPaintTimeMs < 0
@@ -491,7 +491,7 @@ void DesktopTransitionManager::beginPeek(bool showing, const QString& effectId,
                     // there. Velocity starts at rest: a stateless leg carries
                     // no momentum to hand over.
                     const qreal oldEased = old.progressCurve
-                        ? ShaderInternal::clampProgressForCurve(old.progressCurve->evaluate(displacedProgress),
+                        ? ShaderInternal::clampProgressForCurve(old.progressCurve->sample(displacedProgress),
                                                                 old.progressCurve.get())
                         : displacedProgress;
                     tr.progressCurveState.value = 1.0 - oldEased;
@@ -352,7 +352,7 @@ public:
                 complete = true;
             } else {
                 const qreal t = elapsedMs / durationMs;
-                m_state.value = curve->evaluate(t);
+                m_state.value = curve->sample(t);
             }
         }
 
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <PhosphorAnimation/AnimationLimits.h>
+#include <PhosphorAnimation/CurveLut.h>
 #include <PhosphorAnimation/phosphoranimation_export.h>
 
 #include <QString>
@@ -41,6 +42,9 @@ struct PHOSPHORANIMATION_EXPORT CurveState
 ///
 /// Thread-safe: all const methods callable from any thread. step() mutates
 /// only the caller-owned CurveState.
+///
+/// Curves handed out by CurveRegistry may carry a sampled CurveLut; per-frame
+/// consumers call sample() rather than evaluate() to use it.
 class PHOSPHORANIMATION_EXPORT Curve
 {
 public:
@@ -98,14 +102,57 @@ public:
     /// rounded); subclasses with precise floats should override.
     virtual bool equals(const Curve& other) const;
 
+    /// evaluate(), read from the attached lookup table when there is one and
+    /// @p t is inside [0,1]; the analytic evaluate() otherwise. Agrees with
+    /// evaluate() to within CurveLut::MaxError. Non-virtual so the per-frame
+    /// path skips the dispatch as well as the solve.
+    qreal sample(qreal t) const
+    {
+        if (m_lut && t >= 0.0 && t <= 1.0) {
+            return m_lut->evaluate(t);
+        }
+        return evaluate(t);
+    }
+
+    /// sample() for @p count values of @p t into @p out (non-overlapping).
+    void sampleBatch(const qreal* t, qreal* out, qsizetype count) const;
+
+    /// The attached lookup table, or null. Set by CurveRegistry on curves it
+    /// creates; a stateful curve never has one.
+    const CurveLut* lut() const
+    {
+        return m_lut.get();
+    }
+
 protected:
     // Protected copy/move prevents slicing outside the hierarchy while
     // allowing subclasses to default their own copy/move for value semantics.
+    //
+    // None of them carry the lookup table: Easing's parameters are public
+    // fields, so a copy may be edited into a different curve, and a table
+    // sampled from the original would then silently disagree with evaluate().
+    // The registry re-attaches a table to whatever it hands out.
     Curve() = default;
-    Curve(const Curve&) = default;
-    Curve& operator=(const Curve&) = default;
-    Curve(Curve&&) = default;
-    Curve& operator=(Curve&&) = default;
+    Curve(const Curve&) noexcept
+    {
+    }
+    Curve& operator=(const Curve&) noexcept
+    {
+        m_lut.reset();
+        return *this;
+    }
+    Curve(Curve&&) noexcept
+    {
+    }
+    Curve& operator=(Curve&&) noexcept
+    {
+        m_lut.reset();
+        return *this;
+    }
+
+private:
+    friend class CurveRegistry;
+    std::shared_ptr<const CurveLut> m_lut;
 };
 
 /// Bound a curve's output to the overshoot envelope
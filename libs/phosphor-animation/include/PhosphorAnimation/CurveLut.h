@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+#include <PhosphorAnimation/phosphoranimation_export.h>
+
+#include <QtGlobal>
+
+#include <memory>
+#include <vector>
+
+namespace PhosphorAnimation {
+
+class Curve;
+
+/// Uniformly sampled lookup table for a stateless curve's `evaluate()` over
+/// [0, 1], read back by linear interpolation.
+///
+/// A cubic-bezier `evaluate()` is a virtual call plus a Newton solve for the
+/// curve parameter; every animated value pays it every frame. The table turns
+/// that into an index, two loads and a lerp. Tables are built by
+/// `CurveRegistry` (see `Curve::sample`) — consumers normally never construct
+/// one themselves.
+///
+/// `build()` only returns a table that reproduces the analytic curve to within
+/// `MaxError`: it starts at `MinIntervals` and doubles the resolution until
+/// every interval's midpoint matches, giving up past `MaxIntervals`. Curves
+/// with a kink or a step (bounce's floor impacts, elastic's cut-off at t = 1)
+/// therefore get no table and keep the analytic path — the table is an
+/// accelerator, never an approximation the user can see. 1e-5 is a hundredth
+/// of a pixel on a 1000 px travel. In practice that means the cubic-beziers,
+/// which are also the curves with the expensive (Newton) evaluate().
+///
+/// Immutable after construction; shared across threads as
+/// `shared_ptr<const CurveLut>`.
+class PHOSPHORANIMATION_EXPORT CurveLut
+{
+public:
+    static constexpr int MinIntervals = 256;
+    static constexpr int MaxIntervals = 8192;
+    static constexpr qreal MaxError = 1.0e-5;
+
+    /// Sample @p curve. Null for a stateful curve, a curve producing a
+    /// non-finite value, or one the table cannot follow within `MaxError`.
+    static std::shared_ptr<const CurveLut> build(const Curve& curve);
+
+    /// Interpolated value at @p t; @p t is clamped to [0, 1]. Exact at 0 and 1.
+    qreal evaluate(qreal t) const
+    {
+        const qreal x = qBound(qreal(0.0), t, qreal(1.0)) * m_scale;
+        const int i = static_cast<int>(x);
+        const float* s = m_samples.data() + i;
+        const qreal lo = s[0];
+        return lo + (qreal(s[1]) - lo) * (x - i);
+    }
+
+    /// `evaluate()` for @p count values of @p t into @p out. A branch-free
+    /// loop over contiguous arrays so the compiler can vectorize it; the
+    /// arrays may not overlap.
+    void evaluateBatch(const qreal* t, qreal* out, qsizetype count) const;
+
+    /// Number of interpolation intervals (the table holds one more sample).
+    int intervals() const
+    {
+        return static_cast<int>(m_scale);
+    }
+
+    /// Largest midpoint deviation from the analytic curve measured at build.
+    qreal measuredError() const
+    {
+        return m_measuredError;
+    }
+
+private:
+    CurveLut(std::vector<float> samples, int intervals, qreal measuredError);
+
+    // intervals + 2 entries: the last sample is repeated so evaluate(1.0),
+    // which lands on index `intervals`, can read s[1] without a branch.
+    std::vector<float> m_samples;
+    qreal m_scale;
+    qreal m_measuredError;
+};
+
+} // namespace PhosphorAnimation
@@ -31,11 +31,29 @@ void Curve::step(qreal dt, CurveState& state, qreal target) const
     }
 
     const qreal t = qBound(0.0, state.time / state.duration, 1.0);
-    const qreal progress = evaluate(t);
+    const qreal progress = sample(t);
     state.value = state.startValue + progress * (target - state.startValue);
     state.velocity = (state.value - prevValue) / dt;
 }
 
+void Curve::sampleBatch(const qreal* t, qreal* out, qsizetype count) const
+{
+    if (!m_lut) {
+        for (qsizetype k = 0; k < count; ++k) {
+            out[k] = evaluate(t[k]);
+        }
+        return;
+    }
+    m_lut->evaluateBatch(t, out, count);
+    // The table clamps; a third-party curve may define evaluate() outside
+    // [0,1], so out-of-domain inputs (rare) take the analytic path as in sample().
+    for (qsizetype k = 0; k < count; ++k) {
+        if (!(t[k] >= 0.0 && t[k] <= 1.0)) {
+            out[k] = evaluate(t[k]);
+        }
+    }
+}
+
 bool Curve::equals(const Curve& other) const
 {
     // Fallback equality via string round-trip. Subclasses with
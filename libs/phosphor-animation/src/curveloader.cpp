@@ -266,6 +266,11 @@ CurveLoader::CurveLoader(CurveRegistry& registry, QObject* parent)
     , m_sink(std::make_unique<Sink>(registry, makeCurveLoaderOwnerTag()))
     , m_loader(std::make_unique<PhosphorFsLoader::DirectoryLoader>(*m_sink))
 {
+    // parseFile is reentrant: it only reads the file and queries the
+    // (internally locked) CurveRegistry, so watcher-driven rescans can parse
+    // on the pool instead of the GUI thread.
+    m_loader->setScanMode(PhosphorFsLoader::DirectoryLoader::ScanMode::WorkerPool);
+
     // Gate `curvesChanged` on the per-batch change flag. DirectoryLoader
     // emits `entriesChanged` unconditionally on every rescan (tests and
     // debug tooling rely on that), but consumers of CurveLoader only
@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <PhosphorAnimation/Curve.h>
+#include <PhosphorAnimation/CurveLut.h>
+
+#include <QLoggingCategory>
+
+#include <algorithm>
+#include <cmath>
+
+namespace PhosphorAnimation {
+
+Q_LOGGING_CATEGORY(lcCurveLut, "phosphoranimation.curvelut")
+
+CurveLut::CurveLut(std::vector<float> samples, int intervals, qreal measuredError)
+    : m_samples(std::move(samples))
+    , m_scale(intervals)
+    , m_measuredError(measuredError)
+{
+}
+
+std::shared_ptr<const CurveLut> CurveLut::build(const Curve& curve)
+{
+    if (curve.isStateful()) {
+        return nullptr;
+    }
+
+    // Refinement reuses every evaluation: the midpoints probed to validate a
+    // table of n intervals are exactly the odd samples of the 2n table, so
+    // doubling costs one new round of midpoint probes and nothing else. The
+    // total is ~2x the final sample count whichever level is accepted.
+    std::vector<qreal> samples(MinIntervals + 1);
+    for (int i = 0; i <= MinIntervals; ++i) {
+        samples[i] = curve.evaluate(qreal(i) / MinIntervals);
+    }
+    std::vector<qreal> midpoints;
+
+    for (int n = MinIntervals; n <= MaxIntervals; n *= 2) {
+        midpoints.resize(n);
+        qreal worst = 0.0;
+        for (int i = 0; i < n; ++i) {
+            midpoints[i] = curve.evaluate((qreal(i) + 0.5) / n);
+            // Judge the table as it will be stored — float — so the rounding
+            // is inside the error budget rather than on top of it.
+            const qreal lerped = 0.5 * (qreal(float(samples[i])) + qreal(float(samples[i + 1])));
+            const qreal err = std::abs(lerped - midpoints[i]);
+            if (!std::isfinite(err)) {
+                qCDebug(lcCurveLut) << "curve" << curve.toString() << "produced a non-finite value; not sampled";
+                return nullptr;
+            }
+            worst = std::max(worst, err);
+        }
+
+        if (worst <= MaxError) {
+            std::vector<float> table(n + 2);
+            for (int i = 0; i <= n; ++i) {
+                table[i] = float(samples[i]);
+            }
+            table[n + 1] = table[n];
+            return std::shared_ptr<const CurveLut>(new CurveLut(std::move(table), n, worst));
+        }
+
+        std::vector<qreal> refined(2 * n + 1);
+        for (int i = 0; i < n; ++i) {
+            refined[2 * i] = samples[i];
+            refined[2 * i + 1] = midpoints[i];
+        }
+        refined[2 * n] = samples[n];
+        samples.swap(refined);
+    }
+
+    qCDebug(lcCurveLut) << "curve" << curve.toString() << "not representable within" << MaxError << "at"
+                        << MaxIntervals << "intervals; keeping analytic evaluation";
+    return nullptr;
+}
+
+void CurveLut::evaluateBatch(const qreal* t, qreal* out, qsizetype count) const
+{
+    const float* s = m_samples.data();
+    const qreal scale = m_scale;
+    for (qsizetype k = 0; k < count; ++k) {
+        // qBound, not std::clamp: it maps NaN to 0 (std::clamp passes it
+        // through to the index cast), and compiles to plain min/max.
+        const qreal x = qBound(qreal(0.0), t[k], qreal(1.0)) * scale;
+        const int i = static_cast<int>(x);
+        const qreal lo = s[i];
+        out[k] = lo + (qreal(s[i + 1]) - lo) * (x - i);
+    }
+}
+
+} // namespace PhosphorAnimation
@@ -8,9 +8,12 @@
 #include <PhosphorRegistry/IFactoryBase.h>
 #include <PhosphorRegistry/Registry.h>
 
+#include <QHash>
+#include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonValue>
 #include <QLoggingCategory>
+#include <QMutex>
 #include <QSet>
 #include <QtMath>
 
@@ -65,9 +68,75 @@ public:
     // mutex + insertionOrder + QHash<typeId, Entry> hand-roll.
     PhosphorRegistry::Registry<CurveFactoryEntry> registry;
 
+    // Sampled lookup tables, keyed by the normalized spec that produced the
+    // curve, so a profile resolving the same spec on every animation start
+    // samples it once. A null value records "not representable" so bounce
+    // and friends are not re-probed on every create. Any registration
+    // change drops the lot: a replaced factory may build a different curve
+    // for the same spec, and registrations are rare.
+    QMutex lutMutex;
+    QHash<QString, std::shared_ptr<const CurveLut>> luts;
+
     void registerBuiltins();
+    void invalidateLuts();
+    std::shared_ptr<const Curve> withLut(std::shared_ptr<const Curve> curve, const QString& key);
 };
 
+namespace {
+// Specs come from config and curve files, so the live set is small; the cap
+// only guards against a caller minting specs in a loop.
+constexpr int kMaxCachedLuts = 128;
+} // namespace
+
+void CurveRegistry::Impl::invalidateLuts()
+{
+    QMutexLocker lock(&lutMutex);
+    luts.clear();
+}
+
+std::shared_ptr<const Curve> CurveRegistry::Impl::withLut(std::shared_ptr<const Curve> curve, const QString& key)
+{
+    if (!curve || curve->isStateful() || curve->m_lut) {
+        return curve;
+    }
+
+    std::shared_ptr<const CurveLut> lut;
+    bool cached = false;
+    {
+        QMutexLocker lock(&lutMutex);
+        const auto it = luts.constFind(key);
+        if (it != luts.constEnd()) {
+            lut = *it;
+            cached = true;
+        }
+    }
+    if (!cached) {
+        // Sampled outside the lock: a cold build is a few hundred evaluate()
+        // calls, and two threads racing on the same key build identical tables.
+        lut = CurveLut::build(*curve);
+        QMutexLocker lock(&lutMutex);
+        if (luts.size() >= kMaxCachedLuts) {
+            luts.clear();
+        }
+        luts.insert(key, lut);
+    }
+    if (!lut) {
+        return curve;
+    }
+
+    // A factory normally mints a fresh curve, which only this frame holds —
+    // attaching to it is safe. One that hands out a shared instance (the
+    // loader's captured curve, a third-party singleton) may have readers on
+    // other threads, so it gets a private copy instead of a mutation.
+    if (curve.use_count() == 1) {
+        const_cast<Curve&>(*curve).m_lut = std::move(lut);
+        return curve;
+    }
+    std::shared_ptr<Curve> copy = curve->clone();
+    copy->m_lut = std::move(lut);
+    return copy;
+}
+
 namespace {
 
 // Shared validation + wire-format builders for the built-in JSON
@@ -320,19 +389,28 @@ bool CurveRegistry::registerFactory(const QString& typeId, Factory stringFactory
     m_impl->registry.registerFactory(
         std::make_shared<CurveFactoryEntry>(typeId, std::move(stringFactory), std::move(jsonFactory)), ownerTag,
         PhosphorRegistry::DuplicatePolicy::Replace);
+    m_impl->invalidateLuts();
     return replaced;
 }
 
 bool CurveRegistry::unregisterFactory(const QString& typeId)
 {
-    return m_impl->registry.unregisterFactory(typeId);
+    const bool removed = m_impl->registry.unregisterFactory(typeId);
+    if (removed) {
+        m_impl->invalidateLuts();
+    }
+    return removed;
 }
 
 int CurveRegistry::unregisterByOwner(const QString& ownerTag)
 {
     // The registry rejects an empty tag (it would otherwise wipe every
     // untagged built-in) and emits per-entry factoryUnregistered signals.
-    return m_impl->registry.unregisterByOwner(ownerTag);
+    const int removed = m_impl->registry.unregisterByOwner(ownerTag);
+    if (removed > 0) {
+        m_impl->invalidateLuts();
+    }
+    return removed;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════════
@@ -385,6 +463,13 @@ ParsedSpec parseSpec(const QString& spec)
     return out;
 }
 
+// LUT cache key for a parsed spec. Normalized, so "Bezier:…" and "bezier:…"
+// share a table; the empty key is reserved for the default OutCubic.
+QString lutKey(const ParsedSpec& parsed)
+{
+    return parsed.typeId + QLatin1Char(':') + parsed.params;
+}
+
 } // namespace
 
 std::shared_ptr<const Curve> CurveRegistry::tryCreate(const QString& spec) const
@@ -399,7 +484,7 @@ std::shared_ptr<const Curve> CurveRegistry::tryCreate(const QString& spec) const
     if (!entry || !entry->stringFactory) {
         return nullptr;
     }
-    return entry->stringFactory(parsed.typeId, parsed.params);
+    return m_impl->withLut(entry->stringFactory(parsed.typeId, parsed.params), lutKey(parsed));
 }
 
 std::shared_ptr<const Curve> CurveRegistry::tryCreateFromJson(const QString& typeId,
@@ -413,7 +498,14 @@ std::shared_ptr<const Curve> CurveRegistry::tryCreateFromJson(const QString& typ
     if (!entry || !entry->jsonFactory) {
         return nullptr;
     }
-    return entry->jsonFactory(parameters);
+    // Sampled here rather than on the loader's create() path: the loader
+    // registers a factory that hands back this very instance, so the table
+    // built at load time is the one every later create() of the name shares.
+    // The key is disjoint from the string specs (a JSON object never parses
+    // as one).
+    const QString key = typeId + QLatin1Char('\n')
+        + QString::fromUtf8(QJsonDocument(parameters).toJson(QJsonDocument::Compact));
+    return m_impl->withLut(entry->jsonFactory(parameters), key);
 }
 
 std::shared_ptr<const Curve> CurveRegistry::create(const QString& spec) const
@@ -428,7 +520,7 @@ std::shared_ptr<const Curve> CurveRegistry::create(const QString& spec) const
         // from the pre-registry default OutCubic bezier. Match the
         // unknown-typeId branch's behaviour so callers don't need
         // parallel null-guards.
-        return std::make_shared<Easing>();
+        return m_impl->withLut(std::make_shared<Easing>(), QString());
     }
 
     const ParsedSpec parsed = parseSpec(spec);
@@ -437,16 +529,16 @@ std::shared_ptr<const Curve> CurveRegistry::create(const QString& spec) const
     if (!entry || !entry->stringFactory) {
         qCWarning(lcCurveRegistry) << "unknown curve typeId" << parsed.typeId << "in spec" << spec
                                    << "- returning default";
-        return std::make_shared<Easing>();
+        return m_impl->withLut(std::make_shared<Easing>(), QString());
     }
 
     auto curve = entry->stringFactory(parsed.typeId, parsed.params);
     if (!curve) {
         qCWarning(lcCurveRegistry) << "factory for" << parsed.typeId << "returned null for params" << parsed.params
                                    << "- returning default";
-        return std::make_shared<Easing>();
+        return m_impl->withLut(std::make_shared<Easing>(), QString());
     }
-    return curve;
+    return m_impl->withLut(std::move(curve), lutKey(parsed));
 }
 
 QStringList CurveRegistry::knownTypes() const
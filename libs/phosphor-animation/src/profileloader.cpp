@@ -230,6 +230,11 @@ ProfileLoader::ProfileLoader(PhosphorProfileRegistry& registry, CurveRegistry& c
     , m_sink(std::make_unique<Sink>(registry, curveRegistry, ownerTag.isEmpty() ? defaultOwnerTag() : ownerTag))
     , m_loader(std::make_unique<PhosphorFsLoader::DirectoryLoader>(*m_sink))
 {
+    // parseFile is reentrant: Profile::fromJson only reads the file's JSON
+    // and the (internally locked) CurveRegistry, so watcher-driven rescans
+    // can parse on the pool instead of the GUI thread.
+    m_loader->setScanMode(PhosphorFsLoader::DirectoryLoader::ScanMode::WorkerPool);
+
     // Gate `profilesChanged` on the per-batch change flag — same
     // contract as CurveLoader::curvesChanged. DirectoryLoader emits
     // entriesChanged on every rescan, but ProfileLoader consumers only
@@ -55,14 +55,26 @@ SurfaceAnimator::Private::Private(PhosphorAnimation::PhosphorProfileRegistry& re
     static_assert(offsetof(Private, m_driverTimer) > offsetof(Private, m_tracks),
                   "m_driverTimer must be declared AFTER m_tracks so connectSurfaceCleanup's "
                   "destroyed-lambda is auto-disconnected before the map it touches dies.");
+    static_assert(offsetof(Private, m_driverTimer) > offsetof(Private, m_frameDrivers),
+                  "m_driverTimer must be declared AFTER m_frameDrivers so the per-window frame and "
+                  "destroyed lambdas are auto-disconnected before the drivers they touch die.");
+    static_assert(offsetof(Private, m_stallTimer) > offsetof(Private, m_active),
+                  "m_stallTimer must be declared AFTER m_active so it stops before the arrays its "
+                  "slot walks die.");
 #pragma GCC diagnostic pop
 
-    // Driver fires kTickIntervalMs cadence while any track is in
-    // flight; tickAll stops the timer when m_tracks empties.
+    // The fallback driver fires at kTickIntervalMs cadence while any
+    // track has no frame-paced window; tickAll stops it when the last
+    // such track completes or moves to a window's frames. Frame-paced
+    // tracks tick from QQuickWindow::afterAnimating instead (onFrame).
     m_driverTimer.setInterval(std::chrono::milliseconds(kTickIntervalMs));
     m_driverTimer.setTimerType(Qt::PreciseTimer);
     QObject::connect(&m_driverTimer, &QTimer::timeout, [this]() {
-        tickAll();
+        tickAll(nullptr);
+    });
+    m_stallTimer.setInterval(std::chrono::milliseconds(kFrameStallMs));
+    QObject::connect(&m_stallTimer, &QTimer::timeout, [this]() {
+        demoteStalledDrivers();
     });
 }
 
@@ -116,8 +128,9 @@ SurfaceAnimator::SurfaceAnimator(PhosphorAnimation::PhosphorProfileRegistry& reg
 
 SurfaceAnimator::~SurfaceAnimator()
 {
-    // Stop the timer FIRST so no tick races with the teardown below.
+    // Stop the timers FIRST so no tick races with the teardown below.
     d->m_driverTimer.stop();
+    d->m_stallTimer.stop();
 
     // Move-out for stable iteration (cancelTracking erases from
     // m_tracks; iterating + erase on unordered_map is fragile).
@@ -134,6 +147,11 @@ SurfaceAnimator::~SurfaceAnimator()
     // identical to the normal teardown.
     auto leftovers = std::move(d->m_tracks);
     d->m_tracks.clear();
+    // The dense view points into the moved-out nodes; nothing ticks
+    // again, so drop it wholesale rather than retiring slot by slot.
+    d->m_active = {};
+    d->m_steadyTracks = 0;
+    d->m_frameTracks = 0;
     for (auto& [key, track] : leftovers) {
         (void)key;
         if (track.opacity) {
@@ -28,6 +28,7 @@
 QT_BEGIN_NAMESPACE
 class QQuickItem;
 class QQuickShaderEffectSource;
+class QQuickWindow;
 QT_END_NAMESPACE
 
 namespace PhosphorAnimation {
@@ -53,11 +54,19 @@ namespace PhosphorAnimationLayer {
 // (surfaceanimator_shaderattach/tracks/tick.cpp) shares one category.
 Q_DECLARE_LOGGING_CATEGORY(lcSurfaceAnimator)
 
-/// Driver tick interval. SteadyClock::refreshRate MUST agree so
-/// velocity-based curves (Spring) sample at the timer's cadence.
+/// Fallback driver tick interval, for tracks whose target has no exposed
+/// window to pace them (headless, not yet mapped, stalled render loop).
+/// SteadyClock::refreshRate MUST agree so velocity-based curves (Spring)
+/// sample at the timer's cadence.
 constexpr int kTickIntervalMs = 16;
 constexpr qreal kRefreshRateHz = 1000.0 / kTickIntervalMs;
 
+/// A frame-paced window that goes this long without a frame while tracks
+/// are bound to it counts as stalled (hidden mid-leg, render loop paused):
+/// its tracks drop back to the steady driver so their completions still
+/// fire. Also the period of the stall check itself.
+constexpr int kFrameStallMs = 100;
+
 namespace internal {
 /// Steady-clock IMotionClock. Independent of QQuickWindow rendering
 /// so offscreen QPA (headless CI) ticks too. `internal` (not
@@ -77,10 +86,45 @@ public:
     }
 
     /// requestFrame is a hint — the SurfaceAnimator's QTimer already
-    /// ticks unconditionally while any track is in flight. No-op.
+    /// ticks unconditionally while any steady track is in flight. No-op.
     void requestFrame() override
     {
     }
+
+    /// Shared with FrameClock, so a track can move between the steady
+    /// and frame drivers mid-flight (AnimatedValue::rebindClock).
+    const void* epochIdentity() const override
+    {
+        return steadyClockEpoch();
+    }
+};
+
+/// Per-window IMotionClock paced by the window's own frames. latch() runs
+/// from QQuickWindow::afterAnimating — GUI thread, once per frame, just
+/// before the scene-graph sync — so every track advanced in a frame samples
+/// the same timestamp, and refreshRate() is the output's real rate rather
+/// than the 60 Hz timer's. requestFrame() schedules the next frame through
+/// QQuickWindow::update(); when no track asks for one, the window (and the
+/// animator with it) goes idle. steady_clock-backed, like SteadyClock.
+class FrameClock : public PhosphorAnimation::IMotionClock
+{
+public:
+    explicit FrameClock(QQuickWindow* window);
+
+    std::chrono::nanoseconds now() const override;
+    qreal refreshRate() const override;
+    void requestFrame() override;
+    const void* epochIdentity() const override;
+
+    /// Record the current frame's timestamp. now() returns it until the
+    /// next latch; before the first one it reads steady_clock directly.
+    /// Also called when the driver gains its first track after an idle
+    /// spell, so now() never reports a frame from before it.
+    void latch();
+
+private:
+    QPointer<QQuickWindow> m_window;
+    std::chrono::nanoseconds m_frameTime{0};
 };
 } // namespace internal
 
@@ -226,6 +270,51 @@ public:
         /// `iFrame` is per-leg, not per-shader-item-lifetime, so a
         /// reused shader item starts fresh at 0 on the next leg.
         int shaderFrameCount = 0;
+        /// Slot in m_active while in flight, -1 otherwise. Maintained by
+        /// activateTrack / retireTrack / compactActive only.
+        int activeIndex = -1;
+    };
+
+    /// Frame pacing for one QQuickWindow: its clock plus the
+    /// afterAnimating hookup. Created on first use for a window and kept
+    /// until the window dies; the hookup is live only while tracks are
+    /// bound (and while stalled, to notice the window rendering again),
+    /// so an idle window costs nothing per frame.
+    struct FrameDriver
+    {
+        explicit FrameDriver(QQuickWindow* w)
+            : window(w)
+            , clock(w)
+        {
+        }
+        QQuickWindow* window; ///< Map key; address-only once destroyed fires
+        internal::FrameClock clock;
+        QMetaObject::Connection frameConnection;
+        int boundTracks = 0;
+        /// Set by demoteStalledDrivers; frameDriverFor hands out no new
+        /// tracks until the next frame clears it.
+        bool stalled = false;
+        /// Steady-clock ns of the last frame — or of the bind that ended an
+        /// idle spell, so a just-bound window gets a full grace period.
+        qint64 lastFrameNs = 0;
+        /// This driver's m_lastShaderTickNs (iTimeDelta anchor).
+        qint64 lastShaderTickNs = 0;
+    };
+
+    /// The in-flight tracks as parallel arrays in activation order, so a
+    /// tick is one linear pass instead of a snapshot of m_tracks' keys
+    /// followed by a hash lookup per key per leg. m_tracks keeps ownership;
+    /// its nodes are address-stable, so the raw Track* is valid until the
+    /// entry is erased, and every erase path retires the slot first
+    /// (retireTrack). A slot retired during a tick — legCompleted or a
+    /// cancel from inside a motion callback — is nulled in place and
+    /// compacted once the outermost tick unwinds; slots activated during a
+    /// tick are appended and first advanced on the next one.
+    struct ActiveTracks
+    {
+        std::vector<Track*> tracks; ///< nullptr = retired, awaiting compaction
+        std::vector<FrameDriver*> drivers; ///< nullptr = steady fallback driver
+        int retired = 0;
     };
 
     /// Stash for shader pieces between legs. Populated by
@@ -266,10 +355,22 @@ public:
     /// a synchronous QML handler that cancels and installs a fresh leg, and
     /// an unguarded decrement would then retire the NEW leg early.
     void legCompleted(PhosphorLayer::Surface* surface, QQuickItem* target, quint64 expectedGeneration = 0);
-    void tickAll();
+    /// Advance every active track bound to @p driver (nullptr = the
+    /// steady fallback driver) by one tick.
+    void tickAll(FrameDriver* driver);
     void pushDynamicShaderUniforms(Track& track, qreal deltaSecs);
     void seedShaderUniformsAtAttach(Track& track);
-    void ensureDriving();
+    void ensureDriving(FrameDriver* driver);
+    void activateTrack(Track& track, FrameDriver* driver);
+    void retireTrack(Track& track);
+    void rebindTrack(int index, FrameDriver* driver);
+    void compactActive();
+    void bindDriver(FrameDriver* driver);
+    void unbindDriver(FrameDriver* driver);
+    FrameDriver* frameDriverFor(QQuickItem* target);
+    void onFrame(FrameDriver& driver);
+    void demoteStalledDrivers();
+    void dropFrameDriver(QQuickWindow* window);
 
     PhosphorAnimation::PhosphorProfileRegistry& m_registry;
     PhosphorAnimationShaders::AnimationShaderRegistry* m_shaderRegistry = nullptr;
@@ -287,11 +388,12 @@ public:
     /// `pushDynamicShaderUniforms`) and at attach time (see
     /// `seedShaderUniformsAtAttach`). Empty = no audio data yet.
     QVector<float> m_audioSpectrum;
-    /// Steady-clock-ns timestamp of the last `tickAll` invocation.
-    /// Used to compute real-time `iTimeDelta` for active shader items.
+    /// Steady-clock-ns timestamp of the last steady-driver tick. Used
+    /// to compute real-time `iTimeDelta` for active shader items.
     /// Reset to 0 when the driver stops so the first tick after the
     /// next `ensureDriving()` reports 0 delta instead of the
-    /// wall-clock gap accrued while idle.
+    /// wall-clock gap accrued while idle. Frame drivers keep their own
+    /// (FrameDriver::lastShaderTickNs).
     qint64 m_lastShaderTickNs = 0;
     /// Keyed on `Role::scopePrefix`. Lookup (configFor) is longest-
     /// prefix-match — a linear O(N) scan, which is fine for the handful
@@ -302,11 +404,24 @@ public:
     /// order tears down the AVs (held by non-owning pointer to this
     /// clock) before the clock disappears.
     internal::SteadyClock m_clock;
+    /// Per-window frame drivers (see FrameDriver). Declared before
+    /// m_tracks for the same reason as m_clock: AVs hold non-owning
+    /// pointers to the FrameClocks inside.
+    std::unordered_map<QQuickWindow*, std::unique_ptr<FrameDriver>> m_frameDrivers;
     /// Tracks only in-flight animations; missing entry means "no
     /// active animation". std::unordered_map (not QHash) because
     /// Track is move-only and QHash still requires copy-constructible
     /// values in Qt6.
     std::unordered_map<TrackKey, Track, TrackKeyHash> m_tracks;
+    /// Dense view of m_tracks driven by tickAll (see ActiveTracks).
+    ActiveTracks m_active;
+    /// Active tracks per kind of driver: the steady timer runs only while
+    /// m_steadyTracks > 0, the stall check only while m_frameTracks > 0.
+    int m_steadyTracks = 0;
+    int m_frameTracks = 0;
+    /// tickAll nesting depth — graveyard drains and compaction wait for
+    /// the outermost tick.
+    int m_tickDepth = 0;
     /// Per-(surface, target) stash for ShaderEffect/Source pieces between
     /// legs. Populated by teardownShaderLeg, drained on reuse-claim in
     /// runLeg or on surface destruction (connectSurfaceCleanup wires
@@ -336,10 +451,14 @@ public:
     /// of the next tickAll. MUST be declared after m_clock and
     /// before m_driverTimer so the destruction order is sound.
     std::vector<std::unique_ptr<PhosphorAnimation::AnimatedValue<qreal>>> m_pendingDestroy;
-    /// Drives advance() at ~60Hz while any track is in flight.
-    /// Declared LAST so the timer stops BEFORE m_tracks tears down on
-    /// dtor — otherwise a final tick could fire after the tracks
-    /// have been freed.
+    /// Periodic demoteStalledDrivers while any track is frame-paced.
+    /// Declared after m_active / m_frameDrivers, which its slot walks.
+    QTimer m_stallTimer;
+    /// Drives advance() at ~60Hz while any track lacks a frame-paced
+    /// window (the steady fallback). Also the receiver context for the
+    /// surface-destroyed and per-window connections. Declared LAST so
+    /// the timer stops BEFORE m_tracks tears down on dtor — otherwise a
+    /// final tick could fire after the tracks have been freed.
     QTimer m_driverTimer;
 };
 
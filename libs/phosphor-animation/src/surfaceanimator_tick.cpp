@@ -6,49 +6,95 @@
 #include <PhosphorAnimation/AnimationLimits.h>
 #include <PhosphorRendering/ShaderEffect.h>
 
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QScreen>
+
 #include <private/qquickhoverhandler_p.h>
 
 #include <vector>
 
 namespace PhosphorAnimationLayer {
 
-/// Drive every active animation by one tick. By-key snapshot
-/// iteration is safe against re-entrant erase from legCompleted.
-void SurfaceAnimator::Private::tickAll()
-{
-    // Drain the graveyard — AVs parked here last tick are now safe
-    // to destroy (the spec.onComplete advance() frame has unwound).
-    m_pendingDestroy.clear();
-
-    // Sweep the reuse cache for stale entries — surfaces whose
-    // QPointers all auto-nulled because the QML scene tore the
-    // shader pieces down independently of our cancel paths
-    // (consumer-driven anchor reparent, Loader unload outside the
-    // animator's notice). The destroyed-signal cleanup catches
-    // most cases, but it fires on Surface destruction, not on
-    // shaderItem/Source/Anchor destruction in isolation. Without
-    // this sweep, a surface that survives but loses its anchor
-    // sits with a dead reuse entry indefinitely; the next leg's
-    // reuse-mismatch path destroys it then, but the entry stays
-    // wasting a hash slot until then.
-    for (auto it = m_pendingReuse.begin(); it != m_pendingReuse.end();) {
-        const PendingReuseShader& p = it->second;
-        if (!p.shaderItem && !p.shaderSource && !p.shaderAnchor) {
-            it = m_pendingReuse.erase(it);
-        } else {
-            ++it;
-        }
-    }
-
-    // Snapshot — legCompleted may erase from m_tracks while iterating.
-    std::vector<TrackKey> keys;
-    keys.reserve(m_tracks.size());
-    for (auto& [k, _] : m_tracks) {
-        keys.push_back(k);
-    }
-    // Real-time delta for shader iTimeDelta — measured between
-    // SurfaceAnimator ticks (which fire at kTickIntervalMs cadence
-    // while any track is in flight). First tick after a quiescent
+namespace internal {
+
+FrameClock::FrameClock(QQuickWindow* window)
+    : m_window(window)
+{
+}
+
+std::chrono::nanoseconds FrameClock::now() const
+{
+    if (m_frameTime.count() == 0) {
+        return std::chrono::steady_clock::now().time_since_epoch();
+    }
+    return m_frameTime;
+}
+
+qreal FrameClock::refreshRate() const
+{
+    const QScreen* screen = m_window ? m_window->screen() : nullptr;
+    const qreal hz = screen ? screen->refreshRate() : 0.0;
+    return hz > 0.0 ? hz : kRefreshRateHz;
+}
+
+void FrameClock::requestFrame()
+{
+    // QQuickWindow::update coalesces: any number of calls within a frame
+    // schedule exactly one more.
+    if (m_window) {
+        m_window->update();
+    }
+}
+
+const void* FrameClock::epochIdentity() const
+{
+    return steadyClockEpoch();
+}
+
+void FrameClock::latch()
+{
+    m_frameTime = std::chrono::steady_clock::now().time_since_epoch();
+}
+
+} // namespace internal
+
+/// Drive every active animation bound to @p driver by one tick: one
+/// linear pass over m_active. A slot retired mid-pass (legCompleted or a
+/// cancel from inside a motion callback) reads back as nullptr, and a slot
+/// moved to another driver reads back as a different driver, so each leg
+/// re-checks the slot after every advance() that could have run callbacks.
+void SurfaceAnimator::Private::tickAll(FrameDriver* driver)
+{
+    if (m_tickDepth == 0) {
+        // Drain the graveyard — AVs parked here last tick are now safe
+        // to destroy (the spec.onComplete advance() frame has unwound).
+        m_pendingDestroy.clear();
+
+        // Sweep the reuse cache for stale entries — surfaces whose
+        // QPointers all auto-nulled because the QML scene tore the
+        // shader pieces down independently of our cancel paths
+        // (consumer-driven anchor reparent, Loader unload outside the
+        // animator's notice). The destroyed-signal cleanup catches
+        // most cases, but it fires on Surface destruction, not on
+        // shaderItem/Source/Anchor destruction in isolation. Without
+        // this sweep, a surface that survives but loses its anchor
+        // sits with a dead reuse entry indefinitely; the next leg's
+        // reuse-mismatch path destroys it then, but the entry stays
+        // wasting a hash slot until then.
+        for (auto it = m_pendingReuse.begin(); it != m_pendingReuse.end();) {
+            const PendingReuseShader& p = it->second;
+            if (!p.shaderItem && !p.shaderSource && !p.shaderAnchor) {
+                it = m_pendingReuse.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // Real-time delta for shader iTimeDelta — measured between this
+    // driver's ticks (the window's frames, or the fallback timer's
+    // kTickIntervalMs cadence). First tick after a quiescent
     // period reports 0 instead of a stale wall-clock gap, matching
     // OverlayService::updateShaderUniforms's clamp-on-resume idiom
     // for the overlay path. Capped at the shared
@@ -57,51 +103,73 @@ void SurfaceAnimator::Private::tickAll()
     // into the shader. Both runtimes reference the same constant —
     // bumping one without the other was the prior drift risk.
     const qreal kMaxShaderDeltaSecs = static_cast<qreal>(PhosphorAnimation::Limits::MaxShaderTimeDeltaSeconds);
-    const qint64 nowNs = m_clock.now().count();
+    qint64& lastShaderTickNs = driver ? driver->lastShaderTickNs : m_lastShaderTickNs;
+    const qint64 nowNs = driver ? driver->clock.now().count() : m_clock.now().count();
     qreal shaderDeltaSecs = 0.0;
-    if (m_lastShaderTickNs > 0) {
-        shaderDeltaSecs = qBound(qreal(0.0), qreal(nowNs - m_lastShaderTickNs) / 1.0e9, kMaxShaderDeltaSecs);
+    if (lastShaderTickNs > 0) {
+        shaderDeltaSecs = qBound(qreal(0.0), qreal(nowNs - lastShaderTickNs) / 1.0e9, kMaxShaderDeltaSecs);
     }
-    m_lastShaderTickNs = nowNs;
+    lastShaderTickNs = nowNs;
 
-    for (const auto& k : keys) {
-        auto it = m_tracks.find(k);
-        if (it == m_tracks.end()) {
+    ++m_tickDepth;
+    // Slots appended during the pass wait for the next tick, as the old
+    // key snapshot did.
+    const std::size_t count = m_active.tracks.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        Track* track = m_active.tracks[i];
+        if (!track || m_active.drivers[i] != driver) {
             continue;
         }
-        if (it->second.opacity) {
-            it->second.opacity->advance();
+        if (!driver) {
+            // A steady track whose window has since been exposed (the
+            // usual first show: beginShow runs before the compositor maps
+            // the surface) moves to that window's frames from here on.
+            if (FrameDriver* paced = frameDriverFor(track->target)) {
+                rebindTrack(static_cast<int>(i), paced);
+                continue;
+            }
+        }
+        const auto stillHere = [&] {
+            return m_active.tracks[i] == track && m_active.drivers[i] == driver;
+        };
+        if (track->opacity) {
+            track->opacity->advance();
         }
-        // Re-find: advance may have completed + erased via legCompleted.
-        it = m_tracks.find(k);
-        if (it == m_tracks.end()) {
+        if (!stillHere()) {
             continue;
         }
-        if (it->second.scale) {
-            it->second.scale->advance();
+        if (track->scale) {
+            track->scale->advance();
         }
-        it = m_tracks.find(k);
-        if (it == m_tracks.end()) {
+        if (!stillHere()) {
             continue;
         }
-        if (it->second.shaderTime) {
-            it->second.shaderTime->advance();
+        if (track->shaderTime) {
+            track->shaderTime->advance();
         }
-        // Re-find again: shaderTime->advance may have completed +
-        // erased via legCompleted. Then push per-frame dynamic
-        // uniforms (iTimeDelta, iFrame, iMouse, audio spectrum)
-        // so the next paint sees the latest values. Cheap on
-        // identity (each setter early-returns when unchanged).
-        it = m_tracks.find(k);
-        if (it == m_tracks.end()) {
+        // Then push per-frame dynamic uniforms (iTimeDelta, iFrame,
+        // iMouse, audio spectrum) so the next paint sees the latest
+        // values. Cheap on identity (each setter early-returns when
+        // unchanged).
+        if (!stillHere()) {
             continue;
         }
-        if (it->second.shaderItem) {
-            pushDynamicShaderUniforms(it->second, shaderDeltaSecs);
+        if (track->shaderItem) {
+            pushDynamicShaderUniforms(*track, shaderDeltaSecs);
         }
     }
-    // Stop the driver if every track completed during this tick.
-    if (m_tracks.empty() && m_driverTimer.isActive()) {
+    --m_tickDepth;
+
+    if (m_tickDepth == 0 && m_active.retired > 0) {
+        compactActive();
+    }
+    if (driver) {
+        if (driver->boundTracks == 0) {
+            lastShaderTickNs = 0;
+        }
+    } else if (m_steadyTracks == 0 && m_driverTimer.isActive()) {
+        // Stop the driver if every steady track completed (or moved to
+        // a frame driver) during this tick.
         m_driverTimer.stop();
         // Reset the tick-time anchor so the first tick after the
         // next ensureDriving() reports 0 delta instead of the
@@ -179,12 +247,211 @@ void SurfaceAnimator::Private::seedShaderUniformsAtAttach(Track& track)
     }
 }
 
-/// Ensure the driver timer is running. Idempotent.
-void SurfaceAnimator::Private::ensureDriving()
+/// Make sure @p driver will tick: schedule a frame on a frame driver, or
+/// start the fallback timer. Idempotent.
+void SurfaceAnimator::Private::ensureDriving(FrameDriver* driver)
 {
+    if (driver) {
+        driver->clock.requestFrame();
+        return;
+    }
     if (!m_driverTimer.isActive()) {
         m_driverTimer.start();
     }
 }
 
+/// Enter @p track into m_active on @p driver. A track already in flight
+/// (runLeg re-installing the same slot) keeps its position and only
+/// switches driver if the target moved windows.
+void SurfaceAnimator::Private::activateTrack(Track& track, FrameDriver* driver)
+{
+    if (track.activeIndex < 0) {
+        track.activeIndex = static_cast<int>(m_active.tracks.size());
+        m_active.tracks.push_back(&track);
+        m_active.drivers.push_back(nullptr);
+        bindDriver(nullptr);
+    }
+    rebindTrack(track.activeIndex, driver);
+}
+
+/// Take @p track out of m_active. Every m_tracks erase path calls this
+/// BEFORE the erase, while the node is still the one m_active points at.
+void SurfaceAnimator::Private::retireTrack(Track& track)
+{
+    const int index = track.activeIndex;
+    if (index < 0) {
+        return;
+    }
+    track.activeIndex = -1;
+    unbindDriver(m_active.drivers[index]);
+    m_active.tracks[index] = nullptr;
+    m_active.drivers[index] = nullptr;
+    ++m_active.retired;
+    // Mid-tick, the pass still indexes m_active — tickAll compacts once
+    // the outermost tick unwinds.
+    if (m_tickDepth == 0) {
+        compactActive();
+    }
+}
+
+/// Move the track at @p index to @p driver, rebasing its AVs onto the new
+/// clock (both are steady_clock-backed, so rebindClock keeps elapsed and
+/// dt intact).
+void SurfaceAnimator::Private::rebindTrack(int index, FrameDriver* driver)
+{
+    FrameDriver* previous = m_active.drivers[index];
+    if (previous == driver) {
+        return;
+    }
+    unbindDriver(previous);
+    bindDriver(driver);
+    m_active.drivers[index] = driver;
+    Track* track = m_active.tracks[index];
+    PhosphorAnimation::IMotionClock* clock = &m_clock;
+    if (driver) {
+        clock = &driver->clock;
+    }
+    for (auto* av : {track->opacity.get(), track->scale.get(), track->shaderTime.get()}) {
+        if (av) {
+            av->rebindClock(clock);
+        }
+    }
+    ensureDriving(driver);
+}
+
+/// Squeeze retired slots out of m_active, preserving activation order.
+void SurfaceAnimator::Private::compactActive()
+{
+    std::size_t live = 0;
+    for (std::size_t i = 0; i < m_active.tracks.size(); ++i) {
+        Track* track = m_active.tracks[i];
+        if (!track) {
+            continue;
+        }
+        track->activeIndex = static_cast<int>(live);
+        m_active.tracks[live] = track;
+        m_active.drivers[live] = m_active.drivers[i];
+        ++live;
+    }
+    m_active.tracks.resize(live);
+    m_active.drivers.resize(live);
+    m_active.retired = 0;
+}
+
+void SurfaceAnimator::Private::bindDriver(FrameDriver* driver)
+{
+    if (!driver) {
+        ++m_steadyTracks;
+        return;
+    }
+    if (driver->boundTracks++ == 0) {
+        // The clock still holds the last frame of the previous busy spell,
+        // which may be long past. A leg started or rebased against that
+        // would count the whole idle gap as elapsed and end on its first
+        // frame, so latch the present until the next frame does.
+        driver->clock.latch();
+        driver->lastFrameNs = m_clock.now().count();
+        if (!driver->frameConnection) {
+            driver->frameConnection = QObject::connect(driver->window, &QQuickWindow::afterAnimating, &m_driverTimer,
+                                                       [this, driver]() {
+                                                           onFrame(*driver);
+                                                       });
+        }
+    }
+    if (m_frameTracks++ == 0) {
+        m_stallTimer.start();
+    }
+}
+
+void SurfaceAnimator::Private::unbindDriver(FrameDriver* driver)
+{
+    if (!driver) {
+        --m_steadyTracks;
+        return;
+    }
+    // The afterAnimating hookup is dropped lazily, on the next frame
+    // (onFrame), so a track handed straight back does not reconnect.
+    --driver->boundTracks;
+    if (--m_frameTracks == 0) {
+        m_stallTimer.stop();
+    }
+}
+
+/// The frame driver for @p target's window, created on first use — or
+/// nullptr to stay on the steady fallback: no window, a window not
+/// exposed (unmapped, hidden; it would never deliver a frame), or one
+/// currently marked stalled.
+SurfaceAnimator::Private::FrameDriver* SurfaceAnimator::Private::frameDriverFor(QQuickItem* target)
+{
+    QQuickWindow* window = target ? target->window() : nullptr;
+    if (!window || !window->isExposed()) {
+        return nullptr;
+    }
+    auto it = m_frameDrivers.find(window);
+    if (it == m_frameDrivers.end()) {
+        // Address-only capture: destroyed fires from ~QObject, after
+        // ~QQuickWindow ran.
+        QObject::connect(window, &QObject::destroyed, &m_driverTimer, [this, window]() {
+            dropFrameDriver(window);
+        });
+        it = m_frameDrivers.emplace(window, std::make_unique<FrameDriver>(window)).first;
+    }
+    return it->second->stalled ? nullptr : it->second.get();
+}
+
+/// afterAnimating slot: latch the frame time and advance the window's
+/// tracks against it.
+void SurfaceAnimator::Private::onFrame(FrameDriver& driver)
+{
+    driver.clock.latch();
+    driver.lastFrameNs = driver.clock.now().count();
+    driver.stalled = false;
+    if (driver.boundTracks == 0) {
+        QObject::disconnect(driver.frameConnection);
+        driver.frameConnection = {};
+        driver.lastShaderTickNs = 0;
+        return;
+    }
+    tickAll(&driver);
+}
+
+/// m_stallTimer slot. A window can stop producing frames with tracks
+/// still bound — hidden or unexposed mid-leg, render loop paused — and
+/// those tracks would otherwise never complete, leaving the consumer's
+/// onComplete (often the very unmap that is waiting) pending forever.
+void SurfaceAnimator::Private::demoteStalledDrivers()
+{
+    const qint64 nowNs = m_clock.now().count();
+    constexpr qint64 kStallNs = qint64(kFrameStallMs) * 1000 * 1000;
+    for (auto& [window, driver] : m_frameDrivers) {
+        if (driver->boundTracks == 0 || nowNs - driver->lastFrameNs < kStallNs) {
+            continue;
+        }
+        qCDebug(lcSurfaceAnimator) << "no frame from" << window << "for" << kFrameStallMs
+                                   << "ms - moving its tracks to the steady driver";
+        driver->stalled = true;
+        for (std::size_t i = 0; i < m_active.tracks.size(); ++i) {
+            if (m_active.tracks[i] && m_active.drivers[i] == driver.get()) {
+                rebindTrack(static_cast<int>(i), nullptr);
+            }
+        }
+    }
+}
+
+/// Window destroyed: hand its tracks to the steady driver before the
+/// FrameClock their AVs point at goes away.
+void SurfaceAnimator::Private::dropFrameDriver(QQuickWindow* window)
+{
+    const auto it = m_frameDrivers.find(window);
+    if (it == m_frameDrivers.end()) {
+        return;
+    }
+    for (std::size_t i = 0; i < m_active.tracks.size(); ++i) {
+        if (m_active.tracks[i] && m_active.drivers[i] == it->second.get()) {
+            rebindTrack(static_cast<int>(i), nullptr);
+        }
+    }
+    m_frameDrivers.erase(it);
+}
+
 } // namespace PhosphorAnimationLayer
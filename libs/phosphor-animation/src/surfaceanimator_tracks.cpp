@@ -324,6 +324,7 @@ void SurfaceAnimator::Private::connectSurfaceCleanup(PhosphorLayer::Surface* sur
                     // inside a motion callback if a consumer deletes the
                     // Surface there.
                     Track& track = trackIt->second;
+                    retireTrack(track);
                     if (track.opacity) {
                         track.opacity->cancel();
                         m_pendingDestroy.push_back(std::move(track.opacity));
@@ -354,7 +355,7 @@ void SurfaceAnimator::Private::connectSurfaceCleanup(PhosphorLayer::Surface* sur
 /// re-entrant cancel from inside spec.onValueChanged must not
 /// destroy *this mid-advance (AnimatedValue::advance()'s
 /// re-entrancy contract); graveyard
-/// drains on next tickAll. Shader pieces are parked in
+/// drains on the next tick. Shader pieces are parked in
 /// m_pendingReuse (see teardownShaderLeg) so they survive the
 /// external Surface::show()/hide() pre-cancel and can be reclaimed
 /// by the immediately-following beginShow/Hide.
@@ -372,6 +373,7 @@ void SurfaceAnimator::Private::cancelTrackingFor(PhosphorLayer::Surface* surface
     // AV objects themselves, so the cancel() calls below still reach
     // any advance() frame on the stack — m_isAnimating=false makes its
     // post-callback work bail rather than mutate cancelled state.
+    retireTrack(it->second);
     Track track = std::move(it->second);
     m_tracks.erase(it);
     if (track.opacity) {
@@ -573,7 +575,14 @@ void SurfaceAnimator::Private::runLeg(PhosphorLayer::Surface* surface, QQuickIte
         destroyPendingReuseForKey(TrackKey{surface, target});
     }
 
+    // Pace the leg by the target window's frames when it has an exposed
+    // one; otherwise by the steady fallback timer (tickAll promotes the
+    // track once the window is mapped).
+    FrameDriver* driver = frameDriverFor(target);
     PhosphorAnimation::IMotionClock* clock = &m_clock;
+    if (driver) {
+        clock = &driver->clock;
+    }
 
     // When a shader leg is active, it IS the transition — suppress
     // the scale leg so the built-in popin motion doesn't fight the
@@ -619,6 +628,7 @@ void SurfaceAnimator::Private::runLeg(PhosphorLayer::Surface* surface, QQuickIte
         slot.pendingLegs = legCount;
         slot.shaderExclusive = hasShaderLeg;
         slot.targetOpacity = toOpacity;
+        activateTrack(slot, driver);
     }
 
     // When a shader leg is active, the shader IS the entire
@@ -1078,10 +1088,10 @@ void SurfaceAnimator::Private::runLeg(PhosphorLayer::Surface* surface, QQuickIte
         }
     }
 
-    // Kick the driver — ensureDriving is idempotent. Skip if a
-    // re-entrant cancel already drained the map.
-    if (!m_tracks.empty()) {
-        ensureDriving();
+    // Kick the leg's driver — ensureDriving is idempotent. Skip if a
+    // re-entrant cancel already retired the slot.
+    if (const auto it = m_tracks.find(TrackKey{surface, target}); it != m_tracks.end() && it->second.activeIndex >= 0) {
+        ensureDriving(m_active.drivers[it->second.activeIndex]);
     }
 }
 
@@ -1117,6 +1127,7 @@ void SurfaceAnimator::Private::legCompleted(PhosphorLayer::Surface* surface, QQu
     // finds nothing and is a no-op. The AVs go to the graveyard (not
     // destroyed here) because legCompleted runs from inside the very
     // AV's spec.onComplete.
+    retireTrack(it->second);
     Track track = std::move(it->second);
     m_tracks.erase(it);
 
@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/**
+ * @file bench_curvelut.cpp
+ * @brief Per-frame curve cost: analytic evaluate() vs the sampled CurveLut.
+ *
+ * Models a workspace-wide retile — many windows animating at once, each
+ * asking its curve for progress once per frame — three ways:
+ *
+ *   - analytic: a virtual Curve::evaluate() per value (Newton solve for a
+ *     cubic-bezier)
+ *   - sample:   Curve::sample() per value, served from the attached table
+ *   - batch:    one Curve::sampleBatch() over the whole frame
+ *
+ * plus the one-off cost of building the table. Run with:
+ *
+ *   ctest --test-dir build -R bench_curvelut --output-on-failure
+ */
+
+#include <PhosphorAnimation/CurveLut.h>
+#include <PhosphorAnimation/CurveRegistry.h>
+#include <PhosphorAnimation/Easing.h>
+
+#include <QTest>
+
+#include <memory>
+#include <vector>
+
+using PhosphorAnimation::Curve;
+using PhosphorAnimation::CurveLut;
+using PhosphorAnimation::CurveRegistry;
+using PhosphorAnimation::Easing;
+
+namespace {
+
+// Values per frame: 64 windows x (x, y, w, h, opacity), roughly.
+constexpr int kValuesPerFrame = 320;
+
+// Spread progress across the frame like staggered animations would.
+std::vector<qreal> frameProgress()
+{
+    std::vector<qreal> t(kValuesPerFrame);
+    for (int i = 0; i < kValuesPerFrame; ++i) {
+        t[i] = qreal((i * 37) % kValuesPerFrame) / (kValuesPerFrame - 1);
+    }
+    return t;
+}
+
+} // namespace
+
+class BenchCurveLut : public QObject
+{
+    Q_OBJECT
+
+private:
+    CurveRegistry m_registry;
+
+    static void addRows()
+    {
+        QTest::addColumn<QString>("spec");
+        QTest::newRow("OutCubic") << QStringLiteral("0.33,1.00,0.68,1.00");
+        QTest::newRow("ease-in-out") << QStringLiteral("0.42,0.00,0.58,1.00");
+        QTest::newRow("steep") << QStringLiteral("0.90,0.00,0.10,1.00");
+    }
+
+private Q_SLOTS:
+    void analytic_data()
+    {
+        addRows();
+    }
+    void analytic()
+    {
+        QFETCH(QString, spec);
+        const std::shared_ptr<const Curve> curve = std::make_shared<Easing>(Easing::fromString(spec));
+        const std::vector<qreal> t = frameProgress();
+        qreal sink = 0.0;
+        QBENCHMARK {
+            for (qreal v : t) {
+                sink += curve->evaluate(v);
+            }
+        }
+        QVERIFY(sink > 0.0);
+    }
+
+    void sample_data()
+    {
+        addRows();
+    }
+    void sample()
+    {
+        QFETCH(QString, spec);
+        const auto curve = m_registry.create(spec);
+        QVERIFY(curve->lut());
+        const std::vector<qreal> t = frameProgress();
+        qreal sink = 0.0;
+        QBENCHMARK {
+            for (qreal v : t) {
+                sink += curve->sample(v);
+            }
+        }
+        QVERIFY(sink > 0.0);
+    }
+
+    void batch_data()
+    {
+        addRows();
+    }
+    void batch()
+    {
+        QFETCH(QString, spec);
+        const auto curve = m_registry.create(spec);
+        QVERIFY(curve->lut());
+        const std::vector<qreal> t = frameProgress();
+        std::vector<qreal> out(t.size());
+        QBENCHMARK {
+            curve->sampleBatch(t.data(), out.data(), qsizetype(t.size()));
+        }
+        QVERIFY(out.back() >= 0.0);
+    }
+
+    void build_data()
+    {
+        addRows();
+    }
+    void build()
+    {
+        QFETCH(QString, spec);
+        const Easing curve = Easing::fromString(spec);
+        std::shared_ptr<const CurveLut> lut;
+        QBENCHMARK {
+            lut = CurveLut::build(curve);
+        }
+        QVERIFY(lut);
+        qInfo().noquote() << QStringLiteral("%1: %2 intervals, midpoint error %3")
+                                 .arg(spec)
+                                 .arg(lut->intervals())
+                                 .arg(lut->measuredError(), 0, 'g', 3);
+    }
+};
+
+QTEST_GUILESS_MAIN(BenchCurveLut)
+#include "bench_curvelut.moc"
@@ -0,0 +1,200 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <PhosphorAnimation/CurveLut.h>
+#include <PhosphorAnimation/CurveRegistry.h>
+#include <PhosphorAnimation/Easing.h>
+#include <PhosphorAnimation/Spring.h>
+
+#include <QJsonObject>
+#include <QTest>
+
+#include <cmath>
+#include <vector>
+
+using PhosphorAnimation::Curve;
+using PhosphorAnimation::CurveLut;
+using PhosphorAnimation::CurveRegistry;
+using PhosphorAnimation::Easing;
+using PhosphorAnimation::Spring;
+
+namespace {
+
+// Dense enough to land between every pair of samples at MaxIntervals, and
+// deliberately not a multiple of it so most probes sit off the grid.
+constexpr int kProbes = 100003;
+
+qreal worstDeviation(const Curve& curve, const CurveLut& lut)
+{
+    qreal worst = 0.0;
+    for (int i = 0; i <= kProbes; ++i) {
+        const qreal t = qreal(i) / kProbes;
+        worst = std::max(worst, std::abs(lut.evaluate(t) - curve.evaluate(t)));
+    }
+    return worst;
+}
+
+} // namespace
+
+class TestCurveLut : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void testMatchesAnalyticCurve_data()
+    {
+        QTest::addColumn<QString>("spec");
+        QTest::newRow("default OutCubic") << QStringLiteral("0.33,1.00,0.68,1.00");
+        QTest::newRow("ease-in-out") << QStringLiteral("0.42,0.00,0.58,1.00");
+        QTest::newRow("overshoot bezier") << QStringLiteral("0.34,1.56,0.64,1.00");
+        QTest::newRow("steep bezier") << QStringLiteral("0.90,0.00,0.10,1.00");
+        QTest::newRow("css ease") << QStringLiteral("0.25,0.10,0.25,1.00");
+    }
+
+    void testMatchesAnalyticCurve()
+    {
+        // The precision contract: wherever build() hands out a table, it
+        // tracks the analytic curve to MaxError everywhere in [0,1], not
+        // just at the midpoints build() probes. The 2x slack covers the
+        // gap between a midpoint probe and the true per-interval maximum.
+        QFETCH(QString, spec);
+        const auto curve = std::make_shared<Easing>(Easing::fromString(spec));
+        const auto lut = CurveLut::build(*curve);
+        QVERIFY2(lut, qPrintable(spec));
+        QVERIFY(lut->intervals() >= CurveLut::MinIntervals);
+        QVERIFY(lut->intervals() <= CurveLut::MaxIntervals);
+        QVERIFY(lut->measuredError() <= CurveLut::MaxError);
+
+        const qreal worst = worstDeviation(*curve, *lut);
+        QVERIFY2(worst <= 2.0 * CurveLut::MaxError, qPrintable(QStringLiteral("%1: %2").arg(spec).arg(worst)));
+
+        // Endpoints are samples, not interpolations.
+        QCOMPARE(lut->evaluate(0.0), curve->evaluate(0.0));
+        QCOMPARE(lut->evaluate(1.0), curve->evaluate(1.0));
+    }
+
+    void testSmoothBezierStaysCoarse()
+    {
+        // The common case should not pay for resolution it doesn't need:
+        // the default OutCubic settles one doubling above the floor.
+        const Easing outCubic;
+        const auto lut = CurveLut::build(outCubic);
+        QVERIFY(lut);
+        QVERIFY(lut->intervals() <= 2 * CurveLut::MinIntervals);
+    }
+
+    void testUnrepresentableCurvesStayAnalytic()
+    {
+        // Bounce has slope discontinuities at each floor impact; linear
+        // interpolation across one cannot reach MaxError at any sane size.
+        const Easing bounce = Easing::fromString(QStringLiteral("bounce-out:1.0,3"));
+        QVERIFY(!CurveLut::build(bounce));
+
+        // Elastic is cut off at t = 1 while its residual ring is still
+        // ~1e-3 off the target, so it ends in a small step no table can span.
+        const Easing elastic = Easing::fromString(QStringLiteral("elastic-out:1.0,0.3"));
+        QVERIFY(!CurveLut::build(elastic));
+
+        // Stateful curves have no parametric table at all.
+        QVERIFY(!CurveLut::build(Spring::smooth()));
+    }
+
+    void testBatchMatchesScalar()
+    {
+        const Easing curve = Easing::fromString(QStringLiteral("0.42,0.00,0.58,1.00"));
+        const auto lut = CurveLut::build(curve);
+        QVERIFY(lut);
+
+        std::vector<qreal> t;
+        for (int i = -10; i <= 1010; ++i) {
+            t.push_back(qreal(i) / 1000.0);
+        }
+        t.push_back(qQNaN());
+        std::vector<qreal> out(t.size());
+        lut->evaluateBatch(t.data(), out.data(), qsizetype(t.size()));
+        for (size_t i = 0; i < t.size(); ++i) {
+            QCOMPARE(out[i], lut->evaluate(t[i]));
+        }
+        // Out-of-domain inputs clamp rather than read past the table.
+        QCOMPARE(out.front(), 0.0);
+        QCOMPARE(out[t.size() - 2], 1.0);
+    }
+
+    void testRegistryAttachesTable()
+    {
+        CurveRegistry registry;
+        const auto bezier = registry.create(QStringLiteral("0.42,0.00,0.58,1.00"));
+        QVERIFY(bezier->lut());
+
+        // Same spec → same table, sampled once.
+        const auto again = registry.create(QStringLiteral("0.42,0.00,0.58,1.00"));
+        QCOMPARE(again->lut(), bezier->lut());
+
+        // The default fallback gets one too — it is what an empty setting
+        // resolves to on every animation.
+        QVERIFY(registry.create(QString())->lut());
+
+        QVERIFY(!registry.create(QStringLiteral("spring:12.0,0.8"))->lut());
+        QVERIFY(!registry.create(QStringLiteral("bounce-out:1.0,3"))->lut());
+
+        // JSON path (CurveLoader's parseFile) samples at load time.
+        const auto loaded = registry.tryCreateFromJson(QStringLiteral("cubic-bezier"),
+                                                       QJsonObject{{QStringLiteral("x1"), 0.25},
+                                                                   {QStringLiteral("y1"), 0.1},
+                                                                   {QStringLiteral("x2"), 0.25},
+                                                                   {QStringLiteral("y2"), 1.0}});
+        QVERIFY(loaded && loaded->lut());
+    }
+
+    void testSharedFactoryInstanceIsNotMutated()
+    {
+        // A factory handing out one shared instance (as the loader does) must
+        // not see it mutated under concurrent readers — the registry attaches
+        // the table to a private copy instead.
+        CurveRegistry registry;
+        const auto shared = std::make_shared<Easing>(Easing::fromString(QStringLiteral("0.42,0.00,0.58,1.00")));
+        registry.registerFactory(QStringLiteral("shared-test"), [shared](const QString&, const QString&) {
+            return shared;
+        });
+        const auto created = registry.create(QStringLiteral("shared-test"));
+        QVERIFY(created->lut());
+        QVERIFY(created.get() != shared.get());
+        QVERIFY(!shared->lut());
+        QVERIFY(created->equals(*shared));
+    }
+
+    void testSampleFallsBackOutsideDomain()
+    {
+        CurveRegistry registry;
+        const auto curve = registry.create(QStringLiteral("0.34,1.56,0.64,1.00"));
+        QVERIFY(curve->lut());
+        for (qreal t : {0.0, 0.1, 0.37, 0.5, 0.93, 1.0}) {
+            QVERIFY(std::abs(curve->sample(t) - curve->evaluate(t)) <= 2.0 * CurveLut::MaxError);
+        }
+        QCOMPARE(curve->sample(-0.5), curve->evaluate(-0.5));
+        QCOMPARE(curve->sample(1.5), curve->evaluate(1.5));
+
+        const qreal t[] = {-0.5, 0.25, 0.75, 1.5};
+        qreal out[4];
+        curve->sampleBatch(t, out, 4);
+        for (int i = 0; i < 4; ++i) {
+            QCOMPARE(out[i], curve->sample(t[i]));
+        }
+    }
+
+    void testCopyDropsTable()
+    {
+        // Easing's parameters are public; a copy may be edited into another
+        // curve, so it must not inherit a table sampled from the original.
+        CurveRegistry registry;
+        const auto curve = registry.create(QStringLiteral("0.42,0.00,0.58,1.00"));
+        QVERIFY(curve->lut());
+        Easing copy = *static_cast<const Easing*>(curve.get());
+        QVERIFY(!copy.lut());
+        QVERIFY(!curve->clone()->lut());
+    }
+};
+
+QTEST_MAIN(TestCurveLut)
+#include "test_curvelut.moc"
@@ -12,6 +12,8 @@
  *   - per-Role config lookup falls back to defaultConfig
  *   - profile resolution: profile path resolves through registry
  *   - ctor/dtor lifecycle is clean (no leaked Tracks)
+ *   - frame-paced legs complete, and one started after an idle spell is
+ *     timed from its start
  *
  * Coverage gaps (intentional, NOT bugs):
  *   - the `setIsReversed(!isShowLeg)` runtime pushes (runLeg's reuse path
@@ -1119,6 +1121,189 @@ private Q_SLOTS:
 
         delete surface;
     }
+
+    /// A leg on an exposed window is paced by that window's frames
+    /// (afterAnimating) rather than the fallback timer. Whichever driver
+    /// ends up ticking it — offscreen QPA may expose a window without
+    /// rendering, in which case the stall check hands the track back to
+    /// the timer — the leg must reach its end and complete exactly once.
+    void exposed_window_leg_completes_on_frames()
+    {
+        PhosphorLayer::Testing::MockTransport t;
+        PhosphorLayer::Testing::MockScreenProvider s;
+        SurfaceAnimator anim(m_registry, defaultsForTesting());
+        auto deps = PhosphorLayer::Testing::makeDeps(&t, &s);
+        SurfaceFactory f(deps);
+
+        PhosphorLayer::SurfaceConfig sc;
+        sc.role = PhosphorShellPatterns::Modal();
+        sc.contentItem = std::make_unique<QQuickItem>();
+        sc.screen = s.primary();
+        sc.debugName = QStringLiteral("frame-paced");
+
+        auto* surface = f.create(std::move(sc));
+        QVERIFY(surface);
+        surface->warmUp();
+        QQuickWindow* window = surface->window();
+        QVERIFY(window);
+        window->show();
+        // The tests run on the offscreen QPA, which exposes shown windows.
+        QVERIFY(QTest::qWaitForWindowExposed(window));
+        QQuickItem* target = animatedItem(surface);
+        QVERIFY(target);
+
+        int completions = 0;
+        anim.beginShow(surface, target, [&completions]() {
+            ++completions;
+        });
+        QVERIFY(waitFor(
+            [&completions] {
+                return completions == 1;
+            },
+            1000));
+        QVERIFY(target->opacity() >= 0.999);
+        QTest::qWait(50);
+        QCOMPARE(completions, 1);
+
+        delete surface;
+    }
+
+    /// A frame-paced window that stops rendering mid-leg (hidden here)
+    /// must not strand the leg: the stall check moves it to the fallback
+    /// timer and the consumer's onComplete still fires.
+    void hidden_window_mid_leg_still_completes()
+    {
+        const QString path = QStringLiteral("test.frame-stall");
+        m_registry.registerProfile(path, makeProfile(/*durationMs=*/150));
+        struct Cleanup
+        {
+            PhosphorProfileRegistry& reg;
+            QString p;
+            ~Cleanup()
+            {
+                reg.unregisterProfile(p);
+            }
+        } _{m_registry, path};
+
+        SurfaceAnimator::Config cfg;
+        cfg.showProfile = path;
+        cfg.hideProfile = path;
+        SurfaceAnimator anim(m_registry, cfg);
+
+        PhosphorLayer::Testing::MockTransport t;
+        PhosphorLayer::Testing::MockScreenProvider s;
+        auto deps = PhosphorLayer::Testing::makeDeps(&t, &s);
+        SurfaceFactory f(deps);
+
+        PhosphorLayer::SurfaceConfig sc;
+        sc.role = PhosphorShellPatterns::Modal();
+        sc.contentItem = std::make_unique<QQuickItem>();
+        sc.screen = s.primary();
+        sc.debugName = QStringLiteral("frame-stall");
+
+        auto* surface = f.create(std::move(sc));
+        QVERIFY(surface);
+        surface->warmUp();
+        QQuickWindow* window = surface->window();
+        QVERIFY(window);
+        window->show();
+        // The tests run on the offscreen QPA, which exposes shown windows.
+        QVERIFY(QTest::qWaitForWindowExposed(window));
+        QQuickItem* target = animatedItem(surface);
+        QVERIFY(target);
+
+        int completions = 0;
+        anim.beginShow(surface, target, [&completions]() {
+            ++completions;
+        });
+        window->hide();
+        QVERIFY(waitFor(
+            [&completions] {
+                return completions == 1;
+            },
+            1000));
+        QVERIFY(target->opacity() >= 0.999);
+
+        delete surface;
+    }
+
+    /// A leg started on a window's frame clock after an idle spell is timed
+    /// from its start, not from the last frame of the previous spell. The
+    /// test is the frame source: it emits afterAnimating itself, without
+    /// spinning the event loop, so no render-loop frame lands in between.
+    void frame_paced_leg_after_idle_is_not_rebased_by_the_gap()
+    {
+        const QString path = QStringLiteral("test.frame-idle");
+        m_registry.registerProfile(path, makeProfile(/*durationMs=*/200));
+        struct Cleanup
+        {
+            PhosphorProfileRegistry& reg;
+            QString p;
+            ~Cleanup()
+            {
+                reg.unregisterProfile(p);
+            }
+        } _{m_registry, path};
+
+        SurfaceAnimator::Config cfg;
+        cfg.showProfile = path;
+        cfg.hideProfile = path;
+        SurfaceAnimator anim(m_registry, cfg);
+
+        PhosphorLayer::Testing::MockTransport t;
+        PhosphorLayer::Testing::MockScreenProvider s;
+        auto deps = PhosphorLayer::Testing::makeDeps(&t, &s);
+        SurfaceFactory f(deps);
+
+        PhosphorLayer::SurfaceConfig sc;
+        sc.role = PhosphorShellPatterns::Modal();
+        sc.contentItem = std::make_unique<QQuickItem>();
+        sc.screen = s.primary();
+        sc.debugName = QStringLiteral("frame-idle");
+
+        auto* surface = f.create(std::move(sc));
+        QVERIFY(surface);
+        surface->warmUp();
+        QQuickWindow* window = surface->window();
+        QVERIFY(window);
+        window->show();
+        QVERIFY(QTest::qWaitForWindowExposed(window));
+        QQuickItem* target = animatedItem(surface);
+        QVERIFY(target);
+
+        // First leg: leaves the window's clock latched at its last frame.
+        int shows = 0;
+        anim.beginShow(surface, target, [&shows]() {
+            ++shows;
+        });
+        for (int frame = 0; frame < 4 && shows == 0; ++frame) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(80));
+            Q_EMIT window->afterAnimating();
+        }
+        QCOMPARE(shows, 1);
+
+        // The next frame finds the driver idle and drops its hookup; the
+        // clock keeps that frame's time through the idle spell after it,
+        // which outlasts a whole leg.
+        Q_EMIT window->afterAnimating();
+        std::this_thread::sleep_for(std::chrono::milliseconds(400));
+
+        int hides = 0;
+        anim.beginHide(surface, target, [&hides]() {
+            ++hides;
+        });
+        Q_EMIT window->afterAnimating();
+        QCOMPARE(hides, 0);
+        QVERIFY(target->opacity() > 0.5);
+
+        // Paced by the frames that follow: done once the duration passed.
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        Q_EMIT window->afterAnimating();
+        QCOMPARE(hides, 1);
+        QVERIFY(target->opacity() <= 0.001);
+
+        delete surface;
+    }
 };
 
 QTEST_MAIN(TestSurfaceAnimator)
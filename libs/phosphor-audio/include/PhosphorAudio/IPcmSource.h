@@ -0,0 +1,46 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+#include <PhosphorAudio/phosphoraudio_export.h>
+
+#include <QString>
+
+#include <functional>
+
+namespace PhosphorAudio {
+
+/// Raw PCM feed behind NativeSpectrumProvider. The bundled implementation
+/// captures from PipeWire; tests (or a consumer with its own audio path)
+/// inject a source of their own.
+///
+/// A source delivers interleaved stereo float samples (L, R, L, R, ...,
+/// nominally in [-1, 1]) on a thread of its choosing. Mono material is
+/// delivered duplicated into both channels.
+class PHOSPHORAUDIO_EXPORT IPcmSource
+{
+public:
+    /// Receives @p frames stereo frames at @p sampleRate Hz. Called on the
+    /// source's thread, never concurrently with itself.
+    using Consumer = std::function<void(const float* samples, qsizetype frames, int sampleRate)>;
+    /// Reports a failure after a successful start (server gone, target
+    /// removed). Called on the source's thread; capture is dead afterwards.
+    using ErrorHandler = std::function<void(const QString& message)>;
+
+    virtual ~IPcmSource() = default;
+
+    /// Whether start() has a chance of succeeding (backend compiled in and
+    /// its server reachable).
+    virtual bool isAvailable() const = 0;
+
+    /// Begin capturing from @p target ("auto" = the backend's default
+    /// monitor). Returns false with @p error filled on an immediate failure.
+    virtual bool start(const QString& target, Consumer consumer, ErrorHandler onError, QString* error) = 0;
+
+    /// Stop capturing. Once this returns the consumer is not running and is
+    /// never called again. A no-op when not started.
+    virtual void stop() = 0;
+};
+
+} // namespace PhosphorAudio
@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+#include <PhosphorAudio/IAudioSpectrumProvider.h>
+#include <PhosphorAudio/IPcmSource.h>
+
+#include <QString>
+#include <QVector>
+
+#include <memory>
+
+namespace PhosphorAudio {
+
+/// In-process spectrum provider: no `cava` subprocess and no text parsing.
+/// PCM arrives from an IPcmSource on the source's own thread, where a
+/// Hann-windowed FFT, log-frequency binning and cava's smoothing chain
+/// (noise reduction, autosens, monstercat / waves, channel layout, reverse)
+/// turn it into bars. Finished frames cross to this object's thread through
+/// a lock-free triple buffer; spectrumUpdated is emitted there, coalesced to
+/// at most one pending notification.
+///
+/// SpectrumOptions::inputSource names the capture target handed to the
+/// source; inputMethod is ignored (the source is the backend).
+class PHOSPHORAUDIO_EXPORT NativeSpectrumProvider : public IAudioSpectrumProvider
+{
+    Q_OBJECT
+
+public:
+    /// Captures from PipeWire when the library was built with it; otherwise
+    /// the provider reports itself unavailable.
+    explicit NativeSpectrumProvider(QObject* parent = nullptr);
+    /// Captures from @p source (may be null: the provider is then unavailable).
+    explicit NativeSpectrumProvider(std::unique_ptr<IPcmSource> source, QObject* parent = nullptr);
+    ~NativeSpectrumProvider() override;
+
+    /// Whether the library was built with PipeWire capture support.
+    static bool hasPipeWireSupport();
+
+    bool isAvailable() const override;
+    void start() override;
+    void stop() override;
+    bool isRunning() const override;
+
+    SpectrumOptions options() const override;
+    void setOptions(const SpectrumOptions& options) override;
+
+    QVector<float> spectrum() const override;
+
+private:
+    class Private;
+
+    void onPcm(const float* samples, qsizetype frames, int sampleRate);
+    void onSourceError(const QString& message);
+    void takeFrame();
+
+    std::unique_ptr<Private> d;
+};
+
+} // namespace PhosphorAudio
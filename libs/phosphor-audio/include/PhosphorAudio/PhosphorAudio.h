@@ -6,3 +6,5 @@
 #include <PhosphorAudio/AudioDefaults.h>
 #include <PhosphorAudio/CavaSpectrumProvider.h>
 #include <PhosphorAudio/IAudioSpectrumProvider.h>
+#include <PhosphorAudio/IPcmSource.h>
+#include <PhosphorAudio/NativeSpectrumProvider.h>
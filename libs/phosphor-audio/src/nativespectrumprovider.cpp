@@ -0,0 +1,279 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <PhosphorAudio/CavaSpectrumProvider.h>
+#include <PhosphorAudio/NativeSpectrumProvider.h>
+
+#include "spectrumanalyzer.h"
+#ifdef PHOSPHORAUDIO_HAVE_PIPEWIRE
+#include "pipewirepcmsource.h"
+#endif
+
+#include <QLoggingCategory>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace PhosphorAudio {
+
+Q_DECLARE_LOGGING_CATEGORY(lcPhosphorAudio)
+
+namespace {
+
+// Hands finished bar frames from the capture thread to the GUI thread.
+// Three slots rather than two: the writer always owns one, the reader owns
+// one, and the third is exchanged atomically in between, so neither side
+// ever waits and the reader never sees a frame the writer is still filling
+// (a two-slot flip cannot guarantee that without the reader blocking it).
+class FrameBuffer
+{
+public:
+    /// Writer side: the slot to fill next.
+    std::vector<float>& back()
+    {
+        return m_slots[m_back];
+    }
+
+    /// Writer side: make back() the newest frame.
+    void publish()
+    {
+        m_back = m_middle.exchange(m_back | kFresh, std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    /// Reader side: pick up the newest published frame, if one arrived since
+    /// the last call. Returns null when nothing new is there.
+    const std::vector<float>* take()
+    {
+        if (!(m_middle.load(std::memory_order_relaxed) & kFresh)) {
+            return nullptr;
+        }
+        m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & kIndexMask;
+        return &m_slots[m_front];
+    }
+
+    /// Only while no writer is running.
+    void reset()
+    {
+        m_back = 0;
+        m_middle.store(1, std::memory_order_relaxed);
+        m_front = 2;
+    }
+
+private:
+    static constexpr int kIndexMask = 0x3;
+    static constexpr int kFresh = 0x4;
+
+    std::array<std::vector<float>, 3> m_slots;
+    int m_back = 0;
+    std::atomic<int> m_middle{1};
+    int m_front = 2;
+};
+
+} // namespace
+
+class NativeSpectrumProvider::Private
+{
+public:
+    std::unique_ptr<IPcmSource> source;
+    SpectrumOptions options; ///< GUI thread
+    QVector<float> spectrum; ///< GUI thread
+    bool running = false;
+    int generation = 0; ///< bumped per start(), so a late error from an old stream is ignored
+
+    // Capture thread only (and the GUI thread while stopped).
+    SpectrumAnalyzer analyzer;
+    FrameBuffer frames;
+
+    // Option changes made while running: the GUI thread stores the set and
+    // raises the flag; the capture thread applies it before its next
+    // block, taking the mutex only then.
+    QMutex pendingMutex;
+    SpectrumOptions pendingOptions;
+    std::atomic<bool> optionsDirty{false};
+
+    // Set while a takeFrame() call is queued, so a burst of frames costs
+    // one event, not one per frame.
+    std::atomic<bool> notifyPending{false};
+};
+
+NativeSpectrumProvider::NativeSpectrumProvider(QObject* parent)
+#ifdef PHOSPHORAUDIO_HAVE_PIPEWIRE
+    : NativeSpectrumProvider(std::make_unique<PipeWirePcmSource>(), parent)
+#else
+    : NativeSpectrumProvider(nullptr, parent)
+#endif
+{
+}
+
+NativeSpectrumProvider::NativeSpectrumProvider(std::unique_ptr<IPcmSource> source, QObject* parent)
+    : IAudioSpectrumProvider(parent)
+    , d(std::make_unique<Private>())
+{
+    d->source = std::move(source);
+    d->options = CavaSpectrumProvider::normalizedOptions(d->options);
+}
+
+NativeSpectrumProvider::~NativeSpectrumProvider()
+{
+    stop();
+}
+
+bool NativeSpectrumProvider::hasPipeWireSupport()
+{
+#ifdef PHOSPHORAUDIO_HAVE_PIPEWIRE
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool NativeSpectrumProvider::isAvailable() const
+{
+    return d->source && d->source->isAvailable();
+}
+
+void NativeSpectrumProvider::start()
+{
+    if (d->running) {
+        return;
+    }
+    if (!isAvailable()) {
+        Q_EMIT errorOccurred(QStringLiteral("No audio capture backend available for the native spectrum provider."));
+        return;
+    }
+
+    d->analyzer.setOptions(d->options);
+    d->analyzer.reset();
+    d->frames.reset();
+    d->optionsDirty.store(false, std::memory_order_relaxed);
+    d->notifyPending.store(false, std::memory_order_relaxed);
+    d->spectrum.clear();
+
+    const int generation = ++d->generation;
+    QString error;
+    const bool started = d->source->start(
+        d->options.inputSource,
+        [this](const float* samples, qsizetype frames, int sampleRate) {
+            onPcm(samples, frames, sampleRate);
+        },
+        [this, generation](const QString& message) {
+            QMetaObject::invokeMethod(
+                this,
+                [this, generation, message]() {
+                    if (generation == d->generation) {
+                        onSourceError(message);
+                    }
+                },
+                Qt::QueuedConnection);
+        },
+        &error);
+    if (!started) {
+        Q_EMIT errorOccurred(error.isEmpty() ? QStringLiteral("Audio capture failed to start.") : error);
+        return;
+    }
+    d->running = true;
+    Q_EMIT runningChanged(true);
+}
+
+void NativeSpectrumProvider::stop()
+{
+    if (!d->running) {
+        return;
+    }
+    // Returns only once the consumer can no longer run, so the analyzer and
+    // frame buffer are ours again.
+    d->source->stop();
+    d->running = false;
+    d->spectrum.clear();
+    Q_EMIT runningChanged(false);
+}
+
+bool NativeSpectrumProvider::isRunning() const
+{
+    return d->running;
+}
+
+SpectrumOptions NativeSpectrumProvider::options() const
+{
+    return d->options;
+}
+
+void NativeSpectrumProvider::setOptions(const SpectrumOptions& options)
+{
+    const SpectrumOptions normalized = CavaSpectrumProvider::normalizedOptions(options);
+    if (d->options == normalized) {
+        return;
+    }
+    const bool retarget = normalized.inputSource != d->options.inputSource;
+    d->options = normalized;
+    if (!d->running) {
+        return;
+    }
+    // Everything but the capture target is analysis-side and applies in
+    // place on the next block; only a new target needs a new stream.
+    if (retarget) {
+        stop();
+        start();
+        return;
+    }
+    {
+        QMutexLocker locker(&d->pendingMutex);
+        d->pendingOptions = normalized;
+    }
+    d->optionsDirty.store(true, std::memory_order_release);
+}
+
+QVector<float> NativeSpectrumProvider::spectrum() const
+{
+    return d->spectrum;
+}
+
+void NativeSpectrumProvider::onPcm(const float* samples, qsizetype frames, int sampleRate)
+{
+    if (d->optionsDirty.exchange(false, std::memory_order_acquire)) {
+        QMutexLocker locker(&d->pendingMutex);
+        d->analyzer.setOptions(d->pendingOptions);
+    }
+    if (!d->analyzer.process(samples, frames, sampleRate)) {
+        return;
+    }
+    const std::vector<float>& bars = d->analyzer.bars();
+    std::vector<float>& slot = d->frames.back();
+    slot.assign(bars.begin(), bars.end()); // no allocation once the slot has grown to size
+    d->frames.publish();
+    if (!d->notifyPending.exchange(true, std::memory_order_acq_rel)) {
+        QMetaObject::invokeMethod(this, &NativeSpectrumProvider::takeFrame, Qt::QueuedConnection);
+    }
+}
+
+void NativeSpectrumProvider::takeFrame()
+{
+    d->notifyPending.store(false, std::memory_order_release);
+    // A notification queued just before stop() must not resurrect the
+    // spectrum stop() cleared.
+    if (!d->running) {
+        return;
+    }
+    const std::vector<float>* frame = d->frames.take();
+    if (!frame) {
+        return;
+    }
+    d->spectrum.resize(qsizetype(frame->size()));
+    std::copy(frame->begin(), frame->end(), d->spectrum.begin());
+    Q_EMIT spectrumUpdated(d->spectrum);
+}
+
+void NativeSpectrumProvider::onSourceError(const QString& message)
+{
+    if (!d->running) {
+        return;
+    }
+    qCWarning(lcPhosphorAudio) << message;
+    stop();
+    Q_EMIT errorOccurred(message);
+}
+
+} // namespace PhosphorAudio
@@ -0,0 +1,191 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "pipewirepcmsource.h"
+
+#include <QFileInfo>
+#include <QLoggingCategory>
+#include <QStandardPaths>
+
+#include <pipewire/pipewire.h>
+#include <spa/param/audio/format-utils.h>
+
+#include <algorithm>
+#include <mutex>
+
+namespace PhosphorAudio {
+
+Q_DECLARE_LOGGING_CATEGORY(lcPhosphorAudio)
+
+namespace {
+
+constexpr int kChannels = 2;
+
+std::once_flag g_pwInitOnce;
+
+void ensurePipeWireInit()
+{
+    // pw_init is reference counted, so sharing the process with
+    // phosphor-service-pipewire (which makes its own call) is fine.
+    std::call_once(g_pwInitOnce, [] {
+        pw_init(nullptr, nullptr);
+    });
+}
+
+} // namespace
+
+struct PipeWirePcmSource::Callbacks
+{
+    static void stateChanged(void* data, pw_stream_state, pw_stream_state state, const char* error)
+    {
+        auto* self = static_cast<PipeWirePcmSource*>(data);
+        if (state == PW_STREAM_STATE_ERROR && self->m_onError) {
+            self->m_onError(QStringLiteral("PipeWire capture failed: %1")
+                                .arg(error ? QString::fromUtf8(error) : QStringLiteral("unknown error")));
+        }
+    }
+
+    static void paramChanged(void* data, uint32_t id, const spa_pod* param)
+    {
+        auto* self = static_cast<PipeWirePcmSource*>(data);
+        if (!param || id != SPA_PARAM_Format) {
+            return;
+        }
+        uint32_t mediaType = 0;
+        uint32_t mediaSubtype = 0;
+        if (spa_format_parse(param, &mediaType, &mediaSubtype) < 0 || mediaType != SPA_MEDIA_TYPE_audio
+            || mediaSubtype != SPA_MEDIA_SUBTYPE_raw) {
+            return;
+        }
+        spa_audio_info_raw info{};
+        if (spa_format_audio_raw_parse(param, &info) >= 0 && info.rate > 0) {
+            self->m_sampleRate = int(info.rate);
+        }
+    }
+
+    static void process(void* data)
+    {
+        auto* self = static_cast<PipeWirePcmSource*>(data);
+        pw_buffer* buffer = pw_stream_dequeue_buffer(self->m_stream);
+        if (!buffer) {
+            return;
+        }
+        const spa_data& chunkData = buffer->buffer->datas[0];
+        if (chunkData.data && chunkData.chunk) {
+            const uint32_t offset = std::min(chunkData.chunk->offset, chunkData.maxsize);
+            const uint32_t size = std::min(chunkData.chunk->size, chunkData.maxsize - offset);
+            const auto* samples = SPA_PTROFF(chunkData.data, offset, const float);
+            const qsizetype frames = size / (sizeof(float) * kChannels);
+            if (frames > 0) {
+                self->m_consumer(samples, frames, self->m_sampleRate);
+            }
+        }
+        pw_stream_queue_buffer(self->m_stream, buffer);
+    }
+
+    static const pw_stream_events kEvents;
+};
+
+const pw_stream_events PipeWirePcmSource::Callbacks::kEvents = {
+    .version = PW_VERSION_STREAM_EVENTS,
+    .state_changed = &Callbacks::stateChanged,
+    .param_changed = &Callbacks::paramChanged,
+    .process = &Callbacks::process,
+};
+
+PipeWirePcmSource::PipeWirePcmSource() = default;
+
+PipeWirePcmSource::~PipeWirePcmSource()
+{
+    stop();
+}
+
+bool PipeWirePcmSource::isAvailable() const
+{
+    // Same probe CavaSpectrumProvider uses to pick its backend: the socket
+    // of a running server in the runtime dir (or an explicit remote).
+    if (!qEnvironmentVariableIsEmpty("PIPEWIRE_REMOTE")) {
+        return true;
+    }
+    const QString runtimeDir = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation);
+    return !runtimeDir.isEmpty() && QFileInfo::exists(runtimeDir + QStringLiteral("/pipewire-0"));
+}
+
+bool PipeWirePcmSource::start(const QString& target, Consumer consumer, ErrorHandler onError, QString* error)
+{
+    if (m_loop) {
+        return true;
+    }
+    ensurePipeWireInit();
+    m_consumer = std::move(consumer);
+    m_onError = std::move(onError);
+    m_sampleRate = 48000;
+
+    // The loop thread is not running yet, so the stream can be set up
+    // without taking the loop lock; from pw_thread_loop_start on every
+    // callback runs on that thread.
+    m_loop = pw_thread_loop_new("phosphor-audio", nullptr);
+    pw_properties* props = pw_properties_new(PW_KEY_MEDIA_TYPE, "Audio", PW_KEY_MEDIA_CATEGORY, "Capture",
+                                             PW_KEY_MEDIA_ROLE, "Music", PW_KEY_NODE_NAME, "phosphor-audio-spectrum",
+                                             nullptr);
+    if (m_loop && props) {
+        if (target.isEmpty() || target == QLatin1String("auto")) {
+            pw_properties_set(props, PW_KEY_STREAM_CAPTURE_SINK, "true");
+        } else {
+            pw_properties_set(props, PW_KEY_TARGET_OBJECT, target.toUtf8().constData());
+        }
+        // Takes ownership of props, also on failure.
+        m_stream = pw_stream_new_simple(pw_thread_loop_get_loop(m_loop), "phosphor-audio-spectrum", props,
+                                        &Callbacks::kEvents, this);
+        props = nullptr;
+    }
+    if (props) {
+        pw_properties_free(props);
+    }
+
+    bool ok = m_stream != nullptr;
+    if (ok) {
+        // Format and channel count are pinned (the adapter converts); the
+        // rate is left open so the stream runs at the graph rate with no
+        // resampling, and is picked up in paramChanged.
+        uint8_t podBuffer[1024];
+        spa_pod_builder builder = SPA_POD_BUILDER_INIT(podBuffer, sizeof(podBuffer));
+        spa_audio_info_raw info{};
+        info.format = SPA_AUDIO_FORMAT_F32;
+        info.channels = kChannels;
+        info.position[0] = SPA_AUDIO_CHANNEL_FL;
+        info.position[1] = SPA_AUDIO_CHANNEL_FR;
+        const spa_pod* params[] = {spa_format_audio_raw_build(&builder, SPA_PARAM_EnumFormat, &info)};
+        const auto flags = pw_stream_flags(PW_STREAM_FLAG_AUTOCONNECT | PW_STREAM_FLAG_MAP_BUFFERS);
+        ok = pw_stream_connect(m_stream, PW_DIRECTION_INPUT, PW_ID_ANY, flags, params, 1) == 0
+            && pw_thread_loop_start(m_loop) == 0;
+    }
+    if (!ok) {
+        if (error) {
+            *error = QStringLiteral("Could not open a PipeWire capture stream");
+        }
+        qCWarning(lcPhosphorAudio) << "PipeWire capture stream setup failed for target" << target;
+        stop();
+        return false;
+    }
+    return true;
+}
+
+void PipeWirePcmSource::stop()
+{
+    if (!m_loop) {
+        return;
+    }
+    // Joins the loop thread: no callback is running or will run after this.
+    pw_thread_loop_stop(m_loop);
+    if (m_stream) {
+        pw_stream_destroy(m_stream);
+        m_stream = nullptr;
+    }
+    pw_thread_loop_destroy(m_loop);
+    m_loop = nullptr;
+    m_consumer = nullptr;
+    m_onError = nullptr;
+}
+
+} // namespace PhosphorAudio
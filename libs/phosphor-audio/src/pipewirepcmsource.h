@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+// Internal (not installed) PipeWire capture behind NativeSpectrumProvider.
+// Only compiled when the library is built with PHOSPHORAUDIO_HAVE_PIPEWIRE;
+// libpipewire types stay out of every public header.
+
+#include <PhosphorAudio/IPcmSource.h>
+
+struct pw_stream;
+struct pw_thread_loop;
+
+namespace PhosphorAudio {
+
+/// Captures a stereo F32 stream at the graph rate on a dedicated
+/// pw_thread_loop. "auto" follows the default sink's monitor (what is
+/// playing); any other target is passed as the node to link to.
+class PipeWirePcmSource : public IPcmSource
+{
+public:
+    PipeWirePcmSource();
+    ~PipeWirePcmSource() override;
+
+    bool isAvailable() const override;
+    bool start(const QString& target, Consumer consumer, ErrorHandler onError, QString* error) override;
+    void stop() override;
+
+private:
+    struct Callbacks; ///< the pw_stream_events trampolines, in the .cpp
+
+    pw_thread_loop* m_loop = nullptr;
+    pw_stream* m_stream = nullptr;
+    Consumer m_consumer;
+    ErrorHandler m_onError;
+    int m_sampleRate = 48000; ///< touched on the loop thread only while running
+};
+
+} // namespace PhosphorAudio
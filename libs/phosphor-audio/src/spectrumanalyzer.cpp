@@ -0,0 +1,384 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "spectrumanalyzer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace PhosphorAudio {
+
+namespace {
+
+// Below this peak sample level a window counts as silence: autosens holds
+// its gain instead of ramping up into the noise floor.
+constexpr float kSilenceLevel = 1.0e-5f;
+
+// cava's smoothing constants (cavacore.c): gravity acceleration per frame,
+// autosens step sizes, and the quadratic fall-off of the waves filter, the
+// latter expressed against a 100-row bar height since our bars are 0..1.
+constexpr float kFallStep = 0.028f;
+constexpr double kAutosensDown = 0.98;
+constexpr double kAutosensUp = 1.001;
+constexpr double kAutosensInitialUp = 1.1;
+constexpr float kWaveRows = 100.0f;
+
+// Keeps a runaway autosens (long silence just above kSilenceLevel, or a
+// clipping source) within a range it can recover from in a few seconds.
+constexpr double kMinGain = 1.0e-3;
+constexpr double kMaxGain = 1.0e4;
+
+int reverseBits(int value, int bits)
+{
+    int out = 0;
+    for (int i = 0; i < bits; ++i) {
+        out = (out << 1) | (value & 1);
+        value >>= 1;
+    }
+    return out;
+}
+
+// Copy a ring oldest-first: [oldest, end) then [0, oldest).
+void unroll(const std::vector<float>& ring, int oldest, float* out)
+{
+    const auto split = ring.begin() + oldest;
+    std::copy(ring.begin(), split, std::copy(split, ring.end(), out));
+}
+
+} // namespace
+
+void Fft::setSize(int size)
+{
+    m_size = size;
+    int bits = 0;
+    while ((1 << bits) < size) {
+        ++bits;
+    }
+    m_swaps.clear();
+    for (int i = 0; i < size; ++i) {
+        const int j = reverseBits(i, bits);
+        if (i < j) {
+            m_swaps.push_back(i);
+            m_swaps.push_back(j);
+        }
+    }
+    m_twiddleRe.assign(size, 0.0f);
+    m_twiddleIm.assign(size, 0.0f);
+    for (int half = 1; half < size; half *= 2) {
+        for (int j = 0; j < half; ++j) {
+            const double angle = -std::numbers::pi * j / half;
+            m_twiddleRe[half + j] = float(std::cos(angle));
+            m_twiddleIm[half + j] = float(std::sin(angle));
+        }
+    }
+}
+
+void Fft::forward(float* re, float* im) const
+{
+    for (size_t i = 0; i < m_swaps.size(); i += 2) {
+        std::swap(re[m_swaps[i]], re[m_swaps[i + 1]]);
+        std::swap(im[m_swaps[i]], im[m_swaps[i + 1]]);
+    }
+    for (int half = 1; half < m_size; half *= 2) {
+        const float* wr = m_twiddleRe.data() + half;
+        const float* wi = m_twiddleIm.data() + half;
+        for (int block = 0; block < m_size; block += 2 * half) {
+            float* ar = re + block;
+            float* ai = im + block;
+            float* br = ar + half;
+            float* bi = ai + half;
+            for (int j = 0; j < half; ++j) {
+                const float tr = br[j] * wr[j] - bi[j] * wi[j];
+                const float ti = br[j] * wi[j] + bi[j] * wr[j];
+                br[j] = ar[j] - tr;
+                bi[j] = ai[j] - ti;
+                ar[j] += tr;
+                ai[j] += ti;
+            }
+        }
+    }
+}
+
+void SpectrumAnalyzer::setOptions(const SpectrumOptions& options)
+{
+    m_options = options;
+    if (m_sampleRate > 0) {
+        rebuild();
+    }
+}
+
+void SpectrumAnalyzer::reset()
+{
+    // The next process() sees a "new" rate and rebuilds from scratch.
+    m_sampleRate = 0;
+    m_bars.clear();
+    m_haveBars = false;
+}
+
+bool SpectrumAnalyzer::process(const float* samples, qsizetype frames, int sampleRate)
+{
+    if (sampleRate <= 0 || frames <= 0) {
+        return false;
+    }
+    if (sampleRate != m_sampleRate) {
+        m_sampleRate = sampleRate;
+        rebuild();
+    }
+    const int mask = m_fft.size() - 1;
+    bool produced = false;
+    // Analyze at every hop boundary inside the buffer, not once per call: a
+    // server quantum longer than the frame interval would otherwise slow the
+    // smoothing clock (gravity, autosens) down to the callback rate.
+    while (frames > 0) {
+        const int chunk = int(std::min<qsizetype>(frames, m_hop - m_sinceFrame));
+        for (int i = 0; i < chunk; ++i) {
+            m_left[m_write] = samples[2 * i];
+            m_right[m_write] = samples[2 * i + 1];
+            m_write = (m_write + 1) & mask;
+        }
+        samples += 2 * chunk;
+        frames -= chunk;
+        m_sinceFrame += chunk;
+        if (m_sinceFrame == m_hop) {
+            m_sinceFrame = 0;
+            analyze();
+            produced = true;
+        }
+    }
+    return produced;
+}
+
+void SpectrumAnalyzer::rebuild()
+{
+    // ~85 ms of audio: 4096 points at 44.1 / 48 kHz (11.7 Hz resolution),
+    // doubling with the rate so the low bars keep their resolution.
+    int size = 4096;
+    while (size < m_sampleRate / 12) {
+        size *= 2;
+    }
+    m_fft.setSize(size);
+    m_hop = std::max(1, m_sampleRate / m_options.framerate);
+    m_sinceFrame = 0;
+
+    m_left.assign(size, 0.0f);
+    m_right.assign(size, 0.0f);
+    m_write = 0;
+    m_re.assign(size, 0.0f);
+    m_im.assign(size, 0.0f);
+    m_magLeft.assign(size / 2 + 1, 0.0f);
+    m_magRight.assign(size / 2 + 1, 0.0f);
+    m_window.resize(size);
+    for (int i = 0; i < size; ++i) {
+        m_window[i] = float(0.5 * (1.0 - std::cos(2.0 * std::numbers::pi * i / size)));
+    }
+
+    // Log-spaced bar edges between the cutoffs, mapped to FFT bins. Where
+    // several low bars would land on the same bin each is pushed one bin
+    // up, as cava does, so every bar tracks its own bin.
+    m_channelBars = m_options.channelMode == ChannelMode::Stereo ? m_options.barCount / 2 : m_options.barCount;
+    m_binLow.resize(m_channelBars);
+    m_binHigh.resize(m_channelBars);
+    const double binHz = double(m_sampleRate) / size;
+    const double low = m_options.lowerCutoffHz;
+    const double high = std::max(low * 2.0, std::min<double>(m_options.higherCutoffHz, m_sampleRate / 2.0));
+    const int lastBin = size / 2 - 1;
+    int previous = 0; // bin 0 (DC) is never part of a bar
+    for (int b = 0; b < m_channelBars; ++b) {
+        const double from = low * std::pow(high / low, double(b) / m_channelBars);
+        const double to = low * std::pow(high / low, double(b + 1) / m_channelBars);
+        const int first = std::min(std::max(previous + 1, int(std::lround(from / binHz))), lastBin);
+        const int last = std::min(std::max(first, int(std::lround(to / binHz)) - 1), lastBin);
+        m_binLow[b] = first;
+        m_binHigh[b] = last;
+        previous = last;
+    }
+
+    const int total = m_options.barCount;
+    m_peak.assign(total, 0.0f);
+    m_fall.assign(total, 0.0f);
+    m_previous.assign(total, 0.0f);
+    m_memory.assign(total, 0.0f);
+    m_frame.assign(total, 0.0f);
+    m_bars.assign(total, 0.0f);
+    m_haveBars = false;
+
+    m_gain = m_options.sensitivity / 100.0;
+    m_senseLow = true;
+    m_noiseReduction = m_options.noiseReduction / 100.0f;
+    // cava disables gravity for noise_reduction <= 0.1 (and divides by it).
+    m_gravity = m_noiseReduction > 0.1f
+        ? float(std::pow(60.0 / m_options.framerate, 2.5) * 1.54 / m_noiseReduction)
+        : 0.0f;
+}
+
+void SpectrumAnalyzer::analyze()
+{
+    const int size = m_fft.size();
+    float* re = m_re.data();
+    float* im = m_im.data();
+    const float* window = m_window.data();
+
+    // Both channels go through one complex FFT (left real, right
+    // imaginary) and are separated afterwards by conjugate symmetry; the
+    // mono modes fold to the real part and leave the imaginary part zero.
+    unroll(m_left, m_write, re);
+    unroll(m_right, m_write, im);
+    float level = 0.0f;
+    for (int i = 0; i < size; ++i) {
+        level = std::max(level, std::max(std::abs(re[i]), std::abs(im[i])));
+    }
+    switch (m_options.channelMode) {
+    case ChannelMode::Stereo:
+        for (int i = 0; i < size; ++i) {
+            re[i] *= window[i];
+            im[i] *= window[i];
+        }
+        break;
+    case ChannelMode::MonoAverage:
+        for (int i = 0; i < size; ++i) {
+            re[i] = 0.5f * (re[i] + im[i]) * window[i];
+            im[i] = 0.0f;
+        }
+        break;
+    case ChannelMode::MonoLeft:
+        for (int i = 0; i < size; ++i) {
+            re[i] *= window[i];
+            im[i] = 0.0f;
+        }
+        break;
+    case ChannelMode::MonoRight:
+        for (int i = 0; i < size; ++i) {
+            re[i] = im[i] * window[i];
+            im[i] = 0.0f;
+        }
+        break;
+    }
+    const bool silent = level < kSilenceLevel;
+
+    m_fft.forward(re, im);
+
+    // X_left[k] = (Z[k] + conj Z[N-k]) / 2, X_right[k] = (Z[k] - conj Z[N-k]) / 2i.
+    // A one-sided Hann-windowed bin needs 4/N (coherent gain 1/2, two-sided
+    // split 1/2); the sums below are 2 X[k], hence 2/N. A full-scale sine
+    // reads ~1.0 in its bin.
+    const float scale = 2.0f / size;
+    float* magLeft = m_magLeft.data();
+    float* magRight = m_magRight.data();
+    for (int k = 1; k <= size / 2; ++k) {
+        const int mirror = size - k;
+        const float sumRe = re[k] + re[mirror];
+        const float diffIm = im[k] - im[mirror];
+        const float sumIm = im[k] + im[mirror];
+        const float diffRe = re[k] - re[mirror];
+        magLeft[k] = scale * std::sqrt(sumRe * sumRe + diffIm * diffIm);
+        magRight[k] = scale * std::sqrt(sumIm * sumIm + diffRe * diffRe);
+    }
+
+    // A bar is the sum of its bins. With log-spaced bars the bin count grows
+    // with frequency, which is the same high-end tilt cava gets from its
+    // per-bar equalizer over the bin average.
+    const int channels = m_options.channelMode == ChannelMode::Stereo ? 2 : 1;
+    const int total = channels * m_channelBars;
+    const float gain = float(m_gain);
+    for (int c = 0; c < channels; ++c) {
+        const float* mag = c == 0 ? magLeft : magRight;
+        for (int b = 0; b < m_channelBars; ++b) {
+            float sum = 0.0f;
+            for (int k = m_binLow[b]; k <= m_binHigh[b]; ++k) {
+                sum += mag[k];
+            }
+            m_frame[c * m_channelBars + b] = sum * gain;
+        }
+    }
+
+    // cava's noise reduction: gravity fall-off from the last peak, then an
+    // integral over previous frames. The integral is normalized here (new
+    // value weighted 1 - nr) so a steady tone settles at its own level and
+    // the autosens-off output does not scale with the smoothing setting.
+    bool overshoot = false;
+    for (int j = 0; j < total; ++j) {
+        float value = m_frame[j];
+        if (m_gravity > 0.0f && value < m_previous[j]) {
+            value = std::max(0.0f, m_peak[j] * (1.0f - m_fall[j] * m_fall[j] * m_gravity));
+            m_fall[j] += kFallStep;
+        } else {
+            m_peak[j] = value;
+            m_fall[j] = 0.0f;
+        }
+        m_previous[j] = value;
+        value = m_memory[j] * m_noiseReduction + value * (1.0f - m_noiseReduction);
+        m_memory[j] = value;
+        if (value > 1.0f) {
+            overshoot = true;
+            value = 1.0f;
+        }
+        m_frame[j] = value;
+    }
+
+    if (m_options.autosens) {
+        if (overshoot) {
+            m_gain *= kAutosensDown;
+            m_senseLow = false;
+        } else if (!silent) {
+            m_gain *= kAutosensUp;
+            if (m_senseLow) {
+                m_gain *= kAutosensInitialUp;
+            }
+        }
+        m_gain = std::clamp(m_gain, kMinGain, kMaxGain);
+    }
+
+    for (int c = 0; c < channels; ++c) {
+        float* block = m_frame.data() + c * m_channelBars;
+        spread(block, m_channelBars);
+        if (m_options.reverse) {
+            std::reverse(block, block + m_channelBars);
+        }
+    }
+
+    const float retain = float(m_options.extraSmoothing);
+    if (retain > 0.0f && m_haveBars) {
+        for (int j = 0; j < total; ++j) {
+            m_bars[j] = (1.0f - retain) * m_frame[j] + retain * m_bars[j];
+        }
+    } else {
+        std::copy(m_frame.begin(), m_frame.end(), m_bars.begin());
+    }
+    m_haveBars = true;
+}
+
+void SpectrumAnalyzer::spread(float* bars, int count) const
+{
+    // cava's monstercat / waves filters: every bar lifts its neighbours to
+    // a level falling off with distance (geometrically for monstercat,
+    // quadratically for waves). Waves wins when both are set, as in cava.
+    if (m_options.waves) {
+        for (int z = 0; z < count; ++z) {
+            bars[z] /= 1.25f;
+            for (int m = z - 1; m >= 0; --m) {
+                const float d = float(z - m);
+                bars[m] = std::max(bars[z] - d * d / kWaveRows, bars[m]);
+            }
+            for (int m = z + 1; m < count; ++m) {
+                const float d = float(m - z);
+                bars[m] = std::max(bars[z] - d * d / kWaveRows, bars[m]);
+            }
+        }
+    } else if (m_options.monstercat) {
+        for (int z = 0; z < count; ++z) {
+            float falloff = bars[z];
+            for (int m = z - 1; m >= 0 && falloff > 0.0f; --m) {
+                falloff /= 1.5f;
+                bars[m] = std::max(falloff, bars[m]);
+            }
+            falloff = bars[z];
+            for (int m = z + 1; m < count && falloff > 0.0f; ++m) {
+                falloff /= 1.5f;
+                bars[m] = std::max(falloff, bars[m]);
+            }
+        }
+    }
+}
+
+} // namespace PhosphorAudio
@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+// Internal (not installed) DSP core of NativeSpectrumProvider: turns a stream
+// of interleaved stereo float PCM into bar frames shaped by SpectrumOptions,
+// following cava's processing chain. Not thread-safe; the provider drives one
+// instance from the PCM source's thread only.
+
+#include <PhosphorAudio/IAudioSpectrumProvider.h>
+
+#include <vector>
+
+namespace PhosphorAudio {
+
+/// Iterative radix-2 complex FFT, in place over split real / imaginary
+/// arrays. Each stage's twiddles are stored contiguously so the butterfly
+/// loop is a unit-stride pass over four float arrays, which the compiler
+/// vectorizes without intrinsics.
+class Fft
+{
+public:
+    /// @p size must be a power of two >= 2.
+    void setSize(int size);
+    int size() const
+    {
+        return m_size;
+    }
+    void forward(float* re, float* im) const;
+
+private:
+    int m_size = 0;
+    std::vector<int> m_swaps; ///< bit-reversal pairs (i, j), i < j, flattened
+    std::vector<float> m_twiddleRe; ///< stage with half-span h at [h, 2h)
+    std::vector<float> m_twiddleIm;
+};
+
+class SpectrumAnalyzer
+{
+public:
+    /// Apply an already-normalized option set. Resets the smoothing state.
+    void setOptions(const SpectrumOptions& options);
+
+    /// Drop buffered audio and smoothing state (next capture starts clean).
+    void reset();
+
+    /// Feed @p frames interleaved stereo frames. Returns true when at least
+    /// one bar frame completed; bars() then holds the newest.
+    bool process(const float* samples, qsizetype frames, int sampleRate);
+
+    const std::vector<float>& bars() const
+    {
+        return m_bars;
+    }
+
+    /// Per-bin magnitudes of the newest window, indexed by FFT bin (0 = DC,
+    /// never filled). @p channel 1 is the right channel, only meaningful in
+    /// ChannelMode::Stereo; the mono modes analyze into channel 0.
+    const std::vector<float>& magnitudes(int channel) const
+    {
+        return channel == 0 ? m_magLeft : m_magRight;
+    }
+
+    int fftSize() const
+    {
+        return m_fft.size();
+    }
+
+private:
+    void rebuild();
+    void analyze();
+    void spread(float* bars, int count) const;
+
+    SpectrumOptions m_options;
+    int m_sampleRate = 0;
+    int m_hop = 1; ///< samples per output frame
+    int m_sinceFrame = 0;
+    int m_channelBars = 0; ///< bars per analyzed channel
+    Fft m_fft;
+
+    // Ring of the last fftSize samples per channel; m_write is the oldest.
+    std::vector<float> m_left;
+    std::vector<float> m_right;
+    int m_write = 0;
+
+    std::vector<float> m_window;
+    std::vector<float> m_re;
+    std::vector<float> m_im;
+    std::vector<float> m_magLeft;
+    std::vector<float> m_magRight;
+    std::vector<int> m_binLow; ///< per channel bar, inclusive FFT bin range
+    std::vector<int> m_binHigh;
+
+    // cava's per-bar smoothing state, all channels concatenated.
+    std::vector<float> m_peak;
+    std::vector<float> m_fall;
+    std::vector<float> m_previous;
+    std::vector<float> m_memory;
+    std::vector<float> m_frame;
+    std::vector<float> m_bars;
+    double m_gain = 1.0;
+    bool m_senseLow = true;
+    bool m_haveBars = false;
+    float m_noiseReduction = 0.0f;
+    float m_gravity = 0.0f;
+};
+
+} // namespace PhosphorAudio
@@ -4,12 +4,110 @@
 #include <PhosphorAudio/AudioDefaults.h>
 #include <PhosphorAudio/CavaSpectrumProvider.h>
 #include <PhosphorAudio/IAudioSpectrumProvider.h>
+#include <PhosphorAudio/IPcmSource.h>
+#include <PhosphorAudio/NativeSpectrumProvider.h>
 
+#include "spectrumanalyzer.h"
+
+#include <QSignalSpy>
 #include <QTest>
 
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <thread>
+#include <vector>
+
 using PhosphorAudio::ChannelMode;
 using PhosphorAudio::SpectrumOptions;
 
+namespace {
+
+// Stands in for a capture backend: start() just records the consumer, and
+// the test pushes sine PCM through it on whatever thread it likes.
+class SyntheticPcmSource : public PhosphorAudio::IPcmSource
+{
+public:
+    bool isAvailable() const override
+    {
+        return true;
+    }
+
+    bool start(const QString& target, Consumer consumer, ErrorHandler onError, QString*) override
+    {
+        lastTarget = target;
+        m_consumer = std::move(consumer);
+        m_onError = std::move(onError);
+        ++starts;
+        return true;
+    }
+
+    void stop() override
+    {
+        m_consumer = nullptr;
+        m_onError = nullptr;
+        ++stops;
+    }
+
+    // @p seconds of 48 kHz stereo in 10 ms blocks; 0 Hz = silence on that channel.
+    void feed(double leftHz, double rightHz, double seconds, float amplitude = 0.3f)
+    {
+        constexpr int kRate = 48000;
+        constexpr int kBlock = 480;
+        std::vector<float> block(2 * kBlock);
+        const int blocks = int(seconds * kRate / kBlock);
+        for (int b = 0; b < blocks && m_consumer; ++b) {
+            for (int i = 0; i < kBlock; ++i) {
+                const double t = double(m_frame++) / kRate;
+                block[2 * i] = leftHz > 0 ? amplitude * float(std::sin(2 * std::numbers::pi * leftHz * t)) : 0.0f;
+                block[2 * i + 1] = rightHz > 0 ? amplitude * float(std::sin(2 * std::numbers::pi * rightHz * t)) : 0.0f;
+            }
+            m_consumer(block.data(), kBlock, kRate);
+        }
+    }
+
+    void fail(const QString& message)
+    {
+        if (m_onError) {
+            m_onError(message);
+        }
+    }
+
+    QString lastTarget;
+    int starts = 0;
+    int stops = 0;
+
+private:
+    Consumer m_consumer;
+    ErrorHandler m_onError;
+    qint64 m_frame = 0;
+};
+
+// Unsmoothed, fixed-gain options so a bar frame reflects only the current
+// window: the tests then read the analysis, not the smoothing dynamics.
+SpectrumOptions rawOptions(ChannelMode mode)
+{
+    SpectrumOptions opts;
+    opts.barCount = 32;
+    opts.channelMode = mode;
+    opts.autosens = false;
+    opts.noiseReduction = 0;
+    opts.extraSmoothing = 0.0;
+    return opts;
+}
+
+qsizetype peakIndex(const QVector<float>& bars, qsizetype from, qsizetype to)
+{
+    return std::max_element(bars.begin() + from, bars.begin() + to) - bars.begin();
+}
+
+float peakValue(const QVector<float>& bars, qsizetype from, qsizetype to)
+{
+    return *std::max_element(bars.begin() + from, bars.begin() + to);
+}
+
+} // namespace
+
 class TestPhosphorAudio : public QObject
 {
     Q_OBJECT
@@ -211,6 +309,166 @@ private Q_SLOTS:
         QCOMPARE(iface->options().channelMode, ChannelMode::MonoAverage);
         QVERIFY(iface->options().monstercat);
     }
+
+    // The magnitude scale pins a full-scale sine to ~1.0 in its bin. Two
+    // windows of a bin-centred tone, so the newest window holds whole periods
+    // and there is no leakage beyond the Hann main lobe.
+    void testAnalyzerFullScaleSineReadsUnity()
+    {
+        PhosphorAudio::SpectrumAnalyzer analyzer;
+        analyzer.setOptions(rawOptions(ChannelMode::Stereo));
+        constexpr int kRate = 48000;
+        constexpr int kSize = 4096;
+        constexpr int kBin = 85; // ~996 Hz
+        const double hz = double(kRate) * kBin / kSize;
+        std::vector<float> pcm(2 * 2 * kSize);
+        for (int i = 0; i < 2 * kSize; ++i) {
+            const float s = float(std::sin(2 * std::numbers::pi * hz * i / kRate));
+            pcm[2 * i] = s;
+            pcm[2 * i + 1] = 0.5f * s;
+        }
+        QVERIFY(analyzer.process(pcm.data(), 2 * kSize, kRate));
+        QCOMPARE(analyzer.fftSize(), kSize);
+        QVERIFY(std::abs(analyzer.magnitudes(0)[kBin] - 1.0f) < 1.0e-3f);
+        QVERIFY(std::abs(analyzer.magnitudes(1)[kBin] - 0.5f) < 1.0e-3f);
+        // Hann main lobe: the neighbours carry half, the next bin out nothing.
+        QVERIFY(std::abs(analyzer.magnitudes(0)[kBin + 1] - 0.5f) < 1.0e-3f);
+        QVERIFY(analyzer.magnitudes(0)[kBin + 2] < 1.0e-3f);
+    }
+
+    void testNativeProviderWithoutSource()
+    {
+        PhosphorAudio::NativeSpectrumProvider provider(std::unique_ptr<PhosphorAudio::IPcmSource>{});
+        QVERIFY(!provider.isAvailable());
+        QSignalSpy errors(&provider, &PhosphorAudio::IAudioSpectrumProvider::errorOccurred);
+        provider.start();
+        QCOMPARE(errors.count(), 1);
+        QVERIFY(!provider.isRunning());
+    }
+
+    // A tone lands in the bar covering its frequency: low tones in low bars,
+    // and the bars stay in 0..1.
+    void testNativeProviderLocatesTone()
+    {
+        auto source = std::make_unique<SyntheticPcmSource>();
+        SyntheticPcmSource* pcm = source.get();
+        PhosphorAudio::NativeSpectrumProvider provider(std::move(source));
+        provider.setOptions(rawOptions(ChannelMode::MonoAverage));
+        provider.start();
+        QVERIFY(provider.isRunning());
+
+        pcm->feed(200, 200, 0.5);
+        QTRY_COMPARE(provider.spectrum().size(), 32);
+        const qsizetype low = peakIndex(provider.spectrum(), 0, 32);
+        QVERIFY(peakValue(provider.spectrum(), 0, 32) > 0.3f);
+
+        pcm->feed(4000, 4000, 0.5);
+        QTRY_VERIFY(peakIndex(provider.spectrum(), 0, 32) > low + 8);
+        for (const float v : provider.spectrum()) {
+            QVERIFY(v >= 0.0f && v <= 1.0f);
+        }
+    }
+
+    void testNativeProviderChannelModes()
+    {
+        auto source = std::make_unique<SyntheticPcmSource>();
+        SyntheticPcmSource* pcm = source.get();
+        PhosphorAudio::NativeSpectrumProvider provider(std::move(source));
+        provider.setOptions(rawOptions(ChannelMode::Stereo));
+        provider.start();
+
+        // Tone on the left only: stereo layout is left block, then right block.
+        pcm->feed(1000, 0, 0.5);
+        QTRY_COMPARE(provider.spectrum().size(), 32);
+        QVERIFY(peakValue(provider.spectrum(), 0, 16) > 0.3f);
+        QVERIFY(peakValue(provider.spectrum(), 16, 32) < 0.01f);
+
+        provider.setOptions(rawOptions(ChannelMode::MonoRight));
+        pcm->feed(1000, 0, 0.5);
+        QTRY_VERIFY(peakValue(provider.spectrum(), 0, 32) < 0.01f);
+
+        provider.setOptions(rawOptions(ChannelMode::MonoLeft));
+        pcm->feed(1000, 0, 0.5);
+        QTRY_VERIFY(peakValue(provider.spectrum(), 0, 32) > 0.3f);
+        // Options other than the target apply in place, without a new stream.
+        QCOMPARE(pcm->starts, 1);
+    }
+
+    void testNativeProviderReverse()
+    {
+        auto source = std::make_unique<SyntheticPcmSource>();
+        SyntheticPcmSource* pcm = source.get();
+        PhosphorAudio::NativeSpectrumProvider provider(std::move(source));
+        provider.setOptions(rawOptions(ChannelMode::MonoAverage));
+        provider.start();
+        pcm->feed(200, 200, 0.5);
+        QTRY_COMPARE(provider.spectrum().size(), 32);
+        const qsizetype forward = peakIndex(provider.spectrum(), 0, 32);
+
+        SpectrumOptions opts = rawOptions(ChannelMode::MonoAverage);
+        opts.reverse = true;
+        provider.setOptions(opts);
+        pcm->feed(200, 200, 0.5);
+        QTRY_COMPARE(peakIndex(provider.spectrum(), 0, 32), 31 - forward);
+    }
+
+    // Frames produced on another thread reach the provider's thread through
+    // the frame buffer as spectrumUpdated.
+    void testNativeProviderPublishesAcrossThreads()
+    {
+        auto source = std::make_unique<SyntheticPcmSource>();
+        SyntheticPcmSource* pcm = source.get();
+        PhosphorAudio::NativeSpectrumProvider provider(std::move(source));
+        provider.setOptions(rawOptions(ChannelMode::MonoAverage));
+        QSignalSpy updates(&provider, &PhosphorAudio::IAudioSpectrumProvider::spectrumUpdated);
+        provider.start();
+
+        std::thread capture([pcm] {
+            pcm->feed(1000, 1000, 1.0);
+        });
+        capture.join();
+        QTRY_VERIFY(!updates.isEmpty());
+        QCOMPARE(updates.last().first().value<QVector<float>>(), provider.spectrum());
+        QVERIFY(peakValue(provider.spectrum(), 0, 32) > 0.3f);
+    }
+
+    void testNativeProviderSilenceAndStop()
+    {
+        auto source = std::make_unique<SyntheticPcmSource>();
+        SyntheticPcmSource* pcm = source.get();
+        PhosphorAudio::NativeSpectrumProvider provider(std::move(source));
+        QSignalSpy running(&provider, &PhosphorAudio::IAudioSpectrumProvider::runningChanged);
+        provider.start();
+        pcm->feed(0, 0, 0.5);
+        QTRY_COMPARE(provider.spectrum().size(), PhosphorAudio::Defaults::DefaultBarCount);
+        QCOMPARE(peakValue(provider.spectrum(), 0, provider.spectrum().size()), 0.0f);
+
+        // A new capture target is a new stream.
+        SpectrumOptions opts = provider.options();
+        opts.inputSource = QStringLiteral("alsa_output.test.monitor");
+        provider.setOptions(opts);
+        QCOMPARE(pcm->starts, 2);
+        QCOMPARE(pcm->lastTarget, QStringLiteral("alsa_output.test.monitor"));
+
+        provider.stop();
+        QVERIFY(!provider.isRunning());
+        QVERIFY(provider.spectrum().isEmpty());
+        QCOMPARE(pcm->stops, 2);
+        QCOMPARE(running.count(), 4); // start, restart (off + on), stop
+    }
+
+    // A backend failure after start stops the provider and surfaces once.
+    void testNativeProviderSourceError()
+    {
+        auto source = std::make_unique<SyntheticPcmSource>();
+        SyntheticPcmSource* pcm = source.get();
+        PhosphorAudio::NativeSpectrumProvider provider(std::move(source));
+        QSignalSpy errors(&provider, &PhosphorAudio::IAudioSpectrumProvider::errorOccurred);
+        provider.start();
+        pcm->fail(QStringLiteral("server went away"));
+        QTRY_COMPARE(errors.count(), 1);
+        QVERIFY(!provider.isRunning());
+    }
 };
 
 QTEST_MAIN(TestPhosphorAudio)
@@ -19,6 +19,40 @@ namespace PhosphorConfig {
 class IBackend;
 struct Schema;
 
+/// Typed handle to one declared key, for reads on hot paths.
+///
+/// Obtained once from @c Store::handle and then read with @c Store::get,
+/// which indexes a flat array of already-converted values: no group
+/// lookup, no @c QVariant, no type switch. Keys get their slots in schema
+/// order, so a handle is valid for any @c Store built from the same
+/// schema declaration, not only the one that issued it.
+template<typename T>
+struct KeyHandle
+{
+    int slot = -1; ///< the key's dense index, in schema order
+    int index = -1; ///< its position in the store's cache for @c T
+
+    bool isValid() const
+    {
+        return index >= 0;
+    }
+};
+
+/// Per-key change notification. One per declared key, created on first
+/// request by @c Store::notifier and owned by the store.
+class PHOSPHORCONFIG_EXPORT KeyNotifier : public QObject
+{
+    Q_OBJECT
+
+public:
+    using QObject::QObject;
+
+Q_SIGNALS:
+    /// The key was written or reset through the store, or @c Store::refresh
+    /// found a different value on the backend.
+    void changed();
+};
+
 /// High-level declarative configuration facade.
 ///
 /// Wraps an @c IBackend with a @c Schema so consumers get:
@@ -27,6 +61,8 @@ struct Schema;
 ///   - @c exportToJson() / @c importFromJson() for backup, dotfile sync, and settings-panel "export"
 ///   - Automatic schema-version stamping and migration-runner execution on construction
 ///   - A uniform @c changed() signal that consumers can wire directly to UI updates
+///   - Typed per-key handles (@c handle / @c get) for O(1) unboxed reads on hot
+///     paths, with a per-key @c KeyNotifier for narrow change subscriptions
 ///
 /// @code
 ///   Schema schema;
@@ -86,6 +122,56 @@ public:
         return T();
     }
 
+    /// Resolve @p group / @p key to a typed handle for @c get. Returns an
+    /// invalid handle when the key is undeclared or declared with a type
+    /// other than @c T (its @c expectedType, or its default's type when
+    /// none is given) — callers fall back to @c read<T> for those.
+    ///
+    /// Supported for the @c read<T> types; the same static_assert trap
+    /// applies to anything else.
+    template<typename T>
+    KeyHandle<T> handle(const QString& group, const QString& key) const
+    {
+        static_assert(sizeof(T) == 0,
+                      "PhosphorConfig::Store::handle<T> is only implemented for QString, int, bool, double, "
+                      "QColor, QVariantMap, QVariantList.");
+        return {};
+    }
+
+    /// Read through a handle. Returns exactly what @c read<T> would for the
+    /// same key — schema default, validator and all — from a per-key cache
+    /// filled on first use and kept current by this store's own @c write /
+    /// @c reset paths. Anything that changes the backend behind the store's
+    /// back (@c IBackend::reparseConfiguration, a direct @c IGroup write,
+    /// another @c Store on the same backend) must be followed by
+    /// @c refresh(). An invalid handle reads as @c T{}.
+    template<typename T>
+    T get(KeyHandle<T> handle) const
+    {
+        static_assert(sizeof(T) == 0,
+                      "PhosphorConfig::Store::get<T> is only implemented for QString, int, bool, double, "
+                      "QColor, QVariantMap, QVariantList.");
+        return T();
+    }
+
+    /// The change notifier for one declared key, or @c nullptr when the key
+    /// is undeclared. Lets a consumer react to the keys it reads instead of
+    /// filtering the store-wide @c changed signal.
+    KeyNotifier* notifier(const QString& group, const QString& key) const;
+
+    template<typename T>
+    KeyNotifier* notifier(KeyHandle<T> handle) const
+    {
+        return notifierForSlot(handle.slot);
+    }
+
+    /// Resynchronise with a backend that changed underneath the store: drops
+    /// the handle cache (the next @c get re-reads) and re-reads every key
+    /// that has a notifier, firing @c KeyNotifier::changed for each whose
+    /// value moved. Does not emit @c changed: only keys with a notifier are
+    /// compared, so it could not promise one emission per change.
+    void refresh();
+
     /// Read as @c QVariant. Uses @c QString coercion on the wire and
     /// reconstructs the type via @c QMetaType when possible. Undeclared
     /// keys return @c QVariant().
@@ -158,6 +244,9 @@ Q_SIGNALS:
     void changed(const QString& group, const QString& key);
 
 private:
+    KeyNotifier* notifierForSlot(int slot) const;
+    void keyWritten(const QString& group, const QString& key);
+
     class Private;
     std::unique_ptr<Private> d;
 };
@@ -184,4 +273,37 @@ PHOSPHORCONFIG_EXPORT QVariantMap Store::read<QVariantMap>(const QString&, const
 template<>
 PHOSPHORCONFIG_EXPORT QVariantList Store::read<QVariantList>(const QString&, const QString&) const;
 
+// ─ Supported handle<T> / get<T> specializations ─────────────────────────
+// Same type set as read<T>, defined alongside it in store.cpp.
+
+template<>
+PHOSPHORCONFIG_EXPORT KeyHandle<QString> Store::handle<QString>(const QString&, const QString&) const;
+template<>
+PHOSPHORCONFIG_EXPORT KeyHandle<int> Store::handle<int>(const QString&, const QString&) const;
+template<>
+PHOSPHORCONFIG_EXPORT KeyHandle<bool> Store::handle<bool>(const QString&, const QString&) const;
+template<>
+PHOSPHORCONFIG_EXPORT KeyHandle<double> Store::handle<double>(const QString&, const QString&) const;
+template<>
+PHOSPHORCONFIG_EXPORT KeyHandle<QColor> Store::handle<QColor>(const QString&, const QString&) const;
+template<>
+PHOSPHORCONFIG_EXPORT KeyHandle<QVariantMap> Store::handle<QVariantMap>(const QString&, const QString&) const;
+template<>
+PHOSPHORCONFIG_EXPORT KeyHandle<QVariantList> Store::handle<QVariantList>(const QString&, const QString&) const;
+
+template<>
+PHOSPHORCONFIG_EXPORT QString Store::get<QString>(KeyHandle<QString>) const;
+template<>
+PHOSPHORCONFIG_EXPORT int Store::get<int>(KeyHandle<int>) const;
+template<>
+PHOSPHORCONFIG_EXPORT bool Store::get<bool>(KeyHandle<bool>) const;
+template<>
+PHOSPHORCONFIG_EXPORT double Store::get<double>(KeyHandle<double>) const;
+template<>
+PHOSPHORCONFIG_EXPORT QColor Store::get<QColor>(KeyHandle<QColor>) const;
+template<>
+PHOSPHORCONFIG_EXPORT QVariantMap Store::get<QVariantMap>(KeyHandle<QVariantMap>) const;
+template<>
+PHOSPHORCONFIG_EXPORT QVariantList Store::get<QVariantList>(KeyHandle<QVariantList>) const;
+
 } // namespace PhosphorConfig
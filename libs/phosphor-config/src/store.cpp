@@ -7,15 +7,88 @@
 #include <PhosphorConfig/Store.h>
 
 #include <QDebug>
+#include <QHash>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonValue>
 #include <QMetaType>
 
+#include <algorithm>
 #include <limits>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 namespace PhosphorConfig {
 
+namespace {
+
+/// Which typed cache a declared key's handle reads from. One per
+/// Store::read<T> specialization; None for keys whose declared type has no
+/// typed reader (int64, QStringList, ...) — those still get a slot and a
+/// notifier, just no handle.
+enum class ValueKind {
+    None,
+    String,
+    Int,
+    Bool,
+    Double,
+    Color,
+    Map,
+    List,
+};
+
+ValueKind valueKindFor(const KeyDef& def)
+{
+    // Same type source as readVariantAs: expectedType when declared, the
+    // default's type otherwise.
+    const int typeId =
+        (def.expectedType != QMetaType::UnknownType) ? static_cast<int>(def.expectedType) : def.defaultValue.typeId();
+    switch (typeId) {
+    case QMetaType::QString:
+        return ValueKind::String;
+    case QMetaType::Int:
+        return ValueKind::Int;
+    case QMetaType::Bool:
+        return ValueKind::Bool;
+    case QMetaType::Double:
+    case QMetaType::Float:
+        return ValueKind::Double;
+    case QMetaType::QColor:
+        return ValueKind::Color;
+    case QMetaType::QVariantMap:
+        return ValueKind::Map;
+    case QMetaType::QVariantList:
+        return ValueKind::List;
+    default:
+        return ValueKind::None;
+    }
+}
+
+template<typename T>
+constexpr ValueKind valueKindOf()
+{
+    if constexpr (std::is_same_v<T, QString>) {
+        return ValueKind::String;
+    } else if constexpr (std::is_same_v<T, int>) {
+        return ValueKind::Int;
+    } else if constexpr (std::is_same_v<T, bool>) {
+        return ValueKind::Bool;
+    } else if constexpr (std::is_same_v<T, double>) {
+        return ValueKind::Double;
+    } else if constexpr (std::is_same_v<T, QColor>) {
+        return ValueKind::Color;
+    } else if constexpr (std::is_same_v<T, QVariantMap>) {
+        return ValueKind::Map;
+    } else if constexpr (std::is_same_v<T, QVariantList>) {
+        return ValueKind::List;
+    } else {
+        return ValueKind::None;
+    }
+}
+
+} // namespace
+
 // ─── Store::Private ──────────────────────────────────────────────────────────
 
 class Store::Private
@@ -27,10 +100,110 @@ public:
     {
     }
 
+    /// One per declared key, numbered in schema order (groups in QMap order,
+    /// keys in declaration order) so the numbering — and therefore every
+    /// KeyHandle — depends on the schema alone.
+    struct Slot
+    {
+        QString group;
+        KeyDef def; // a copy, so the slot never dangles into a detached schema
+        ValueKind kind = ValueKind::None;
+        int index = -1; // position in the typed cache for `kind`
+        std::unique_ptr<KeyNotifier> notifier; // created on first notifier() request
+        QVariant seen; // last value the notifier reported, for refresh()
+    };
+
+    void buildSlots();
+    int slotOf(const QString& group, const QString& key) const;
+
+    template<typename T>
+    int reserveValue()
+    {
+        auto& values = std::get<std::vector<T>>(cache);
+        values.emplace_back();
+        return static_cast<int>(values.size()) - 1;
+    }
+
+    template<typename T>
+    KeyHandle<T> handleFor(const QString& group, const QString& key) const;
+
+    template<typename T>
+    T cachedValue(KeyHandle<T> handle);
+
     IBackend* backend; // non-owning — lifetime managed by the caller
     Schema schema;
+
+    std::vector<Slot> slots;
+    QHash<QString, QHash<QString, int>> slotIndex;
+    // Typed value cache, one flat array per ValueKind, plus a per-slot flag
+    // saying whether the cached value still matches the backend. Cleared by
+    // the store's own writes and by refresh(); refilled lazily by get().
+    std::tuple<std::vector<QString>, std::vector<int>, std::vector<bool>, std::vector<double>, std::vector<QColor>,
+               std::vector<QVariantMap>, std::vector<QVariantList>>
+        cache;
+    std::vector<char> fresh;
 };
 
+void Store::Private::buildSlots()
+{
+    for (auto git = schema.groups.constBegin(); git != schema.groups.constEnd(); ++git) {
+        QHash<QString, int>& keys = slotIndex[git.key()];
+        for (const KeyDef& def : git.value()) {
+            Slot slot;
+            slot.group = git.key();
+            slot.def = def;
+            slot.kind = valueKindFor(def);
+            switch (slot.kind) {
+            case ValueKind::String:
+                slot.index = reserveValue<QString>();
+                break;
+            case ValueKind::Int:
+                slot.index = reserveValue<int>();
+                break;
+            case ValueKind::Bool:
+                slot.index = reserveValue<bool>();
+                break;
+            case ValueKind::Double:
+                slot.index = reserveValue<double>();
+                break;
+            case ValueKind::Color:
+                slot.index = reserveValue<QColor>();
+                break;
+            case ValueKind::Map:
+                slot.index = reserveValue<QVariantMap>();
+                break;
+            case ValueKind::List:
+                slot.index = reserveValue<QVariantList>();
+                break;
+            case ValueKind::None:
+                break;
+            }
+            keys.insert(def.key, static_cast<int>(slots.size()));
+            slots.push_back(std::move(slot));
+        }
+    }
+    fresh.assign(slots.size(), 0);
+}
+
+int Store::Private::slotOf(const QString& group, const QString& key) const
+{
+    const auto git = slotIndex.constFind(group);
+    if (git == slotIndex.constEnd()) {
+        return -1;
+    }
+    return git->value(key, -1);
+}
+
+template<typename T>
+KeyHandle<T> Store::Private::handleFor(const QString& group, const QString& key) const
+{
+    const int slot = slotOf(group, key);
+    if (slot < 0 || slots[slot].kind != valueKindOf<T>()) {
+        return {};
+    }
+    return {slot, slots[slot].index};
+}
+
 // ─── Variant dispatch helpers ────────────────────────────────────────────────
 // write() takes a QVariant; we need to dispatch to the right typed write on
 // IGroup to preserve JSON types (writing "true" as a string would round-trip
@@ -350,6 +523,8 @@ Store::Store(IBackend* backend, Schema schema, QObject* parent)
                 static_cast<long long>(d->schema.migrations.size()));
         }
     }
+
+    d->buildSlots();
 }
 
 Store::~Store() = default;
@@ -425,7 +600,7 @@ void Store::write(const QString& group, const QString& key, const QVariant& valu
         }
         writeVariantTo(*g, key, coerced);
     }
-    Q_EMIT changed(group, key);
+    keyWritten(group, key);
 }
 
 void Store::reset(const QString& group, const QString& key)
@@ -447,7 +622,7 @@ void Store::reset(const QString& group, const QString& key)
         }
         writeVariantTo(*g, key, def->defaultValue);
     }
-    Q_EMIT changed(group, key);
+    keyWritten(group, key);
 }
 
 void Store::resetGroup(const QString& group)
@@ -474,8 +649,73 @@ void Store::resetGroup(const QString& group)
             resetKeys.append(def.key);
         }
     }
-    for (const QString& key : resetKeys) {
-        Q_EMIT changed(group, key);
+    // Drop every reset key from the handle cache before the first emission,
+    // so a slot reacting to one key never reads a sibling's stale value.
+    for (const QString& key : std::as_const(resetKeys)) {
+        const int slot = d->slotOf(group, key);
+        if (slot >= 0) {
+            d->fresh[slot] = 0;
+        }
+    }
+    for (const QString& key : std::as_const(resetKeys)) {
+        keyWritten(group, key);
+    }
+}
+
+void Store::keyWritten(const QString& group, const QString& key)
+{
+    const int slot = d->slotOf(group, key);
+    if (slot >= 0) {
+        d->fresh[slot] = 0;
+    }
+    Q_EMIT changed(group, key);
+    if (slot < 0 || !d->slots[slot].notifier) {
+        return;
+    }
+    Private::Slot& s = d->slots[slot];
+    s.seen = readVariant(group, key);
+    Q_EMIT s.notifier->changed();
+}
+
+KeyNotifier* Store::notifier(const QString& group, const QString& key) const
+{
+    return notifierForSlot(d->slotOf(group, key));
+}
+
+KeyNotifier* Store::notifierForSlot(int slot) const
+{
+    if (slot < 0 || slot >= static_cast<int>(d->slots.size())) {
+        return nullptr;
+    }
+    Private::Slot& s = d->slots[slot];
+    if (!s.notifier) {
+        // Unparented: the slot owns it, and the slot table outlives nothing
+        // but the Store itself.
+        s.notifier = std::make_unique<KeyNotifier>();
+        s.seen = readVariant(s.group, s.def.key);
+    }
+    return s.notifier.get();
+}
+
+void Store::refresh()
+{
+    std::fill(d->fresh.begin(), d->fresh.end(), 0);
+
+    // Compare first, emit after: a notifier slot that writes re-entrantly
+    // must not see a half-refreshed table.
+    QVector<KeyNotifier*> moved;
+    for (Private::Slot& s : d->slots) {
+        if (!s.notifier) {
+            continue;
+        }
+        QVariant now = readVariant(s.group, s.def.key);
+        if (now != s.seen) {
+            s.seen = std::move(now);
+            moved.append(s.notifier.get());
+        }
+    }
+    for (KeyNotifier* n : std::as_const(moved)) {
+        Q_EMIT n->changed();
     }
 }
 
@@ -750,6 +990,29 @@ T readDeclared(const Schema& schema, IBackend* backend, const QString& group, co
 }
 } // namespace
 
+template<typename T>
+T Store::Private::cachedValue(KeyHandle<T> handle)
+{
+    // A handle from a Store over a different schema would index someone
+    // else's key; check it actually names a T slot here.
+    const bool valid = handle.slot >= 0 && handle.slot < static_cast<int>(slots.size())
+        && slots[handle.slot].kind == valueKindOf<T>() && slots[handle.slot].index == handle.index;
+    Q_ASSERT_X(valid, "PhosphorConfig::Store::get", "handle does not name a key of this type in this store");
+    if (!valid) {
+        return T();
+    }
+    auto& values = std::get<std::vector<T>>(cache);
+    if (!fresh[handle.slot]) {
+        const Slot& s = slots[handle.slot];
+        {
+            auto g = backend->group(s.group);
+            values[handle.index] = applyValidator(&s.def, readTyped<T>(*g, s.def));
+        }
+        fresh[handle.slot] = 1;
+    }
+    return values[handle.index];
+}
+
 // Undeclared keys return a value-initialized T (matching the docstring on
 // Store::read). Falling through to the backend would surface keys the
 // schema doesn't know about and inconsistently differ from
@@ -797,6 +1060,94 @@ QVariantList Store::read<QVariantList>(const QString& group, const QString& key)
     return readDeclared<QVariantList>(d->schema, d->backend, group, key, QVariantList{});
 }
 
+// ─── Typed handles ───────────────────────────────────────────────────────────
+// Same type set as read<T>. get() returns what read<T> would, from the slot
+// cache instead of a fresh backend lookup.
+
+template<>
+KeyHandle<QString> Store::handle<QString>(const QString& group, const QString& key) const
+{
+    return d->handleFor<QString>(group, key);
+}
+
+template<>
+KeyHandle<int> Store::handle<int>(const QString& group, const QString& key) const
+{
+    return d->handleFor<int>(group, key);
+}
+
+template<>
+KeyHandle<bool> Store::handle<bool>(const QString& group, const QString& key) const
+{
+    return d->handleFor<bool>(group, key);
+}
+
+template<>
+KeyHandle<double> Store::handle<double>(const QString& group, const QString& key) const
+{
+    return d->handleFor<double>(group, key);
+}
+
+template<>
+KeyHandle<QColor> Store::handle<QColor>(const QString& group, const QString& key) const
+{
+    return d->handleFor<QColor>(group, key);
+}
+
+template<>
+KeyHandle<QVariantMap> Store::handle<QVariantMap>(const QString& group, const QString& key) const
+{
+    return d->handleFor<QVariantMap>(group, key);
+}
+
+template<>
+KeyHandle<QVariantList> Store::handle<QVariantList>(const QString& group, const QString& key) const
+{
+    return d->handleFor<QVariantList>(group, key);
+}
+
+template<>
+QString Store::get<QString>(KeyHandle<QString> handle) const
+{
+    return d->cachedValue(handle);
+}
+
+template<>
+int Store::get<int>(KeyHandle<int> handle) const
+{
+    return d->cachedValue(handle);
+}
+
+template<>
+bool Store::get<bool>(KeyHandle<bool> handle) const
+{
+    return d->cachedValue(handle);
+}
+
+template<>
+double Store::get<double>(KeyHandle<double> handle) const
+{
+    return d->cachedValue(handle);
+}
+
+template<>
+QColor Store::get<QColor>(KeyHandle<QColor> handle) const
+{
+    return d->cachedValue(handle);
+}
+
+template<>
+QVariantMap Store::get<QVariantMap>(KeyHandle<QVariantMap> handle) const
+{
+    return d->cachedValue(handle);
+}
+
+template<>
+QVariantList Store::get<QVariantList>(KeyHandle<QVariantList> handle) const
+{
+    return d->cachedValue(handle);
+}
+
 // The explicit specializations above ARE the definitions — no separate
 // "template Store::read<T>(...)" instantiation line is needed (and would be
 // rejected because the primary template has no body in this TU).
@@ -673,6 +673,62 @@ private Q_SLOTS:
         QCOMPARE(persisted.value(QStringLiteral("_version")).toInt(), 2);
     }
 
+    void keyHandle_readsCachedValueAndNotifiesPerSlot()
+    {
+        JsonBackend backend(m_path);
+        Store store(&backend, makeSchema());
+
+        const auto width = store.handle<int>(QStringLiteral("Window"), QStringLiteral("Width"));
+        const auto height = store.handle<int>(QStringLiteral("Window"), QStringLiteral("Height"));
+        QVERIFY(width.isValid());
+        QVERIFY(height.isValid());
+        QCOMPARE(store.get(width), 800);
+        QCOMPARE(store.get(height), 600);
+
+        // Wrong type, undeclared key, and a declared type with no typed
+        // reader all refuse a handle; the last still has a notifier.
+        QVERIFY(!store.handle<QString>(QStringLiteral("Window"), QStringLiteral("Width")).isValid());
+        QVERIFY(!store.handle<int>(QStringLiteral("Window"), QStringLiteral("Depth")).isValid());
+        QVERIFY(!store.handle<QVariantList>(QStringLiteral("Appearance"), QStringLiteral("Tags")).isValid());
+        QVERIFY(store.notifier(QStringLiteral("Appearance"), QStringLiteral("Tags")) != nullptr);
+        QVERIFY(store.notifier(QStringLiteral("Window"), QStringLiteral("Depth")) == nullptr);
+
+        QSignalSpy widthSpy(store.notifier(width), &KeyNotifier::changed);
+        QSignalSpy heightSpy(store.notifier(height), &KeyNotifier::changed);
+
+        store.write(QStringLiteral("Window"), QStringLiteral("Width"), 1024);
+        QCOMPARE(store.get(width), 1024);
+        QCOMPARE(widthSpy.count(), 1);
+        QCOMPARE(heightSpy.count(), 0);
+
+        // A write behind the store's back is picked up by refresh(), which
+        // notifies only the key that moved.
+        {
+            auto g = store.backend()->group(QStringLiteral("Window"));
+            g->writeInt(QStringLiteral("Height"), 700);
+        }
+        store.refresh();
+        QCOMPARE(store.get(height), 700);
+        QCOMPARE(heightSpy.count(), 1);
+        QCOMPARE(widthSpy.count(), 1);
+        store.refresh();
+        QCOMPARE(heightSpy.count(), 1);
+
+        store.resetGroup(QStringLiteral("Window"));
+        QCOMPARE(store.get(width), 800);
+        QCOMPARE(store.get(height), 600);
+        QCOMPARE(widthSpy.count(), 2);
+        QCOMPARE(heightSpy.count(), 2);
+
+        // Slots are numbered from the schema alone, so the handle works on
+        // any store built from the same declaration.
+        JsonBackend otherBackend(m_tmp->filePath(QStringLiteral("other.json")));
+        Store other(&otherBackend, makeSchema());
+        other.write(QStringLiteral("Window"), QStringLiteral("Width"), 1280);
+        QCOMPARE(other.get(width), 1280);
+        QCOMPARE(store.get(width), 800);
+    }
+
 private:
     std::unique_ptr<QTemporaryDir> m_tmp;
     QString m_path;
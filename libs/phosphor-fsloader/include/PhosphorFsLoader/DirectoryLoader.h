@@ -37,6 +37,18 @@ namespace PhosphorFsLoader {
  *   • Sink dispatch (`parseFile` per file, one `commitBatch` per scan).
  *   • Stale-entry purge: deleted files' keys are reported to the sink
  *     as `removedKeys` so the sink can unregister them.
+ *   • A per-file manifest (size, mtime, change time, content hash →
+ *     the sink's `ParsedEntry`) kept across rescans, so a rescan stats
+ *     every file but hands only new or changed ones to `parseFile`.
+ *     Unchanged files reuse their previous parse; layering, the caps
+ *     and the `commitBatch` contract are unaffected — the sink still
+ *     receives the full current set every scan.
+ *
+ * The manifest assumes a file's parse depends on its bytes alone. A sink
+ * whose parse also consults outside state (a registry lookup that may
+ * now resolve differently) gets a full reparse from the explicit
+ * `requestRescan` / `rescanNow`, which discard the manifest; watcher-driven
+ * rescans and `loadFromDirectory[ies]` keep it.
  *
  * Loaders that need a different on-disk shape (subdirectory layouts,
  * non-JSON file extensions, custom filename validation) implement
@@ -46,7 +58,8 @@ namespace PhosphorFsLoader {
  * ## Thread safety
  *
  * GUI-thread only. Inherits the threading constraint from
- * `WatchedDirectorySet`.
+ * `WatchedDirectorySet`. The one exception is the sink's `parseFile`,
+ * which `ScanMode::WorkerPool` calls from pool threads — see there.
  */
 class PHOSPHORFSLOADER_EXPORT DirectoryLoader : public QObject
 {
@@ -62,6 +75,32 @@ public:
         QString systemSourcePath;
     };
 
+    /// Where a rescan reads and parses its files.
+    enum class ScanMode : quint8 {
+        /// Every file is read and parsed on the GUI thread, one after the
+        /// other. The default, and the only mode a sink whose `parseFile`
+        /// touches shared state (a registry lookup, a cache) can use.
+        GuiThread,
+        /// Files are read and parsed on `QThreadPool::globalInstance()`,
+        /// and the fresh entry set — shadowing, duplicate checks, refused
+        /// files — is folded together there in the same order the serial
+        /// scan would visit it. Only the directory listing and the final
+        /// `commitBatch` swap run on the GUI thread.
+        ///
+        /// Debounced rescans (watcher events, `requestRescan`) return to
+        /// the event loop while the pool works and commit when it is done,
+        /// so `entriesChanged` fires then. `loadFromDirectory[ies]` and
+        /// `rescanNow` keep their synchronous contract: they fan the parse
+        /// out the same way but wait for it, and discard any debounced
+        /// result still in flight.
+        ///
+        /// The sink's `parseFile` is called CONCURRENTLY from pool threads
+        /// in this mode, so it must be reentrant: no unsynchronised member
+        /// state, no registry access. Entry-cap and user-over-system
+        /// semantics are identical to `GuiThread`.
+        WorkerPool,
+    };
+
     /**
      * @brief Construct with a borrowed sink.
      *
@@ -122,6 +161,12 @@ public:
 
     /// Trigger a debounced rescan. Forwards to the underlying
     /// `WatchedDirectorySet`.
+    ///
+    /// Discards the parse manifest first, so the rescan re-parses every
+    /// file. Consumers call this when something outside the files changed
+    /// (the `curvesChanged` → profile rescan wiring), which a stat cannot
+    /// see; the watcher's own rescans do not come through here and stay
+    /// incremental.
     void requestRescan();
 
     /// Rescan every registered directory synchronously, on the calling
@@ -145,8 +190,23 @@ public:
     /// running: calling it from an `entriesChanged` slot re-enters the
     /// scan, and nothing bounds that recursion. The caller owns
     /// termination.
+    ///
+    /// Like `requestRescan`, discards the parse manifest: every file is
+    /// re-parsed.
     void rescanNow();
 
+    /// Select how rescans read and parse files. Takes effect from the next
+    /// scan; switching back to `GuiThread` while a debounced worker-pool scan
+    /// is in flight drops its result, and the pending rescan is redone on
+    /// the GUI thread. Default `ScanMode::GuiThread`.
+    ///
+    /// A dropped worker-pool scan is never waited for (here, or when a newer
+    /// scan supersedes it): `parseFile` calls it already started finish on
+    /// the pool, possibly alongside the next scan's. Only destroying the
+    /// loader waits for them, since they use the borrowed sink.
+    void setScanMode(ScanMode mode);
+    ScanMode scanMode() const;
+
     /// Count of entries currently tracked by the loader.
     int registeredCount() const;
 
@@ -188,6 +248,15 @@ public:
     /// order of magnitude lower for exactly this reason.
     static constexpr int kMaxEntries = 10'000;
 
+    /// How recently a file may have been modified for its stat to still
+    /// be trusted by the parse manifest. A file whose mtime falls within
+    /// this window of the moment it was stat'ed can be rewritten again
+    /// without the stamp moving — same size, and an mtime that rounds to
+    /// the same millisecond, or the same second on coarser filesystems —
+    /// so its next scan compares content hashes rather than stamps.
+    /// Shared by every manifest in this library.
+    static constexpr qint64 kRacyStampWindowMs = 1000;
+
     /// Test-only: override the debounce interval (default 50 ms).
     void setDebounceIntervalForTest(int ms);
 
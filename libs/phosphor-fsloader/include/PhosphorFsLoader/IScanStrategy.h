@@ -51,7 +51,8 @@ namespace PhosphorFsLoader {
  * ## Emit semantics
  *
  * The base emits `WatchedDirectorySet::rescanCompleted` unconditionally
- * on every rescan, regardless of whether any state changed — the base
+ * on every committed rescan (a deferred dispatch, see `scanDeferred`, is
+ * not one), regardless of whether any state changed — the base
  * has no way to compare strategy-private payloads. Strategies that need
  * change-only emit semantics MUST diff inside `performScan` and gate
  * their own consumer-facing signal on the result (see
@@ -112,6 +113,26 @@ public:
      */
     virtual QStringList performScan(const QStringList& directoriesInScanOrder) = 0;
 
+    /**
+     * @brief Whether the last `performScan` handed its work to another thread.
+     *
+     * A strategy that parses off the GUI thread returns from `performScan`
+     * before anything is committed and reports `true` here. The base then
+     * treats that call as a dispatch, not a rescan: it skips the per-file
+     * watch re-sync and does not emit `rescanCompleted`, because nothing
+     * the consumer can observe has changed yet. When the work lands, the
+     * strategy calls `WatchedDirectorySet::completeDeferredScan()`, and the
+     * `performScan` that call triggers commits the result through the
+     * normal path.
+     *
+     * Read by the base immediately after each `performScan` returns.
+     * Synchronous strategies keep the default.
+     */
+    virtual bool scanDeferred() const
+    {
+        return false;
+    }
+
 protected:
     IScanStrategy() = default;
 };
@@ -50,7 +50,9 @@ namespace PhosphorFsLoader {
  *      same-user blob DoS guard).
  *   3. Parse `metadata.json` into a caller-supplied schema-specific
  *      `Payload` via the `Parser` policy. Parser-returned `std::nullopt`
- *      skips the entry; an empty `Payload::id` skips it as well.
+ *      skips the entry; an empty `Payload::id` skips it as well. A pack
+ *      unchanged since its last read reuses that parse instead (see
+ *      `invalidateManifest`).
  *   4. Per-rescan entry cap (caller-tunable, default 10,000) — when
  *      tripped, system overflow is dropped (reverse-iteration scans
  *      user dirs first, so cap-trip never violates user-wins layering).
@@ -407,12 +409,32 @@ public:
         m_loggingCat = &cat;
     }
 
+    /// Forget every remembered parse, so the next scan reads and parses
+    /// every pack again.
+    ///
+    /// Between scans the strategy keeps, per subdir, the stats and content
+    /// hash of the `metadata.json` it last read and the payload the parser
+    /// made of it, and reuses that payload while nothing it keys on moved:
+    /// the `metadata.json`, the subdir's own listing, the files
+    /// `PerEntryWatchPaths` reported for the payload, and `isUser`. A
+    /// parser whose output depends on anything else — a lookup table, a
+    /// setting, a file outside its pack — must have this called when that
+    /// input changes. `MetadataPackLoader::refresh` calls it for exactly
+    /// that reason.
+    void invalidateManifest()
+    {
+        m_manifest.clear();
+    }
+
     /**
      * @brief Run a full rescan across @p directoriesInScanOrder.
      *
      * See `IScanStrategy::performScan` for the canonical input shape.
-     * The strategy always rebuilds its full pack map from scratch — no
-     * incremental update. Stale entries (subdirs whose `metadata.json`
+     * The strategy always rebuilds its full pack map, but not every
+     * parse: a subdir the manifest shows unchanged since its last read
+     * (see `invalidateManifest`) contributes its remembered payload, so
+     * a rescan costs stats for the packs nobody touched and parses for
+     * the ones somebody did. Stale entries (subdirs whose `metadata.json`
      * vanished since the last scan) drop out by being absent from the
      * rebuilt map; the next signature comparison reports the change
      * and `OnCommit` fires.
@@ -485,6 +507,71 @@ public:
     }
 
 private:
+    /// What the manifest remembers about one pack subdir: enough to tell
+    /// on the next scan, from stats alone, whether the parse below would
+    /// come out the same.
+    struct ManifestRecord
+    {
+        QByteArray metadataStamp; ///< `stampOf` the metadata.json that was read
+        /// SHA-1 over isUser, the subdir's own stamp and each of
+        /// `entryWatches`' stamps, taken when the pack was parsed. The
+        /// subdir stamp moves when a file appears or disappears in it,
+        /// which is what the existence checks parsers do depend on.
+        QByteArray contextStamp;
+        QByteArray contentHash; ///< SHA-1 of the metadata.json bytes
+        bool isUser = false;
+        /// Stamps taken too soon after the stamped file was modified to
+        /// vouch for it (see `DirectoryLoader::kRacyStampWindowMs`). A racy
+        /// metadata stamp sends the next scan to the content hash; a racy
+        /// context stamp sends it to a full reparse.
+        bool metadataRacy = false;
+        bool contextRacy = false;
+        /// The parser's verdict; disengaged when the JSON was malformed,
+        /// not an object, declined, or carried an empty id.
+        std::optional<Payload> payload;
+        QStringList entryWatches; ///< `PerEntryWatchPaths` for `payload`
+    };
+
+    /// "size|mtime|ctime" for an existing path, "missing" otherwise. Sets
+    /// @p racy when the path was modified too recently for the stamp to
+    /// be trusted; never clears it.
+    static QByteArray stampOf(const QFileInfo& info, bool* racy = nullptr)
+    {
+        if (!info.exists()) {
+            return QByteArrayLiteral("missing");
+        }
+        const qint64 mtimeMs = info.lastModified().toMSecsSinceEpoch();
+        if (racy && mtimeMs > QDateTime::currentMSecsSinceEpoch() - DirectoryLoader::kRacyStampWindowMs) {
+            *racy = true;
+        }
+        return QByteArray::number(info.size()) + '|' + QByteArray::number(mtimeMs) + '|'
+            + QByteArray::number(info.metadataChangeTime().toMSecsSinceEpoch());
+    }
+
+    static QByteArray contextStampOf(const QByteArray& subdirStamp, bool isUser, const QStringList& entryWatches,
+                                     bool* racy = nullptr)
+    {
+        QCryptographicHash hasher(QCryptographicHash::Sha1);
+        hasher.addData(isUser ? QByteArrayView("u") : QByteArrayView("s"));
+        hasher.addData(QByteArrayView("\n"));
+        hasher.addData(subdirStamp);
+        for (const QString& path : entryWatches) {
+            hasher.addData(QByteArrayView("\n"));
+            hasher.addData(path.toUtf8());
+            hasher.addData(QByteArrayView("|"));
+            hasher.addData(stampOf(QFileInfo(path), racy));
+        }
+        return hasher.result();
+    }
+
+    /// Open, hash and (unless @p reusable has the same bytes) parse one
+    /// pack's metadata.json. Returns nullopt only for the outcomes worth
+    /// retrying from scratch next scan: the file would not open, or grew
+    /// past the cap between the stat and the open.
+    std::optional<ManifestRecord> readRecord(const QString& subdirPath, const QString& metadataPath,
+                                             const QByteArray& metadataStamp, bool isUserDir,
+                                             const ManifestRecord* reusable, const QLoggingCategory& log) const;
+
     Parser m_parser;
     OnCommit m_onCommit;
     PerEntryWatchPaths m_perEntryWatch;
@@ -497,6 +584,10 @@ private:
     const QLoggingCategory* m_loggingCat = nullptr;
 
     QHash<QString, Payload> m_packs;
+    /// Subdir path → what its last read produced. Lets a watcher-driven
+    /// rescan stat an unchanged pack instead of re-reading and re-parsing
+    /// it; `invalidateManifest` empties it for a full reparse.
+    QHash<QString, ManifestRecord> m_manifest;
     QByteArray m_lastSignature;
     bool m_signatureSeeded = false;
 };
@@ -511,6 +602,96 @@ PHOSPHORFSLOADER_EXPORT Q_DECLARE_LOGGING_CATEGORY(lcMetadataPackScan)
 
 } // namespace detail
 
+template<typename Payload>
+auto MetadataPackScanStrategy<Payload>::readRecord(const QString& subdirPath, const QString& metadataPath,
+                                                   const QByteArray& metadataStamp, bool isUserDir,
+                                                   const ManifestRecord* reusable, const QLoggingCategory& log) const
+    -> std::optional<ManifestRecord>
+{
+    QFile file(metadataPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(log) << "MetadataPackScanStrategy: failed to open metadata.json:" << metadataPath;
+        return std::nullopt;
+    }
+    // Re-checked on the OPEN descriptor. The pre-open stat in `performScan`
+    // can be beaten by a rewrite between the stat and the open, which leaves
+    // `readAll()` below unbounded — the same TOCTOU that was closed in
+    // `validateJsonEnvelope`, and this was the one remaining site that
+    // still enforced the cap on the path rather than the descriptor.
+    //
+    // Deliberately untested: hitting this branch requires losing the
+    // stat/open race on purpose, and a test cannot schedule a
+    // same-process rewrite into that window deterministically. The
+    // pre-open cap in `performScan` carries the observable coverage; this
+    // recheck is the race-closing twin and is kept correct by review.
+    if (file.size() > DirectoryLoader::kMaxFileBytes) {
+        qCWarning(log) << "MetadataPackScanStrategy: skipping oversized metadata.json:" << metadataPath << "("
+                       << file.size() << "bytes, cap" << DirectoryLoader::kMaxFileBytes << ")";
+        return std::nullopt;
+    }
+
+    // The subdir is stamped BEFORE the parse: a file the parser's existence
+    // checks miss because it lands mid-parse then still moves the stamp the
+    // next scan compares against.
+    bool contextRacy = false;
+    const QByteArray subdirStamp = stampOf(QFileInfo(subdirPath), &contextRacy);
+    const QByteArray bytes = file.readAll();
+    ManifestRecord record;
+    record.metadataStamp = metadataStamp;
+    record.contentHash = QCryptographicHash::hash(bytes, QCryptographicHash::Sha1);
+    record.isUser = isUserDir;
+
+    // Touched but not changed — a save without edits, a `touch`, a sync tool
+    // rewriting identical bytes. The hash already paid for the read; it saves
+    // the JSON parse and the parser call.
+    if (reusable && reusable->contentHash == record.contentHash) {
+        record.payload = reusable->payload;
+        record.entryWatches = reusable->entryWatches;
+        record.contextStamp = reusable->contextStamp;
+        record.contextRacy = reusable->contextRacy;
+        return record;
+    }
+
+    // The declared files' part of the context stamp can only be taken once
+    // the parser has said which files they are.
+    const auto finish = [&]() {
+        record.contextStamp = contextStampOf(subdirStamp, isUserDir, record.entryWatches, &contextRacy);
+        record.contextRacy = contextRacy;
+        return std::optional<ManifestRecord>(std::move(record));
+    };
+
+    QJsonParseError parseError{};
+    const QJsonDocument doc = QJsonDocument::fromJson(bytes, &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        qCWarning(log) << "MetadataPackScanStrategy: parse error in" << metadataPath << ":"
+                       << parseError.errorString();
+        return finish();
+    }
+    if (!doc.isObject()) {
+        qCWarning(log) << "MetadataPackScanStrategy: non-object root in" << metadataPath;
+        return finish();
+    }
+
+    // Schema-specific parse. `m_parser` is guarded once at the top of
+    // `performScan` rather than here, so the ctor's debug assert has a
+    // release-build counterpart and this call cannot throw
+    // `std::bad_function_call` out of a GUI-thread rescan.
+    std::optional<Payload> parsed = m_parser(subdirPath, doc.object(), isUserDir);
+    if (!parsed.has_value()) {
+        qCDebug(log) << "MetadataPackScanStrategy: parser declined" << metadataPath;
+        return finish();
+    }
+    if (parsed->id.isEmpty()) {
+        qCWarning(log) << "MetadataPackScanStrategy: skipping" << metadataPath << ": empty 'id' field";
+        return finish();
+    }
+    if (m_perEntryWatch) {
+        record.entryWatches = m_perEntryWatch(*parsed);
+    }
+    record.payload = std::move(parsed);
+    return finish();
+}
+
 template<typename Payload>
 QStringList MetadataPackScanStrategy<Payload>::performScan(const QStringList& directoriesInScanOrder)
 {
@@ -561,6 +742,10 @@ QStringList MetadataPackScanStrategy<Payload>::performScan(const QStringList& di
     QSet<QString> seenIds;
 
     QStringList desiredWatches;
+    /// Every subdir whose metadata.json was read (or reused) this scan.
+    /// Replaces `m_manifest` wholesale, so a pack that vanished, or that
+    /// sorted past the cap, is forgotten with it.
+    QHash<QString, ManifestRecord> manifest;
 
     const QLoggingCategory& log = m_loggingCat ? *m_loggingCat : detail::lcMetadataPackScan();
 
@@ -696,71 +881,53 @@ QStringList MetadataPackScanStrategy<Payload>::performScan(const QStringList& di
                 continue;
             }
 
-            QFile file(metadataPath);
-            if (!file.open(QIODevice::ReadOnly)) {
-                qCWarning(log) << "MetadataPackScanStrategy: failed to open metadata.json:" << metadataPath;
-                continue;
-            }
-            // Re-checked on the OPEN descriptor. The pre-open stat above can be
-            // beaten by a rewrite between the stat and the open, which leaves
-            // `readAll()` below unbounded — the same TOCTOU that was closed in
-            // `validateJsonEnvelope`, and this was the one remaining site that
-            // still enforced the cap on the path rather than the descriptor.
-            //
-            // Deliberately untested: hitting this branch requires losing the
-            // stat/open race on purpose, and a test cannot schedule a
-            // same-process rewrite into that window deterministically. The
-            // pre-open cap two blocks up carries the observable coverage; this
-            // recheck is the race-closing twin and is kept correct by review.
-            if (file.size() > DirectoryLoader::kMaxFileBytes) {
-                qCWarning(log) << "MetadataPackScanStrategy: skipping oversized metadata.json:" << metadataPath << "("
-                               << file.size() << "bytes, cap" << DirectoryLoader::kMaxFileBytes << ")";
-                continue;
-            }
-
-            QJsonParseError parseError{};
-            const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
-            if (parseError.error != QJsonParseError::NoError) {
-                qCWarning(log) << "MetadataPackScanStrategy: parse error in" << metadataPath << ":"
-                               << parseError.errorString();
-                continue;
+            // Incremental reuse. A pack whose metadata.json, isUser
+            // classification, directory listing and declared files all stat
+            // the same as when it was last parsed keeps that parse; one whose
+            // metadata.json was merely touched keeps it too once the content
+            // hash agrees. Only a pack with a real change pays for the open,
+            // the JSON parse and the parser call.
+            const auto cached = m_manifest.constFind(subdirPath);
+            const ManifestRecord* reusable = nullptr;
+            if (cached != m_manifest.cend() && cached->isUser == isUserDir && !cached->contextRacy
+                && cached->contextStamp
+                    == contextStampOf(stampOf(QFileInfo(subdirPath)), isUserDir, cached->entryWatches)) {
+                reusable = &*cached;
             }
-            if (!doc.isObject()) {
-                qCWarning(log) << "MetadataPackScanStrategy: non-object root in" << metadataPath;
-                continue;
+            std::optional<ManifestRecord> record;
+            bool metadataRacy = false;
+            const QByteArray metadataStamp = stampOf(metadataInfo, &metadataRacy);
+            if (reusable && !reusable->metadataRacy && reusable->metadataStamp == metadataStamp) {
+                record = *reusable;
+            } else {
+                record = readRecord(subdirPath, metadataPath, metadataStamp, isUserDir, reusable, log);
             }
-
-            // Schema-specific parse. `m_parser` is guarded once at the top of
-            // this function rather than here, so the ctor's debug assert has a
-            // release-build counterpart and this call cannot throw
-            // `std::bad_function_call` out of a GUI-thread rescan.
-            std::optional<Payload> parsed = m_parser(subdirPath, doc.object(), isUserDir);
-            if (!parsed.has_value()) {
-                qCDebug(log) << "MetadataPackScanStrategy: parser declined" << metadataPath;
+            if (!record) {
                 continue;
             }
-            if (parsed->id.isEmpty()) {
-                qCWarning(log) << "MetadataPackScanStrategy: skipping" << metadataPath << ": empty 'id' field";
+            record->metadataRacy = metadataRacy;
+            manifest.insert(subdirPath, *record);
+            if (!record->payload) {
                 continue;
             }
+            const Payload& parsed = *record->payload;
 
             // First-wins on id collision. Reverse-iteration means a
             // user-dir entry claims its id before any system-dir entry
             // can; a colliding system entry is silently shadowed.
-            if (seenIds.contains(parsed->id)) {
-                qCDebug(log) << "MetadataPackScanStrategy: id" << parsed->id
+            if (seenIds.contains(parsed.id)) {
+                qCDebug(log) << "MetadataPackScanStrategy: id" << parsed.id
                              << "already registered from a higher-priority dir; shadowed at:" << subdirPath;
                 continue;
             }
 
-            // Per-payload watches — frag/vert/kwin shaders, etc.
-            if (m_perEntryWatch) {
-                desiredWatches.append(m_perEntryWatch(*parsed));
-            }
+            // Per-payload watches — frag/vert/kwin shaders, etc. Computed
+            // when the pack was parsed and remembered with it.
+            desiredWatches.append(record->entryWatches);
 
-            // Capture the metadata.json fingerprint BEFORE the move so
-            // we can mix it into the per-rescan signature below. Any
-            // parser-consumed field's edit shifts the file's mtime (POSIX
+            // Capture the metadata.json fingerprint so we can mix it into
+            // the per-rescan signature below. Any parser-consumed field's
+            // edit shifts the file's mtime (POSIX
             // guarantees the mtime is UPDATED on a content-change write;
             // the value mixed here is truncated to milliseconds, so a
             // same-size rewrite landing in the same millisecond as the
@@ -770,12 +937,11 @@ QStringList MetadataPackScanStrategy<Payload>::performScan(const QStringList& di
             // atomic rename which also changes the inode), so a single
             // mtime+size mix-in covers every schema field without forcing
             // per-field enumeration in SignatureContrib.
-            QString id = parsed->id;
-            seenIds.insert(id);
+            seenIds.insert(parsed.id);
             entries.push_back(
-                Entry{std::move(id),
+                Entry{parsed.id,
                       EntryFingerprint{metadataInfo.size(), metadataInfo.lastModified().toMSecsSinceEpoch(), isUserDir},
-                      std::move(*parsed)});
+                      parsed});
         }
     }
 
@@ -878,6 +1044,7 @@ QStringList MetadataPackScanStrategy<Payload>::performScan(const QStringList& di
     const bool changed = isFirstScan ? !fresh.isEmpty() : signature != m_lastSignature;
 
     m_packs = std::move(fresh);
+    m_manifest = std::move(manifest);
     m_lastSignature = signature;
     m_signatureSeeded = true;
 
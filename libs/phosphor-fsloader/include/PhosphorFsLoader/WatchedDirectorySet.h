@@ -233,6 +233,21 @@ public:
     /// the same ground).
     void rescanNow();
 
+    /// Run the strategy again on the calling stack WITHOUT cancelling a
+    /// pending debounced rescan. For strategies whose `performScan` hands
+    /// its work to a worker thread (see `IScanStrategy::scanDeferred`):
+    /// once that work lands back on the GUI thread, the strategy calls
+    /// this, commits the finished result from the `performScan` it
+    /// triggers, and the base re-arms file watches and emits
+    /// `rescanCompleted` as for any other rescan.
+    ///
+    /// Unlike `rescanNow`, a debounced rescan requested while the worker
+    /// was busy is left armed: the result being committed was read before
+    /// that request, so the follow-up scan is still owed.
+    ///
+    /// GUI-thread only; refused off-thread like `rescanNow`.
+    void completeDeferredScan();
+
     /// Currently-registered directories in registration order.
     ///
     /// Intended to be called on the GUI thread. The returned QStringList
@@ -281,7 +296,8 @@ Q_SIGNALS:
      *
      * Emitted unconditionally on rescan completion — the strategy's
      * commit step has already touched the consumer's registry by the
-     * time this fires.
+     * time this fires. A scan the strategy deferred to another thread
+     * completes, and emits, from `completeDeferredScan`.
      */
     void rescanCompleted();
 
@@ -4,18 +4,30 @@
 #include <PhosphorFsLoader/DirectoryLoader.h>
 #include <PhosphorFsLoader/IScanStrategy.h>
 
+#include <QCryptographicHash>
+#include <QDateTime>
 #include <QDir>
+#include <QFile>
 #include <QFileInfo>
+#include <QFuture>
 #include <QHash>
 #include <QLoggingCategory>
+#include <QThreadPool>
+#include <QtConcurrent>
 
 #include <algorithm>
+#include <functional>
+#include <optional>
 #include <utility>
 
 namespace PhosphorFsLoader {
 
 namespace {
 Q_LOGGING_CATEGORY(lcLoader, "phosphorfsloader.directoryloader")
+
+/// Worker-pool folds must see reads in plan order — shadowing and the
+/// intra-directory duplicate check are first-wins — and one at a time.
+constexpr QtConcurrent::ReduceOptions kPlanOrderReduce = QtConcurrent::OrderedReduce | QtConcurrent::SequentialReduce;
 } // namespace
 
 /**
@@ -26,6 +38,14 @@ Q_LOGGING_CATEGORY(lcLoader, "phosphorfsloader.directoryloader")
  * Defined in the source file rather than the header because no
  * consumer needs the symbol — the loader's public surface is only the
  * sink contract.
+ *
+ * A rescan is three steps, whichever `ScanMode` runs it: `planScan`
+ * lists the files and applies the entry cap, each planned file is read
+ * into a `Read`, and the reads are folded into a `Result` in plan order
+ * before `commit` swaps it in. `GuiThread` does all three on the calling
+ * stack; `WorkerPool` runs the read and the fold on the pool. Keeping the
+ * fold order fixed is what keeps layering and the cap identical between
+ * the two.
  */
 class DirectoryLoader::JsonScanStrategy : public IScanStrategy
 {
@@ -35,8 +55,23 @@ public:
     {
     }
 
+    ~JsonScanStrategy() override
+    {
+        // The pool holds m_sink; it must not outlive the loader borrowing it.
+        // The one place a discarded job is waited for.
+        cancelJob();
+        for (QFuture<Result>& job : m_retiredJobs) {
+            job.waitForFinished();
+        }
+    }
+
     QStringList performScan(const QStringList& directoriesInScanOrder) override;
 
+    bool scanDeferred() const override
+    {
+        return m_deferred;
+    }
+
     int registeredCount() const
     {
         return m_entries.size();
@@ -66,15 +101,195 @@ public:
         m_maxEntries = cap >= 0 ? cap : DirectoryLoader::kMaxEntries;
     }
 
+    /// Forget every remembered parse, so the next scan hands every file
+    /// to the sink again.
+    void invalidateManifest()
+    {
+        m_manifest.clear();
+    }
+
+    ScanMode scanMode() const
+    {
+        return m_mode;
+    }
+
+    /// Returns true when a debounced worker-pool scan was dropped by the
+    /// switch and the caller owes a rescan in its place.
+    bool setScanMode(ScanMode mode)
+    {
+        if (mode == m_mode) {
+            return false;
+        }
+        m_mode = mode;
+        const bool inFlight = !m_job.isFinished();
+        cancelJob();
+        return inFlight;
+    }
+
+    /// Hands a finished worker-pool scan back to the base. Set by the
+    /// owning loader, which is the one holding the `WatchedDirectorySet`.
+    std::function<void()> deliverDeferredScan;
+
+    /// Depth of synchronous loader entry points (`loadFromDirectories`,
+    /// `rescanNow`) currently on the stack. A scan started under one of
+    /// them must commit before returning, so `WorkerPool` waits for the
+    /// pool instead of deferring. A depth rather than a bool because an
+    /// `entriesChanged` slot may call `rescanNow` from inside one.
+    int synchronousDepth = 0;
+
 private:
+    /// One file a rescan will read, in the order the serial walk visits
+    /// it: directories highest-priority first, names sorted within each.
+    struct Candidate
+    {
+        QString path;
+        int directoryIndex = 0; ///< into `Plan::directories`
+    };
+
+    struct Plan
+    {
+        QStringList directories; ///< highest-priority first
+        QList<Candidate> files;
+        bool capTripped = false;
+    };
+
+    /// What one stat tells us about a file without opening it. Change
+    /// time is included so a rename into place that preserves mtime and
+    /// size (`cp -p`, `rsync -t`) still reads as a change.
+    struct FileStamp
+    {
+        qint64 size = -1;
+        qint64 mtimeMs = 0;
+        qint64 ctimeMs = 0;
+        bool operator==(const FileStamp&) const = default;
+    };
+
+    /// The manifest's memory of one file: the stamp and content hash it
+    /// had when the sink last parsed it, and the sink's verdict. `entry`
+    /// is the raw `parseFile` return, before any layering touched it.
+    struct ManifestRecord
+    {
+        FileStamp stamp;
+        /// The stamp was taken within `kRacyStampWindowMs` of the file's
+        /// mtime, so a write landing after it may not have moved it. The
+        /// next scan checks such a file's content hash even when the stamp
+        /// still matches.
+        bool racy = false;
+        /// SHA-1 of the content, taken whenever the file is read rather
+        /// than reused by stamp — including every parse, so the next touch
+        /// that leaves the bytes alone has something to match.
+        QByteArray contentHash;
+        std::optional<ParsedEntry> entry;
+    };
+    using Manifest = QHash<QString, ManifestRecord>; ///< absolute path → record
+
+    /// What reading one candidate produced. `record` is disengaged for an
+    /// oversized file, which the sink never saw; `record->entry` is
+    /// disengaged when the sink refused the file.
+    struct Read
+    {
+        QString path;
+        int directoryIndex = 0;
+        std::optional<ManifestRecord> record;
+    };
+
+    /// The fresh entry set, folded from reads strictly in plan order.
+    struct Result
+    {
+        QHash<QString, DirectoryLoader::Entry> fresh;
+        QHash<QString, ParsedEntry> parsedByKey;
+        // Files this scan looked at and did not register — oversized, unparseable,
+        // empty key, or an intra-directory duplicate. NOT the cross-directory
+        // shadowed ones: a shadowed file's content changes nothing observable while
+        // the override that shadows it exists, and its removal is a directory event
+        // the search-path watch already catches.
+        //
+        // The refused files own no entry,
+        // but they still get a per-file watch below: an in-place edit that FIXES a
+        // broken file is the most common way an entry goes from invisible to
+        // visible, and a directory watch does not fire on content changes to a file
+        // that already exists. Both sibling scanners do the same
+        // (MetadataPackScanStrategy re-arms the metadata.json watch regardless of
+        // the parse outcome; ScriptedAlgorithmLoader keeps m_refusedFilePaths).
+        QStringList refusedPaths;
+        // Track keys already seen within the directory being folded so we
+        // can warn on intra-directory collisions (across directories is
+        // legitimate user-wins-over-system layering, which `fold` handles
+        // separately). Map value is the absolute path of the first file
+        // claiming the key so the warning can name both the winning file
+        // and the ignored file.
+        //
+        // INTRA-directory only: lookup key is case-folded so
+        // rsync-from-macOS-APFS (case-insensitive) onto ext4
+        // (case-sensitive) — where `Curve.json` and `curve.json`
+        // coexist on ext4 but collide on APFS — warns consistently
+        // on both platforms. The ORIGINAL case is still used for the
+        // registered entry key (sinks may care about case for display
+        // purposes) — only the collision check itself is case-folded.
+        //
+        // Cross-directory layering uses the raw key, so user
+        // `Curve.json` (key="Foo") in one dir and system `curve.json`
+        // (key="foo") in another resolve to two distinct registry
+        // entries. That asymmetry is deliberate: case-folding
+        // cross-dir would risk silently dropping legitimate user
+        // overrides whose keys happen to differ only in case from a
+        // system entry, and the only realistic way to hit a mixed-
+        // sensitivity collision is rsync APFS → ext4 (already
+        // round-tripped via the intra-dir warning above).
+        QHash<QString, QString> keysInThisDir;
+        int directoryIndex = -1; ///< the directory `keysInThisDir` belongs to
+        /// Every file the sink ruled on this scan, for the next one to reuse.
+        Manifest manifest;
+
+        void fold(const Read& read, const QStringList& directories);
+    };
+
+    /// A worker-pool result waiting for `deliverDeferredScan` to bring the
+    /// base back into `performScan`.
+    struct Ready
+    {
+        QStringList directories; ///< as passed to the `performScan` that dispatched it
+        bool capTripped = false;
+        Result result;
+    };
+
+    static Plan planScan(const QStringList& directoriesInScanOrder, int maxEntries);
+    static Read readCandidate(IDirectoryLoaderSink& sink, const Manifest& prior, const Candidate& candidate);
+
+    QStringList commit(Result result, bool capTripped);
+    void cancelJob();
+    void onJobFinished(quint64 generation, Result result);
+
     IDirectoryLoaderSink* m_sink = nullptr;
     QHash<QString, DirectoryLoader::Entry> m_entries; ///< key → tracked entry
+    /// Per-file parse results from the last committed scan. Watcher-driven
+    /// rescans consult it so an unchanged file is stat'ed, not re-read and
+    /// re-parsed; `invalidateManifest` empties it for a full reparse.
+    Manifest m_manifest;
     int m_maxEntries = DirectoryLoader::kMaxEntries;
+    ScanMode m_mode = ScanMode::GuiThread;
+
+    /// The debounced worker-pool scan in flight, if any. Only ever one: a
+    /// newer rescan supersedes it, and a synchronous one discards it. Both
+    /// bump `m_jobGeneration`, and a result landing under an older
+    /// generation is dropped.
+    QFuture<Result> m_job;
+    quint64 m_jobGeneration = 0;
+    /// Discarded jobs whose reads may still be running. Pruned as they
+    /// finish; the destructor waits out the rest.
+    QList<QFuture<Result>> m_retiredJobs;
+    /// Context for the jobs' continuations, so they run on this thread.
+    QObject m_jobContext;
+    QStringList m_jobDirectories;
+    bool m_jobCapTripped = false;
+    std::optional<Ready> m_ready;
+    bool m_deferred = false;
 };
 
-QStringList DirectoryLoader::JsonScanStrategy::performScan(const QStringList& directoriesInScanOrder)
+DirectoryLoader::JsonScanStrategy::Plan
+DirectoryLoader::JsonScanStrategy::planScan(const QStringList& directoriesInScanOrder, int maxEntries)
 {
-    // Build the fresh set in REVERSE scan order — first-wins semantics.
+    // Plan in REVERSE scan order — first-wins semantics.
     //
     // Callers register dirs system-first / user-last (per the public
     // `loadFromDirectories` docstring); iterating in reverse lets the
@@ -92,38 +307,26 @@ QStringList DirectoryLoader::JsonScanStrategy::performScan(const QStringList& di
     // never user overrides — assuming the user dir alone fits within
     // the cap. If the user dir contains more than `m_maxEntries`
     // files the cap trips during the user pass and system overrides
-    // are then never scanned at all (the warning below makes the
+    // are then never scanned at all (the warning in `commit` makes the
     // pruning-or-bumping decision explicit). User-wins layering is
     // never violated either way.
-    QHash<QString, Entry> fresh;
-    QHash<QString, ParsedEntry> freshParsedByKey;
-    // Files this scan looked at and did not register — oversized, unparseable,
-    // empty key, or an intra-directory duplicate. NOT the cross-directory
-    // shadowed ones: a shadowed file's content changes nothing observable while
-    // the override that shadows it exists, and its removal is a directory event
-    // the search-path watch already catches.
     //
-    // The refused files own no entry,
-    // but they still get a per-file watch below: an in-place edit that FIXES a
-    // broken file is the most common way an entry goes from invisible to
-    // visible, and a directory watch does not fire on content changes to a file
-    // that already exists. Both sibling scanners do the same
-    // (MetadataPackScanStrategy re-arms the metadata.json watch regardless of
-    // the parse outcome; ScriptedAlgorithmLoader keeps m_refusedFilePaths).
-    QStringList refusedPaths;
-
-    bool capTripped = false;
+    // The cap is applied HERE, before anything is read, rather than in the
+    // read loop. Every planned file is read exactly once and nothing is
+    // skipped between planning and folding, so counting at plan time
+    // charges the same files, in the same order, as counting while reading
+    // would — and it lets the worker pool be handed an exact, bounded list.
+    Plan plan;
     /// Files CONSIDERED this rescan, summed across every registered directory.
     /// The cap counts these rather than the entries that survive to
     /// registration: a file that fails to parse, yields an empty key, loses an
     /// intra-directory duplicate check, or is shadowed cross-directory has
-    /// still been read and parsed on the GUI thread, which is the work the cap
-    /// exists to bound.
+    /// still been read and parsed, which is the work the cap exists to bound.
     int filesConsidered = 0;
 
     for (auto dirIt = directoriesInScanOrder.crbegin(); dirIt != directoriesInScanOrder.crend(); ++dirIt) {
         const QString& directory = *dirIt;
-        if (capTripped) {
+        if (plan.capTripped) {
             break;
         }
         QDir dir(directory);
@@ -145,39 +348,15 @@ QStringList DirectoryLoader::JsonScanStrategy::performScan(const QStringList& di
         // same user could have copied in anyway. Refusing them would break the
         // one legitimate use people actually have: symlinking a curve out of a
         // dotfiles repo.
-        QStringList files = dir.entryList({QStringLiteral("*.json")}, QDir::Files, QDir::Name);
-
-        // Track keys already seen within THIS directory so we can warn
-        // on intra-directory collisions (across directories is legitimate
-        // user-wins-over-system layering, which we handle below).
-        // Map value is the absolute path of the first file claiming the
-        // key so the warning can name both the winning file and the
-        // ignored file.
-        //
-        // INTRA-directory only: lookup key is case-folded so
-        // rsync-from-macOS-APFS (case-insensitive) onto ext4
-        // (case-sensitive) — where `Curve.json` and `curve.json`
-        // coexist on ext4 but collide on APFS — warns consistently
-        // on both platforms. The ORIGINAL case is still used for the
-        // registered entry key (sinks may care about case for display
-        // purposes) — only the collision check itself is case-folded.
-        //
-        // Cross-directory layering uses the raw key, so user
-        // `Curve.json` (key="Foo") in one dir and system `curve.json`
-        // (key="foo") in another resolve to two distinct registry
-        // entries. That asymmetry is deliberate: case-folding
-        // cross-dir would risk silently dropping legitimate user
-        // overrides whose keys happen to differ only in case from a
-        // system entry, and the only realistic way to hit a mixed-
-        // sensitivity collision is rsync APFS → ext4 (already
-        // round-tripped via the intra-dir warning above).
-        QHash<QString, QString> keysInThisDir;
+        const QStringList files = dir.entryList({QStringLiteral("*.json")}, QDir::Files, QDir::Name);
+        const int directoryIndex = plan.directories.size();
+        plan.directories.append(directory);
 
         for (const QString& file : files) {
             // Entry-count DoS guard — paired with the per-file byte cap
-            // below. A directory sprayed with tens of thousands of empty
-            // `*.json` files would otherwise parse every one of them on
-            // the GUI thread on every watcher fire.
+            // in `readCandidate`. A directory sprayed with tens of
+            // thousands of empty `*.json` files would otherwise parse
+            // every one of them on every watcher fire.
             //
             // Counts files considered, NOT keys registered. Every one of the
             // sprayed files above parses (cheaply, but not freely) and then
@@ -185,89 +364,192 @@ QStringList DirectoryLoader::JsonScanStrategy::performScan(const QStringList& di
             // the cap and the guard would let exactly the attack it names
             // straight through. Same for tens of thousands of files that all
             // resolve to one key.
-            if (filesConsidered >= m_maxEntries) {
-                capTripped = true;
+            if (filesConsidered >= maxEntries) {
+                plan.capTripped = true;
                 break;
             }
             ++filesConsidered;
+            plan.files.append(Candidate{dir.absoluteFilePath(file), directoryIndex});
+        }
+    }
+    return plan;
+}
 
-            const QString fullPath = dir.absoluteFilePath(file);
+DirectoryLoader::JsonScanStrategy::Read
+DirectoryLoader::JsonScanStrategy::readCandidate(IDirectoryLoaderSink& sink, const Manifest& prior,
+                                                 const Candidate& candidate)
+{
+    Read read{candidate.path, candidate.directoryIndex, std::nullopt};
 
-            // DoS / foot-gun guard: untrusted same-user files should not
-            // be able to stall the GUI thread with a 2 GB blob. Stat
-            // first; skip + warn on oversize. Sinks that want a lower
-            // cap enforce their own on top of this.
-            //
-            // This is a stat-side cap, not a read-side one: a file that
-            // passes the size check here and then grows before the sink
-            // reads it is not re-checked. The sink owns the descriptor and
-            // is the only layer that can bound the actual bytes read, so a
-            // descriptor-side ceiling (if a sink needs a hard one) belongs
-            // there, not here.
-            const QFileInfo fileInfo(fullPath);
-            if (fileInfo.size() > DirectoryLoader::kMaxFileBytes) {
-                qCWarning(lcLoader) << "Skipping oversized file" << fullPath << "(" << fileInfo.size() << "bytes, cap"
-                                    << DirectoryLoader::kMaxFileBytes << ")";
-                refusedPaths.append(fullPath);
-                continue;
-            }
+    // DoS / foot-gun guard: untrusted same-user files should not
+    // be able to stall a scan with a 2 GB blob. Stat first; skip +
+    // warn on oversize. Sinks that want a lower cap enforce their
+    // own on top of this.
+    //
+    // This is a stat-side cap, not a read-side one: a file that
+    // passes the size check here and then grows before the sink
+    // reads it is not re-checked. The sink owns the descriptor and
+    // is the only layer that can bound the actual bytes read, so a
+    // descriptor-side ceiling (if a sink needs a hard one) belongs
+    // there, not here.
+    const QFileInfo fileInfo(candidate.path);
+    if (fileInfo.size() > DirectoryLoader::kMaxFileBytes) {
+        qCWarning(lcLoader) << "Skipping oversized file" << candidate.path << "(" << fileInfo.size() << "bytes, cap"
+                            << DirectoryLoader::kMaxFileBytes << ")";
+        return read;
+    }
 
-            auto parsed = m_sink->parseFile(fullPath);
-            if (!parsed) {
-                refusedPaths.append(fullPath);
-                continue;
-            }
-            const QString key = parsed->key;
-            if (key.isEmpty()) {
-                qCWarning(lcLoader) << "parseFile returned entry with empty key from" << fullPath
-                                    << "— sinks must set ParsedEntry::key";
-                refusedPaths.append(fullPath);
-                continue;
-            }
+    ManifestRecord& record = read.record.emplace();
+    record.stamp = FileStamp{fileInfo.size(), fileInfo.lastModified().toMSecsSinceEpoch(),
+                             fileInfo.metadataChangeTime().toMSecsSinceEpoch()};
+    record.racy =
+        record.stamp.mtimeMs > QDateTime::currentMSecsSinceEpoch() - DirectoryLoader::kRacyStampWindowMs;
+    const auto cached = prior.constFind(candidate.path);
+    const bool haveCached = cached != prior.constEnd();
+    // Untouched since the sink last parsed it: reuse the verdict as is.
+    if (haveCached && cached->stamp == record.stamp && !cached->racy) {
+        record = *cached;
+        return read;
+    }
+    // Touched, but possibly not changed — a save without edits, a `touch`,
+    // a sync tool rewriting identical bytes. Hashing costs one bounded
+    // read; parsing is the sink's full schema pass. Hashed before a first
+    // parse too: the record it lands in is what that later touch compares
+    // against.
+    {
+        QFile file(candidate.path);
+        if (file.open(QIODevice::ReadOnly)) {
+            record.contentHash =
+                QCryptographicHash::hash(file.read(DirectoryLoader::kMaxFileBytes + 1), QCryptographicHash::Sha1);
+        }
+    }
+    if (haveCached && !record.contentHash.isEmpty() && record.contentHash == cached->contentHash) {
+        record.entry = cached->entry;
+        return read;
+    }
+    record.entry = sink.parseFile(candidate.path);
+    return read;
+}
 
-            // Intra-directory duplicate: two files in the SAME dir with
-            // the same key (case-folded). Filesystem enumeration is
-            // alphabetic (we sort above), so the first-seen file wins
-            // deterministically.
-            const QString foldedKey = key.toLower();
-            if (auto winnerIt = keysInThisDir.constFind(foldedKey); winnerIt != keysInThisDir.constEnd()) {
-                qCWarning(lcLoader).nospace()
-                    << "Duplicate key '" << key << "' within directory " << directory << " — kept '" << winnerIt.value()
-                    << "', ignored '" << fullPath << "' (winner is alphabetically first)";
-                refusedPaths.append(fullPath);
-                continue;
-            }
-            keysInThisDir.insert(foldedKey, fullPath);
-
-            // Cross-directory: first-wins (we iterate user-first via
-            // the reverse loop above). If this key was already claimed
-            // by a higher-priority dir, the currently-scanned (lower-
-            // priority) file is shadowed — record its path on the
-            // already-tracked entry AND mirror onto the matching
-            // ParsedEntry so the sink sees it in commitBatch without a
-            // separate propagation pass. The shadowed entry is NOT
-            // registered with the sink; only the highest-priority claim is.
-            if (auto existing = fresh.find(key); existing != fresh.end()) {
-                if (existing->systemSourcePath.isEmpty()) {
-                    existing->systemSourcePath = parsed->sourcePath;
-                    auto pIt = freshParsedByKey.find(key);
-                    if (pIt != freshParsedByKey.end()) {
-                        pIt->systemSourcePath = parsed->sourcePath;
-                    }
-                }
-                continue;
+void DirectoryLoader::JsonScanStrategy::Result::fold(const Read& read, const QStringList& directories)
+{
+    if (read.directoryIndex != directoryIndex) {
+        directoryIndex = read.directoryIndex;
+        keysInThisDir.clear();
+    }
+    if (read.record) {
+        manifest.insert(read.path, *read.record);
+    }
+    if (!read.record || !read.record->entry) {
+        refusedPaths.append(read.path);
+        return;
+    }
+    const ParsedEntry& parsed = *read.record->entry;
+    const QString& key = parsed.key;
+    if (key.isEmpty()) {
+        qCWarning(lcLoader) << "parseFile returned entry with empty key from" << read.path
+                            << "— sinks must set ParsedEntry::key";
+        refusedPaths.append(read.path);
+        return;
+    }
+
+    // Intra-directory duplicate: two files in the SAME dir with
+    // the same key (case-folded). Filesystem enumeration is
+    // alphabetic (`planScan` sorts), so the first-seen file wins
+    // deterministically.
+    const QString foldedKey = key.toLower();
+    if (auto winnerIt = keysInThisDir.constFind(foldedKey); winnerIt != keysInThisDir.constEnd()) {
+        qCWarning(lcLoader).nospace() << "Duplicate key '" << key << "' within directory "
+                                      << directories.at(read.directoryIndex) << " — kept '" << winnerIt.value()
+                                      << "', ignored '" << read.path << "' (winner is alphabetically first)";
+        refusedPaths.append(read.path);
+        return;
+    }
+    keysInThisDir.insert(foldedKey, read.path);
+
+    // Cross-directory: first-wins (`planScan` orders user-first).
+    // If this key was already claimed by a higher-priority dir, the
+    // currently-folded (lower-priority) file is shadowed — record its
+    // path on the already-tracked entry AND mirror onto the matching
+    // ParsedEntry so the sink sees it in commitBatch without a
+    // separate propagation pass. The shadowed entry is NOT
+    // registered with the sink; only the highest-priority claim is.
+    if (auto existing = fresh.find(key); existing != fresh.end()) {
+        if (existing->systemSourcePath.isEmpty()) {
+            existing->systemSourcePath = parsed.sourcePath;
+            auto pIt = parsedByKey.find(key);
+            if (pIt != parsedByKey.end()) {
+                pIt->systemSourcePath = parsed.sourcePath;
             }
+        }
+        return;
+    }
 
-            Entry trackedEntry;
-            trackedEntry.key = key;
-            trackedEntry.sourcePath = parsed->sourcePath;
-            trackedEntry.systemSourcePath = parsed->systemSourcePath;
-            fresh.insert(key, trackedEntry);
+    DirectoryLoader::Entry trackedEntry;
+    trackedEntry.key = key;
+    trackedEntry.sourcePath = parsed.sourcePath;
+    trackedEntry.systemSourcePath = parsed.systemSourcePath;
+    fresh.insert(key, trackedEntry);
 
-            freshParsedByKey.insert(key, std::move(*parsed));
+    parsedByKey.insert(key, parsed);
+}
+
+QStringList DirectoryLoader::JsonScanStrategy::performScan(const QStringList& directoriesInScanOrder)
+{
+    m_deferred = false;
+
+    // Back from `deliverDeferredScan`: commit what the pool built. The
+    // directory check is belt-and-braces — every call that changes the
+    // registered set is synchronous and discards the job first.
+    if (m_ready) {
+        Ready ready = std::move(*m_ready);
+        m_ready.reset();
+        if (ready.directories == directoriesInScanOrder) {
+            return commit(std::move(ready.result), ready.capTripped);
         }
     }
 
+    Plan plan = planScan(directoriesInScanOrder, m_maxEntries);
+
+    if (m_mode == ScanMode::GuiThread) {
+        Result result;
+        for (const Candidate& candidate : std::as_const(plan.files)) {
+            result.fold(readCandidate(*m_sink, m_manifest, candidate), plan.directories);
+        }
+        return commit(std::move(result), plan.capTripped);
+    }
+
+    // Either way, whatever the pool is still working on was planned from
+    // an older listing than this one.
+    cancelJob();
+
+    IDirectoryLoaderSink* sink = m_sink;
+    const auto readOne = [sink, prior = m_manifest](const Candidate& candidate) {
+        return readCandidate(*sink, prior, candidate);
+    };
+    const auto foldInOrder = [directories = plan.directories](Result& result, const Read& next) {
+        result.fold(next, directories);
+    };
+
+    if (synchronousDepth > 0 || plan.files.isEmpty()) {
+        Result result = QtConcurrent::blockingMappedReduced<Result>(QThreadPool::globalInstance(), plan.files, readOne,
+                                                                    foldInOrder, kPlanOrderReduce);
+        return commit(std::move(result), plan.capTripped);
+    }
+
+    m_jobDirectories = directoriesInScanOrder;
+    m_jobCapTripped = plan.capTripped;
+    m_job = QtConcurrent::mappedReduced<Result>(QThreadPool::globalInstance(), std::move(plan.files), readOne,
+                                                foldInOrder, kPlanOrderReduce);
+    m_job.then(&m_jobContext, [this, generation = m_jobGeneration](Result result) {
+        onJobFinished(generation, std::move(result));
+    });
+    m_deferred = true;
+    return {};
+}
+
+QStringList DirectoryLoader::JsonScanStrategy::commit(Result result, bool capTripped)
+{
     if (capTripped) {
         // System dirs may not have been fully scanned (cap trips on
         // count, not on dir boundary). For surviving entries that
@@ -279,7 +561,7 @@ QStringList DirectoryLoader::JsonScanStrategy::performScan(const QStringList& di
         // tripped scan re-derives the path correctly; until then, the
         // last successfully observed value is the best available
         // estimate.
-        for (auto it = fresh.begin(); it != fresh.end(); ++it) {
+        for (auto it = result.fresh.begin(); it != result.fresh.end(); ++it) {
             if (!it->systemSourcePath.isEmpty()) {
                 continue; // shadowed in this scan; current value is authoritative
             }
@@ -288,8 +570,8 @@ QStringList DirectoryLoader::JsonScanStrategy::performScan(const QStringList& di
                 continue; // never had a shadow recorded
             }
             it->systemSourcePath = prior->systemSourcePath;
-            auto pIt = freshParsedByKey.find(it.key());
-            if (pIt != freshParsedByKey.end()) {
+            auto pIt = result.parsedByKey.find(it.key());
+            if (pIt != result.parsedByKey.end()) {
                 pIt->systemSourcePath = prior->systemSourcePath;
             }
         }
@@ -302,8 +584,8 @@ QStringList DirectoryLoader::JsonScanStrategy::performScan(const QStringList& di
     // by key gives the sink a stable iteration order across platforms
     // and Qt versions (QHash iteration order is randomised in Qt6).
     QList<ParsedEntry> freshParsed;
-    freshParsed.reserve(freshParsedByKey.size());
-    for (auto it = freshParsedByKey.cbegin(); it != freshParsedByKey.cend(); ++it) {
+    freshParsed.reserve(result.parsedByKey.size());
+    for (auto it = result.parsedByKey.cbegin(); it != result.parsedByKey.cend(); ++it) {
         freshParsed.append(it.value());
     }
     std::sort(freshParsed.begin(), freshParsed.end(), [](const ParsedEntry& a, const ParsedEntry& b) {
@@ -314,12 +596,13 @@ QStringList DirectoryLoader::JsonScanStrategy::performScan(const QStringList& di
     // registered before but is no longer on disk is a removal.
     QStringList removedKeys;
     for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
-        if (!fresh.contains(it.key())) {
+        if (!result.fresh.contains(it.key())) {
             removedKeys.append(it.key());
         }
     }
 
-    m_entries = std::move(fresh);
+    m_entries = std::move(result.fresh);
+    m_manifest = std::move(result.manifest);
 
     // Hand the batch to the sink — single call, so the sink can emit
     // one bulk-reload signal on its registry instead of N per-key
@@ -328,11 +611,11 @@ QStringList DirectoryLoader::JsonScanStrategy::performScan(const QStringList& di
 
     // Tell the base which paths to install per-file watches on.
     QStringList desiredFileWatches;
-    desiredFileWatches.reserve(m_entries.size() + refusedPaths.size());
+    desiredFileWatches.reserve(m_entries.size() + result.refusedPaths.size());
     for (const auto& entry : std::as_const(m_entries)) {
         desiredFileWatches.append(entry.sourcePath);
     }
-    desiredFileWatches.append(refusedPaths);
+    desiredFileWatches.append(result.refusedPaths);
     // Sorted before returning, like MetadataPackScanStrategy does. Nothing
     // depends on it: the base copies into a QSet (so it dedupes and ignores
     // order), the IScanStrategy contract promises no ordering, and this
@@ -346,6 +629,37 @@ QStringList DirectoryLoader::JsonScanStrategy::performScan(const QStringList& di
     return desiredFileWatches;
 }
 
+void DirectoryLoader::JsonScanStrategy::cancelJob()
+{
+    // Cancelling only stops the pool from starting more reads; the ones
+    // already running finish on their own. The GUI thread does not wait
+    // for them: their `parseFile` calls are reentrant by this mode's
+    // contract, so overlapping the next scan is harmless, and the
+    // generation bump turns the job's eventual result into a no-op.
+    ++m_jobGeneration;
+    m_retiredJobs.removeIf([](const QFuture<Result>& job) {
+        return job.isFinished();
+    });
+    if (!m_job.isFinished()) {
+        m_job.cancel();
+        m_retiredJobs.append(m_job);
+    }
+    m_job = QFuture<Result>();
+    m_ready.reset();
+}
+
+void DirectoryLoader::JsonScanStrategy::onJobFinished(quint64 generation, Result result)
+{
+    if (generation != m_jobGeneration) {
+        return; // superseded or discarded
+    }
+    m_ready = Ready{m_jobDirectories, m_jobCapTripped, std::move(result)};
+    m_job = QFuture<Result>();
+    if (deliverDeferredScan) {
+        deliverDeferredScan();
+    }
+}
+
 // ─── DirectoryLoader ────────────────────────────────────────────────────────
 
 DirectoryLoader::DirectoryLoader(IDirectoryLoaderSink& sink, QObject* parent)
@@ -356,6 +670,9 @@ DirectoryLoader::DirectoryLoader(IDirectoryLoaderSink& sink, QObject* parent)
     // Forward the base's rescan signal to the loader's public
     // `entriesChanged` so existing consumers keep working without changes.
     connect(m_watcher.get(), &WatchedDirectorySet::rescanCompleted, this, &DirectoryLoader::entriesChanged);
+    m_strategy->deliverDeferredScan = [this]() {
+        m_watcher->completeDeferredScan();
+    };
 }
 
 DirectoryLoader::~DirectoryLoader() = default;
@@ -367,18 +684,38 @@ int DirectoryLoader::loadFromDirectory(const QString& directory, LiveReload live
 
 int DirectoryLoader::loadFromDirectories(const QStringList& directories, LiveReload liveReload, RegistrationOrder order)
 {
+    ++m_strategy->synchronousDepth;
     m_watcher->registerDirectories(directories, liveReload, order);
+    --m_strategy->synchronousDepth;
     return m_strategy->registeredCount();
 }
 
 void DirectoryLoader::requestRescan()
 {
+    // An explicit request means something the file stamps cannot show
+    // has changed; see the header.
+    m_strategy->invalidateManifest();
     m_watcher->requestRescan();
 }
 
 void DirectoryLoader::rescanNow()
 {
+    m_strategy->invalidateManifest();
+    ++m_strategy->synchronousDepth;
     m_watcher->rescanNow();
+    --m_strategy->synchronousDepth;
+}
+
+void DirectoryLoader::setScanMode(ScanMode mode)
+{
+    if (m_strategy->setScanMode(mode)) {
+        m_watcher->requestRescan();
+    }
+}
+
+DirectoryLoader::ScanMode DirectoryLoader::scanMode() const
+{
+    return m_strategy->scanMode();
 }
 
 int DirectoryLoader::registeredCount() const
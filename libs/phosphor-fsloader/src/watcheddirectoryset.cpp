@@ -360,6 +360,18 @@ void WatchedDirectorySet::rescanNow()
     rescanAll();
 }
 
+void WatchedDirectorySet::completeDeferredScan()
+{
+    if (thread() != QThread::currentThread()) {
+        Q_ASSERT_X(false, "WatchedDirectorySet::completeDeferredScan", "GUI-thread only — see class docs");
+        qCWarning(lcWatcher) << "completeDeferredScan called off the owning thread; refusing";
+        return;
+    }
+    // No m_debounceTimer.stop(): a request that arrived while the worker
+    // was busy describes a change the deferred result may not contain.
+    rescanAll();
+}
+
 void WatchedDirectorySet::requestRescan()
 {
     // Asserted AND guarded, like its siblings. This is reached from
@@ -483,18 +495,25 @@ void WatchedDirectorySet::rescanAll()
     // after this rescan.
     const QStringList desiredFileWatches = m_strategy->performScan(m_directories);
 
-    // Arm per-file watches AFTER commit so the watch set exactly
-    // matches the strategy's view of "currently relevant" paths.
-    // QFileSystemWatcher auto-drops entries on atomic-rename saves
-    // (most editors), so we re-sync on every rescan — the add/remove
-    // diff makes this cheap. `syncFileWatches` itself null-checks
-    // `m_watcher`, but gating here saves the QSet allocation when
-    // live-reload is off.
-    if (m_watcher) {
-        syncFileWatches(desiredFileWatches);
-    }
+    // A deferred scan has only been dispatched: nothing is committed, so
+    // there is nothing to re-arm and nothing to announce. The strategy
+    // comes back through `completeDeferredScan` when the result lands.
+    // The replay bookkeeping below still runs, so a request captured
+    // during the dispatch is not lost.
+    if (!m_strategy->scanDeferred()) {
+        // Arm per-file watches AFTER commit so the watch set exactly
+        // matches the strategy's view of "currently relevant" paths.
+        // QFileSystemWatcher auto-drops entries on atomic-rename saves
+        // (most editors), so we re-sync on every rescan — the add/remove
+        // diff makes this cheap. `syncFileWatches` itself null-checks
+        // `m_watcher`, but gating here saves the QSet allocation when
+        // live-reload is off.
+        if (m_watcher) {
+            syncFileWatches(desiredFileWatches);
+        }
 
-    Q_EMIT rescanCompleted();
+        Q_EMIT rescanCompleted();
+    }
 
     // Race-guard replay. `Q_EMIT` is a synchronous call: every
     // `Qt::DirectConnection` slot wired to `rescanCompleted` runs
@@ -10,13 +10,16 @@
 #include <QFileInfo>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QSemaphore>
 #include <QSignalSpy>
 #include <QTemporaryDir>
 #include <QTest>
+#include <QThread>
 #include <QTimer>
 
 #include <algorithm>
 #include <any>
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -32,6 +35,13 @@ public:
     std::optional<ParsedEntry> parseFile(const QString& filePath) override
     {
         ++parseCalls;
+        return parseRecord(filePath);
+    }
+
+    /// The parse itself, free of any member state, so the worker-pool sink
+    /// below can call it from several threads at once.
+    static std::optional<ParsedEntry> parseRecord(const QString& filePath)
+    {
         QFile f(filePath);
         if (!f.open(QIODevice::ReadOnly)) {
             return std::nullopt;
@@ -143,6 +153,43 @@ public:
     }
 };
 
+/// Sink for `ScanMode::WorkerPool`, which calls `parseFile` from several
+/// pool threads at once: every member it touches there is atomic or
+/// thread-safe, and the inherited `parseCalls` is left alone. `gate` lets a
+/// test hold a debounced scan on the pool while it acts on the GUI thread;
+/// it starts open.
+class PoolSink : public RecordingSink
+{
+public:
+    std::optional<ParsedEntry> parseFile(const QString& filePath) override
+    {
+        ++poolParseCalls;
+        if (QThread::currentThread() != guiThread) {
+            ++offGuiParseCalls;
+        }
+        gate.acquire();
+        gate.release();
+        return parseRecord(filePath);
+    }
+
+    std::atomic<int> poolParseCalls{0};
+    std::atomic<int> offGuiParseCalls{0};
+    QSemaphore gate{1};
+    QThread* const guiThread = QThread::currentThread();
+};
+
+/// `key|sourcePath|systemSourcePath` per tracked entry, in `entries()`
+/// order, so two loaders' views can be compared in one QCOMPARE.
+QStringList describeEntries(const DirectoryLoader& loader)
+{
+    QStringList described;
+    const auto entries = loader.entries();
+    for (const DirectoryLoader::Entry& entry : entries) {
+        described.append(entry.key + QLatin1Char('|') + entry.sourcePath + QLatin1Char('|') + entry.systemSourcePath);
+    }
+    return described;
+}
+
 } // namespace
 
 class TestDirectoryLoader : public QObject
@@ -1121,6 +1168,199 @@ private Q_SLOTS:
         QVERIFY(sink.registry.isEmpty());
     }
 
+    /// Watcher-driven rescans hand only changed files to `parseFile`: an
+    /// edited file is reparsed, a touched one with identical bytes is matched
+    /// by content hash, and the rest reuse their previous parse while the
+    /// sink still receives the full set. `requestRescan` reparses everything.
+    ///
+    /// The fixtures age past `kRacyStampWindowMs` first; a stamp taken right
+    /// after a write is not trusted (`testInPlaceRewriteDetectedByTheFileWatch`
+    /// is the slot that depends on that).
+    void testManifest_rescanReparsesOnlyChangedFiles()
+    {
+        const QString a = m_tmp->filePath(QStringLiteral("a.json"));
+        const QString b = m_tmp->filePath(QStringLiteral("b.json"));
+        QVERIFY(writeJson(a, QStringLiteral("alpha"), QStringLiteral("v1")));
+        QVERIFY(writeJson(b, QStringLiteral("beta"), QStringLiteral("v1")));
+        QVERIFY(writeJson(m_tmp->filePath(QStringLiteral("c.json")), QStringLiteral("gamma"), QStringLiteral("v1")));
+        QTest::qWait(int(DirectoryLoader::kRacyStampWindowMs) + 100);
+
+        RecordingSink sink;
+        DirectoryLoader loader(sink);
+        loader.setDebounceIntervalForTest(1);
+        loader.loadFromDirectory(m_tmp->path(), LiveReload::On);
+        QCOMPARE(sink.parseCalls, 3);
+
+        QSignalSpy edited(&loader, &DirectoryLoader::entriesChanged);
+        QVERIFY(writeJson(b, QStringLiteral("beta"), QStringLiteral("v2")));
+        QVERIFY(edited.wait(2000));
+        QCOMPARE(sink.parseCalls, 4);
+        QCOMPARE(sink.lastCurrent.size(), 3);
+        QCOMPARE(sink.registry.value(QStringLiteral("beta")), std::string("v2"));
+
+        QSignalSpy touched(&loader, &DirectoryLoader::entriesChanged);
+        QVERIFY(writeJson(a, QStringLiteral("alpha"), QStringLiteral("v1")));
+        QVERIFY(touched.wait(2000));
+        QCOMPARE(sink.parseCalls, 4);
+        QCOMPARE(sink.lastCurrent.size(), 3);
+
+        QSignalSpy explicitRescan(&loader, &DirectoryLoader::entriesChanged);
+        loader.requestRescan();
+        QVERIFY(explicitRescan.wait(2000));
+        QCOMPARE(sink.parseCalls, 7);
+    }
+
+    // ── ScanMode::WorkerPool ────────────────────────────────────────────
+
+    /// The pool folds reads in the serial walk's order, so every layering
+    /// rule — user-over-system shadowing, the case-folded intra-directory
+    /// duplicate check, refused files — and the cap's file accounting
+    /// come out identical to a GUI-thread scan of the same tree.
+    void testWorkerPool_matchesGuiThreadScan()
+    {
+        QTemporaryDir systemDir;
+        QTemporaryDir userDir;
+        QVERIFY(systemDir.isValid() && userDir.isValid());
+        for (int i = 0; i < 24; ++i) {
+            const QString name = QStringLiteral("sys-%1.json").arg(i, 2, 10, QLatin1Char('0'));
+            QVERIFY(writeJson(systemDir.filePath(name), QStringLiteral("key-%1").arg(i), QStringLiteral("system")));
+        }
+        for (int i = 0; i < 24; i += 3) {
+            const QString name = QStringLiteral("user-%1.json").arg(i, 2, 10, QLatin1Char('0'));
+            QVERIFY(writeJson(userDir.filePath(name), QStringLiteral("key-%1").arg(i), QStringLiteral("user")));
+        }
+        // Case-folded duplicate of user-00's key, sorted after it: refused.
+        QVERIFY(writeJson(userDir.filePath(QStringLiteral("zz-dup.json")), QStringLiteral("KEY-0"),
+                          QStringLiteral("dup")));
+        QFile bad(userDir.filePath(QStringLiteral("broken.json")));
+        QVERIFY(bad.open(QIODevice::WriteOnly));
+        bad.write("{ not valid json ");
+        bad.close();
+
+        const QStringList dirs{systemDir.path(), userDir.path()};
+        RecordingSink serialSink;
+        DirectoryLoader serial(serialSink);
+        PoolSink poolSink;
+        DirectoryLoader pooled(poolSink);
+        pooled.setScanMode(DirectoryLoader::ScanMode::WorkerPool);
+        QCOMPARE(pooled.scanMode(), DirectoryLoader::ScanMode::WorkerPool);
+
+        QCOMPARE(pooled.loadFromDirectories(dirs), serial.loadFromDirectories(dirs));
+        QCOMPARE(describeEntries(pooled), describeEntries(serial));
+        QCOMPARE(poolSink.registry, serialSink.registry);
+        QCOMPARE(poolSink.registry.value(QStringLiteral("key-0")), std::string("user"));
+        QCOMPARE(poolSink.poolParseCalls.load(), serialSink.parseCalls);
+
+        // A cap that trips part-way through the system directory.
+        serial.setMaxEntriesForTest(20);
+        pooled.setMaxEntriesForTest(20);
+        serialSink.parseCalls = 0;
+        poolSink.poolParseCalls = 0;
+        serial.rescanNow();
+        pooled.rescanNow();
+        QCOMPARE(describeEntries(pooled), describeEntries(serial));
+        QCOMPARE(poolSink.lastRemoved, serialSink.lastRemoved);
+        QCOMPARE(poolSink.poolParseCalls.load(), 20);
+        QCOMPARE(serialSink.parseCalls, 20);
+    }
+
+    /// A debounced rescan parses entirely on the pool and commits once when
+    /// the result lands: the dispatch itself is not a completed rescan, so
+    /// `entriesChanged` fires exactly once, after the commit.
+    void testWorkerPool_debouncedRescanCommitsOffGuiThread()
+    {
+        QVERIFY(writeJson(m_tmp->filePath(QStringLiteral("a.json")), QStringLiteral("alpha"), QStringLiteral("v1")));
+
+        PoolSink sink;
+        DirectoryLoader loader(sink);
+        loader.setScanMode(DirectoryLoader::ScanMode::WorkerPool);
+        loader.setDebounceIntervalForTest(1);
+        QCOMPARE(loader.loadFromDirectory(m_tmp->path(), LiveReload::Off), 1);
+
+        QVERIFY(writeJson(m_tmp->filePath(QStringLiteral("b.json")), QStringLiteral("beta"), QStringLiteral("v2")));
+        const int offGuiBefore = sink.offGuiParseCalls;
+        const int commitsBefore = sink.commitCount;
+        QSignalSpy spy(&loader, &DirectoryLoader::entriesChanged);
+        loader.requestRescan();
+
+        QVERIFY(spy.wait(4000));
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(sink.commitCount, commitsBefore + 1);
+        QCOMPARE(loader.registeredCount(), 2);
+        QCOMPARE(sink.registry.value(QStringLiteral("beta")), std::string("v2"));
+        QCOMPARE(sink.offGuiParseCalls - offGuiBefore, 2);
+    }
+
+    /// `rescanNow` keeps its synchronous contract in worker-pool mode: a
+    /// debounced scan still running on the pool is discarded (it listed
+    /// the directory before the write below), and only the synchronous
+    /// result is ever committed.
+    void testWorkerPool_rescanNowDiscardsInFlightScan()
+    {
+        QVERIFY(writeJson(m_tmp->filePath(QStringLiteral("a.json")), QStringLiteral("alpha"), QStringLiteral("v1")));
+
+        PoolSink sink;
+        DirectoryLoader loader(sink);
+        loader.setScanMode(DirectoryLoader::ScanMode::WorkerPool);
+        loader.setDebounceIntervalForTest(1);
+        loader.loadFromDirectory(m_tmp->path(), LiveReload::Off);
+
+        // Hold the next scan's parses on the pool.
+        sink.gate.acquire();
+        const int parsesBefore = sink.poolParseCalls;
+        loader.requestRescan();
+        QTRY_VERIFY(sink.poolParseCalls > parsesBefore);
+
+        QVERIFY(writeJson(m_tmp->filePath(QStringLiteral("b.json")), QStringLiteral("beta"), QStringLiteral("v2")));
+        const int commitsBefore = sink.commitCount;
+        QSignalSpy spy(&loader, &DirectoryLoader::entriesChanged);
+        sink.gate.release();
+        loader.rescanNow();
+
+        QCOMPARE(sink.commitCount, commitsBefore + 1);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(loader.registeredCount(), 2);
+
+        // The discarded job's completion must not commit a stale set on top.
+        QTest::qWait(100);
+        QCOMPARE(sink.commitCount, commitsBefore + 1);
+        QCOMPARE(spy.count(), 1);
+    }
+
+    /// Discarding a debounced scan does not wait for reads already running
+    /// on the pool: the mode switch below returns while one is still held
+    /// there (waiting would deadlock on the gate this thread holds), and
+    /// the held job's result is dropped when it finally lands.
+    void testWorkerPool_discardDoesNotWaitForPool()
+    {
+        QVERIFY(writeJson(m_tmp->filePath(QStringLiteral("a.json")), QStringLiteral("alpha"), QStringLiteral("v1")));
+
+        PoolSink sink;
+        DirectoryLoader loader(sink);
+        loader.setScanMode(DirectoryLoader::ScanMode::WorkerPool);
+        loader.setDebounceIntervalForTest(1);
+        loader.loadFromDirectory(m_tmp->path(), LiveReload::Off);
+
+        sink.gate.acquire();
+        const int parsesBefore = sink.poolParseCalls;
+        loader.requestRescan();
+        QTRY_VERIFY(sink.poolParseCalls > parsesBefore);
+
+        QVERIFY(writeJson(m_tmp->filePath(QStringLiteral("b.json")), QStringLiteral("beta"), QStringLiteral("v2")));
+        const int commitsBefore = sink.commitCount;
+        QSignalSpy spy(&loader, &DirectoryLoader::entriesChanged);
+        loader.setScanMode(DirectoryLoader::ScanMode::GuiThread);
+        QCOMPARE(loader.scanMode(), DirectoryLoader::ScanMode::GuiThread);
+        sink.gate.release();
+
+        // The switch owes a rescan in the dropped one's place.
+        QVERIFY(spy.wait(4000));
+        QCOMPARE(loader.registeredCount(), 2);
+        QTest::qWait(100);
+        QCOMPARE(sink.commitCount, commitsBefore + 1);
+        QCOMPARE(spy.count(), 1);
+    }
+
 private:
     std::unique_ptr<QTemporaryDir> m_tmp;
 };
@@ -1030,6 +1030,64 @@ private Q_SLOTS:
         QVERIFY(!strategy.contains(QString()));
     }
 
+    /// A rescan reparses only the packs that changed. An untouched pack is
+    /// served from the manifest, a touched-but-identical metadata.json is
+    /// caught by the content hash, and a file appearing in a pack dir counts
+    /// as a change because parsers probe for optional files.
+    /// `invalidateManifest` forces the full reparse back.
+    ///
+    /// The fixtures are left to age past `kRacyStampWindowMs` first: a
+    /// stamp taken right after a write is not trusted, and the first scan
+    /// would otherwise remember every pack as needing a reparse.
+    void testIncrementalRescan_reparsesOnlyChangedPacks()
+    {
+        const QString dir = m_tmp->filePath(QStringLiteral("d"));
+        const QString pkgA = dir + QStringLiteral("/pkg-a");
+        const QString pkgB = dir + QStringLiteral("/pkg-b");
+        QVERIFY(writeMetadata(pkgA, QStringLiteral("pkg-a"), 1));
+        QVERIFY(writeMetadata(pkgB, QStringLiteral("pkg-b"), 2));
+        QTest::qWait(int(DirectoryLoader::kRacyStampWindowMs) + 100);
+
+        int parses = 0;
+        MetadataPackScanStrategy<FakePayload> strategy(
+            [&parses, parser = makeDefaultParser()](const QString& subdirPath, const QJsonObject& root, bool isUser) {
+                ++parses;
+                return parser(subdirPath, root, isUser);
+            },
+            [] { });
+        WatchedDirectorySet set(strategy);
+        set.registerDirectory(dir, LiveReload::Off);
+        QCOMPARE(parses, 2);
+
+        set.rescanNow();
+        QCOMPARE(parses, 2);
+        QCOMPARE(strategy.size(), 2);
+
+        // Same bytes, new mtime.
+        QFile metadata(pkgA + QStringLiteral("/metadata.json"));
+        QVERIFY(metadata.open(QIODevice::ReadOnly));
+        const QByteArray bytes = metadata.readAll();
+        metadata.close();
+        QVERIFY(writeFile(metadata.fileName(), bytes));
+        set.rescanNow();
+        QCOMPARE(parses, 2);
+
+        QVERIFY(writeMetadata(pkgB, QStringLiteral("pkg-b"), 20));
+        set.rescanNow();
+        QCOMPARE(parses, 3);
+        QCOMPARE(strategy.pack(QStringLiteral("pkg-b")).score, 20);
+        QCOMPARE(strategy.pack(QStringLiteral("pkg-a")).score, 1);
+
+        QVERIFY(writeFile(pkgA + QStringLiteral("/zone.vert"), QByteArrayLiteral("// vert\n")));
+        set.rescanNow();
+        QCOMPARE(parses, 4);
+
+        strategy.invalidateManifest();
+        set.rescanNow();
+        QCOMPARE(parses, 6);
+        QCOMPARE(strategy.size(), 2);
+    }
+
 private:
     std::unique_ptr<QTemporaryDir> m_tmp;
 };
@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+#include <phosphorgeometry_export.h>
+
+#include <QList>
+
+#include <memory>
+
+namespace PhosphorGeometry {
+
+/// Constraint strengths, compared as plain doubles. Anything below Required
+/// may be violated when the system cannot satisfy it; the solver then
+/// minimises the strength-weighted error. The three named tiers are far
+/// enough apart that no amount of Weak error outweighs one unit of Medium.
+namespace ConstraintStrength {
+inline constexpr double Weak = 1.0;
+inline constexpr double Medium = 1.0e3;
+inline constexpr double Strong = 1.0e6;
+inline constexpr double Required = 1.0e9 + 1.0e6 + 1.0e3;
+} // namespace ConstraintStrength
+
+/**
+ * @brief Incremental linear-arithmetic constraint solver (Cassowary).
+ *
+ * Keeps a simplex tableau over the added constraints, so adding or removing
+ * one constraint, or moving an edit variable with suggestValue(), re-solves
+ * from the current basis instead of from scratch. This is what makes a
+ * divider drag cheap: the layout's constraints stay in place and only the
+ * dragged edge's suggested value changes between frames.
+ *
+ * Each constraint reads `sum(coefficient * variable) + constant <relation> 0`.
+ * Required constraints must hold exactly; weaker ones are met as closely as
+ * their strength allows.
+ *
+ * Not thread-safe; one solver per thread.
+ */
+class PHOSPHORGEOMETRY_EXPORT ConstraintSolver
+{
+public:
+    using Variable = int;
+    using ConstraintId = int;
+
+    struct Term
+    {
+        Variable variable = -1;
+        double coefficient = 1.0;
+    };
+
+    enum class Relation {
+        LessOrEqual,
+        Equal,
+        GreaterOrEqual
+    };
+
+    ConstraintSolver();
+    ~ConstraintSolver();
+
+    ConstraintSolver(ConstraintSolver&&) noexcept;
+    ConstraintSolver& operator=(ConstraintSolver&&) noexcept;
+    ConstraintSolver(const ConstraintSolver&) = delete;
+    ConstraintSolver& operator=(const ConstraintSolver&) = delete;
+
+    /// A new unconstrained variable, initially 0.
+    Variable addVariable();
+
+    /// Add `terms + constant <relation> 0` at @p strength. Returns the id to
+    /// remove it with, or -1 when a required constraint conflicts with the
+    /// required constraints already present, in which case it is not added.
+    ConstraintId addConstraint(const QList<Term>& terms, double constant, Relation relation,
+                               double strength = ConstraintStrength::Required);
+
+    /// Returns false for an unknown id.
+    bool removeConstraint(ConstraintId id);
+
+    /// Make @p variable suggestable at @p strength (which must be below
+    /// Required). Returns false if it already is one.
+    bool addEditVariable(Variable variable, double strength = ConstraintStrength::Strong);
+    bool removeEditVariable(Variable variable);
+    bool hasEditVariable(Variable variable) const;
+
+    /// Pull @p variable toward @p value and re-solve incrementally. Returns
+    /// false if @p variable is not an edit variable.
+    bool suggestValue(Variable variable, double value);
+
+    /// Current solved value of @p variable.
+    double value(Variable variable) const;
+
+    /// Drop every variable, constraint and edit variable.
+    void reset();
+
+private:
+    struct Private;
+    std::unique_ptr<Private> d;
+};
+
+} // namespace PhosphorGeometry
@@ -5,6 +5,7 @@
 
 #include <phosphorgeometry_export.h>
 
+#include <QPair>
 #include <QRect>
 #include <QRectF>
 #include <QSize>
@@ -24,6 +25,12 @@ PHOSPHORGEOMETRY_EXPORT QRect snapToRect(const QRectF& rf);
 // Grows zones to accommodate per-window minimum sizes by stealing surplus
 // from adjacent neighbors, then resolves any residual overlap.
 //
+// Column layouts (every zone exactly one column wide along the axis) are
+// solved directly. Any other arrangement is handed to a linear constraint
+// solver over the shared edges, which keeps its tableau between calls on the
+// same thread, so re-applying one arrangement with moved dividers is
+// incremental rather than a fresh solve.
+//
 // Vector tolerance (matches clampZonesToScreen): if minSizes is shorter than
 // zones, missing entries are treated as no minimum (zero size). Extra entries
 // past zones.size() are ignored. Empty minSizes is a no-op (nothing to enforce);
@@ -56,6 +63,13 @@ PHOSPHORGEOMETRY_EXPORT void enforceMinSizes(QVector<QRect>& zones, const QVecto
 PHOSPHORGEOMETRY_EXPORT void clampZonesToScreen(QVector<QRect>& zones, const QVector<QSize>& minSizes,
                                                 const QRect& screen);
 
+// Every pair (i, j), i < j, of zones whose interiors intersect, sorted. A
+// sweep over the zones' left/right edges with an interval tree of the zones
+// crossing the sweep line: O((n + k) log n) for k pairs instead of testing
+// all n² of them. Empty rects overlap nothing; rects that only touch do not
+// overlap.
+PHOSPHORGEOMETRY_EXPORT QVector<QPair<int, int>> findRectOverlaps(const QVector<QRect>& zones);
+
 PHOSPHORGEOMETRY_EXPORT void removeRectOverlaps(QVector<QRect>& zones, const QVector<QSize>& minSizes = {},
                                                 int innerGap = 0);
 
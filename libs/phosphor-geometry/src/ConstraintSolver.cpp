@@ -0,0 +1,631 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <PhosphorGeometry/ConstraintSolver.h>
+
+#include <QtGlobal>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+// Cassowary as described by Badros, Borning and Stuckey ("The Cassowary
+// Linear Arithmetic Constraint Solving Algorithm", TOCHI 2001), laid out the
+// way the kiwi implementation does it: every constraint becomes one tableau
+// row with its own marker symbol, non-required constraints contribute
+// strength-weighted error symbols to the objective, and edit variables are
+// ordinary non-required equalities whose constant suggestValue() moves before
+// a dual-simplex pass restores feasibility.
+
+namespace PhosphorGeometry {
+
+namespace {
+
+constexpr double kEpsilon = 1.0e-8;
+
+bool nearZero(double value)
+{
+    return std::abs(value) < kEpsilon;
+}
+
+enum class SymbolType : quint8 {
+    Invalid,
+    External, ///< a user variable
+    Slack, ///< inequality slack, also used for artificial variables
+    Error, ///< error of a non-required constraint
+    Dummy ///< marker of a required equality; never pivoted on
+};
+
+struct Symbol
+{
+    quint64 id = 0;
+    SymbolType type = SymbolType::Invalid;
+
+    bool isValid() const
+    {
+        return type != SymbolType::Invalid;
+    }
+    bool isPivotable() const
+    {
+        return type == SymbolType::Slack || type == SymbolType::Error;
+    }
+    friend bool operator<(const Symbol& a, const Symbol& b)
+    {
+        return a.id < b.id;
+    }
+    friend bool operator==(const Symbol& a, const Symbol& b)
+    {
+        return a.id == b.id;
+    }
+};
+
+// One tableau row, read as `basic = constant + sum(coefficient * symbol)`.
+// Ordered by symbol id so pivot choices, and with them the solution picked
+// among equally good ones, are deterministic.
+class Row
+{
+public:
+    explicit Row(double constant = 0.0)
+        : m_constant(constant)
+    {
+    }
+
+    double constant() const
+    {
+        return m_constant;
+    }
+    const std::map<Symbol, double>& cells() const
+    {
+        return m_cells;
+    }
+
+    double add(double value)
+    {
+        return m_constant += value;
+    }
+
+    void insert(const Symbol& symbol, double coefficient = 1.0)
+    {
+        if (nearZero(m_cells[symbol] += coefficient)) {
+            m_cells.erase(symbol);
+        }
+    }
+
+    void insert(const Row& other, double coefficient = 1.0)
+    {
+        m_constant += other.m_constant * coefficient;
+        for (const auto& [symbol, value] : other.m_cells) {
+            insert(symbol, value * coefficient);
+        }
+    }
+
+    void remove(const Symbol& symbol)
+    {
+        m_cells.erase(symbol);
+    }
+
+    void reverseSign()
+    {
+        m_constant = -m_constant;
+        for (auto& cell : m_cells) {
+            cell.second = -cell.second;
+        }
+    }
+
+    // Rewrite `0 = this` as `symbol = ...`.
+    void solveFor(const Symbol& symbol)
+    {
+        const double coefficient = -1.0 / m_cells[symbol];
+        m_cells.erase(symbol);
+        m_constant *= coefficient;
+        for (auto& cell : m_cells) {
+            cell.second *= coefficient;
+        }
+    }
+
+    // Rewrite `lhs = this` as `rhs = ...`.
+    void solveFor(const Symbol& lhs, const Symbol& rhs)
+    {
+        insert(lhs, -1.0);
+        solveFor(rhs);
+    }
+
+    double coefficientFor(const Symbol& symbol) const
+    {
+        const auto it = m_cells.find(symbol);
+        return it == m_cells.end() ? 0.0 : it->second;
+    }
+
+    void substitute(const Symbol& symbol, const Row& row)
+    {
+        const auto it = m_cells.find(symbol);
+        if (it != m_cells.end()) {
+            const double coefficient = it->second;
+            m_cells.erase(it);
+            insert(row, coefficient);
+        }
+    }
+
+private:
+    std::map<Symbol, double> m_cells;
+    double m_constant;
+};
+
+// The symbols a constraint added to the tableau: `marker` identifies its row,
+// `other` is the second error symbol of a non-required equality or the error
+// symbol of a non-required inequality.
+struct Tag
+{
+    Symbol marker;
+    Symbol other;
+};
+
+struct ConstraintData
+{
+    QList<ConstraintSolver::Term> terms;
+    double constant = 0.0;
+    ConstraintSolver::Relation relation = ConstraintSolver::Relation::Equal;
+    double strength = ConstraintStrength::Required;
+    Tag tag;
+};
+
+struct EditInfo
+{
+    ConstraintSolver::ConstraintId constraint = -1;
+    Tag tag;
+    double constant = 0.0;
+};
+
+} // namespace
+
+struct ConstraintSolver::Private
+{
+    using RowMap = std::map<Symbol, Row>;
+
+    quint64 nextSymbolId = 1;
+    ConstraintId nextConstraintId = 0;
+    std::vector<Symbol> variables;
+    RowMap rows;
+    std::unordered_map<ConstraintId, ConstraintData> constraints;
+    std::unordered_map<Variable, EditInfo> edits;
+    std::vector<Symbol> infeasibleRows;
+    Row objective;
+    std::unique_ptr<Row> artificial;
+
+    Symbol newSymbol(SymbolType type)
+    {
+        return Symbol{nextSymbolId++, type};
+    }
+
+    Row createRow(const ConstraintData& data, Tag& tag)
+    {
+        Row row(data.constant);
+        for (const Term& term : data.terms) {
+            if (nearZero(term.coefficient)) {
+                continue;
+            }
+            const Symbol symbol = variables[term.variable];
+            const auto basic = rows.find(symbol);
+            if (basic != rows.end()) {
+                row.insert(basic->second, term.coefficient);
+            } else {
+                row.insert(symbol, term.coefficient);
+            }
+        }
+
+        const bool required = data.strength >= ConstraintStrength::Required;
+        if (data.relation == Relation::Equal) {
+            if (required) {
+                tag.marker = newSymbol(SymbolType::Dummy);
+                row.insert(tag.marker);
+            } else {
+                tag.marker = newSymbol(SymbolType::Error);
+                tag.other = newSymbol(SymbolType::Error);
+                row.insert(tag.marker, -1.0);
+                row.insert(tag.other, 1.0);
+                objective.insert(tag.marker, data.strength);
+                objective.insert(tag.other, data.strength);
+            }
+        } else {
+            const double sign = data.relation == Relation::LessOrEqual ? 1.0 : -1.0;
+            tag.marker = newSymbol(SymbolType::Slack);
+            row.insert(tag.marker, sign);
+            if (!required) {
+                tag.other = newSymbol(SymbolType::Error);
+                row.insert(tag.other, -sign);
+                objective.insert(tag.other, data.strength);
+            }
+        }
+
+        if (row.constant() < 0.0) {
+            row.reverseSign();
+        }
+        return row;
+    }
+
+    static Symbol chooseSubject(const Row& row, const Tag& tag)
+    {
+        for (const auto& cell : row.cells()) {
+            if (cell.first.type == SymbolType::External) {
+                return cell.first;
+            }
+        }
+        if (tag.marker.isPivotable() && row.coefficientFor(tag.marker) < 0.0) {
+            return tag.marker;
+        }
+        if (tag.other.isPivotable() && row.coefficientFor(tag.other) < 0.0) {
+            return tag.other;
+        }
+        return {};
+    }
+
+    static bool allDummies(const Row& row)
+    {
+        for (const auto& cell : row.cells()) {
+            if (cell.first.type != SymbolType::Dummy) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static Symbol anyPivotableSymbol(const Row& row)
+    {
+        for (const auto& cell : row.cells()) {
+            if (cell.first.isPivotable()) {
+                return cell.first;
+            }
+        }
+        return {};
+    }
+
+    void substitute(const Symbol& symbol, const Row& row)
+    {
+        for (auto& [basic, basicRow] : rows) {
+            basicRow.substitute(symbol, row);
+            if (basic.type != SymbolType::External && basicRow.constant() < 0.0) {
+                infeasibleRows.push_back(basic);
+            }
+        }
+        objective.substitute(symbol, row);
+        if (artificial) {
+            artificial->substitute(symbol, row);
+        }
+    }
+
+    void pivot(RowMap::iterator leavingRow, const Symbol& entering)
+    {
+        const Symbol leaving = leavingRow->first;
+        Row row = std::move(leavingRow->second);
+        rows.erase(leavingRow);
+        row.solveFor(leaving, entering);
+        substitute(entering, row);
+        rows.insert_or_assign(entering, std::move(row));
+    }
+
+    // Primal simplex on `target` (the objective, or the artificial row while
+    // adding a constraint that has no natural subject). Returns false if the
+    // objective is unbounded, which well-formed input never produces.
+    bool optimize(const Row& target)
+    {
+        for (;;) {
+            Symbol entering;
+            for (const auto& cell : target.cells()) {
+                if (cell.first.type != SymbolType::Dummy && cell.second < 0.0) {
+                    entering = cell.first;
+                    break;
+                }
+            }
+            if (!entering.isValid()) {
+                return true;
+            }
+
+            auto leaving = rows.end();
+            double ratio = std::numeric_limits<double>::max();
+            for (auto it = rows.begin(); it != rows.end(); ++it) {
+                if (it->first.type == SymbolType::External) {
+                    continue;
+                }
+                const double coefficient = it->second.coefficientFor(entering);
+                if (coefficient < 0.0) {
+                    const double candidate = -it->second.constant() / coefficient;
+                    if (candidate < ratio) {
+                        ratio = candidate;
+                        leaving = it;
+                    }
+                }
+            }
+            if (leaving == rows.end()) {
+                return false;
+            }
+            pivot(leaving, entering);
+        }
+    }
+
+    // Dual simplex over the rows an edit or removal left negative.
+    bool dualOptimize()
+    {
+        while (!infeasibleRows.empty()) {
+            const Symbol leaving = infeasibleRows.back();
+            infeasibleRows.pop_back();
+            const auto it = rows.find(leaving);
+            if (it == rows.end() || nearZero(it->second.constant()) || it->second.constant() >= 0.0) {
+                continue;
+            }
+            Symbol entering;
+            double ratio = std::numeric_limits<double>::max();
+            for (const auto& [symbol, coefficient] : it->second.cells()) {
+                if (symbol.type != SymbolType::Dummy && coefficient > 0.0) {
+                    const double candidate = objective.coefficientFor(symbol) / coefficient;
+                    if (candidate < ratio) {
+                        ratio = candidate;
+                        entering = symbol;
+                    }
+                }
+            }
+            if (!entering.isValid()) {
+                infeasibleRows.clear();
+                return false;
+            }
+            pivot(it, entering);
+        }
+        return true;
+    }
+
+    bool addWithArtificialVariable(const Row& row)
+    {
+        const Symbol art = newSymbol(SymbolType::Slack);
+        rows.insert_or_assign(art, row);
+        artificial = std::make_unique<Row>(row);
+        optimize(*artificial);
+        const bool success = nearZero(artificial->constant());
+        artificial.reset();
+
+        const auto it = rows.find(art);
+        if (it != rows.end()) {
+            Row basic = std::move(it->second);
+            rows.erase(it);
+            if (basic.cells().empty()) {
+                return success;
+            }
+            const Symbol entering = anyPivotableSymbol(basic);
+            if (!entering.isValid()) {
+                return false;
+            }
+            basic.solveFor(art, entering);
+            substitute(entering, basic);
+            rows.insert_or_assign(entering, std::move(basic));
+        }
+        for (auto& entry : rows) {
+            entry.second.remove(art);
+        }
+        objective.remove(art);
+        return success;
+    }
+
+    // The row to pivot @p marker into when it is not basic: prefer the
+    // restricted row that stays feasible, then any restricted row, then an
+    // external one.
+    RowMap::iterator markerLeavingRow(const Symbol& marker)
+    {
+        const double dmax = std::numeric_limits<double>::max();
+        double r1 = dmax;
+        double r2 = dmax;
+        auto first = rows.end();
+        auto second = rows.end();
+        auto third = rows.end();
+        for (auto it = rows.begin(); it != rows.end(); ++it) {
+            const double coefficient = it->second.coefficientFor(marker);
+            if (coefficient == 0.0) {
+                continue;
+            }
+            if (it->first.type == SymbolType::External) {
+                third = it;
+            } else if (coefficient < 0.0) {
+                const double r = -it->second.constant() / coefficient;
+                if (r < r1) {
+                    r1 = r;
+                    first = it;
+                }
+            } else {
+                const double r = it->second.constant() / coefficient;
+                if (r < r2) {
+                    r2 = r;
+                    second = it;
+                }
+            }
+        }
+        if (first != rows.end()) {
+            return first;
+        }
+        if (second != rows.end()) {
+            return second;
+        }
+        return third;
+    }
+
+    void removeMarkerEffects(const Symbol& marker, double strength)
+    {
+        const auto it = rows.find(marker);
+        if (it != rows.end()) {
+            objective.insert(it->second, -strength);
+        } else {
+            objective.insert(marker, -strength);
+        }
+    }
+
+    void removeFromTableau(const ConstraintData& data)
+    {
+        if (data.tag.marker.type == SymbolType::Error) {
+            removeMarkerEffects(data.tag.marker, data.strength);
+        }
+        if (data.tag.other.type == SymbolType::Error) {
+            removeMarkerEffects(data.tag.other, data.strength);
+        }
+
+        const auto basic = rows.find(data.tag.marker);
+        if (basic != rows.end()) {
+            rows.erase(basic);
+        } else {
+            // A marker that is in no row at all belongs to a constraint whose
+            // artificial add failed and was dropped; nothing to pivot out.
+            const auto leaving = markerLeavingRow(data.tag.marker);
+            if (leaving != rows.end()) {
+                const Symbol leavingSymbol = leaving->first;
+                Row row = std::move(leaving->second);
+                rows.erase(leaving);
+                row.solveFor(leavingSymbol, data.tag.marker);
+                substitute(data.tag.marker, row);
+            }
+        }
+        optimize(objective);
+    }
+};
+
+ConstraintSolver::ConstraintSolver()
+    : d(std::make_unique<Private>())
+{
+}
+
+ConstraintSolver::~ConstraintSolver() = default;
+ConstraintSolver::ConstraintSolver(ConstraintSolver&&) noexcept = default;
+ConstraintSolver& ConstraintSolver::operator=(ConstraintSolver&&) noexcept = default;
+
+ConstraintSolver::Variable ConstraintSolver::addVariable()
+{
+    d->variables.push_back(d->newSymbol(SymbolType::External));
+    return Variable(d->variables.size() - 1);
+}
+
+ConstraintSolver::ConstraintId ConstraintSolver::addConstraint(const QList<Term>& terms, double constant,
+                                                               Relation relation, double strength)
+{
+    for (const Term& term : terms) {
+        if (term.variable < 0 || term.variable >= Variable(d->variables.size())) {
+            return -1;
+        }
+    }
+
+    ConstraintData data{terms, constant, relation, std::min(strength, ConstraintStrength::Required), {}};
+    Row row = d->createRow(data, data.tag);
+    Symbol subject = Private::chooseSubject(row, data.tag);
+    if (!subject.isValid() && Private::allDummies(row)) {
+        // A required equality over variables that are already pinned: it
+        // either restates what holds or contradicts it.
+        if (!nearZero(row.constant())) {
+            return -1;
+        }
+        subject = data.tag.marker;
+    }
+
+    const ConstraintId id = d->nextConstraintId++;
+    d->constraints.emplace(id, data);
+    if (!subject.isValid()) {
+        if (!d->addWithArtificialVariable(row)) {
+            removeConstraint(id);
+            return -1;
+        }
+    } else {
+        row.solveFor(subject);
+        d->substitute(subject, row);
+        d->rows.insert_or_assign(subject, std::move(row));
+    }
+    d->optimize(d->objective);
+    return id;
+}
+
+bool ConstraintSolver::removeConstraint(ConstraintId id)
+{
+    const auto it = d->constraints.find(id);
+    if (it == d->constraints.end()) {
+        return false;
+    }
+    const ConstraintData data = std::move(it->second);
+    d->constraints.erase(it);
+    d->removeFromTableau(data);
+    return true;
+}
+
+bool ConstraintSolver::addEditVariable(Variable variable, double strength)
+{
+    if (strength >= ConstraintStrength::Required || d->edits.contains(variable)) {
+        return false;
+    }
+    const ConstraintId id = addConstraint({{variable, 1.0}}, 0.0, Relation::Equal, strength);
+    if (id < 0) {
+        return false;
+    }
+    d->edits.emplace(variable, EditInfo{id, d->constraints.at(id).tag, 0.0});
+    return true;
+}
+
+bool ConstraintSolver::removeEditVariable(Variable variable)
+{
+    const auto it = d->edits.find(variable);
+    if (it == d->edits.end()) {
+        return false;
+    }
+    const ConstraintId id = it->second.constraint;
+    d->edits.erase(it);
+    return removeConstraint(id);
+}
+
+bool ConstraintSolver::hasEditVariable(Variable variable) const
+{
+    return d->edits.contains(variable);
+}
+
+bool ConstraintSolver::suggestValue(Variable variable, double value)
+{
+    const auto it = d->edits.find(variable);
+    if (it == d->edits.end()) {
+        return false;
+    }
+    EditInfo& info = it->second;
+    const double delta = value - info.constant;
+    info.constant = value;
+
+    // The edit row reads `variable = errorPlus - errorMinus`; moving its
+    // constant touches whichever error symbol is basic, or every row the
+    // positive one appears in.
+    const auto plus = d->rows.find(info.tag.marker);
+    if (plus != d->rows.end()) {
+        if (plus->second.add(-delta) < 0.0) {
+            d->infeasibleRows.push_back(plus->first);
+        }
+        return d->dualOptimize();
+    }
+    const auto minus = d->rows.find(info.tag.other);
+    if (minus != d->rows.end()) {
+        if (minus->second.add(delta) < 0.0) {
+            d->infeasibleRows.push_back(minus->first);
+        }
+        return d->dualOptimize();
+    }
+    for (auto& [basic, row] : d->rows) {
+        const double coefficient = row.coefficientFor(info.tag.marker);
+        if (coefficient != 0.0 && row.add(delta * coefficient) < 0.0 && basic.type != SymbolType::External) {
+            d->infeasibleRows.push_back(basic);
+        }
+    }
+    return d->dualOptimize();
+}
+
+double ConstraintSolver::value(Variable variable) const
+{
+    if (variable < 0 || variable >= Variable(d->variables.size())) {
+        return 0.0;
+    }
+    const auto it = d->rows.find(d->variables[variable]);
+    return it == d->rows.end() ? 0.0 : it->second.constant();
+}
+
+void ConstraintSolver::reset()
+{
+    *d = Private();
+}
+
+} // namespace PhosphorGeometry
@@ -4,12 +4,15 @@
 #include <PhosphorGeometry/GeometryUtils.h>
 #include <PhosphorGeometry/JsonKeys.h>
 
+#include "MinSizeSolver.h"
+
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace PhosphorGeometry {
 
@@ -40,17 +43,18 @@ static bool solveAxisBoundaries(QVector<QRect>& zones, const QVector<int>& minDi
     }
 
     QVector<int> boundaries;
+    boundaries.reserve(2 * n);
     for (int i = 0; i < n; ++i) {
         int lo = horizontal ? zones[i].left() : zones[i].top();
         int hi = horizontal ? (zones[i].left() + zones[i].width()) : (zones[i].top() + zones[i].height());
-        if (!boundaries.contains(lo)) {
-            boundaries.append(lo);
-        }
-        if (!boundaries.contains(hi)) {
-            boundaries.append(hi);
-        }
+        boundaries.append(lo);
+        boundaries.append(hi);
     }
     std::sort(boundaries.begin(), boundaries.end());
+    boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+    const auto boundaryIndex = [&boundaries](int coord) {
+        return int(std::lower_bound(boundaries.begin(), boundaries.end(), coord) - boundaries.begin());
+    };
 
     const int numBoundaries = boundaries.size();
     if (numBoundaries < 2) {
@@ -64,9 +68,9 @@ static bool solveAxisBoundaries(QVector<QRect>& zones, const QVector<int>& minDi
     for (int i = 0; i < n; ++i) {
         int lo = horizontal ? zones[i].left() : zones[i].top();
         int hi = horizontal ? (zones[i].left() + zones[i].width()) : (zones[i].top() + zones[i].height());
-        int colStart = boundaries.indexOf(lo);
-        int colEnd = boundaries.indexOf(hi);
-        if (colStart < 0 || colEnd < 0 || colEnd != colStart + 1) {
+        int colStart = boundaryIndex(lo);
+        int colEnd = boundaryIndex(hi);
+        if (colEnd != colStart + 1) {
             return false;
         }
         zoneColumn[i] = colStart;
@@ -419,9 +423,19 @@ void enforceMinSizes(QVector<QRect>& zones, const QVector<QSize>& minSizes, int
         return;
     }
 
+    // The grid solver is exact and cheap when every zone occupies a single
+    // column; anything else (a zone spanning columns, rows whose dividers do
+    // not line up) goes to the general solver, whose tableau is kept per
+    // thread so repeated applies of one arrangement, like a divider drag,
+    // re-solve incrementally. pairwiseFallback stays as the last resort.
+    thread_local detail::MinSizeAxisSolver widthSolver;
+    thread_local detail::MinSizeAxisSolver heightSolver;
+
     bool widthSolved = solveAxisBoundaries(zones, minWidths, true, gapThreshold);
     if (!widthSolved) {
-        pairwiseFallback(zones, minWidths, gapThreshold, true);
+        if (!widthSolver.solve(zones, minWidths, true, gapThreshold)) {
+            pairwiseFallback(zones, minWidths, gapThreshold, true);
+        }
     } else {
         bool widthDeficit = false;
         for (int i = 0; i < n; ++i) {
@@ -437,7 +451,9 @@ void enforceMinSizes(QVector<QRect>& zones, const QVector<QSize>& minSizes, int
 
     bool heightSolved = solveAxisBoundaries(zones, minHeights, false, gapThreshold);
     if (!heightSolved) {
-        pairwiseFallback(zones, minHeights, gapThreshold, false);
+        if (!heightSolver.solve(zones, minHeights, false, gapThreshold)) {
+            pairwiseFallback(zones, minHeights, gapThreshold, false);
+        }
     } else {
         bool heightDeficit = false;
         for (int i = 0; i < n; ++i) {
@@ -454,6 +470,133 @@ void enforceMinSizes(QVector<QRect>& zones, const QVector<QSize>& minSizes, int
     removeRectOverlaps(zones, minSizes, innerGap);
 }
 
+// ═══════════════════════════════════════════════════════════════════════════════
+// Sweep-line overlap detection
+// ═══════════════════════════════════════════════════════════════════════════════
+
+namespace {
+
+// The zones currently crossing the sweep line, indexed by their rank in
+// top-edge order. Each node holds the largest (exclusive) bottom among the
+// active zones beneath it, so a query only descends into subtrees that can
+// contain a hit and costs O((k + 1) log n) for k hits.
+class ActiveIntervalTree
+{
+public:
+    static constexpr int Inactive = std::numeric_limits<int>::min();
+
+    explicit ActiveIntervalTree(int count)
+    {
+        while (m_leaves < count) {
+            m_leaves *= 2;
+        }
+        m_maxBottom.fill(Inactive, 2 * m_leaves);
+    }
+
+    void set(int rank, int bottom)
+    {
+        int node = rank + m_leaves;
+        m_maxBottom[node] = bottom;
+        for (node /= 2; node > 0; node /= 2) {
+            m_maxBottom[node] = std::max(m_maxBottom[2 * node], m_maxBottom[2 * node + 1]);
+        }
+    }
+
+    // Calls report(rank) for every active rank below rankLimit whose bottom
+    // lies past top.
+    template<typename Report>
+    void query(int rankLimit, int top, Report&& report) const
+    {
+        visit(1, 0, m_leaves, rankLimit, top, report);
+    }
+
+private:
+    template<typename Report>
+    void visit(int node, int lo, int hi, int rankLimit, int top, Report& report) const
+    {
+        if (lo >= rankLimit || m_maxBottom[node] <= top) {
+            return;
+        }
+        if (hi - lo == 1) {
+            report(lo);
+            return;
+        }
+        const int mid = (lo + hi) / 2;
+        visit(2 * node, lo, mid, rankLimit, top, report);
+        visit(2 * node + 1, mid, hi, rankLimit, top, report);
+    }
+
+    int m_leaves = 1;
+    QVector<int> m_maxBottom;
+};
+
+} // namespace
+
+QVector<QPair<int, int>> findRectOverlaps(const QVector<QRect>& zones)
+{
+    QVector<int> byTop;
+    byTop.reserve(zones.size());
+    for (int i = 0; i < zones.size(); ++i) {
+        if (!zones[i].isEmpty()) {
+            byTop.append(i);
+        }
+    }
+    std::sort(byTop.begin(), byTop.end(), [&zones](int a, int b) {
+        return zones[a].top() != zones[b].top() ? zones[a].top() < zones[b].top() : a < b;
+    });
+    QVector<int> rankOf(zones.size(), -1);
+    QVector<int> sortedTops(byTop.size());
+    for (int rank = 0; rank < byTop.size(); ++rank) {
+        rankOf[byTop[rank]] = rank;
+        sortedTops[rank] = zones[byTop[rank]].top();
+    }
+
+    // Left edges open a zone, right edges close it. At equal x closing comes
+    // first: zones that only touch do not overlap.
+    struct Event
+    {
+        int x;
+        bool opens;
+        int index;
+    };
+    QVector<Event> events;
+    events.reserve(2 * byTop.size());
+    for (int i : byTop) {
+        events.append({zones[i].left(), true, i});
+        events.append({zones[i].left() + zones[i].width(), false, i});
+    }
+    std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+        if (a.x != b.x) {
+            return a.x < b.x;
+        }
+        if (a.opens != b.opens) {
+            return !a.opens;
+        }
+        return a.index < b.index;
+    });
+
+    QVector<QPair<int, int>> pairs;
+    ActiveIntervalTree active(byTop.size());
+    for (const Event& event : events) {
+        const QRect& zone = zones[event.index];
+        if (!event.opens) {
+            active.set(rankOf[event.index], ActiveIntervalTree::Inactive);
+            continue;
+        }
+        const int top = zone.top();
+        const int bottom = zone.top() + zone.height();
+        // Active zones that start above this one's bottom and end below its top.
+        const int rankLimit = int(std::lower_bound(sortedTops.begin(), sortedTops.end(), bottom) - sortedTops.begin());
+        active.query(rankLimit, top, [&](int rank) {
+            const int other = byTop[rank];
+            pairs.append(qMakePair(std::min(event.index, other), std::max(event.index, other)));
+        });
+        active.set(rankOf[event.index], bottom);
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════════
 // Min-size-aware overlap removal (multi-pass convergence)
 // ═══════════════════════════════════════════════════════════════════════════════
@@ -471,145 +614,145 @@ void removeRectOverlaps(QVector<QRect>& zones, const QVector<QSize>& minSizes, i
     for (int pass = 0; pass < maxPasses; ++pass) {
         bool changed = false;
 
-        for (int i = 0; i < n; ++i) {
-            for (int j = i + 1; j < n; ++j) {
-                if (zones[i].bottom() < zones[j].top() || zones[j].bottom() < zones[i].top()) {
-                    continue;
-                }
-                int iRight = zones[i].left() + zones[i].width();
-                int jRight = zones[j].left() + zones[j].width();
-                int overlapLeft = qMax(zones[i].left(), zones[j].left());
-                int overlapRight = qMin(iRight, jRight);
-                if (overlapLeft >= overlapRight) {
-                    continue;
-                }
+        // Only pairs the sweep found overlapping can need a fix. Each is
+        // re-checked against the current geometry, since resolving one pair
+        // moves edges the next may share; overlap a fix creates is picked up
+        // by the next pass.
+        for (const auto& [i, j] : findRectOverlaps(zones)) {
+            if (zones[i].bottom() < zones[j].top() || zones[j].bottom() < zones[i].top()) {
+                continue;
+            }
+            int iRight = zones[i].left() + zones[i].width();
+            int jRight = zones[j].left() + zones[j].width();
+            int overlapLeft = qMax(zones[i].left(), zones[j].left());
+            int overlapRight = qMin(iRight, jRight);
+            if (overlapLeft >= overlapRight) {
+                continue;
+            }
 
-                int leftIdx = (zones[i].left() <= zones[j].left()) ? i : j;
-                int rightIdx = (leftIdx == i) ? j : i;
+            int leftIdx = (zones[i].left() <= zones[j].left()) ? i : j;
+            int rightIdx = (leftIdx == i) ? j : i;
 
-                int leftMinW = GeometryDefaults::MinRectSizePx;
-                int rightMinW = GeometryDefaults::MinRectSizePx;
-                if (hasMinSizes) {
-                    if (minSizes[leftIdx].width() > 0) {
-                        leftMinW = qMax(leftMinW, minSizes[leftIdx].width());
-                    }
-                    if (minSizes[rightIdx].width() > 0) {
-                        rightMinW = qMax(rightMinW, minSizes[rightIdx].width());
-                    }
+            int leftMinW = GeometryDefaults::MinRectSizePx;
+            int rightMinW = GeometryDefaults::MinRectSizePx;
+            if (hasMinSizes) {
+                if (minSizes[leftIdx].width() > 0) {
+                    leftMinW = qMax(leftMinW, minSizes[leftIdx].width());
+                }
+                if (minSizes[rightIdx].width() > 0) {
+                    rightMinW = qMax(rightMinW, minSizes[rightIdx].width());
                 }
+            }
 
-                int leftSurplus = qMax(0, zones[leftIdx].width() - leftMinW);
-                int rightSurplus = qMax(0, zones[rightIdx].width() - rightMinW);
+            int leftSurplus = qMax(0, zones[leftIdx].width() - leftMinW);
+            int rightSurplus = qMax(0, zones[rightIdx].width() - rightMinW);
 
-                int boundary;
-                int overlapAmount = overlapRight - overlapLeft;
+            int boundary;
+            int overlapAmount = overlapRight - overlapLeft;
 
-                if (leftSurplus + rightSurplus <= 0) {
-                    boundary = (overlapLeft + overlapRight) / 2;
-                } else {
-                    int leftShare = static_cast<int>(static_cast<qint64>(overlapAmount) * rightSurplus
-                                                     / (leftSurplus + rightSurplus));
-                    boundary = overlapLeft + leftShare;
-                }
+            if (leftSurplus + rightSurplus <= 0) {
+                boundary = (overlapLeft + overlapRight) / 2;
+            } else {
+                int leftShare = static_cast<int>(static_cast<qint64>(overlapAmount) * rightSurplus
+                                                 / (leftSurplus + rightSurplus));
+                boundary = overlapLeft + leftShare;
+            }
 
-                int leftExclusiveRight = zones[leftIdx].left() + leftMinW;
-                boundary = qMax(boundary, leftExclusiveRight);
-                int rightMaxLeft = (zones[rightIdx].left() + zones[rightIdx].width()) - rightMinW;
-                boundary = qMin(boundary, rightMaxLeft);
-
-                int leftBound = boundary;
-                int rightBound = boundary;
-                if (innerGap > 0) {
-                    int halfGap = innerGap / 2;
-                    int candidateLeft = boundary - halfGap;
-                    int candidateRight = boundary + (innerGap - halfGap);
-                    if ((candidateLeft - zones[leftIdx].left()) >= leftMinW
-                        && ((zones[rightIdx].left() + zones[rightIdx].width()) - candidateRight) >= rightMinW) {
-                        leftBound = candidateLeft;
-                        rightBound = candidateRight;
-                    }
+            int leftExclusiveRight = zones[leftIdx].left() + leftMinW;
+            boundary = qMax(boundary, leftExclusiveRight);
+            int rightMaxLeft = (zones[rightIdx].left() + zones[rightIdx].width()) - rightMinW;
+            boundary = qMin(boundary, rightMaxLeft);
+
+            int leftBound = boundary;
+            int rightBound = boundary;
+            if (innerGap > 0) {
+                int halfGap = innerGap / 2;
+                int candidateLeft = boundary - halfGap;
+                int candidateRight = boundary + (innerGap - halfGap);
+                if ((candidateLeft - zones[leftIdx].left()) >= leftMinW
+                    && ((zones[rightIdx].left() + zones[rightIdx].width()) - candidateRight) >= rightMinW) {
+                    leftBound = candidateLeft;
+                    rightBound = candidateRight;
                 }
+            }
 
-                int newLeftWidth = leftBound - zones[leftIdx].left();
-                int newRightWidth = (zones[rightIdx].left() + zones[rightIdx].width()) - rightBound;
+            int newLeftWidth = leftBound - zones[leftIdx].left();
+            int newRightWidth = (zones[rightIdx].left() + zones[rightIdx].width()) - rightBound;
 
-                if (newLeftWidth > 0 && newRightWidth > 0) {
-                    zones[leftIdx].setWidth(newLeftWidth);
-                    zones[rightIdx].setLeft(rightBound);
-                    zones[rightIdx].setWidth(newRightWidth);
-                    changed = true;
-                }
+            if (newLeftWidth > 0 && newRightWidth > 0) {
+                zones[leftIdx].setWidth(newLeftWidth);
+                zones[rightIdx].setLeft(rightBound);
+                zones[rightIdx].setWidth(newRightWidth);
+                changed = true;
             }
         }
 
-        for (int i = 0; i < n; ++i) {
-            for (int j = i + 1; j < n; ++j) {
-                if (zones[i].right() < zones[j].left() || zones[j].right() < zones[i].left()) {
-                    continue;
-                }
-                int iBottom = zones[i].top() + zones[i].height();
-                int jBottom = zones[j].top() + zones[j].height();
-                int overlapTop = qMax(zones[i].top(), zones[j].top());
-                int overlapBottom = qMin(iBottom, jBottom);
-                if (overlapTop >= overlapBottom) {
-                    continue;
-                }
+        for (const auto& [i, j] : findRectOverlaps(zones)) {
+            if (zones[i].right() < zones[j].left() || zones[j].right() < zones[i].left()) {
+                continue;
+            }
+            int iBottom = zones[i].top() + zones[i].height();
+            int jBottom = zones[j].top() + zones[j].height();
+            int overlapTop = qMax(zones[i].top(), zones[j].top());
+            int overlapBottom = qMin(iBottom, jBottom);
+            if (overlapTop >= overlapBottom) {
+                continue;
+            }
 
-                int topIdx = (zones[i].top() <= zones[j].top()) ? i : j;
-                int bottomIdx = (topIdx == i) ? j : i;
+            int topIdx = (zones[i].top() <= zones[j].top()) ? i : j;
+            int bottomIdx = (topIdx == i) ? j : i;
 
-                int topMinH = GeometryDefaults::MinRectSizePx;
-                int bottomMinH = GeometryDefaults::MinRectSizePx;
-                if (hasMinSizes) {
-                    if (minSizes[topIdx].height() > 0) {
-                        topMinH = qMax(topMinH, minSizes[topIdx].height());
-                    }
-                    if (minSizes[bottomIdx].height() > 0) {
-                        bottomMinH = qMax(bottomMinH, minSizes[bottomIdx].height());
-                    }
+            int topMinH = GeometryDefaults::MinRectSizePx;
+            int bottomMinH = GeometryDefaults::MinRectSizePx;
+            if (hasMinSizes) {
+                if (minSizes[topIdx].height() > 0) {
+                    topMinH = qMax(topMinH, minSizes[topIdx].height());
+                }
+                if (minSizes[bottomIdx].height() > 0) {
+                    bottomMinH = qMax(bottomMinH, minSizes[bottomIdx].height());
                 }
+            }
 
-                int topSurplus = qMax(0, zones[topIdx].height() - topMinH);
-                int bottomSurplus = qMax(0, zones[bottomIdx].height() - bottomMinH);
+            int topSurplus = qMax(0, zones[topIdx].height() - topMinH);
+            int bottomSurplus = qMax(0, zones[bottomIdx].height() - bottomMinH);
 
-                int boundary;
-                int overlapAmount = overlapBottom - overlapTop;
+            int boundary;
+            int overlapAmount = overlapBottom - overlapTop;
 
-                if (topSurplus + bottomSurplus <= 0) {
-                    boundary = (overlapTop + overlapBottom) / 2;
-                } else {
-                    int topShare = static_cast<int>(static_cast<qint64>(overlapAmount) * bottomSurplus
-                                                    / (topSurplus + bottomSurplus));
-                    boundary = overlapTop + topShare;
-                }
+            if (topSurplus + bottomSurplus <= 0) {
+                boundary = (overlapTop + overlapBottom) / 2;
+            } else {
+                int topShare = static_cast<int>(static_cast<qint64>(overlapAmount) * bottomSurplus
+                                                / (topSurplus + bottomSurplus));
+                boundary = overlapTop + topShare;
+            }
 
-                int topExclusiveBottom = zones[topIdx].top() + topMinH;
-                boundary = qMax(boundary, topExclusiveBottom);
-                int bottomMaxTop = (zones[bottomIdx].top() + zones[bottomIdx].height()) - bottomMinH;
-                boundary = qMin(boundary, bottomMaxTop);
-
-                int topBound = boundary;
-                int bottomBound = boundary;
-                if (innerGap > 0) {
-                    int halfGap = innerGap / 2;
-                    int candidateTop = boundary - halfGap;
-                    int candidateBottom = boundary + (innerGap - halfGap);
-                    if ((candidateTop - zones[topIdx].top()) >= topMinH
-                        && ((zones[bottomIdx].top() + zones[bottomIdx].height()) - candidateBottom) >= bottomMinH) {
-                        topBound = candidateTop;
-                        bottomBound = candidateBottom;
-                    }
+            int topExclusiveBottom = zones[topIdx].top() + topMinH;
+            boundary = qMax(boundary, topExclusiveBottom);
+            int bottomMaxTop = (zones[bottomIdx].top() + zones[bottomIdx].height()) - bottomMinH;
+            boundary = qMin(boundary, bottomMaxTop);
+
+            int topBound = boundary;
+            int bottomBound = boundary;
+            if (innerGap > 0) {
+                int halfGap = innerGap / 2;
+                int candidateTop = boundary - halfGap;
+                int candidateBottom = boundary + (innerGap - halfGap);
+                if ((candidateTop - zones[topIdx].top()) >= topMinH
+                    && ((zones[bottomIdx].top() + zones[bottomIdx].height()) - candidateBottom) >= bottomMinH) {
+                    topBound = candidateTop;
+                    bottomBound = candidateBottom;
                 }
+            }
 
-                int newTopHeight = topBound - zones[topIdx].top();
-                int newBottomHeight = (zones[bottomIdx].top() + zones[bottomIdx].height()) - bottomBound;
+            int newTopHeight = topBound - zones[topIdx].top();
+            int newBottomHeight = (zones[bottomIdx].top() + zones[bottomIdx].height()) - bottomBound;
 
-                if (newTopHeight > 0 && newBottomHeight > 0) {
-                    zones[topIdx].setHeight(newTopHeight);
-                    zones[bottomIdx].setTop(bottomBound);
-                    zones[bottomIdx].setHeight(newBottomHeight);
-                    changed = true;
-                }
+            if (newTopHeight > 0 && newBottomHeight > 0) {
+                zones[topIdx].setHeight(newTopHeight);
+                zones[bottomIdx].setTop(bottomBound);
+                zones[bottomIdx].setHeight(newBottomHeight);
+                changed = true;
             }
         }
 
@@ -0,0 +1,250 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "MinSizeSolver.h"
+
+#include <PhosphorGeometry/GeometryUtils.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <numeric>
+
+namespace PhosphorGeometry::detail {
+
+namespace {
+
+constexpr int kMovable = std::numeric_limits<int>::min();
+
+// Every pair (i, j), i < j, whose [lo, hi) intervals overlap, sorted. One
+// sweep in lo order with the still-open intervals keyed by their end.
+QVector<QPair<int, int>> overlappingIntervals(const QVector<int>& lo, const QVector<int>& hi)
+{
+    const int n = lo.size();
+    QVector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return lo[a] != lo[b] ? lo[a] < lo[b] : a < b;
+    });
+
+    QVector<QPair<int, int>> pairs;
+    std::multimap<int, int> open;
+    for (int i : order) {
+        while (!open.empty() && open.begin()->first <= lo[i]) {
+            open.erase(open.begin());
+        }
+        for (const auto& entry : open) {
+            pairs.append(qMakePair(std::min(i, entry.second), std::max(i, entry.second)));
+        }
+        open.emplace(hi[i], i);
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+} // namespace
+
+bool MinSizeAxisSolver::solve(QVector<QRect>& zones, const QVector<int>& minDims, bool horizontal, int gapThreshold)
+{
+    const int n = zones.size();
+    QVector<int> lo(n);
+    QVector<int> hi(n);
+    QVector<int> acrossLo(n);
+    QVector<int> acrossHi(n);
+    for (int i = 0; i < n; ++i) {
+        const QRect& zone = zones[i];
+        lo[i] = horizontal ? zone.left() : zone.top();
+        hi[i] = lo[i] + (horizontal ? zone.width() : zone.height());
+        acrossLo[i] = horizontal ? zone.top() : zone.left();
+        acrossHi[i] = acrossLo[i] + (horizontal ? zone.height() : zone.width());
+        if (hi[i] <= lo[i] || acrossHi[i] <= acrossLo[i]) {
+            return false;
+        }
+    }
+
+    // Constrained zones get at least MinRectSizePx, like the grid solver.
+    // Unconstrained ones may donate, but not below MinRectSizePx (or their
+    // current extent if already smaller), and only at medium strength so a
+    // real minimum wins when the two conflict. The sign records which of the
+    // two an entry is: positive for a minimum, negative for a donor floor.
+    QVector<int> minExtents(n);
+    bool deficit = false;
+    for (int i = 0; i < n; ++i) {
+        const int extent = hi[i] - lo[i];
+        if (minDims[i] > 0) {
+            minExtents[i] = std::max(minDims[i], GeometryDefaults::MinRectSizePx);
+            deficit |= extent < minExtents[i];
+        } else {
+            minExtents[i] = -std::min(GeometryDefaults::MinRectSizePx, extent);
+        }
+    }
+    if (!deficit) {
+        return true;
+    }
+
+    QVector<int> coords;
+    coords.reserve(2 * n);
+    for (int i = 0; i < n; ++i) {
+        coords.append(lo[i]);
+        coords.append(hi[i]);
+    }
+    std::sort(coords.begin(), coords.end());
+    coords.erase(std::unique(coords.begin(), coords.end()), coords.end());
+    const auto edgeOf = [&coords](int coord) {
+        return int(std::lower_bound(coords.begin(), coords.end(), coord) - coords.begin());
+    };
+
+    Topology topology;
+    topology.zoneLow.resize(n);
+    topology.zoneHigh.resize(n);
+    for (int i = 0; i < n; ++i) {
+        topology.zoneLow[i] = edgeOf(lo[i]);
+        topology.zoneHigh[i] = edgeOf(hi[i]);
+    }
+
+    QVector<bool> movable(coords.size(), false);
+    for (const auto& [a, b] : overlappingIntervals(acrossLo, acrossHi)) {
+        int first = a;
+        int second = b;
+        if (hi[b] <= lo[a]) {
+            std::swap(first, second);
+        } else if (hi[a] > lo[b]) {
+            continue; // overlapping along the axis too: removeRectOverlaps' job
+        }
+        const int low = topology.zoneHigh[first];
+        const int high = topology.zoneLow[second];
+        const int gap = lo[second] - hi[first];
+        if (gap <= gapThreshold) {
+            topology.adjacencies.append({low, high, gap});
+            movable[low] = true;
+            movable[high] = true;
+        } else {
+            topology.orderings.append(qMakePair(low, high));
+        }
+    }
+    if (!std::any_of(movable.cbegin(), movable.cend(), [](bool m) {
+            return m;
+        })) {
+        return true; // no zone has a neighbour to take space from
+    }
+    std::sort(topology.adjacencies.begin(), topology.adjacencies.end());
+    topology.adjacencies.erase(std::unique(topology.adjacencies.begin(), topology.adjacencies.end()),
+                               topology.adjacencies.end());
+    std::sort(topology.orderings.begin(), topology.orderings.end());
+    topology.orderings.erase(std::unique(topology.orderings.begin(), topology.orderings.end()),
+                             topology.orderings.end());
+    topology.pinned.resize(coords.size());
+    for (int e = 0; e < coords.size(); ++e) {
+        topology.pinned[e] = movable[e] ? kMovable : coords[e];
+    }
+
+    if (!m_built || !(topology == m_topology)) {
+        if (!rebuild(topology)) {
+            return false;
+        }
+    }
+
+    for (int e = 0; e < coords.size(); ++e) {
+        // rebuild() made every movable edge an edit variable; a refusal means
+        // the retained tableau no longer matches the topology, so drop it and
+        // let the caller take the pairwise path.
+        if (movable[e] && !m_solver.suggestValue(m_edges[e], coords[e])) {
+            m_built = false;
+            return false;
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        if (m_minExtents[i] == minExtents[i]) {
+            continue;
+        }
+        if (m_minConstraints[i] >= 0) {
+            m_solver.removeConstraint(m_minConstraints[i]);
+            m_minConstraints[i] = -1;
+        }
+        m_minExtents[i] = minExtents[i];
+        const int low = topology.zoneLow[i];
+        const int high = topology.zoneHigh[i];
+        const int extent = std::abs(minExtents[i]);
+        if (extent > 1 && (movable[low] || movable[high])) {
+            const double strength = minExtents[i] > 0 ? ConstraintStrength::Strong : ConstraintStrength::Medium;
+            m_minConstraints[i] = m_solver.addConstraint({{m_edges[high], 1.0}, {m_edges[low], -1.0}}, -extent,
+                                                         ConstraintSolver::Relation::GreaterOrEqual, strength);
+        }
+    }
+
+    for (int i = 0; i < n; ++i) {
+        const int newLo = qRound(m_solver.value(m_edges[topology.zoneLow[i]]));
+        const int newHi = qRound(m_solver.value(m_edges[topology.zoneHigh[i]]));
+        if (horizontal) {
+            zones[i].setLeft(newLo);
+            zones[i].setWidth(std::max(1, newHi - newLo));
+        } else {
+            zones[i].setTop(newLo);
+            zones[i].setHeight(std::max(1, newHi - newLo));
+        }
+    }
+    return true;
+}
+
+bool MinSizeAxisSolver::rebuild(const Topology& topology)
+{
+    using Relation = ConstraintSolver::Relation;
+
+    m_solver.reset();
+    m_built = false;
+    const int edgeCount = topology.pinned.size();
+    m_edges.resize(edgeCount);
+    for (int e = 0; e < edgeCount; ++e) {
+        m_edges[e] = m_solver.addVariable();
+    }
+
+    // Every required constraint below holds for the arrangement the topology
+    // was taken from, so a failure here means corrupt input, not a conflict.
+    bool ok = true;
+    for (int e = 0; e < edgeCount; ++e) {
+        if (topology.pinned[e] == kMovable) {
+            ok &= m_solver.addEditVariable(m_edges[e], ConstraintStrength::Weak);
+        } else {
+            ok &= m_solver.addConstraint({{m_edges[e], 1.0}}, -topology.pinned[e], Relation::Equal) >= 0;
+        }
+    }
+    for (const Adjacency& adjacency : topology.adjacencies) {
+        if (adjacency.low != adjacency.high) {
+            ok &= m_solver.addConstraint({{m_edges[adjacency.high], 1.0}, {m_edges[adjacency.low], -1.0}},
+                                         -adjacency.gap, Relation::Equal)
+                >= 0;
+        }
+    }
+    const auto isMovable = [&topology](int edge) {
+        return topology.pinned[edge] == kMovable;
+    };
+    for (const auto& [low, high] : topology.orderings) {
+        if (isMovable(low) || isMovable(high)) {
+            ok &= m_solver.addConstraint({{m_edges[high], 1.0}, {m_edges[low], -1.0}}, 0.0,
+                                         Relation::GreaterOrEqual)
+                >= 0;
+        }
+    }
+    const int n = topology.zoneLow.size();
+    for (int i = 0; i < n; ++i) {
+        const int low = topology.zoneLow[i];
+        const int high = topology.zoneHigh[i];
+        if (isMovable(low) || isMovable(high)) {
+            ok &= m_solver.addConstraint({{m_edges[high], 1.0}, {m_edges[low], -1.0}}, -1.0,
+                                         Relation::GreaterOrEqual)
+                >= 0;
+        }
+    }
+    if (!ok) {
+        m_solver.reset();
+        return false;
+    }
+
+    m_minConstraints.fill(-1, n);
+    m_minExtents.fill(0, n);
+    m_topology = topology;
+    m_built = true;
+    return true;
+}
+
+} // namespace PhosphorGeometry::detail
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#pragma once
+
+// Private, built into PhosphorGeometry, not installed. The general-arrangement
+// path of enforceMinSizes(): what it falls back to when the grid solver in
+// GeometryUtils.cpp cannot describe the layout as columns.
+
+#include <PhosphorGeometry/ConstraintSolver.h>
+
+#include <QPair>
+#include <QRect>
+#include <QVector>
+
+namespace PhosphorGeometry::detail {
+
+// Enforces per-zone minimum extents along one axis of an arbitrary
+// non-overlapping arrangement: zones spanning several columns, rows whose
+// dividers do not line up, BSP trees. Every distinct edge coordinate is a
+// variable shared by all zones with an edge there, so moving a divider moves
+// every zone on it. Zones whose across-axis extents overlap and sit at most
+// gapThreshold apart are neighbours and keep their gap exactly; an edge with
+// no neighbour on either side is pinned, so a zone never grows into empty
+// space or off the layout. Minimums are strong constraints against weak
+// "stay where you were" edits, which makes the result the smallest total
+// edge movement that satisfies them, or the closest compromise when they
+// cannot all be met.
+//
+// The tableau is kept between calls. As long as the arrangement's structure
+// (which edges are shared, which zones neighbour, the pinned coordinates) is
+// unchanged, a call only re-suggests the free edges' current positions and
+// swaps the minimum constraints that changed, so a divider drag re-solves
+// incrementally from the previous basis.
+class MinSizeAxisSolver
+{
+public:
+    // Returns false, leaving zones untouched, when a zone has no extent and
+    // the arrangement cannot be modelled, or the solver rejects the model.
+    bool solve(QVector<QRect>& zones, const QVector<int>& minDims, bool horizontal, int gapThreshold);
+
+private:
+    struct Adjacency
+    {
+        int low = -1; ///< edge ending the zone before the gap
+        int high = -1; ///< edge starting the zone after it
+        int gap = 0;
+        bool operator==(const Adjacency&) const = default;
+        auto operator<=>(const Adjacency&) const = default;
+    };
+
+    struct Topology
+    {
+        QVector<int> zoneLow;
+        QVector<int> zoneHigh;
+        QVector<int> pinned; ///< per edge: its fixed coordinate, or kMovable
+        QVector<Adjacency> adjacencies;
+        QVector<QPair<int, int>> orderings; ///< (low, high): high may not pass low
+        bool operator==(const Topology&) const = default;
+    };
+
+    bool rebuild(const Topology& topology);
+
+    Topology m_topology;
+    bool m_built = false;
+    ConstraintSolver m_solver;
+    QVector<ConstraintSolver::Variable> m_edges;
+    QVector<ConstraintSolver::ConstraintId> m_minConstraints;
+    QVector<int> m_minExtents;
+};
+
+} // namespace PhosphorGeometry::detail
@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <PhosphorGeometry/ConstraintSolver.h>
+
+#include <QTest>
+
+using PhosphorGeometry::ConstraintSolver;
+namespace Strength = PhosphorGeometry::ConstraintStrength;
+using Relation = ConstraintSolver::Relation;
+
+class TestConstraintSolver : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void requiredEquality_pinsVariable();
+    void editVariable_followsSuggestion();
+    void strongMinimum_beatsWeakEdit();
+    void removeConstraint_releasesVariable();
+    void conflictingRequired_isRejected();
+    void unsatisfiableStrong_isClosestCompromise();
+    void editVariable_rejectsDuplicateAndRequired();
+    void reset_dropsEverything();
+
+private:
+    // A 0..900 span split by one divider that has to stay at least 1 px
+    // from either end.
+    struct Span
+    {
+        ConstraintSolver solver;
+        ConstraintSolver::Variable left = -1;
+        ConstraintSolver::Variable divider = -1;
+        ConstraintSolver::Variable right = -1;
+    };
+    static void buildSpan(Span& span);
+};
+
+void TestConstraintSolver::buildSpan(Span& span)
+{
+    span.left = span.solver.addVariable();
+    span.divider = span.solver.addVariable();
+    span.right = span.solver.addVariable();
+    QVERIFY(span.solver.addConstraint({{span.left, 1.0}}, 0.0, Relation::Equal) >= 0);
+    QVERIFY(span.solver.addConstraint({{span.right, 1.0}}, -900.0, Relation::Equal) >= 0);
+    QVERIFY(span.solver.addConstraint({{span.divider, 1.0}, {span.left, -1.0}}, -1.0, Relation::GreaterOrEqual) >= 0);
+    QVERIFY(span.solver.addConstraint({{span.right, 1.0}, {span.divider, -1.0}}, -1.0, Relation::GreaterOrEqual) >= 0);
+    QVERIFY(span.solver.addEditVariable(span.divider, Strength::Weak));
+}
+
+void TestConstraintSolver::requiredEquality_pinsVariable()
+{
+    Span span;
+    buildSpan(span);
+    QCOMPARE(span.solver.value(span.left), 0.0);
+    QCOMPARE(span.solver.value(span.right), 900.0);
+}
+
+void TestConstraintSolver::editVariable_followsSuggestion()
+{
+    Span span;
+    buildSpan(span);
+    QVERIFY(span.solver.suggestValue(span.divider, 300.0));
+    QCOMPARE(span.solver.value(span.divider), 300.0);
+    QVERIFY(span.solver.suggestValue(span.divider, 650.0));
+    QCOMPARE(span.solver.value(span.divider), 650.0);
+    // Required bounds win over the edit.
+    QVERIFY(span.solver.suggestValue(span.divider, 5000.0));
+    QCOMPARE(span.solver.value(span.divider), 899.0);
+}
+
+void TestConstraintSolver::strongMinimum_beatsWeakEdit()
+{
+    Span span;
+    buildSpan(span);
+    span.solver.suggestValue(span.divider, 300.0);
+    const auto min = span.solver.addConstraint({{span.divider, 1.0}, {span.left, -1.0}}, -400.0,
+                                               Relation::GreaterOrEqual, Strength::Strong);
+    QVERIFY(min >= 0);
+    QCOMPARE(span.solver.value(span.divider), 400.0);
+
+    // Incremental: suggestions above the minimum are followed, below it are
+    // clamped, without rebuilding anything.
+    span.solver.suggestValue(span.divider, 600.0);
+    QCOMPARE(span.solver.value(span.divider), 600.0);
+    span.solver.suggestValue(span.divider, 100.0);
+    QCOMPARE(span.solver.value(span.divider), 400.0);
+}
+
+void TestConstraintSolver::removeConstraint_releasesVariable()
+{
+    Span span;
+    buildSpan(span);
+    const auto min = span.solver.addConstraint({{span.divider, 1.0}, {span.left, -1.0}}, -400.0,
+                                               Relation::GreaterOrEqual, Strength::Strong);
+    span.solver.suggestValue(span.divider, 100.0);
+    QCOMPARE(span.solver.value(span.divider), 400.0);
+    QVERIFY(span.solver.removeConstraint(min));
+    QCOMPARE(span.solver.value(span.divider), 100.0);
+    QVERIFY(!span.solver.removeConstraint(min));
+}
+
+void TestConstraintSolver::conflictingRequired_isRejected()
+{
+    Span span;
+    buildSpan(span);
+    span.solver.suggestValue(span.divider, 500.0);
+    QCOMPARE(span.solver.addConstraint({{span.right, 1.0}}, -1000.0, Relation::Equal), -1);
+    QCOMPARE(span.solver.addConstraint({{span.divider, 1.0}, {span.right, -1.0}}, 0.0, Relation::GreaterOrEqual), -1);
+
+    // The rejected constraints left nothing behind.
+    QCOMPARE(span.solver.value(span.right), 900.0);
+    span.solver.suggestValue(span.divider, 500.0);
+    QCOMPARE(span.solver.value(span.divider), 500.0);
+}
+
+void TestConstraintSolver::unsatisfiableStrong_isClosestCompromise()
+{
+    Span span;
+    buildSpan(span);
+    span.solver.suggestValue(span.divider, 450.0);
+    span.solver.addConstraint({{span.divider, 1.0}, {span.left, -1.0}}, -1000.0, Relation::GreaterOrEqual,
+                              Strength::Strong);
+    QCOMPARE(span.solver.value(span.divider), 899.0);
+}
+
+void TestConstraintSolver::editVariable_rejectsDuplicateAndRequired()
+{
+    ConstraintSolver solver;
+    const auto x = solver.addVariable();
+    QVERIFY(!solver.addEditVariable(x, Strength::Required));
+    QVERIFY(solver.addEditVariable(x, Strength::Medium));
+    QVERIFY(!solver.addEditVariable(x, Strength::Weak));
+    QVERIFY(solver.hasEditVariable(x));
+    QVERIFY(solver.removeEditVariable(x));
+    QVERIFY(!solver.hasEditVariable(x));
+    QVERIFY(!solver.suggestValue(x, 1.0));
+}
+
+void TestConstraintSolver::reset_dropsEverything()
+{
+    Span span;
+    buildSpan(span);
+    span.solver.reset();
+    const auto x = span.solver.addVariable();
+    QCOMPARE(x, 0);
+    QVERIFY(span.solver.addEditVariable(x));
+    span.solver.suggestValue(x, 7.0);
+    QCOMPARE(span.solver.value(x), 7.0);
+}
+
+QTEST_GUILESS_MAIN(TestConstraintSolver)
+#include "test_constraint_solver.moc"
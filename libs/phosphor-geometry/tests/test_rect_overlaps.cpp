@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <PhosphorGeometry/GeometryUtils.h>
+
+#include <QRandomGenerator>
+#include <QRect>
+#include <QTest>
+
+using PhosphorGeometry::findRectOverlaps;
+
+using Pairs = QVector<QPair<int, int>>;
+
+class TestRectOverlaps : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void grid_hasNoOverlaps();
+    void touchingEdges_doNotOverlap();
+    void emptyRects_overlapNothing();
+    void nestedAndCrossing_reported();
+    void matchesBruteForce_onRandomLayouts();
+};
+
+void TestRectOverlaps::grid_hasNoOverlaps()
+{
+    QVector<QRect> grid;
+    for (int row = 0; row < 4; ++row) {
+        for (int col = 0; col < 4; ++col) {
+            grid.append(QRect(col * 100, row * 100, 100, 100));
+        }
+    }
+    QVERIFY(findRectOverlaps(grid).isEmpty());
+}
+
+void TestRectOverlaps::touchingEdges_doNotOverlap()
+{
+    const QVector<QRect> zones{QRect(0, 0, 100, 100), QRect(100, 0, 100, 100), QRect(0, 100, 200, 50)};
+    QVERIFY(findRectOverlaps(zones).isEmpty());
+}
+
+void TestRectOverlaps::emptyRects_overlapNothing()
+{
+    const QVector<QRect> zones{QRect(0, 0, 100, 100), QRect(50, 50, 0, 10), QRect(), QRect(10, 10, 10, 10)};
+    QCOMPARE(findRectOverlaps(zones), (Pairs{{0, 3}}));
+}
+
+void TestRectOverlaps::nestedAndCrossing_reported()
+{
+    const QVector<QRect> zones{
+        QRect(0, 0, 300, 300), // 0: contains 1
+        QRect(100, 100, 50, 50), // 1
+        QRect(250, 280, 100, 100), // 2: clips 0's corner
+        QRect(400, 0, 10, 500), // 3: crosses 4
+        QRect(350, 200, 200, 10), // 4
+    };
+    QCOMPARE(findRectOverlaps(zones), (Pairs{{0, 1}, {0, 2}, {3, 4}}));
+}
+
+void TestRectOverlaps::matchesBruteForce_onRandomLayouts()
+{
+    QRandomGenerator rng(1234);
+    for (int round = 0; round < 200; ++round) {
+        QVector<QRect> zones;
+        const int count = rng.bounded(40);
+        for (int i = 0; i < count; ++i) {
+            zones.append(QRect(rng.bounded(200), rng.bounded(200), rng.bounded(60), rng.bounded(60)));
+        }
+        Pairs expected;
+        for (int i = 0; i < count; ++i) {
+            for (int j = i + 1; j < count; ++j) {
+                if (zones[i].intersects(zones[j])) {
+                    expected.append({i, j});
+                }
+            }
+        }
+        QCOMPARE(findRectOverlaps(zones), expected);
+    }
+}
+
+QTEST_GUILESS_MAIN(TestRectOverlaps)
+#include "test_rect_overlaps.moc"
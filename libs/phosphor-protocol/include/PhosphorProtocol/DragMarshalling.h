@@ -15,7 +15,8 @@
 /// D-Bus marshalling for the window-drag value types (see DragTypes.h).
 ///
 /// Pulls in ZoneMarshalling.h because the DragOutcome marshaller streams a
-/// nested EmptyZoneList.
+/// nested EmptyZoneList and ZoneHitSnapshot a ZoneGeometryRect plus a
+/// NamedZoneGeometryList.
 
 namespace PhosphorProtocol {
 
@@ -23,8 +24,12 @@ PHOSPHORPROTOCOL_EXPORT QDBusArgument& operator<<(QDBusArgument& arg, const Drag
 PHOSPHORPROTOCOL_EXPORT const QDBusArgument& operator>>(const QDBusArgument& arg, DragPolicy& p);
 PHOSPHORPROTOCOL_EXPORT QDBusArgument& operator<<(QDBusArgument& arg, const DragOutcome& o);
 PHOSPHORPROTOCOL_EXPORT const QDBusArgument& operator>>(const QDBusArgument& arg, DragOutcome& o);
+PHOSPHORPROTOCOL_EXPORT QDBusArgument& operator<<(QDBusArgument& arg, const ZoneHitSnapshot& s);
+PHOSPHORPROTOCOL_EXPORT const QDBusArgument& operator>>(const QDBusArgument& arg, ZoneHitSnapshot& s);
 
 static_assert(PhosphorDBus::HasDBusStreaming<DragPolicy>::value, "DragPolicy missing QDBusArgument operators");
 static_assert(PhosphorDBus::HasDBusStreaming<DragOutcome>::value, "DragOutcome missing QDBusArgument operators");
+static_assert(PhosphorDBus::HasDBusStreaming<ZoneHitSnapshot>::value,
+              "ZoneHitSnapshot missing QDBusArgument operators");
 
 } // namespace PhosphorProtocol
@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+#include <PhosphorProtocol/phosphorprotocoltypes_export.h>
+
+#include <QtGlobal>
+
+#include <memory>
+
+namespace PhosphorProtocol {
+
+/// One cursor/modifier sample written by the compositor plugin during a drag.
+/// Same fields updateDragCursor carries on the D-Bus path, minus the window
+/// id — the window is fixed per drag by beginDrag, so the channel never needs
+/// to carry it.
+struct DragSample
+{
+    qint32 cursorX = 0;
+    qint32 cursorY = 0;
+    qint32 modifiers = 0; ///< Qt::KeyboardModifiers
+    qint32 mouseButtons = 0; ///< Qt::MouseButtons
+    qint64 timestampNs = 0; ///< CLOCK_MONOTONIC at capture (DragSampleChannel::monotonicNowNs)
+};
+
+/**
+ * @brief memfd-backed drag-sample ring shared between the compositor plugin
+ *        and the daemon, with an eventfd doorbell.
+ *
+ * The opt-in fast path for the drag hot loop. The producer (compositor
+ * plugin) writes every cursor sample into a fixed ring of seqlocked slots;
+ * the consumer (daemon) reads only the LATEST complete sample whenever it
+ * gets round to it — typically once per display frame — so a 1000 Hz mouse
+ * costs the daemon one read per frame instead of one D-Bus message per
+ * sample. D-Bus updateDragCursor remains the fallback whenever the channel
+ * is not attached.
+ *
+ * Doorbell: the consumer arms a flag in shared memory after each read. The
+ * producer rings the eventfd only when it finds the flag armed, so a burst
+ * of samples between two consumer reads costs a single write(2), and an idle
+ * consumer wakes exactly once per burst.
+ *
+ * Single producer, single consumer. All shared state is lock-free atomics,
+ * so neither side can block the other — a stalled daemon never stalls the
+ * compositor thread.
+ *
+ * Lifetime: the producer creates the memfd (sealed against shrink/grow, so a
+ * consumer mapping can never SIGBUS) and the eventfd, then hands both fds to
+ * the consumer (over D-Bus as unix fds). attach() validates the seals,
+ * size and header before mapping; a malformed or hostile fd yields nullptr.
+ */
+class PHOSPHORPROTOCOLTYPES_EXPORT DragSampleChannel
+{
+public:
+    /// Ring capacity (samples). The consumer only ever reads the newest slot,
+    /// so capacity just has to exceed what the producer can write during one
+    /// consumer read (a handful of nanoseconds) — 64 is generous.
+    static constexpr int DefaultCapacity = 64;
+
+    ~DragSampleChannel();
+    DragSampleChannel(const DragSampleChannel&) = delete;
+    DragSampleChannel& operator=(const DragSampleChannel&) = delete;
+
+    /// Producer side: allocate a fresh sealed memfd + eventfd. Returns nullptr
+    /// (with a warning) when the kernel lacks memfd/eventfd support.
+    static std::unique_ptr<DragSampleChannel> create(int capacity = DefaultCapacity);
+
+    /// Consumer side: map a channel created by another process. Both fds are
+    /// dup()ed, so the caller keeps ownership of the ones it passes in.
+    static std::unique_ptr<DragSampleChannel> attach(int memFd, int doorbellFd);
+
+    int memFd() const
+    {
+        return m_memFd;
+    }
+    int doorbellFd() const
+    {
+        return m_doorbellFd;
+    }
+    bool isProducer() const
+    {
+        return m_producer;
+    }
+
+    /// Producer: publish @p sample as the newest entry and ring the doorbell
+    /// if the consumer is waiting. Wait-free.
+    void publish(const DragSample& sample);
+
+    /// Sequence number of the newest published sample (0 = none yet).
+    quint64 writeSequence() const;
+
+    /// Consumer: copy the newest complete sample into @p out. Returns false
+    /// when nothing has been published yet. @p sequence (optional) receives
+    /// the sample's sequence number, so callers can ignore samples that
+    /// predate a drag boundary.
+    bool readLatest(DragSample& out, quint64* sequence = nullptr) const;
+
+    /// Consumer: drain the eventfd and re-arm the doorbell. Call after
+    /// handling a wake-up; then re-check writeSequence() — a sample published
+    /// between the read and the re-arm does not ring again.
+    void rearmDoorbell();
+
+    /// CLOCK_MONOTONIC in nanoseconds — the clock DragSample::timestampNs
+    /// uses, comparable across the two processes.
+    static qint64 monotonicNowNs();
+
+private:
+    DragSampleChannel() = default;
+
+    struct Shared;
+    Shared* m_shared = nullptr;
+    size_t m_mappedSize = 0;
+    quint32 m_capacity = 0;
+    int m_memFd = -1;
+    int m_doorbellFd = -1;
+    bool m_producer = false;
+};
+
+} // namespace PhosphorProtocol
@@ -7,8 +7,10 @@
 #include <PhosphorProtocol/phosphorprotocoltypes_export.h>
 
 #include <QMetaType>
+#include <QPoint>
 #include <QRect>
 #include <QString>
+#include <QStringList>
 
 class QDebug;
 
@@ -134,7 +136,53 @@ struct PHOSPHORPROTOCOLTYPES_EXPORT DragOutcome
     QString validationError() const;
 };
 
+/// Which zones a cursor position hits in a ZoneHitSnapshot, in snapshot
+/// order. Mirrors the two sets ZoneDetector::detectMultiZone derives its
+/// result from: zones containing the cursor, and zones within the adjacency
+/// threshold of it (containing zones included).
+struct ZoneHitKey
+{
+    QStringList containing;
+    QStringList near;
+
+    bool operator==(const ZoneHitKey&) const = default;
+};
+
+/// Compact per-screen snapshot of the computed zone rectangles the daemon
+/// hit-tests drags against. Published by WindowDrag.zoneHitSnapshotChanged
+/// whenever a layout compute for the screen lands, so the compositor plugin
+/// can tell locally whether a cursor sample could change the daemon's zone
+/// pick and skip the updateDragCursor call when it cannot.
+///
+/// Wire: (sstib(iiii)a(siiii))
+struct PHOSPHORPROTOCOLTYPES_EXPORT ZoneHitSnapshot
+{
+    QString screenId;
+    QString layoutId; ///< empty when the screen has no active layout
+    quint64 generation = 0; ///< compute generation the rects came from (per screen, monotonic)
+    int adjacencyThreshold = 0; ///< daemon's multi-zone edge threshold, in pixels
+    /// The daemon consumes the raw cursor on this screen (shader overlay
+    /// mouse uniform, autotile insert preview), so every sample matters and
+    /// the plugin must not filter.
+    bool tracksCursor = false;
+    ZoneGeometryRect screenGeometry;
+    NamedZoneGeometryList zones; ///< absolute zone rects, layout order
+
+    /// Hit-test @p point. Returns false when the answer is ambiguous within
+    /// @p slack pixels — the cursor sits on a zone edge or threshold boundary
+    /// (where integer rounding of the published rects could disagree with
+    /// the daemon's float geometry), or anywhere not inside exactly one zone:
+    /// overlapping zones are resolved by centre distance, and outside every
+    /// zone the daemon picks the nearest one. Callers must forward such
+    /// samples unconditionally. On true, @p key is the stable hit.
+    bool stableHitAt(const QPoint& point, int slack, ZoneHitKey& key) const;
+};
+
+using ZoneHitSnapshotList = QList<ZoneHitSnapshot>;
+
 } // namespace PhosphorProtocol
 
 Q_DECLARE_METATYPE(PhosphorProtocol::DragPolicy)
 Q_DECLARE_METATYPE(PhosphorProtocol::DragOutcome)
+Q_DECLARE_METATYPE(PhosphorProtocol::ZoneHitSnapshot)
+Q_DECLARE_METATYPE(PhosphorProtocol::ZoneHitSnapshotList)
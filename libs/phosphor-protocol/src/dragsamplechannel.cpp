@@ -0,0 +1,298 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <PhosphorProtocol/DragSampleChannel.h>
+
+#include <QLoggingCategory>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace PhosphorProtocol {
+
+namespace {
+
+// File-local category sharing the library's "phosphor.protocol" name — this
+// QtCore-only types target cannot reach ClientHelpers' accessor (see types.cpp).
+const QLoggingCategory& lcDragChannel()
+{
+    static const QLoggingCategory category("phosphor.protocol", QtInfoMsg);
+    return category;
+}
+
+constexpr quint32 kChannelMagic = 0x505a4453; // "PZDS"
+// Bump on any change to the shared layout below. attach() rejects a
+// mismatch, so a daemon/effect version skew falls back to D-Bus instead of
+// misreading the ring.
+constexpr quint32 kChannelVersion = 1;
+constexpr int kMaxCapacity = 4096;
+
+static_assert(std::atomic<quint64>::is_always_lock_free, "drag channel needs lock-free 64-bit atomics");
+static_assert(std::atomic<qint32>::is_always_lock_free, "drag channel needs lock-free 32-bit atomics");
+
+// One seqlocked slot. Fields are individually atomic (relaxed) so the
+// reader's copy racing a writer is well-defined; the sequence fences turn
+// that into an all-or-nothing read.
+struct alignas(64) Slot
+{
+    std::atomic<quint64> sequence; ///< sample number held, 0 while being written
+    std::atomic<qint32> cursorX;
+    std::atomic<qint32> cursorY;
+    std::atomic<qint32> modifiers;
+    std::atomic<qint32> mouseButtons;
+    std::atomic<qint64> timestampNs;
+};
+
+// Shared header; the slot array follows it directly in the mapping.
+struct Header
+{
+    quint32 magic;
+    quint32 version;
+    quint32 capacity;
+    quint32 slotSize;
+    // Producer- and consumer-written words on their own cache lines so the
+    // two processes don't false-share.
+    alignas(64) std::atomic<quint64> writeSequence;
+    alignas(64) std::atomic<quint32> consumerArmed;
+
+    Slot* slots()
+    {
+        return reinterpret_cast<Slot*>(reinterpret_cast<char*>(this) + sizeof(Header));
+    }
+    const Slot* slots() const
+    {
+        return reinterpret_cast<const Slot*>(reinterpret_cast<const char*>(this) + sizeof(Header));
+    }
+};
+
+size_t sharedSizeFor(quint32 capacity)
+{
+    return sizeof(Header) + size_t(capacity) * sizeof(Slot);
+}
+
+} // namespace
+
+struct DragSampleChannel::Shared : Header
+{
+};
+
+DragSampleChannel::~DragSampleChannel()
+{
+    if (m_shared) {
+        munmap(m_shared, m_mappedSize);
+    }
+    if (m_memFd >= 0) {
+        close(m_memFd);
+    }
+    if (m_doorbellFd >= 0) {
+        close(m_doorbellFd);
+    }
+}
+
+std::unique_ptr<DragSampleChannel> DragSampleChannel::create(int capacity)
+{
+    if (capacity < 2 || capacity > kMaxCapacity) {
+        qCWarning(lcDragChannel()) << "DragSampleChannel: invalid capacity" << capacity;
+        return nullptr;
+    }
+
+    std::unique_ptr<DragSampleChannel> channel(new DragSampleChannel());
+    channel->m_producer = true;
+    channel->m_capacity = static_cast<quint32>(capacity);
+    channel->m_mappedSize = sharedSizeFor(channel->m_capacity);
+
+    channel->m_memFd = memfd_create("plasmazones-drag", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (channel->m_memFd < 0) {
+        qCWarning(lcDragChannel()) << "DragSampleChannel: memfd_create failed:" << strerror(errno);
+        return nullptr;
+    }
+    if (ftruncate(channel->m_memFd, static_cast<off_t>(channel->m_mappedSize)) != 0) {
+        qCWarning(lcDragChannel()) << "DragSampleChannel: ftruncate failed:" << strerror(errno);
+        return nullptr;
+    }
+    // Freeze the size before anyone else can map it: a consumer mapping of a
+    // file that later shrinks would SIGBUS the daemon.
+    if (fcntl(channel->m_memFd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) != 0) {
+        qCWarning(lcDragChannel()) << "DragSampleChannel: sealing failed:" << strerror(errno);
+        return nullptr;
+    }
+
+    void* mapped = mmap(nullptr, channel->m_mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, channel->m_memFd, 0);
+    if (mapped == MAP_FAILED) {
+        qCWarning(lcDragChannel()) << "DragSampleChannel: mmap failed:" << strerror(errno);
+        return nullptr;
+    }
+    auto* shared = static_cast<Shared*>(mapped);
+    channel->m_shared = shared;
+
+    // The memfd starts zero-filled; placement-new the atomics anyway so the
+    // objects formally exist before either side touches them.
+    new (&shared->writeSequence) std::atomic<quint64>(0);
+    new (&shared->consumerArmed) std::atomic<quint32>(1);
+    Slot* slots = shared->slots();
+    for (quint32 i = 0; i < channel->m_capacity; ++i) {
+        new (&slots[i]) Slot();
+        slots[i].sequence.store(0, std::memory_order_relaxed);
+    }
+    shared->capacity = channel->m_capacity;
+    shared->slotSize = sizeof(Slot);
+    shared->version = kChannelVersion;
+    // Magic last: attach() treats a missing magic as "not a channel".
+    std::atomic_thread_fence(std::memory_order_release);
+    shared->magic = kChannelMagic;
+
+    channel->m_doorbellFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (channel->m_doorbellFd < 0) {
+        qCWarning(lcDragChannel()) << "DragSampleChannel: eventfd failed:" << strerror(errno);
+        return nullptr;
+    }
+    return channel;
+}
+
+std::unique_ptr<DragSampleChannel> DragSampleChannel::attach(int memFd, int doorbellFd)
+{
+    if (memFd < 0 || doorbellFd < 0) {
+        return nullptr;
+    }
+
+    std::unique_ptr<DragSampleChannel> channel(new DragSampleChannel());
+    channel->m_memFd = fcntl(memFd, F_DUPFD_CLOEXEC, 0);
+    channel->m_doorbellFd = fcntl(doorbellFd, F_DUPFD_CLOEXEC, 0);
+    if (channel->m_memFd < 0 || channel->m_doorbellFd < 0) {
+        qCWarning(lcDragChannel()) << "DragSampleChannel: dup failed:" << strerror(errno);
+        return nullptr;
+    }
+    // The doorbell is read non-blocking from the consumer's event loop.
+    const int flags = fcntl(channel->m_doorbellFd, F_GETFL);
+    if (flags < 0 || fcntl(channel->m_doorbellFd, F_SETFL, flags | O_NONBLOCK) != 0) {
+        return nullptr;
+    }
+
+    // Refuse an unsealed fd: the peer could truncate it under our mapping.
+    const int seals = fcntl(channel->m_memFd, F_GET_SEALS);
+    if (seals < 0 || (seals & F_SEAL_SHRINK) == 0) {
+        qCWarning(lcDragChannel()) << "DragSampleChannel: refusing unsealed memfd";
+        return nullptr;
+    }
+
+    struct stat st;
+    if (fstat(channel->m_memFd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+        qCWarning(lcDragChannel()) << "DragSampleChannel: memfd too small";
+        return nullptr;
+    }
+    channel->m_mappedSize = static_cast<size_t>(st.st_size);
+
+    // Read-write: the consumer owns the consumerArmed word.
+    void* mapped = mmap(nullptr, channel->m_mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, channel->m_memFd, 0);
+    if (mapped == MAP_FAILED) {
+        qCWarning(lcDragChannel()) << "DragSampleChannel: mmap failed:" << strerror(errno);
+        return nullptr;
+    }
+    auto* shared = static_cast<Shared*>(mapped);
+    channel->m_shared = shared;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (shared->magic != kChannelMagic || shared->version != kChannelVersion || shared->slotSize != sizeof(Slot)
+        || shared->capacity < 2 || shared->capacity > kMaxCapacity
+        || sharedSizeFor(shared->capacity) > channel->m_mappedSize) {
+        qCWarning(lcDragChannel()) << "DragSampleChannel: header mismatch (magic/version/size)";
+        return nullptr;
+    }
+    channel->m_capacity = shared->capacity;
+    return channel;
+}
+
+void DragSampleChannel::publish(const DragSample& sample)
+{
+    if (!m_shared || !m_producer) {
+        return;
+    }
+    const quint64 n = m_shared->writeSequence.load(std::memory_order_relaxed) + 1;
+    Slot& slot = m_shared->slots()[(n - 1) % m_capacity];
+
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.cursorX.store(sample.cursorX, std::memory_order_relaxed);
+    slot.cursorY.store(sample.cursorY, std::memory_order_relaxed);
+    slot.modifiers.store(sample.modifiers, std::memory_order_relaxed);
+    slot.mouseButtons.store(sample.mouseButtons, std::memory_order_relaxed);
+    slot.timestampNs.store(sample.timestampNs, std::memory_order_relaxed);
+    slot.sequence.store(n, std::memory_order_release);
+    m_shared->writeSequence.store(n, std::memory_order_release);
+
+    // Ring only if the consumer has re-armed since its last read.
+    if (m_shared->consumerArmed.exchange(0, std::memory_order_acq_rel) != 0) {
+        const quint64 one = 1;
+        // EAGAIN (counter saturated) is harmless: the consumer is already due
+        // to wake. Anything else just costs this one wake-up.
+        [[maybe_unused]] const ssize_t written = write(m_doorbellFd, &one, sizeof(one));
+    }
+}
+
+quint64 DragSampleChannel::writeSequence() const
+{
+    return m_shared ? m_shared->writeSequence.load(std::memory_order_acquire) : 0;
+}
+
+bool DragSampleChannel::readLatest(DragSample& out, quint64* sequence) const
+{
+    if (!m_shared) {
+        return false;
+    }
+    // A torn read means the producer lapped this slot mid-copy — retry on the
+    // (new) newest sample. Bounded so a hostile producer can't spin us.
+    for (int attempt = 0; attempt < 8; ++attempt) {
+        const quint64 n = m_shared->writeSequence.load(std::memory_order_acquire);
+        if (n == 0) {
+            return false;
+        }
+        const Slot& slot = m_shared->slots()[(n - 1) % m_capacity];
+        if (slot.sequence.load(std::memory_order_acquire) != n) {
+            continue;
+        }
+        DragSample copy;
+        copy.cursorX = slot.cursorX.load(std::memory_order_relaxed);
+        copy.cursorY = slot.cursorY.load(std::memory_order_relaxed);
+        copy.modifiers = slot.modifiers.load(std::memory_order_relaxed);
+        copy.mouseButtons = slot.mouseButtons.load(std::memory_order_relaxed);
+        copy.timestampNs = slot.timestampNs.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != n) {
+            continue;
+        }
+        out = copy;
+        if (sequence) {
+            *sequence = n;
+        }
+        return true;
+    }
+    return false;
+}
+
+void DragSampleChannel::rearmDoorbell()
+{
+    if (!m_shared || m_producer) {
+        return;
+    }
+    quint64 counter = 0;
+    [[maybe_unused]] const ssize_t drained = read(m_doorbellFd, &counter, sizeof(counter));
+    m_shared->consumerArmed.store(1, std::memory_order_release);
+}
+
+qint64 DragSampleChannel::monotonicNowNs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return qint64(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+} // namespace PhosphorProtocol
@@ -371,6 +371,26 @@ const QDBusArgument& operator>>(const QDBusArgument& arg, DragOutcome& o)
     return arg;
 }
 
+QDBusArgument& operator<<(QDBusArgument& arg, const ZoneHitSnapshot& s)
+{
+    arg.beginStructure();
+    arg << s.screenId << s.layoutId << static_cast<qulonglong>(s.generation) << s.adjacencyThreshold
+        << s.tracksCursor << s.screenGeometry << s.zones;
+    arg.endStructure();
+    return arg;
+}
+
+const QDBusArgument& operator>>(const QDBusArgument& arg, ZoneHitSnapshot& s)
+{
+    arg.beginStructure();
+    qulonglong generation = 0;
+    arg >> s.screenId >> s.layoutId >> generation >> s.adjacencyThreshold >> s.tracksCursor >> s.screenGeometry
+        >> s.zones;
+    s.generation = generation;
+    arg.endStructure();
+    return arg;
+}
+
 void registerWireTypes()
 {
     // Each type is registered under its fully-qualified name
@@ -418,6 +438,8 @@ void registerWireTypes()
     P_REGISTER_DBUS_TYPE(PreTileGeometryList);
     P_REGISTER_DBUS_TYPE(DragPolicy);
     P_REGISTER_DBUS_TYPE(DragOutcome);
+    P_REGISTER_DBUS_TYPE(ZoneHitSnapshot);
+    P_REGISTER_DBUS_TYPE(ZoneHitSnapshotList);
 
 #undef P_REGISTER_DBUS_TYPE
 }
@@ -6,9 +6,13 @@
 #include <PhosphorProtocol/DragTypes.h>
 
 #include <QDebug>
+#include <QtMath>
 #include <QLatin1String>
 #include <QLoggingCategory>
 
+#include <algorithm>
+#include <cmath>
+
 namespace PhosphorProtocol {
 
 namespace {
@@ -221,4 +225,52 @@ QDebug operator<<(QDebug debug, DragBypassReason r)
     return debug;
 }
 
+namespace {
+// Same metric as Zone::distanceToPoint: 0 inside, else Euclidean distance to
+// the nearest edge. QRect's right()/bottom() are inclusive (x + w - 1), so
+// the exclusive edge is used to match the daemon's QRectF geometry.
+qreal distanceToRect(const QRect& r, const QPoint& p)
+{
+    const qreal dx = std::max({0, r.x() - p.x(), p.x() - (r.x() + r.width())});
+    const qreal dy = std::max({0, r.y() - p.y(), p.y() - (r.y() + r.height())});
+    return qSqrt(dx * dx + dy * dy);
+}
+
+// Signed distance: negative depth inside the rect, positive distance outside.
+qreal signedDistanceToRect(const QRect& r, const QPoint& p)
+{
+    const qreal outside = distanceToRect(r, p);
+    if (outside > 0) {
+        return outside;
+    }
+    const int depth = std::min({p.x() - r.x(), r.x() + r.width() - p.x(), p.y() - r.y(), r.y() + r.height() - p.y()});
+    return -qreal(depth);
+}
+} // namespace
+
+bool ZoneHitSnapshot::stableHitAt(const QPoint& point, int slack, ZoneHitKey& key) const
+{
+    key = {};
+    const qreal threshold = std::max(0, adjacencyThreshold);
+    for (const NamedZoneGeometry& zone : zones) {
+        const qreal d = signedDistanceToRect(zone.toRect(), point);
+        // Each test is stable only if it gives the same answer anywhere
+        // within slack of the cursor.
+        if (std::abs(d) <= slack || std::abs(d - threshold) <= slack) {
+            return false;
+        }
+        if (d < 0) {
+            key.containing.append(zone.zoneId);
+            key.near.append(zone.zoneId);
+        } else if (d <= threshold) {
+            key.near.append(zone.zoneId);
+        }
+    }
+    // Only a single containing zone pins the daemon's pick. With several, it
+    // resolves the overlap by distance to each zone's centre. With none, it
+    // falls back to the nearest zone at any distance. Both answers move with
+    // the cursor inside one key.
+    return key.containing.size() == 1;
+}
+
 } // namespace PhosphorProtocol
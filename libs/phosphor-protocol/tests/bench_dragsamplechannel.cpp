@@ -0,0 +1,181 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/**
+ * @file bench_dragsamplechannel.cpp
+ * @brief Producer→consumer latency: shared-memory drag channel vs D-Bus.
+ *
+ * Measures what the drag hot loop pays per cursor sample on each transport:
+ *
+ *   - ring: publish() on the producer until a consumer thread blocked in
+ *     poll() on the doorbell has read the sample back out (wake-up included)
+ *   - dbus: a no-reply method call (the updateDragCursor shape) from one
+ *     session-bus connection until the slot runs on a second connection's
+ *     thread — bus daemon hop included
+ *
+ * Both report median / p99 in microseconds via qInfo. Run with:
+ *
+ *   ctest --test-dir build -R bench_dragsamplechannel --output-on-failure
+ *
+ * The D-Bus half runs against the private session bus set up by
+ * phosphor_apply_test_isolation and skips when no bus is reachable.
+ */
+
+#include <PhosphorProtocol/DragSampleChannel.h>
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QTest>
+#include <QThread>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+
+using namespace PhosphorProtocol;
+
+namespace {
+
+constexpr int Iterations = 5000;
+
+void report(const char* label, std::vector<qint64>& latenciesNs)
+{
+    QVERIFY(!latenciesNs.empty());
+    std::sort(latenciesNs.begin(), latenciesNs.end());
+    const qint64 median = latenciesNs[latenciesNs.size() / 2];
+    const qint64 p99 = latenciesNs[(latenciesNs.size() * 99) / 100];
+    qInfo("%s: median %.2f us, p99 %.2f us over %zu samples", label, median / 1000.0, p99 / 1000.0,
+          latenciesNs.size());
+}
+
+bool waitFor(const std::atomic<int>& counter, int target)
+{
+    const qint64 deadline = DragSampleChannel::monotonicNowNs() + qint64(5) * 1000 * 1000 * 1000;
+    while (counter.load(std::memory_order_acquire) < target) {
+        if (DragSampleChannel::monotonicNowNs() > deadline) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+} // namespace
+
+/// Receiving end of the D-Bus half; lives on its own thread.
+class DragSink : public QObject
+{
+    Q_OBJECT
+
+public:
+    std::vector<qint64> latenciesNs;
+    std::atomic<int> received{0};
+
+public Q_SLOTS:
+    void sample(qlonglong sentNs, int cursorX, int cursorY, int modifiers, int mouseButtons)
+    {
+        Q_UNUSED(cursorX)
+        Q_UNUSED(cursorY)
+        Q_UNUSED(modifiers)
+        Q_UNUSED(mouseButtons)
+        latenciesNs.push_back(DragSampleChannel::monotonicNowNs() - sentNs);
+        received.fetch_add(1, std::memory_order_release);
+    }
+};
+
+class BenchDragSampleChannel : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void benchRingLatency()
+    {
+        auto producer = DragSampleChannel::create();
+        QVERIFY(producer);
+        auto consumer = DragSampleChannel::attach(producer->memFd(), producer->doorbellFd());
+        QVERIFY(consumer);
+
+        std::vector<qint64> latencies;
+        latencies.reserve(Iterations);
+        std::atomic<int> consumed{0};
+        std::atomic<bool> stop{false};
+
+        std::thread reader([&] {
+            quint64 seen = 0;
+            while (!stop.load(std::memory_order_acquire)) {
+                pollfd p{consumer->doorbellFd(), POLLIN, 0};
+                if (::poll(&p, 1, 100) <= 0) {
+                    continue;
+                }
+                DragSample s;
+                quint64 seq = 0;
+                if (consumer->readLatest(s, &seq) && seq > seen) {
+                    seen = seq;
+                    latencies.push_back(DragSampleChannel::monotonicNowNs() - s.timestampNs);
+                    consumed.fetch_add(1, std::memory_order_release);
+                }
+                consumer->rearmDoorbell();
+            }
+        });
+
+        for (int i = 0; i < Iterations; ++i) {
+            DragSample s;
+            s.cursorX = i;
+            s.timestampNs = DragSampleChannel::monotonicNowNs();
+            producer->publish(s);
+            if (!waitFor(consumed, i + 1)) {
+                break;
+            }
+        }
+        stop.store(true, std::memory_order_release);
+        reader.join();
+
+        QCOMPARE(consumed.load(), Iterations);
+        report("ring publish->read", latencies);
+    }
+
+    void benchDBusLatency()
+    {
+        QDBusConnection sender = QDBusConnection::sessionBus();
+        if (!sender.isConnected()) {
+            QSKIP("no session bus");
+        }
+        QDBusConnection receiver =
+            QDBusConnection::connectToBus(QDBusConnection::SessionBus, QStringLiteral("bench-drag-receiver"));
+        if (!receiver.isConnected()) {
+            QSKIP("cannot open a second session-bus connection");
+        }
+
+        QThread sinkThread;
+        DragSink sink;
+        sink.latenciesNs.reserve(Iterations);
+        sink.moveToThread(&sinkThread);
+        sinkThread.start();
+        QVERIFY(receiver.registerObject(QStringLiteral("/bench"), &sink, QDBusConnection::ExportAllSlots));
+
+        for (int i = 0; i < Iterations; ++i) {
+            QDBusMessage msg = QDBusMessage::createMethodCall(receiver.baseService(), QStringLiteral("/bench"),
+                                                              QString(), QStringLiteral("sample"));
+            msg << qlonglong(DragSampleChannel::monotonicNowNs()) << i << i << 0 << 0;
+            msg.setAutoStartService(false);
+            QVERIFY(sender.send(msg));
+            if (!waitFor(sink.received, i + 1)) {
+                break;
+            }
+        }
+
+        receiver.unregisterObject(QStringLiteral("/bench"));
+        sinkThread.quit();
+        sinkThread.wait();
+        QDBusConnection::disconnectFromBus(QStringLiteral("bench-drag-receiver"));
+
+        QCOMPARE(sink.received.load(), Iterations);
+        report("dbus call->slot", sink.latenciesNs);
+    }
+};
+
+QTEST_GUILESS_MAIN(BenchDragSampleChannel)
+#include "bench_dragsamplechannel.moc"
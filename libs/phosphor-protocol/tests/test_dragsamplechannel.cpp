@@ -0,0 +1,178 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <PhosphorProtocol/DragSampleChannel.h>
+
+#include <QTest>
+
+#include <atomic>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace PhosphorProtocol;
+
+namespace {
+
+DragSample makeSample(int i)
+{
+    DragSample s;
+    s.cursorX = i;
+    s.cursorY = -i;
+    s.modifiers = i * 3;
+    s.mouseButtons = i * 7;
+    s.timestampNs = qint64(i) * 1000;
+    return s;
+}
+
+bool doorbellReadable(int fd)
+{
+    pollfd p{fd, POLLIN, 0};
+    return ::poll(&p, 1, 0) == 1 && (p.revents & POLLIN);
+}
+
+} // namespace
+
+class TestDragSampleChannel : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testEmptyChannel()
+    {
+        auto producer = DragSampleChannel::create();
+        QVERIFY(producer);
+        auto consumer = DragSampleChannel::attach(producer->memFd(), producer->doorbellFd());
+        QVERIFY(consumer);
+        QVERIFY(!consumer->isProducer());
+        QCOMPARE(consumer->writeSequence(), quint64(0));
+        DragSample out;
+        QVERIFY(!consumer->readLatest(out));
+    }
+
+    void testReadsNewestSample()
+    {
+        auto producer = DragSampleChannel::create(4);
+        auto consumer = DragSampleChannel::attach(producer->memFd(), producer->doorbellFd());
+        QVERIFY(consumer);
+
+        // Wrap the ring several times; only the newest sample is visible.
+        for (int i = 1; i <= 10; ++i) {
+            producer->publish(makeSample(i));
+        }
+        DragSample out;
+        quint64 seq = 0;
+        QVERIFY(consumer->readLatest(out, &seq));
+        QCOMPARE(seq, quint64(10));
+        QCOMPARE(out.cursorX, 10);
+        QCOMPARE(out.cursorY, -10);
+        QCOMPARE(out.modifiers, 30);
+        QCOMPARE(out.mouseButtons, 70);
+        QCOMPARE(out.timestampNs, qint64(10000));
+    }
+
+    void testDoorbellRingsOncePerArm()
+    {
+        auto producer = DragSampleChannel::create();
+        auto consumer = DragSampleChannel::attach(producer->memFd(), producer->doorbellFd());
+        QVERIFY(consumer);
+
+        // A fresh channel starts armed: the first publish rings, the burst
+        // after it does not add wake-ups.
+        producer->publish(makeSample(1));
+        QVERIFY(doorbellReadable(consumer->doorbellFd()));
+        producer->publish(makeSample(2));
+        producer->publish(makeSample(3));
+
+        consumer->rearmDoorbell();
+        QVERIFY(!doorbellReadable(consumer->doorbellFd()));
+
+        producer->publish(makeSample(4));
+        QVERIFY(doorbellReadable(consumer->doorbellFd()));
+    }
+
+    void testRejectsUnsealedMemfd()
+    {
+        const int fd = memfd_create("not-a-channel", MFD_CLOEXEC);
+        QVERIFY(fd >= 0);
+        QCOMPARE(ftruncate(fd, 4096), 0);
+        auto producer = DragSampleChannel::create();
+        QVERIFY(!DragSampleChannel::attach(fd, producer->doorbellFd()));
+        ::close(fd);
+    }
+
+    void testRejectsForeignLayout()
+    {
+        // Sealed and big enough, but no channel header.
+        const int fd = memfd_create("not-a-channel", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+        QVERIFY(fd >= 0);
+        QCOMPARE(ftruncate(fd, 65536), 0);
+        QCOMPARE(fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW), 0);
+        auto producer = DragSampleChannel::create();
+        QVERIFY(!DragSampleChannel::attach(fd, producer->doorbellFd()));
+        ::close(fd);
+    }
+
+    void testAttachDupsDescriptors()
+    {
+        auto producer = DragSampleChannel::create();
+        const int mem = ::dup(producer->memFd());
+        const int bell = ::dup(producer->doorbellFd());
+        auto consumer = DragSampleChannel::attach(mem, bell);
+        QVERIFY(consumer);
+        ::close(mem);
+        ::close(bell);
+
+        producer->publish(makeSample(5));
+        DragSample out;
+        QVERIFY(consumer->readLatest(out));
+        QCOMPARE(out.cursorX, 5);
+    }
+
+    void testConcurrentReadsAreNeverTorn()
+    {
+        // Every published sample is internally consistent (all fields derive
+        // from i), so a torn read shows up as a field mismatch.
+        auto producer = DragSampleChannel::create(2);
+        auto consumer = DragSampleChannel::attach(producer->memFd(), producer->doorbellFd());
+        QVERIFY(consumer);
+
+        constexpr int Samples = 200000;
+        std::atomic<bool> done{false};
+        std::thread writer([&] {
+            for (int i = 1; i <= Samples; ++i) {
+                producer->publish(makeSample(i));
+            }
+            done.store(true, std::memory_order_release);
+        });
+
+        quint64 lastSeq = 0;
+        bool consistent = true;
+        bool monotonic = true;
+        while (!done.load(std::memory_order_acquire)) {
+            DragSample out;
+            quint64 seq = 0;
+            if (!consumer->readLatest(out, &seq)) {
+                continue;
+            }
+            const int i = out.cursorX;
+            consistent = consistent && out.cursorY == -i && out.modifiers == i * 3 && out.mouseButtons == i * 7
+                && out.timestampNs == qint64(i) * 1000 && seq == quint64(i);
+            monotonic = monotonic && seq >= lastSeq;
+            lastSeq = seq;
+        }
+        writer.join();
+
+        QVERIFY(consistent);
+        QVERIFY(monotonic);
+        DragSample out;
+        QVERIFY(consumer->readLatest(out));
+        QCOMPARE(out.cursorX, Samples);
+    }
+};
+
+QTEST_GUILESS_MAIN(TestDragSampleChannel)
+#include "test_dragsamplechannel.moc"
@@ -120,6 +120,75 @@ private Q_SLOTS:
         QVERIFY(o.validationError().isEmpty());
     }
 
+    void testZoneHitSnapshotStableHit()
+    {
+        // Two side-by-side zones 5px apart, adjacency threshold 20.
+        ZoneHitSnapshot snap;
+        snap.adjacencyThreshold = 20;
+        snap.zones = {NamedZoneGeometry{QStringLiteral("a"), 0, 0, 100, 100},
+                      NamedZoneGeometry{QStringLiteral("b"), 105, 0, 100, 100}};
+
+        ZoneHitKey key;
+        QVERIFY(snap.stableHitAt(QPoint(30, 50), 2, key));
+        QCOMPARE(key.containing, QStringList{QStringLiteral("a")});
+        QCOMPARE(key.near, QStringList{QStringLiteral("a")});
+
+        // Inside a, within the threshold of b: both near, only a containing.
+        QVERIFY(snap.stableHitAt(QPoint(95, 50), 2, key));
+        QCOMPARE(key.containing, QStringList{QStringLiteral("a")});
+        QCOMPARE(key.near, (QStringList{QStringLiteral("a"), QStringLiteral("b")}));
+
+        // The same zones under two different points produce equal keys.
+        ZoneHitKey other;
+        QVERIFY(snap.stableHitAt(QPoint(30, 70), 2, other));
+        QVERIFY(snap.stableHitAt(QPoint(40, 40), 2, key));
+        QCOMPARE(key, other);
+    }
+
+    void testZoneHitSnapshotAmbiguousHits()
+    {
+        ZoneHitSnapshot snap;
+        snap.adjacencyThreshold = 20;
+        snap.zones = {NamedZoneGeometry{QStringLiteral("a"), 0, 0, 100, 100},
+                      NamedZoneGeometry{QStringLiteral("b"), 130, 0, 100, 100}};
+
+        ZoneHitKey key;
+        // On a's right edge: rounding could put it on either side.
+        QVERIFY(!snap.stableHitAt(QPoint(100, 50), 2, key));
+        // On b's threshold boundary.
+        QVERIFY(!snap.stableHitAt(QPoint(110, 50), 2, key));
+        // In the gap, near both: the daemon picks the closest by distance.
+        QVERIFY(!snap.stableHitAt(QPoint(115, 50), 2, key));
+    }
+
+    void testZoneHitSnapshotEmptyArea()
+    {
+        ZoneHitSnapshot snap;
+        snap.adjacencyThreshold = 20;
+        snap.zones = {NamedZoneGeometry{QStringLiteral("a"), 0, 0, 100, 100}};
+
+        // Far from every zone the daemon still snaps to the nearest one, and
+        // which zone that is depends on where the cursor is. Never stable.
+        ZoneHitKey key;
+        QVERIFY(!snap.stableHitAt(QPoint(500, 500), 2, key));
+    }
+
+    void testZoneHitSnapshotOverlapIsUnstable()
+    {
+        // A small zone on top of a large one: the daemon picks between them
+        // by distance to each centre, which varies inside the shared key.
+        ZoneHitSnapshot snap;
+        snap.adjacencyThreshold = 20;
+        snap.zones = {NamedZoneGeometry{QStringLiteral("background"), 0, 0, 400, 400},
+                      NamedZoneGeometry{QStringLiteral("inset"), 100, 100, 100, 100}};
+
+        ZoneHitKey key;
+        QVERIFY(!snap.stableHitAt(QPoint(150, 150), 2, key));
+        // Outside the inset's threshold only the background contains it.
+        QVERIFY(snap.stableHitAt(QPoint(320, 320), 2, key));
+        QCOMPARE(key.containing, QStringList{QStringLiteral("background")});
+    }
+
     void testBridgeRegistrationValidation()
     {
         BridgeRegistrationResult r;
@@ -248,9 +248,12 @@ public:
     }
 
     // Synchronous rescan — re-walks every search path on the calling
-    // stack and reconciles the Registry.
+    // stack and reconciles the Registry. Reparses every pack rather than
+    // reusing unchanged ones: a caller asking for a refresh is saying
+    // something the file stats cannot show has changed.
     void refresh()
     {
+        m_strategy->invalidateManifest();
         m_watcher->rescanNow();
     }
 
@@ -0,0 +1,15 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+// phosphor-shader-baker: one-shot bake helper spawned by ShaderCompiler on a
+// cache miss. See ShaderBakeService for the protocol.
+
+#include <PhosphorRendering/ShaderBakeService.h>
+
+#include <QCoreApplication>
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+    return PhosphorRendering::ShaderBakeService::runWorker(argc, argv);
+}
@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+#include <PhosphorRendering/phosphorrendering_export.h>
+
+#include <QString>
+
+namespace PhosphorRendering {
+
+/// Out-of-process bake workers for ShaderCompiler cache misses.
+///
+/// glslang is not reentrant, so in-process bakes serialize on one mutex and a
+/// cold cache (new Qt, cleared `phosphor-shadercache`, a new pack) bakes one
+/// shader at a time on one core. When the `phosphor-shader-baker` helper is
+/// installed, ShaderCompiler::compile() instead hands each miss to a short-lived
+/// helper process — each with its own glslang — and up to workerCount() of them
+/// run at once. The helper writes its result into the same content-addressed
+/// disk cache and streams it back on stdout, so a warm run is unchanged.
+///
+/// Anything that goes wrong on the worker path (no helper, spawn failure, a
+/// crash, a timeout) falls back to the in-process serialized bake; a genuine
+/// compile error from the helper is reported as-is.
+///
+/// Environment:
+/// - `PHOSPHOR_SHADER_BAKE_WORKERS=<n>` overrides the worker count; `0`
+///   disables the worker path.
+/// - `PHOSPHOR_SHADER_BAKE_HELPER=<path>` overrides the helper location
+///   (in-tree runs, tests).
+///
+/// @par Thread-safety
+/// All methods are safe to call from any thread.
+class PHOSPHORRENDERING_EXPORT ShaderBakeService
+{
+public:
+    /// Maximum concurrent helper processes. Defaults to the ideal thread count.
+    static int workerCount();
+    /// Override workerCount(); 0 disables the worker path for this process.
+    static void setWorkerCount(int count);
+
+    /// Absolute path of the helper executable, or empty when none was found.
+    /// Looked up once: the env override, then beside the running executable,
+    /// then the install location.
+    static QString helperPath();
+
+    /// True when misses will go to helper processes.
+    static bool isAvailable();
+
+    /// How many threads a caller should use to feed ShaderCompiler::compile()
+    /// misses: workerCount() with the worker path available, otherwise 1 —
+    /// more threads would only queue on the in-process bake mutex.
+    static int parallelism();
+
+    /// The helper's main(): bake one shader and exit. Reads the expanded
+    /// source from stdin, the stage from `--stage <n>` (a QShader::Stage
+    /// value) and `--spirv-only` for ShaderCompiler::Targets::SpirvOnly,
+    /// writes the serialized QShader to stdout and any compile error to
+    /// stderr. Returns the process exit code.
+    static int runWorker(int argc, char** argv);
+};
+
+} // namespace PhosphorRendering
@@ -17,14 +17,19 @@ namespace PhosphorRendering {
 /// Static utility for GLSL → SPIR-V compilation with include resolution and caching.
 ///
 /// Compilation results are cached by source hash to avoid redundant QShaderBaker
-/// invocations. The cache is in-memory only — cleared on process restart.
+/// invocations: a small in-memory LRU, backed by a content-addressed disk cache
+/// under `phosphor-shadercache/` (the user cache dir, then read-only prebaked
+/// copies under the data dirs).
 ///
 /// @par Thread-safety
 /// All methods are safe to call from any thread. Cache reads are lock-free for
-/// already-baked sources. Cache misses serialize on an internal bake mutex —
-/// QShaderBaker (glslang) is not reentrant, and concurrent bake() calls crash
-/// inside QSpirvCompiler::compileToSpirv(), so the mutex is load-bearing and
-/// must not be removed. loadAndExpand() is pure I/O and runs concurrently.
+/// already-baked sources, and concurrent misses on the same source bake once.
+/// Misses go to `phosphor-shader-baker` helper processes when one is installed
+/// (see ShaderBakeService), so distinct shaders bake in parallel. Without a
+/// helper they serialize on an internal bake mutex — QShaderBaker (glslang) is
+/// not reentrant, and concurrent bake() calls crash inside
+/// QSpirvCompiler::compileToSpirv(), so the mutex is load-bearing and must not
+/// be removed. loadAndExpand() is pure I/O and runs concurrently.
 class PHOSPHORRENDERING_EXPORT ShaderCompiler
 {
 public:
@@ -35,9 +40,17 @@ public:
         QString error;
     };
 
-    /// Compile GLSL source to QShader (SPIR-V 1.0 + GLSL 330 + ES 300/310/320).
-    /// Cached by source hash; second call with same source returns immediately.
-    static Result compile(const QByteArray& source, QShader::Stage stage);
+    /// Which variants a bake produces. SpirvOnly is for a source that reads
+    /// storage buffers (see kStorageBufferDefine).
+    enum class Targets {
+        All, ///< bakeTargets()
+        SpirvOnly, ///< SPIR-V 1.0 alone
+    };
+
+    /// Compile GLSL source to QShader (SPIR-V 1.0 + GLSL 330 + ES 300/310/320,
+    /// or SPIR-V only with Targets::SpirvOnly). Cached by source hash and
+    /// @p targets; second call with same source returns immediately.
+    static Result compile(const QByteArray& source, QShader::Stage stage, Targets targets = Targets::All);
 
     /// Load shader from file, expand #include directives, then compile.
     /// @param path         Path to .frag or .vert file
@@ -85,6 +98,18 @@ public:
 
     /// Bake target list: SPIR-V 1.0, GLSL 330, GLSL ES 300/310/320.
     static const QList<QShaderBaker::GeneratedShader>& bakeTargets();
+
+    /// Macro a source `#define`s to declare it reads storage buffers. Such a
+    /// source cannot translate to GLSL 330 or ES 300 at all, and ES 3.1/3.2 do
+    /// not guarantee fragment-stage storage blocks, so the caller that splices
+    /// it in also compiles with Targets::SpirvOnly, and must therefore only do
+    /// so on the Vulkan backend. compile() never looks for it in the source:
+    /// shared headers mention it, and a text match there would strip the GLSL
+    /// variants from every shader that includes them.
+    static constexpr const char* kStorageBufferDefine = "PHOSPHOR_STORAGE_BUFFERS";
+
+    /// Bake target list for @p targets: bakeTargets(), or SPIR-V 1.0 alone.
+    static const QList<QShaderBaker::GeneratedShader>& bakeTargetsFor(Targets targets);
 };
 
 } // namespace PhosphorRendering
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <PhosphorRendering/ShaderCompiler.h>
 #include <PhosphorRendering/phosphorrendering_export.h>
 
 #include <PhosphorShaders/BaseUniforms.h>
@@ -84,7 +85,8 @@ constexpr bool isConsumerBinding(int binding) noexcept
  * wallpaper, depth), and shader baking.
  *
  * Application-specific UBO data is appended via IUniformExtension.
- * Application-specific texture bindings use setExtraBinding() / removeExtraBinding().
+ * Application-specific texture bindings use setExtraBinding() / removeExtraBinding(),
+ * and read-only storage buffers use setExtraStorageBuffer().
  *
  * Uses QRhi and QShaderBaker (runtime SPIR-V + GLSL 330 bake). Requires Qt 6.6+
  * (commandBuffer(), renderTarget()).
@@ -227,6 +229,20 @@ public:
      * the SRB/pipeline is NOT rebuilt when nothing actually changed.
      */
     bool setExtraBinding(int binding, QRhiTexture* texture, QRhiSampler* sampler);
+    /**
+     * @brief Bind a consumer-owned storage buffer, read-only in the fragment
+     * stage, at the given binding number.
+     *
+     * Same range policy, same idempotence and same lifetime rule as
+     * setExtraBinding(): removeExtraBinding(binding) MUST run before the
+     * buffer is destroyed. @p offset and @p size select the span of @p buffer
+     * the binding exposes, so one buffer can back several bindings. The offset
+     * must respect the backend's storage-buffer offset alignment (256 covers
+     * every Vulkan implementation). The buffer must have been created with
+     * QRhiBuffer::StorageBuffer usage, and the caller is responsible for only
+     * doing this on a backend whose fragment stage can read storage buffers.
+     */
+    bool setExtraStorageBuffer(int binding, QRhiBuffer* buffer, quint32 offset, quint32 size);
     /// @return true if a binding existed at that slot and was removed.
     bool removeExtraBinding(int binding);
 
@@ -333,6 +349,24 @@ protected:
      */
     QRhi* safeRhi() const;
 
+    /**
+     * @brief Node-owned `#define` lines spliced ahead of the param preamble.
+     *
+     * For a subclass whose shader contract depends on what the node itself
+     * decides, such as ZoneShaderNodeRhi choosing storage buffers on Vulkan,
+     * rather than on anything the owning item knows. Applied by
+     * loadFragmentShader() exactly like setParamPreamble(), with the same
+     * consequence: it must be set before the load, and the bake-cache key
+     * covers `defines + preamble`, so a warm bake that wants the same cache
+     * entry passes that concatenation as its paramPreamble.
+     *
+     * @p targets is what the fragment stage is compiled for; a define that
+     * makes the source untranslatable to GLSL says so here (and the warm bake
+     * passes the same value as its fragmentTargets).
+     */
+    void setFragmentDefines(const QString& defines,
+                            ShaderCompiler::Targets targets = ShaderCompiler::Targets::All);
+
 private:
     bool ensurePipeline();
     bool ensureBufferPipeline();
@@ -354,8 +388,16 @@ private:
      * Append the extension region to a resource update batch.
      * @pre m_uniformExtension && m_uniformExtension->extensionSize() > 0
      * Reuses m_extensionStaging to avoid per-frame render-thread allocations.
+     * ExtensionUpload::Changed sends only the spans the extension reports via
+     * takeDirtyRanges(). ExtensionUpload::Whole is for the paths that must
+     * refresh everything: the first upload after (re)creating the UBO, and the
+     * defensive full-base fallback.
      */
-    void uploadExtensionToUbo(QRhiResourceUpdateBatch* batch);
+    enum class ExtensionUpload {
+        Whole,
+        Changed,
+    };
+    void uploadExtensionToUbo(QRhiResourceUpdateBatch* batch, ExtensionUpload mode);
     void releaseRhiResources();
     void appendUserTextureBindings(QVector<QRhiShaderResourceBinding>& bindings) const;
     void appendWallpaperBinding(QVector<QRhiShaderResourceBinding>& bindings) const;
@@ -418,6 +460,10 @@ private:
     /// extension's reported size changes (avoids a render-thread QByteArray
     /// allocation every frame that the extension is dirty).
     QByteArray m_extensionStaging;
+    /// Scratch for IUniformExtension::takeDirtyRanges(). An extension with
+    /// more changed spans than this reports a whole-region upload instead.
+    static constexpr int kMaxExtensionDirtyRanges = 16;
+    std::array<PhosphorShaders::IUniformExtension::DirtyRange, kMaxExtensionDirtyRanges> m_extensionDirtyRanges{};
 
     // ── Shader Include Paths ───────────────────────────────────────────
     QStringList m_shaderIncludePaths;
@@ -426,6 +472,11 @@ private:
     /// Spliced after `#version` into the fragment source at load time and
     /// fingerprinted into the bake-cache key. Empty = no-op.
     QString m_paramPreamble;
+    /// Subclass-owned defines spliced ahead of m_paramPreamble. See
+    /// setFragmentDefines(). Empty = no-op.
+    QString m_fragmentDefines;
+    /// Bake targets for the fragment stage, set with m_fragmentDefines.
+    ShaderCompiler::Targets m_fragmentTargets = ShaderCompiler::Targets::All;
 
     // ── Entry-point scaffold (T1.4) ────────────────────────────────────
     /// Prologue prepended (and candidate `main()` appended) to an entry-only
@@ -578,10 +629,15 @@ private:
     std::array<QColor, kMaxCustomColors> m_customColors;
 
     // ── Extra Bindings (consumer-managed) ──────────────────────────────
+    /// Either a texture + sampler pair (setExtraBinding) or a storage-buffer
+    /// span (setExtraStorageBuffer); `buffer` non-null selects the latter.
     struct ExtraBinding
     {
         QRhiTexture* texture = nullptr;
         QRhiSampler* sampler = nullptr;
+        QRhiBuffer* buffer = nullptr;
+        quint32 bufferOffset = 0;
+        quint32 bufferSize = 0;
     };
     // std::map (ordered) so SRB construction produces a deterministic binding
     // order regardless of insertion/erasure history. An unordered_map can
@@ -695,11 +751,15 @@ struct WarmShaderBakeResult
  *                        applied when the fragment defines no `main()`. MUST
  *                        match what `ShaderNodeRhi::loadFragmentShader` uses for
  *                        the same shader so warm + live agree on key and source.
+ * @param fragmentTargets Bake targets for the fragment stage. MUST match the
+ *                        live node's setFragmentDefines() targets whenever
+ *                        @p paramPreamble carries its defines.
  * @return success and error message for UI reporting
  */
 PHOSPHORRENDERING_EXPORT WarmShaderBakeResult warmShaderBakeCacheForPaths(
     const QString& vertexPath, const QString& fragmentPath, const QStringList& includePaths = {},
     const QString& paramPreamble = {}, const QString& entryPrologue = {},
-    const QList<PhosphorShaders::EntryCandidate>& entryCandidates = {});
+    const QList<PhosphorShaders::EntryCandidate>& entryCandidates = {},
+    ShaderCompiler::Targets fragmentTargets = ShaderCompiler::Targets::All);
 
 } // namespace PhosphorRendering
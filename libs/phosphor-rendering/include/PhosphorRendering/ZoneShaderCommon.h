@@ -19,6 +19,30 @@ namespace PhosphorRendering {
  */
 constexpr int MaxZones = 64;
 
+/**
+ * @brief Zone ceiling of the storage-buffer data path.
+ *
+ * On backends where ZoneShaderNodeRhi reads zone data from storage buffers
+ * (see ZoneShaderNodeRhi::zoneStorageAvailable), the four zone arrays live in
+ * one buffer, one kZoneStorageArrayBytes section each, instead of in the UBO.
+ * The UBO keeps its MaxZones arrays in both modes, because buffer passes and
+ * the vertex stage are not built with the storage define and still read them.
+ */
+constexpr int MaxStorageZones = 1024;
+
+/// One storage section: MaxStorageZones vec4s (std430 vec4 stride is 16).
+/// 16 KiB, which is a multiple of the 256-byte maximum Vulkan allows for
+/// minStorageBufferOffsetAlignment, so every section offset is bindable.
+inline constexpr int kZoneStorageArrayBytes = MaxStorageZones * 4 * static_cast<int>(sizeof(float));
+/// Whole storage buffer: rects, fill colours, border colours, params.
+inline constexpr int kZoneStorageBytes = 4 * kZoneStorageArrayBytes;
+/// Binding of the first section (zoneRects). The other three follow at +1..+3.
+/// Must match the `binding = ` qualifiers in data/overlays/shared/common.glsl.
+inline constexpr int kZoneStorageFirstBinding = 13;
+
+static_assert(kZoneStorageArrayBytes % 256 == 0, "storage sections must stay offset-aligned for every Vulkan driver");
+static_assert(MaxStorageZones >= MaxZones, "the storage path must hold at least what the UBO does");
+
 /**
  * @brief GPU uniform buffer layout — BaseUniforms + zone extension.
  *
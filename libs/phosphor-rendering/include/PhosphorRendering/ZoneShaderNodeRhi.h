@@ -8,15 +8,19 @@
 #include <PhosphorRendering/ZoneShaderCommon.h>
 #include <PhosphorRendering/phosphorrendering_export.h>
 
+#include <QByteArray>
 #include <QImage>
 #include <QQuickItem>
 
+#include <array>
 #include <memory>
 
 #include <rhi/qrhi.h>
 
 namespace PhosphorRendering {
 
+class ZoneUniformExtension;
+
 /**
  * @brief QSGRenderNode for zone overlay rendering, delegating to ShaderNodeRhi.
  *
@@ -26,11 +30,22 @@ namespace PhosphorRendering {
  * This subclass adds zone-specific state:
  * - Labels texture at binding 1 (via setExtraBinding)
  * - Zone count / highlighted count in BaseUniforms::appField0/appField1
+ * - On Vulkan, a zone storage buffer at bindings 13..16 (see below)
  *
  * Zone UBO data (rects, colors, params) is written by ZoneUniformExtension,
  * which the host item registers via ShaderEffect::setUniformExtension(). The
  * node does not hold a QVector<ZoneData> cache; it only reports counts to the
  * shader via setZoneCounts().
+ *
+ * @par Storage-buffer zone data
+ * When zoneStorageAvailable() holds, the node also owns one kZoneStorageBytes
+ * storage buffer, binds its four sections at kZoneStorageFirstBinding..+3, and
+ * splices zoneStorageDefines() into the fragment stage, which switches
+ * common.glsl to read the zone arrays from those bindings. That lifts the
+ * ceiling from MaxZones to MaxStorageZones. Only the spans the extension
+ * reports as changed are uploaded each frame. Everywhere else, the UBO arrays
+ * remain the only path. Buffer passes keep reading the UBO arrays in both
+ * modes, so they still see only the first MaxZones zones.
  */
 class PHOSPHORRENDERING_EXPORT ZoneShaderNodeRhi : public ShaderNodeRhi
 {
@@ -64,6 +79,51 @@ public:
      */
     void setZoneCounts(int total, int highlighted);
 
+    /**
+     * @brief Whether zone nodes in this process read zone data from storage
+     * buffers.
+     *
+     * True on the Vulkan backend. OpenGL keeps the UBO path: the bake targets
+     * there (GLSL 330, ES 300) cannot express storage buffers, and ES 3.1/3.2
+     * may expose none to the fragment stage. `PHOSPHOR_ZONE_STORAGE=0` forces
+     * the UBO path everywhere, which is how the two are compared.
+     *
+     * Static, and keyed on QQuickWindow::graphicsApi() rather than a live QRhi,
+     * so a warm bake that runs before any window exists makes the same choice
+     * a node will (see zoneStorageDefines()).
+     */
+    static bool zoneStorageAvailable();
+
+    /**
+     * @brief The fragment defines a storage-mode node splices ahead of its
+     * param preamble.
+     *
+     * A warm bake that should hit the same cache entry as a storage-mode node
+     * passes `zoneStorageDefines() + paramPreamble` as its preamble, and
+     * zoneStorageTargets() as its fragment targets, whenever
+     * zoneStorageAvailable() is true.
+     */
+    static QString zoneStorageDefines();
+
+    /// Fragment bake targets that go with zoneStorageDefines(): SPIR-V only.
+    static ShaderCompiler::Targets zoneStorageTargets()
+    {
+        return ShaderCompiler::Targets::SpirvOnly;
+    }
+
+    /// True when this node reads zone data from its storage buffer.
+    bool usesZoneStorage() const
+    {
+        return m_zoneStorage;
+    }
+
+    /// Most zones the shader can see on this node: MaxStorageZones in storage
+    /// mode, MaxZones otherwise. setZoneCounts() clamps to it.
+    int zoneCapacity() const
+    {
+        return m_zoneStorage ? MaxStorageZones : MaxZones;
+    }
+
     /**
      * @brief Stage the sparse zone-labels payload. Upload happens in prepare().
      *
@@ -84,6 +144,10 @@ private:
     /// in the screen-sized texture (and clearing vacated regions), so no
     /// full-screen CPU image is ever allocated.
     void uploadLabelsTexture(QRhi* rhi, QRhiCommandBuffer* cb);
+    /// Create the zone storage buffer on first use and upload the spans the
+    /// ZoneUniformExtension reports as changed (storage mode only).
+    void uploadZoneStorage(QRhi* rhi, QRhiCommandBuffer* cb);
+    void removeZoneStorageBindings();
 
     ZoneLabelTexture m_labels;
     /// Dest rects of the tiles uploaded last time, so the next upload can clear
@@ -108,6 +172,27 @@ private:
     // pattern; we mirror it here for the daemon's render path.
     int m_labelsInitFailureCount = 0;
     bool m_labelsInitGaveUp = false;
+
+    // ── Storage-buffer zone data ─────────────────────────────────────────
+    /// Fixed at construction from zoneStorageAvailable(); the fragment defines
+    /// spliced into the shader follow it.
+    bool m_zoneStorage = false;
+    std::unique_ptr<QRhiBuffer> m_zoneStorageBuffer;
+    /// CPU image of the buffer the extension copies changed spans into, so the
+    /// upload reads from memory the node owns. Sized on first use.
+    QByteArray m_zoneStorageStaging;
+    std::array<PhosphorShaders::IUniformExtension::DirtyRange, 16> m_zoneStorageRanges{};
+    /// The extension the buffer was last filled from. A different (or
+    /// replaced) extension means the buffer holds someone else's data, so the
+    /// next upload must be whole. Weak, so a freed-and-reallocated extension at
+    /// the same address cannot pass for the old one.
+    std::weak_ptr<const ZoneUniformExtension> m_zoneStorageSource;
+    /// Set when the buffer is (re)created with undefined contents, and only
+    /// cleared by a whole upload that sent at least one span.
+    bool m_zoneStorageNeedsFull = true;
+    /// Same give-up cap as the labels texture, for the same reason.
+    int m_zoneStorageInitFailureCount = 0;
+    bool m_zoneStorageInitGaveUp = false;
 };
 
 } // namespace PhosphorRendering
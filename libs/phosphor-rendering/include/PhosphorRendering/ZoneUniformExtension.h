@@ -9,9 +9,12 @@
 #include <QMutex>
 #include <QMutexLocker>
 #include <QtNumeric>
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <cmath>
 #include <cstring>
+#include <memory>
 
 namespace PhosphorRendering {
 
@@ -27,6 +30,20 @@ namespace PhosphorRendering {
  * The zone data layout matches the GLSL UBO declaration in common.glsl exactly,
  * and is binary-compatible with the zone region of ZoneShaderUniforms.
  *
+ * @par Change tracking
+ * updateFromZones() compares every entry it writes and records only the
+ * vec4s that actually changed, so takeDirtyRanges() hands the node a few
+ * 16-byte spans instead of the whole block. Moving the highlight from one
+ * zone to another changes two zoneParams entries (plus their colours, if the
+ * highlight recolours), which is what crosses the bus.
+ *
+ * @par Storage copy
+ * Alongside the UBO arrays the extension keeps the same four arrays sized for
+ * MaxStorageZones, laid out exactly like the storage buffer ZoneShaderNodeRhi
+ * binds on backends that support it, with its own change tracking read
+ * through takeStorageUpdate(). Zones past MaxZones exist only there. The UBO
+ * arrays are still maintained in that mode, since buffer passes read them.
+ *
  * @par Threading
  * write() runs on the render thread during prepare(); updateFromZones() runs
  * during the sync phase (updatePaintNode), which is ALSO the render thread,
@@ -49,6 +66,9 @@ public:
         // border width to 0, so a fresh overlay's first frames would render
         // square-cornered and border-less before the first setScale() lands.
         m_data = {};
+        // Zero-initialised like m_data. Heap-allocated because it is 64 KiB,
+        // too big to sit inline in an object a QML item holds by value.
+        m_storage = std::make_unique<ZoneStorageData>();
     }
 
     int extensionSize() const override
@@ -72,6 +92,48 @@ public:
         m_dirty.store(false, std::memory_order_release);
     }
 
+    int takeDirtyRanges(DirtyRange* out, int capacity) override
+    {
+        QMutexLocker lock(&m_mutex);
+        m_dirty.store(false, std::memory_order_release);
+        return m_uboRanges.take(out, capacity);
+    }
+
+    /**
+     * @brief Copy the changed parts of the storage copy out, for upload.
+     *
+     * @p dst is a kZoneStorageBytes buffer laid out like the GPU one. Every
+     * reported span is copied into it at its own offset, under the same lock
+     * that guards updateFromZones(), so a span and its bytes always agree.
+     *
+     * With @p everything set (a freshly created GPU buffer, whose contents are
+     * undefined), or when more spans changed than fit in @p capacity, reports
+     * the populated prefix of each of the four sections instead: every zone
+     * index ever written, so nothing the shader can index is left undefined.
+     * @p capacity must therefore be at least 4.
+     *
+     * @return the number of spans written to @p out, 0 when nothing changed.
+     */
+    int takeStorageUpdate(char* dst, DirtyRange* out, int capacity, bool everything)
+    {
+        QMutexLocker lock(&m_mutex);
+        int count = everything ? -1 : m_storageRanges.take(out, capacity);
+        if (count < 0) {
+            m_storageRanges.reset();
+            count = 0;
+            if (m_storageHighWater > 0 && capacity >= 4) {
+                for (int a = 0; a < 4; ++a) {
+                    out[count++] = DirtyRange{a * kZoneStorageArrayBytes, m_storageHighWater * kVec4Bytes};
+                }
+            }
+        }
+        const char* src = reinterpret_cast<const char*>(m_storage.get());
+        for (int i = 0; i < count; ++i) {
+            std::memcpy(dst + out[i].offset, src + out[i].offset, out[i].size);
+        }
+        return count;
+    }
+
     /// Update zone data from a vector of ZoneData. Called from the sync phase
     /// (updatePaintNode), which runs on the render thread with the GUI thread
     /// blocked. Mutex-guarded against a concurrent write() — see the class
@@ -79,32 +141,41 @@ public:
     void updateFromZones(const QVector<ZoneData>& zones)
     {
         QMutexLocker lock(&m_mutex);
-        for (int i = 0; i < MaxZones; ++i) {
-            if (i < zones.size()) {
+        // Zones past MaxStorageZones cannot be shown by either path. Slots
+        // between the new count and the previous one are zeroed, and nothing
+        // past the previous count can be non-zero, so the loop stops there.
+        const int count = std::min(static_cast<int>(zones.size()), MaxStorageZones);
+        const int touched = std::max(count, m_storageCount);
+        for (int i = 0; i < touched; ++i) {
+            float entry[4][4] = {};
+            if (i < count) {
                 const ZoneData& zone = zones[i];
-                m_data.zoneRects[i][0] = static_cast<float>(zone.rect.x());
-                m_data.zoneRects[i][1] = static_cast<float>(zone.rect.y());
-                m_data.zoneRects[i][2] = static_cast<float>(zone.rect.width());
-                m_data.zoneRects[i][3] = static_cast<float>(zone.rect.height());
-                m_data.zoneFillColors[i][0] = static_cast<float>(zone.fillColor.redF());
-                m_data.zoneFillColors[i][1] = static_cast<float>(zone.fillColor.greenF());
-                m_data.zoneFillColors[i][2] = static_cast<float>(zone.fillColor.blueF());
-                m_data.zoneFillColors[i][3] = static_cast<float>(zone.fillColor.alphaF());
-                m_data.zoneBorderColors[i][0] = static_cast<float>(zone.borderColor.redF());
-                m_data.zoneBorderColors[i][1] = static_cast<float>(zone.borderColor.greenF());
-                m_data.zoneBorderColors[i][2] = static_cast<float>(zone.borderColor.blueF());
-                m_data.zoneBorderColors[i][3] = static_cast<float>(zone.borderColor.alphaF());
-                m_data.zoneParams[i][0] = zone.borderRadius;
-                m_data.zoneParams[i][1] = zone.borderWidth;
-                m_data.zoneParams[i][2] = zone.isHighlighted ? 1.0f : 0.0f;
-                m_data.zoneParams[i][3] = static_cast<float>(zone.zoneNumber);
-            } else {
-                std::memset(m_data.zoneRects[i], 0, sizeof(m_data.zoneRects[i]));
-                std::memset(m_data.zoneFillColors[i], 0, sizeof(m_data.zoneFillColors[i]));
-                std::memset(m_data.zoneBorderColors[i], 0, sizeof(m_data.zoneBorderColors[i]));
-                std::memset(m_data.zoneParams[i], 0, sizeof(m_data.zoneParams[i]));
+                entry[0][0] = static_cast<float>(zone.rect.x());
+                entry[0][1] = static_cast<float>(zone.rect.y());
+                entry[0][2] = static_cast<float>(zone.rect.width());
+                entry[0][3] = static_cast<float>(zone.rect.height());
+                entry[1][0] = static_cast<float>(zone.fillColor.redF());
+                entry[1][1] = static_cast<float>(zone.fillColor.greenF());
+                entry[1][2] = static_cast<float>(zone.fillColor.blueF());
+                entry[1][3] = static_cast<float>(zone.fillColor.alphaF());
+                entry[2][0] = static_cast<float>(zone.borderColor.redF());
+                entry[2][1] = static_cast<float>(zone.borderColor.greenF());
+                entry[2][2] = static_cast<float>(zone.borderColor.blueF());
+                entry[2][3] = static_cast<float>(zone.borderColor.alphaF());
+                entry[3][0] = zone.borderRadius;
+                entry[3][1] = zone.borderWidth;
+                entry[3][2] = zone.isHighlighted ? 1.0f : 0.0f;
+                entry[3][3] = static_cast<float>(zone.zoneNumber);
+            }
+            for (int a = 0; a < 4; ++a) {
+                storeEntry(a, i, entry[a]);
             }
         }
+        m_storageCount = count;
+        m_storageHighWater = std::max(m_storageHighWater, count);
+        // Armed even when nothing changed, so isDirty() keeps meaning "an
+        // update arrived". The upload that follows takes zero ranges and sends
+        // nothing.
         m_dirty.store(true, std::memory_order_release);
     }
 
@@ -148,11 +219,93 @@ public:
             return true;
         }
         m_data.zoneScale = scale;
+        m_uboRanges.add(static_cast<int>(offsetof(ZoneExtensionData, zoneScale)), static_cast<int>(sizeof(float)));
         m_dirty.store(true, std::memory_order_release);
         return true;
     }
 
 private:
+    static constexpr int kVec4Bytes = static_cast<int>(4 * sizeof(float));
+
+    /// Changed spans, merged when they touch. Fixed capacity, so recording
+    /// never allocates. Recording past it latches "everything changed", which
+    /// take() reports as -1 (whole-region upload).
+    class DirtyRangeSet
+    {
+    public:
+        static constexpr int kCapacity = 12;
+
+        void add(int offset, int size)
+        {
+            if (m_overflow) {
+                return;
+            }
+            // Absorb every span the new one touches, then store the union once.
+            int lo = offset;
+            int hi = offset + size;
+            int kept = 0;
+            for (int i = 0; i < m_count; ++i) {
+                const DirtyRange r = m_ranges[i];
+                if (r.offset <= hi && lo <= r.offset + r.size) {
+                    lo = std::min(lo, r.offset);
+                    hi = std::max(hi, r.offset + r.size);
+                } else {
+                    m_ranges[kept++] = r;
+                }
+            }
+            if (kept == kCapacity) {
+                m_overflow = true;
+                m_count = 0;
+                return;
+            }
+            m_ranges[kept++] = DirtyRange{lo, hi - lo};
+            m_count = kept;
+        }
+
+        /// Copy the spans out and reset. -1 when overflowed or when they do
+        /// not fit in @p capacity.
+        int take(DirtyRange* out, int capacity)
+        {
+            const int count = (m_overflow || m_count > capacity) ? -1 : m_count;
+            for (int i = 0; i < count; ++i) {
+                out[i] = m_ranges[i];
+            }
+            reset();
+            return count;
+        }
+
+        void reset()
+        {
+            m_count = 0;
+            m_overflow = false;
+        }
+
+    private:
+        std::array<DirtyRange, kCapacity> m_ranges{};
+        int m_count = 0;
+        // Starts latched: the first upload after construction must be whole.
+        bool m_overflow = true;
+    };
+
+    /// Store one vec4 of array @p array (0 rects, 1 fill, 2 border, 3 params)
+    /// for zone @p zone in the storage copy and, below MaxZones, in the UBO
+    /// copy, recording a span in each only if the bytes changed.
+    void storeEntry(int array, int zone, const float (&value)[4])
+    {
+        float* stored = m_storage->arrays[array][zone];
+        if (std::memcmp(stored, value, sizeof(value)) == 0) {
+            return;
+        }
+        std::memcpy(stored, value, sizeof(value));
+        m_storageRanges.add(array * kZoneStorageArrayBytes + zone * kVec4Bytes, kVec4Bytes);
+        if (zone < MaxZones) {
+            float(*uboArrays[4])[4] = {m_data.zoneRects, m_data.zoneFillColors, m_data.zoneBorderColors,
+                                       m_data.zoneParams};
+            std::memcpy(uboArrays[array][zone], value, sizeof(value));
+            m_uboRanges.add((array * MaxZones + zone) * kVec4Bytes, kVec4Bytes);
+        }
+    }
+
     /// Raw zone extension data — matches the zone region of ZoneShaderUniforms exactly.
     struct alignas(16) ZoneExtensionData
     {
@@ -189,7 +342,22 @@ private:
     static_assert(sizeof(ZoneExtensionData) == sizeof(ZoneShaderUniforms) - sizeof(PhosphorShaders::BaseUniforms),
                   "ZoneExtensionData size must match ZoneShaderUniforms zone region size");
 
+    /// Byte image of ZoneShaderNodeRhi's storage buffer: four sections of
+    /// kZoneStorageArrayBytes, in the same order as the UBO arrays.
+    struct ZoneStorageData
+    {
+        float arrays[4][MaxStorageZones][4];
+    };
+    static_assert(sizeof(ZoneStorageData) == kZoneStorageBytes, "storage copy must match the GPU buffer byte for byte");
+
     ZoneExtensionData m_data;
+    std::unique_ptr<ZoneStorageData> m_storage;
+    DirtyRangeSet m_uboRanges;
+    DirtyRangeSet m_storageRanges;
+    /// Zones written by the last updateFromZones().
+    int m_storageCount = 0;
+    /// Most zones ever written, i.e. the storage prefix that holds defined data.
+    int m_storageHighWater = 0;
     mutable QMutex m_mutex;
     std::atomic<bool> m_dirty{true};
 };
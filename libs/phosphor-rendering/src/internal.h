@@ -11,6 +11,7 @@
  * limits for the multipass buffer system.
  */
 
+#include <PhosphorRendering/ShaderCompiler.h>
 #include <PhosphorRendering/ShaderNodeRhi.h>
 
 #include <QByteArray>
@@ -26,6 +27,14 @@ Q_DECLARE_LOGGING_CATEGORY(lcShaderNode)
 /// source-hash cache while the filename cache kept serving stale bakes.
 void clearFilenameShaderCache();
 
+/// Bake @p source for @p targets in a `phosphor-shader-baker` helper process (see
+/// ShaderBakeService), blocking until a worker slot is free and the helper
+/// exits. Returns true when the helper produced an answer — a shader, or a
+/// compile error in `result.error` — and false when the worker path is
+/// unavailable or failed, in which case the caller bakes in-process.
+bool bakeInWorker(const QByteArray& source, QShader::Stage stage, ShaderCompiler::Targets targets,
+                  ShaderCompiler::Result& result);
+
 /// Apply the T1.4 entry-point scaffold to a raw fragment source. Returns
 /// @p raw unchanged when @p candidates is empty or @p raw already defines
 /// `main()`; otherwise prepends @p prologue and appends the first matching
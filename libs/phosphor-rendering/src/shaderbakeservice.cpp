@@ -0,0 +1,255 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <PhosphorRendering/ShaderBakeService.h>
+#include <PhosphorRendering/ShaderCompiler.h>
+
+#include "internal.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QProcess>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+namespace PhosphorRendering {
+
+namespace {
+
+constexpr auto kHelperName = "phosphor-shader-baker";
+constexpr auto kSpirvOnlyArg = "--spirv-only";
+
+// A single bake is tens to hundreds of milliseconds; a helper still running
+// after this is wedged, and the in-process fallback gets a chance instead.
+constexpr int kWorkerTimeoutMs = 60000;
+
+// Exit codes of runWorker(). Anything but Baked / CompileError (a usage error,
+// a crash, a killed helper) is treated as "worker unavailable".
+enum WorkerExit : int {
+    Baked = 0,
+    CompileError = 1,
+    UsageError = 2,
+};
+
+// -1 = not yet resolved from the environment.
+std::atomic<int> s_workerCount{-1};
+
+int workerCountFromEnvironment()
+{
+    bool ok = false;
+    const int fromEnv = qEnvironmentVariableIntValue("PHOSPHOR_SHADER_BAKE_WORKERS", &ok);
+    if (ok) {
+        return qMax(0, fromEnv);
+    }
+    return qMax(1, QThread::idealThreadCount());
+}
+
+// Counting gate over concurrent helpers. Not a QSemaphore: the cap follows
+// setWorkerCount() at runtime, so it is re-read on every acquire.
+struct WorkerSlots
+{
+    QMutex mutex;
+    QWaitCondition freed;
+    int active = 0;
+
+    static WorkerSlots& instance()
+    {
+        static WorkerSlots s;
+        return s;
+    }
+
+    bool acquire()
+    {
+        QMutexLocker lock(&mutex);
+        for (;;) {
+            const int cap = ShaderBakeService::workerCount();
+            if (cap <= 0) {
+                return false;
+            }
+            if (active < cap) {
+                ++active;
+                return true;
+            }
+            freed.wait(&mutex);
+        }
+    }
+
+    void release()
+    {
+        QMutexLocker lock(&mutex);
+        --active;
+        freed.wakeOne();
+    }
+};
+
+} // namespace
+
+int ShaderBakeService::workerCount()
+{
+    int count = s_workerCount.load(std::memory_order_relaxed);
+    if (count < 0) {
+        // Racing first callers compute the same value; whichever store wins
+        // is fine, and a setWorkerCount() in between is not overwritten.
+        int expected = -1;
+        s_workerCount.compare_exchange_strong(expected, workerCountFromEnvironment());
+        count = s_workerCount.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+void ShaderBakeService::setWorkerCount(int count)
+{
+    s_workerCount.store(qMax(0, count), std::memory_order_relaxed);
+    // Waiters re-read the cap; wake them so a raised (or zeroed) limit
+    // takes effect without waiting for a running helper to finish.
+    auto& slots = WorkerSlots::instance();
+    QMutexLocker lock(&slots.mutex);
+    slots.freed.wakeAll();
+}
+
+QString ShaderBakeService::helperPath()
+{
+    static const QString path = [] {
+        const auto executable = [](const QString& candidate) {
+            const QFileInfo info(candidate);
+            return info.isFile() && info.isExecutable() ? info.absoluteFilePath() : QString();
+        };
+        if (const QString fromEnv = qEnvironmentVariable("PHOSPHOR_SHADER_BAKE_HELPER"); !fromEnv.isEmpty()) {
+            return executable(fromEnv);
+        }
+        // Beside the running executable first, so a build tree uses its own
+        // helper rather than an older installed one.
+        if (QCoreApplication::instance()) {
+            const QString local = executable(QCoreApplication::applicationDirPath() + QLatin1Char('/')
+                                             + QLatin1String(kHelperName));
+            if (!local.isEmpty()) {
+                return local;
+            }
+        }
+#ifdef PHOSPHORRENDERING_BAKE_HELPER
+        return executable(QStringLiteral(PHOSPHORRENDERING_BAKE_HELPER));
+#else
+        return QString();
+#endif
+    }();
+    return path;
+}
+
+bool ShaderBakeService::isAvailable()
+{
+    return workerCount() > 0 && !helperPath().isEmpty();
+}
+
+int ShaderBakeService::parallelism()
+{
+    return isAvailable() ? workerCount() : 1;
+}
+
+int ShaderBakeService::runWorker(int argc, char** argv)
+{
+    // A helper never spawns helpers of its own: its compile() bakes in-process
+    // (and writes the shared disk cache on the way).
+    setWorkerCount(0);
+
+    int stage = -1;
+    ShaderCompiler::Targets targets = ShaderCompiler::Targets::All;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--stage") == 0 && i + 1 < argc) {
+            bool ok = false;
+            stage = QByteArray(argv[i + 1]).toInt(&ok);
+            if (!ok) {
+                stage = -1;
+            }
+        } else if (std::strcmp(argv[i], kSpirvOnlyArg) == 0) {
+            targets = ShaderCompiler::Targets::SpirvOnly;
+        }
+    }
+    if (stage < QShader::VertexStage || stage > QShader::ComputeStage) {
+        std::fprintf(stderr, "usage: %s --stage <QShader::Stage> [%s] < source.glsl > shader.qsb\n", kHelperName,
+                     kSpirvOnlyArg);
+        return UsageError;
+    }
+
+    QFile in;
+    QFile out;
+    if (!in.open(stdin, QIODevice::ReadOnly) || !out.open(stdout, QIODevice::WriteOnly)) {
+        return UsageError;
+    }
+    const QByteArray source = in.readAll();
+
+    const ShaderCompiler::Result result = ShaderCompiler::compile(source, static_cast<QShader::Stage>(stage), targets);
+    if (!result.success) {
+        std::fputs(result.error.toLocal8Bit().constData(), stderr);
+        return CompileError;
+    }
+    const QByteArray blob = result.shader.serialized();
+    if (out.write(blob) != blob.size() || !out.flush()) {
+        return UsageError;
+    }
+    return Baked;
+}
+
+bool bakeInWorker(const QByteArray& source, QShader::Stage stage, ShaderCompiler::Targets targets,
+                  ShaderCompiler::Result& result)
+{
+    const QString helper = ShaderBakeService::helperPath();
+    if (helper.isEmpty()) {
+        return false;
+    }
+    auto& slots = WorkerSlots::instance();
+    if (!slots.acquire()) {
+        return false;
+    }
+
+    QProcess process;
+    // stderr carries the compile error only; keep it apart from the blob.
+    process.setProcessChannelMode(QProcess::SeparateChannels);
+    QStringList arguments{QStringLiteral("--stage"), QString::number(static_cast<int>(stage))};
+    if (targets == ShaderCompiler::Targets::SpirvOnly) {
+        arguments.append(QLatin1String(kSpirvOnlyArg));
+    }
+    process.start(helper, arguments);
+    bool finished = false;
+    if (process.waitForStarted()) {
+        process.write(source);
+        process.closeWriteChannel();
+        finished = process.waitForFinished(kWorkerTimeoutMs);
+        if (!finished) {
+            process.kill();
+            process.waitForFinished();
+        }
+    }
+    slots.release();
+
+    if (!finished || process.exitStatus() != QProcess::NormalExit) {
+        qCWarning(lcShaderNode) << "shader bake worker" << helper << "failed:" << process.errorString()
+                                << "— baking in-process";
+        return false;
+    }
+    switch (process.exitCode()) {
+    case Baked: {
+        QShader shader = QShader::fromSerialized(process.readAllStandardOutput());
+        if (!shader.isValid()) {
+            qCWarning(lcShaderNode) << "shader bake worker returned an unreadable shader — baking in-process";
+            return false;
+        }
+        result.shader = std::move(shader);
+        result.success = true;
+        return true;
+    }
+    case CompileError:
+        result.error = QString::fromLocal8Bit(process.readAllStandardError());
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // namespace PhosphorRendering
@@ -15,8 +15,11 @@
 #include <QMutex>
 #include <QMutexLocker>
 #include <QSaveFile>
+#include <QScopeGuard>
+#include <QSet>
 #include <QStandardPaths>
 #include <QTextStream>
+#include <QWaitCondition>
 
 #include <algorithm>
 #include <mutex>
@@ -40,6 +43,14 @@ const QList<QShaderBaker::GeneratedShader>& ShaderCompiler::bakeTargets()
     return targets;
 }
 
+const QList<QShaderBaker::GeneratedShader>& ShaderCompiler::bakeTargetsFor(Targets targets)
+{
+    static const QList<QShaderBaker::GeneratedShader> spirvOnly = {
+        {QShader::SpirvShader, QShaderVersion(100)},
+    };
+    return targets == Targets::SpirvOnly ? spirvOnly : bakeTargets();
+}
+
 // ═══════════════════════════════════════════════════════════════════════════════
 // Compilation Cache
 // ═══════════════════════════════════════════════════════════════════════════════
@@ -54,6 +65,8 @@ struct BakeCache
     // (deserialize), not a glslang re-bake. Kept small to bound resident memory
     // — a baked QShader carries SPIR-V + several GLSL variants.
     static constexpr int kMaxSize = 32;
+    // (source, stage | targets << 8): the same source baked for different
+    // target sets is a different shader.
     using Key = QPair<QByteArray, int>;
     QMutex mutex;
     // QCache provides LRU eviction (touched on object()), unlike a plain QHash
@@ -79,6 +92,23 @@ QMutex& bakeSerializationMutex()
     return m;
 }
 
+// Keys currently being baked. With bakes fanned out to worker processes, two
+// threads missing on the same shader (a zone warm-bake racing the render
+// thread's first prepare) would otherwise both pay for a bake; the second
+// instead waits here and picks the result up from the in-memory cache.
+struct InFlightBakes
+{
+    QMutex mutex;
+    QWaitCondition done;
+    QSet<BakeCache::Key> keys;
+
+    static InFlightBakes& instance()
+    {
+        static InFlightBakes s;
+        return s;
+    }
+};
+
 // ═══════════════════════════════════════════════════════════════════════════════
 // Persistent (on-disk) bake cache
 // ═══════════════════════════════════════════════════════════════════════════════
@@ -90,7 +120,7 @@ QMutex& bakeSerializationMutex()
 // disk cache: subsequent launches load SPIR-V/GLSL straight from disk and skip
 // glslang entirely.
 //
-// Key = SHA-256 of (stage byte ‖ fully-expanded source). Because the source
+// Key = SHA-256 of (stage byte ‖ [targets byte] ‖ fully-expanded source). Because the source
 // passed to compile() already has every #include inlined, an edit to a shader
 // OR any of its includes changes the digest, so the cache is self-invalidating —
 // no mtime tracking or explicit eviction on edit needed. Orphaned blobs from
@@ -104,6 +134,24 @@ QMutex& bakeSerializationMutex()
 
 constexpr int kMaxDiskCacheEntries = 512;
 
+// Versioned subdirectory shared by the user cache and the prebaked tier. The
+// QShader serialized format is Qt-version-bound. fromSerialized() already
+// rejects mismatches (→ treated as a miss + re-bake), but versioning the
+// directory by Qt version + a local schema tag keeps stale blobs from a prior
+// Qt from piling up indefinitely.
+QString diskCacheSubdir()
+{
+    return QLatin1String("phosphor-shadercache/qt") + QLatin1String(QT_VERSION_STR) + QLatin1String("-v1");
+}
+
+// PHOSPHOR_SHADER_CACHE_DIR replaces GenericCacheLocation as the base. The
+// package-time prebake points it at the install tree's data dir; bake workers
+// inherit it, so their writes land in the same place.
+bool diskCacheDirOverridden()
+{
+    return qEnvironmentVariableIsSet("PHOSPHOR_SHADER_CACHE_DIR");
+}
+
 // Cache directory, resolved + created once. Empty string = disk cache disabled
 // (unset/unwritable cache location, or the opt-out env var).
 QString diskCacheDir()
@@ -112,16 +160,13 @@ QString diskCacheDir()
         if (qEnvironmentVariableIsSet("PHOSPHOR_DISABLE_SHADER_DISK_CACHE")) {
             return QString();
         }
-        const QString base = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+        const QString base = diskCacheDirOverridden()
+            ? qEnvironmentVariable("PHOSPHOR_SHADER_CACHE_DIR")
+            : QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
         if (base.isEmpty()) {
             return QString();
         }
-        // The QShader serialized format is Qt-version-bound. fromSerialized()
-        // already rejects mismatches (→ treated as a miss + re-bake), but
-        // versioning the directory by Qt version + a local schema tag keeps
-        // stale blobs from a prior Qt from piling up indefinitely.
-        const QString d =
-            base + QLatin1String("/phosphor-shadercache/qt") + QLatin1String(QT_VERSION_STR) + QLatin1String("-v1");
+        const QString d = base + QLatin1Char('/') + diskCacheSubdir();
         if (!QDir().mkpath(d)) {
             qCWarning(lcShaderNode) << "shader disk cache: cannot create directory" << d << "— disk cache disabled";
             return QString();
@@ -131,17 +176,45 @@ QString diskCacheDir()
     return dir;
 }
 
-QString diskCachePath(const QByteArray& source, int stage)
+// Read-only tier below the user cache: blobs baked at package-install time
+// into <datadir>/phosphor-shadercache/qt<ver>-v1 (see plasmazones-shader-validate
+// --prebake). A fresh install or a new user then starts warm without ever
+// running glslang. Same content-addressed names, so a lookup is just a second
+// open(); the user dir is excluded in case the two coincide.
+//
+// Not consulted when PHOSPHOR_SHADER_CACHE_DIR is set: that is the prebake
+// filling its target, and a hit served from an already-installed tier would
+// never be written there, leaving the package short of those shaders. Memory
+// hits need no such care — everything in memory was read from or written to
+// the target first.
+const QStringList& prebakedCacheDirs()
+{
+    static const QStringList dirs = [] {
+        if (qEnvironmentVariableIsSet("PHOSPHOR_DISABLE_SHADER_DISK_CACHE") || diskCacheDirOverridden()) {
+            return QStringList();
+        }
+        QStringList found = QStandardPaths::locateAll(QStandardPaths::GenericDataLocation, diskCacheSubdir(),
+                                                      QStandardPaths::LocateDirectory);
+        found.removeAll(diskCacheDir());
+        return found;
+    }();
+    return dirs;
+}
+
+// Content-addressed blob name: hex SHA-256 of (stage byte ‖ expanded source).
+// A SPIR-V-only bake also hashes a targets byte; a full bake does not, so its
+// names (and every prebaked blob) stay what they were before target sets.
+QString diskCacheFileName(const QByteArray& source, int stage, ShaderCompiler::Targets targets)
 {
-    const QString dir = diskCacheDir();
-    if (dir.isEmpty()) {
-        return QString();
-    }
     QCryptographicHash hash(QCryptographicHash::Sha256);
     const char stageByte = static_cast<char>(stage);
     hash.addData(QByteArrayView(&stageByte, 1));
+    if (targets != ShaderCompiler::Targets::All) {
+        const char targetsByte = static_cast<char>(targets);
+        hash.addData(QByteArrayView(&targetsByte, 1));
+    }
     hash.addData(source);
-    return dir + QLatin1Char('/') + QString::fromLatin1(hash.result().toHex()) + QLatin1String(".qsb");
+    return QString::fromLatin1(hash.result().toHex()) + QLatin1String(".qsb");
 }
 
 // Bound disk growth: orphaned blobs only accrue when shaders are edited, so a
@@ -151,8 +224,10 @@ void pruneDiskCacheOnce()
 {
     static std::once_flag once;
     std::call_once(once, [] {
+        // An explicitly chosen directory (a prebake target) is managed by
+        // whoever chose it; trimming it would drop shaders the package ships.
         const QString dir = diskCacheDir();
-        if (dir.isEmpty()) {
+        if (dir.isEmpty() || diskCacheDirOverridden()) {
             return;
         }
         QFileInfoList blobs = QDir(dir).entryInfoList({QStringLiteral("*.qsb")}, QDir::Files, QDir::NoSort);
@@ -181,25 +256,39 @@ void pruneDiskCacheOnce()
 }
 
 // Returns a valid QShader on hit, an invalid one on miss / corrupt / version
-// mismatch (all treated identically: re-bake).
-QShader readDiskCache(const QString& path)
+// mismatch (all treated identically: re-bake). The user cache is consulted
+// first, then each prebaked tier.
+QShader readDiskCache(const QString& fileName)
 {
-    if (path.isEmpty()) {
-        return {};
+    const auto readFrom = [&fileName](const QString& dir) -> QShader {
+        if (dir.isEmpty()) {
+            return {};
+        }
+        QFile f(dir + QLatin1Char('/') + fileName);
+        if (!f.open(QIODevice::ReadOnly)) {
+            return {};
+        }
+        return QShader::fromSerialized(f.readAll());
+    };
+    if (QShader shader = readFrom(diskCacheDir()); shader.isValid()) {
+        return shader;
     }
-    QFile f(path);
-    if (!f.open(QIODevice::ReadOnly)) {
-        return {};
+    for (const QString& dir : prebakedCacheDirs()) {
+        if (QShader shader = readFrom(dir); shader.isValid()) {
+            return shader;
+        }
     }
-    return QShader::fromSerialized(f.readAll());
+    return {};
 }
 
-void writeDiskCache(const QString& path, const QShader& shader)
+void writeDiskCache(const QString& fileName, const QShader& shader)
 {
-    if (path.isEmpty()) {
+    const QString dir = diskCacheDir();
+    if (dir.isEmpty()) {
         return;
     }
     pruneDiskCacheOnce();
+    const QString path = dir + QLatin1Char('/') + fileName;
     // QSaveFile writes to a temp file and atomically renames on commit(), so a
     // concurrent reader (or another PlasmaZones process baking the same key)
     // never observes a partial blob; identical keys produce identical bytes, so
@@ -233,7 +322,7 @@ void writeDiskCache(const QString& path, const QShader& shader)
 // compile()
 // ═══════════════════════════════════════════════════════════════════════════════
 
-ShaderCompiler::Result ShaderCompiler::compile(const QByteArray& source, QShader::Stage stage)
+ShaderCompiler::Result ShaderCompiler::compile(const QByteArray& source, QShader::Stage stage, Targets targets)
 {
     Result result;
 
@@ -243,7 +332,7 @@ ShaderCompiler::Result ShaderCompiler::compile(const QByteArray& source, QShader
     }
 
     // Check cache
-    const BakeCache::Key key(source, static_cast<int>(stage));
+    const BakeCache::Key key(source, static_cast<int>(stage) | (static_cast<int>(targets) << 8));
     auto& cache = BakeCache::instance();
     {
         QMutexLocker lock(&cache.mutex);
@@ -256,15 +345,15 @@ ShaderCompiler::Result ShaderCompiler::compile(const QByteArray& source, QShader
         }
     }
 
-    // Persistent-cache check BEFORE taking the bake lock: a serialized QShader
-    // from a previous run skips glslang entirely, and the read is lock-free
-    // (writeDiskCache uses QSaveFile's atomic rename, so a reader sees a whole
-    // file or none). Keeping disk I/O off the bake mutex means a render-thread
-    // miss that resolves from disk never serializes behind a warm-bake thread's
-    // disk I/O. Populate the in-memory cache on a disk hit so repeat lookups
-    // this run stay hot.
-    const QString diskPath = diskCachePath(source, static_cast<int>(stage));
-    if (QShader fromDisk = readDiskCache(diskPath); fromDisk.isValid()) {
+    // Persistent-cache check BEFORE claiming the bake: a serialized QShader
+    // from a previous run (or a package prebake) skips glslang entirely, and
+    // the read is lock-free (writeDiskCache uses QSaveFile's atomic rename, so
+    // a reader sees a whole file or none). Keeping disk I/O off the bake path
+    // means a render-thread miss that resolves from disk never serializes
+    // behind a warm-bake thread. Populate the in-memory cache on a disk hit so
+    // repeat lookups this run stay hot.
+    const QString diskName = diskCacheFileName(source, static_cast<int>(stage), targets);
+    if (QShader fromDisk = readDiskCache(diskName); fromDisk.isValid()) {
         QMutexLocker cacheLock(&cache.mutex);
         cache.entries.insert(key, new QShader(fromDisk));
         result.shader = fromDisk;
@@ -272,24 +361,48 @@ ShaderCompiler::Result ShaderCompiler::compile(const QByteArray& source, QShader
         return result;
     }
 
-    // Disk miss — bake under the serialization mutex (glslang is not reentrant).
-    // The lock is held ONLY across the bake itself; disk I/O stays outside it.
+    // Claim the key. A concurrent caller already baking it finishes first;
+    // its result is then a memory-cache hit (a failed bake leaves nothing
+    // cached, and we retry it ourselves).
+    auto& inFlight = InFlightBakes::instance();
     {
-        QMutexLocker bakeLock(&bakeSerializationMutex());
-        // Double-check in-memory inside the lock so a concurrent caller that beat
-        // us to the bake (and already inserted) doesn't trigger a second one.
-        {
+        QMutexLocker flightLock(&inFlight.mutex);
+        while (inFlight.keys.contains(key)) {
+            inFlight.done.wait(&inFlight.mutex);
+        }
+        QMutexLocker cacheLock(&cache.mutex);
+        if (QShader* hit = cache.entries.object(key); hit && hit->isValid()) {
+            result.shader = *hit;
+            result.success = true;
+            return result;
+        }
+        inFlight.keys.insert(key);
+    }
+    const auto releaseClaim = qScopeGuard([&inFlight, &key] {
+        QMutexLocker flightLock(&inFlight.mutex);
+        inFlight.keys.remove(key);
+        inFlight.done.wakeAll();
+    });
+
+    // Preferred: a helper process with its own glslang, so distinct misses
+    // bake in parallel. The helper persists the blob to the shared disk cache
+    // itself; only the in-memory insert is left to do here.
+    if (bakeInWorker(source, stage, targets, result)) {
+        if (result.success) {
             QMutexLocker cacheLock(&cache.mutex);
-            if (QShader* hit = cache.entries.object(key); hit && hit->isValid()) {
-                result.shader = *hit;
-                result.success = true;
-                return result;
-            }
+            cache.entries.insert(key, new QShader(result.shader));
         }
+        return result;
+    }
 
+    // No worker — bake in-process under the serialization mutex (glslang is
+    // not reentrant). The lock is held ONLY across the bake itself; disk I/O
+    // stays outside it.
+    {
+        QMutexLocker bakeLock(&bakeSerializationMutex());
         QShaderBaker baker;
         baker.setGeneratedShaderVariants({QShader::StandardShader});
-        baker.setGeneratedShaders(bakeTargets());
+        baker.setGeneratedShaders(bakeTargetsFor(targets));
         baker.setSourceString(source, stage);
         result.shader = baker.bake();
 
@@ -308,7 +421,7 @@ ShaderCompiler::Result ShaderCompiler::compile(const QByteArray& source, QShader
     // makes concurrent writers harmless, and a failed write just means a future
     // re-bake, never a wrong result.
     if (result.success) {
-        writeDiskCache(diskPath, result.shader);
+        writeDiskCache(diskName, result.shader);
     }
 
     return result;
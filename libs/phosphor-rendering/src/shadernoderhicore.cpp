@@ -478,7 +478,8 @@ void ShaderNodeRhi::prepare()
         const QByteArray fragIncludeFp = includeFingerprint(m_fragmentIncludedPaths);
         const QByteArray entryFp = entryScaffoldFingerprint(m_entryPrologue, m_entryCandidates);
         const QByteArray cacheKey = shaderCacheKey(m_vertexPath, m_vertexMtime, vertIncludeFp, m_fragmentPath,
-                                                   m_fragmentMtime, fragIncludeFp, m_paramPreamble, entryFp);
+                                                   m_fragmentMtime, fragIncludeFp,
+                                                   m_fragmentDefines + m_paramPreamble, entryFp);
         if (!m_vertexPath.isEmpty() && !m_fragmentPath.isEmpty()) {
             QMutexLocker lock(&filenameShaderCacheMutex());
             auto& cache = filenameShaderCache();
@@ -510,7 +511,8 @@ void ShaderNodeRhi::prepare()
                 qCWarning(lcShaderNode) << "Shader compile failed for" << m_vertexPath << ":" << m_shaderError;
                 return;
             }
-            auto fragResult = ShaderCompiler::compile(m_fragmentShaderSource.toUtf8(), QShader::FragmentStage);
+            auto fragResult =
+                ShaderCompiler::compile(m_fragmentShaderSource.toUtf8(), QShader::FragmentStage, m_fragmentTargets);
             m_fragmentShader = fragResult.shader;
             if (!m_fragmentShader.isValid()) {
                 m_shaderError = QStringLiteral("Fragment shader: ")
@@ -839,7 +841,8 @@ void ShaderNodeRhi::releaseResources()
 WarmShaderBakeResult warmShaderBakeCacheForPaths(const QString& vertexPath, const QString& fragmentPath,
                                                  const QStringList& includePaths, const QString& paramPreamble,
                                                  const QString& entryPrologue,
-                                                 const QList<PhosphorShaders::EntryCandidate>& entryCandidates)
+                                                 const QList<PhosphorShaders::EntryCandidate>& entryCandidates,
+                                                 ShaderCompiler::Targets fragmentTargets)
 {
     WarmShaderBakeResult result;
     if (vertexPath.isEmpty() || fragmentPath.isEmpty()) {
@@ -892,7 +895,7 @@ WarmShaderBakeResult warmShaderBakeCacheForPaths(const QString& vertexPath, cons
             vertResult.error.isEmpty() ? QStringLiteral("Vertex shader bake failed") : vertResult.error;
         return result;
     }
-    auto fragResult = ShaderCompiler::compile(fragSource.toUtf8(), QShader::FragmentStage);
+    auto fragResult = ShaderCompiler::compile(fragSource.toUtf8(), QShader::FragmentStage, fragmentTargets);
     if (!fragResult.shader.isValid()) {
         result.errorMessage =
             fragResult.error.isEmpty() ? QStringLiteral("Fragment shader bake failed") : fragResult.error;
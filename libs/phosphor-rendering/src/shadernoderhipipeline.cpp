@@ -649,6 +649,12 @@ void ShaderNodeRhi::appendDepthBinding(QVector<QRhiShaderResourceBinding>& bindi
 void ShaderNodeRhi::appendExtraBindings(QVector<QRhiShaderResourceBinding>& bindings) const
 {
     for (const auto& [binding, extra] : m_extraBindings) {
+        if (extra.buffer) {
+            bindings.append(QRhiShaderResourceBinding::bufferLoad(binding, QRhiShaderResourceBinding::FragmentStage,
+                                                                  extra.buffer, extra.bufferOffset,
+                                                                  extra.bufferSize));
+            continue;
+        }
         if (!extra.texture || !extra.sampler)
             continue;
         bindings.append(QRhiShaderResourceBinding::sampledTexture(binding, QRhiShaderResourceBinding::FragmentStage,
@@ -286,7 +286,8 @@ bool ShaderNodeRhi::setExtraBinding(int binding, QRhiTexture* texture, QRhiSampl
     // steady-state rendering) would trigger a full pipeline rebuild on every
     // frame.
     auto it = m_extraBindings.find(binding);
-    if (it != m_extraBindings.end() && it->second.texture == texture && it->second.sampler == sampler) {
+    if (it != m_extraBindings.end() && !it->second.buffer && it->second.texture == texture
+        && it->second.sampler == sampler) {
         return true;
     }
     m_extraBindings[binding] = ExtraBinding{texture, sampler};
@@ -295,6 +296,35 @@ bool ShaderNodeRhi::setExtraBinding(int binding, QRhiTexture* texture, QRhiSampl
     return true;
 }
 
+bool ShaderNodeRhi::setExtraStorageBuffer(int binding, QRhiBuffer* buffer, quint32 offset, quint32 size)
+{
+    if (!isConsumerBinding(binding)) {
+        qCWarning(lcShaderNode) << "setExtraStorageBuffer: binding" << binding << "out of allowed range ("
+                                << kFirstFreeConsumerBinding << "or" << (kReservedBindingRangeEnd + 1) << "-"
+                                << kMaxConsumerBinding << ") — ignored";
+        return false;
+    }
+    if (!buffer || size == 0) {
+        qCWarning(lcShaderNode) << "setExtraStorageBuffer: binding" << binding << "given no buffer span — ignored";
+        return false;
+    }
+    // Same idempotence guard as setExtraBinding: a per-frame re-push of the
+    // same span must not rebuild every SRB and pipeline.
+    auto it = m_extraBindings.find(binding);
+    if (it != m_extraBindings.end() && it->second.buffer == buffer && it->second.bufferOffset == offset
+        && it->second.bufferSize == size) {
+        return true;
+    }
+    ExtraBinding extra;
+    extra.buffer = buffer;
+    extra.bufferOffset = offset;
+    extra.bufferSize = size;
+    m_extraBindings[binding] = extra;
+    m_extraBindingsDirty = true;
+    resetAllBindingsAndPipelines();
+    return true;
+}
+
 bool ShaderNodeRhi::removeExtraBinding(int binding)
 {
     auto it = m_extraBindings.find(binding);
@@ -663,7 +693,7 @@ bool ShaderNodeRhi::loadFragmentShader(const QString& path)
     // positions, isn't disturbed. Empty preamble = no-op (returns the source
     // unchanged). The preamble is folded into the bake-cache key below, so a
     // cache hit can never serve SPIR-V baked with a different preamble.
-    m_fragmentShaderSource = PhosphorShaders::spliceAfterVersion(expanded, m_paramPreamble);
+    m_fragmentShaderSource = PhosphorShaders::spliceAfterVersion(expanded, m_fragmentDefines + m_paramPreamble);
     m_fragmentPath = path;
     m_fragmentMtime = mtime;
     m_fragmentIncludedPaths = std::move(includedPaths);
@@ -766,6 +796,18 @@ void ShaderNodeRhi::setParamPreamble(const QString& preamble)
     m_shaderDirty = true;
 }
 
+void ShaderNodeRhi::setFragmentDefines(const QString& defines, ShaderCompiler::Targets targets)
+{
+    if (m_fragmentDefines == defines && m_fragmentTargets == targets) {
+        return;
+    }
+    m_fragmentDefines = defines;
+    m_fragmentTargets = targets;
+    // Same reload contract as setParamPreamble: spliced at load time and
+    // folded into the bake-cache key.
+    m_shaderDirty = true;
+}
+
 // ============================================================================
 // Normalize helpers (static)
 // ============================================================================
@@ -165,20 +165,40 @@ void ShaderNodeRhi::syncBaseUniforms(QRhi* rhi)
 //     when called repeatedly for the same extension.
 //   - Clears the extension's dirty bit (the extension's own isDirty() is
 //     the authoritative upload gate — there is no node-side mirror).
-//   - clearDirty() runs BEFORE write(): a GUI-thread setter landing between
-//     the two then re-arms the flag and the missed value uploads next frame.
-//     The old write-then-clear order silently dropped that setter's dirty
-//     bit, freezing its value until the next unrelated set.
-void ShaderNodeRhi::uploadExtensionToUbo(QRhiResourceUpdateBatch* batch)
+//   - takeDirtyRanges() (which clears the bit) runs BEFORE write(): a
+//     GUI-thread setter landing between the two then re-arms the flag and the
+//     missed value uploads next frame. The old write-then-clear order silently
+//     dropped that setter's dirty bit, freezing its value until the next
+//     unrelated set.
+//   - Ranges are taken even on a Whole upload, so spans recorded before a UBO
+//     recreation are not replayed against the freshly written buffer.
+//   - A range outside the region is an extension bug. Fall back to the whole
+//     region rather than trust any of that frame's ranges.
+void ShaderNodeRhi::uploadExtensionToUbo(QRhiResourceUpdateBatch* batch, ExtensionUpload mode)
 {
     const int extSize = m_uniformExtension->extensionSize();
     if (m_extensionStaging.size() != extSize) {
         m_extensionStaging.resize(extSize);
     }
-    m_uniformExtension->clearDirty();
+    const int rangeCount =
+        m_uniformExtension->takeDirtyRanges(m_extensionDirtyRanges.data(), kMaxExtensionDirtyRanges);
     m_uniformExtension->write(m_extensionStaging.data(), 0);
     const int extOffset = m_uboProfile->baseSize();
-    batch->updateDynamicBuffer(m_ubo.get(), extOffset, extSize, m_extensionStaging.constData());
+
+    bool whole = mode == ExtensionUpload::Whole || rangeCount < 0 || rangeCount > kMaxExtensionDirtyRanges;
+    for (int i = 0; !whole && i < rangeCount; ++i) {
+        const auto& r = m_extensionDirtyRanges[i];
+        whole = r.offset < 0 || r.size <= 0 || r.offset > extSize - r.size;
+    }
+    if (whole) {
+        batch->updateDynamicBuffer(m_ubo.get(), extOffset, extSize, m_extensionStaging.constData());
+        return;
+    }
+    for (int i = 0; i < rangeCount; ++i) {
+        const auto& r = m_extensionDirtyRanges[i];
+        batch->updateDynamicBuffer(m_ubo.get(), extOffset + r.offset, r.size,
+                                   m_extensionStaging.constData() + r.offset);
+    }
 }
 
 // ============================================================================
@@ -255,7 +275,7 @@ void ShaderNodeRhi::uploadDirtyTextures(QRhi* rhi, QRhiCommandBuffer* cb)
                 }
                 // Upload extension data if present
                 if (extensionHasData) {
-                    uploadExtensionToUbo(batch);
+                    uploadExtensionToUbo(batch, ExtensionUpload::Whole);
                 }
                 m_didFullUploadOnce = true;
             } else {
@@ -275,7 +295,7 @@ void ShaderNodeRhi::uploadDirtyTextures(QRhi* rhi, QRhiCommandBuffer* cb)
                 // doesn't re-upload it redundantly.
                 bool extensionUploaded = false;
                 if (extensionHasData && m_uniformExtension->isDirty()) {
-                    uploadExtensionToUbo(batch);
+                    uploadExtensionToUbo(batch, ExtensionUpload::Changed);
                     extensionUploaded = true;
                 }
                 // Defensive: if no granular flags set, do full base upload.
@@ -297,7 +317,7 @@ void ShaderNodeRhi::uploadDirtyTextures(QRhi* rhi, QRhiCommandBuffer* cb)
                                                    static_cast<const char*>(uboData) + r.offset);
                     }
                     if (extensionHasData && !extensionUploaded) {
-                        uploadExtensionToUbo(batch);
+                        uploadExtensionToUbo(batch, ExtensionUpload::Whole);
                     }
                 }
             }
@@ -318,7 +338,7 @@ void ShaderNodeRhi::uploadDirtyTextures(QRhi* rhi, QRhiCommandBuffer* cb)
         if (extensionHasData && m_uniformExtension->isDirty()) {
             batch = rhi->nextResourceUpdateBatch();
             if (batch)
-                uploadExtensionToUbo(batch);
+                uploadExtensionToUbo(batch, ExtensionUpload::Changed);
         }
         if (!m_vboUploaded) {
             if (!batch)
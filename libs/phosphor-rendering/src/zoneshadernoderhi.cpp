@@ -2,12 +2,16 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
 #include <PhosphorRendering/ZoneShaderNodeRhi.h>
+#include <PhosphorRendering/ShaderCompiler.h>
+#include <PhosphorRendering/ZoneUniformExtension.h>
 
 #include <QImage>
 #include <QList>
 #include <QLoggingCategory>
 #include <QPoint>
+#include <QQuickWindow>
 #include <QRect>
+#include <QSGRendererInterface>
 #include <QSize>
 
 #include <atomic>
@@ -38,6 +42,14 @@ ZoneShaderNodeRhi::ZoneShaderNodeRhi(QQuickItem* item)
     // The ZoneUniformExtension is owned by the host item and pushed down each
     // frame through ShaderEffect::syncBasePropertiesToNode(). No extension
     // allocation happens here.
+    //
+    // The storage decision is made once, here, because the defines it implies
+    // must be in place before the owning item's first loadFragmentShader(),
+    // which runs right after it creates the node.
+    m_zoneStorage = zoneStorageAvailable();
+    if (m_zoneStorage) {
+        setFragmentDefines(zoneStorageDefines(), zoneStorageTargets());
+    }
 }
 
 ZoneShaderNodeRhi::~ZoneShaderNodeRhi()
@@ -51,11 +63,27 @@ ZoneShaderNodeRhi::~ZoneShaderNodeRhi()
     // m_extraBindings always point to live resources" holds for the entire
     // teardown sequence.
     removeExtraBinding(1);
+    removeZoneStorageBindings();
+}
+
+bool ZoneShaderNodeRhi::zoneStorageAvailable()
+{
+    bool overridden = false;
+    const int forced = qEnvironmentVariableIntValue("PHOSPHOR_ZONE_STORAGE", &overridden);
+    if (overridden && forced == 0) {
+        return false;
+    }
+    return QQuickWindow::graphicsApi() == QSGRendererInterface::Vulkan;
+}
+
+QString ZoneShaderNodeRhi::zoneStorageDefines()
+{
+    return QStringLiteral("#define %1 1\n").arg(QLatin1String(ShaderCompiler::kStorageBufferDefine));
 }
 
 void ZoneShaderNodeRhi::setZoneCounts(int total, int highlighted)
 {
-    const int clampedTotal = qBound(0, total, MaxZones);
+    const int clampedTotal = qBound(0, total, zoneCapacity());
     const int clampedHighlighted = qBound(0, highlighted, clampedTotal);
     setAppField0(clampedTotal);
     setAppField1(clampedHighlighted);
@@ -274,16 +302,102 @@ void ZoneShaderNodeRhi::uploadLabelsTexture(QRhi* rhi, QRhiCommandBuffer* cb)
     m_labelsTextureDirty = false;
 }
 
+void ZoneShaderNodeRhi::removeZoneStorageBindings()
+{
+    for (int i = 0; i < 4; ++i) {
+        removeExtraBinding(kZoneStorageFirstBinding + i);
+    }
+}
+
+void ZoneShaderNodeRhi::uploadZoneStorage(QRhi* rhi, QRhiCommandBuffer* cb)
+{
+    constexpr int kMaxInitAttempts = 5;
+    if (m_zoneStorageInitGaveUp) {
+        return;
+    }
+
+    if (!m_zoneStorageBuffer) {
+        // Static, not Dynamic: QRhi does not allow Dynamic storage buffers.
+        // uploadStaticBuffer() takes an offset, which is all the per-span
+        // upload below needs.
+        std::unique_ptr<QRhiBuffer> buffer(
+            rhi->newBuffer(QRhiBuffer::Static, QRhiBuffer::StorageBuffer, kZoneStorageBytes));
+        if (!buffer->create()) {
+            ++m_zoneStorageInitFailureCount;
+            if (m_zoneStorageInitFailureCount >= kMaxInitAttempts) {
+                // The shader was built against bindings 13..16, so without the
+                // buffer its pipeline cannot be created and the overlay stays
+                // blank. PHOSPHOR_ZONE_STORAGE=0 selects the UBO path instead.
+                qCWarning(lcZoneShader) << "zone storage buffer init failed" << kMaxInitAttempts
+                                        << "times — giving up; the overlay will not render"
+                                        << "(PHOSPHOR_ZONE_STORAGE=0 falls back to the UBO path)";
+                m_zoneStorageInitGaveUp = true;
+            }
+            return;
+        }
+        m_zoneStorageBuffer = std::move(buffer);
+        m_zoneStorageInitFailureCount = 0;
+        m_zoneStorageNeedsFull = true;
+        // One buffer, four bindings: each section is one of the GLSL arrays.
+        for (int i = 0; i < 4; ++i) {
+            setExtraStorageBuffer(kZoneStorageFirstBinding + i, m_zoneStorageBuffer.get(),
+                                  static_cast<quint32>(i * kZoneStorageArrayBytes),
+                                  static_cast<quint32>(kZoneStorageArrayBytes));
+        }
+    }
+
+    const auto zoneExt = std::dynamic_pointer_cast<ZoneUniformExtension>(uniformExtension());
+    if (!zoneExt) {
+        // Nothing to show yet. The host pushes a zero zone count until it
+        // installs the extension, so the undefined buffer is never read.
+        return;
+    }
+    const bool everything = m_zoneStorageNeedsFull || m_zoneStorageSource.lock() != zoneExt;
+
+    // Acquire the batch BEFORE taking the spans: taking clears them, so a
+    // pool-exhaustion return after that would lose this frame's changes.
+    QRhiResourceUpdateBatch* batch = rhi->nextResourceUpdateBatch();
+    if (!batch) {
+        return;
+    }
+    if (m_zoneStorageStaging.size() != kZoneStorageBytes) {
+        m_zoneStorageStaging.resize(kZoneStorageBytes);
+    }
+    const int count = zoneExt->takeStorageUpdate(m_zoneStorageStaging.data(), m_zoneStorageRanges.data(),
+                                                 static_cast<int>(m_zoneStorageRanges.size()), everything);
+    for (int i = 0; i < count; ++i) {
+        const auto& r = m_zoneStorageRanges[i];
+        batch->uploadStaticBuffer(m_zoneStorageBuffer.get(), r.offset, r.size,
+                                  m_zoneStorageStaging.constData() + r.offset);
+    }
+    if (count > 0) {
+        cb->resourceUpdate(batch);
+    } else {
+        batch->release();
+    }
+    // A whole take before any zone was written (high-water mark 0) uploads
+    // nothing, so the buffer is still undefined; keep asking for a whole
+    // upload until one actually lands.
+    if (!everything || count > 0) {
+        m_zoneStorageNeedsFull = false;
+        m_zoneStorageSource = zoneExt;
+    }
+}
+
 void ZoneShaderNodeRhi::prepare()
 {
-    // Upload labels texture BEFORE parent's prepare(). The parent's
-    // ensurePipeline() will include our extra binding (labels at 1) in its
-    // SRB creation via appendExtraBindings().
+    // Upload labels texture (and, in storage mode, the zone storage buffer)
+    // BEFORE parent's prepare(). The parent's ensurePipeline() will include
+    // our extra bindings (labels at 1, zone storage at 13..16) in its SRB
+    // creation via appendExtraBindings().
     QRhiCommandBuffer* cb = commandBuffer();
     if (cb) {
         QRhi* rhi = cb->rhi();
         if (rhi) {
             uploadLabelsTexture(rhi, cb);
+            if (m_zoneStorage) {
+                uploadZoneStorage(rhi, cb);
+            }
         }
     }
 
@@ -308,6 +422,14 @@ void ZoneShaderNodeRhi::releaseResources()
     // drop the stale vacated-rect tracking from the old texture.
     m_prevTileRects.clear();
     removeExtraBinding(1);
+    // Bindings first, then the buffer, so the map never points at a freed
+    // QRhiBuffer. The recreated buffer starts undefined and gets a whole
+    // upload.
+    removeZoneStorageBindings();
+    m_zoneStorageBuffer.reset();
+    m_zoneStorageNeedsFull = true;
+    m_zoneStorageInitFailureCount = 0;
+    m_zoneStorageInitGaveUp = false;
 
     ShaderNodeRhi::releaseResources();
 }
@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <memory>
 #include <optional>
 
 #include "RuleAction.h"
@@ -19,6 +20,10 @@
 
 namespace PhosphorRules {
 
+namespace detail {
+class RuleMatchIndex;
+}
+
 /**
  * @brief The output of a resolution — the first action filling each slot.
  *
@@ -106,6 +111,15 @@ private:
  * computed once per rule-set revision and reused, so back-to-back resolves
  * against an unchanged set do not re-sort.
  *
+ * Sets of at least @ref kMatchIndexMinRules rules are additionally compiled,
+ * once per revision, into a candidate prefilter: exact-value hash tables for
+ * `Equals`, one Aho–Corasick automaton per field for the substring operators
+ * and `AppIdMatches`, and grouped alternations for `Regex` leaves. `resolve()`
+ * and `highestPriorityMatch()` then walk only the rules the prefilter cannot
+ * rule out — still in priority order, still through the full
+ * `MatchExpression::evaluate()`, so the verdict is identical to the plain
+ * walk.
+ *
  * `resolveCached()` adds a match cache keyed `(windowId, ruleSetRevision)`.
  * The cache is automatically bypassed/invalidated when the bound rule set's
  * revision changes; `clearCache()` forces invalidation for metadata-driven
@@ -131,7 +145,7 @@ private:
  * note). A rule set containing any `Regex` predicate must have all
  * `hasAnyMatch()` calls serialized. `resolve()`, `resolveCached()` and
  * `highestPriorityMatch()` mutate the lazily-built `mutable` priority-order
- * index (and, for `resolveCached()`, the `mutable` match cache);
+ * index and candidate prefilter (and, for `resolveCached()`, the `mutable` match cache);
  * `clearCache()` mutates only the match cache. All of these latter calls must
  * be externally serialized — both against each other and against
  * `hasAnyMatch()` (since concurrent rule-set mutation invalidates its read).
@@ -219,6 +233,10 @@ public:
     /// not a routine hot-path constraint.
     static constexpr int kMaxCacheEntries = 4096;
 
+    /// Smallest rule set that gets a compiled candidate prefilter. Below it
+    /// the plain priority walk is cheaper than consulting the index.
+    static constexpr int kMatchIndexMinRules = 32;
+
 private:
     const RuleSet& m_ruleSet;
 
@@ -247,6 +265,13 @@ private:
     mutable qsizetype m_priorityOrderRulesSize = 0;
     mutable bool m_priorityOrderValid = false;
     const QList<int>& priorityOrder() const;
+
+    /// Candidate prefilter over `m_priorityOrder`, rebuilt alongside it.
+    /// Null for sets below @ref kMatchIndexMinRules. Call after
+    /// `priorityOrder()` — it only reads the state that call validated.
+    mutable std::shared_ptr<const detail::RuleMatchIndex> m_matchIndex;
+    mutable bool m_matchIndexValid = false;
+    const detail::RuleMatchIndex* matchIndex() const;
 };
 
 } // namespace PhosphorRules
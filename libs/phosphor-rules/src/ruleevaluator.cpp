@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "rulelogging.h"
+#include "rulematchindex_p.h"
 
 namespace PhosphorRules {
 
@@ -70,9 +71,28 @@ const QList<int>& RuleEvaluator::priorityOrder() const
     m_priorityOrderRevision = revision;
     m_priorityOrderRulesSize = rules.size();
     m_priorityOrderValid = true;
+    // The prefilter is keyed on priority ranks — retire it with the order.
+    m_matchIndex.reset();
+    m_matchIndexValid = false;
     return m_priorityOrder;
 }
 
+const detail::RuleMatchIndex* RuleEvaluator::matchIndex() const
+{
+    if (m_matchIndexValid) {
+        return m_matchIndex.get();
+    }
+    const QList<Rule>& rules = m_ruleSet.rules();
+    if (rules.size() >= kMatchIndexMinRules) {
+        m_matchIndex = std::make_shared<const detail::RuleMatchIndex>(rules, m_priorityOrder);
+        qCDebug(lcRuleEval) << "match index built: revision:" << m_ruleSet.revision()
+                            << "guarded:" << m_matchIndex->guardedCount()
+                            << "unguarded:" << m_matchIndex->unguardedCount();
+    }
+    m_matchIndexValid = true;
+    return m_matchIndex.get();
+}
+
 ResolvedActions RuleEvaluator::resolve(const WindowQuery& query) const
 {
     ResolvedActions result;
@@ -87,8 +107,17 @@ ResolvedActions RuleEvaluator::resolve(const WindowQuery& query) const
     const QList<int>& order = priorityOrder();
     const ActionRegistry& registry = ActionRegistry::instance();
 
-    for (int index : order) {
-        const Rule& rule = rules.at(index);
+    // Walk only the prefilter's candidates (ranks into `order`, ascending) —
+    // or every rank when the set is too small to be indexed.
+    std::vector<int> candidates;
+    const detail::RuleMatchIndex* index = matchIndex();
+    if (index) {
+        index->candidates(query, candidates);
+    }
+    const qsizetype count = index ? qsizetype(candidates.size()) : order.size();
+
+    for (qsizetype i = 0; i < count; ++i) {
+        const Rule& rule = rules.at(order.at(index ? candidates[i] : i));
         if (!rule.enabled) {
             continue;
         }
@@ -149,9 +178,18 @@ const Rule* RuleEvaluator::highestPriorityMatch(const WindowQuery& query,
     // Descending priority; ties broken by original list order (first wins).
     // The cached priority order encodes exactly that — walk it and return the
     // first qualifying rule so the tie-break matches resolve()'s walk.
+    // The prefilter's candidate ranks preserve that order.
     const QList<Rule>& rules = m_ruleSet.rules();
-    for (int index : priorityOrder()) {
-        const Rule& rule = rules.at(index);
+    const QList<int>& order = priorityOrder();
+    std::vector<int> candidates;
+    const detail::RuleMatchIndex* index = matchIndex();
+    if (index) {
+        index->candidates(query, candidates);
+    }
+    const qsizetype count = index ? qsizetype(candidates.size()) : order.size();
+
+    for (qsizetype i = 0; i < count; ++i) {
+        const Rule& rule = rules.at(order.at(index ? candidates[i] : i));
         if (!rule.enabled) {
             continue;
         }
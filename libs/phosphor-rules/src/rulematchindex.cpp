@@ -0,0 +1,442 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "rulematchindex_p.h"
+
+#include <PhosphorRules/MatchExpression.h>
+
+#include <algorithm>
+#include <deque>
+
+namespace PhosphorRules {
+namespace detail {
+
+namespace {
+
+/// Per-unit simple case fold — the same folding QString's Qt::CaseInsensitive
+/// compare / contains / startsWith / endsWith apply to BMP text, so a folded
+/// key compares equal exactly when the case-insensitive operation would.
+QString foldCase(QStringView text)
+{
+    QString out(text.size(), Qt::Uninitialized);
+    QChar* dst = out.data();
+    for (qsizetype i = 0; i < text.size(); ++i) {
+        dst[i] = text[i].toCaseFolded();
+    }
+    return out;
+}
+
+bool isAscii(QStringView text)
+{
+    return std::all_of(text.begin(), text.end(), [](QChar c) {
+        return c.unicode() < 128;
+    });
+}
+
+bool hasSurrogates(QStringView text)
+{
+    return std::any_of(text.begin(), text.end(), [](QChar c) {
+        return c.isSurrogate();
+    });
+}
+
+/// True if @p pattern keeps its meaning when wrapped as one `(?:…)` branch
+/// of a larger alternation. Conservative: anything that depends on group
+/// numbering (back-references, recursion, conditionals), quoting that could
+/// swallow the closing parenthesis, extended-mode comments, or leading
+/// verbs is rejected and the rule stays unguarded instead.
+bool isGroupableRegex(QStringView pattern)
+{
+    const qsizetype n = pattern.size();
+    for (qsizetype i = 0; i < n; ++i) {
+        const QChar c = pattern[i];
+        if (c == QLatin1Char('\\')) {
+            if (i + 1 < n) {
+                const QChar next = pattern[i + 1];
+                if (next.isDigit() || next == QLatin1Char('g') || next == QLatin1Char('k') || next == QLatin1Char('Q')
+                    || next == QLatin1Char('E')) {
+                    return false;
+                }
+            }
+            ++i;
+            continue;
+        }
+        if (c != QLatin1Char('(') || i + 1 >= n) {
+            continue;
+        }
+        if (pattern[i + 1] == QLatin1Char('*')) {
+            return false;
+        }
+        if (pattern[i + 1] != QLatin1Char('?')) {
+            continue;
+        }
+        if (i + 2 >= n) {
+            return false;
+        }
+        const QChar kind = pattern[i + 2];
+        if (kind == QLatin1Char(':') || kind == QLatin1Char('=') || kind == QLatin1Char('!')) {
+            continue;
+        }
+        if (kind == QLatin1Char('<') && i + 3 < n
+            && (pattern[i + 3] == QLatin1Char('=') || pattern[i + 3] == QLatin1Char('!'))) {
+            continue;
+        }
+        // Inline option group — (?i) (?-s) (?m:…). `x` is excluded: its `#`
+        // comments run to end of line and would eat the group's `)`.
+        qsizetype j = i + 2;
+        while (j < n && QLatin1StringView("imsU-").contains(pattern[j])) {
+            ++j;
+        }
+        if (j > i + 2 && j < n && (pattern[j] == QLatin1Char(':') || pattern[j] == QLatin1Char(')'))) {
+            continue;
+        }
+        return false;
+    }
+    return true;
+}
+
+enum class KeyKind {
+    Exact,
+    Literal,
+    Regex,
+};
+
+struct GuardKey
+{
+    Field field;
+    KeyKind kind;
+    QString text; ///< folded for Exact / Literal, verbatim for Regex
+};
+
+/// A necessary condition for one expression: unguarded (always a candidate)
+/// or guarded by a disjunction of keys. Guarded with no keys means the
+/// expression can never match.
+struct Guard
+{
+    bool guarded = false;
+    QList<GuardKey> keys;
+
+    static Guard unguarded()
+    {
+        return Guard{};
+    }
+    static Guard never()
+    {
+        return Guard{true, {}};
+    }
+
+    /// Rough per-query cost of testing this guard — used to pick the
+    /// cheapest child of an `All{}`.
+    int cost() const
+    {
+        int total = 0;
+        for (const GuardKey& key : keys) {
+            total += key.kind == KeyKind::Exact ? 1 : key.kind == KeyKind::Literal ? 2 : 8;
+        }
+        return total;
+    }
+};
+
+Guard leafGuard(const MatchExpression::Predicate& predicate)
+{
+    // Non-string leaves have no index — bool / int compares are already cheap.
+    if (!fieldIsString(predicate.field)) {
+        return Guard::unguarded();
+    }
+    const QString text = predicate.value.toString();
+    const Field field = predicate.field;
+
+    switch (predicate.op) {
+    case Operator::Equals:
+        if (hasSurrogates(text)) {
+            return Guard::unguarded();
+        }
+        return Guard{true, {GuardKey{field, KeyKind::Exact, foldCase(text)}}};
+    case Operator::Contains:
+    case Operator::StartsWith:
+    case Operator::EndsWith:
+        // Mirrors stringMatch: an empty pattern never matches.
+        if (text.isEmpty()) {
+            return Guard::never();
+        }
+        if (!isAscii(text)) {
+            return Guard::unguarded();
+        }
+        return Guard{true, {GuardKey{field, KeyKind::Literal, foldCase(text)}}};
+    case Operator::AppIdMatches: {
+        if (text.isEmpty()) {
+            return Guard::never();
+        }
+        if (!isAscii(text)) {
+            return Guard::unguarded();
+        }
+        // Forward directions (equal, trailing segment, last-segment prefix)
+        // all put the pattern inside the subject.
+        Guard guard{true, {GuardKey{field, KeyKind::Literal, foldCase(text)}}};
+        // Reverse trailing segment: the subject IS some dot-suffix of the pattern.
+        for (qsizetype dot = text.indexOf(QLatin1Char('.')); dot >= 0;
+             dot = text.indexOf(QLatin1Char('.'), dot + 1)) {
+            if (dot + 1 < text.size()) {
+                guard.keys.append(GuardKey{field, KeyKind::Exact, foldCase(QStringView(text).mid(dot + 1))});
+            }
+        }
+        // Reverse last-segment prefix: the subject IS a ≥5-char strict prefix
+        // of the pattern's last segment.
+        const qsizetype lastDot = text.lastIndexOf(QLatin1Char('.'));
+        if (lastDot >= 0) {
+            const QStringView lastSegment = QStringView(text).mid(lastDot + 1);
+            for (qsizetype len = 5; len < lastSegment.size(); ++len) {
+                guard.keys.append(GuardKey{field, KeyKind::Exact, foldCase(lastSegment.left(len))});
+            }
+        }
+        return guard;
+    }
+    case Operator::Regex: {
+        // Same compile MatchExpression::ensureRegex performs — an invalid
+        // program never matches.
+        const QRegularExpression regex(text, QRegularExpression::CaseInsensitiveOption);
+        if (!regex.isValid()) {
+            return Guard::never();
+        }
+        if (!isGroupableRegex(text)) {
+            return Guard::unguarded();
+        }
+        return Guard{true, {GuardKey{field, KeyKind::Regex, text}}};
+    }
+    case Operator::GreaterThan:
+    case Operator::LessThan:
+        return Guard::never();
+    }
+    return Guard::unguarded();
+}
+
+Guard guardFor(const MatchExpression& expr)
+{
+    switch (expr.kind()) {
+    case MatchExpression::Kind::Leaf:
+        return leafGuard(expr.predicate());
+    case MatchExpression::Kind::All: {
+        // Every child must match, so any one child's guard is necessary for
+        // the whole — keep the cheapest. Empty All{} (catch-all) is unguarded.
+        Guard best = Guard::unguarded();
+        for (const MatchExpression& child : expr.children()) {
+            Guard guard = guardFor(child);
+            if (guard.guarded && (!best.guarded || guard.cost() < best.cost())) {
+                best = std::move(guard);
+            }
+        }
+        return best;
+    }
+    case MatchExpression::Kind::Any: {
+        // Some child must match — the union of the children's guards, which
+        // is only a guard if every child has one. Empty Any{} never matches.
+        Guard combined = Guard::never();
+        for (const MatchExpression& child : expr.children()) {
+            const Guard guard = guardFor(child);
+            if (!guard.guarded) {
+                return Guard::unguarded();
+            }
+            combined.keys.append(guard.keys);
+        }
+        return combined;
+    }
+    case MatchExpression::Kind::None:
+        return Guard::unguarded();
+    }
+    return Guard::unguarded();
+}
+
+} // namespace
+
+// ── LiteralAutomaton ────────────────────────────────────────────────────
+
+LiteralAutomaton::LiteralAutomaton()
+{
+    std::fill(std::begin(m_rootEdges), std::end(m_rootEdges), -1);
+    m_nodes.emplace_back();
+}
+
+int LiteralAutomaton::step(int state, char16_t ch) const
+{
+    if (state == 0) {
+        return m_rootEdges[ch];
+    }
+    for (const auto& [edge, target] : m_nodes[state].edges) {
+        if (edge == ch) {
+            return target;
+        }
+    }
+    return -1;
+}
+
+int LiteralAutomaton::add(const QString& literal)
+{
+    int state = 0;
+    for (const QChar c : literal) {
+        const char16_t ch = c.unicode();
+        Q_ASSERT(ch < 128);
+        int next = step(state, ch);
+        if (next < 0) {
+            next = int(m_nodes.size());
+            m_nodes.emplace_back();
+            if (state == 0) {
+                m_rootEdges[ch] = next;
+            } else {
+                m_nodes[state].edges.emplace_back(ch, next);
+            }
+        }
+        state = next;
+    }
+    if (m_nodes[state].literal < 0) {
+        m_nodes[state].literal = m_literalCount++;
+    }
+    return m_nodes[state].literal;
+}
+
+void LiteralAutomaton::build()
+{
+    // Breadth-first so a node's failure target (always shallower) is final
+    // before the node itself is linked.
+    std::deque<int> queue;
+    for (int ch = 0; ch < 128; ++ch) {
+        if (m_rootEdges[ch] >= 0) {
+            m_nodes[m_rootEdges[ch]].fail = 0;
+            queue.push_back(m_rootEdges[ch]);
+        }
+    }
+    while (!queue.empty()) {
+        const int state = queue.front();
+        queue.pop_front();
+        for (const auto& [ch, child] : m_nodes[state].edges) {
+            int fail = m_nodes[state].fail;
+            while (fail != 0 && step(fail, ch) < 0) {
+                fail = m_nodes[fail].fail;
+            }
+            const int target = step(fail, ch);
+            Node& node = m_nodes[child];
+            node.fail = target < 0 ? 0 : target;
+            const Node& failNode = m_nodes[node.fail];
+            node.outputLink = failNode.literal >= 0 ? node.fail : failNode.outputLink;
+            queue.push_back(child);
+        }
+    }
+}
+
+// ── RuleMatchIndex ──────────────────────────────────────────────────────
+
+RuleMatchIndex::RuleMatchIndex(const QList<Rule>& rules, const QList<int>& order)
+{
+    m_fields.resize(FieldCount);
+
+    // Regex leaves are collected first and grouped once every rule is seen.
+    std::vector<std::vector<std::pair<QString, int>>> regexLeaves(FieldCount);
+
+    for (int rank = 0; rank < order.size(); ++rank) {
+        const Rule& rule = rules.at(order.at(rank));
+        if (!rule.enabled) {
+            continue;
+        }
+        const Guard guard = guardFor(rule.match);
+        if (!guard.guarded) {
+            m_unguarded.push_back(rank);
+            continue;
+        }
+        ++m_guardedCount;
+        for (const GuardKey& key : guard.keys) {
+            FieldIndex& index = m_fields[static_cast<int>(key.field)];
+            index.used = true;
+            switch (key.kind) {
+            case KeyKind::Exact:
+                index.exact[key.text].push_back(rank);
+                break;
+            case KeyKind::Literal: {
+                const int id = index.literals.add(key.text);
+                if (id >= int(index.literalRanks.size())) {
+                    index.literalRanks.resize(id + 1);
+                }
+                index.literalRanks[id].push_back(rank);
+                break;
+            }
+            case KeyKind::Regex:
+                regexLeaves[static_cast<int>(key.field)].emplace_back(key.text, rank);
+                break;
+            }
+        }
+    }
+
+    for (int f = 0; f < FieldCount; ++f) {
+        FieldIndex& index = m_fields[f];
+        index.literals.build();
+
+        const auto& leaves = regexLeaves[f];
+        for (size_t begin = 0; begin < leaves.size(); begin += kRegexGroupSize) {
+            const size_t end = std::min(leaves.size(), begin + size_t(kRegexGroupSize));
+            QStringList branches;
+            RegexGroup group;
+            for (size_t i = begin; i < end; ++i) {
+                branches.append(QLatin1String("(?:") + leaves[i].first + QLatin1Char(')'));
+                group.ranks.push_back(leaves[i].second);
+            }
+            group.regex =
+                QRegularExpression(branches.join(QLatin1Char('|')), QRegularExpression::CaseInsensitiveOption);
+            // isValid() compiles — do it here, not on the first query. A group
+            // that still fails (e.g. a resource limit) just stops filtering.
+            if (!group.regex.isValid()) {
+                m_unguarded.insert(m_unguarded.end(), group.ranks.begin(), group.ranks.end());
+                continue;
+            }
+            index.regexGroups.push_back(std::move(group));
+        }
+    }
+
+    std::sort(m_unguarded.begin(), m_unguarded.end());
+    m_unguarded.erase(std::unique(m_unguarded.begin(), m_unguarded.end()), m_unguarded.end());
+}
+
+void RuleMatchIndex::candidates(const WindowQuery& query, std::vector<int>& ranks) const
+{
+    ranks.assign(m_unguarded.begin(), m_unguarded.end());
+
+    std::vector<char> literalSeen;
+    for (int f = 0; f < FieldCount; ++f) {
+        const FieldIndex& index = m_fields[f];
+        if (!index.used) {
+            continue;
+        }
+        // An absent field fails every leaf over it — nothing keyed here can match.
+        const std::optional<QVariant> value = query.valueForField(static_cast<Field>(f));
+        if (!value) {
+            continue;
+        }
+        const QString subject = value->toString();
+
+        if (!index.exact.isEmpty() || !index.literals.isEmpty()) {
+            const QString folded = foldCase(subject);
+            const auto exact = index.exact.constFind(folded);
+            if (exact != index.exact.constEnd()) {
+                ranks.insert(ranks.end(), exact->begin(), exact->end());
+            }
+            if (!index.literals.isEmpty()) {
+                literalSeen.assign(index.literalRanks.size(), 0);
+                index.literals.scan(folded, [&](int id) {
+                    if (!literalSeen[id]) {
+                        literalSeen[id] = 1;
+                        ranks.insert(ranks.end(), index.literalRanks[id].begin(), index.literalRanks[id].end());
+                    }
+                });
+            }
+        }
+
+        for (const RegexGroup& group : index.regexGroups) {
+            if (group.regex.match(subject).hasMatch()) {
+                ranks.insert(ranks.end(), group.ranks.begin(), group.ranks.end());
+            }
+        }
+    }
+
+    std::sort(ranks.begin(), ranks.end());
+    ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+}
+
+} // namespace detail
+} // namespace PhosphorRules
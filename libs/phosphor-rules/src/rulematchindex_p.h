@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Private (non-installed) header — the compiled candidate prefilter behind
+// RuleEvaluator's priority walk. Built once per rule-set revision; see
+// RuleMatchIndex below.
+
+#pragma once
+
+#include <PhosphorRules/Rule.h>
+#include <PhosphorRules/WindowQuery.h>
+
+#include <QHash>
+#include <QList>
+#include <QRegularExpression>
+#include <QString>
+
+#include <vector>
+
+namespace PhosphorRules {
+namespace detail {
+
+/**
+ * @brief Aho–Corasick automaton over case-folded ASCII literals.
+ *
+ * Finds every inserted literal occurring anywhere in a subject in one pass,
+ * independent of the literal count. Only ASCII literals are accepted (see
+ * RuleMatchIndex for why), so any non-ASCII subject unit simply resets the
+ * automaton to its root.
+ */
+class LiteralAutomaton
+{
+public:
+    LiteralAutomaton();
+
+    /// Add @p literal (already case-folded, ASCII, non-empty) and return its
+    /// id. Re-adding an existing literal returns the original id.
+    int add(const QString& literal);
+
+    /// Compute failure and output links. Call once after the last add().
+    void build();
+
+    bool isEmpty() const
+    {
+        return m_literalCount == 0;
+    }
+
+    /// Invoke @p hit(literalId) for every literal occurrence in @p folded.
+    template<typename Hit>
+    void scan(QStringView folded, Hit&& hit) const
+    {
+        int state = 0;
+        for (const QChar c : folded) {
+            const char16_t ch = c.unicode();
+            if (ch >= 128) {
+                state = 0;
+                continue;
+            }
+            while (state != 0 && step(state, ch) < 0) {
+                state = m_nodes[state].fail;
+            }
+            const int next = step(state, ch);
+            state = next < 0 ? 0 : next;
+            for (int out = m_nodes[state].literal >= 0 ? state : m_nodes[state].outputLink; out >= 0;
+                 out = m_nodes[out].outputLink) {
+                hit(m_nodes[out].literal);
+            }
+        }
+    }
+
+private:
+    struct Node
+    {
+        std::vector<std::pair<char16_t, int>> edges; ///< unsorted, small fan-out
+        int fail = 0;
+        int outputLink = -1; ///< nearest proper-suffix node that ends a literal
+        int literal = -1; ///< id of the literal ending here, if any
+    };
+
+    int step(int state, char16_t ch) const;
+
+    std::vector<Node> m_nodes;
+    int m_rootEdges[128]; ///< dense root fan-out — every scan step passes through the root
+    int m_literalCount = 0;
+};
+
+/**
+ * @brief Compiled per-revision prefilter for RuleEvaluator.
+ *
+ * Each enabled rule is reduced to a **guard** — a set of cheap keys, at least
+ * one of which must fire for the rule's match expression to be able to match:
+ *
+ *   - `Equals` on a string field → an exact key in a per-field hash table;
+ *   - `Contains` / `StartsWith` / `EndsWith` → a literal in a per-field
+ *     Aho–Corasick automaton (a prefix or suffix is in particular a substring);
+ *   - `AppIdMatches` → its pattern as a literal (equality / trailing-segment /
+ *     last-segment-prefix all contain it) plus exact keys for the reverse
+ *     directions (every dot-suffix of the pattern, every ≥5-char prefix of its
+ *     last segment);
+ *   - `Regex` → membership in one of the field's grouped regexes — an
+ *     alternation of up to kRegexGroupSize regex leaves on that field,
+ *     matched once per query;
+ *   - `All{…}` → the cheapest guarded child's guard; `Any{…}` → the union of
+ *     its children's guards, if every child is guarded.
+ *
+ * Anything else — `None{}`, numeric / bool leaves, the catch-all, non-ASCII
+ * string patterns, regexes with back-references — leaves the rule unguarded:
+ * it is a candidate for every query. A guard is only ever a *necessary*
+ * condition; candidates still go through the full `MatchExpression::evaluate`,
+ * so the prefilter can cost speed but never change a verdict.
+ *
+ * Candidates are reported as **ranks** — positions in the priority order the
+ * index was built from — so the caller walks them in the same
+ * descending-priority / list-order sequence as an unfiltered walk.
+ *
+ * Immutable once built, except that `candidates()` dispatches the grouped
+ * regexes through `QRegularExpression::match()` (same serialization
+ * requirement as the regex leaves themselves — see RuleEvaluator).
+ */
+class RuleMatchIndex
+{
+public:
+    /// Build over @p rules walked in @p order (rule indices, descending priority).
+    RuleMatchIndex(const QList<Rule>& rules, const QList<int>& order);
+
+    /// Append to @p ranks every rank whose rule may match @p query, then sort
+    /// ascending and de-duplicate. @p ranks is cleared first.
+    void candidates(const WindowQuery& query, std::vector<int>& ranks) const;
+
+    /// Number of enabled rules that received a guard — for logging / tests.
+    int guardedCount() const
+    {
+        return m_guardedCount;
+    }
+
+    /// Number of enabled rules evaluated for every query.
+    int unguardedCount() const
+    {
+        return int(m_unguarded.size());
+    }
+
+private:
+    struct RegexGroup
+    {
+        QRegularExpression regex; ///< `(?:p1)|(?:p2)|…` over up to kRegexGroupSize leaves
+        std::vector<int> ranks;
+    };
+
+    struct FieldIndex
+    {
+        bool used = false;
+        QHash<QString, std::vector<int>> exact; ///< folded value → ranks
+        LiteralAutomaton literals;
+        std::vector<std::vector<int>> literalRanks; ///< literal id → ranks
+        std::vector<RegexGroup> regexGroups;
+    };
+
+    /// Regex leaves per grouped alternation. A group hit promotes every rule
+    /// in the group, so smaller groups filter tighter at the cost of more
+    /// match() calls per query.
+    static constexpr int kRegexGroupSize = 32;
+
+    std::vector<FieldIndex> m_fields; ///< indexed by static_cast<int>(Field)
+    std::vector<int> m_unguarded; ///< ranks, ascending
+    int m_guardedCount = 0;
+};
+
+} // namespace detail
+} // namespace PhosphorRules
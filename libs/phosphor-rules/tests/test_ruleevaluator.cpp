@@ -6,6 +6,8 @@
 #include <QSet>
 #include <QTest>
 
+#include <algorithm>
+
 using namespace PhosphorRules;
 using namespace PhosphorRules::TestHelpers;
 
@@ -21,6 +23,110 @@ WindowQuery konsoleQuery()
     return q;
 }
 
+/// Reference resolution — the plain descending-priority walk with no
+/// prefilter — for checking the indexed path against.
+ResolvedActions linearResolve(const RuleSet& set, const WindowQuery& query, const Rule** first = nullptr)
+{
+    const QList<Rule>& rules = set.rules();
+    QList<int> order;
+    for (int i = 0; i < rules.size(); ++i) {
+        order.append(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [&rules](int a, int b) {
+        return rules.at(a).priority > rules.at(b).priority;
+    });
+
+    const ActionRegistry& registry = ActionRegistry::instance();
+    ResolvedActions result;
+    for (int index : order) {
+        const Rule& rule = rules.at(index);
+        if (!rule.enabled || !rule.match.evaluate(query)) {
+            continue;
+        }
+        if (first && !*first) {
+            *first = &rule;
+        }
+        bool terminate = false;
+        for (const RuleAction& action : rule.actions) {
+            if (registry.isTerminal(action)) {
+                result.markExcluded();
+                terminate = true;
+                break;
+            }
+            result.fillSlot(registry.slotFor(action), action);
+        }
+        if (terminate) {
+            break;
+        }
+    }
+    return result;
+}
+
+/// A set large enough to be indexed, mixing every operator the prefilter
+/// keys on with shapes it must leave unguarded (non-ASCII, back-references,
+/// None{}, numeric leaves). Priorities collide so list-order tie-breaks are
+/// exercised; the shared opacity slot makes the per-slot winner observable.
+RuleSet buildMixedRuleSet(int n)
+{
+    RuleSet set;
+    for (int i = 0; i < n; ++i) {
+        MatchExpression match;
+        switch (i % 10) {
+        case 0:
+            match = MatchExpression::makeLeaf(Field::AppId, Operator::Equals, QStringLiteral("Org.App%1").arg(i % 7));
+            break;
+        case 1:
+            match =
+                MatchExpression::makeLeaf(Field::WindowClass, Operator::Contains, QStringLiteral("LASS%1").arg(i % 5));
+            break;
+        case 2:
+            match = MatchExpression::makeLeaf(Field::Title, Operator::StartsWith, QStringLiteral("doc %1").arg(i % 4));
+            break;
+        case 3:
+            match = MatchExpression::makeLeaf(Field::Title, Operator::EndsWith, QStringLiteral("- editor"));
+            break;
+        case 4:
+            match = MatchExpression::makeLeaf(Field::AppId, Operator::AppIdMatches,
+                                              i % 20 == 4 ? QStringLiteral("org.kde.konsole")
+                                                          : QStringLiteral("systemsettings"));
+            break;
+        case 5:
+            match = MatchExpression::makeLeaf(Field::Title, Operator::Regex,
+                                              i % 20 == 5 ? QStringLiteral("^(report|draft)-\\d+")
+                                                          : QStringLiteral("(ab)\\1"));
+            break;
+        case 6:
+            match = MatchExpression::makeAll({
+                MatchExpression::makeLeaf(Field::WindowClass, Operator::Equals, QStringLiteral("firefox")),
+                MatchExpression::makeLeaf(Field::Width, Operator::GreaterThan, 400 + i),
+            });
+            break;
+        case 7:
+            match = MatchExpression::makeAny({
+                MatchExpression::makeLeaf(Field::Title, Operator::Contains, QStringLiteral("über")),
+                MatchExpression::makeLeaf(Field::AppId, Operator::Equals, QStringLiteral("solo")),
+            });
+            break;
+        case 8:
+            match = MatchExpression::makeNone({
+                MatchExpression::makeLeaf(Field::WindowClass, Operator::Contains, QStringLiteral("lass")),
+            });
+            break;
+        default:
+            match = MatchExpression::makeAny({
+                MatchExpression::makeLeaf(Field::WindowClass, Operator::EndsWith, QStringLiteral("%1").arg(i % 3)),
+                MatchExpression::makeLeaf(Field::Title, Operator::Contains, QString()),
+            });
+            break;
+        }
+        Rule rule = makeRule(QStringLiteral("mixed-%1").arg(i), (i * 37) % 25, match,
+                             {i % 41 == 40 ? excludeAction() : setOpacity(i / 1000.0)});
+        rule.enabled = i % 23 != 22;
+        set.addRule(rule);
+    }
+    return set;
+}
+
 } // namespace
 
 class TestRuleEvaluator : public QObject
@@ -516,6 +622,61 @@ private Q_SLOTS:
         QCOMPARE(eval.cacheSize(), 0);
     }
 
+    // ── compiled prefilter ──
+
+    void testMatchIndex_agreesWithLinearWalk()
+    {
+        const RuleSet set = buildMixedRuleSet(240);
+        QVERIFY(set.rules().size() >= RuleEvaluator::kMatchIndexMinRules);
+        RuleEvaluator eval(set);
+
+        QList<WindowQuery> queries;
+        const auto query = [&queries](const QString& appId, const QString& windowClass, const QString& title,
+                                      int width) {
+            WindowQuery q;
+            q.appId = appId;
+            q.windowClass = windowClass;
+            q.title = title;
+            q.width = width;
+            q.screenId = QStringLiteral("DP-1");
+            queries.append(q);
+        };
+        query(QStringLiteral("ORG.APP3"), QStringLiteral("someclass4"), QStringLiteral("Doc 2 - Editor"), 300);
+        query(QStringLiteral("konsole"), QStringLiteral("Firefox"), QStringLiteral("report-17"), 900);
+        query(QStringLiteral("org.kde.systemsettings5"), QStringLiteral("x"), QStringLiteral("Über alles"), 500);
+        query(QStringLiteral("kde.konsole"), QStringLiteral("klass2"), QStringLiteral("ababab"), 100);
+        query(QStringLiteral("solo"), QStringLiteral("nothing"), QStringLiteral("DRAFT-1"), 1000);
+        query(QStringLiteral("syste"), QStringLiteral("lass1lass3"), QStringLiteral("plain"), 0);
+        query(QStringLiteral("unrelated"), QStringLiteral("unrelated"), QStringLiteral("unrelated"), 10);
+        WindowQuery windowless;
+        windowless.screenId = QStringLiteral("DP-1");
+        queries.append(windowless);
+
+        for (const WindowQuery& q : queries) {
+            const Rule* expectedFirst = nullptr;
+            const ResolvedActions expected = linearResolve(set, q, &expectedFirst);
+            QCOMPARE(eval.resolve(q), expected);
+            QCOMPARE(eval.highestPriorityMatch(q), expectedFirst);
+        }
+    }
+
+    void testMatchIndex_rebuiltOnRevisionBump()
+    {
+        RuleSet set = buildMixedRuleSet(RuleEvaluator::kMatchIndexMinRules);
+        RuleEvaluator eval(set);
+        WindowQuery q;
+        q.appId = QStringLiteral("fresh.app");
+        q.screenId = QStringLiteral("DP-1");
+        QVERIFY(!eval.resolve(q).hasSlot(QString(ActionSlot::Float)));
+
+        // A rule added after the index was built must be seen by the next walk.
+        set.addRule(makeRule(QStringLiteral("late"), 1000,
+                             MatchExpression::makeLeaf(Field::AppId, Operator::AppIdMatches, QStringLiteral("app")),
+                             {floatAction()}));
+        QVERIFY(eval.resolve(q).hasSlot(QString(ActionSlot::Float)));
+        QCOMPARE(eval.highestPriorityMatch(q)->name, QStringLiteral("late"));
+    }
+
     // ── per-property appearance slots cascade independently ──
 
     void testBorderAppearance_perSlotCascade()
@@ -4,7 +4,9 @@
 // Evaluation-cost benchmark. As rule evaluation is O(rules) per query (vs the
 // old cheap hash cascade), the match cache must cover the hot paths. This
 // benchmark measures the uncached descending-priority walk, the cached path,
-// and a representative composite-tree resolution.
+// and a representative composite-tree resolution. The 1k / 10k mixed-operator
+// cases measure the compiled candidate prefilter, where an uncached resolve
+// should scale with the matching rules rather than the set size.
 
 #include "RuleTestHelpers.h"
 
@@ -30,6 +32,48 @@ RuleSet buildRuleSet(int n)
     return set;
 }
 
+/// @p n rules cycling through the indexed operators (Equals, Contains,
+/// AppIdMatches, Regex) with distinct values, plus a catch-all — the shape
+/// of a large imported rule library.
+RuleSet buildMixedRuleSet(int n)
+{
+    RuleSet set;
+    for (int i = 0; i < n; ++i) {
+        MatchExpression match;
+        switch (i % 4) {
+        case 0:
+            match = MatchExpression::makeLeaf(Field::WindowClass, Operator::Equals, QStringLiteral("class-%1").arg(i));
+            break;
+        case 1:
+            match = MatchExpression::makeLeaf(Field::Title, Operator::Contains, QStringLiteral("doc-%1").arg(i));
+            break;
+        case 2:
+            match = MatchExpression::makeLeaf(Field::AppId, Operator::AppIdMatches,
+                                              QStringLiteral("org.vendor.tool%1").arg(i));
+            break;
+        default:
+            match = MatchExpression::makeLeaf(Field::Title, Operator::Regex, QStringLiteral("^report-%1-\\d+$").arg(i));
+            break;
+        }
+        set.addRule(makeRule(QStringLiteral("mixed-%1").arg(i), i % 100, match, {floatAction()}));
+    }
+    set.addRule(makeRule(QStringLiteral("catch-all"), 0, MatchExpression{}, {engineMode(QStringLiteral("snapping"))}));
+    return set;
+}
+
+/// Hits exactly one mixed rule (the AppIdMatches rule at index 2 via its
+/// trailing segment) — everything else must be filtered out.
+WindowQuery mixedQuery()
+{
+    WindowQuery q;
+    q.appId = QStringLiteral("org.vendor.tool2");
+    q.windowClass = QStringLiteral("class-none");
+    q.title = QStringLiteral("Untitled Document");
+    q.screenId = QStringLiteral("DP-2");
+    q.virtualDesktop = 1;
+    return q;
+}
+
 WindowQuery sampleQuery()
 {
     WindowQuery q;
@@ -118,6 +162,28 @@ private Q_SLOTS:
         }
     }
 
+    void benchmarkResolveUncached_mixed1k()
+    {
+        const RuleSet set = buildMixedRuleSet(1000);
+        RuleEvaluator eval(set);
+        const WindowQuery q = mixedQuery();
+        QBENCHMARK {
+            const ResolvedActions r = eval.resolve(q);
+            Q_UNUSED(r);
+        }
+    }
+
+    void benchmarkResolveUncached_mixed10k()
+    {
+        const RuleSet set = buildMixedRuleSet(10000);
+        RuleEvaluator eval(set);
+        const WindowQuery q = mixedQuery();
+        QBENCHMARK {
+            const ResolvedActions r = eval.resolve(q);
+            Q_UNUSED(r);
+        }
+    }
+
     void benchmarkResultSanity()
     {
         // Not a benchmark — a correctness gate so the benchmark above is
@@ -127,6 +193,17 @@ private Q_SLOTS:
         const ResolvedActions r = eval.resolve(sampleQuery());
         QVERIFY(r.hasSlot(QString(ActionSlot::Float)));
         QVERIFY(r.hasSlot(QString(ActionSlot::EngineMode)));
+
+        // Same gate for the mixed sets: the one AppIdMatches hit plus the
+        // catch-all, and the winner is the rule the query was built for.
+        const RuleSet mixed = buildMixedRuleSet(1000);
+        RuleEvaluator mixedEval(mixed);
+        const ResolvedActions m = mixedEval.resolve(mixedQuery());
+        QVERIFY(m.hasSlot(QString(ActionSlot::Float)));
+        QVERIFY(m.hasSlot(QString(ActionSlot::EngineMode)));
+        const Rule* winner = mixedEval.highestPriorityMatch(mixedQuery());
+        QVERIFY(winner);
+        QCOMPARE(winner->name, QStringLiteral("mixed-2"));
     }
 };
 
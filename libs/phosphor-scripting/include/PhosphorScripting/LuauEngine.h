@@ -5,7 +5,10 @@
 
 #include <phosphorscripting_export.h>
 
+#include <PhosphorScripting/LuauStack.h>
+
 #include <QByteArray>
+#include <QHash>
 #include <QString>
 #include <QVariant>
 #include <QVariantList>
@@ -13,6 +16,7 @@
 #include <atomic>
 #include <cstddef>
 #include <memory>
+#include <type_traits>
 
 struct lua_State;
 
@@ -28,10 +32,12 @@ class LuauWatchdog;
  * + stdlib) → @ref loadModule (per script). Scripts are then driven via
  * @ref callModule / @ref moduleField.
  *
- * The `lua_State` is private: the public surface is entirely `QVariant`-based so
- * no Luau symbols cross the library boundary. Domain bindings marshal their
- * params into nested `QVariantMap`/`QVariantList` and read results back the same
- * way.
+ * The `lua_State` is private so no Luau symbols cross the library boundary.
+ * Domain bindings marshal their params into nested `QVariantMap`/`QVariantList`
+ * and read results back the same way — or, on a hot path, use the typed
+ * surface (@ref internKey + @ref callModuleTyped), which writes arguments and
+ * reads the result directly on the VM stack through LuauStackWriter /
+ * LuauStackReader without building any QVariant.
  *
  * Not thread-safe — like the underlying VM, all calls must occur on the owning
  * thread. Runaway scripts are bounded by the shared @ref LuauWatchdog.
@@ -83,6 +89,12 @@ public:
 
     /// Compile + load a module chunk and run it; the chunk is expected to
     /// `return` a table. Returns a handle (>= 0) to that table, or -1 on error.
+    ///
+    /// Compiled bytecode (of preludes too) is cached content-addressed in
+    /// memory and under the user's cache directory, keyed on the source, the
+    /// pinned Luau version and the preludes this VM has run — so an unchanged
+    /// script loads without recompiling, across reloads and daemon restarts.
+    /// Set `PHOSPHOR_DISABLE_LUAU_BYTECODE_CACHE` to skip the on-disk layer.
     int loadModule(const QString& chunkName, const QByteArray& source, QString* error = nullptr);
 
     /// Release a module handle from @ref loadModule.
@@ -99,6 +111,42 @@ public:
     /// result. @p timeoutMs <= 0 means no timeout.
     CallOutcome callModule(int moduleHandle, const QString& function, const QVariantList& args, int timeoutMs);
 
+    /// Intern @p name as a VM string for the typed call surface. Interning the
+    /// same name twice returns the same key; keys live as long as the engine.
+    /// Returns an invalid key if the engine is not initialised.
+    LuauKey internKey(QStringView name);
+
+    /**
+     * @brief Typed counterpart of @ref callModule.
+     *
+     * Looks up `module[function]`, lets @p writeArgs push the arguments
+     * (`int writeArgs(LuauStackWriter&)`, returning how many it pushed), runs
+     * the call under the watchdog, then hands the single result to
+     * @p readResult (`void readResult(LuauStackReader&)`, result at -1) before
+     * popping it. Nothing is marshalled through QVariant on either side, so a
+     * per-frame caller pays only for the Lua values themselves.
+     *
+     * Returns the call status; on failure @p message (if set) receives the
+     * error and @p readResult is not invoked.
+     */
+    template<typename WriteArgs, typename ReadResult>
+    CallStatus callModuleTyped(int moduleHandle, LuauKey function, int timeoutMs, WriteArgs&& writeArgs,
+                               ReadResult&& readResult, QString* message = nullptr)
+    {
+        using W = std::remove_reference_t<WriteArgs>;
+        using R = std::remove_reference_t<ReadResult>;
+        return callModuleTypedImpl(
+            moduleHandle, function, timeoutMs,
+            [](void* ctx, LuauStackWriter& writer) -> int {
+                return (*static_cast<W*>(ctx))(writer);
+            },
+            const_cast<void*>(static_cast<const void*>(std::addressof(writeArgs))),
+            [](void* ctx, LuauStackReader& reader) {
+                (*static_cast<R*>(ctx))(reader);
+            },
+            const_cast<void*>(static_cast<const void*>(std::addressof(readResult))), message);
+    }
+
     bool isValid() const noexcept
     {
         return m_L != nullptr;
@@ -150,10 +198,17 @@ private:
     /// error object is popped and (optionally) returned via @p message.
     CallStatus guardedPcall(int nargs, int nresults, int timeoutMs, QString* message);
 
+    using WriteThunk = int (*)(void*, LuauStackWriter&);
+    using ReadThunk = void (*)(void*, LuauStackReader&);
+    CallStatus callModuleTypedImpl(int moduleHandle, LuauKey function, int timeoutMs, WriteThunk write,
+                                   void* writeCtx, ReadThunk read, void* readCtx, QString* message);
+
     lua_State* m_L = nullptr;
     std::shared_ptr<LuauWatchdog> m_watchdog;
     std::shared_ptr<std::atomic<bool>> m_interrupt;
     MemoryBudget m_memory;
+    QHash<QString, int> m_internedKeys; ///< name → registry ref, see internKey
+    QByteArray m_preludeDigest; ///< chained hash of every prelude run — part of the bytecode cache key
     bool m_sandboxed = false;
     // VM-thread-only: written by guardedPcall before arming the watchdog and
     // read after disarming; the interrupt callback that consumes them also runs
@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+#include <phosphorscripting_export.h>
+
+#include <QStringView>
+#include <QVarLengthArray>
+#include <QVariant>
+
+struct lua_State;
+
+namespace PhosphorScripting {
+
+/**
+ * @brief A string preinterned in an engine's VM, for the typed call surface.
+ *
+ * Obtained from @ref LuauEngine::internKey. Holds a registry reference to the
+ * Lua string, so a field write through it skips the strlen + hash + string-table
+ * lookup a `const char*` key costs on every use. Only valid with the engine that
+ * interned it; a default-constructed key is invalid.
+ */
+struct LuauKey
+{
+    int ref = -1;
+
+    bool isValid() const noexcept
+    {
+        return ref > 0;
+    }
+};
+
+/**
+ * @brief Typed, QVariant-free writer for call arguments.
+ *
+ * Handed to the argument callback of @ref LuauEngine::callModuleTyped. Values
+ * are pushed straight onto the VM stack; tables are created pre-sized, and
+ * fields are written through interned @ref LuauKey keys.
+ *
+ * Writes happen outside any protected call, so the writer never raises: if the
+ * stack cannot grow it latches @ref failed, turns every later call into a
+ * no-op, and the engine discards the partial arguments and reports an error.
+ */
+class PHOSPHORSCRIPTING_EXPORT LuauStackWriter
+{
+public:
+    void pushNil();
+    void pushBool(bool value);
+    void pushInt(int value);
+    void pushNumber(double value);
+    void pushString(QStringView value);
+    /// Generic fallback — same conversion as the QVariant call surface.
+    void pushVariant(const QVariant& value);
+
+    /// Push a new table with room for @p arrayCount sequence entries and
+    /// @p fieldCount keyed fields, so filling it never rehashes.
+    void pushTable(int arrayCount = 0, int fieldCount = 0);
+
+    /// Pop the top value into `table[key]`; the table sits just below it.
+    void setField(LuauKey key);
+    /// Pop the top value into `table[index]` (1-based); the table sits just below it.
+    void setIndex(int index);
+
+    void setBool(LuauKey key, bool value)
+    {
+        pushBool(value);
+        setField(key);
+    }
+    void setInt(LuauKey key, int value)
+    {
+        pushInt(value);
+        setField(key);
+    }
+    void setNumber(LuauKey key, double value)
+    {
+        pushNumber(value);
+        setField(key);
+    }
+    void setString(LuauKey key, QStringView value)
+    {
+        pushString(value);
+        setField(key);
+    }
+
+    bool failed() const noexcept
+    {
+        return m_failed;
+    }
+
+private:
+    friend class LuauEngine;
+    explicit LuauStackWriter(lua_State* L)
+        : m_L(L)
+    {
+    }
+
+    /// Reserve @p slots stack slots, latching m_failed on failure.
+    bool reserve(int slots);
+
+    lua_State* m_L;
+    bool m_failed = false;
+    QVarLengthArray<char, 256> m_utf8; ///< scratch for pushString — no heap for short strings
+};
+
+/**
+ * @brief Typed reader over a call's result, for @ref LuauEngine::callModuleTyped.
+ *
+ * Indices are ordinary Lua stack indices; the result starts at -1. Reads are
+ * raw (no metamethods) — the same view the QVariant surface's table walk
+ * takes. The engine reserves @ref StackReserve free slots before the callback
+ * runs; a reader must not hold more pushed values than that at once.
+ */
+class PHOSPHORSCRIPTING_EXPORT LuauStackReader
+{
+public:
+    static constexpr int StackReserve = 16;
+
+    bool isTable(int idx = -1) const;
+    /// Sequence border (`#t`) of a table, 0 for anything else.
+    int length(int idx = -1) const;
+
+    /// Push `t[index]` (raw) — nil when @p idx is not a table.
+    void pushIndex(int idx, int index);
+    /// Push `t[key]` (raw) — nil when @p idx is not a table.
+    void pushField(int idx, LuauKey key);
+    void pop(int count = 1);
+
+    /// The value as an int, with exactly `toVariant(idx).toInt()` semantics
+    /// but without building a QVariant for the common number case.
+    int toInt(int idx = -1) const;
+    QVariant toVariant(int idx = -1) const;
+
+    /// `toInt` of `t[key]`.
+    int intField(int idx, LuauKey key);
+
+private:
+    friend class LuauEngine;
+    explicit LuauStackReader(lua_State* L)
+        : m_L(L)
+    {
+    }
+
+    lua_State* m_L;
+};
+
+} // namespace PhosphorScripting
@@ -0,0 +1,228 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "luaubytecodecache.h"
+
+#include <QCache>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <mutex>
+
+namespace PhosphorScripting {
+namespace BytecodeCache {
+
+namespace {
+
+// Daemon start compiles the prelude plus every bundled and user algorithm, and
+// every live reload of the algorithm directory compiles them all again. The
+// bytecode only depends on the source, the compiler and its options, so it is
+// cached content-addressed, the same way phosphor-rendering caches baked
+// shaders: an in-process LRU for reloads, backed by an on-disk store that
+// survives restarts.
+//
+// Key = SHA-256 of (schema tag ‖ Luau version ‖ prelude digest ‖ source). An
+// edit to the script, the prelude or the compiler changes the key, so the cache
+// is self-invalidating; orphans are bounded by a one-shot prune.
+//
+// Trust model: as for the shader cache, the directory lives under the user's
+// own GenericCacheLocation and is trusted (same-UID). luau_load() does not
+// validate bytecode against a hostile writer, but such a process already
+// controls the daemon. Accidental damage is caught: each entry carries the
+// SHA-256 of its payload and a mismatch is a miss.
+
+// Bumped whenever the compile options passed to luau_compile() change.
+constexpr char kSchema[] = "luau-bc-v1";
+
+constexpr int kMaxDiskCacheEntries = 256;
+// In-memory layer budget in bytes; a bundled algorithm compiles to a few KiB.
+constexpr qsizetype kMaxMemoryBytes = 4 * 1024 * 1024;
+constexpr qsizetype kDigestSize = 32;
+
+#ifdef PHOSPHORSCRIPTING_LUAU_VERSION
+constexpr char kLuauVersion[] = PHOSPHORSCRIPTING_LUAU_VERSION;
+#endif
+
+struct MemoryCache
+{
+    QMutex mutex;
+    // QCache owns its values and evicts LRU-first by total cost (bytes).
+    QCache<QByteArray, QByteArray> entries{kMaxMemoryBytes};
+
+    static MemoryCache& instance()
+    {
+        static MemoryCache s;
+        return s;
+    }
+};
+
+// Cache directory, resolved + created once. Empty = disk layer disabled: the
+// opt-out env var, no writable cache location, or a system Luau build whose
+// compiler version is not pinned by this build and so cannot key the cache.
+QString diskCacheDir()
+{
+    static const QString dir = [] {
+#ifndef PHOSPHORSCRIPTING_LUAU_VERSION
+        return QString();
+#else
+        if (qEnvironmentVariableIsSet("PHOSPHOR_DISABLE_LUAU_BYTECODE_CACHE")) {
+            return QString();
+        }
+        const QString base = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+        if (base.isEmpty()) {
+            return QString();
+        }
+        // The version is in the key already; in the path too so a Luau bump
+        // leaves the old blobs in a directory of their own instead of mixed in.
+        const QString d = base + QLatin1String("/phosphor-luaucache/luau") + QLatin1String(kLuauVersion)
+            + QLatin1Char('-') + QLatin1String(kSchema);
+        if (!QDir().mkpath(d)) {
+            return QString();
+        }
+        return d;
+#endif
+    }();
+    return dir;
+}
+
+QString diskCachePath(const QByteArray& key)
+{
+    const QString dir = diskCacheDir();
+    if (dir.isEmpty()) {
+        return QString();
+    }
+    return dir + QLatin1Char('/') + QString::fromLatin1(key.toHex()) + QLatin1String(".luauc");
+}
+
+// Orphans only accrue when scripts are edited, so one prune per process (on
+// first write) bounds the directory. Keeps the newest ~90% of the cap.
+void pruneDiskCacheOnce()
+{
+    static std::once_flag once;
+    std::call_once(once, [] {
+        const QString dir = diskCacheDir();
+        if (dir.isEmpty()) {
+            return;
+        }
+        QFileInfoList blobs = QDir(dir).entryInfoList({QStringLiteral("*.luauc")}, QDir::Files, QDir::NoSort);
+        if (blobs.size() <= kMaxDiskCacheEntries) {
+            return;
+        }
+        std::sort(blobs.begin(), blobs.end(), [](const QFileInfo& a, const QFileInfo& b) {
+            return a.lastModified() > b.lastModified();
+        });
+        for (int i = kMaxDiskCacheEntries * 9 / 10; i < blobs.size(); ++i) {
+            QFile::remove(blobs.at(i).absoluteFilePath());
+        }
+    });
+}
+
+void remember(const QByteArray& key, const QByteArray& bytecode)
+{
+    auto& cache = MemoryCache::instance();
+    QMutexLocker lock(&cache.mutex);
+    cache.entries.insert(key, new QByteArray(bytecode), std::max<qsizetype>(1, bytecode.size()));
+}
+
+// Disk entry = bytecode ‖ SHA-256(bytecode).
+QByteArray readDiskCache(const QString& path)
+{
+    if (path.isEmpty()) {
+        return {};
+    }
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    const QByteArray blob = f.readAll();
+    if (blob.size() <= kDigestSize) {
+        return {};
+    }
+    const QByteArrayView payload(blob.constData(), blob.size() - kDigestSize);
+    if (QCryptographicHash::hash(payload, QCryptographicHash::Sha256) != blob.right(kDigestSize)) {
+        return {};
+    }
+    return blob.left(payload.size());
+}
+
+void writeDiskCache(const QString& path, const QByteArray& bytecode)
+{
+    if (path.isEmpty()) {
+        return;
+    }
+    pruneDiskCacheOnce();
+    // Atomic rename on commit(): a concurrent reader never sees a partial
+    // entry, and identical keys produce identical bytes, so racing writers are
+    // harmless. Failures just leave the entry uncached.
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    const QByteArray digest = QCryptographicHash::hash(bytecode, QCryptographicHash::Sha256);
+    if (f.write(bytecode) != bytecode.size() || f.write(digest) != digest.size()) {
+        f.cancelWriting();
+        return;
+    }
+    f.commit();
+}
+
+} // namespace
+
+QByteArray key(const QByteArray& source, const QByteArray& preludeDigest)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(QByteArrayView(kSchema));
+#ifdef PHOSPHORSCRIPTING_LUAU_VERSION
+    hash.addData(QByteArrayView(kLuauVersion));
+#endif
+    // Length-prefix the variable-size parts so no two (digest, source) pairs
+    // hash the same bytes.
+    const qint64 digestSize = preludeDigest.size();
+    hash.addData(QByteArrayView(reinterpret_cast<const char*>(&digestSize), sizeof(digestSize)));
+    hash.addData(preludeDigest);
+    hash.addData(source);
+    return hash.result();
+}
+
+QByteArray chainPrelude(const QByteArray& preludeDigest, const QByteArray& source)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(preludeDigest);
+    hash.addData(QCryptographicHash::hash(source, QCryptographicHash::Sha256));
+    return hash.result();
+}
+
+QByteArray lookup(const QByteArray& key)
+{
+    {
+        auto& cache = MemoryCache::instance();
+        QMutexLocker lock(&cache.mutex);
+        if (const QByteArray* hit = cache.entries.object(key)) {
+            return *hit;
+        }
+    }
+    QByteArray bytecode = readDiskCache(diskCachePath(key));
+    if (!bytecode.isEmpty()) {
+        remember(key, bytecode);
+    }
+    return bytecode;
+}
+
+void store(const QByteArray& key, const QByteArray& bytecode)
+{
+    if (bytecode.isEmpty() || bytecode.at(0) == 0) {
+        return;
+    }
+    remember(key, bytecode);
+    writeDiskCache(diskCachePath(key), bytecode);
+}
+
+} // namespace BytecodeCache
+} // namespace PhosphorScripting
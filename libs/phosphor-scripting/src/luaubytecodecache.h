@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Internal content-addressed Luau bytecode cache. NOT part of the public API —
+// LuauEngine consults it around luau_compile() for preludes and modules.
+
+#pragma once
+
+#include <QByteArray>
+
+namespace PhosphorScripting {
+namespace BytecodeCache {
+
+/// Cache key for compiling @p source in a VM whose preludes hash to
+/// @p preludeDigest. Folds in the pinned Luau version and the compile-option
+/// schema, so a Luau bump or an options change never serves stale bytecode.
+QByteArray key(const QByteArray& source, const QByteArray& preludeDigest);
+
+/// Chain @p source onto @p preludeDigest — the digest a VM carries once it has
+/// also run @p source as a prelude.
+QByteArray chainPrelude(const QByteArray& preludeDigest, const QByteArray& source);
+
+/// Bytecode stored under @p key, from memory or disk; empty on a miss (and on
+/// a corrupt or unreadable entry, which is treated as a miss).
+QByteArray lookup(const QByteArray& key);
+
+/// Store successfully compiled @p bytecode under @p key. Callers must not
+/// store an error blob (leading 0 byte) — a compile error should surface anew
+/// on every load, not be replayed from the cache.
+void store(const QByteArray& key, const QByteArray& bytecode);
+
+} // namespace BytecodeCache
+} // namespace PhosphorScripting
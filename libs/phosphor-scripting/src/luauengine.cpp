@@ -4,6 +4,7 @@
 #include <PhosphorScripting/LuauEngine.h>
 #include <PhosphorScripting/LuauWatchdog.h>
 
+#include "luaubytecodecache.h"
 #include "luaumarshal.h"
 
 #include <lua.h>
@@ -74,6 +75,50 @@ QString errorText(lua_State* L)
     const char* msg = lua_tostring(L, -1);
     return msg ? QString::fromUtf8(msg) : QStringLiteral("<non-string error object>");
 }
+
+// Compile @p source — or take its bytecode from the cache — and luau_load it,
+// leaving the chunk function on the stack. On failure nothing is left on the
+// stack and @p error (if set) receives the reason. @p preludeDigest identifies
+// the preludes the VM has run, which is part of the cache key.
+bool loadChunk(lua_State* L, const QString& chunkName, const QByteArray& source, const QByteArray& preludeDigest,
+               QString* error)
+{
+    const QByteArray cacheKey = BytecodeCache::key(source, preludeDigest);
+    QByteArray bytecode = BytecodeCache::lookup(cacheKey);
+    if (bytecode.isEmpty()) {
+        size_t bcSize = 0;
+        char* bc = nullptr;
+        {
+            // Pin LC_NUMERIC to "C" so '.'-decimal literals lex correctly
+            // regardless of the user's locale (see ScopedCNumericLocale).
+            const ScopedCNumericLocale cNumeric;
+            bc = luau_compile(source.constData(), static_cast<size_t>(source.size()), nullptr, &bcSize);
+        }
+        // luau_compile allocates the result with its own allocator (outside the
+        // VM heap cap) and encodes syntax errors into a non-null blob — a null
+        // return means allocation failure, not a syntax error.
+        if (!bc) {
+            if (error) {
+                *error = QStringLiteral("luau_compile failed (out of memory)");
+            }
+            return false;
+        }
+        bytecode = QByteArray(bc, static_cast<qsizetype>(bcSize));
+        std::free(bc);
+        // store() skips error blobs, so a syntax error is re-reported each load.
+        BytecodeCache::store(cacheKey, bytecode);
+    }
+    const int loadStatus = luau_load(L, chunkName.toUtf8().constData(), bytecode.constData(),
+                                     static_cast<size_t>(bytecode.size()), 0);
+    if (loadStatus != 0) {
+        if (error) {
+            *error = errorText(L);
+        }
+        lua_pop(L, 1);
+        return false;
+    }
+    return true;
+}
 } // namespace
 
 LuauEngine::LuauEngine(std::shared_ptr<LuauWatchdog> watchdog, std::size_t memoryCapBytes)
@@ -171,30 +216,7 @@ bool LuauEngine::runPrelude(const QString& chunkName, const QByteArray& source,
         return false;
     }
 
-    size_t bcSize = 0;
-    char* bc = nullptr;
-    {
-        // Pin LC_NUMERIC to "C" so '.'-decimal literals lex correctly
-        // regardless of the user's locale (see ScopedCNumericLocale).
-        const ScopedCNumericLocale cNumeric;
-        bc = luau_compile(source.constData(), static_cast<size_t>(source.size()), nullptr, &bcSize);
-    }
-    // luau_compile allocates the result with its own allocator (outside the VM
-    // heap cap) and encodes syntax errors into a non-null blob — a null return
-    // means allocation failure, not a syntax error.
-    if (!bc) {
-        if (error) {
-            *error = QStringLiteral("luau_compile failed (out of memory)");
-        }
-        return false;
-    }
-    const int loadStatus = luau_load(m_L, chunkName.toUtf8().constData(), bc, bcSize, 0);
-    std::free(bc);
-    if (loadStatus != 0) {
-        if (error) {
-            *error = errorText(m_L);
-        }
-        lua_pop(m_L, 1);
+    if (!loadChunk(m_L, chunkName, source, m_preludeDigest, error)) {
         return false;
     }
 
@@ -205,6 +227,8 @@ bool LuauEngine::runPrelude(const QString& chunkName, const QByteArray& source,
         }
         return false;
     }
+    // Modules compiled from here on are keyed on every prelude that ran.
+    m_preludeDigest = BytecodeCache::chainPrelude(m_preludeDigest, source);
     return true;
 }
 
@@ -230,28 +254,7 @@ int LuauEngine::loadModule(const QString& chunkName, const QByteArray& source, Q
         return -1;
     }
 
-    size_t bcSize = 0;
-    char* bc = nullptr;
-    {
-        // Pin LC_NUMERIC to "C" so '.'-decimal literals lex correctly
-        // regardless of the user's locale (see ScopedCNumericLocale).
-        const ScopedCNumericLocale cNumeric;
-        bc = luau_compile(source.constData(), static_cast<size_t>(source.size()), nullptr, &bcSize);
-    }
-    // See runPrelude: a null blob is an allocation failure, not a syntax error.
-    if (!bc) {
-        if (error) {
-            *error = QStringLiteral("luau_compile failed (out of memory)");
-        }
-        return -1;
-    }
-    const int loadStatus = luau_load(m_L, chunkName.toUtf8().constData(), bc, bcSize, 0);
-    std::free(bc);
-    if (loadStatus != 0) {
-        if (error) {
-            *error = errorText(m_L);
-        }
-        lua_pop(m_L, 1);
+    if (!loadChunk(m_L, chunkName, source, m_preludeDigest, error)) {
         return -1;
     }
 
@@ -365,6 +368,81 @@ LuauEngine::CallOutcome LuauEngine::callModule(int moduleHandle, const QString&
     return out;
 }
 
+LuauKey LuauEngine::internKey(QStringView name)
+{
+    if (!m_L) {
+        return {};
+    }
+    const QString key = name.toString();
+    const auto it = m_internedKeys.constFind(key);
+    if (it != m_internedKeys.constEnd()) {
+        return LuauKey{*it};
+    }
+    const QByteArray utf8 = key.toUtf8();
+    lua_pushlstring(m_L, utf8.constData(), static_cast<size_t>(utf8.size()));
+    const int ref = lua_ref(m_L, -1);
+    lua_pop(m_L, 1);
+    if (ref <= 0) {
+        return {};
+    }
+    m_internedKeys.insert(key, ref);
+    return LuauKey{ref};
+}
+
+LuauEngine::CallStatus LuauEngine::callModuleTypedImpl(int moduleHandle, LuauKey function, int timeoutMs,
+                                                       WriteThunk write, void* writeCtx, ReadThunk read,
+                                                       void* readCtx, QString* message)
+{
+    const auto fail = [message](const QString& text) {
+        if (message) {
+            *message = text;
+        }
+        return CallStatus::Error;
+    };
+    if (!m_L || moduleHandle < 0 || !function.isValid()) {
+        return fail(QStringLiteral("invalid module handle"));
+    }
+
+    const int base = lua_gettop(m_L);
+    lua_getref(m_L, moduleHandle);
+    if (!lua_istable(m_L, -1)) {
+        lua_settop(m_L, base);
+        return fail(QStringLiteral("invalid module handle"));
+    }
+    // Non-raw lookup, like callModule's lua_getfield.
+    lua_getref(m_L, function.ref);
+    lua_gettable(m_L, -2);
+    if (!lua_isfunction(m_L, -1)) {
+        lua_getref(m_L, function.ref);
+        const QString name = QString::fromUtf8(lua_tostring(m_L, -1));
+        lua_settop(m_L, base);
+        return fail(QStringLiteral("module has no function '%1'").arg(name));
+    }
+    lua_remove(m_L, -2); // drop module, keep the function
+
+    LuauStackWriter writer(m_L);
+    const int nargs = write(writeCtx, writer);
+    // A latched writer failure, or a callback that miscounted its pushes,
+    // leaves the stack in a state the call must not consume.
+    if (writer.failed() || nargs < 0 || lua_gettop(m_L) != base + 1 + nargs) {
+        lua_settop(m_L, base);
+        return fail(QStringLiteral("argument marshalling failed"));
+    }
+
+    const CallStatus status = guardedPcall(nargs, 1, timeoutMs, message);
+    if (status != CallStatus::Ok) {
+        return status;
+    }
+    if (!lua_checkstack(m_L, LuauStackReader::StackReserve)) {
+        lua_settop(m_L, base);
+        return fail(QStringLiteral("result marshalling failed"));
+    }
+    LuauStackReader reader(m_L);
+    read(readCtx, reader);
+    lua_settop(m_L, base);
+    return CallStatus::Ok;
+}
+
 void LuauEngine::interruptCallback(lua_State* L, int gc)
 {
     if (gc >= 0) {
@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <PhosphorScripting/LuauStack.h>
+
+#include "luaumarshal.h"
+
+#include <lua.h>
+
+#include <QStringEncoder>
+
+#include <cmath>
+
+namespace PhosphorScripting {
+
+// ── LuauStackWriter ─────────────────────────────────────────────────────
+
+bool LuauStackWriter::reserve(int slots)
+{
+    if (m_failed) {
+        return false;
+    }
+    // Runs outside any protected call — see the Marshal::pushVariant note.
+    if (!lua_checkstack(m_L, slots)) {
+        m_failed = true;
+        return false;
+    }
+    return true;
+}
+
+void LuauStackWriter::pushNil()
+{
+    if (reserve(1)) {
+        lua_pushnil(m_L);
+    }
+}
+
+void LuauStackWriter::pushBool(bool value)
+{
+    if (reserve(1)) {
+        lua_pushboolean(m_L, value ? 1 : 0);
+    }
+}
+
+void LuauStackWriter::pushInt(int value)
+{
+    if (reserve(1)) {
+        lua_pushinteger(m_L, value);
+    }
+}
+
+void LuauStackWriter::pushNumber(double value)
+{
+    if (reserve(1)) {
+        lua_pushnumber(m_L, value);
+    }
+}
+
+void LuauStackWriter::pushString(QStringView value)
+{
+    if (!reserve(1)) {
+        return;
+    }
+    QStringEncoder encoder(QStringEncoder::Utf8);
+    m_utf8.resize(encoder.requiredSpace(value.size()));
+    char* end = encoder.appendToBuffer(m_utf8.data(), value);
+    lua_pushlstring(m_L, m_utf8.constData(), static_cast<size_t>(end - m_utf8.constData()));
+}
+
+void LuauStackWriter::pushVariant(const QVariant& value)
+{
+    // pushVariant reserves its own per-level slots and degrades to nil.
+    if (reserve(1)) {
+        Marshal::pushVariant(m_L, value);
+    }
+}
+
+void LuauStackWriter::pushTable(int arrayCount, int fieldCount)
+{
+    // The table plus the value about to be stored in it.
+    if (reserve(2)) {
+        lua_createtable(m_L, arrayCount, fieldCount);
+    }
+}
+
+void LuauStackWriter::setField(LuauKey key)
+{
+    if (!reserve(1)) {
+        return;
+    }
+    // value at -1, table at -2 → push key, swap under the value, rawset.
+    lua_getref(m_L, key.ref);
+    lua_insert(m_L, -2);
+    lua_rawset(m_L, -3);
+}
+
+void LuauStackWriter::setIndex(int index)
+{
+    if (!m_failed) {
+        lua_rawseti(m_L, -2, index);
+    }
+}
+
+// ── LuauStackReader ─────────────────────────────────────────────────────
+
+bool LuauStackReader::isTable(int idx) const
+{
+    return lua_istable(m_L, idx);
+}
+
+int LuauStackReader::length(int idx) const
+{
+    if (!lua_istable(m_L, idx)) {
+        return 0;
+    }
+    const int n = lua_objlen(m_L, idx);
+    return n < 0 ? 0 : n;
+}
+
+void LuauStackReader::pushIndex(int idx, int index)
+{
+    if (!lua_istable(m_L, idx)) {
+        lua_pushnil(m_L);
+        return;
+    }
+    lua_rawgeti(m_L, idx, index);
+}
+
+void LuauStackReader::pushField(int idx, LuauKey key)
+{
+    if (!lua_istable(m_L, idx)) {
+        lua_pushnil(m_L);
+        return;
+    }
+    const int table = idx < 0 ? lua_gettop(m_L) + idx + 1 : idx;
+    lua_getref(m_L, key.ref);
+    lua_rawget(m_L, table);
+}
+
+void LuauStackReader::pop(int count)
+{
+    lua_pop(m_L, count);
+}
+
+int LuauStackReader::toInt(int idx) const
+{
+    if (lua_type(m_L, idx) == LUA_TNUMBER) {
+        // Mirror Marshal::toVariant + QVariant::toInt(): exact integers travel
+        // as qlonglong and truncate to int; other finite doubles round the way
+        // QVariant's double → int conversion does. Non-finite values read 0.
+        const double n = lua_tonumber(m_L, idx);
+        if (!std::isfinite(n)) {
+            return 0;
+        }
+        if (std::floor(n) == n && std::fabs(n) <= 9007199254740992.0) {
+            return static_cast<int>(static_cast<qlonglong>(n));
+        }
+        return static_cast<int>(qRound64(n));
+    }
+    // Strings, booleans, tables: rare — take the exact QVariant route.
+    return Marshal::toVariant(m_L, idx).toInt();
+}
+
+QVariant LuauStackReader::toVariant(int idx) const
+{
+    return Marshal::toVariant(m_L, idx);
+}
+
+int LuauStackReader::intField(int idx, LuauKey key)
+{
+    pushField(idx, key);
+    const int value = toInt(-1);
+    lua_pop(m_L, 1);
+    return value;
+}
+
+} // namespace PhosphorScripting
@@ -7,6 +7,7 @@
 
 #include <QAbstractItemModel>
 #include <QObject>
+#include <QVariantMap>
 
 #include <memory>
 
@@ -51,6 +52,18 @@ public:
     /// Re-apply the entry at @p index to the clipboard selection. Out-of-range
     /// indices are ignored.
     Q_INVOKABLE void copy(int index);
+    /// Search the text entries for @p query and return one page of matches as
+    /// `{ rows: [int], total: int }`: `rows` are indices into `history` (valid
+    /// for `copy` / `remove` until the history next changes), best match first,
+    /// starting at @p offset and at most @p limit long; `total` counts every
+    /// match so a picker can size its list and fetch further pages only as it
+    /// scrolls. Entries starting with the query rank first, then those
+    /// containing it, then close (typo-tolerant) matches, newest first within
+    /// each. Backed by an incrementally maintained trigram index, so a
+    /// keystroke costs the matching entries rather than the whole history. An
+    /// empty query matches nothing.
+    [[nodiscard]] Q_INVOKABLE QVariantMap search(const QString& query, int offset = 0, int limit = 50) const;
+
     /// Remove the entry at @p index from the history (and disk).
     Q_INVOKABLE void remove(int index);
     /// Clear the entire history (and disk).
@@ -6,6 +6,7 @@
 // Internal (not installed) value type: one entry in the clipboard history.
 
 #include <QByteArray>
+#include <QCryptographicHash>
 #include <QDateTime>
 #include <QString>
 #include <QStringList>
@@ -14,8 +15,14 @@ namespace PhosphorServiceClipboard {
 
 struct ClipboardEntry
 {
-    /// The raw bytes that were on the clipboard for `mimeType`.
+    /// The raw bytes that were on the clipboard for `mimeType`. Empty once the
+    /// entry has been persisted and released, and for entries loaded from disk:
+    /// the bytes then live only in the store's blob, read back on demand with
+    /// `ClipboardStore::readContent`.
     QByteArray content;
+    /// SHA-256 (lowercase hex) of `content`, computed once at capture. Keys
+    /// de-duplication and names the on-disk blob, so neither re-hashes the bytes.
+    QString contentHash;
     /// The MIME type the `content` was materialized as.
     QString mimeType;
     /// Every MIME type the selection offered (the full menu, even though only
@@ -29,6 +36,15 @@ struct ClipboardEntry
     /// True when the selection carried a sensitivity hint (e.g. a password
     /// manager). Sensitive entries are surfaced live but never persisted.
     bool sensitive = false;
+    /// Assigned by the history model when the entry enters the list; stable
+    /// while it stays there and strictly increasing with recency. Keys the
+    /// search index, whose hits the model maps back to rows.
+    quint64 serial = 0;
+
+    [[nodiscard]] static QString hashContent(const QByteArray& content)
+    {
+        return QString::fromLatin1(QCryptographicHash::hash(content, QCryptographicHash::Sha256).toHex());
+    }
 };
 
 } // namespace PhosphorServiceClipboard
@@ -5,6 +5,8 @@
 
 #include <QDateTime>
 
+#include <algorithm>
+
 namespace PhosphorServiceClipboard {
 
 namespace {
@@ -118,16 +120,82 @@ void ClipboardHistoryModel::setEntries(const QList<ClipboardEntry>& entries)
     // m_maxEntries is clamped to >= 0 in setMaxEntries, so the cap always applies.
     if (m_entries.size() > static_cast<qsizetype>(m_maxEntries))
         m_entries.erase(m_entries.begin() + m_maxEntries, m_entries.end());
+    // Loaded entries carry their hash; hash anything seeded without one so
+    // de-duplication can key on it. Serials run oldest-to-newest, so the
+    // most-recent-first rows keep strictly decreasing serials.
+    m_searchIndex.clear();
+    for (qsizetype row = m_entries.size() - 1; row >= 0; --row) {
+        ClipboardEntry& entry = m_entries[row];
+        if (entry.contentHash.isEmpty())
+            entry.contentHash = ClipboardEntry::hashContent(entry.content);
+        entry.serial = m_nextSerial++;
+        indexEntry(entry);
+    }
     endResetModel();
     if (m_entries.size() != before)
         Q_EMIT countChanged();
 }
 
+void ClipboardHistoryModel::setContentReader(ContentReader reader)
+{
+    m_contentReader = std::move(reader);
+}
+
+void ClipboardHistoryModel::indexEntry(const ClipboardEntry& entry)
+{
+    if (!isTextType(entry.mimeType))
+        return;
+    QByteArray bytes = entry.content;
+    if (bytes.isEmpty() && m_contentReader)
+        bytes = m_contentReader(entry);
+    // The index reads only a bounded head; don't decode more than it can use
+    // (a UTF-8 character is at most 4 bytes, and folding collapses whitespace).
+    bytes.truncate(8 * ClipboardSearchIndex::MaxIndexedChars);
+    m_searchIndex.insert(entry.serial, QString::fromUtf8(bytes));
+}
+
+int ClipboardHistoryModel::rowOfSerial(quint64 serial) const
+{
+    // Rows are most-recent first and serials grow with recency, so the list is
+    // sorted by descending serial.
+    const auto it = std::lower_bound(m_entries.cbegin(), m_entries.cend(), serial,
+                                     [](const ClipboardEntry& entry, quint64 s) {
+                                         return entry.serial > s;
+                                     });
+    if (it == m_entries.cend() || it->serial != serial)
+        return -1;
+    return int(it - m_entries.cbegin());
+}
+
+QList<int> ClipboardHistoryModel::search(const QString& query, int offset, int limit, int* total) const
+{
+    qsizetype matches = 0;
+    const QList<quint64> serials = m_searchIndex.search(query, offset, limit, &matches);
+    if (total)
+        *total = int(matches);
+    QList<int> rows;
+    rows.reserve(serials.size());
+    for (const quint64 serial : serials) {
+        if (const int row = rowOfSerial(serial); row >= 0)
+            rows.append(row);
+    }
+    return rows;
+}
+
+void ClipboardHistoryModel::releasePersistedContent()
+{
+    for (ClipboardEntry& entry : m_entries) {
+        if (!entry.sensitive)
+            entry.content = QByteArray();
+    }
+}
+
 void ClipboardHistoryModel::removeAt(int row)
 {
     if (row < 0 || row >= m_entries.size())
         return;
     beginRemoveRows(QModelIndex(), row, row);
+    m_searchIndex.remove(m_entries.at(row).serial);
     m_entries.removeAt(row);
     endRemoveRows();
     Q_EMIT countChanged();
@@ -140,6 +208,7 @@ void ClipboardHistoryModel::clear()
         return;
     beginResetModel();
     m_entries.clear();
+    m_searchIndex.clear();
     endResetModel();
     Q_EMIT countChanged();
     Q_EMIT historyChanged();
@@ -204,19 +273,24 @@ void ClipboardHistoryModel::recordEntry(const QByteArray& content, const QString
 {
     ClipboardEntry entry;
     entry.content = content;
+    // The one hash of these bytes: dedup below and the store's blob name both
+    // reuse it.
+    entry.contentHash = ClipboardEntry::hashContent(content);
     entry.mimeType = mimeType;
     entry.offeredTypes = offeredTypes;
     entry.preview = makePreview(content, mimeType);
     entry.timestamp = QDateTime::currentDateTime();
     entry.sensitive = false; // sensitive selections never reach here.
+    entry.serial = m_nextSerial++;
 
     const qsizetype beforeCount = m_entries.size();
 
     // De-duplicate: an identical capture moves to the front (most-recent) rather
     // than adding a second copy.
-    const int existing = indexOfContent(entry.content, entry.mimeType);
+    const int existing = indexOfContent(entry.contentHash, entry.mimeType);
     if (existing >= 0) {
         beginRemoveRows(QModelIndex(), existing, existing);
+        m_searchIndex.remove(m_entries.at(existing).serial);
         m_entries.removeAt(existing);
         endRemoveRows();
     }
@@ -224,6 +298,8 @@ void ClipboardHistoryModel::recordEntry(const QByteArray& content, const QString
     beginInsertRows(QModelIndex(), 0, 0);
     m_entries.prepend(entry);
     endInsertRows();
+    // Indexed while the bytes are still in hand; never re-read for this.
+    indexEntry(entry);
 
     enforceCap();
 
@@ -233,10 +309,12 @@ void ClipboardHistoryModel::recordEntry(const QByteArray& content, const QString
     Q_EMIT historyChanged();
 }
 
-int ClipboardHistoryModel::indexOfContent(const QByteArray& content, const QString& mimeType) const
+int ClipboardHistoryModel::indexOfContent(const QString& contentHash, const QString& mimeType) const
 {
+    // By hash, not bytes: released and loaded entries no longer hold their
+    // content, and the digest was taken at capture anyway.
     for (int i = 0; i < m_entries.size(); ++i) {
-        if (m_entries.at(i).mimeType == mimeType && m_entries.at(i).content == content)
+        if (m_entries.at(i).mimeType == mimeType && m_entries.at(i).contentHash == contentHash)
             return i;
     }
     return -1;
@@ -250,6 +328,7 @@ void ClipboardHistoryModel::enforceCap()
     while (m_entries.size() > m_maxEntries) {
         const int last = m_entries.size() - 1;
         beginRemoveRows(QModelIndex(), last, last);
+        m_searchIndex.remove(m_entries.at(last).serial);
         m_entries.removeLast();
         endRemoveRows();
     }
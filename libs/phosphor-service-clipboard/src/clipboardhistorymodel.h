@@ -10,6 +10,7 @@
 // unit-tested with a fake source and no live compositor.
 
 #include "clipboardentry.h"
+#include "clipboardsearchindex.h"
 #include "iclipboardsource.h"
 
 #include <QAbstractListModel>
@@ -17,6 +18,8 @@
 #include <QList>
 #include <QPointer>
 
+#include <functional>
+
 namespace PhosphorServiceClipboard {
 
 class ClipboardHistoryModel : public QAbstractListModel
@@ -57,6 +60,26 @@ public:
     /// re-save).
     void setEntries(const QList<ClipboardEntry>& entries);
 
+    /// Drop the in-memory bytes of every non-sensitive entry, leaving the
+    /// metadata and `contentHash`. Called once the history is on disk, so
+    /// resident memory is bounded by the entry count rather than the payload
+    /// size; readers fetch the bytes back through the store. Sensitive entries
+    /// are never persisted and keep theirs.
+    void releasePersistedContent();
+
+    /// Reads an entry's bytes when the model needs them and the entry no longer
+    /// holds them (entries seeded from disk); the host wires this to the store.
+    using ContentReader = std::function<QByteArray(const ClipboardEntry&)>;
+    /// Set before setEntries() so loaded text entries can be indexed for search.
+    void setContentReader(ContentReader reader);
+
+    /// Rows whose text matches @p query, best first (see ClipboardSearchIndex
+    /// for the ranking), starting at @p offset for at most @p limit rows. The
+    /// index is maintained on every capture and removal, so this costs the
+    /// matching entries, not the history size. @p total, when non-null,
+    /// receives the full match count. Only text entries are searchable.
+    [[nodiscard]] QList<int> search(const QString& query, int offset, int limit, int* total = nullptr) const;
+
     /// Remove the entry at @p row. Out-of-range rows are ignored.
     void removeAt(int row);
     /// Remove every entry.
@@ -73,8 +96,10 @@ private:
     void onDataReceived(const QString& mimeType, const QByteArray& data);
     void startNextRead();
     void recordEntry(const QByteArray& content, const QString& mimeType, const QStringList& offeredTypes);
-    [[nodiscard]] int indexOfContent(const QByteArray& content, const QString& mimeType) const;
+    [[nodiscard]] int indexOfContent(const QString& contentHash, const QString& mimeType) const;
     void enforceCap();
+    void indexEntry(const ClipboardEntry& entry);
+    [[nodiscard]] int rowOfSerial(quint64 serial) const;
 
     [[nodiscard]] static QString preferredMimeType(const QStringList& mimeTypes);
     [[nodiscard]] static bool isSensitive(const QStringList& mimeTypes);
@@ -83,6 +108,9 @@ private:
     QPointer<IClipboardSource> m_source;
     QList<ClipboardEntry> m_entries;
     int m_maxEntries = 100;
+    quint64 m_nextSerial = 1;
+    ClipboardSearchIndex m_searchIndex;
+    ContentReader m_contentReader;
 
     // Reads are serialized so an async delivery is never mis-attributed: at most
     // one receive() is outstanding at a time. `m_latestTypes` is the most recent
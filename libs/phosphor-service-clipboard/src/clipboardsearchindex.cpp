@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "clipboardsearchindex.h"
+
+#include <algorithm>
+
+namespace PhosphorServiceClipboard {
+
+namespace {
+// Rank tiers, best first.
+enum Rank : int {
+    Fuzzy = 0,
+    Contains = 1,
+    Prefix = 2,
+};
+
+struct Hit
+{
+    quint64 id;
+    int rank;
+    int shared; // query trigrams the entry contains
+};
+
+bool ranksBefore(const Hit& a, const Hit& b)
+{
+    if (a.rank != b.rank)
+        return a.rank > b.rank;
+    if (a.shared != b.shared)
+        return a.shared > b.shared;
+    return a.id > b.id;
+}
+
+int rankOf(QStringView text, QStringView query)
+{
+    if (text.startsWith(query))
+        return Prefix;
+    if (text.contains(query))
+        return Contains;
+    return Fuzzy;
+}
+} // namespace
+
+QString ClipboardSearchIndex::fold(QStringView text)
+{
+    // Fold a bounded head: simplified() over a multi-megabyte paste would cost
+    // far more than the index saves. Over-take so whitespace collapsing still
+    // leaves MaxIndexedChars of content.
+    QString folded = text.left(2 * MaxIndexedChars).toString().toCaseFolded().simplified();
+    folded.truncate(MaxIndexedChars);
+    return folded;
+}
+
+std::vector<ClipboardSearchIndex::Trigram> ClipboardSearchIndex::trigrams(QStringView folded)
+{
+    std::vector<Trigram> grams;
+    if (folded.size() < 3)
+        return grams;
+    grams.reserve(folded.size() - 2);
+    for (qsizetype i = 0; i + 2 < folded.size(); ++i) {
+        grams.push_back((Trigram(folded[i].unicode()) << 32) | (Trigram(folded[i + 1].unicode()) << 16)
+                        | Trigram(folded[i + 2].unicode()));
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+void ClipboardSearchIndex::insert(quint64 id, QStringView text)
+{
+    remove(id);
+    const QString folded = fold(text);
+    for (const Trigram gram : trigrams(folded)) {
+        std::vector<quint64>& ids = m_postings[gram];
+        // Captures arrive newest-last, so this is almost always an append.
+        if (ids.empty() || ids.back() < id)
+            ids.push_back(id);
+        else
+            ids.insert(std::lower_bound(ids.begin(), ids.end(), id), id);
+    }
+    m_texts.insert(id, folded);
+}
+
+void ClipboardSearchIndex::remove(quint64 id)
+{
+    const auto it = m_texts.constFind(id);
+    if (it == m_texts.cend())
+        return;
+    for (const Trigram gram : trigrams(*it)) {
+        const auto posting = m_postings.find(gram);
+        if (posting == m_postings.end())
+            continue;
+        std::vector<quint64>& ids = *posting;
+        const auto at = std::lower_bound(ids.begin(), ids.end(), id);
+        if (at != ids.end() && *at == id)
+            ids.erase(at);
+        if (ids.empty())
+            m_postings.erase(posting);
+    }
+    m_texts.erase(it);
+}
+
+void ClipboardSearchIndex::clear()
+{
+    m_texts.clear();
+    m_postings.clear();
+}
+
+qsizetype ClipboardSearchIndex::size() const
+{
+    return m_texts.size();
+}
+
+QList<quint64> ClipboardSearchIndex::search(QStringView query, qsizetype offset, qsizetype limit,
+                                            qsizetype* total) const
+{
+    const QString q = fold(query);
+    std::vector<Hit> hits;
+
+    if (q.size() < 3) {
+        // No trigram to look up; a short query is a plain substring scan.
+        if (!q.isEmpty()) {
+            for (auto it = m_texts.cbegin(); it != m_texts.cend(); ++it) {
+                if (it->contains(q))
+                    hits.push_back({it.key(), rankOf(*it, q), 0});
+            }
+        }
+    } else {
+        const std::vector<Trigram> grams = trigrams(q);
+        const int n = int(grams.size());
+        // Fuzzy threshold: an entry must share ~60% of the query's trigrams,
+        // which tolerates a typo or two without matching noise.
+        const int required = n - n * 2 / 5;
+
+        std::vector<const std::vector<quint64>*> lists;
+        lists.reserve(n);
+        static const std::vector<quint64> kEmpty;
+        for (const Trigram gram : grams) {
+            const auto posting = m_postings.constFind(gram);
+            lists.push_back(posting == m_postings.cend() ? &kEmpty : &*posting);
+        }
+        std::sort(lists.begin(), lists.end(), [](const auto* a, const auto* b) {
+            return a->size() < b->size();
+        });
+
+        // Pigeonhole: an entry in at least `required` lists must be in one of
+        // the (n - required + 1) rarest, so only those seed candidates; the
+        // common trigrams are then probed by binary search, never walked.
+        std::vector<quint64> candidates;
+        for (int i = 0; i < n - required + 1; ++i)
+            candidates.insert(candidates.end(), lists[i]->begin(), lists[i]->end());
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+        for (const quint64 id : candidates) {
+            int shared = 0;
+            for (const auto* list : lists) {
+                if (std::binary_search(list->begin(), list->end(), id))
+                    ++shared;
+            }
+            if (shared < required)
+                continue;
+            // Only an entry holding every trigram can contain the query.
+            const int rank = shared == n ? rankOf(m_texts.value(id), q) : Fuzzy;
+            hits.push_back({id, rank, shared});
+        }
+    }
+
+    if (total)
+        *total = qsizetype(hits.size());
+    const qsizetype begin = std::clamp<qsizetype>(offset, 0, hits.size());
+    const qsizetype end = limit < 0 ? qsizetype(hits.size()) : std::min<qsizetype>(hits.size(), begin + limit);
+    // Order only as far as the requested page reaches.
+    std::partial_sort(hits.begin(), hits.begin() + end, hits.end(), ranksBefore);
+
+    QList<quint64> page;
+    page.reserve(end - begin);
+    for (qsizetype i = begin; i < end; ++i)
+        page.append(hits[i].id);
+    return page;
+}
+
+} // namespace PhosphorServiceClipboard
@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+// Internal (not installed) incremental search index over the text entries of the
+// clipboard history. A picker filtering a large history in QML walks every
+// entry's text on every keystroke; this keeps a trigram posting list per
+// three-character sequence instead, updated one entry at a time as the history
+// model captures and evicts, so a query touches only the entries that share its
+// rarest trigrams. Pure data structure, unit-tested on its own.
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringView>
+
+#include <vector>
+
+namespace PhosphorServiceClipboard {
+
+class ClipboardSearchIndex
+{
+public:
+    /// Only the first this-many (folded) characters of an entry are indexed,
+    /// bounding the index per entry whatever was pasted.
+    static constexpr int MaxIndexedChars = 1024;
+
+    /// Index @p text under @p id, replacing anything already indexed for it.
+    /// Ids are caller-assigned and compared for recency: higher is newer.
+    void insert(quint64 id, QStringView text);
+    void remove(quint64 id);
+    void clear();
+    [[nodiscard]] qsizetype size() const;
+
+    /// Ids matching @p query, best first, from @p offset for at most @p limit
+    /// results (a negative limit means all); @p total, when non-null, receives
+    /// the full match count for pagination. Ranking: entries starting with the
+    /// query, then containing it, then fuzzy matches sharing most of its
+    /// trigrams; newest first within a rank. Queries under three characters
+    /// have no trigram and fall back to a substring scan. An empty query
+    /// matches nothing.
+    [[nodiscard]] QList<quint64> search(QStringView query, qsizetype offset, qsizetype limit,
+                                        qsizetype* total = nullptr) const;
+
+    /// Case-fold, collapse whitespace runs and truncate to MaxIndexedChars —
+    /// the normalization both entries and queries go through.
+    [[nodiscard]] static QString fold(QStringView text);
+
+private:
+    using Trigram = quint64;
+
+    [[nodiscard]] static std::vector<Trigram> trigrams(QStringView folded);
+
+    // Folded, truncated text per id: verifies substring ranks, serves short
+    // queries, and re-derives an entry's trigrams on removal.
+    QHash<quint64, QString> m_texts;
+    // Ids containing each trigram, ascending.
+    QHash<Trigram, std::vector<quint64>> m_postings;
+};
+
+} // namespace PhosphorServiceClipboard
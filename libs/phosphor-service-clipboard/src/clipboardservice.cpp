@@ -8,16 +8,67 @@
 #include "waylandclipboardsource.h"
 
 #include <QByteArray>
+#include <QFutureWatcher>
 #include <QMap>
+#include <QTimer>
+#include <QVariantMap>
+#include <QtConcurrent>
 
 namespace PhosphorServiceClipboard {
 
+namespace {
+constexpr int kCompactionDelayMs = 30 * 1000;
+} // namespace
+
 class ClipboardService::Private
 {
 public:
     ClipboardHistoryModel model;
     ClipboardStore store{ClipboardStore::defaultDirectory()};
     WaylandClipboardSource source;
+    // Deferred log compaction: a save only appends, and the rewrite runs once
+    // the clipboard has been quiet for a while rather than on a copy, on a
+    // pool thread. Saves wait for it (saveDue) since they would append to the
+    // log it is replacing.
+    QTimer compactTimer;
+    QFutureWatcher<bool> compaction;
+    ClipboardStore::CompactionJob compactionJob;
+    bool saveDue = false;
+
+    ~Private()
+    {
+        // The job holds only value copies, but a rewrite must not outlive
+        // the store that would otherwise start appending after it.
+        compaction.waitForFinished();
+    }
+
+    void scheduleCompaction()
+    {
+        if (store.needsCompaction() && !compaction.isRunning())
+            compactTimer.start();
+    }
+
+    void startCompaction()
+    {
+        compactionJob = store.prepareCompaction();
+        compaction.setFuture(QtConcurrent::run([job = compactionJob] {
+            return ClipboardStore::runCompaction(job);
+        }));
+    }
+
+    void save()
+    {
+        if (compaction.isRunning()) {
+            saveDue = true;
+            return;
+        }
+        saveDue = false;
+        // Once the entries are on disk their bytes live in the blobs; keep
+        // only metadata resident. On a failed save they stay in memory.
+        if (store.save(model.entries()))
+            model.releasePersistedContent();
+        scheduleCompaction();
+    }
 };
 
 ClipboardService::ClipboardService(QObject* parent)
@@ -25,13 +76,31 @@ ClipboardService::ClipboardService(QObject* parent)
     , d(std::make_unique<Private>())
 {
     // Seed from disk first (setEntries does not emit historyChanged, so this does
-    // not trigger an immediate re-save), then watch the live clipboard.
+    // not trigger an immediate re-save), then watch the live clipboard. Loaded
+    // entries hold no bytes; the search index reads a bounded head of each text
+    // blob once, here, and is kept current from captures afterwards.
+    d->model.setContentReader([this](const ClipboardEntry& entry) {
+        return d->store.readContent(entry, 8 * ClipboardSearchIndex::MaxIndexedChars);
+    });
     d->model.setEntries(d->store.load());
     d->model.setSource(&d->source);
 
+    d->compactTimer.setSingleShot(true);
+    d->compactTimer.setInterval(kCompactionDelayMs);
+    connect(&d->compactTimer, &QTimer::timeout, this, [this] {
+        d->startCompaction();
+    });
+    connect(&d->compaction, &QFutureWatcher<bool>::finished, this, [this] {
+        d->store.finishCompaction(d->compactionJob, d->compaction.result());
+        d->compactionJob = {};
+        if (d->saveDue)
+            d->save();
+    });
+    d->scheduleCompaction();
+
     connect(&d->model, &ClipboardHistoryModel::countChanged, this, &ClipboardService::countChanged);
     connect(&d->model, &ClipboardHistoryModel::historyChanged, this, [this] {
-        d->store.save(d->model.entries());
+        d->save();
     });
 }
 
@@ -55,11 +124,25 @@ int ClipboardService::count() const
 void ClipboardService::copy(int index)
 {
     const ClipboardEntry entry = d->model.entryAt(index);
-    if (entry.content.isEmpty() || entry.mimeType.isEmpty())
+    if (entry.mimeType.isEmpty())
+        return;
+    // Persisted entries hold no bytes in memory; read the blob on demand.
+    const QByteArray content = d->store.readContent(entry);
+    if (content.isEmpty())
         return;
     // Re-offer the materialized type. A loopback selection event re-reads it, but
     // dedup just moves the entry to the front rather than duplicating it.
-    d->source.setSelection({{entry.mimeType, entry.content}});
+    d->source.setSelection({{entry.mimeType, content}});
+}
+
+QVariantMap ClipboardService::search(const QString& query, int offset, int limit) const
+{
+    int total = 0;
+    const QList<int> rows = d->model.search(query, offset, limit, &total);
+    return {
+        {QStringLiteral("rows"), QVariant::fromValue(rows)},
+        {QStringLiteral("total"), total},
+    };
 }
 
 void ClipboardService::remove(int index)
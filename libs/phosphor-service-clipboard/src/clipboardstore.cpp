@@ -3,13 +3,12 @@
 
 #include "clipboardstore.h"
 
-#include <QCryptographicHash>
 #include <QDateTime>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QJsonArray>
 #include <QJsonDocument>
-#include <QJsonObject>
 #include <QSaveFile>
 #include <QSet>
 #include <QStandardPaths>
@@ -19,16 +18,16 @@
 namespace PhosphorServiceClipboard {
 
 namespace {
-// Upper bound on a single blob we read back into memory on load. Blobs we write
-// are already bounded (the live read path caps payload size), so a blob larger
-// than this is corrupt or tampered; skip it rather than load it and risk
-// exhausting memory at startup.
+// Upper bound on a single blob we read back into memory. Blobs we write are
+// already bounded (the live read path caps payload size), so a blob larger than
+// this is corrupt or tampered; skip it rather than load it and risk exhausting
+// memory.
 constexpr qint64 kMaxBlobBytes = 100 * 1024 * 1024; // 100 MiB
 
-QString blobHash(const QByteArray& content)
-{
-    return QString::fromLatin1(QCryptographicHash::hash(content, QCryptographicHash::Sha256).toHex());
-}
+// compact() is worth it once the log holds this many records beyond twice the
+// live entry count: each copy appends one `add`, so with the default 100-entry
+// cap that is a rewrite every ~160 copies, of metadata only.
+constexpr int kCompactionSlack = 64;
 
 // A blob filename is always a SHA-256 hex digest on the write path. Validate the
 // index's `blob` field against that contract on read so a tampered index can
@@ -62,6 +61,58 @@ bool atomicWrite(const QString& path, const QByteArray& bytes)
     QFile::setPermissions(path, QFileDevice::ReadOwner | QFileDevice::WriteOwner);
     return true;
 }
+
+QJsonObject fieldsFor(const ClipboardEntry& entry, const QString& hash)
+{
+    QJsonObject obj;
+    obj.insert(QLatin1String("mime"), entry.mimeType);
+    obj.insert(QLatin1String("offered"), QJsonArray::fromStringList(entry.offeredTypes));
+    obj.insert(QLatin1String("preview"), entry.preview);
+    obj.insert(QLatin1String("timestamp"), static_cast<double>(entry.timestamp.toMSecsSinceEpoch()));
+    obj.insert(QLatin1String("blob"), hash);
+    return obj;
+}
+
+ClipboardEntry entryFrom(const QJsonObject& obj)
+{
+    ClipboardEntry entry;
+    entry.contentHash = obj.value(QLatin1String("blob")).toString();
+    entry.mimeType = obj.value(QLatin1String("mime")).toString();
+    const QJsonArray offered = obj.value(QLatin1String("offered")).toArray();
+    for (const QJsonValue& type : offered)
+        entry.offeredTypes.append(type.toString());
+    entry.preview = obj.value(QLatin1String("preview")).toString();
+    entry.timestamp =
+        QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(obj.value(QLatin1String("timestamp")).toDouble()));
+    entry.sensitive = false; // sensitive entries are never persisted.
+    return entry;
+}
+
+QByteArray recordKey(const QJsonObject& fields)
+{
+    // Content-addressed: the timestamp, preview and offered types describe the
+    // latest capture of these bytes, not which entry it is.
+    return fields.value(QLatin1String("blob")).toString().toLatin1() + '\n'
+        + fields.value(QLatin1String("mime")).toString().toUtf8();
+}
+
+QByteArray logLine(QLatin1String op, const QJsonObject& fields = {})
+{
+    QJsonObject record;
+    record.insert(QLatin1String("op"), op);
+    if (!fields.isEmpty())
+        record.insert(QLatin1String("entry"), fields);
+    return QJsonDocument(record).toJson(QJsonDocument::Compact) + '\n';
+}
+
+qsizetype indexOfKey(const auto& records, const QByteArray& key)
+{
+    for (qsizetype i = 0; i < records.size(); ++i) {
+        if (records.at(i).key == key)
+            return i;
+    }
+    return -1;
+}
 } // namespace
 
 ClipboardStore::ClipboardStore(QString directory)
@@ -75,7 +126,12 @@ QString ClipboardStore::defaultDirectory()
         .filePath(QStringLiteral("phosphor-clipboard"));
 }
 
-QString ClipboardStore::indexPath() const
+QString ClipboardStore::logPath() const
+{
+    return QDir(m_directory).filePath(QStringLiteral("index.log"));
+}
+
+QString ClipboardStore::legacyIndexPath() const
 {
     return QDir(m_directory).filePath(QStringLiteral("index.json"));
 }
@@ -85,48 +141,83 @@ QString ClipboardStore::blobsDir() const
     return QDir(m_directory).filePath(QStringLiteral("blobs"));
 }
 
-QList<ClipboardEntry> ClipboardStore::load() const
+void ClipboardStore::replay()
 {
-    QList<ClipboardEntry> entries;
+    m_live.clear();
+    m_logRecords = 0;
+    m_needsSnapshot = false;
 
-    QFile index(indexPath());
-    if (!index.open(QIODevice::ReadOnly))
-        return entries; // first run or unreadable: empty history.
-
-    const QJsonDocument doc = QJsonDocument::fromJson(index.readAll());
-    if (!doc.isArray())
-        return entries;
+    QFile log(logPath());
+    if (log.open(QIODevice::ReadOnly)) {
+        const QList<QByteArray> lines = log.readAll().split('\n');
+        for (const QByteArray& line : lines) {
+            if (line.isEmpty())
+                continue;
+            // A line that does not parse is a write torn by a crash (only ever
+            // the last one); skip it and keep the rest of the history.
+            const QJsonDocument doc = QJsonDocument::fromJson(line);
+            if (!doc.isObject())
+                continue;
+            ++m_logRecords;
+            const QJsonObject record = doc.object();
+            const QString op = record.value(QLatin1String("op")).toString();
+            if (op == QLatin1String("clear")) {
+                m_live.clear();
+                continue;
+            }
+            const QJsonObject fields = record.value(QLatin1String("entry")).toObject();
+            const QByteArray key = recordKey(fields);
+            if (const qsizetype at = indexOfKey(m_live, key); at >= 0)
+                m_live.removeAt(at);
+            if (op == QLatin1String("add") && isValidBlobHash(fields.value(QLatin1String("blob")).toString()))
+                m_live.prepend(Record{key, fields});
+        }
+    } else {
+        // No log yet: read the snapshot-style index.json earlier versions wrote.
+        QFile index(legacyIndexPath());
+        if (index.open(QIODevice::ReadOnly)) {
+            const QJsonDocument doc = QJsonDocument::fromJson(index.readAll());
+            const QJsonArray array = doc.array();
+            for (const QJsonValue& value : array) {
+                const QJsonObject fields = value.toObject();
+                if (!isValidBlobHash(fields.value(QLatin1String("blob")).toString()))
+                    continue; // missing or tampered blob reference: skip.
+                m_live.append(Record{recordKey(fields), fields});
+            }
+            m_needsSnapshot = !m_live.isEmpty();
+        }
+    }
 
+    // A missing blob means a corrupt entry, an oversize one a corrupt or
+    // tampered one; drop both. A stat per entry — the bytes stay on disk.
     const QDir blobs(blobsDir());
-    const QJsonArray array = doc.array();
-    entries.reserve(array.size());
-    for (const QJsonValue& value : array) {
-        const QJsonObject obj = value.toObject();
-        const QString hash = obj.value(QLatin1String("blob")).toString();
-        if (!isValidBlobHash(hash))
-            continue; // missing or tampered blob reference: skip.
-        QFile blob(blobs.filePath(hash));
-        if (!blob.open(QIODevice::ReadOnly))
-            continue; // a missing blob means a corrupt entry; skip it.
-        if (blob.size() > kMaxBlobBytes)
-            continue; // corrupt or tampered oversize blob; skip it.
-
-        ClipboardEntry entry;
-        entry.content = blob.readAll();
-        entry.mimeType = obj.value(QLatin1String("mime")).toString();
-        const QJsonArray offered = obj.value(QLatin1String("offered")).toArray();
-        for (const QJsonValue& type : offered)
-            entry.offeredTypes.append(type.toString());
-        entry.preview = obj.value(QLatin1String("preview")).toString();
-        entry.timestamp =
-            QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(obj.value(QLatin1String("timestamp")).toDouble()));
-        entry.sensitive = false; // sensitive entries are never persisted.
-        entries.append(entry);
+    m_live.removeIf([&blobs](const Record& record) {
+        const QFileInfo blob(blobs.filePath(record.fields.value(QLatin1String("blob")).toString()));
+        return !blob.isFile() || blob.size() > kMaxBlobBytes;
+    });
+}
+
+void ClipboardStore::ensureLoaded()
+{
+    if (!m_loaded) {
+        replay();
+        m_loaded = true;
     }
+}
+
+QList<ClipboardEntry> ClipboardStore::load()
+{
+    replay();
+    m_loaded = true;
+
+    QList<ClipboardEntry> entries;
+    entries.reserve(m_live.size());
+    for (const Record& record : std::as_const(m_live))
+        entries.append(entryFrom(record.fields));
     return entries;
 }
 
-bool ClipboardStore::save(const QList<ClipboardEntry>& entries) const
+bool ClipboardStore::prepareDirectories() const
 {
     QDir dir(m_directory);
     if (!dir.mkpath(QStringLiteral(".")) || !dir.mkpath(QStringLiteral("blobs")))
@@ -138,43 +229,225 @@ bool ClipboardStore::save(const QList<ClipboardEntry>& entries) const
         QFileDevice::ReadOwner | QFileDevice::WriteOwner | QFileDevice::ExeOwner;
     QFile::setPermissions(m_directory, ownerOnlyDir);
     QFile::setPermissions(blobsDir(), ownerOnlyDir);
+    return true;
+}
+
+bool ClipboardStore::appendRecords(const QByteArray& lines)
+{
+    // If a crash tore the previous append, start on a fresh line so this
+    // record does not fuse with the torn one and get skipped along with it.
+    QByteArray bytes = lines;
+    {
+        QFile tail(logPath());
+        if (tail.open(QIODevice::ReadOnly) && tail.size() > 0 && tail.seek(tail.size() - 1) && tail.read(1) != "\n")
+            bytes.prepend('\n');
+    }
+
+    QFile log(logPath());
+    const bool created = !log.exists();
+    if (!log.open(QIODevice::WriteOnly | QIODevice::Append))
+        return false;
+    if (created)
+        QFile::setPermissions(logPath(), QFileDevice::ReadOwner | QFileDevice::WriteOwner);
+    if (log.write(bytes) != bytes.size())
+        return false;
+    return log.flush();
+}
 
+void ClipboardStore::removeUnreferencedBlobs(const QList<QString>& candidates) const
+{
+    if (candidates.isEmpty())
+        return;
+    QSet<QString> live;
+    for (const Record& record : m_live)
+        live.insert(record.fields.value(QLatin1String("blob")).toString());
     const QDir blobs(blobsDir());
+    for (const QString& hash : candidates) {
+        if (!live.contains(hash))
+            QFile::remove(blobs.filePath(hash));
+    }
+}
 
-    QJsonArray array;
-    QSet<QString> liveHashes;
+bool ClipboardStore::save(const QList<ClipboardEntry>& entries)
+{
+    ensureLoaded();
+    if (!prepareDirectories())
+        return false;
+
+    QSet<QByteArray> persistedKeys;
+    for (const Record& record : std::as_const(m_live))
+        persistedKeys.insert(record.key);
+
+    const QDir blobs(blobsDir());
+    QList<Record> next;
+    QSet<QByteArray> nextKeys;
     for (const ClipboardEntry& entry : entries) {
         if (entry.sensitive)
             continue; // defence in depth: secrets never hit the disk.
-        const QString hash = blobHash(entry.content);
-        liveHashes.insert(hash);
+        // The hash is taken at capture; only entries built elsewhere (tests,
+        // older callers) pay for hashing here.
+        const QString hash = entry.contentHash.isEmpty() ? ClipboardEntry::hashContent(entry.content)
+                                                         : entry.contentHash;
+        if (!isValidBlobHash(hash))
+            continue;
+        const QJsonObject fields = fieldsFor(entry, hash);
+        const QByteArray key = recordKey(fields);
+        if (nextKeys.contains(key))
+            continue;
+
+        // A persisted record's blob is already on disk. A new one needs its
+        // bytes written first, so the log never references a missing blob.
+        if (!persistedKeys.contains(key)) {
+            const QString blobPath = blobs.filePath(hash);
+            if (!QFile::exists(blobPath)) {
+                if (entry.content.isEmpty())
+                    continue; // released content with no blob: nothing to persist.
+                if (!atomicWrite(blobPath, entry.content))
+                    return false;
+            }
+        }
+        nextKeys.insert(key);
+        next.append(Record{key, fields});
+    }
+
+    // A legacy index converts with one snapshot write rather than replaying
+    // the whole list into the log.
+    if (m_needsSnapshot) {
+        QList<QString> dropped;
+        for (const Record& record : std::as_const(m_live))
+            dropped.append(record.fields.value(QLatin1String("blob")).toString());
+        m_live = next;
+        if (!compact())
+            return false;
+        removeUnreferencedBlobs(dropped);
+        return true;
+    }
 
-        const QString blobPath = blobs.filePath(hash);
-        if (!QFile::exists(blobPath)) {
-            if (!atomicWrite(blobPath, entry.content))
-                return false;
+    // Express the change as log records. Entries missing from `next` are
+    // removed; what remains of the old order must then be a suffix of `next`,
+    // with everything before that suffix (new captures, or entries moved to the
+    // front) added newest-last. A copy is one `add`; a cap eviction one
+    // `remove`; an arbitrary reorder degrades to re-adding the whole list.
+    QByteArray lines;
+    int records = 0;
+    QList<QString> droppedHashes;
+    QList<Record> remaining;
+    if (next.isEmpty() && !m_live.isEmpty()) {
+        lines += logLine(QLatin1String("clear"));
+        ++records;
+        for (const Record& record : std::as_const(m_live))
+            droppedHashes.append(record.fields.value(QLatin1String("blob")).toString());
+    } else {
+        for (const Record& record : std::as_const(m_live)) {
+            if (nextKeys.contains(record.key)) {
+                remaining.append(record);
+            } else {
+                lines += logLine(QLatin1String("remove"), record.fields);
+                ++records;
+                droppedHashes.append(record.fields.value(QLatin1String("blob")).toString());
+            }
         }
+    }
 
-        QJsonObject obj;
-        obj.insert(QLatin1String("mime"), entry.mimeType);
-        obj.insert(QLatin1String("offered"), QJsonArray::fromStringList(entry.offeredTypes));
-        obj.insert(QLatin1String("preview"), entry.preview);
-        obj.insert(QLatin1String("timestamp"), static_cast<double>(entry.timestamp.toMSecsSinceEpoch()));
-        obj.insert(QLatin1String("blob"), hash);
-        array.append(obj);
+    qsizetype front = 0;
+    QSet<QByteArray> moved;
+    for (; front < next.size(); moved.insert(next.at(front).key), ++front) {
+        // Does next[front..] equal `remaining` minus the entries in next[0..front)?
+        qsizetype n = front;
+        bool matches = true;
+        for (const Record& record : std::as_const(remaining)) {
+            if (moved.contains(record.key))
+                continue;
+            // An entry whose metadata changed in place is re-added too.
+            if (n >= next.size() || next.at(n).key != record.key || next.at(n).fields != record.fields) {
+                matches = false;
+                break;
+            }
+            ++n;
+        }
+        if (matches && n == next.size())
+            break;
+    }
+    for (qsizetype i = front - 1; i >= 0; --i) {
+        lines += logLine(QLatin1String("add"), next.at(i).fields);
+        ++records;
     }
 
-    if (!atomicWrite(indexPath(), QJsonDocument(array).toJson(QJsonDocument::Compact)))
+    if (records > 0 && !appendRecords(lines))
         return false;
+    m_live = next;
+    m_logRecords += records;
+    removeUnreferencedBlobs(droppedHashes);
+    return true;
+}
 
-    // Prune blobs no longer referenced by the current index.
+QByteArray ClipboardStore::readContent(const ClipboardEntry& entry, qint64 maxBytes) const
+{
+    if (!entry.content.isEmpty())
+        return maxBytes < 0 ? entry.content : entry.content.left(maxBytes);
+    if (!isValidBlobHash(entry.contentHash))
+        return {};
+    QFile blob(QDir(blobsDir()).filePath(entry.contentHash));
+    if (!blob.open(QIODevice::ReadOnly) || blob.size() > kMaxBlobBytes)
+        return {};
+    return maxBytes < 0 ? blob.readAll() : blob.read(maxBytes);
+}
+
+bool ClipboardStore::needsCompaction() const
+{
+    return m_needsSnapshot || m_logRecords > 2 * m_live.size() + kCompactionSlack;
+}
+
+bool ClipboardStore::compact()
+{
+    const CompactionJob job = prepareCompaction();
+    const bool written = runCompaction(job);
+    finishCompaction(job, written);
+    return written;
+}
+
+ClipboardStore::CompactionJob ClipboardStore::prepareCompaction()
+{
+    ensureLoaded();
+
+    CompactionJob job;
+    job.directory = m_directory;
+    job.records = int(m_live.size());
+    // Oldest first, so replaying the adds rebuilds most-recent-first order.
+    for (qsizetype i = m_live.size() - 1; i >= 0; --i) {
+        job.snapshot += logLine(QLatin1String("add"), m_live.at(i).fields);
+        job.liveBlobs.insert(m_live.at(i).fields.value(QLatin1String("blob")).toString());
+    }
+    return job;
+}
+
+bool ClipboardStore::runCompaction(const CompactionJob& job)
+{
+    // Paths and directory setup only; nothing here touches a live store.
+    const ClipboardStore paths(job.directory);
+    if (!paths.prepareDirectories())
+        return false;
+    if (!atomicWrite(paths.logPath(), job.snapshot))
+        return false;
+    QFile::remove(paths.legacyIndexPath());
+
+    // Sweep blobs nothing references: leftovers of a save interrupted between
+    // its blob write and its log append, or of entries dropped on load.
+    const QDir blobs(paths.blobsDir());
     const QStringList existing = blobs.entryList(QDir::Files | QDir::NoDotAndDotDot);
     for (const QString& name : existing) {
-        if (!liveHashes.contains(name))
+        if (!job.liveBlobs.contains(name))
             QFile::remove(blobs.filePath(name));
     }
-
     return true;
 }
 
+void ClipboardStore::finishCompaction(const CompactionJob& job, bool written)
+{
+    if (!written)
+        return;
+    m_logRecords = job.records;
+    m_needsSnapshot = false;
+}
+
 } // namespace PhosphorServiceClipboard
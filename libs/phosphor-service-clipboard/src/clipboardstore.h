@@ -4,14 +4,28 @@
 #pragma once
 
 // Internal (not installed) on-disk clipboard-history store. Persists the entry
-// list as a JSON index plus per-entry content blobs (cliphist-style) under a
-// directory, so history survives restarts. Sensitive entries are never written.
-// The directory is injectable so the round-trip is unit-tested against a temp dir
-// with no real user data.
+// list as an append-only index log plus per-entry content blobs (cliphist-style)
+// under a directory, so history survives restarts. Sensitive entries are never
+// written. The directory is injectable so the round-trip is unit-tested against a
+// temp dir with no real user data.
+//
+// The log holds one JSON record per line: `add` (insert or move an entry to the
+// front), `remove`, or `clear`, matched by content hash and MIME type, so a
+// re-copy that moves an entry up with a new timestamp is one `add`. A save
+// appends only the records that turn the
+// persisted list into the new one — typically a single `add` per copy — instead
+// of rewriting the whole index. Blobs are named by the entry's capture-time
+// SHA-256 and are only read when the bytes are needed (`readContent`), so a load
+// costs the index, not the history's payload. `compact()` rewrites the log as a
+// snapshot once it has grown well past the live entry count; its file I/O can
+// run on a worker thread through prepareCompaction() / runCompaction().
 
 #include "clipboardentry.h"
 
+#include <QByteArray>
+#include <QJsonObject>
 #include <QList>
+#include <QSet>
 #include <QString>
 
 namespace PhosphorServiceClipboard {
@@ -21,23 +35,81 @@ class ClipboardStore
 public:
     explicit ClipboardStore(QString directory);
 
-    /// Load persisted entries (most-recent first). Returns an empty list on
-    /// first run or when the index is missing / unreadable / corrupt.
-    [[nodiscard]] QList<ClipboardEntry> load() const;
+    /// Load persisted entries (most-recent first) with their `content` left
+    /// empty — fetch it with readContent(). Returns an empty list on first run
+    /// or when the index is missing / unreadable / corrupt. Reads a legacy
+    /// `index.json` when no log exists yet; the next save converts it.
+    [[nodiscard]] QList<ClipboardEntry> load();
 
     /// Persist @p entries (most-recent first), replacing the prior contents.
-    /// Sensitive entries are skipped. Writes are atomic (temp file + rename) and
-    /// orphaned content blobs are pruned. Returns false on a write failure.
-    bool save(const QList<ClipboardEntry>& entries) const;
+    /// Sensitive entries are skipped. Appends the difference to the log, writes
+    /// blobs that do not exist yet (atomic temp file + rename), and deletes blobs
+    /// no remaining entry references. Returns false on a write failure.
+    bool save(const QList<ClipboardEntry>& entries);
+
+    /// The bytes of @p entry: its in-memory `content` when present, otherwise
+    /// its blob read from disk. Empty when the blob is missing or invalid. A
+    /// non-negative @p maxBytes reads at most that much of the blob (indexing
+    /// needs only a head).
+    [[nodiscard]] QByteArray readContent(const ClipboardEntry& entry, qint64 maxBytes = -1) const;
+
+    /// True when the log carries enough superseded records that compact() is
+    /// worth running.
+    [[nodiscard]] bool needsCompaction() const;
+
+    /// Rewrite the log as a snapshot of the live entries (atomic) and drop any
+    /// blob nothing references. Returns false on a write failure.
+    bool compact();
+
+    /// What a compaction writes, copied out of the store so the rewrite can
+    /// run on another thread while the store keeps serving readContent().
+    struct CompactionJob
+    {
+        QString directory;
+        QByteArray snapshot;
+        QSet<QString> liveBlobs;
+        int records = 0;
+    };
+
+    /// compact() in three steps: prepareCompaction() on the owning thread,
+    /// runCompaction() (the file I/O) on any thread, then finishCompaction()
+    /// back on the owning thread with its result. No save() may run between
+    /// prepare and finish: it would append to the log being replaced.
+    [[nodiscard]] CompactionJob prepareCompaction();
+    static bool runCompaction(const CompactionJob& job);
+    void finishCompaction(const CompactionJob& job, bool written);
 
     /// The default user data directory, `~/.local/share/phosphor-clipboard`.
     [[nodiscard]] static QString defaultDirectory();
 
 private:
-    [[nodiscard]] QString indexPath() const;
+    // One persisted entry: its metadata record and its identity (content hash
+    // and MIME type), which `remove` and move-to-front match on.
+    struct Record
+    {
+        QByteArray key;
+        QJsonObject fields;
+    };
+
+    [[nodiscard]] QString logPath() const;
+    [[nodiscard]] QString legacyIndexPath() const;
     [[nodiscard]] QString blobsDir() const;
 
+    void ensureLoaded();
+    void replay();
+    bool prepareDirectories() const;
+    bool appendRecords(const QByteArray& lines);
+    void removeUnreferencedBlobs(const QList<QString>& candidates) const;
+
     QString m_directory;
+    // The persisted list as the log currently describes it (most-recent first);
+    // metadata only, so it stays small however large the blobs are.
+    QList<Record> m_live;
+    // Records in the log file, superseded ones included.
+    int m_logRecords = 0;
+    bool m_loaded = false;
+    // Loaded from a legacy index.json: the next save writes a full snapshot.
+    bool m_needsSnapshot = false;
 };
 
 } // namespace PhosphorServiceClipboard
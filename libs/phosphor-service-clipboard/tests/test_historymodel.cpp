@@ -121,6 +121,8 @@ private Q_SLOTS:
     void removeAtOutOfRangeIsNoOp();
     void setMaxEntriesBoundaries();
     void dataWithInvalidIndexIsEmpty();
+    void searchFollowsCaptureEvictionAndRemoval();
+    void searchIndexesLoadedEntriesThroughReader();
 };
 
 void ClipboardHistoryModelTest::startsEmpty()
@@ -467,5 +469,66 @@ void ClipboardHistoryModelTest::dataWithInvalidIndexIsEmpty()
     QVERIFY(!model.data(model.index(0), Qt::UserRole + 999).isValid()); // unknown role
 }
 
+void ClipboardHistoryModelTest::searchFollowsCaptureEvictionAndRemoval()
+{
+    FakeClipboardSource source;
+    ClipboardHistoryModel model;
+    model.setMaxEntries(3);
+    model.setSource(&source);
+
+    source.pushText(utf8("alpha report"));
+    source.pushText(utf8("beta report"));
+    source.pushText(utf8("gamma notes"));
+
+    int total = 0;
+    QCOMPARE(model.search(QStringLiteral("report"), 0, 10, &total), (QList<int>{1, 2}));
+    QCOMPARE(total, 2);
+
+    // Dedup moves "alpha report" to the front: the hit follows it to row 0.
+    source.pushText(utf8("alpha report"));
+    QCOMPARE(model.search(QStringLiteral("alpha"), 0, 10), QList<int>{0});
+
+    // A fourth entry evicts the oldest ("beta report").
+    source.pushText(utf8("delta report"));
+    QCOMPARE(model.search(QStringLiteral("report"), 0, 10, &total), (QList<int>{0, 1}));
+    QCOMPARE(total, 2);
+
+    model.removeAt(0);
+    QCOMPARE(model.search(QStringLiteral("delta"), 0, 10, &total), QList<int>());
+    QCOMPARE(total, 0);
+
+    model.clear();
+    QCOMPARE(model.search(QStringLiteral("alpha"), 0, 10), QList<int>());
+}
+
+void ClipboardHistoryModelTest::searchIndexesLoadedEntriesThroughReader()
+{
+    ClipboardHistoryModel model;
+    int reads = 0;
+    model.setContentReader([&reads](const ClipboardEntry& entry) {
+        ++reads;
+        return entry.preview.toUtf8();
+    });
+
+    // Loaded entries carry no bytes; the model asks the reader for text only.
+    QList<ClipboardEntry> seed;
+    const QStringList texts{QStringLiteral("newest line"), QStringLiteral("older line")};
+    for (const QString& text : texts) {
+        ClipboardEntry entry;
+        entry.mimeType = QStringLiteral("text/plain");
+        entry.preview = text;
+        seed.append(entry);
+    }
+    ClipboardEntry image;
+    image.mimeType = QStringLiteral("image/png");
+    image.preview = QStringLiteral("line");
+    seed.append(image);
+    model.setEntries(seed);
+
+    QCOMPARE(reads, 2);
+    QCOMPARE(model.search(QStringLiteral("line"), 0, 10), (QList<int>{0, 1}));
+    QCOMPARE(model.search(QStringLiteral("older"), 0, 10), QList<int>{1});
+}
+
 QTEST_GUILESS_MAIN(ClipboardHistoryModelTest)
 #include "test_historymodel.moc"
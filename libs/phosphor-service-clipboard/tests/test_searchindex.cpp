@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Unit test for the clipboard search index: ranking tiers, typo tolerance,
+// the short-query fallback, pagination, and incremental insert / remove. The
+// index is a pure data structure, so it is compiled directly with no model and
+// no compositor. The benchmark keeps a per-keystroke query over a large history
+// honest.
+
+#include "clipboardsearchindex.h"
+
+#include <QTest>
+
+using namespace PhosphorServiceClipboard;
+
+class ClipboardSearchIndexTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void emptyQueryMatchesNothing();
+    void ranksPrefixThenContainsThenFuzzy();
+    void newerFirstWithinRank();
+    void toleratesTypos();
+    void rejectsUnrelatedText();
+    void shortQueryFallsBackToSubstring();
+    void foldsCaseAndWhitespace();
+    void paginatesWithTotal();
+    void insertReplacesAndRemoveForgets();
+    void clearEmptiesIndex();
+    void benchmarkQueryOverLargeHistory();
+};
+
+void ClipboardSearchIndexTest::emptyQueryMatchesNothing()
+{
+    ClipboardSearchIndex index;
+    index.insert(1, u"anything");
+    qsizetype total = -1;
+    QVERIFY(index.search(u"", 0, 10, &total).isEmpty());
+    QCOMPARE(total, qsizetype(0));
+    QVERIFY(index.search(u"   ", 0, 10).isEmpty());
+}
+
+void ClipboardSearchIndexTest::ranksPrefixThenContainsThenFuzzy()
+{
+    ClipboardSearchIndex index;
+    index.insert(1, u"quarterly report due"); // prefix
+    index.insert(2, u"the quartrly report"); // fuzzy (typo in the entry)
+    index.insert(3, u"see the quarterly report"); // contains
+    QCOMPARE(index.search(u"quarterly report", 0, 10), (QList<quint64>{1, 3, 2}));
+}
+
+void ClipboardSearchIndexTest::newerFirstWithinRank()
+{
+    ClipboardSearchIndex index;
+    index.insert(1, u"see the invoice");
+    index.insert(2, u"old invoice");
+    index.insert(3, u"new invoice");
+    QCOMPARE(index.search(u"invoice", 0, 10), (QList<quint64>{3, 2, 1}));
+}
+
+void ClipboardSearchIndexTest::toleratesTypos()
+{
+    ClipboardSearchIndex index;
+    index.insert(1, u"https://example.org/configuration");
+    QCOMPARE(index.search(u"configuratoin", 0, 10), QList<quint64>{1});
+    QCOMPARE(index.search(u"example.org/configuratoin", 0, 10), QList<quint64>{1});
+}
+
+void ClipboardSearchIndexTest::rejectsUnrelatedText()
+{
+    ClipboardSearchIndex index;
+    index.insert(1, u"grocery list: milk, eggs");
+    index.insert(2, u"ssh user@host");
+    QVERIFY(index.search(u"configuration", 0, 10).isEmpty());
+}
+
+void ClipboardSearchIndexTest::shortQueryFallsBackToSubstring()
+{
+    ClipboardSearchIndex index;
+    index.insert(1, u"ab cd");
+    index.insert(2, u"xyz");
+    index.insert(3, u"cdef");
+    QCOMPARE(index.search(u"cd", 0, 10), (QList<quint64>{3, 1})); // prefix first
+    QCOMPARE(index.search(u"y", 0, 10), QList<quint64>{2});
+}
+
+void ClipboardSearchIndexTest::foldsCaseAndWhitespace()
+{
+    ClipboardSearchIndex index;
+    index.insert(1, u"Hello\n\n   World");
+    QCOMPARE(index.search(u"hello world", 0, 10), QList<quint64>{1});
+    QCOMPARE(index.search(u"WORLD", 0, 10), QList<quint64>{1});
+}
+
+void ClipboardSearchIndexTest::paginatesWithTotal()
+{
+    ClipboardSearchIndex index;
+    for (quint64 id = 1; id <= 25; ++id)
+        index.insert(id, QStringLiteral("entry number %1").arg(id));
+
+    qsizetype total = 0;
+    const QList<quint64> first = index.search(u"entry", 0, 10, &total);
+    QCOMPARE(total, qsizetype(25));
+    QCOMPARE(first.size(), qsizetype(10));
+    QCOMPARE(first.first(), quint64(25));
+
+    const QList<quint64> last = index.search(u"entry", 20, 10, &total);
+    QCOMPARE(total, qsizetype(25));
+    QCOMPARE(last, (QList<quint64>{5, 4, 3, 2, 1}));
+
+    QVERIFY(index.search(u"entry", 40, 10).isEmpty());
+    QCOMPARE(index.search(u"entry", 0, -1).size(), qsizetype(25));
+}
+
+void ClipboardSearchIndexTest::insertReplacesAndRemoveForgets()
+{
+    ClipboardSearchIndex index;
+    index.insert(1, u"first text");
+    index.insert(1, u"second text");
+    QCOMPARE(index.size(), qsizetype(1));
+    QVERIFY(index.search(u"first", 0, 10).isEmpty());
+    QCOMPARE(index.search(u"second", 0, 10), QList<quint64>{1});
+
+    index.insert(2, u"second helping");
+    index.remove(1);
+    index.remove(99); // unknown id is a no-op
+    QCOMPARE(index.size(), qsizetype(1));
+    QCOMPARE(index.search(u"second", 0, 10), QList<quint64>{2});
+}
+
+void ClipboardSearchIndexTest::clearEmptiesIndex()
+{
+    ClipboardSearchIndex index;
+    index.insert(1, u"some text");
+    index.clear();
+    QCOMPARE(index.size(), qsizetype(0));
+    QVERIFY(index.search(u"some", 0, 10).isEmpty());
+}
+
+void ClipboardSearchIndexTest::benchmarkQueryOverLargeHistory()
+{
+    ClipboardSearchIndex index;
+    for (quint64 id = 1; id <= 10000; ++id) {
+        index.insert(id,
+                     QStringLiteral("log line %1: request to /api/v2/items/%2 finished in %3 ms")
+                         .arg(id)
+                         .arg(id * 7919 % 100000)
+                         .arg(id % 997));
+    }
+    index.insert(10001, u"the one deployment checklist we need");
+
+    QList<quint64> hits;
+    QBENCHMARK {
+        hits = index.search(u"deploymnet checklist", 0, 50);
+    }
+    QCOMPARE(hits, QList<quint64>{10001});
+}
+
+QTEST_GUILESS_MAIN(ClipboardSearchIndexTest)
+#include "test_searchindex.moc"
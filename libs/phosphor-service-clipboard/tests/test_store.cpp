@@ -4,14 +4,19 @@
 // Unit test for the on-disk clipboard store. It round-trips entries through a
 // temporary directory (no real user data), pinning the persistence contract:
 // save/load fidelity for text and binary content, sensitive-entry exclusion,
-// orphan-blob pruning, and graceful empty/first-run behaviour.
+// orphan-blob pruning, and graceful empty/first-run behaviour; plus the
+// append-only log (one record per copy, compaction, torn-tail recovery, legacy
+// index.json conversion) and lazy content loading.
 
 #include "clipboardstore.h"
 
 #include <QDir>
+#include <QFile>
 #include <QTemporaryDir>
 #include <QTest>
 
+#include <thread>
+
 using namespace PhosphorServiceClipboard;
 
 namespace {
@@ -26,6 +31,14 @@ ClipboardEntry textEntry(const QByteArray& content, const QString& preview)
     entry.sensitive = false;
     return entry;
 }
+
+int logRecordCount(const QString& storePath)
+{
+    QFile log(QDir(storePath).filePath(QStringLiteral("index.log")));
+    if (!log.open(QIODevice::ReadOnly))
+        return 0;
+    return log.readAll().count('\n');
+}
 } // namespace
 
 class ClipboardStoreTest : public QObject
@@ -44,6 +57,13 @@ private Q_SLOTS:
     void tamperedBlobReferenceIsSkipped();
     void missingBlobFileIsSkipped();
     void identicalContentSharesOneBlob();
+    void loadLeavesContentOnDisk();
+    void captureAppendsOneRecord();
+    void captureHashNamesTheBlob();
+    void compactionRewritesSnapshot();
+    void compactionRunsOnAnotherThread();
+    void tornTailIsTolerated();
+    void legacyIndexIsConverted();
 };
 
 void ClipboardStoreTest::emptyOnFirstRun()
@@ -63,14 +83,15 @@ void ClipboardStoreTest::saveThenLoadRoundTrips()
     QVERIFY(ClipboardStore(path).save(entries));
 
     // A fresh store on the same directory reads them back, in order.
-    const QList<ClipboardEntry> loaded = ClipboardStore(path).load();
+    ClipboardStore reader(path);
+    const QList<ClipboardEntry> loaded = reader.load();
     QCOMPARE(loaded.size(), 2);
-    QCOMPARE(loaded.at(0).content, QByteArray("first"));
+    QCOMPARE(reader.readContent(loaded.at(0)), QByteArray("first"));
     QCOMPARE(loaded.at(0).preview, QStringLiteral("first"));
     QCOMPARE(loaded.at(0).mimeType, QStringLiteral("text/plain;charset=utf-8"));
     QCOMPARE(loaded.at(0).offeredTypes.size(), 2);
     QCOMPARE(loaded.at(0).timestamp.toMSecsSinceEpoch(), 1700000000000LL);
-    QCOMPARE(loaded.at(1).content, QByteArray("second"));
+    QCOMPARE(reader.readContent(loaded.at(1)), QByteArray("second"));
 }
 
 void ClipboardStoreTest::binaryContentRoundTrips()
@@ -85,9 +106,10 @@ void ClipboardStoreTest::binaryContentRoundTrips()
     image.timestamp = QDateTime::fromMSecsSinceEpoch(1700000001000LL);
 
     QVERIFY(ClipboardStore(path).save({image}));
-    const QList<ClipboardEntry> loaded = ClipboardStore(path).load();
+    ClipboardStore reader(path);
+    const QList<ClipboardEntry> loaded = reader.load();
     QCOMPARE(loaded.size(), 1);
-    QCOMPARE(loaded.at(0).content, image.content);
+    QCOMPARE(reader.readContent(loaded.at(0)), image.content);
     QCOMPARE(loaded.at(0).mimeType, QStringLiteral("image/png"));
 }
 
@@ -100,9 +122,10 @@ void ClipboardStoreTest::sensitiveEntryNotPersisted()
     secret.sensitive = true;
     QVERIFY(ClipboardStore(path).save({textEntry("public", QStringLiteral("public")), secret}));
 
-    const QList<ClipboardEntry> loaded = ClipboardStore(path).load();
+    ClipboardStore reader(path);
+    const QList<ClipboardEntry> loaded = reader.load();
     QCOMPARE(loaded.size(), 1);
-    QCOMPARE(loaded.at(0).content, QByteArray("public"));
+    QCOMPARE(reader.readContent(loaded.at(0)), QByteArray("public"));
     // The secret's bytes are nowhere on disk.
     const QDir blobs(QDir(path).filePath(QStringLiteral("blobs")));
     for (const QString& name : blobs.entryList(QDir::Files)) {
@@ -127,7 +150,7 @@ void ClipboardStoreTest::prunesOrphanBlobs()
     QCOMPARE(blobs.entryList(QDir::Files).size(), 1);
     const QList<ClipboardEntry> loaded = store.load();
     QCOMPARE(loaded.size(), 1);
-    QCOMPARE(loaded.at(0).content, QByteArray("a"));
+    QCOMPARE(store.readContent(loaded.at(0)), QByteArray("a"));
 }
 
 void ClipboardStoreTest::emptySaveClearsHistory()
@@ -217,7 +240,200 @@ void ClipboardStoreTest::identicalContentSharesOneBlob()
     QCOMPARE(blobs.entryList(QDir::Files).size(), 1);
     const QList<ClipboardEntry> loaded = store.load();
     QCOMPARE(loaded.size(), 1);
-    QCOMPARE(loaded.at(0).content, QByteArray("dup"));
+    QCOMPARE(store.readContent(loaded.at(0)), QByteArray("dup"));
+}
+
+void ClipboardStoreTest::loadLeavesContentOnDisk()
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath(QStringLiteral("store"));
+    QVERIFY(ClipboardStore(path).save({textEntry("payload", QStringLiteral("payload"))}));
+
+    // A load reads the index only: the bytes stay in the blob until asked for,
+    // so startup cost and resident memory do not scale with the payload.
+    ClipboardStore reader(path);
+    const QList<ClipboardEntry> loaded = reader.load();
+    QCOMPARE(loaded.size(), 1);
+    QVERIFY(loaded.at(0).content.isEmpty());
+    QCOMPARE(loaded.at(0).contentHash, ClipboardEntry::hashContent("payload"));
+    QCOMPARE(reader.readContent(loaded.at(0)), QByteArray("payload"));
+
+    // An entry that still holds its bytes is served from memory.
+    QCOMPARE(reader.readContent(textEntry("live", QStringLiteral("live"))), QByteArray("live"));
+}
+
+void ClipboardStoreTest::captureAppendsOneRecord()
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath(QStringLiteral("store"));
+
+    ClipboardStore store(path);
+    const ClipboardEntry a = textEntry("a", QStringLiteral("a"));
+    const ClipboardEntry b = textEntry("b", QStringLiteral("b"));
+    const ClipboardEntry c = textEntry("c", QStringLiteral("c"));
+    QVERIFY(store.save({b, a}));
+    QCOMPARE(logRecordCount(path), 2);
+
+    // A new capture at the front is one appended record, not a rewrite.
+    QVERIFY(store.save({c, b, a}));
+    QCOMPARE(logRecordCount(path), 3);
+
+    // Re-copying existing content moves it to the front as a new capture with
+    // a later timestamp: still one record, since records are keyed on the
+    // content. A cap eviction is one removal.
+    ClipboardEntry recopied = textEntry("a", QStringLiteral("a"));
+    recopied.timestamp = a.timestamp.addSecs(60);
+    QVERIFY(store.save({recopied, c}));
+    QCOMPARE(logRecordCount(path), 5);
+
+    // An unchanged list appends nothing.
+    QVERIFY(store.save({recopied, c}));
+    QCOMPARE(logRecordCount(path), 5);
+
+    ClipboardStore reader(path);
+    const QList<ClipboardEntry> loaded = reader.load();
+    QCOMPARE(loaded.size(), 2);
+    QCOMPARE(loaded.at(0).preview, QStringLiteral("a"));
+    QCOMPARE(loaded.at(0).timestamp, recopied.timestamp);
+    QCOMPARE(loaded.at(1).preview, QStringLiteral("c"));
+    // The evicted entry's blob went with it.
+    QCOMPARE(QDir(QDir(path).filePath(QStringLiteral("blobs"))).entryList(QDir::Files).size(), 2);
+}
+
+void ClipboardStoreTest::captureHashNamesTheBlob()
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath(QStringLiteral("store"));
+
+    // The hash taken at capture is used as-is: the store never re-hashes bytes
+    // it has been handed a digest for.
+    ClipboardEntry entry = textEntry("bytes", QStringLiteral("bytes"));
+    entry.contentHash = ClipboardEntry::hashContent("bytes");
+    QVERIFY(ClipboardStore(path).save({entry}));
+    const QDir blobs(QDir(path).filePath(QStringLiteral("blobs")));
+    QCOMPARE(blobs.entryList(QDir::Files), QStringList{entry.contentHash});
+
+    // A released entry (bytes dropped after persisting) saves by hash alone.
+    ClipboardStore store(path);
+    ClipboardEntry released = store.load().at(0);
+    QVERIFY(released.content.isEmpty());
+    const ClipboardEntry fresh = textEntry("fresh", QStringLiteral("fresh"));
+    QVERIFY(store.save({fresh, released}));
+    QCOMPARE(ClipboardStore(path).load().size(), 2);
+}
+
+void ClipboardStoreTest::compactionRewritesSnapshot()
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath(QStringLiteral("store"));
+
+    ClipboardStore store(path);
+    const ClipboardEntry a = textEntry("a", QStringLiteral("a"));
+    const ClipboardEntry b = textEntry("b", QStringLiteral("b"));
+    QVERIFY(store.save({b, a}));
+    QVERIFY(!store.needsCompaction());
+
+    // Copying back and forth between two entries grows the log without growing
+    // the history — exactly what compaction is for.
+    for (int i = 0; i < 100; ++i)
+        QVERIFY(store.save((i % 2) ? QList<ClipboardEntry>{b, a} : QList<ClipboardEntry>{a, b}));
+    QVERIFY(store.needsCompaction());
+    QVERIFY(logRecordCount(path) > 100);
+
+    QVERIFY(store.compact());
+    QVERIFY(!store.needsCompaction());
+    QCOMPARE(logRecordCount(path), 2);
+
+    ClipboardStore reader(path);
+    const QList<ClipboardEntry> loaded = reader.load();
+    QCOMPARE(loaded.size(), 2);
+    QCOMPARE(loaded.at(0).preview, QStringLiteral("b"));
+    QCOMPARE(loaded.at(1).preview, QStringLiteral("a"));
+}
+
+void ClipboardStoreTest::compactionRunsOnAnotherThread()
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath(QStringLiteral("store"));
+
+    ClipboardStore store(path);
+    const ClipboardEntry a = textEntry("a", QStringLiteral("a"));
+    const ClipboardEntry b = textEntry("b", QStringLiteral("b"));
+    for (int i = 0; i < 100; ++i)
+        QVERIFY(store.save((i % 2) ? QList<ClipboardEntry>{b, a} : QList<ClipboardEntry>{a, b}));
+    QVERIFY(store.needsCompaction());
+
+    // The rewrite works from the copied job alone, so the store can keep
+    // serving reads while it runs.
+    const QList<ClipboardEntry> loaded = store.load();
+    const ClipboardStore::CompactionJob job = store.prepareCompaction();
+    bool written = false;
+    std::thread worker([&job, &written] {
+        written = ClipboardStore::runCompaction(job);
+    });
+    QCOMPARE(store.readContent(loaded.at(0)), QByteArray("b"));
+    worker.join();
+    QVERIFY(written);
+    store.finishCompaction(job, written);
+    QVERIFY(!store.needsCompaction());
+    QCOMPARE(logRecordCount(path), 2);
+
+    // Saves after the finish append to the rewritten log.
+    const ClipboardEntry c = textEntry("c", QStringLiteral("c"));
+    QVERIFY(store.save({c, b, a}));
+    QCOMPARE(logRecordCount(path), 3);
+    QCOMPARE(ClipboardStore(path).load().size(), 3);
+}
+
+void ClipboardStoreTest::tornTailIsTolerated()
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath(QStringLiteral("store"));
+
+    QVERIFY(ClipboardStore(path).save({textEntry("a", QStringLiteral("a"))}));
+    // Simulate a crash mid-append: half a record, no trailing newline.
+    QFile log(QDir(path).filePath(QStringLiteral("index.log")));
+    QVERIFY(log.open(QIODevice::WriteOnly | QIODevice::Append));
+    log.write(R"({"op":"add","entry":{"blo)");
+    log.close();
+
+    // The torn record is skipped and the next append is not swallowed by it.
+    ClipboardStore store(path);
+    QCOMPARE(store.load().size(), 1);
+    QVERIFY(store.save({textEntry("b", QStringLiteral("b")), textEntry("a", QStringLiteral("a"))}));
+    const QList<ClipboardEntry> loaded = ClipboardStore(path).load();
+    QCOMPARE(loaded.size(), 2);
+    QCOMPARE(loaded.at(0).preview, QStringLiteral("b"));
+}
+
+void ClipboardStoreTest::legacyIndexIsConverted()
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath(QStringLiteral("store"));
+    QVERIFY(QDir().mkpath(QDir(path).filePath(QStringLiteral("blobs"))));
+    const QString hash = ClipboardEntry::hashContent("legacy");
+    QFile blob(QDir(path).filePath(QStringLiteral("blobs/") + hash));
+    QVERIFY(blob.open(QIODevice::WriteOnly));
+    blob.write("legacy");
+    blob.close();
+    QFile index(QDir(path).filePath(QStringLiteral("index.json")));
+    QVERIFY(index.open(QIODevice::WriteOnly));
+    index.write(QStringLiteral(R"([{"mime":"text/plain","preview":"legacy","timestamp":0,"blob":"%1"}])")
+                    .arg(hash)
+                    .toUtf8());
+    index.close();
+
+    // The snapshot index written before the log still loads...
+    ClipboardStore store(path);
+    const QList<ClipboardEntry> loaded = store.load();
+    QCOMPARE(loaded.size(), 1);
+    QCOMPARE(store.readContent(loaded.at(0)), QByteArray("legacy"));
+
+    // ...and the first save converts it to the log.
+    QVERIFY(store.save({textEntry("new", QStringLiteral("new")), loaded.at(0)}));
+    QVERIFY(!QFile::exists(QDir(path).filePath(QStringLiteral("index.json"))));
+    QCOMPARE(logRecordCount(path), 2);
+    QCOMPARE(ClipboardStore(path).load().size(), 2);
 }
 
 QTEST_GUILESS_MAIN(ClipboardStoreTest)
@@ -26,6 +26,14 @@ namespace PhosphorServiceIconTheme {
 /// active theme + inherited parents + Hicolor fallback, using the
 /// spec's distance algorithm to pick a size when no exact match
 /// exists.
+///
+/// Each theme is indexed once (icon name -> every size / scale / path
+/// it ships) from its directory listings, so a lookup is a hash probe
+/// rather than a stat() per candidate path across the Inherits= chain.
+/// The listings persist under the user cache dir keyed on directory
+/// mtimes, and the indexed directories are watched so an installed or
+/// removed icon is picked up without a restart. Decoded images are
+/// kept in a byte-budgeted LRU cache.
 class PHOSPHORSERVICEICONTHEME_EXPORT IconThemeResolver : public QObject
 {
     Q_OBJECT
@@ -61,6 +69,8 @@ public:
     [[nodiscard]] static QImage decodePixmaps(const QList<QPair<QSize, QByteArray>>& pixmaps, int size);
 
 Q_SIGNALS:
+    /// The active theme changed, or icons were added to / removed from
+    /// a watched theme directory; previously resolved icons may differ.
     void themeChanged();
 
 private:
@@ -15,6 +15,9 @@
  *   `image://phosphor-service-icontheme/` that holds a thread-safe
  *   `QImage` registry so models can hand QML a URL even when the
  *   payload is a raw bitmap rather than a file.
+ * - `ThemeIconImageProvider`, asynchronous provider mounted at
+ *   `image://phosphor-service-themeicon/` that resolves and decodes
+ *   theme icons by name on a bounded thread pool.
  *
  * Extracted from the legacy `phosphor-services` umbrella as part of
  * the Phase 2.0 split documented in
@@ -24,3 +27,4 @@
 #include <PhosphorServiceIconTheme/IconThemeResolver.h>
 #include <PhosphorServiceIconTheme/IconImageProvider.h>
 #include <PhosphorServiceIconTheme/QmlRegistration.h>
+#include <PhosphorServiceIconTheme/ThemeIconImageProvider.h>
@@ -28,7 +28,9 @@ PHOSPHORSERVICEICONTHEME_EXPORT void registerQmlTypes();
 /// raw `QImage` payloads (e.g. SNI tray icons that arrive as IconPixmap
 /// over D-Bus) reachable from QML's `Image.source` (a `QUrl` property;
 /// QImage doesn't auto-convert). Per-engine because `QQmlEngine` takes
-/// ownership of its providers and tears them down with itself.
+/// ownership of its providers and tears them down with itself. Also
+/// mounts the asynchronous `ThemeIconImageProvider` under
+/// `image://phosphor-service-themeicon/` for theme icons by name.
 PHOSPHORSERVICEICONTHEME_EXPORT void installImageProvider(QQmlEngine* engine);
 
 /// Stable URL host segment for the image provider, exported so
@@ -38,4 +40,8 @@ PHOSPHORSERVICEICONTHEME_EXPORT void installImageProvider(QQmlEngine* engine);
 /// link rather than fail silently at runtime.
 PHOSPHORSERVICEICONTHEME_EXPORT const char* imageProviderUrlHost();
 
+/// Stable URL host segment for `ThemeIconImageProvider`, for the same
+/// reason.
+PHOSPHORSERVICEICONTHEME_EXPORT const char* themeIconProviderUrlHost();
+
 } // namespace PhosphorServiceIconTheme
@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+#include <PhosphorServiceIconTheme/phosphorserviceicontheme_export.h>
+
+#include <QQuickAsyncImageProvider>
+#include <QString>
+
+namespace PhosphorServiceIconTheme {
+
+/// Asynchronous QML image provider for XDG theme icons by name,
+/// mounted at `image://phosphor-service-themeicon/`. Where
+/// `IconImageProvider` serves images a publisher already holds, this
+/// one resolves and decodes them: a URL of the form
+/// `image://phosphor-service-themeicon/<icon-name>[?scale=N]` goes
+/// through `IconThemeResolver::iconForName` at the Image's
+/// `sourceSize` (48 px when unset).
+///
+/// Decodes run on a small process-wide thread pool rather than the
+/// synchronous provider path, so a launcher grid or tray menu opening
+/// with dozens of uncached SVGs rasterises them in parallel instead of
+/// one after another. Concurrent requests for the same (name, size,
+/// scale) share one decode. The newest request is decoded first, so
+/// the delegates the user is looking at now win over ones scrolled
+/// past. A request whose delegate is destroyed before its decode
+/// starts is dropped from the queue.
+class PHOSPHORSERVICEICONTHEME_EXPORT ThemeIconImageProvider : public QQuickAsyncImageProvider
+{
+    Q_DISABLE_COPY_MOVE(ThemeIconImageProvider)
+public:
+    ThemeIconImageProvider();
+
+    QQuickImageResponse* requestImageResponse(const QString& id, const QSize& requestedSize) override;
+
+    /// Icon size used when the Image sets no `sourceSize`.
+    static constexpr int DefaultIconSize = 48;
+};
+
+} // namespace PhosphorServiceIconTheme
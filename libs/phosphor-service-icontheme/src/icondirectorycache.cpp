@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "icondirectorycache.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QLoggingCategory>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+Q_DECLARE_LOGGING_CATEGORY(lcIconTheme)
+
+namespace PhosphorServiceIconTheme {
+
+namespace {
+
+constexpr quint32 kMagic = 0x505a4943; // "PZIC"
+// Bump when the record layout changes; an older file is then ignored and
+// rewritten on the next save.
+constexpr quint32 kFormatVersion = 1;
+
+// A listing whose directory changed this recently is kept in memory but not
+// persisted: a file added later within the same timestamp tick would leave
+// the mtime untouched and hide behind the stale listing in the next process.
+constexpr qint64 kRacyWindowMs = 2000;
+
+// Bounds a corrupt or hostile cache file. Far above any real icon tree
+// (Breeze + hicolor + Adwaita together list a few hundred directories).
+constexpr qint32 kMaxDirectories = 1 << 16;
+
+} // namespace
+
+IconDirectoryCache::IconDirectoryCache(QString cacheFile, QStringList extensions)
+    : m_file(std::move(cacheFile))
+    , m_extensions(std::move(extensions))
+{
+}
+
+QString IconDirectoryCache::defaultCacheFile()
+{
+    const QString base = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    if (base.isEmpty())
+        return {};
+    return base + QStringLiteral("/phosphor-icontheme/directories.cache");
+}
+
+void IconDirectoryCache::load()
+{
+    m_loaded = true;
+    if (m_file.isEmpty())
+        return;
+    QFile f(m_file);
+    if (!f.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream in(&f);
+    in.setVersion(QDataStream::Qt_6_5);
+    quint32 magic = 0;
+    quint32 version = 0;
+    QStringList extensions;
+    qint32 count = 0;
+    in >> magic >> version;
+    if (magic != kMagic || version != kFormatVersion)
+        return;
+    // Listings were filtered by the writer's extension list; a different
+    // list would serve wrong answers, so start over instead.
+    in >> extensions >> count;
+    if (extensions != m_extensions || count < 0 || count > kMaxDirectories)
+        return;
+
+    QHash<QString, Listing> listings;
+    listings.reserve(count);
+    for (qint32 i = 0; i < count; ++i) {
+        QString dir;
+        Listing listing;
+        in >> dir >> listing.mtime >> listing.files;
+        if (in.status() != QDataStream::Ok) {
+            qCDebug(lcIconTheme) << "ignoring truncated icon directory cache" << m_file;
+            return;
+        }
+        listings.insert(dir, std::move(listing));
+    }
+    m_listings = std::move(listings);
+}
+
+QStringList IconDirectoryCache::files(const QString& dir)
+{
+    if (!m_loaded)
+        load();
+
+    const QFileInfo info(dir);
+    if (!info.isDir()) {
+        if (m_listings.remove(dir))
+            m_dirty = true;
+        return {};
+    }
+    const qint64 mtime = info.lastModified().toMSecsSinceEpoch();
+    if (const auto it = m_listings.constFind(dir); it != m_listings.constEnd() && it->mtime == mtime)
+        return it->files;
+
+    QStringList nameFilters;
+    nameFilters.reserve(m_extensions.size());
+    for (const QString& ext : m_extensions)
+        nameFilters.append(QLatin1Char('*') + ext);
+    Listing listing;
+    listing.mtime = mtime;
+    listing.files = QDir(dir).entryList(nameFilters, QDir::Files | QDir::Readable | QDir::CaseSensitive);
+    m_listings.insert(dir, listing);
+    m_dirty = true;
+    return listing.files;
+}
+
+void IconDirectoryCache::invalidate(const QString& dir)
+{
+    if (m_listings.remove(dir))
+        m_dirty = true;
+}
+
+void IconDirectoryCache::save()
+{
+    if (!m_dirty || m_file.isEmpty())
+        return;
+    m_dirty = false;
+    if (!QDir().mkpath(QFileInfo(m_file).absolutePath()))
+        return;
+
+    const qint64 racyAfter = QDateTime::currentMSecsSinceEpoch() - kRacyWindowMs;
+    qint32 count = 0;
+    for (const Listing& listing : std::as_const(m_listings)) {
+        if (listing.mtime < racyAfter)
+            ++count;
+    }
+
+    QSaveFile f(m_file);
+    if (!f.open(QIODevice::WriteOnly))
+        return;
+    QDataStream out(&f);
+    out.setVersion(QDataStream::Qt_6_5);
+    out << kMagic << kFormatVersion << m_extensions << count;
+    for (auto it = m_listings.cbegin(); it != m_listings.cend(); ++it) {
+        if (it->mtime < racyAfter)
+            out << it.key() << it->mtime << it->files;
+    }
+    if (out.status() != QDataStream::Ok || !f.commit())
+        qCDebug(lcIconTheme) << "failed to write icon directory cache" << m_file;
+}
+
+} // namespace PhosphorServiceIconTheme
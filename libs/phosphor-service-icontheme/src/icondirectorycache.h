@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+// Internal (not installed) listing cache behind IconThemeResolver's per-theme
+// icon index. Maps an absolute directory to the icon files it holds, keyed on
+// the directory's mtime, and persists the map under the user cache dir so a
+// fresh process rebuilds a theme's index with one stat per directory instead of
+// a readdir per directory (or, before the index existed, a stat per candidate
+// file per lookup). Not thread-safe: the resolver serialises access through its
+// own mutex.
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+namespace PhosphorServiceIconTheme {
+
+class IconDirectoryCache
+{
+public:
+    /// @p cacheFile is where listings persist; empty keeps them in memory only.
+    /// Only files ending in one of @p extensions are listed.
+    IconDirectoryCache(QString cacheFile, QStringList extensions);
+
+    /// Icon file names in @p dir. Served from the cache when the directory's
+    /// mtime matches the recorded one, otherwise rescanned. A missing
+    /// directory lists nothing.
+    [[nodiscard]] QStringList files(const QString& dir);
+
+    /// Forget @p dir so the next files() rescans it even if its mtime looks
+    /// unchanged (a watcher event within the same timestamp tick).
+    void invalidate(const QString& dir);
+
+    /// Write the listings out if any changed since the last load / save.
+    void save();
+
+    /// `<GenericCacheLocation>/phosphor-icontheme/directories.cache`, or empty
+    /// when there is no writable cache location.
+    [[nodiscard]] static QString defaultCacheFile();
+
+private:
+    struct Listing
+    {
+        qint64 mtime = 0; ///< ms since epoch
+        QStringList files;
+    };
+
+    void load();
+
+    QString m_file;
+    QStringList m_extensions;
+    QHash<QString, Listing> m_listings;
+    bool m_loaded = false;
+    bool m_dirty = false;
+};
+
+} // namespace PhosphorServiceIconTheme
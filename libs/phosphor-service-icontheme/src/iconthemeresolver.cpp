@@ -3,21 +3,29 @@
 
 #include <PhosphorServiceIconTheme/IconThemeResolver.h>
 
+#include "icondirectorycache.h"
+
+#include <algorithm>
 #include <climits>
+#include <tuple>
 
+#include <QCache>
 #include <QCoreApplication>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QHash>
 #include <QIcon>
 #include <QImageReader>
 #include <QLoggingCategory>
 #include <QMap>
 #include <QMutex>
 #include <QMutexLocker>
-#include <QQueue>
 #include <QSet>
 #include <QStandardPaths>
 #include <QStringList>
+#include <QTimer>
 #include <QtEndian>
 
 Q_LOGGING_CATEGORY(lcIconTheme, "phosphor.service.icontheme")
@@ -41,11 +49,24 @@ struct DirectoryEntry
     QString context;
 };
 
+/// One file for an icon name: indices into `ThemeIndex::directories`, the
+/// search path, and `iconFileExtensions()`.
+struct IconLocation
+{
+    int dir = 0;
+    int root = 0;
+    int ext = 0;
+};
+
 struct ThemeIndex
 {
     QString name;
     QStringList inherits;
     QList<DirectoryEntry> directories;
+    // Every icon file the theme's directories hold, by icon name. Each list is
+    // ordered by (dir, root, ext) — the order the per-lookup probe walk used —
+    // so "first match" keeps the same meaning it had there.
+    QHash<QString, QList<IconLocation>> icons;
 };
 
 namespace {
@@ -210,27 +231,43 @@ public:
     mutable QMutex mutex;
     QString configuredTheme; ///< empty => autodetect
     QStringList searchPath; ///< from xdgIconSearchPath()
-    // `themeCache` and `resolvedCache` are both memoisation state.
-    // The public API surface in IconThemeResolver.h declares
-    // `iconForName(...) const` (theme resolution does not mutate
-    // user-visible state). To honour that contract without lying
-    // about the cache being internal-only, both maps are `mutable`.
-    // Access is always serialised through `mutex` above.
-    mutable QHash<QString, ThemeIndex> themeCache; ///< parsed index.theme per theme name
-    mutable QHash<QString, QImage> resolvedCache;
-    // FIFO eviction order for `resolvedCache`. We push on insert,
-    // pop oldest on overflow. Pure FIFO (not LRU on hit) is enough
-    // for the tray workload, tray icons either stay hot or churn
-    // entirely on theme switch, and we already clear both caches
-    // wholesale in `setThemeName`. Anti-LRU (`erase(begin())`)
-    // would re-evict whatever bucket QHash::begin happens to
-    // point at, which is unrelated to access order and produces
-    // pathological thrash under bucket-collision.
-    mutable QQueue<QString> resolvedOrder;
-    static constexpr int kCacheLimit = 256;
+    // `themeCache`, `fallbackIcons`, `listings` and `resolvedCache` are
+    // all memoisation state. The public API surface in
+    // IconThemeResolver.h declares `iconForName(...) const` (theme
+    // resolution does not mutate user-visible state). To honour that
+    // contract without lying about the caches being internal-only,
+    // they are `mutable`. Access is always serialised through `mutex`
+    // above.
+    mutable QHash<QString, ThemeIndex> themeCache; ///< parsed index.theme + icon index per theme name
+    // Unthemed `<root>/<name>.<ext>` files, by icon name, first root and
+    // extension winning. Built on the first fallback lookup.
+    mutable QHash<QString, QString> fallbackIcons;
+    mutable bool fallbackIndexed = false;
+    // Directory listings behind both indexes, persisted across processes.
+    mutable IconDirectoryCache listings{IconDirectoryCache::defaultCacheFile(), iconFileExtensions()};
+    // Decoded images, LRU by byte cost (QCache costs are in KiB here so
+    // the budget fits any platform's qsizetype comfortably). A count cap
+    // let a handful of 256 px launcher icons cost as much as hundreds of
+    // tray glyphs; a byte budget bounds the memory actually held.
+    static constexpr qsizetype kImageCacheBudgetKiB = 16 * 1024;
+    mutable QCache<QString, QImage> resolvedCache{kImageCacheBudgetKiB};
+
+    // Invalidation: every directory an index was built from is watched
+    // (along with each index.theme), and a change drops the indexes so
+    // the next lookup rebuilds them — rescanning only the directories
+    // whose mtime moved. The watcher lives on the resolver's thread;
+    // lookups on other threads queue their additions onto it.
+    QFileSystemWatcher* watcher = nullptr;
+    QTimer* invalidateTimer = nullptr;
+    mutable QSet<QString> watchedPaths;
+    QSet<QString> changedPaths;
 
     [[nodiscard]] QString detectThemeName() const;
     [[nodiscard]] const ThemeIndex& parseThemeIndex(const QString& themeName) const;
+    void indexThemeIcons(ThemeIndex& idx, QStringList& watch) const;
+    void watchPaths(const QStringList& paths) const;
+    void unwatchAll() const;
+    void dropIndexes();
     [[nodiscard]] QString findIconHelper(const QString& iconName, int size, int scale, const QString& themeName) const;
     [[nodiscard]] QString lookupIcon(const QString& iconName, int size, int scale, const QString& themeName,
                                      QSet<QString>* visited = nullptr) const;
@@ -307,6 +344,25 @@ QMap<QString, QMap<QString, QString>> parseIniFile(const QString& path)
     return result;
 }
 
+/// The directory whose change notifications reveal icons landing in
+/// @p dir: @p dir itself if it exists, else its nearest existing
+/// ancestor no higher than @p root (creating a directory touches its
+/// parent). Empty when not even @p root exists. @p isDir memoises the
+/// stats, since the directories of one theme share their ancestors.
+QString nearestExistingDir(QString dir, const QString& root, QHash<QString, bool>& isDir)
+{
+    while (true) {
+        auto it = isDir.constFind(dir);
+        if (it == isDir.constEnd())
+            it = isDir.insert(dir, QFileInfo(dir).isDir());
+        if (*it)
+            return dir;
+        if (dir.size() <= root.size())
+            return {};
+        dir.truncate(dir.lastIndexOf(QLatin1Char('/')));
+    }
+}
+
 } // namespace
 
 const ThemeIndex& IconThemeResolver::Private::parseThemeIndex(const QString& themeName) const
@@ -324,10 +380,12 @@ const ThemeIndex& IconThemeResolver::Private::parseThemeIndex(const QString& the
     // (KDE does this for "breeze", half is in /usr/share, half in
     // /usr/share/kf5 etc.).
     bool foundHeader = false;
+    QStringList watch;
     for (const auto& root : searchPath) {
         const QString indexPath = root + QLatin1Char('/') + themeName + QStringLiteral("/index.theme");
         if (!QFile::exists(indexPath))
             continue;
+        watch.append(indexPath);
 
         const auto sections = parseIniFile(indexPath);
         const auto& iconThemeSection = sections.value(QStringLiteral("Icon Theme"));
@@ -345,8 +403,8 @@ const ThemeIndex& IconThemeResolver::Private::parseThemeIndex(const QString& the
         // the [Icon Theme] header are candidate icon directories. Vendor
         // extensions like [KDE Icon Theme] and arbitrary metadata groups
         // are accepted as comments by the spec, not as lookup roots.
-        // Restricting the section walk avoids wasted QFile::exists
-        // syscalls on every name lookup against non-spec groups.
+        // Restricting the section walk avoids indexing (and watching)
+        // directories of non-spec groups.
         QSet<QString> directoriesAllowed;
         const auto collectDirs = [&](const QString& key) {
             const auto raw = iconThemeSection.value(key);
@@ -400,7 +458,109 @@ const ThemeIndex& IconThemeResolver::Private::parseThemeIndex(const QString& the
         idx.inherits.append(QStringLiteral("hicolor"));
     }
 
-    return *themeCache.insert(themeName, idx);
+    indexThemeIcons(idx, watch);
+    listings.save();
+    watchPaths(watch);
+
+    return *themeCache.insert(themeName, std::move(idx));
+}
+
+void IconThemeResolver::Private::indexThemeIcons(ThemeIndex& idx, QStringList& watch) const
+{
+    // One listing per (root, directory) replaces the per-lookup probe of
+    // every (directory, root, extension) candidate: a theme with a hundred
+    // size/context directories cost a few hundred stat() calls for every
+    // name it did NOT have, times each theme in the Inherits= chain. The
+    // listings come from the persisted cache when the directory's mtime is
+    // unchanged, so a warm start stats each directory once and reads none.
+    const QStringList& exts = iconFileExtensions();
+    QHash<QString, QStringList> listed; // a theme split across roots may repeat a group
+    QHash<QString, bool> isDir;
+    for (int di = 0; di < idx.directories.size(); ++di) {
+        for (int ri = 0; ri < searchPath.size(); ++ri) {
+            const QString dir =
+                searchPath[ri] + QLatin1Char('/') + idx.name + QLatin1Char('/') + idx.directories[di].path;
+            auto it = listed.constFind(dir);
+            if (it == listed.constEnd()) {
+                it = listed.insert(dir, listings.files(dir));
+                // A directory with no icons yet, empty or not created until
+                // a package installs into it, is watched as well (or its
+                // nearest existing ancestor), so its first icon invalidates
+                // the index like any other change.
+                const QString watched = it->isEmpty() ? nearestExistingDir(dir, searchPath[ri], isDir) : dir;
+                if (!watched.isEmpty())
+                    watch.append(watched);
+            }
+            for (const QString& file : *it) {
+                for (int ei = 0; ei < exts.size(); ++ei) {
+                    if (!file.endsWith(exts[ei]))
+                        continue;
+                    idx.icons[file.chopped(exts[ei].size())].append({di, ri, ei});
+                    break;
+                }
+            }
+        }
+    }
+    // Extensions were appended in listing order, not priority order; restore
+    // the (dir, root, ext) order within each (dir, root) run.
+    for (auto& locations : idx.icons) {
+        std::sort(locations.begin(), locations.end(), [](const IconLocation& a, const IconLocation& b) {
+            return std::tie(a.dir, a.root, a.ext) < std::tie(b.dir, b.root, b.ext);
+        });
+    }
+}
+
+void IconThemeResolver::Private::watchPaths(const QStringList& paths) const
+{
+    QStringList fresh;
+    for (const QString& path : paths) {
+        if (!watchedPaths.contains(path)) {
+            watchedPaths.insert(path);
+            fresh.append(path);
+        }
+    }
+    if (fresh.isEmpty() || !watcher)
+        return;
+    // QFileSystemWatcher is not thread-safe; hop onto its thread.
+    QMetaObject::invokeMethod(
+        watcher,
+        [w = watcher, fresh]() {
+            w->addPaths(fresh);
+        },
+        Qt::QueuedConnection);
+}
+
+void IconThemeResolver::Private::unwatchAll() const
+{
+    // Indexes are rebuilt lazily and re-watch whatever they still read, so
+    // paths dropped with them (an uninstalled theme, a switched-away search
+    // path) stop costing a watch. A change before the rebuild needs no
+    // notification: the listing mtimes pick it up then. Queued like the
+    // additions, so the two apply in the order they were made.
+    if (watchedPaths.isEmpty())
+        return;
+    const QStringList stale = watchedPaths.values();
+    watchedPaths.clear();
+    if (!watcher)
+        return;
+    QMetaObject::invokeMethod(
+        watcher,
+        [w = watcher, stale]() {
+            w->removePaths(stale);
+        },
+        Qt::QueuedConnection);
+}
+
+void IconThemeResolver::Private::dropIndexes()
+{
+    for (const QString& path : std::as_const(changedPaths))
+        listings.invalidate(path);
+    changedPaths.clear();
+    unwatchAll();
+    themeCache.clear();
+    fallbackIcons.clear();
+    fallbackIndexed = false;
+    resolvedCache.clear();
 }
 
 QString IconThemeResolver::Private::themeIconPath(const QString& iconName, int size, int scale,
@@ -408,55 +568,37 @@ QString IconThemeResolver::Private::themeIconPath(const QString& iconName, int s
 {
     const auto& idx = parseThemeIndex(themeName);
 
-    // Try every directory in the theme. First pass: directories whose
-    // size matches. Second pass: closest by size distance.
-    const QStringList& exts = iconFileExtensions();
-
     // Per-item overrides (`extraThemeDir`) are handled as a flat probe
     // at the top of `iconForName`, not threaded through the themed
     // walk: SNI's IconThemePath typically points at a dir containing
     // raw `<iconName>.<ext>` files rather than a themed `NN/apps`
     // subtree.
-    QStringList roots;
-    roots.reserve(searchPath.size());
-    for (const auto& r : searchPath) {
-        roots.append(r + QLatin1Char('/') + themeName);
-    }
+    const auto found = idx.icons.constFind(iconName);
+    if (found == idx.icons.constEnd())
+        return {};
 
-    // Pass 1: exact size match per the directory descriptor.
-    for (const auto& d : idx.directories) {
-        if (!directoryMatchesSize(d, size, scale))
-            continue;
-        for (const auto& root : roots) {
-            for (const auto& ext : exts) {
-                const QString candidate = root + QLatin1Char('/') + d.path + QLatin1Char('/') + iconName + ext;
-                if (QFile::exists(candidate))
-                    return candidate;
-            }
+    // Pass 1: exact size match per the directory descriptor. Pass 2:
+    // closest by size distance, earliest directory on a tie. Both walk
+    // only the files that exist, in (dir, root, ext) order.
+    const IconLocation* best = nullptr;
+    for (const auto& loc : *found) {
+        if (directoryMatchesSize(idx.directories[loc.dir], size, scale)) {
+            best = &loc;
+            break;
         }
     }
-
-    // Pass 2: closest size.
-    int bestDist = INT_MAX;
-    QString bestPath;
-    for (const auto& d : idx.directories) {
-        const int dist = directorySizeDistance(d, size, scale);
-        if (dist >= bestDist)
-            continue;
-        for (const auto& root : roots) {
-            for (const auto& ext : exts) {
-                const QString candidate = root + QLatin1Char('/') + d.path + QLatin1Char('/') + iconName + ext;
-                if (QFile::exists(candidate)) {
-                    bestDist = dist;
-                    bestPath = candidate;
-                    break;
-                }
+    if (!best) {
+        int bestDist = INT_MAX;
+        for (const auto& loc : *found) {
+            const int dist = directorySizeDistance(idx.directories[loc.dir], size, scale);
+            if (dist < bestDist) {
+                bestDist = dist;
+                best = &loc;
             }
-            if (bestDist == dist)
-                break;
         }
     }
-    return bestPath;
+    return searchPath[best->root] + QLatin1Char('/') + themeName + QLatin1Char('/') + idx.directories[best->dir].path
+        + QLatin1Char('/') + iconName + iconFileExtensions()[best->ext];
 }
 
 QString IconThemeResolver::Private::lookupIcon(const QString& iconName, int size, int scale, const QString& themeName,
@@ -497,18 +639,32 @@ QString IconThemeResolver::Private::lookupIcon(const QString& iconName, int size
 
 QString IconThemeResolver::Private::lookupFallbackIcon(const QString& iconName) const
 {
-    // Last resort: scan the search path for `<root>/<iconName>.{png,svg,xpm}`
-    // directly. This is the "unthemed icons" path, /usr/share/pixmaps
-    // historically dumps a flat tree of app icons there.
-    const QStringList& exts = iconFileExtensions();
-    for (const auto& root : searchPath) {
-        for (const auto& ext : exts) {
-            const QString candidate = root + QLatin1Char('/') + iconName + ext;
-            if (QFile::exists(candidate))
-                return candidate;
+    // Last resort: `<root>/<iconName>.{png,svg,xpm}` directly under a
+    // search-path root. This is the "unthemed icons" path,
+    // /usr/share/pixmaps historically dumps a flat tree of app icons
+    // there. Indexed once from the roots' listings like the themes.
+    if (!fallbackIndexed) {
+        fallbackIndexed = true;
+        const QStringList& exts = iconFileExtensions();
+        QStringList watch;
+        for (const auto& root : searchPath) {
+            const QStringList files = listings.files(root);
+            if (!files.isEmpty())
+                watch.append(root);
+            for (const auto& ext : exts) {
+                for (const auto& file : files) {
+                    if (!file.endsWith(ext))
+                        continue;
+                    const QString name = file.chopped(ext.size());
+                    if (!fallbackIcons.contains(name))
+                        fallbackIcons.insert(name, root + QLatin1Char('/') + file);
+                }
+            }
         }
+        listings.save();
+        watchPaths(watch);
     }
-    return {};
+    return fallbackIcons.value(iconName);
 }
 
 QString IconThemeResolver::Private::findIconHelper(const QString& iconName, int size, int scale,
@@ -545,6 +701,29 @@ IconThemeResolver::IconThemeResolver(QObject* parent)
     , d(std::make_unique<Private>())
 {
     d->searchPath = xdgIconSearchPath();
+
+    // A package install or icon copy touches many directories in a burst;
+    // coalesce them into one index drop and one themeChanged().
+    d->watcher = new QFileSystemWatcher(this);
+    d->invalidateTimer = new QTimer(this);
+    d->invalidateTimer->setSingleShot(true);
+    d->invalidateTimer->setInterval(250);
+    const auto onChanged = [this](const QString& path) {
+        {
+            QMutexLocker locker(&d->mutex);
+            d->changedPaths.insert(path);
+        }
+        d->invalidateTimer->start();
+    };
+    connect(d->watcher, &QFileSystemWatcher::directoryChanged, this, onChanged);
+    connect(d->watcher, &QFileSystemWatcher::fileChanged, this, onChanged);
+    connect(d->invalidateTimer, &QTimer::timeout, this, [this]() {
+        {
+            QMutexLocker locker(&d->mutex);
+            d->dropIndexes();
+        }
+        Q_EMIT themeChanged();
+    });
 }
 
 IconThemeResolver::~IconThemeResolver() = default;
@@ -560,8 +739,10 @@ void IconThemeResolver::setThemeName(const QString& themeName)
         return;
     d->configuredTheme = themeName;
     d->themeCache.clear();
+    d->unwatchAll();
+    d->fallbackIcons.clear();
+    d->fallbackIndexed = false;
     d->resolvedCache.clear();
-    d->resolvedOrder.clear();
     // Refresh the XDG search path on every theme switch. The
     // singleton's constructor reads env vars once and caches; if a
     // test or runtime caller mutates `XDG_DATA_HOME` / `XDG_DATA_DIRS`
@@ -620,8 +801,8 @@ QImage IconThemeResolver::iconForName(const QString& name, int size, int scale,
         const QChar sep = QChar(QChar::Null);
         cacheKey = theme + sep + name + sep + extraThemeDir + sep + QString::number(size) + QLatin1Char(':')
             + QString::number(scale);
-        if (auto it = d->resolvedCache.constFind(cacheKey); it != d->resolvedCache.constEnd()) {
-            return *it;
+        if (const QImage* cached = d->resolvedCache.object(cacheKey)) {
+            return *cached;
         }
 
         if (!extraThemeDir.isEmpty()) {
@@ -667,8 +848,8 @@ QImage IconThemeResolver::iconForName(const QString& name, int size, int scale,
     }
 
     // Phase 3: insert into the resolved cache. Re-check for a racing
-    // insert from another thread before our own put so we don't
-    // double-count toward the FIFO order. Skip caching null QImages
+    // insert from another thread before our own put so both callers
+    // return the same shared image. Skip caching null QImages
     // (lookup miss or decode failure) so a later filesystem update
     // (theme install, icon copied in, package upgrade) is visible on
     // the next lookup instead of waiting for setThemeName() to flush
@@ -678,14 +859,13 @@ QImage IconThemeResolver::iconForName(const QString& name, int size, int scale,
     }
     {
         QMutexLocker locker(&d->mutex);
-        if (auto it = d->resolvedCache.constFind(cacheKey); it != d->resolvedCache.constEnd()) {
-            return *it;
-        }
-        while (d->resolvedCache.size() >= Private::kCacheLimit && !d->resolvedOrder.isEmpty()) {
-            d->resolvedCache.remove(d->resolvedOrder.dequeue());
+        if (const QImage* cached = d->resolvedCache.object(cacheKey)) {
+            return *cached;
         }
-        d->resolvedCache.insert(cacheKey, img);
-        d->resolvedOrder.enqueue(cacheKey);
+        // QCache evicts least-recently-used images until the new one fits,
+        // and declines (deleting its copy) one larger than the whole budget.
+        const qsizetype costKiB = qMax<qsizetype>(1, img.sizeInBytes() / 1024);
+        d->resolvedCache.insert(cacheKey, new QImage(img), costKiB);
     }
     return img;
 }
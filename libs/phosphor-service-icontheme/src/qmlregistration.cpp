@@ -5,6 +5,7 @@
 
 #include <PhosphorServiceIconTheme/IconImageProvider.h>
 #include <PhosphorServiceIconTheme/IconThemeResolver.h>
+#include <PhosphorServiceIconTheme/ThemeIconImageProvider.h>
 
 #include <QCoreApplication>
 #include <QLoggingCategory>
@@ -21,6 +22,7 @@ constexpr int kModuleVersionMajor = 1;
 constexpr int kModuleVersionMinor = 0;
 constexpr const char* kModule = "Phosphor.Service.IconTheme";
 constexpr const char* kImageProviderHost = "phosphor-service-icontheme";
+constexpr const char* kThemeIconProviderHost = "phosphor-service-themeicon";
 } // namespace
 
 void registerQmlTypes()
@@ -64,10 +66,12 @@ void installImageProvider(QQmlEngine* engine)
     // QQmlEngine per hot reload, so re-install is the steady-state
     // pattern.
     engine->addImageProvider(QString::fromLatin1(kImageProviderHost), new IconImageProvider());
+    engine->addImageProvider(QString::fromLatin1(kThemeIconProviderHost), new ThemeIconImageProvider());
     // Pointer addresses leak ASLR layout into logs that may be
     // forwarded; log the URL host (the actionable identity) and gate
     // engine identity behind qCDebug for in-process correlation.
-    qCInfo(lcIconThemeQml).nospace() << "image provider mounted at image://" << kImageProviderHost << "/";
+    qCInfo(lcIconThemeQml).nospace() << "image providers mounted at image://" << kImageProviderHost
+                                     << "/ and image://" << kThemeIconProviderHost << "/";
     qCDebug(lcIconThemeQml).nospace() << "image provider engine=" << static_cast<void*>(engine);
 }
 
@@ -76,4 +80,9 @@ const char* imageProviderUrlHost()
     return kImageProviderHost;
 }
 
+const char* themeIconProviderUrlHost()
+{
+    return kThemeIconProviderHost;
+}
+
 } // namespace PhosphorServiceIconTheme
@@ -0,0 +1,261 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <PhosphorServiceIconTheme/ThemeIconImageProvider.h>
+
+#include <PhosphorServiceIconTheme/IconThemeResolver.h>
+
+#include <QCoreApplication>
+#include <QHash>
+#include <QImage>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QQuickTextureFactory>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <QUrl>
+#include <QUrlQuery>
+
+#include <memory>
+
+namespace PhosphorServiceIconTheme {
+
+namespace {
+
+class ThemeIconResponse;
+
+// The link between one response and the decode serving it. The response
+// clears `response` in its destructor under `mutex`, so a decode finishing on
+// a pool thread never touches a response the engine already deleted, and
+// `done` makes the first of {decode finished, cancel} the only one that
+// completes it.
+struct Waiter
+{
+    QMutex mutex;
+    ThemeIconResponse* response = nullptr;
+    bool done = false;
+};
+
+// One queued or running decode, shared by every request for its key (name,
+// pixel size, scale).
+struct DecodeJob
+{
+    QString name;
+    int size = 0;
+    int scale = 1;
+    int pixelSize = 0; ///< target box edge; the decoded image is fitted to it
+    QList<std::shared_ptr<Waiter>> waiters;
+    QRunnable* task = nullptr; ///< owned by the pool; valid while the job is in `m_inFlight`
+};
+
+class ThemeIconResponse : public QQuickImageResponse
+{
+public:
+    explicit ThemeIconResponse(QString key)
+        : m_key(std::move(key))
+        , m_waiter(std::make_shared<Waiter>())
+    {
+        m_waiter->response = this;
+    }
+
+    ~ThemeIconResponse() override
+    {
+        QMutexLocker locker(&m_waiter->mutex);
+        m_waiter->response = nullptr;
+    }
+
+    QQuickTextureFactory* textureFactory() const override
+    {
+        QMutexLocker locker(&m_waiter->mutex);
+        return QQuickTextureFactory::textureFactoryForImage(m_image);
+    }
+
+    QString errorString() const override
+    {
+        QMutexLocker locker(&m_waiter->mutex);
+        return m_error;
+    }
+
+    void cancel() override;
+
+    [[nodiscard]] const std::shared_ptr<Waiter>& waiter() const
+    {
+        return m_waiter;
+    }
+
+    /// Called once, by complete(), with the waiter's mutex held.
+    void setResult(const QImage& image, const QString& error)
+    {
+        m_image = image;
+        m_error = error;
+    }
+
+private:
+    // Guarded by the waiter's mutex.
+    QImage m_image;
+    QString m_error;
+    const QString m_key;
+    const std::shared_ptr<Waiter> m_waiter;
+};
+
+// Hand @p image (or @p error) to the waiter's response and signal it, unless
+// the response is gone or already completed. finished() is queued onto the
+// response's own thread: the engine may emit cancel() and delete the response
+// there, and a direct emit from a pool thread would race that.
+void complete(Waiter& waiter, const QImage& image, const QString& error)
+{
+    QMutexLocker locker(&waiter.mutex);
+    if (!waiter.response || waiter.done)
+        return;
+    waiter.done = true;
+    waiter.response->setResult(image, error);
+    QMetaObject::invokeMethod(waiter.response, &QQuickImageResponse::finished, Qt::QueuedConnection);
+}
+
+class DecodeScheduler
+{
+public:
+    static DecodeScheduler& instance()
+    {
+        static DecodeScheduler s;
+        return s;
+    }
+
+    void request(const QString& key, const QString& name, int size, int scale, int pixelSize,
+                 const std::shared_ptr<Waiter>& waiter)
+    {
+        QMutexLocker locker(&m_mutex);
+        std::shared_ptr<DecodeJob>& job = m_inFlight[key];
+        if (job) {
+            job->waiters.append(waiter);
+            return;
+        }
+        job = std::make_shared<DecodeJob>();
+        job->name = name;
+        job->size = size;
+        job->scale = scale;
+        job->pixelSize = pixelSize;
+        job->waiters.append(waiter);
+        job->task = QRunnable::create([this, key, job]() {
+            run(key, job);
+        });
+        // Newest first: QThreadPool runs higher priorities first, and the
+        // delegates created last are the ones on screen now. The mask keeps
+        // the counter non-negative; a wrap after a billion requests merely
+        // misorders one batch.
+        m_pool.start(job->task, int(++m_sequence & 0x3fffffff));
+    }
+
+    void cancel(const QString& key, const std::shared_ptr<Waiter>& waiter)
+    {
+        QMutexLocker locker(&m_mutex);
+        const auto it = m_inFlight.find(key);
+        if (it == m_inFlight.end())
+            return;
+        const std::shared_ptr<DecodeJob> job = *it;
+        job->waiters.removeOne(waiter);
+        // A decode nobody waits for is dropped if it has not started. One
+        // already running finishes anyway: its result lands in the
+        // resolver's cache, which is where the next request will look.
+        if (job->waiters.isEmpty() && m_pool.tryTake(job->task)) {
+            delete job->task;
+            m_inFlight.erase(it);
+        }
+    }
+
+    void shutdown()
+    {
+        m_pool.clear();
+        m_pool.waitForDone();
+    }
+
+private:
+    DecodeScheduler()
+    {
+        // Bounded: decoding is CPU work competing with the render thread,
+        // and a handful of threads already drains a launcher grid's worth of
+        // SVGs in one frame budget or two.
+        m_pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount() / 2, 4));
+        m_pool.setObjectName(QStringLiteral("phosphor-themeicon-decode"));
+        // Drain before QCoreApplication deletes its children: a decode
+        // still running at static-destruction time would call into the
+        // resolver singleton after it was destroyed with the application.
+        qAddPostRoutine([] {
+            DecodeScheduler::instance().shutdown();
+        });
+    }
+
+    void run(const QString& key, const std::shared_ptr<DecodeJob>& job)
+    {
+        QImage image = IconThemeResolver::instance()->iconForName(job->name, job->size, job->scale);
+        // The resolver rasterises SVGs at the exact size; a raster from the
+        // nearest size directory is fitted to the requested box here, still
+        // off the GUI and loader threads.
+        if (!image.isNull() && qMax(image.width(), image.height()) != job->pixelSize) {
+            image = image.scaled(job->pixelSize, job->pixelSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        }
+
+        QList<std::shared_ptr<Waiter>> waiters;
+        {
+            QMutexLocker locker(&m_mutex);
+            waiters = job->waiters;
+            m_inFlight.remove(key);
+        }
+        const QString error =
+            image.isNull() ? QStringLiteral("no icon named \"%1\" in the current theme").arg(job->name) : QString();
+        for (const auto& waiter : std::as_const(waiters))
+            complete(*waiter, image, error);
+    }
+
+    QMutex m_mutex;
+    QHash<QString, std::shared_ptr<DecodeJob>> m_inFlight;
+    int m_sequence = 0;
+    // Last, so it is destroyed (and waited on) before the state its tasks use.
+    QThreadPool m_pool;
+};
+
+void ThemeIconResponse::cancel()
+{
+    // The engine calls this when the Image that asked is destroyed or
+    // changes source. It still expects finished() afterwards.
+    DecodeScheduler::instance().cancel(m_key, m_waiter);
+    complete(*m_waiter, {}, QStringLiteral("cancelled"));
+}
+
+} // namespace
+
+ThemeIconImageProvider::ThemeIconImageProvider() = default;
+
+QQuickImageResponse* ThemeIconImageProvider::requestImageResponse(const QString& id, const QSize& requestedSize)
+{
+    // Same URL hygiene as IconImageProvider: split off the query and
+    // percent-decode the path. Name validation (path separators, `..`,
+    // NUL) is IconThemeResolver::iconForName's, at the filesystem
+    // boundary.
+    QString name = id;
+    int scale = 1;
+    if (const int q = name.indexOf(QLatin1Char('?')); q >= 0) {
+        const QUrlQuery query(name.mid(q + 1));
+        scale = qBound(1, query.queryItemValue(QStringLiteral("scale")).toInt(), 4);
+        name.truncate(q);
+    }
+    name = QUrl::fromPercentEncoding(name.toUtf8());
+
+    // requestedSize is the Image's sourceSize in pixels; `scale` selects
+    // the theme's HiDPI directories, with the logical size taken as the
+    // pixel size divided by it.
+    int pixelSize = qMax(requestedSize.width(), requestedSize.height());
+    if (pixelSize <= 0)
+        pixelSize = DefaultIconSize * scale;
+    const int size = qMax(1, pixelSize / scale);
+
+    const QChar sep = QChar(QChar::Null);
+    const QString key = name + sep + QString::number(pixelSize) + QLatin1Char(':') + QString::number(scale);
+    auto* response = new ThemeIconResponse(key);
+    DecodeScheduler::instance().request(key, name, size, scale, pixelSize, response->waiter());
+    return response;
+}
+
+} // namespace PhosphorServiceIconTheme
@@ -6,6 +6,7 @@
 #include <QDir>
 #include <QFile>
 #include <QImage>
+#include <QSignalSpy>
 #include <QTemporaryDir>
 #include <QtTest/QtTest>
 
@@ -32,13 +33,15 @@ private:
         QDir().mkpath(themeRoot + QStringLiteral("/testtheme/scalable/apps"));
         QDir().mkpath(themeRoot + QStringLiteral("/hicolor/22x22/apps"));
 
-        // index.theme, declares the three directories and inherits hicolor.
+        // index.theme, declares the three directories above (scalable/apps
+        // left empty) plus 48x48/apps, which is not created, and inherits
+        // hicolor.
         QFile index(themeRoot + QStringLiteral("/testtheme/index.theme"));
         QVERIFY(index.open(QIODevice::WriteOnly));
         index.write(R"([Icon Theme]
 Name=TestTheme
 Inherits=hicolor
-Directories=16x16/apps,32x32/apps,scalable/apps
+Directories=16x16/apps,32x32/apps,48x48/apps,scalable/apps
 
 [16x16/apps]
 Size=16
@@ -50,6 +53,11 @@ Size=32
 Type=Fixed
 Context=Applications
 
+[48x48/apps]
+Size=48
+Type=Fixed
+Context=Applications
+
 [scalable/apps]
 Size=32
 MinSize=8
@@ -75,14 +83,22 @@ Context=Applications
 )");
         hicolorIndex.close();
 
-        // Synthesise a 1×1 PNG for each "icon". We don't need to
-        // render, just need QImage::isNull() to be false after
-        // resolution.
-        QImage red(1, 1, QImage::Format_ARGB32);
-        red.fill(Qt::red);
-        QVERIFY(red.save(themeRoot + QStringLiteral("/testtheme/16x16/apps/test-app.png")));
-        QVERIFY(red.save(themeRoot + QStringLiteral("/testtheme/32x32/apps/test-app.png")));
-        QVERIFY(red.save(themeRoot + QStringLiteral("/hicolor/22x22/apps/inherited-only.png")));
+        // Synthesise a PNG for each "icon". We don't need to render,
+        // just need QImage::isNull() to be false after resolution; the
+        // two sized-app files are written at their nominal size so a
+        // test can tell which directory the resolver picked.
+        QVERIFY(solid(1).save(themeRoot + QStringLiteral("/testtheme/16x16/apps/test-app.png")));
+        QVERIFY(solid(16).save(themeRoot + QStringLiteral("/testtheme/16x16/apps/sized-app.png")));
+        QVERIFY(solid(32).save(themeRoot + QStringLiteral("/testtheme/32x32/apps/sized-app.png")));
+        QVERIFY(solid(1).save(themeRoot + QStringLiteral("/testtheme/32x32/apps/test-app.png")));
+        QVERIFY(solid(1).save(themeRoot + QStringLiteral("/hicolor/22x22/apps/inherited-only.png")));
+    }
+
+    static QImage solid(int size)
+    {
+        QImage img(size, size, QImage::Format_ARGB32);
+        img.fill(Qt::red);
+        return img;
     }
 
     // Point Qt's standard-paths machinery at our fixture so the
@@ -142,6 +158,74 @@ private Q_SLOTS:
         QVERIFY(img.isNull());
     }
 
+    // The per-theme index answers with the spec's size selection: an
+    // exact directory match first, else the smallest size distance.
+    void picksClosestSizeFromIndex()
+    {
+        auto* r = IconThemeResolver::instance();
+        r->setThemeName(QStringLiteral("testtheme"));
+
+        QCOMPARE(r->iconForName(QStringLiteral("sized-app"), 16).width(), 16);
+        QCOMPARE(r->iconForName(QStringLiteral("sized-app"), 32).width(), 32);
+        QCOMPARE(r->iconForName(QStringLiteral("sized-app"), 20).width(), 16); // 4 from 16, 12 from 32
+        QCOMPARE(r->iconForName(QStringLiteral("sized-app"), 30).width(), 32); // 14 from 16, 2 from 32
+        QCOMPARE(r->iconForName(QStringLiteral("sized-app"), 64).width(), 32);
+    }
+
+    // Unthemed icons directly under a search-path root resolve through
+    // the fallback index.
+    void resolvesUnthemedFallback()
+    {
+        auto* r = IconThemeResolver::instance();
+        r->setThemeName(QStringLiteral("testtheme"));
+        QVERIFY(solid(4).save(themeRoot + QStringLiteral("/loose-app.png")));
+        // setThemeName only flushes on an actual change.
+        r->setThemeName(QString());
+        r->setThemeName(QStringLiteral("testtheme"));
+
+        QCOMPARE(r->iconForName(QStringLiteral("loose-app"), 48).width(), 4);
+    }
+
+    // Installing an icon into an indexed theme directory is picked up
+    // via the watcher without a theme switch or restart.
+    void watcherPicksUpInstalledIcon()
+    {
+        auto* r = IconThemeResolver::instance();
+        r->setThemeName(QStringLiteral("testtheme"));
+        QVERIFY(r->iconForName(QStringLiteral("late-app"), 16).isNull());
+        // Let the queued watcher registration for the freshly indexed
+        // directories land before touching them.
+        QTest::qWait(50);
+
+        QSignalSpy changed(r, &IconThemeResolver::themeChanged);
+        QVERIFY(solid(16).save(themeRoot + QStringLiteral("/testtheme/16x16/apps/late-app.png")));
+        QVERIFY(changed.wait(5000));
+        QTRY_COMPARE_WITH_TIMEOUT(r->iconForName(QStringLiteral("late-app"), 16).width(), 16, 5000);
+    }
+
+    // The first icon installed into a declared directory that is still
+    // empty, or does not exist yet, is picked up the same way.
+    void watcherPicksUpIconInEmptyOrMissingDirectory()
+    {
+        auto* r = IconThemeResolver::instance();
+        r->setThemeName(QStringLiteral("testtheme"));
+        QVERIFY(r->iconForName(QStringLiteral("new-scalable-app"), 64).isNull());
+        QVERIFY(r->iconForName(QStringLiteral("new-sized-app"), 48).isNull());
+        QTest::qWait(50);
+
+        QSignalSpy changed(r, &IconThemeResolver::themeChanged);
+        QVERIFY(solid(64).save(themeRoot + QStringLiteral("/testtheme/scalable/apps/new-scalable-app.png")));
+        QVERIFY(changed.wait(5000));
+        QTRY_COMPARE_WITH_TIMEOUT(r->iconForName(QStringLiteral("new-scalable-app"), 64).width(), 64, 5000);
+        QTest::qWait(50);
+
+        changed.clear();
+        QVERIFY(QDir().mkpath(themeRoot + QStringLiteral("/testtheme/48x48/apps")));
+        QVERIFY(solid(48).save(themeRoot + QStringLiteral("/testtheme/48x48/apps/new-sized-app.png")));
+        QVERIFY(changed.wait(5000));
+        QTRY_COMPARE_WITH_TIMEOUT(r->iconForName(QStringLiteral("new-sized-app"), 48).width(), 48, 5000);
+    }
+
     void emptyNameReturnsEmpty()
     {
         auto* r = IconThemeResolver::instance();
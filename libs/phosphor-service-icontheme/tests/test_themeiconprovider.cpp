@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <PhosphorServiceIconTheme/IconThemeResolver.h>
+#include <PhosphorServiceIconTheme/QmlRegistration.h>
+#include <PhosphorServiceIconTheme/ThemeIconImageProvider.h>
+
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QQuickTextureFactory>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include <memory>
+#include <vector>
+
+using PhosphorServiceIconTheme::IconThemeResolver;
+using PhosphorServiceIconTheme::ThemeIconImageProvider;
+
+class TestThemeIconProvider : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir fixtureRoot;
+    ThemeIconImageProvider provider;
+
+    // One-directory fixture theme: enough for the resolver to find a
+    // 32 px raster the provider then fits to the requested size.
+    void writeFixture()
+    {
+        QVERIFY(fixtureRoot.isValid());
+        const QString themeDir = fixtureRoot.path() + QStringLiteral("/icons/fixturetheme");
+        QVERIFY(QDir().mkpath(themeDir + QStringLiteral("/32x32/apps")));
+        QFile index(themeDir + QStringLiteral("/index.theme"));
+        QVERIFY(index.open(QIODevice::WriteOnly));
+        index.write(R"([Icon Theme]
+Name=FixtureTheme
+Directories=32x32/apps
+
+[32x32/apps]
+Size=32
+Type=Fixed
+Context=Applications
+)");
+        index.close();
+        QImage img(32, 32, QImage::Format_ARGB32);
+        img.fill(Qt::green);
+        QVERIFY(img.save(themeDir + QStringLiteral("/32x32/apps/fixture-app.png")));
+    }
+
+    // Wait for @p response to finish and return its image (null on error).
+    // Takes ownership: the engine normally deletes responses.
+    static QImage finish(QQuickImageResponse* response, QString* error = nullptr)
+    {
+        std::unique_ptr<QQuickImageResponse> owned(response);
+        QSignalSpy finished(response, &QQuickImageResponse::finished);
+        if (!finished.wait(5000))
+            return {};
+        if (error)
+            *error = response->errorString();
+        std::unique_ptr<QQuickTextureFactory> factory(response->textureFactory());
+        return factory ? factory->image() : QImage();
+    }
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        writeFixture();
+        qputenv("XDG_DATA_HOME", fixtureRoot.path().toUtf8());
+        qputenv("XDG_DATA_DIRS", fixtureRoot.path().toUtf8());
+        IconThemeResolver::instance()->setThemeName(QStringLiteral("fixturetheme"));
+    }
+
+    // Pinned like imageProviderUrlHost(): a rename must fail here, not
+    // as a silent "provider not found" in QML.
+    void urlHostIsPinned()
+    {
+        QCOMPARE(QString::fromLatin1(PhosphorServiceIconTheme::themeIconProviderUrlHost()),
+                 QStringLiteral("phosphor-service-themeicon"));
+    }
+
+    void deliversIconFittedToRequestedSize()
+    {
+        QString error;
+        const QImage img = finish(provider.requestImageResponse(QStringLiteral("fixture-app"), QSize(24, 24)), &error);
+        QVERIFY2(!img.isNull(), qPrintable(error));
+        QCOMPARE(img.size(), QSize(24, 24));
+        QVERIFY(error.isEmpty());
+    }
+
+    void defaultsSizeWithoutSourceSize()
+    {
+        const QImage img = finish(provider.requestImageResponse(QStringLiteral("fixture-app"), QSize()));
+        QCOMPARE(img.width(), ThemeIconImageProvider::DefaultIconSize);
+    }
+
+    // `?scale=` selects HiDPI lookup; the pixel size stays the request's.
+    void scaleQueryIsStripped()
+    {
+        const QImage img = finish(provider.requestImageResponse(QStringLiteral("fixture-app?scale=2"), QSize(64, 64)));
+        QCOMPARE(img.size(), QSize(64, 64));
+    }
+
+    void unknownIconFinishesWithError()
+    {
+        QString error;
+        const QImage img = finish(provider.requestImageResponse(QStringLiteral("no-such-icon"), QSize(16, 16)), &error);
+        QVERIFY(img.isNull());
+        QVERIFY(!error.isEmpty());
+    }
+
+    // A burst of identical requests (a grid of the same icon) all complete
+    // with the same result, however they were coalesced.
+    void concurrentIdenticalRequestsAllFinish()
+    {
+        std::vector<std::unique_ptr<QQuickImageResponse>> responses;
+        std::vector<std::unique_ptr<QSignalSpy>> spies;
+        for (int i = 0; i < 16; ++i) {
+            responses.emplace_back(provider.requestImageResponse(QStringLiteral("fixture-app"), QSize(40, 40)));
+            spies.push_back(std::make_unique<QSignalSpy>(responses.back().get(), &QQuickImageResponse::finished));
+        }
+        for (const auto& spy : spies)
+            QTRY_COMPARE_WITH_TIMEOUT(spy->count(), 1, 5000);
+        for (const auto& response : responses) {
+            std::unique_ptr<QQuickTextureFactory> factory(response->textureFactory());
+            QVERIFY(factory);
+            QCOMPARE(factory->image().size(), QSize(40, 40));
+        }
+    }
+
+    // The engine cancels a response whose Image went away and still
+    // expects exactly one finished(), whether or not the decode had begun.
+    void cancelFinishesExactlyOnce()
+    {
+        std::unique_ptr<QQuickImageResponse> response(
+            provider.requestImageResponse(QStringLiteral("fixture-app"), QSize(20, 20)));
+        QSignalSpy finished(response.get(), &QQuickImageResponse::finished);
+        response->cancel();
+        QVERIFY(finished.wait(5000));
+        QTest::qWait(100); // a decode that was already running must not finish it again
+        QCOMPARE(finished.count(), 1);
+    }
+};
+
+QTEST_MAIN(TestThemeIconProvider)
+#include "test_themeiconprovider.moc"
@@ -11,7 +11,8 @@ namespace PhosphorShaders {
 ///
 /// The RHI render node allocates sizeof(BaseUniforms) + extensionSize() bytes
 /// for the UBO. During prepare(), if isDirty() returns true, write() is called
-/// to fill the extension region.
+/// to fill the extension region, and only the spans takeDirtyRanges() reports
+/// are sent to the GPU.
 ///
 /// All methods may be called on the render thread.
 class PHOSPHORSHADERS_EXPORT IUniformExtension
@@ -39,6 +40,32 @@ public:
     /// Mark as clean after a successful write.
     virtual void clearDirty() = 0;
 
+    /// A changed byte span of the extension region, relative to its start.
+    struct DirtyRange
+    {
+        int offset = 0;
+        int size = 0;
+    };
+
+    /// Report which parts of the region changed since the last call, and mark
+    /// the extension clean in the same step.
+    ///
+    /// The node calls this BEFORE write(), for the same reason it used to call
+    /// clearDirty() first: a setter landing between the two re-arms the flag,
+    /// so its value is picked up next frame instead of being lost.
+    ///
+    /// Fills at most @p capacity entries of @p out and returns how many it
+    /// wrote. Zero is legal and means nothing actually changed. Returns -1 for
+    /// "upload the whole region", which is also the fallback an extension must
+    /// take when its changes do not fit in @p capacity ranges. The default
+    /// implementation always returns -1, which keeps whole-region uploads for
+    /// extensions that do not track changes.
+    virtual int takeDirtyRanges(DirtyRange* /*out*/, int /*capacity*/)
+    {
+        clearDirty();
+        return -1;
+    }
+
     /// Whether `iResolution` in this extension's UBO should be uploaded
     /// in PHYSICAL pixels (DPR-scaled, matches `gl_FragCoord`) or
     /// LOGICAL pixels (matches the QQuickItem's bounds and Qt's
@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#pragma once
+
+#include <PhosphorTheme/PaletteStore.h>
+#include <PhosphorTheme/phosphortheme_export.h>
+
+#include <QColor>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QUrl>
+#include <QVariantMap>
+#include <QtQmlIntegration/qqmlintegration.h>
+
+#include <memory>
+
+class QImage;
+
+namespace PhosphorTheme {
+
+// In-process replacement for MatugenRunner: derives the M3 token palette
+// from a wallpaper without spawning matugen. Same surface (mode, prefer,
+// run / cancel, paletteReady / failed), so callers can switch engines by
+// swapping the object.
+//
+// The pipeline runs on a worker thread: hash the file, decode it scaled
+// down to at most 128 px on the long edge, quantize to ~128 colors
+// (5-bit histogram refined by k-means in CAM16-UCS), rank source-color
+// candidates with Material's score, then expand the chosen one into a
+// tonal-spot scheme. Ranked candidates are cached per content hash
+// (in memory and under the user cache dir), so re-applying a wallpaper,
+// or switching mode / prefer on the current one, skips decoding entirely.
+//
+// Unlike MatugenRunner, the extractor can feed a PaletteStore itself: with
+// `store` set, the tokens are merged into it right before `paletteReady`
+// fires. Leave `store` unset to only receive the map.
+class PHOSPHORTHEME_EXPORT PaletteExtractor : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    // "dark" or "light". Default: "dark".
+    Q_PROPERTY(QString mode READ mode WRITE setMode NOTIFY modeChanged)
+
+    // Which ranked candidate becomes the source color. Accepts the
+    // matugen spellings that make sense without a fallback color:
+    // "saturation" (default, most chromatic), "less-saturation",
+    // "darkness", "lightness", and "" for the best-scoring candidate.
+    // Unknown values behave like "".
+    Q_PROPERTY(QString prefer READ prefer WRITE setPrefer NOTIFY preferChanged)
+
+    // Optional palette to merge results into. Not owned.
+    Q_PROPERTY(PhosphorTheme::PaletteStore* store READ store WRITE setStore NOTIFY storeChanged)
+
+    // True while a `run()` call is in flight.
+    Q_PROPERTY(bool running READ isRunning NOTIFY runningChanged)
+
+public:
+    explicit PaletteExtractor(QObject* parent = nullptr);
+    ~PaletteExtractor() override;
+
+    [[nodiscard]] QString mode() const;
+    void setMode(const QString& mode);
+
+    [[nodiscard]] QString prefer() const;
+    void setPrefer(const QString& prefer);
+
+    [[nodiscard]] PaletteStore* store() const;
+    void setStore(PaletteStore* store);
+
+    [[nodiscard]] bool isRunning() const;
+
+    // Extract from `wallpaperPath` off the GUI thread. Emits
+    // `paletteReady` on success, `failed` otherwise. A second `run` while
+    // one is in flight supersedes it: the earlier result is dropped.
+    Q_INVOKABLE void run(const QString& wallpaperPath);
+
+    // QUrl overload for QML callers. Non-file URLs are rejected via
+    // `failed`, as with MatugenRunner.
+    Q_INVOKABLE void run(const QUrl& wallpaperUrl);
+
+    // Drop an in-flight run. Safe to call when nothing is running.
+    Q_INVOKABLE void cancel();
+
+    // Synchronous building blocks, for tests and for callers that already
+    // hold a decoded image or a source color.
+    //
+    // Ranked source-color candidates for `image`, best first. Scales the
+    // image down first if it is large. Never empty: an image with nothing
+    // colorful yields Material's fallback blue.
+    [[nodiscard]] static QList<QColor> sourceColors(const QImage& image);
+
+    // The full tonal-spot token map for `source`, in `mode` ("light" or
+    // anything else for dark). Keys are Phosphor's snake_case token names
+    // plus the extra M3 roles matugen also emits (surface_dim, inverse_*,
+    // *_fixed, ...).
+    [[nodiscard]] static QVariantMap tokensForSourceColor(const QColor& source, const QString& mode);
+
+Q_SIGNALS:
+    void modeChanged();
+    void preferChanged();
+    void storeChanged();
+    void runningChanged();
+
+    // Extraction finished. Already merged into `store` if one is set.
+    void paletteReady(const QVariantMap& tokens, const QString& wallpaperPath);
+
+    // Unreadable or undecodable file, or a non-file URL.
+    void failed(const QString& wallpaperPath, const QString& reason);
+
+private:
+    void setRunning(bool running);
+
+    class Private;
+    std::unique_ptr<Private> d;
+};
+
+} // namespace PhosphorTheme
@@ -9,5 +9,6 @@
 
 #include <PhosphorTheme/IThemeService.h>
 #include <PhosphorTheme/MatugenRunner.h>
+#include <PhosphorTheme/PaletteExtractor.h>
 #include <PhosphorTheme/PaletteStore.h>
 #include <PhosphorTheme/TemplateEngine.h>
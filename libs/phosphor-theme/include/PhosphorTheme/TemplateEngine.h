@@ -4,12 +4,50 @@
 
 #include <PhosphorTheme/phosphortheme_export.h>
 
+#include <QList>
 #include <QString>
+#include <QStringList>
 #include <QVariantMap>
 #include <QtQmlIntegration/qqmlintegration.h>
 
+#include <memory>
+
 namespace PhosphorTheme {
 
+// A template parsed once into literal runs and placeholders. Each distinct
+// token name gets one slot, resolved against the token map once per
+// render no matter how often the template references it, and each
+// distinct `token.field` pair is formatted once. Rendering is then a
+// single pre-sized concatenation, no regex scan.
+//
+// Immutable and implicitly shared: copies are cheap, and one plan can be
+// rendered from several threads at once. Output is identical to
+// TemplateEngine::render on the same source, including the unknown-token
+// and unknown-field behaviour (warnings are logged once per render per
+// token / field rather than once per occurrence).
+class PHOSPHORTHEME_EXPORT CompiledTemplate
+{
+public:
+    // Renders as the empty string.
+    CompiledTemplate();
+    explicit CompiledTemplate(const QString& templateSource);
+    ~CompiledTemplate();
+    CompiledTemplate(const CompiledTemplate&);
+    CompiledTemplate& operator=(const CompiledTemplate&);
+
+    [[nodiscard]] QString render(const QVariantMap& tokens) const;
+
+    // Distinct token names the template references, in first-use order.
+    [[nodiscard]] QStringList tokenNames() const;
+
+    // Number of `{{...}}` occurrences.
+    [[nodiscard]] int placeholderCount() const;
+
+private:
+    struct Plan;
+    std::shared_ptr<const Plan> m_plan;
+};
+
 // Minimal mustache-style template engine for the matugen fan-out pipeline.
 //
 // Templates contain `{{token}}` placeholders that resolve to color values
@@ -47,15 +85,34 @@ class PHOSPHORTHEME_EXPORT TemplateEngine
     QML_VALUE_TYPE(templateEngine)
 
 public:
+    // One template file rendered to one output path.
+    struct Target
+    {
+        QString templatePath;
+        QString outPath;
+    };
+
     // Render `templateSource` against `tokens`. Returns the substituted
     // string. Missing tokens log a warning and leave the placeholder
-    // intact.
+    // intact. One-shot: parses the source on every call. Callers that
+    // render the same template repeatedly should hold a CompiledTemplate.
     [[nodiscard]] static QString render(const QString& templateSource, const QVariantMap& tokens);
 
     // Convenience: read template from disk, render, write to outPath.
     // Returns true on success, false on any IO failure (rendering never
     // fails). Logs a warning on either failure path.
+    //
+    // The parsed template is cached process-wide by path and reused while
+    // the file's mtime and size are unchanged, so a palette change only
+    // pays for the render. outPath is left untouched (no write, no mtime
+    // bump, no watcher event for whoever consumes it) when it already
+    // holds exactly the rendered bytes.
     static bool renderFile(const QString& templatePath, const QString& outPath, const QVariantMap& tokens);
+
+    // renderFile for every target, spread across the global thread pool.
+    // Blocks until all are done. Returns true only if every target
+    // succeeded; failures are logged per target and do not stop the rest.
+    static bool renderFiles(const QList<Target>& targets, const QVariantMap& tokens);
 };
 
 } // namespace PhosphorTheme
@@ -0,0 +1,289 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "colorquantizer.h"
+
+#include "hct.h"
+
+#include <QHash>
+#include <QImage>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace PhosphorTheme::detail {
+
+namespace {
+
+constexpr int kHistogramBits = 5;
+constexpr int kHistogramSize = 1 << (3 * kHistogramBits);
+constexpr int kKMeansIterations = 10;
+
+int histogramIndex(QRgb argb)
+{
+    constexpr int shift = 8 - kHistogramBits;
+    return ((qRed(argb) >> shift) << (2 * kHistogramBits)) | ((qGreen(argb) >> shift) << kHistogramBits)
+        | (qBlue(argb) >> shift);
+}
+
+// Running RGB sum per histogram bin, so a bin stands for the mean of the
+// pixels that fell into it rather than for its corner.
+struct Bin
+{
+    quint64 r = 0;
+    quint64 g = 0;
+    quint64 b = 0;
+    int count = 0;
+};
+
+double hueDifference(double a, double b)
+{
+    return 180.0 - std::abs(std::abs(a - b) - 180.0);
+}
+
+int sanitizedHue(int degrees)
+{
+    degrees %= 360;
+    return degrees < 0 ? degrees + 360 : degrees;
+}
+
+} // namespace
+
+QList<QuantizedColor> quantize(const QImage& image, int maxColors)
+{
+    if (image.isNull() || maxColors <= 0) {
+        return {};
+    }
+    const QImage argb = image.convertToFormat(QImage::Format_ARGB32);
+
+    std::vector<Bin> histogram(kHistogramSize);
+    for (int y = 0; y < argb.height(); ++y) {
+        const auto* line = reinterpret_cast<const QRgb*>(argb.constScanLine(y));
+        for (int x = 0; x < argb.width(); ++x) {
+            const QRgb px = line[x];
+            // Same as Material: translucent pixels say nothing reliable
+            // about the color the user sees.
+            if (qAlpha(px) < 255) {
+                continue;
+            }
+            Bin& bin = histogram[histogramIndex(px)];
+            bin.r += qRed(px);
+            bin.g += qGreen(px);
+            bin.b += qBlue(px);
+            ++bin.count;
+        }
+    }
+
+    // The occupied bins become the weighted points k-means runs on, laid out
+    // as structure-of-arrays so the distance loop below vectorises.
+    std::vector<float> pj;
+    std::vector<float> pa;
+    std::vector<float> pb;
+    std::vector<int> weight;
+    std::vector<QRgb> meanColor;
+    for (const Bin& bin : histogram) {
+        if (bin.count == 0) {
+            continue;
+        }
+        const QRgb mean = qRgb(int(bin.r / bin.count), int(bin.g / bin.count), int(bin.b / bin.count));
+        const Cam16 cam = Cam16::fromArgb(mean);
+        pj.push_back(float(cam.jstar));
+        pa.push_back(float(cam.astar));
+        pb.push_back(float(cam.bstar));
+        weight.push_back(bin.count);
+        meanColor.push_back(mean);
+    }
+    const int pointCount = int(weight.size());
+    if (pointCount == 0) {
+        return {};
+    }
+    const int k = std::min(maxColors, pointCount);
+
+    // Seed from the heaviest bins: deterministic, and it starts every
+    // dominant color off with a centroid of its own.
+    std::vector<int> order(pointCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::partial_sort(order.begin(), order.begin() + k, order.end(), [&](int a, int b) {
+        return weight[a] > weight[b];
+    });
+    std::vector<float> cj(k);
+    std::vector<float> ca(k);
+    std::vector<float> cb(k);
+    for (int c = 0; c < k; ++c) {
+        cj[c] = pj[order[c]];
+        ca[c] = pa[order[c]];
+        cb[c] = pb[order[c]];
+    }
+
+    std::vector<int> assignment(pointCount, 0);
+    std::vector<double> sumJ(k);
+    std::vector<double> sumA(k);
+    std::vector<double> sumB(k);
+    std::vector<qint64> clusterWeight(k);
+    for (int iteration = 0; iteration < kKMeansIterations; ++iteration) {
+        bool moved = false;
+        for (int p = 0; p < pointCount; ++p) {
+            const float j = pj[p];
+            const float a = pa[p];
+            const float b = pb[p];
+            float bestDistance = std::numeric_limits<float>::max();
+            int best = 0;
+            for (int c = 0; c < k; ++c) {
+                const float dj = cj[c] - j;
+                const float da = ca[c] - a;
+                const float db = cb[c] - b;
+                const float distance = dj * dj + da * da + db * db;
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = c;
+                }
+            }
+            moved |= assignment[p] != best;
+            assignment[p] = best;
+        }
+        if (!moved && iteration > 0) {
+            break;
+        }
+
+        std::fill(sumJ.begin(), sumJ.end(), 0.0);
+        std::fill(sumA.begin(), sumA.end(), 0.0);
+        std::fill(sumB.begin(), sumB.end(), 0.0);
+        std::fill(clusterWeight.begin(), clusterWeight.end(), 0);
+        for (int p = 0; p < pointCount; ++p) {
+            const int c = assignment[p];
+            sumJ[c] += double(pj[p]) * weight[p];
+            sumA[c] += double(pa[p]) * weight[p];
+            sumB[c] += double(pb[p]) * weight[p];
+            clusterWeight[c] += weight[p];
+        }
+        for (int c = 0; c < k; ++c) {
+            // An emptied centroid stays put; it may pick points up again.
+            if (clusterWeight[c] > 0) {
+                cj[c] = float(sumJ[c] / clusterWeight[c]);
+                ca[c] = float(sumA[c] / clusterWeight[c]);
+                cb[c] = float(sumB[c] / clusterWeight[c]);
+            }
+        }
+    }
+
+    // Report each cluster as the population-weighted sRGB mean of its
+    // members, which is always a real, in-gamut color.
+    std::vector<std::array<quint64, 3>> rgbSum(k, {0, 0, 0});
+    std::vector<qint64> population(k, 0);
+    for (int p = 0; p < pointCount; ++p) {
+        const int c = assignment[p];
+        rgbSum[c][0] += quint64(qRed(meanColor[p])) * weight[p];
+        rgbSum[c][1] += quint64(qGreen(meanColor[p])) * weight[p];
+        rgbSum[c][2] += quint64(qBlue(meanColor[p])) * weight[p];
+        population[c] += weight[p];
+    }
+    QHash<QRgb, int> merged;
+    for (int c = 0; c < k; ++c) {
+        if (population[c] == 0) {
+            continue;
+        }
+        const QRgb color = qRgb(int(rgbSum[c][0] / population[c]), int(rgbSum[c][1] / population[c]),
+                                int(rgbSum[c][2] / population[c]));
+        merged[color] += int(population[c]);
+    }
+    QList<QuantizedColor> out;
+    out.reserve(merged.size());
+    for (auto it = merged.cbegin(); it != merged.cend(); ++it) {
+        out.append({it.key(), it.value()});
+    }
+    return out;
+}
+
+QList<QRgb> scoreSourceColors(const QList<QuantizedColor>& colors, int desired)
+{
+    constexpr double kTargetChroma = 48.0;
+    constexpr double kWeightProportion = 0.7;
+    constexpr double kWeightChromaAbove = 0.3;
+    constexpr double kWeightChromaBelow = 0.1;
+    constexpr double kCutoffChroma = 5.0;
+    constexpr double kCutoffExcitedProportion = 0.01;
+
+    std::vector<Hct> hcts;
+    hcts.reserve(colors.size());
+    std::array<double, 360> huePopulation{};
+    double populationSum = 0.0;
+    for (const QuantizedColor& color : colors) {
+        const Hct hct = Hct::fromArgb(color.argb);
+        hcts.push_back(hct);
+        huePopulation[sanitizedHue(int(std::floor(hct.hue)))] += color.population;
+        populationSum += color.population;
+    }
+    if (populationSum <= 0.0) {
+        return {kFallbackSourceColor};
+    }
+
+    // How much of the image sits within ±15° of each hue: a hue shared by
+    // many slightly different clusters counts as the large area it is.
+    std::array<double, 360> excitedProportion{};
+    for (int hue = 0; hue < 360; ++hue) {
+        const double proportion = huePopulation[hue] / populationSum;
+        if (proportion == 0.0) {
+            continue;
+        }
+        for (int neighbor = hue - 14; neighbor < hue + 16; ++neighbor) {
+            excitedProportion[sanitizedHue(neighbor)] += proportion;
+        }
+    }
+
+    struct Scored
+    {
+        QRgb argb;
+        double hue;
+        double score;
+    };
+    std::vector<Scored> scored;
+    for (int i = 0; i < int(hcts.size()); ++i) {
+        const Hct& hct = hcts[i];
+        const double proportion = excitedProportion[sanitizedHue(int(std::lround(hct.hue)))];
+        if (hct.chroma < kCutoffChroma || proportion <= kCutoffExcitedProportion) {
+            continue;
+        }
+        const double proportionScore = proportion * 100.0 * kWeightProportion;
+        const double chromaWeight = hct.chroma < kTargetChroma ? kWeightChromaBelow : kWeightChromaAbove;
+        const double chromaScore = (hct.chroma - kTargetChroma) * chromaWeight;
+        scored.push_back({colors[i].argb, hct.hue, proportionScore + chromaScore});
+    }
+    std::stable_sort(scored.begin(), scored.end(), [](const Scored& a, const Scored& b) {
+        return a.score > b.score;
+    });
+
+    // Prefer candidates 90° apart; relax the spacing until enough are found.
+    std::vector<const Scored*> chosen;
+    for (int minDifference = 90; minDifference >= 15; --minDifference) {
+        chosen.clear();
+        for (const Scored& candidate : scored) {
+            const bool distinct = std::none_of(chosen.begin(), chosen.end(), [&](const Scored* picked) {
+                return hueDifference(candidate.hue, picked->hue) < minDifference;
+            });
+            if (distinct) {
+                chosen.push_back(&candidate);
+            }
+            if (int(chosen.size()) >= desired) {
+                break;
+            }
+        }
+        if (int(chosen.size()) >= desired) {
+            break;
+        }
+    }
+
+    QList<QRgb> out;
+    for (const Scored* picked : chosen) {
+        out.append(picked->argb);
+    }
+    if (out.isEmpty()) {
+        out.append(kFallbackSourceColor);
+    }
+    return out;
+}
+
+} // namespace PhosphorTheme::detail
@@ -0,0 +1,38 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#pragma once
+
+// Private, built into PhosphorTheme, not installed. Reduces a (small,
+// already downsampled) wallpaper to a handful of weighted colors and ranks
+// them as M3 source-color candidates, the way matugen's "image" command
+// does, but in-process.
+
+#include <QList>
+#include <QRgb>
+
+class QImage;
+
+namespace PhosphorTheme::detail {
+
+// What scoreSourceColors() returns when nothing in the image is colorful
+// enough to theme from (Material's Google-blue fallback, same as matugen).
+inline constexpr QRgb kFallbackSourceColor = 0xff4285f4;
+
+struct QuantizedColor
+{
+    QRgb argb = 0;
+    int population = 0;
+};
+
+// Clusters the opaque pixels of `image` into at most `maxColors` colors.
+// Pixels are first binned into a 5-bit-per-channel histogram, then the bins
+// are refined with weighted k-means in CAM16-UCS so clusters follow
+// perceived rather than RGB distance. Result order is unspecified.
+QList<QuantizedColor> quantize(const QImage& image, int maxColors = 128);
+
+// Material's source-color score: favours hues that cover a large share of
+// the image and chroma near 48, drops near-greys and specks, and returns up
+// to `desired` candidates with distinct hues, best first. Never empty.
+QList<QRgb> scoreSourceColors(const QList<QuantizedColor>& colors, int desired = 4);
+
+} // namespace PhosphorTheme::detail
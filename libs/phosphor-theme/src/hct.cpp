@@ -0,0 +1,328 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "hct.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace PhosphorTheme::detail {
+
+namespace {
+
+// ─── sRGB / XYZ / L* ────────────────────────────────────────────────────────
+
+constexpr double kWhitePoint[3] = {95.047, 100.0, 108.883}; // D65
+
+double linearized(int channel)
+{
+    const double n = channel / 255.0;
+    return (n <= 0.040449936 ? n / 12.92 : std::pow((n + 0.055) / 1.055, 2.4)) * 100.0;
+}
+
+int delinearized(double linear)
+{
+    const double n = linear / 100.0;
+    const double v = n <= 0.0031308 ? n * 12.92 : 1.055 * std::pow(n, 1.0 / 2.4) - 0.055;
+    return std::clamp(int(std::lround(v * 255.0)), 0, 255);
+}
+
+double labF(double t)
+{
+    constexpr double e = 216.0 / 24389.0;
+    constexpr double kappa = 24389.0 / 27.0;
+    return t > e ? std::cbrt(t) : (kappa * t + 16.0) / 116.0;
+}
+
+double labInvF(double ft)
+{
+    constexpr double e = 216.0 / 24389.0;
+    constexpr double kappa = 24389.0 / 27.0;
+    const double ft3 = ft * ft * ft;
+    return ft3 > e ? ft3 : (116.0 * ft - 16.0) / kappa;
+}
+
+double yFromLstar(double lstar)
+{
+    return 100.0 * labInvF((lstar + 16.0) / 116.0);
+}
+
+struct Xyz
+{
+    double x;
+    double y;
+    double z;
+};
+
+Xyz xyzFromArgb(QRgb argb)
+{
+    const double r = linearized(qRed(argb));
+    const double g = linearized(qGreen(argb));
+    const double b = linearized(qBlue(argb));
+    return {0.41233895 * r + 0.35762064 * g + 0.18051042 * b, 0.2126 * r + 0.7152 * g + 0.0722 * b,
+            0.01932141 * r + 0.11916382 * g + 0.95034478 * b};
+}
+
+double sanitizeDegrees(double degrees)
+{
+    degrees = std::fmod(degrees, 360.0);
+    return degrees < 0.0 ? degrees + 360.0 : degrees;
+}
+
+double signum(double v)
+{
+    return v < 0.0 ? -1.0 : (v > 0.0 ? 1.0 : 0.0);
+}
+
+// ─── CAM16 viewing conditions ───────────────────────────────────────────────
+
+// Material's defaults: D65, adapting luminance of a 200 lux room, a
+// mid-grey (L* 50) background, average surround, no discounting.
+struct ViewingConditions
+{
+    double n;
+    double aw;
+    double nbb;
+    double ncb;
+    double c;
+    double nc;
+    double rgbD[3];
+    double fl;
+    double fLRoot;
+    double z;
+
+    ViewingConditions()
+    {
+        const double adaptingLuminance = 200.0 / std::numbers::pi * yFromLstar(50.0) / 100.0;
+        const double backgroundLstar = 50.0;
+        const double surround = 2.0;
+
+        const double rW = kWhitePoint[0] * 0.401288 + kWhitePoint[1] * 0.650173 + kWhitePoint[2] * -0.051461;
+        const double gW = kWhitePoint[0] * -0.250268 + kWhitePoint[1] * 1.204414 + kWhitePoint[2] * 0.045854;
+        const double bW = kWhitePoint[0] * -0.002079 + kWhitePoint[1] * 0.048952 + kWhitePoint[2] * 0.953127;
+
+        const double f = 0.8 + surround / 10.0;
+        c = f >= 0.9 ? std::lerp(0.59, 0.69, (f - 0.9) * 10.0) : std::lerp(0.525, 0.59, (f - 0.8) * 10.0);
+        const double d =
+            std::clamp(f * (1.0 - (1.0 / 3.6) * std::exp((-adaptingLuminance - 42.0) / 92.0)), 0.0, 1.0);
+        nc = f;
+        rgbD[0] = d * (100.0 / rW) + 1.0 - d;
+        rgbD[1] = d * (100.0 / gW) + 1.0 - d;
+        rgbD[2] = d * (100.0 / bW) + 1.0 - d;
+
+        const double k = 1.0 / (5.0 * adaptingLuminance + 1.0);
+        const double k4 = k * k * k * k;
+        const double k4F = 1.0 - k4;
+        fl = k4 * adaptingLuminance + 0.1 * k4F * k4F * std::cbrt(5.0 * adaptingLuminance);
+        fLRoot = std::pow(fl, 0.25);
+        n = yFromLstar(backgroundLstar) / kWhitePoint[1];
+        z = 1.48 + std::sqrt(n);
+        nbb = 0.725 / std::pow(n, 0.2);
+        ncb = nbb;
+
+        double rgbA[3];
+        const double white[3] = {rW, gW, bW};
+        for (int i = 0; i < 3; ++i) {
+            const double factor = std::pow(fl * rgbD[i] * white[i] / 100.0, 0.42);
+            rgbA[i] = 400.0 * factor / (factor + 27.13);
+        }
+        aw = (2.0 * rgbA[0] + rgbA[1] + 0.05 * rgbA[2]) * nbb;
+    }
+};
+
+const ViewingConditions& viewingConditions()
+{
+    static const ViewingConditions vc;
+    return vc;
+}
+
+// CAM16 (J, C, h) back to XYZ under the default viewing conditions.
+Xyz xyzFromJch(double j, double chroma, double hue)
+{
+    const ViewingConditions& vc = viewingConditions();
+    const double alpha = (chroma == 0.0 || j == 0.0) ? 0.0 : chroma / std::sqrt(j / 100.0);
+    const double t = std::pow(alpha / std::pow(1.64 - std::pow(0.29, vc.n), 0.73), 1.0 / 0.9);
+    const double hRad = hue * std::numbers::pi / 180.0;
+    const double eHue = 0.25 * (std::cos(hRad + 2.0) + 3.8);
+    const double ac = vc.aw * std::pow(j / 100.0, 1.0 / vc.c / vc.z);
+    const double p1 = eHue * (50000.0 / 13.0) * vc.nc * vc.ncb;
+    const double p2 = ac / vc.nbb;
+    const double hSin = std::sin(hRad);
+    const double hCos = std::cos(hRad);
+    const double gamma = 23.0 * (p2 + 0.305) * t / (23.0 * p1 + 11.0 * t * hCos + 108.0 * t * hSin);
+    const double a = gamma * hCos;
+    const double b = gamma * hSin;
+    const double rgbA[3] = {(460.0 * p2 + 451.0 * a + 288.0 * b) / 1403.0,
+                            (460.0 * p2 - 891.0 * a - 261.0 * b) / 1403.0,
+                            (460.0 * p2 - 220.0 * a - 6300.0 * b) / 1403.0};
+    double rgbF[3];
+    for (int i = 0; i < 3; ++i) {
+        const double base = std::max(0.0, 27.13 * std::abs(rgbA[i]) / (400.0 - std::abs(rgbA[i])));
+        rgbF[i] = signum(rgbA[i]) * (100.0 / vc.fl) * std::pow(base, 1.0 / 0.42) / vc.rgbD[i];
+    }
+    return {1.86206786 * rgbF[0] - 1.01125463 * rgbF[1] + 0.14918677 * rgbF[2],
+            0.38752654 * rgbF[0] + 0.62144744 * rgbF[1] - 0.00897398 * rgbF[2],
+            -0.01584150 * rgbF[0] - 0.03412294 * rgbF[1] + 1.04996444 * rgbF[2]};
+}
+
+struct LinearRgb
+{
+    double r;
+    double g;
+    double b;
+
+    bool inGamut() const
+    {
+        // A hair of slack so rounding at the gamut surface does not cost a
+        // whole bisection step of chroma.
+        constexpr double lo = -0.01;
+        constexpr double hi = 100.01;
+        return r >= lo && r <= hi && g >= lo && g <= hi && b >= lo && b <= hi;
+    }
+};
+
+LinearRgb linearRgbFromXyz(const Xyz& xyz)
+{
+    return {3.2413774792388685 * xyz.x - 1.5376652402851851 * xyz.y - 0.49885366846268053 * xyz.z,
+            -0.9691452513005321 * xyz.x + 1.8758853451067872 * xyz.y + 0.04156585616912061 * xyz.z,
+            0.05562093689691305 * xyz.x - 0.20395524564742123 * xyz.y + 1.0571799111220335 * xyz.z};
+}
+
+QRgb argbFromLinearRgb(const LinearRgb& rgb)
+{
+    return qRgb(delinearized(rgb.r), delinearized(rgb.g), delinearized(rgb.b));
+}
+
+// The XYZ of (hue, chroma) at the CAM16 lightness whose luminance is
+// `targetY`. Y grows monotonically with J at fixed hue and chroma, so a
+// bisection on J converges without a starting guess.
+Xyz xyzAtLuminance(double hue, double chroma, double targetY)
+{
+    double lo = 0.0;
+    double hi = 100.0;
+    // Saturated light colors can sit above J = 100; widen until bracketed.
+    while (xyzFromJch(hi, chroma, hue).y < targetY && hi < 400.0) {
+        hi *= 1.5;
+    }
+    Xyz xyz{};
+    for (int i = 0; i < 40; ++i) {
+        const double mid = 0.5 * (lo + hi);
+        xyz = xyzFromJch(mid, chroma, hue);
+        if (std::abs(xyz.y - targetY) < 1e-4) {
+            break;
+        }
+        (xyz.y < targetY ? lo : hi) = mid;
+    }
+    return xyz;
+}
+
+} // namespace
+
+double lstarFromArgb(QRgb argb)
+{
+    return 116.0 * labF(xyzFromArgb(argb).y / 100.0) - 16.0;
+}
+
+Cam16 Cam16::fromArgb(QRgb argb)
+{
+    const ViewingConditions& vc = viewingConditions();
+    const Xyz xyz = xyzFromArgb(argb);
+
+    const double rC = 0.401288 * xyz.x + 0.650173 * xyz.y - 0.051461 * xyz.z;
+    const double gC = -0.250268 * xyz.x + 1.204414 * xyz.y + 0.045854 * xyz.z;
+    const double bC = -0.002079 * xyz.x + 0.048952 * xyz.y + 0.953127 * xyz.z;
+    const double cone[3] = {rC * vc.rgbD[0], gC * vc.rgbD[1], bC * vc.rgbD[2]};
+    double rgbA[3];
+    for (int i = 0; i < 3; ++i) {
+        const double af = std::pow(vc.fl * std::abs(cone[i]) / 100.0, 0.42);
+        rgbA[i] = signum(cone[i]) * 400.0 * af / (af + 27.13);
+    }
+
+    const double a = (11.0 * rgbA[0] - 12.0 * rgbA[1] + rgbA[2]) / 11.0;
+    const double b = (rgbA[0] + rgbA[1] - 2.0 * rgbA[2]) / 9.0;
+    const double u = (20.0 * rgbA[0] + 20.0 * rgbA[1] + 21.0 * rgbA[2]) / 20.0;
+    const double p2 = (40.0 * rgbA[0] + 20.0 * rgbA[1] + rgbA[2]) / 20.0;
+
+    Cam16 cam;
+    cam.hue = sanitizeDegrees(std::atan2(b, a) * 180.0 / std::numbers::pi);
+    const double hueRadians = cam.hue * std::numbers::pi / 180.0;
+    const double ac = p2 * vc.nbb;
+    cam.j = 100.0 * std::pow(ac / vc.aw, vc.c * vc.z);
+
+    const double huePrime = cam.hue < 20.14 ? cam.hue + 360.0 : cam.hue;
+    const double eHue = 0.25 * (std::cos(huePrime * std::numbers::pi / 180.0 + 2.0) + 3.8);
+    const double p1 = 50000.0 / 13.0 * eHue * vc.nc * vc.ncb;
+    const double t = p1 * std::hypot(a, b) / (u + 0.305);
+    const double alpha = std::pow(1.64 - std::pow(0.29, vc.n), 0.73) * std::pow(t, 0.9);
+    cam.chroma = alpha * std::sqrt(cam.j / 100.0);
+
+    const double m = cam.chroma * vc.fLRoot;
+    const double mstar = 1.0 / 0.0228 * std::log1p(0.0228 * m);
+    cam.jstar = (1.0 + 100.0 * 0.007) * cam.j / (1.0 + 0.007 * cam.j);
+    cam.astar = mstar * std::cos(hueRadians);
+    cam.bstar = mstar * std::sin(hueRadians);
+    return cam;
+}
+
+Hct Hct::fromArgb(QRgb argb)
+{
+    const Cam16 cam = Cam16::fromArgb(argb);
+    return {cam.hue, cam.chroma, lstarFromArgb(argb)};
+}
+
+QRgb Hct::toArgb(double hue, double chroma, double tone)
+{
+    if (tone <= 0.0) {
+        return qRgb(0, 0, 0);
+    }
+    if (tone >= 100.0) {
+        return qRgb(255, 255, 255);
+    }
+    const double targetY = yFromLstar(tone);
+    hue = sanitizeDegrees(hue);
+    if (chroma < 0.5) {
+        const int grey = delinearized(targetY);
+        return qRgb(grey, grey, grey);
+    }
+
+    // Tone is fixed by luminance; what is left is the largest chroma up to
+    // the requested one whose color at that luminance is still in sRGB.
+    LinearRgb best = linearRgbFromXyz(xyzAtLuminance(hue, chroma, targetY));
+    if (best.inGamut()) {
+        return argbFromLinearRgb(best);
+    }
+    double lo = 0.0;
+    double hi = chroma;
+    best = {targetY, targetY, targetY};
+    for (int i = 0; i < 16 && hi - lo > 0.05; ++i) {
+        const double mid = 0.5 * (lo + hi);
+        const LinearRgb rgb = linearRgbFromXyz(xyzAtLuminance(hue, mid, targetY));
+        if (rgb.inGamut()) {
+            best = rgb;
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return argbFromLinearRgb(best);
+}
+
+TonalPalette::TonalPalette(double hue, double chroma)
+    : m_hue(hue)
+    , m_chroma(chroma)
+{
+}
+
+QRgb TonalPalette::tone(int tone)
+{
+    const auto it = m_cache.find(tone);
+    if (it != m_cache.end()) {
+        return it->second;
+    }
+    const QRgb argb = Hct::toArgb(m_hue, m_chroma, tone);
+    m_cache.emplace(tone, argb);
+    return argb;
+}
+
+} // namespace PhosphorTheme::detail
@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#pragma once
+
+// Private, built into PhosphorTheme, not installed. The color science behind
+// PaletteExtractor: CAM16 under the Material default viewing conditions, the
+// HCT space built on it (CAM16 hue + chroma, CIE L* tone), and M3 tonal
+// palettes. Ported from the published Material Color Utilities algorithms so
+// the extracted palettes line up with what matugen derives from the same
+// source color.
+
+#include <QRgb>
+
+#include <map>
+
+namespace PhosphorTheme::detail {
+
+// CIE L* of an sRGB color, 0..100.
+double lstarFromArgb(QRgb argb);
+
+// The CAM16 appearance correlates PaletteExtractor needs, plus the
+// CAM16-UCS coordinates its quantizer clusters in.
+struct Cam16
+{
+    double hue = 0.0; // degrees, [0, 360)
+    double chroma = 0.0;
+    double j = 0.0; // lightness
+    double jstar = 0.0; // CAM16-UCS
+    double astar = 0.0;
+    double bstar = 0.0;
+
+    static Cam16 fromArgb(QRgb argb);
+};
+
+struct Hct
+{
+    double hue = 0.0;
+    double chroma = 0.0;
+    double tone = 0.0;
+
+    static Hct fromArgb(QRgb argb);
+
+    // The sRGB color with this hue and tone and the chroma closest to the
+    // requested one that sRGB can show (chroma is reduced until the color
+    // is in gamut; hue and tone are kept).
+    static QRgb toArgb(double hue, double chroma, double tone);
+};
+
+// One hue / chroma pair across the tone axis, memoised per tone.
+class TonalPalette
+{
+public:
+    TonalPalette(double hue, double chroma);
+
+    QRgb tone(int tone);
+
+private:
+    double m_hue;
+    double m_chroma;
+    std::map<int, QRgb> m_cache;
+};
+
+} // namespace PhosphorTheme::detail
@@ -0,0 +1,342 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <PhosphorTheme/PaletteExtractor.h>
+
+#include "colorquantizer.h"
+#include "hct.h"
+#include "sourcecolorcache.h"
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QImage>
+#include <QImageReader>
+#include <QPointer>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+namespace PhosphorTheme {
+
+namespace {
+
+// Long edge the wallpaper is decoded at. Quantization only needs the color
+// distribution, and 128 px keeps it (16k pixels) while letting JPEG decode
+// at a fraction of full size.
+constexpr int kMaxDecodeEdge = 128;
+
+struct ExtractionResult
+{
+    QVariantMap tokens;
+    QString error; // non-empty on failure
+};
+
+QList<QRgb> rankSourceColors(const QImage& image)
+{
+    QImage scaled = image;
+    if (std::max(image.width(), image.height()) > kMaxDecodeEdge) {
+        scaled = image.scaled(kMaxDecodeEdge, kMaxDecodeEdge, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    return detail::scoreSourceColors(detail::quantize(scaled));
+}
+
+// matugen's --prefer, applied to the ranked candidates.
+QRgb pickSourceColor(const QList<QRgb>& ranked, const QString& prefer)
+{
+    if (ranked.isEmpty()) {
+        return detail::kFallbackSourceColor;
+    }
+    const auto byChroma = [](QRgb a, QRgb b) {
+        return detail::Hct::fromArgb(a).chroma < detail::Hct::fromArgb(b).chroma;
+    };
+    const auto byTone = [](QRgb a, QRgb b) {
+        return detail::lstarFromArgb(a) < detail::lstarFromArgb(b);
+    };
+    if (prefer == QLatin1String("saturation")) {
+        return *std::max_element(ranked.cbegin(), ranked.cend(), byChroma);
+    }
+    if (prefer == QLatin1String("less-saturation")) {
+        return *std::min_element(ranked.cbegin(), ranked.cend(), byChroma);
+    }
+    if (prefer == QLatin1String("darkness")) {
+        return *std::min_element(ranked.cbegin(), ranked.cend(), byTone);
+    }
+    if (prefer == QLatin1String("lightness")) {
+        return *std::max_element(ranked.cbegin(), ranked.cend(), byTone);
+    }
+    return ranked.first();
+}
+
+// Worker-thread body of run(): touches nothing but its arguments and the
+// (locked) source color cache.
+ExtractionResult extract(const QString& path, const QString& mode, const QString& prefer)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {{}, QStringLiteral("could not read wallpaper: %1").arg(file.errorString())};
+    }
+    const QByteArray bytes = file.readAll();
+    file.close();
+
+    // Keyed on content, not path: a wallpaper replaced in place gets a new
+    // palette, and the same image under two names is decoded once.
+    const QByteArray hash = QCryptographicHash::hash(bytes, QCryptographicHash::Sha1);
+    detail::SourceColorCache& cache = detail::SourceColorCache::instance();
+    QList<QRgb> ranked;
+    if (auto cached = cache.lookup(hash)) {
+        ranked = std::move(*cached);
+    } else {
+        QBuffer buffer;
+        buffer.setData(bytes);
+        buffer.open(QIODevice::ReadOnly);
+        QImageReader reader(&buffer);
+        reader.setAutoTransform(true);
+        const QSize size = reader.size();
+        if (size.isValid() && std::max(size.width(), size.height()) > kMaxDecodeEdge) {
+            reader.setScaledSize(size.scaled(kMaxDecodeEdge, kMaxDecodeEdge, Qt::KeepAspectRatio));
+        }
+        const QImage image = reader.read();
+        if (image.isNull()) {
+            return {{}, QStringLiteral("could not decode wallpaper: %1").arg(reader.errorString())};
+        }
+        ranked = rankSourceColors(image);
+        cache.insert(hash, ranked);
+    }
+    return {PaletteExtractor::tokensForSourceColor(QColor::fromRgb(pickSourceColor(ranked, prefer)), mode), {}};
+}
+
+} // namespace
+
+class PaletteExtractor::Private
+{
+public:
+    QString mode = QStringLiteral("dark");
+    QString prefer = QStringLiteral("saturation");
+    QPointer<PaletteStore> store;
+    QString pendingWallpaper;
+    QFutureWatcher<ExtractionResult> watcher;
+    bool running = false;
+};
+
+PaletteExtractor::PaletteExtractor(QObject* parent)
+    : QObject(parent)
+    , d(std::make_unique<Private>())
+{
+    // Delivered on this object's thread, so applying to the store and
+    // emitting here needs no further hop.
+    connect(&d->watcher, &QFutureWatcher<ExtractionResult>::finished, this, [this] {
+        // cancel() may land after the worker reported but before this
+        // queued delivery, so the running flag is the final word.
+        if (!d->running || d->watcher.future().resultCount() == 0) {
+            return; // cancelled or superseded
+        }
+        const ExtractionResult result = d->watcher.result();
+        const QString path = d->pendingWallpaper;
+        setRunning(false);
+        if (!result.error.isEmpty()) {
+            Q_EMIT failed(path, result.error);
+            return;
+        }
+        if (d->store) {
+            d->store->applyTokens(result.tokens);
+        }
+        Q_EMIT paletteReady(result.tokens, path);
+    });
+}
+
+// The worker holds copies of everything it reads, so an in-flight run can
+// simply be abandoned; its result is discarded by the cancelled future.
+PaletteExtractor::~PaletteExtractor()
+{
+    d->watcher.cancel();
+}
+
+QString PaletteExtractor::mode() const
+{
+    return d->mode;
+}
+
+void PaletteExtractor::setMode(const QString& mode)
+{
+    if (mode == d->mode) {
+        return;
+    }
+    d->mode = mode;
+    Q_EMIT modeChanged();
+}
+
+QString PaletteExtractor::prefer() const
+{
+    return d->prefer;
+}
+
+void PaletteExtractor::setPrefer(const QString& prefer)
+{
+    if (prefer == d->prefer) {
+        return;
+    }
+    d->prefer = prefer;
+    Q_EMIT preferChanged();
+}
+
+PaletteStore* PaletteExtractor::store() const
+{
+    return d->store;
+}
+
+void PaletteExtractor::setStore(PaletteStore* store)
+{
+    if (store == d->store) {
+        return;
+    }
+    d->store = store;
+    Q_EMIT storeChanged();
+}
+
+bool PaletteExtractor::isRunning() const
+{
+    return d->running;
+}
+
+void PaletteExtractor::run(const QUrl& wallpaperUrl)
+{
+    if (!wallpaperUrl.isLocalFile()) {
+        Q_EMIT failed(wallpaperUrl.toString(), QStringLiteral("wallpaper URL is not a local file"));
+        return;
+    }
+    run(wallpaperUrl.toLocalFile());
+}
+
+void PaletteExtractor::run(const QString& wallpaperPath)
+{
+    if (!QFileInfo::exists(wallpaperPath)) {
+        Q_EMIT failed(wallpaperPath, QStringLiteral("wallpaper does not exist"));
+        return;
+    }
+    // Absolute for the same reason MatugenRunner normalises: the path is
+    // reported back in the signals and should not depend on the cwd.
+    const QString absolutePath = QFileInfo(wallpaperPath).absoluteFilePath();
+
+    // A superseded worker runs to completion, but its future is cancelled,
+    // so it reports no result, and setFuture() below stops the watcher
+    // listening to it anyway.
+    d->watcher.cancel();
+    d->pendingWallpaper = absolutePath;
+    d->watcher.setFuture(QtConcurrent::run(extract, absolutePath, d->mode, d->prefer));
+    setRunning(true);
+}
+
+void PaletteExtractor::cancel()
+{
+    if (!d->running) {
+        return;
+    }
+    d->watcher.cancel();
+    setRunning(false);
+}
+
+void PaletteExtractor::setRunning(bool running)
+{
+    if (running == d->running) {
+        return;
+    }
+    d->running = running;
+    Q_EMIT runningChanged();
+}
+
+QList<QColor> PaletteExtractor::sourceColors(const QImage& image)
+{
+    QList<QColor> out;
+    const QList<QRgb> ranked = rankSourceColors(image);
+    out.reserve(ranked.size());
+    for (const QRgb argb : ranked) {
+        out.append(QColor::fromRgb(argb));
+    }
+    return out;
+}
+
+QVariantMap PaletteExtractor::tokensForSourceColor(const QColor& source, const QString& mode)
+{
+    // Material's tonal-spot scheme: one hue family at moderate chroma,
+    // tertiary rotated 60°, near-neutral surfaces tinted with the hue.
+    const detail::Hct hct = detail::Hct::fromArgb(source.rgb());
+    detail::TonalPalette primary(hct.hue, 36.0);
+    detail::TonalPalette secondary(hct.hue, 16.0);
+    detail::TonalPalette tertiary(hct.hue + 60.0, 24.0);
+    detail::TonalPalette neutral(hct.hue, 6.0);
+    detail::TonalPalette neutralVariant(hct.hue, 8.0);
+    detail::TonalPalette error(25.0, 84.0);
+
+    struct Role
+    {
+        const char* name;
+        detail::TonalPalette* palette;
+        int darkTone;
+        int lightTone;
+    };
+    const Role roles[] = {
+        {"background", &neutral, 6, 98},
+        {"on_background", &neutral, 90, 10},
+        {"surface", &neutral, 6, 98},
+        {"surface_dim", &neutral, 6, 87},
+        {"surface_bright", &neutral, 24, 98},
+        {"surface_container_lowest", &neutral, 4, 100},
+        {"surface_container_low", &neutral, 10, 96},
+        {"surface_container", &neutral, 12, 94},
+        {"surface_container_high", &neutral, 17, 92},
+        {"surface_container_highest", &neutral, 22, 90},
+        {"on_surface", &neutral, 90, 10},
+        {"surface_variant", &neutralVariant, 30, 90},
+        {"on_surface_variant", &neutralVariant, 80, 30},
+        {"inverse_surface", &neutral, 90, 20},
+        {"inverse_on_surface", &neutral, 20, 95},
+        {"outline", &neutralVariant, 60, 50},
+        {"outline_variant", &neutralVariant, 30, 80},
+        {"shadow", &neutral, 0, 0},
+        {"scrim", &neutral, 0, 0},
+        {"surface_tint", &primary, 80, 40},
+        {"primary", &primary, 80, 40},
+        {"on_primary", &primary, 20, 100},
+        {"primary_container", &primary, 30, 90},
+        {"on_primary_container", &primary, 90, 10},
+        {"inverse_primary", &primary, 40, 80},
+        {"secondary", &secondary, 80, 40},
+        {"on_secondary", &secondary, 20, 100},
+        {"secondary_container", &secondary, 30, 90},
+        {"on_secondary_container", &secondary, 90, 10},
+        {"tertiary", &tertiary, 80, 40},
+        {"on_tertiary", &tertiary, 20, 100},
+        {"tertiary_container", &tertiary, 30, 90},
+        {"on_tertiary_container", &tertiary, 90, 10},
+        {"error", &error, 80, 40},
+        {"on_error", &error, 20, 100},
+        {"error_container", &error, 30, 90},
+        {"on_error_container", &error, 90, 10},
+        {"primary_fixed", &primary, 90, 90},
+        {"primary_fixed_dim", &primary, 80, 80},
+        {"on_primary_fixed", &primary, 10, 10},
+        {"on_primary_fixed_variant", &primary, 30, 30},
+        {"secondary_fixed", &secondary, 90, 90},
+        {"secondary_fixed_dim", &secondary, 80, 80},
+        {"on_secondary_fixed", &secondary, 10, 10},
+        {"on_secondary_fixed_variant", &secondary, 30, 30},
+        {"tertiary_fixed", &tertiary, 90, 90},
+        {"tertiary_fixed_dim", &tertiary, 80, 80},
+        {"on_tertiary_fixed", &tertiary, 10, 10},
+        {"on_tertiary_fixed_variant", &tertiary, 30, 30},
+    };
+
+    const bool light = mode == QLatin1String("light");
+    QVariantMap tokens;
+    tokens.insert(QStringLiteral("source_color"), source);
+    for (const Role& role : roles) {
+        const int tone = light ? role.lightTone : role.darkTone;
+        tokens.insert(QLatin1String(role.name), QColor::fromRgb(role.palette->tone(tone)));
+    }
+    return tokens;
+}
+
+} // namespace PhosphorTheme
@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "sourcecolorcache.h"
+
+#include "phosphortheme_logging.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace PhosphorTheme::detail {
+
+namespace {
+
+constexpr quint32 kMagic = 0x50545343; // "PTSC"
+// Bump when the record layout or the extraction algorithm changes; an older
+// file is then ignored and rewritten on the next insert.
+constexpr quint32 kFormatVersion = 1;
+
+// Bounds a corrupt file: a ranked list is at most a handful of candidates.
+constexpr qsizetype kMaxColorsPerEntry = 16;
+
+} // namespace
+
+SourceColorCache& SourceColorCache::instance()
+{
+    static SourceColorCache cache(defaultCacheFile());
+    return cache;
+}
+
+SourceColorCache::SourceColorCache(QString cacheFile)
+    : m_file(std::move(cacheFile))
+{
+}
+
+QString SourceColorCache::defaultCacheFile()
+{
+    const QString base = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    if (base.isEmpty()) {
+        return {};
+    }
+    return base + QStringLiteral("/phosphor-theme/source-colors.cache");
+}
+
+std::optional<QList<QRgb>> SourceColorCache::lookup(const QByteArray& contentHash)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_loaded) {
+        loadLocked();
+    }
+    const auto it = m_entries.constFind(contentHash);
+    if (it == m_entries.constEnd()) {
+        return std::nullopt;
+    }
+    return *it;
+}
+
+void SourceColorCache::insert(const QByteArray& contentHash, const QList<QRgb>& colors)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_loaded) {
+        loadLocked();
+    }
+    if (m_entries.contains(contentHash)) {
+        m_order.removeOne(contentHash);
+    }
+    m_entries.insert(contentHash, colors);
+    m_order.append(contentHash);
+    while (m_order.size() > kMaxEntries) {
+        m_entries.remove(m_order.takeFirst());
+    }
+    saveLocked();
+}
+
+void SourceColorCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_entries.clear();
+    m_order.clear();
+    m_loaded = true;
+    if (!m_file.isEmpty()) {
+        QFile::remove(m_file);
+    }
+}
+
+void SourceColorCache::loadLocked()
+{
+    m_loaded = true;
+    if (m_file.isEmpty()) {
+        return;
+    }
+    QFile f(m_file);
+    if (!f.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream in(&f);
+    in.setVersion(QDataStream::Qt_6_5);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint32 count = 0;
+    in >> magic >> version >> count;
+    if (magic != kMagic || version != kFormatVersion || count < 0 || count > kMaxEntries) {
+        return;
+    }
+
+    QHash<QByteArray, QList<QRgb>> entries;
+    QList<QByteArray> order;
+    entries.reserve(count);
+    for (qint32 i = 0; i < count; ++i) {
+        QByteArray key;
+        QList<quint32> colors;
+        in >> key >> colors;
+        if (in.status() != QDataStream::Ok || colors.isEmpty() || colors.size() > kMaxColorsPerEntry) {
+            qCDebug(lcPhosphorTheme) << "ignoring damaged source color cache" << m_file;
+            return;
+        }
+        if (!entries.contains(key)) {
+            order.append(key);
+        }
+        entries.insert(key, colors);
+    }
+    m_entries = std::move(entries);
+    m_order = std::move(order);
+}
+
+void SourceColorCache::saveLocked()
+{
+    if (m_file.isEmpty() || !QDir().mkpath(QFileInfo(m_file).absolutePath())) {
+        return;
+    }
+    QSaveFile f(m_file);
+    if (!f.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QDataStream out(&f);
+    out.setVersion(QDataStream::Qt_6_5);
+    out << kMagic << kFormatVersion << qint32(m_order.size());
+    for (const QByteArray& key : std::as_const(m_order)) {
+        out << key << m_entries.value(key);
+    }
+    if (out.status() != QDataStream::Ok || !f.commit()) {
+        qCDebug(lcPhosphorTheme) << "failed to write source color cache" << m_file;
+    }
+}
+
+} // namespace PhosphorTheme::detail
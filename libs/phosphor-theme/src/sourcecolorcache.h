@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#pragma once
+
+// Private, built into PhosphorTheme, not installed. Remembers the ranked
+// source colors PaletteExtractor found per wallpaper, keyed on a hash of
+// the file's bytes, and persists them under the user cache dir. The
+// expensive part of extraction is decode + quantize; everything after the
+// source color (scheme, mode, prefer) is cheap, so this is the one result
+// worth keeping across theme switches and restarts. Thread-safe: workers
+// from several extractors may hit it at once.
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QRgb>
+#include <QString>
+
+#include <optional>
+
+namespace PhosphorTheme::detail {
+
+class SourceColorCache
+{
+public:
+    // Process-wide instance persisting to defaultCacheFile().
+    static SourceColorCache& instance();
+
+    // `cacheFile` is where entries persist; empty keeps them in memory only.
+    explicit SourceColorCache(QString cacheFile);
+
+    [[nodiscard]] std::optional<QList<QRgb>> lookup(const QByteArray& contentHash);
+
+    // Records `colors` and writes the cache out. Beyond kMaxEntries the
+    // least recently inserted entry is dropped.
+    void insert(const QByteArray& contentHash, const QList<QRgb>& colors);
+
+    // Drops every entry, in memory and on disk.
+    void clear();
+
+    // `<GenericCacheLocation>/phosphor-theme/source-colors.cache`, or empty
+    // when there is no writable cache location.
+    [[nodiscard]] static QString defaultCacheFile();
+
+    static constexpr int kMaxEntries = 256;
+
+private:
+    void loadLocked();
+    void saveLocked();
+
+    QMutex m_mutex;
+    QString m_file;
+    QHash<QByteArray, QList<QRgb>> m_entries;
+    QList<QByteArray> m_order; // insertion order, oldest first
+    bool m_loaded = false;
+};
+
+} // namespace PhosphorTheme::detail
@@ -6,14 +6,23 @@
 #include "phosphortheme_logging.h"
 
 #include <QColor>
+#include <QDateTime>
 #include <QDebug>
 #include <QFile>
+#include <QFileInfo>
+#include <QHash>
 #include <QLatin1String>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QRegularExpression>
 #include <QRegularExpressionMatch>
 #include <QSaveFile>
 #include <QString>
 #include <QVariant>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <optional>
 
 // Definition of the library-wide logging category declared in
 // phosphortheme_logging.h. Lives here (any one TU works) so the
@@ -24,24 +33,107 @@ namespace PhosphorTheme {
 
 namespace {
 
-// Map a single-token reference to its rendered string. The reference
-// is a token name plus an optional `.field`. Field defaults to "hex"
+// Parsed `.field` suffix. Unknown keeps the spelling around for the
+// warning and renders as Hex.
+enum class Field {
+    Hex,
+    Hexa,
+    Red,
+    Green,
+    Blue,
+    Alpha,
+    Rgb,
+    Rgba,
+    Unknown,
+};
+
+Field parseField(const QString& field)
+{
+    if (field.isEmpty() || field == QLatin1String("hex")) {
+        return Field::Hex;
+    }
+    if (field == QLatin1String("hexa")) {
+        return Field::Hexa;
+    }
+    if (field == QLatin1String("r") || field == QLatin1String("red")) {
+        return Field::Red;
+    }
+    if (field == QLatin1String("g") || field == QLatin1String("green")) {
+        return Field::Green;
+    }
+    if (field == QLatin1String("b") || field == QLatin1String("blue")) {
+        return Field::Blue;
+    }
+    if (field == QLatin1String("a") || field == QLatin1String("alpha")) {
+        return Field::Alpha;
+    }
+    if (field == QLatin1String("rgb")) {
+        return Field::Rgb;
+    }
+    if (field == QLatin1String("rgba")) {
+        return Field::Rgba;
+    }
+    return Field::Unknown;
+}
+
+// Map a resolved color to its rendered string. Field defaults to "hex"
 // because that is the most common case for CSS and config files.
 //
-// Returned `ok` is false only when the token is unknown. In that case
-// the caller leaves the original `{{...}}` placeholder in place. An
-// unknown FIELD on a known token logs a qCWarning AND renders the
+// An unknown FIELD on a known token logs a qCWarning AND renders the
 // default hex form — the warning is the loud part (so the template
 // author sees the typo in the journal), the rendering is the
 // graceful-degradation part (so a save still produces a usable
 // output file instead of crashing mid-render). A typo in a field
 // name is less critical than a missing color, and a renderer crash
 // mid-save would be worse than a fallback render.
-QString renderToken(const QString& name, const QString& field, const QVariantMap& tokens, bool& ok)
+QString formatColor(const QColor& c, Field field, const QString& fieldName, const QString& name)
+{
+    switch (field) {
+    case Field::Hex:
+        return c.name(QColor::HexRgb).toUpper();
+    case Field::Hexa:
+        return c.name(QColor::HexArgb).toUpper();
+    case Field::Red:
+        return QString::number(c.red());
+    case Field::Green:
+        return QString::number(c.green());
+    case Field::Blue:
+        return QString::number(c.blue());
+    case Field::Alpha:
+        return QString::number(c.alphaF(), 'f', 3);
+    case Field::Rgb:
+        return QStringLiteral("%1, %2, %3").arg(c.red()).arg(c.green()).arg(c.blue());
+    case Field::Rgba:
+        return QStringLiteral("%1, %2, %3, %4")
+            .arg(c.red())
+            .arg(c.green())
+            .arg(c.blue())
+            .arg(QString::number(c.alphaF(), 'f', 3));
+    case Field::Unknown:
+        break;
+    }
+
+    // Unknown field: degrade to the default hex form. Logged so the
+    // template author can spot the typo without the substitution
+    // disappearing silently.
+    qCWarning(lcPhosphorTheme).noquote() << "phosphor-theme: unknown template field" << fieldName << "on token" << name
+                                         << ", falling back to hex";
+    return c.name(QColor::HexRgb).toUpper();
+}
+
+// Resolve a token name to its color. Returns an invalid QColor when the
+// token is unknown or not a color; the caller then leaves the original
+// `{{...}}` placeholder in place.
+QColor resolveToken(const QString& name, const QVariantMap& tokens)
 {
-    ok = false;
     const auto it = tokens.constFind(name);
     if (it == tokens.constEnd()) {
+        // Unknown token, keep the placeholder so the failure is
+        // visible in the rendered output. Loud warning to stderr so
+        // the user can spot rename mistakes. Routed through the
+        // shared lcPhosphorTheme category so a filter that mutes
+        // the unknown-field warning also catches this one.
+        qCWarning(lcPhosphorTheme).noquote() << "phosphor-theme: unknown token in template:" << name;
         return {};
     }
 
@@ -52,57 +144,148 @@ QString renderToken(const QString& name, const QString& field, const QVariantMap
         // applyPalette / extractValidTokens) converts hex strings and
         // named colors to QColor before storing, so a non-QColor here
         // means the caller passed a map that skipped that normalisation.
-        // Leave the placeholder in place via ok=false (graceful
-        // degradation) AND warn — symmetric with the unknown-field path
-        // below, which also warns + degrades, so the miss is never
-        // silent.
+        // Leave the placeholder in place (graceful degradation) AND
+        // warn — symmetric with the unknown-field path, which also
+        // warns + degrades, so the miss is never silent.
         qCWarning(lcPhosphorTheme).noquote()
             << "phosphor-theme: template token" << name
             << "has a non-color value; render() expects a QColor-normalised token map. Leaving placeholder in place";
-        return {};
     }
-    ok = true;
+    return c;
+}
 
-    if (field.isEmpty() || field == QLatin1String("hex")) {
-        return c.name(QColor::HexRgb).toUpper();
-    }
-    if (field == QLatin1String("hexa")) {
-        return c.name(QColor::HexArgb).toUpper();
-    }
-    if (field == QLatin1String("r") || field == QLatin1String("red")) {
-        return QString::number(c.red());
+// Parsed templates by path, reused while the file's mtime and size match.
+// Process-wide and shared by every renderFile caller, including the
+// parallel workers of renderFiles.
+class PlanCache
+{
+public:
+    static PlanCache& instance()
+    {
+        static PlanCache cache;
+        return cache;
     }
-    if (field == QLatin1String("g") || field == QLatin1String("green")) {
-        return QString::number(c.green());
+
+    std::optional<CompiledTemplate> find(const QString& path, qint64 mtime, qint64 size)
+    {
+        QMutexLocker locker(&m_mutex);
+        const auto it = m_entries.constFind(path);
+        if (it == m_entries.constEnd() || it->mtime != mtime || it->size != size) {
+            return std::nullopt;
+        }
+        return it->plan;
     }
-    if (field == QLatin1String("b") || field == QLatin1String("blue")) {
-        return QString::number(c.blue());
+
+    void insert(const QString& path, qint64 mtime, qint64 size, const CompiledTemplate& plan)
+    {
+        QMutexLocker locker(&m_mutex);
+        // Fan-out sets are a few dozen files; the bound only stops a
+        // caller cycling through throwaway template paths from growing
+        // the cache forever.
+        if (m_entries.size() >= kMaxEntries && !m_entries.contains(path)) {
+            m_entries.clear();
+        }
+        m_entries.insert(path, {mtime, size, plan});
     }
-    if (field == QLatin1String("a") || field == QLatin1String("alpha")) {
-        return QString::number(c.alphaF(), 'f', 3);
+
+private:
+    static constexpr qsizetype kMaxEntries = 256;
+
+    struct Entry
+    {
+        qint64 mtime = 0;
+        qint64 size = 0;
+        CompiledTemplate plan;
+    };
+
+    QMutex m_mutex;
+    QHash<QString, Entry> m_entries;
+};
+
+// Read and parse `templatePath`, or reuse the cached plan. Logs and
+// returns nullopt on any IO failure.
+std::optional<CompiledTemplate> loadTemplate(const QString& templatePath)
+{
+    const QFileInfo info(templatePath);
+    const qint64 mtime = info.lastModified().toMSecsSinceEpoch();
+    const qint64 size = info.size();
+    if (info.isFile()) {
+        if (auto cached = PlanCache::instance().find(templatePath, mtime, size)) {
+            return cached;
+        }
     }
-    if (field == QLatin1String("rgb")) {
-        return QStringLiteral("%1, %2, %3").arg(c.red()).arg(c.green()).arg(c.blue());
+
+    QFile in(templatePath);
+    if (!in.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qCWarning(lcPhosphorTheme).noquote()
+            << "phosphor-theme: cannot open template" << templatePath << ", " << in.errorString();
+        return std::nullopt;
     }
-    if (field == QLatin1String("rgba")) {
-        return QStringLiteral("%1, %2, %3, %4")
-            .arg(c.red())
-            .arg(c.green())
-            .arg(c.blue())
-            .arg(QString::number(c.alphaF(), 'f', 3));
+    const auto raw = in.readAll();
+    if (in.error() != QFileDevice::NoError) {
+        // readAll() returns whatever it managed to read on a short
+        // read (truncated NFS mounts, signal-interrupted reads).
+        // Without this check we'd silently render a partial template
+        // and atomically commit a half-rendered output, which is
+        // exactly the failure mode QSaveFile is supposed to prevent.
+        qCWarning(lcPhosphorTheme).noquote()
+            << "phosphor-theme: short read on template" << templatePath << ", " << in.errorString();
+        return std::nullopt;
     }
+    in.close();
 
-    // Unknown field: degrade to the default hex form. Logged so the
-    // template author can spot the typo without the substitution
-    // disappearing silently.
-    qCWarning(lcPhosphorTheme).noquote() << "phosphor-theme: unknown template field" << field << "on token" << name
-                                         << ", falling back to hex";
-    return c.name(QColor::HexRgb).toUpper();
+    CompiledTemplate plan(QString::fromUtf8(raw));
+    // Keyed on the stat taken before the read: if the file changed in
+    // between, the next call sees a different mtime or size and reparses.
+    PlanCache::instance().insert(templatePath, mtime, size, plan);
+    return plan;
+}
+
+// True when `path` already holds exactly `payload`.
+bool hasContent(const QString& path, const QByteArray& payload)
+{
+    QFile existing(path);
+    if (existing.size() != payload.size() || !existing.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    return existing.readAll() == payload && existing.error() == QFileDevice::NoError;
 }
 
 } // namespace
 
-QString TemplateEngine::render(const QString& templateSource, const QVariantMap& tokens)
+struct CompiledTemplate::Plan
+{
+    // One `{{...}}` occurrence, preceded by the literal run before it.
+    struct Segment
+    {
+        qsizetype literalStart = 0;
+        qsizetype literalLength = 0;
+        qsizetype rawStart = 0; // the placeholder as written, kept for unresolved tokens
+        qsizetype rawLength = 0;
+        int placeholder = 0; // index into `placeholders`
+    };
+
+    // A distinct `token.field` pair.
+    struct Placeholder
+    {
+        int slot = 0; // index into `names`
+        Field field = Field::Hex;
+        QString fieldName;
+    };
+
+    QString source;
+    QList<Segment> segments;
+    qsizetype tailStart = 0; // literal run after the last placeholder
+    QList<Placeholder> placeholders;
+    QStringList names;
+};
+
+CompiledTemplate::CompiledTemplate()
+    : m_plan(std::make_shared<Plan>())
+{
+}
+
+CompiledTemplate::CompiledTemplate(const QString& templateSource)
 {
     // Capture group 1 = token name (alnum + underscore).
     // Capture group 2 = optional field (alphabetic), without the dot.
@@ -112,70 +295,116 @@ QString TemplateEngine::render(const QString& templateSource, const QVariantMap&
     static const QRegularExpression re(
         QStringLiteral(R"(\{\{\s*([A-Za-z_][A-Za-z0-9_]*)\s*(?:\.\s*([A-Za-z]+))?\s*\}\})"));
 
-    QString result;
-    // Pre-reserve to damp the per-append realloc storm. This is a coarse
-    // hint, not a precise prediction: output size is driven by how many
-    // placeholders the template contains (not knowable without scanning
-    // it twice) and how each renders (7-16 chars, e.g. "#RRGGBBAA" or
-    // "255, 200, 100, 1.000"). `tokens.size() * 16` is just a cheap
-    // proxy for "expect roughly token-count expansions"; reserve only
-    // hints capacity, so an over- or under-estimate costs at most a
-    // realloc, never correctness.
-    result.reserve(templateSource.size() + tokens.size() * 16);
+    auto plan = std::make_shared<Plan>();
+    plan->source = templateSource;
 
+    QHash<QString, int> slotByName;
+    QHash<QPair<int, QString>, int> placeholderByKey;
     qsizetype cursor = 0;
-    const QStringView source(templateSource);
-    auto it = re.globalMatch(templateSource);
+    auto it = re.globalMatch(plan->source);
     while (it.hasNext()) {
         const auto match = it.next();
-        result.append(source.mid(cursor, match.capturedStart() - cursor));
-
         const auto name = match.captured(1);
-        const auto field = match.captured(2);
+        const auto fieldName = match.captured(2);
 
-        bool ok = false;
-        const auto rendered = renderToken(name, field, tokens, ok);
-        if (ok) {
-            result.append(rendered);
-        } else {
-            // Unknown token, keep the placeholder so the failure is
-            // visible in the rendered output. Loud warning to stderr so
-            // the user can spot rename mistakes. Routed through the
-            // shared lcPhosphorTheme category so a filter that mutes
-            // the unknown-field warning above also catches this one.
-            qCWarning(lcPhosphorTheme).noquote() << "phosphor-theme: unknown token in template:" << name;
-            result.append(match.captured(0));
+        auto slot = slotByName.constFind(name);
+        if (slot == slotByName.constEnd()) {
+            slot = slotByName.insert(name, int(plan->names.size()));
+            plan->names.append(name);
+        }
+        const QPair<int, QString> key(*slot, fieldName);
+        auto placeholder = placeholderByKey.constFind(key);
+        if (placeholder == placeholderByKey.constEnd()) {
+            placeholder = placeholderByKey.insert(key, int(plan->placeholders.size()));
+            plan->placeholders.append({*slot, parseField(fieldName), fieldName});
         }
+
+        plan->segments.append({cursor, match.capturedStart() - cursor, match.capturedStart(), match.capturedLength(),
+                               *placeholder});
         cursor = match.capturedEnd();
     }
-    result.append(source.mid(cursor));
+    plan->tailStart = cursor;
+    m_plan = std::move(plan);
+}
+
+CompiledTemplate::~CompiledTemplate() = default;
+CompiledTemplate::CompiledTemplate(const CompiledTemplate&) = default;
+CompiledTemplate& CompiledTemplate::operator=(const CompiledTemplate&) = default;
+
+QStringList CompiledTemplate::tokenNames() const
+{
+    return m_plan->names;
+}
+
+int CompiledTemplate::placeholderCount() const
+{
+    return int(m_plan->segments.size());
+}
+
+QString CompiledTemplate::render(const QVariantMap& tokens) const
+{
+    const Plan& plan = *m_plan;
+    if (plan.segments.isEmpty()) {
+        return plan.source;
+    }
+
+    // One map lookup per distinct token, one format per distinct
+    // token.field. A null string marks an unresolved token.
+    QList<QColor> colors;
+    colors.reserve(plan.names.size());
+    for (const QString& name : plan.names) {
+        colors.append(resolveToken(name, tokens));
+    }
+    QStringList rendered;
+    rendered.reserve(plan.placeholders.size());
+    for (const Plan::Placeholder& placeholder : plan.placeholders) {
+        const QColor& c = colors.at(placeholder.slot);
+        rendered.append(c.isValid() ? formatColor(c, placeholder.field, placeholder.fieldName,
+                                                  plan.names.at(placeholder.slot))
+                                    : QString());
+    }
+
+    const QStringView source(plan.source);
+    qsizetype size = source.size() - plan.tailStart;
+    for (const Plan::Segment& segment : plan.segments) {
+        const QString& value = rendered.at(segment.placeholder);
+        size += segment.literalLength + (value.isNull() ? segment.rawLength : value.size());
+    }
+    QString result;
+    result.reserve(size);
+    for (const Plan::Segment& segment : plan.segments) {
+        result.append(source.mid(segment.literalStart, segment.literalLength));
+        const QString& value = rendered.at(segment.placeholder);
+        if (value.isNull()) {
+            result.append(source.mid(segment.rawStart, segment.rawLength));
+        } else {
+            result.append(value);
+        }
+    }
+    result.append(source.mid(plan.tailStart));
     return result;
 }
 
+QString TemplateEngine::render(const QString& templateSource, const QVariantMap& tokens)
+{
+    return CompiledTemplate(templateSource).render(tokens);
+}
+
 bool TemplateEngine::renderFile(const QString& templatePath, const QString& outPath, const QVariantMap& tokens)
 {
-    QFile in(templatePath);
-    if (!in.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qCWarning(lcPhosphorTheme).noquote()
-            << "phosphor-theme: cannot open template" << templatePath << ", " << in.errorString();
-        return false;
-    }
-    const auto raw = in.readAll();
-    if (in.error() != QFileDevice::NoError) {
-        // readAll() returns whatever it managed to read on a short
-        // read (truncated NFS mounts, signal-interrupted reads).
-        // Without this check we'd silently render a partial template
-        // and atomically commit a half-rendered output, which is
-        // exactly the failure mode QSaveFile is supposed to prevent.
-        qCWarning(lcPhosphorTheme).noquote()
-            << "phosphor-theme: short read on template" << templatePath << ", " << in.errorString();
+    const auto plan = loadTemplate(templatePath);
+    if (!plan) {
         return false;
     }
-    const auto src = QString::fromUtf8(raw);
-    in.close();
+    const auto payload = plan->render(tokens).toUtf8();
 
-    const auto rendered = render(src, tokens);
-    const auto payload = rendered.toUtf8();
+    // Most palette changes leave most fan-out files as they were (a
+    // template that only uses tokens the change did not touch). Rewriting
+    // them anyway would bump their mtime and wake every app watching its
+    // config for nothing.
+    if (hasContent(outPath, payload)) {
+        return true;
+    }
 
     // Atomic write: QSaveFile writes to a temp sibling and renames
     // into place on commit(). A crash mid-write leaves the previous
@@ -214,4 +443,17 @@ bool TemplateEngine::renderFile(const QString& templatePath, const QString& outP
     return true;
 }
 
+bool TemplateEngine::renderFiles(const QList<Target>& targets, const QVariantMap& tokens)
+{
+    // Each target is independent file IO plus a render; the shared state
+    // (the plan cache, the logging category) is thread-safe, and `tokens`
+    // is only read.
+    const auto results = QtConcurrent::blockingMapped<QList<bool>>(targets, [&tokens](const Target& target) {
+        return renderFile(target.templatePath, target.outPath, tokens);
+    });
+    return std::all_of(results.cbegin(), results.cend(), [](bool ok) {
+        return ok;
+    });
+}
+
 } // namespace PhosphorTheme
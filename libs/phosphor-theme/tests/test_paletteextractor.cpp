@@ -0,0 +1,284 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <PhosphorTheme/PaletteExtractor.h>
+#include <PhosphorTheme/PaletteStore.h>
+
+#include <QColor>
+#include <QFile>
+#include <QImage>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QUrl>
+#include <QVariantMap>
+
+using namespace PhosphorTheme;
+
+// The extractor is exercised end to end on small generated images, so the
+// expected source colors are known exactly. The QML-facing run() path is
+// covered against a real PaletteStore; the per-target XDG sandbox keeps the
+// source color cache out of the developer's ~/.cache.
+
+namespace {
+
+QImage solidImage(const QColor& color, int width = 64, int height = 48)
+{
+    QImage image(width, height, QImage::Format_ARGB32);
+    image.fill(color);
+    return image;
+}
+
+// Left `dominantShare` of the columns in `dominant`, the rest in `other`.
+QImage splitImage(const QColor& dominant, const QColor& other, double dominantShare)
+{
+    QImage image(100, 40, QImage::Format_ARGB32);
+    const int split = int(100 * dominantShare);
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) {
+            image.setPixelColor(x, y, x < split ? dominant : other);
+        }
+    }
+    return image;
+}
+
+double lightness(const QVariant& value)
+{
+    return value.value<QColor>().lightnessF();
+}
+
+} // namespace
+
+class TestPaletteExtractor : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void sourceColors_solidImageYieldsItsColor();
+    void sourceColors_dominantColorRanksFirst();
+    void sourceColors_greyscaleFallsBackToDefault();
+    void sourceColors_ignoresTranslucentPixels();
+    void tokens_coverPhosphorRoles();
+    void tokens_modeFlipsToneOrdering();
+    void tokens_followSourceHue();
+    void run_appliesToStoreAndEmitsReady();
+    void run_repeatAndModeSwitchReuseCachedSource();
+    void run_emitsFailedOnMissingWallpaper();
+    void run_emitsFailedOnUndecodableFile();
+    void runUrl_rejectsNonLocalUrl();
+    void cancel_dropsInflightResult();
+};
+
+void TestPaletteExtractor::sourceColors_solidImageYieldsItsColor()
+{
+    const QColor teal(0x1a, 0x8a, 0x94);
+    const QList<QColor> colors = PaletteExtractor::sourceColors(solidImage(teal));
+    QCOMPARE(colors.size(), 1);
+    QCOMPARE(colors.first(), teal);
+}
+
+void TestPaletteExtractor::sourceColors_dominantColorRanksFirst()
+{
+    const QColor teal(0x1a, 0x8a, 0x94);
+    const QColor orange(0xe6, 0x78, 0x2a);
+    const QList<QColor> colors = PaletteExtractor::sourceColors(splitImage(teal, orange, 0.8));
+    QCOMPARE(colors.size(), 2);
+    QCOMPARE(colors.at(0), teal);
+    QCOMPARE(colors.at(1), orange);
+}
+
+void TestPaletteExtractor::sourceColors_greyscaleFallsBackToDefault()
+{
+    const QList<QColor> colors = PaletteExtractor::sourceColors(splitImage(Qt::black, QColor(0x80, 0x80, 0x80), 0.5));
+    QCOMPARE(colors.size(), 1);
+    QCOMPARE(colors.first(), QColor(0x42, 0x85, 0xf4));
+}
+
+void TestPaletteExtractor::sourceColors_ignoresTranslucentPixels()
+{
+    const QColor teal(0x1a, 0x8a, 0x94);
+    const QList<QColor> colors =
+        PaletteExtractor::sourceColors(splitImage(teal, QColor(0xe6, 0x78, 0x2a, 0x80), 0.3));
+    QCOMPARE(colors.size(), 1);
+    QCOMPARE(colors.first(), teal);
+}
+
+void TestPaletteExtractor::tokens_coverPhosphorRoles()
+{
+    const QVariantMap tokens = PaletteExtractor::tokensForSourceColor(QColor(0x42, 0x85, 0xf4), QStringLiteral("dark"));
+    for (const char* name :
+         {TokenNames::Background, TokenNames::Surface, TokenNames::SurfaceContainer, TokenNames::SurfaceContainerHigh,
+          TokenNames::SurfaceVariant, TokenNames::OnSurface, TokenNames::OnSurfaceVariant, TokenNames::Primary,
+          TokenNames::OnPrimary, TokenNames::PrimaryContainer, TokenNames::OnPrimaryContainer, TokenNames::Secondary,
+          TokenNames::OnSecondary, TokenNames::SecondaryContainer, TokenNames::Tertiary, TokenNames::OnTertiary,
+          TokenNames::TertiaryContainer, TokenNames::Error, TokenNames::OnError, TokenNames::ErrorContainer,
+          TokenNames::Outline, TokenNames::OutlineVariant}) {
+        const QVariant value = tokens.value(QLatin1String(name));
+        QVERIFY2(value.value<QColor>().isValid(), name);
+    }
+    // Phosphor extensions are left to PaletteStore's merge semantics.
+    QVERIFY(!tokens.contains(QLatin1String(TokenNames::BrandStop0)));
+    QVERIFY(!tokens.contains(QLatin1String(TokenNames::Success)));
+}
+
+void TestPaletteExtractor::tokens_modeFlipsToneOrdering()
+{
+    const QColor source(0x42, 0x85, 0xf4);
+    const QVariantMap dark = PaletteExtractor::tokensForSourceColor(source, QStringLiteral("dark"));
+    const QVariantMap light = PaletteExtractor::tokensForSourceColor(source, QStringLiteral("light"));
+
+    QVERIFY(lightness(dark.value(QStringLiteral("surface"))) < 0.15);
+    QVERIFY(lightness(light.value(QStringLiteral("surface"))) > 0.9);
+    QVERIFY(lightness(dark.value(QStringLiteral("primary"))) > lightness(light.value(QStringLiteral("primary"))));
+    QVERIFY(lightness(dark.value(QStringLiteral("on_primary"))) < lightness(dark.value(QStringLiteral("primary"))));
+    QVERIFY(lightness(light.value(QStringLiteral("on_primary")))
+            > lightness(light.value(QStringLiteral("primary"))));
+    // The surface ramp climbs in dark mode.
+    QVERIFY(lightness(dark.value(QStringLiteral("surface_container")))
+            < lightness(dark.value(QStringLiteral("surface_container_high"))));
+    QCOMPARE(light.value(QStringLiteral("on_primary")).value<QColor>(), QColor(Qt::white));
+}
+
+void TestPaletteExtractor::tokens_followSourceHue()
+{
+    const QVariantMap blue = PaletteExtractor::tokensForSourceColor(QColor(0x42, 0x85, 0xf4), QStringLiteral("dark"));
+    const QVariantMap red = PaletteExtractor::tokensForSourceColor(QColor(0xd0, 0x30, 0x20), QStringLiteral("dark"));
+    const QColor bluePrimary = blue.value(QStringLiteral("primary")).value<QColor>();
+    const QColor redPrimary = red.value(QStringLiteral("primary")).value<QColor>();
+    QVERIFY(bluePrimary.blue() > bluePrimary.red());
+    QVERIFY(redPrimary.red() > redPrimary.blue());
+    // Error is hue-independent.
+    QCOMPARE(blue.value(QStringLiteral("error")), red.value(QStringLiteral("error")));
+}
+
+void TestPaletteExtractor::run_appliesToStoreAndEmitsReady()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath(QStringLiteral("wallpaper.png"));
+    const QColor teal(0x1a, 0x8a, 0x94);
+    // Larger than the decode edge, so the scaled read path is taken.
+    QVERIFY(solidImage(teal, 640, 400).save(path));
+
+    PaletteStore store;
+    PaletteExtractor extractor;
+    extractor.setStore(&store);
+    QSignalSpy readySpy(&extractor, &PaletteExtractor::paletteReady);
+    QSignalSpy runningSpy(&extractor, &PaletteExtractor::runningChanged);
+
+    extractor.run(path);
+    QVERIFY(extractor.isRunning());
+    QVERIFY(readySpy.wait(5000));
+    QVERIFY(!extractor.isRunning());
+    QCOMPARE(runningSpy.count(), 2);
+
+    const QVariantMap tokens = readySpy.at(0).at(0).toMap();
+    QCOMPARE(readySpy.at(0).at(1).toString(), path);
+    QCOMPARE(tokens, PaletteExtractor::tokensForSourceColor(teal, QStringLiteral("dark")));
+    QCOMPARE(store.token(QStringLiteral("primary")), tokens.value(QStringLiteral("primary")).value<QColor>());
+    QCOMPARE(store.token(QStringLiteral("surface")), tokens.value(QStringLiteral("surface")).value<QColor>());
+}
+
+void TestPaletteExtractor::run_repeatAndModeSwitchReuseCachedSource()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath(QStringLiteral("wallpaper.png"));
+    const QColor teal(0x1a, 0x8a, 0x94);
+    const QColor orange(0xe6, 0x78, 0x2a);
+    QVERIFY(splitImage(teal, orange, 0.7).save(path));
+
+    PaletteExtractor extractor;
+    extractor.setPrefer(QString());
+    QSignalSpy readySpy(&extractor, &PaletteExtractor::paletteReady);
+
+    extractor.run(path);
+    QVERIFY(readySpy.wait(5000));
+    extractor.run(path);
+    QVERIFY(readySpy.wait(5000));
+    QCOMPARE(readySpy.at(1).at(0), readySpy.at(0).at(0));
+
+    // Same bytes, other mode and preference: the cached ranking is reused
+    // and only the scheme changes.
+    extractor.setMode(QStringLiteral("light"));
+    extractor.setPrefer(QStringLiteral("saturation"));
+    extractor.run(path);
+    QVERIFY(readySpy.wait(5000));
+    QCOMPARE(readySpy.at(2).at(0).toMap(), PaletteExtractor::tokensForSourceColor(orange, QStringLiteral("light")));
+
+    // A file replaced in place is a different key.
+    QFile::remove(path);
+    QVERIFY(solidImage(orange).save(path));
+    extractor.setMode(QStringLiteral("dark"));
+    extractor.run(path);
+    QVERIFY(readySpy.wait(5000));
+    QCOMPARE(readySpy.at(3).at(0).toMap(), PaletteExtractor::tokensForSourceColor(orange, QStringLiteral("dark")));
+}
+
+void TestPaletteExtractor::run_emitsFailedOnMissingWallpaper()
+{
+    PaletteExtractor extractor;
+    QSignalSpy failedSpy(&extractor, &PaletteExtractor::failed);
+    QSignalSpy runningSpy(&extractor, &PaletteExtractor::runningChanged);
+    extractor.run(QStringLiteral("/nonexistent/phosphor-theme-test-wallpaper.png"));
+    QCOMPARE(failedSpy.count(), 1);
+    QCOMPARE(runningSpy.count(), 0);
+    QVERIFY(!extractor.isRunning());
+}
+
+void TestPaletteExtractor::run_emitsFailedOnUndecodableFile()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath(QStringLiteral("wallpaper.png"));
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("definitely not an image");
+    file.close();
+
+    PaletteStore store;
+    const QVariantMap before = store.palette();
+    PaletteExtractor extractor;
+    extractor.setStore(&store);
+    QSignalSpy failedSpy(&extractor, &PaletteExtractor::failed);
+    QSignalSpy readySpy(&extractor, &PaletteExtractor::paletteReady);
+    extractor.run(path);
+    QVERIFY(failedSpy.wait(5000));
+    QCOMPARE(failedSpy.at(0).at(0).toString(), path);
+    QCOMPARE(readySpy.count(), 0);
+    QCOMPARE(store.palette(), before);
+    QVERIFY(!extractor.isRunning());
+}
+
+void TestPaletteExtractor::runUrl_rejectsNonLocalUrl()
+{
+    PaletteExtractor extractor;
+    QSignalSpy failedSpy(&extractor, &PaletteExtractor::failed);
+    extractor.run(QUrl(QStringLiteral("https://example.com/wallpaper.png")));
+    QCOMPARE(failedSpy.count(), 1);
+    QVERIFY(!extractor.isRunning());
+}
+
+void TestPaletteExtractor::cancel_dropsInflightResult()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath(QStringLiteral("wallpaper.png"));
+    QVERIFY(solidImage(QColor(0x6a, 0x3d, 0x9a), 320, 200).save(path));
+
+    PaletteExtractor extractor;
+    QSignalSpy readySpy(&extractor, &PaletteExtractor::paletteReady);
+    QSignalSpy runningSpy(&extractor, &PaletteExtractor::runningChanged);
+    extractor.run(path);
+    extractor.cancel();
+    QVERIFY(!extractor.isRunning());
+    QCOMPARE(runningSpy.count(), 2);
+    QVERIFY(!readySpy.wait(500));
+
+    // Cancelling an idle extractor is a no-op.
+    extractor.cancel();
+    QCOMPARE(runningSpy.count(), 2);
+}
+
+QTEST_MAIN(TestPaletteExtractor)
+#include "test_paletteextractor.moc"
@@ -4,7 +4,9 @@
 #include <PhosphorTheme/TemplateEngine.h>
 
 #include <QColor>
+#include <QDateTime>
 #include <QFile>
+#include <QFileInfo>
 #include <QTemporaryDir>
 #include <QTest>
 #include <QVariantMap>
@@ -27,8 +29,27 @@ private Q_SLOTS:
     void render_invalidColorValuePreservesPlaceholder();
     void renderFile_roundtripsTemplateToOutput();
     void renderFile_returnsFalseOnMissingTemplate();
+    void renderFile_leavesUnchangedOutputAlone();
+    void renderFile_picksUpTemplateEdits();
+    void renderFiles_rendersEveryTarget();
+    void compiled_matchesOneShotRender();
+    void compiled_sharesSlotsAcrossOccurrences();
+    void compiled_preservesUnresolvedPlaceholderSpelling();
 
 private:
+    static void writeFile(const QString& path, const QByteArray& contents)
+    {
+        QFile f(path);
+        QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        f.write(contents);
+    }
+
+    static QByteArray readFile(const QString& path)
+    {
+        QFile f(path);
+        return f.open(QIODevice::ReadOnly) ? f.readAll() : QByteArray();
+    }
+
     QVariantMap fixture() const
     {
         QVariantMap m;
@@ -139,5 +160,119 @@ void TestTemplateEngine::renderFile_returnsFalseOnMissingTemplate()
     QVERIFY(!QFile::exists(out));
 }
 
+void TestTemplateEngine::renderFile_leavesUnchangedOutputAlone()
+{
+    QTemporaryDir tmp;
+    QVERIFY(tmp.isValid());
+    const QString in = tmp.filePath(QStringLiteral("in.template"));
+    const QString out = tmp.filePath(QStringLiteral("out.css"));
+    writeFile(in, "accent: {{primary}};\n");
+
+    QVERIFY(TemplateEngine::renderFile(in, out, fixture()));
+    // Backdate the output so a rewrite would be visible in the mtime.
+    const QDateTime past = QDateTime::currentDateTime().addDays(-1);
+    {
+        QFile f(out);
+        QVERIFY(f.open(QIODevice::ReadWrite));
+        QVERIFY(f.setFileTime(past, QFileDevice::FileModificationTime));
+    }
+
+    // A token the template does not use changes: same bytes, no write.
+    auto tokens = fixture();
+    tokens.insert(QStringLiteral("on_primary"), QColor(Qt::red));
+    QVERIFY(TemplateEngine::renderFile(in, out, tokens));
+    QCOMPARE(QFileInfo(out).lastModified().toSecsSinceEpoch(), past.toSecsSinceEpoch());
+
+    // One it does use: rewritten.
+    tokens.insert(QStringLiteral("primary"), QColor(Qt::red));
+    QVERIFY(TemplateEngine::renderFile(in, out, tokens));
+    QCOMPARE(readFile(out), QByteArray("accent: #FF0000;\n"));
+    QVERIFY(QFileInfo(out).lastModified() > past);
+}
+
+void TestTemplateEngine::renderFile_picksUpTemplateEdits()
+{
+    QTemporaryDir tmp;
+    QVERIFY(tmp.isValid());
+    const QString in = tmp.filePath(QStringLiteral("in.template"));
+    const QString out = tmp.filePath(QStringLiteral("out.css"));
+    writeFile(in, "a: {{primary}};\n");
+    QVERIFY(TemplateEngine::renderFile(in, out, fixture()));
+    QCOMPARE(readFile(out), QByteArray("a: #3B82F6;\n"));
+
+    // The cached plan is keyed on mtime + size, so an edit that changes
+    // either is reparsed.
+    writeFile(in, "a: {{primary.rgb}}; b: {{scrim.hexa}};\n");
+    QVERIFY(TemplateEngine::renderFile(in, out, fixture()));
+    QCOMPARE(readFile(out), QByteArray("a: 59, 130, 246; b: #80000000;\n"));
+}
+
+void TestTemplateEngine::renderFiles_rendersEveryTarget()
+{
+    QTemporaryDir tmp;
+    QVERIFY(tmp.isValid());
+    QList<TemplateEngine::Target> targets;
+    for (int i = 0; i < 24; ++i) {
+        const QString in = tmp.filePath(QStringLiteral("in%1.template").arg(i));
+        writeFile(in, QStringLiteral("%1: {{primary}} {{on_primary.r}}\n").arg(i).toUtf8());
+        targets.append({in, tmp.filePath(QStringLiteral("out%1.conf").arg(i))});
+    }
+    QVERIFY(TemplateEngine::renderFiles(targets, fixture()));
+    for (int i = 0; i < targets.size(); ++i) {
+        QCOMPARE(readFile(targets.at(i).outPath), QStringLiteral("%1: #3B82F6 240\n").arg(i).toUtf8());
+    }
+
+    // One bad target fails the batch but not its siblings.
+    const QString orphanOut = tmp.filePath(QStringLiteral("orphan.conf"));
+    targets.append({tmp.filePath(QStringLiteral("missing.template")), orphanOut});
+    QFile::remove(targets.at(0).outPath);
+    QVERIFY(!TemplateEngine::renderFiles(targets, fixture()));
+    QVERIFY(QFile::exists(targets.at(0).outPath));
+    QVERIFY(!QFile::exists(orphanOut));
+}
+
+void TestTemplateEngine::compiled_matchesOneShotRender()
+{
+    const auto tokens = fixture();
+    const QStringList sources = {
+        QString(),
+        QStringLiteral("no placeholders at all"),
+        QStringLiteral("{{primary}}"),
+        QStringLiteral("x{{primary}}{{primary.hexa}}y"),
+        QStringLiteral("{{ on_primary . rgba }} and {{scrim.alpha}} then {{missing}} tail"),
+        QStringLiteral("{{primary.lol}} {{ {{primary}} }} {{ not-a-token }}"),
+    };
+    for (const QString& source : sources) {
+        const CompiledTemplate compiled(source);
+        QCOMPARE(compiled.render(tokens), TemplateEngine::render(source, tokens));
+        // Rendering a plan twice gives the same answer.
+        QCOMPARE(compiled.render(tokens), compiled.render(tokens));
+    }
+    QCOMPARE(CompiledTemplate().render(tokens), QString());
+}
+
+void TestTemplateEngine::compiled_sharesSlotsAcrossOccurrences()
+{
+    const CompiledTemplate compiled(QStringLiteral("{{primary}} {{primary.r}} {{on_primary}} {{primary}}"));
+    QCOMPARE(compiled.placeholderCount(), 4);
+    QCOMPARE(compiled.tokenNames(), QStringList({QStringLiteral("primary"), QStringLiteral("on_primary")}));
+
+    // A copy shares the plan and renders independently of the original.
+    const CompiledTemplate copy = compiled;
+    auto tokens = fixture();
+    tokens.insert(QStringLiteral("primary"), QColor(Qt::blue));
+    QCOMPARE(copy.render(tokens), QStringLiteral("#0000FF 0 #F0F9FF #0000FF"));
+    QCOMPARE(compiled.render(fixture()), QStringLiteral("#3B82F6 59 #F0F9FF #3B82F6"));
+}
+
+void TestTemplateEngine::compiled_preservesUnresolvedPlaceholderSpelling()
+{
+    // Two spellings of the same placeholder share a slot but each keeps
+    // its own text when the token cannot be resolved.
+    const CompiledTemplate compiled(QStringLiteral("[{{missing}}] [{{ missing .hex }}]"));
+    QCOMPARE(compiled.tokenNames(), QStringList({QStringLiteral("missing")}));
+    QCOMPARE(compiled.render(fixture()), QStringLiteral("[{{missing}}] [{{ missing .hex }}]"));
+}
+
 QTEST_MAIN(TestTemplateEngine)
 #include "test_templateengine.moc"
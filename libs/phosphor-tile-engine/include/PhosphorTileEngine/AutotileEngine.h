@@ -24,6 +24,7 @@
 #include <QHash>
 #include <QJsonObject>
 #include <QObject>
+#include <QPointer>
 #include <QRect>
 #include <QSet>
 #include <QSize>
@@ -1211,6 +1212,24 @@ public:
     /// tiled here (or has closed).
     QRect lastManagedRect(const QString& rawWindowId) const override;
 
+    // ═══════════════════════════════════════════════════════════════════════════
+    // Layout memoization
+    // ═══════════════════════════════════════════════════════════════════════════
+
+    /// Lifetime counters for the per-screen calculateZones() cache (see
+    /// m_zoneCache). A hit is a retile whose algorithm inputs were identical to
+    /// the screen's previous retile, so the algorithm was not called. The
+    /// daemon prints them in the support report's Autotile section.
+    struct ZoneCacheStats
+    {
+        quint64 hits = 0;
+        quint64 misses = 0;
+    };
+    ZoneCacheStats zoneCacheStats() const
+    {
+        return m_zoneCacheStats;
+    }
+
 private Q_SLOTS:
     void onWindowZoneChanged(const QString& windowId, const QString& zoneId);
     void onWindowAdded(const QString& windowId);
@@ -1717,6 +1736,23 @@ private:
     QSet<QString> m_retileRetryScreens;
     QHash<QString, int> m_retileRetryCount;
 
+    // Per-screen memo of the algorithm's last raw calculateZones() output.
+    // Retiles that change nothing the algorithm can see (focus churn on a
+    // focus-agnostic layout, a window-rules refresh, a no-op settings reload,
+    // a retry) are common, and a scripted algorithm pays a VM call for each.
+    // The key is the serialized algorithm input, compared exactly — not a
+    // digest — so a hit can never return another input's layout. Post-processing
+    // (min-size enforcement, clamping) still runs on a hit. The QPointer makes
+    // an algorithm reload or swap a miss. Cleared with the screen's scheduling.
+    struct ZoneCacheEntry
+    {
+        QPointer<PhosphorTiles::TilingAlgorithm> algorithm;
+        QByteArray key;
+        QVector<QRect> zones;
+    };
+    QHash<QString, ZoneCacheEntry> m_zoneCache;
+    ZoneCacheStats m_zoneCacheStats;
+
     // Deferred focus, keyed by screen: set by onWindowAdded and
     // requestPostRetileFocus, emitted after that screen's applyTiling so the
     // focus request arrives at KWin AFTER windowsTiled (whose onComplete raises
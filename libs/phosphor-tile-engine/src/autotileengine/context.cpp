@@ -151,6 +151,7 @@ void AutotileEngine::clearScreenScheduling(const QString& screenId)
     // recreates vs:N ids), its first applyTiling would consume the stale
     // entry and activate a window from the previous session of that screen.
     m_pendingFocusByScreen.remove(screenId);
+    m_zoneCache.remove(screenId);
 }
 
 void AutotileEngine::setCurrentActivity(const QString& activity)
@@ -4,6 +4,7 @@
 // Qt headers
 #include <algorithm>
 #include <cmath>
+#include <QDataStream>
 #include <QDebug>
 #include <QJsonArray>
 #include <QJsonDocument>
@@ -40,6 +41,71 @@
 
 namespace PhosphorTileEngine {
 
+namespace {
+
+void writeSplitNode(QDataStream& out, const PhosphorTiles::SplitNode* node)
+{
+    if (!node) {
+        out << qint8(0);
+        return;
+    }
+    out << qint8(1) << node->splitRatio << node->splitHorizontal << node->windowId;
+    writeSplitNode(out, node->first.get());
+    writeSplitNode(out, node->second.get());
+}
+
+/**
+ * Everything @p algo can observe through calculateZones(@p params), flattened
+ * into bytes for the per-screen zone cache: the params themselves plus the
+ * TilingState fields algorithms read (order, ratios, split tree, and the
+ * script bag when the algorithm keeps one). Two equal keys mean the algorithm
+ * would be handed the same input.
+ *
+ * Inputs the algorithm declares it ignores stay out of the key. The focus
+ * fields are keyed only when it reads them or retiles on focus, so a focus
+ * move is not a miss for the usual index-placed layout. currentGeometries is
+ * last retile's output, so keying on it would make every change miss twice;
+ * it is keyed only for an algorithm that reads it.
+ */
+QByteArray zoneCacheKey(const PhosphorTiles::TilingParams& params, const PhosphorTiles::TilingAlgorithm* algo)
+{
+    const bool keyFocus = algo->readsFocus() || algo->retilesOnFocusChange();
+
+    QByteArray key;
+    QDataStream out(&key, QIODevice::WriteOnly);
+    out << params.windowCount << params.screenGeometry << params.innerGap << params.outerGaps.top
+        << params.outerGaps.bottom << params.outerGaps.left << params.outerGaps.right << params.minSizes;
+    out << qint32(params.windowInfos.size());
+    for (const PhosphorTiles::WindowInfo& info : params.windowInfos) {
+        out << info.appId << info.windowId;
+        if (keyFocus) {
+            out << info.focused;
+        }
+    }
+    if (keyFocus) {
+        out << params.focusedIndex;
+    }
+    out << params.screenInfo.id << params.screenInfo.portrait << params.screenInfo.aspectRatio << params.customParams;
+    if (algo->readsCurrentGeometries()) {
+        out << params.currentGeometries;
+    }
+
+    const PhosphorTiles::TilingState* state = params.state;
+    out << bool(state);
+    if (!state) {
+        return key;
+    }
+    out << state->windowOrder() << state->tiledWindows() << state->masterCount() << state->splitRatio();
+    const PhosphorTiles::SplitTree* tree = state->splitTree();
+    writeSplitNode(out, tree ? tree->root() : nullptr);
+    if (algo->supportsScriptState()) {
+        out << state->scriptState();
+    }
+    return key;
+}
+
+} // namespace
+
 bool AutotileEngine::recalculateLayout(const QString& screenId)
 {
     if (screenId.isEmpty()) {
@@ -205,7 +271,26 @@ bool AutotileEngine::recalculateLayout(const QString& screenId)
     // Captured before the algorithm runs (state->calculatedZones() is not
     // overwritten until setCalculatedZones below), so it is the prior layout.
     tilingParams.currentGeometries = state->calculatedZones();
-    QVector<QRect> zones = algo->calculateZones(tilingParams);
+
+    // Skip the algorithm when its input is unchanged since this screen's last
+    // retile (see m_zoneCache). Built after prepareTilingState so the key sees
+    // the tree the algorithm will.
+    QByteArray cacheKey = zoneCacheKey(tilingParams, algo);
+    ZoneCacheEntry& cached = m_zoneCache[screenId];
+    QVector<QRect> zones;
+    if (cached.algorithm == algo && cached.key == cacheKey) {
+        zones = cached.zones;
+        ++m_zoneCacheStats.hits;
+        qCDebug(PhosphorTileEngine::lcTileEngine)
+            << "recalculateLayout: zone cache hit screen=" << screenId << "hits=" << m_zoneCacheStats.hits
+            << "misses=" << m_zoneCacheStats.misses;
+    } else {
+        zones = algo->calculateZones(tilingParams);
+        ++m_zoneCacheStats.misses;
+        cached.algorithm = algo;
+        cached.key = std::move(cacheKey);
+        cached.zones = zones;
+    }
 
     qCInfo(PhosphorTileEngine::lcTileEngine)
         << "recalculateLayout: screen=" << screenId << "tiledCount=" << tiledCount << "windowCount=" << windowCount
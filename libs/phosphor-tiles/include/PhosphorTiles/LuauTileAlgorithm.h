@@ -16,6 +16,7 @@
 
 namespace PhosphorScripting {
 class LuauEngine;
+class LuauStackWriter;
 class LuauWatchdog;
 }
 
@@ -48,9 +49,12 @@ class SplitNode;
  *         tile = function(ctx) return ctx.area:columns(ctx.count, ctx.gap) end,
  *     }
  *
- * Params/state are marshalled to/from the script as nested QVariant structures;
- * no Lua types cross into this class. Runaway scripts are bounded by a shared
- * LuauWatchdog.
+ * tile() — the per-retile hot path — goes through the engine's typed call
+ * surface: the `ctx` table is written straight onto the VM stack through keys
+ * interned at load, and the returned rects are read back without building a
+ * QVariant tree. The metadata accessors and lifecycle hooks marshal as nested
+ * QVariant structures. Either way no Lua types cross into this class. Runaway
+ * scripts are bounded by a shared LuauWatchdog.
  *
  * Not thread-safe — all calls must occur on the owning (main) thread.
  */
@@ -107,6 +111,8 @@ public:
     bool centerLayout() const override;
     bool supportsSingleWindow() const noexcept override;
     bool retilesOnFocusChange() const noexcept override;
+    bool readsFocus() const noexcept override;
+    bool readsCurrentGeometries() const noexcept override;
     bool isScripted() const noexcept override;
     bool isUserScript() const noexcept override;
     void prepareTilingState(TilingState* state) const override;
@@ -131,8 +137,9 @@ private:
     bool loadScript(const QString& filePath);
     void cacheMetadataAndOverrides();
 
-    /// Marshal TilingParams into the `ctx` table the script's tile() receives.
-    QVariantMap buildContext(const TilingParams& params, const QRect& area) const;
+    /// Write the `ctx` table the script's tile() receives; returns the
+    /// argument count (always 1).
+    int writeContext(PhosphorScripting::LuauStackWriter& writer, const TilingParams& params, const QRect& area) const;
     /// Marshal a TilingState into the `state` table lifecycle hooks receive.
     QVariantMap buildStateMap(const TilingState* state, bool includeCountAfterRemoval) const;
 
@@ -146,6 +153,9 @@ private:
     PhosphorScripting::LuauEngine* m_engine = nullptr;
     std::shared_ptr<PhosphorScripting::LuauWatchdog> m_watchdog;
     int m_module = -1;
+    // Keys interned in m_engine at load for the typed tile() call.
+    struct MarshalKeys;
+    std::unique_ptr<const MarshalKeys> m_keys;
 
     QString m_filePath;
     QString m_scriptId;
@@ -167,6 +177,10 @@ private:
     bool m_cachedProducesOverlappingZones = false;
     bool m_cachedOverlapFirstOnTop = false;
     bool m_cachedCenterLayout = false;
+    // Whether the script source names the focus fields / ctx.currentGeometries
+    // at all (see loadScript). Conservative: a mention anywhere counts.
+    bool m_readsFocus = true;
+    bool m_readsCurrentGeometries = true;
 };
 
 } // namespace PhosphorTiles
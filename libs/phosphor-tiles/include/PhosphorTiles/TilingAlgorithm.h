@@ -279,6 +279,28 @@ public:
      */
     virtual bool retilesOnFocusChange() const noexcept;
 
+    /**
+     * @brief Whether calculateZones() reads the focus fields of TilingParams
+     *
+     * That is focusedIndex and WindowInfo::focused. The engine's zone cache
+     * leaves them out of its key for an algorithm that neither reads them nor
+     * retilesOnFocusChange(), so a focus move does not cost a cache miss.
+     *
+     * @return true if the output may depend on focus (default: true)
+     */
+    virtual bool readsFocus() const noexcept;
+
+    /**
+     * @brief Whether calculateZones() reads TilingParams::currentGeometries
+     *
+     * The previously applied zones change on every miss, so keying the zone
+     * cache on them makes a change miss twice. The engine keys on them only
+     * for an algorithm that returns true here.
+     *
+     * @return true if the output may depend on the prior layout (default: true)
+     */
+    virtual bool readsCurrentGeometries() const noexcept;
+
     /**
      * @brief Whether this algorithm is a user-provided scripted algorithm
      *
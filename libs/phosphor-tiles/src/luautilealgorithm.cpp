@@ -46,9 +46,9 @@ bool finiteNumber(const QVariantMap& m, const QString& key, double& out)
     return true;
 }
 
-// Marshal a window list for a script, capped at MaxZones. Shared by buildContext
-// (ctx.windows) and buildStateMap (state.windows) so both paths hand a script the
-// same contract.
+// Marshal a window list for a script, capped at MaxZones. buildStateMap
+// (state.windows) uses it directly and writeContext (ctx.windows) mirrors it, so
+// both paths hand a script the same contract.
 //
 // The cap is a plain truncation of the tiled order, so a slot's position in the
 // list IS that window's tiled index. That keeps one index space across every
@@ -59,7 +59,7 @@ bool finiteNumber(const QVariantMap& m, const QString& key, double& out)
 // sits at that index.
 //
 // The list can therefore be shorter than the window count, and on the
-// buildStateMap path focusedIndex can point past its end (buildContext's caller
+// buildStateMap path focusedIndex can point past its end (writeContext's caller
 // caps windowInfos at MaxZones first, so there it always lands inside). A script
 // indexing the list by a tiled index must bound-check against #windows.
 QVariantList marshalWindowList(const QVector<WindowInfo>& infos)
@@ -177,64 +177,6 @@ ScriptedHelpers::ScriptMetadata parseMetadata(const QVariantMap& m)
     return md;
 }
 
-// Lua array-of-{x,y,width,height} → QRects (capped at MaxZones).
-QVector<QRect> variantToRects(const QVariant& v, const QString& scriptId)
-{
-    QVector<QRect> zones;
-    if (v.typeId() != QMetaType::QVariantList) {
-        qCWarning(PhosphorTiles::lcTilesLib)
-            << "LuauTileAlgorithm: tile() did not return an array, script=" << scriptId;
-        return zones;
-    }
-    const QVariantList list = v.toList();
-    const int cap = std::min<int>(static_cast<int>(list.size()), MaxZones);
-    zones.reserve(cap);
-    for (int i = 0; i < cap; ++i) {
-        // Always emit one rect per entry to keep the zone count aligned with the
-        // window count: skipping a malformed/empty entry here would leave a
-        // window unplaced. Degenerate entries either coerce to an empty QRect
-        // (a non-map entry, missing coords, or NaN → 0), which clampZonesToArea()
-        // replaces with the full area, or to a small in-area rect after QRect
-        // normalization — either way the entry survives as one valid in-area
-        // zone and the count stays aligned. The geometry safety net is in
-        // clampZonesToArea().
-        const QVariantMap z = list.at(i).toMap();
-        zones.append(QRect(z.value(QStringLiteral("x")).toInt(), z.value(QStringLiteral("y")).toInt(),
-                           z.value(QStringLiteral("width")).toInt(), z.value(QStringLiteral("height")).toInt()));
-    }
-    return zones;
-}
-
-// Read-only deep copy of the split tree for memory-aware scripts.
-QVariantMap splitNodeToVariant(const SplitNode* node, int depth)
-{
-    QVariantMap m;
-    if (!node || depth > MaxRuntimeTreeDepth) {
-        return m;
-    }
-    m[QStringLiteral("splitRatio")] = node->splitRatio;
-    m[QStringLiteral("splitHorizontal")] = node->splitHorizontal;
-    m[QStringLiteral("windowId")] = node->windowId;
-    m[QStringLiteral("isLeaf")] = node->isLeaf();
-    // At the depth cap the recursion yields an empty map. Assigning it anyway
-    // would hand the script a non-nil child whose every field is nil, which the
-    // `first: SplitNode?` / `second: SplitNode?` contract says cannot happen —
-    // so an exhausted child stays absent instead.
-    if (node->first) {
-        const QVariantMap first = splitNodeToVariant(node->first.get(), depth + 1);
-        if (!first.isEmpty()) {
-            m[QStringLiteral("first")] = first;
-        }
-    }
-    if (node->second) {
-        const QVariantMap second = splitNodeToVariant(node->second.get(), depth + 1);
-        if (!second.isEmpty()) {
-            m[QStringLiteral("second")] = second;
-        }
-    }
-    return m;
-}
-
 QVariantMap rectToVariant(const QRect& r)
 {
     QVariantMap m;
@@ -263,8 +205,146 @@ QVariantMap resizeToVariant(const ResizeEvent& ev)
     return m;
 }
 
+using PhosphorScripting::LuauKey;
+using PhosphorScripting::LuauStackReader;
+using PhosphorScripting::LuauStackWriter;
+
+// Every name the typed tile() call writes or reads, interned once per load.
+struct ContextKeys
+{
+    LuauKey tile;
+    LuauKey count, windowCount, gap, innerGap, masterCount, splitRatio, focusedIndex;
+    LuauKey area, x, y, width, height;
+    LuauKey minSizes, w, h;
+    LuauKey tree, leafCount, splitHorizontal, windowId, isLeaf, first, second;
+    LuauKey windows, appId, focused;
+    LuauKey currentGeometries;
+    LuauKey screen, id, portrait, aspectRatio;
+    LuauKey custom, state;
+
+    bool intern(LuauEngine& engine)
+    {
+        const std::pair<LuauKey*, const char16_t*> names[] = {
+            {&tile, u"tile"},
+            {&count, u"count"},
+            {&windowCount, u"windowCount"},
+            {&gap, u"gap"},
+            {&innerGap, u"innerGap"},
+            {&masterCount, u"masterCount"},
+            {&splitRatio, u"splitRatio"},
+            {&focusedIndex, u"focusedIndex"},
+            {&area, u"area"},
+            {&x, u"x"},
+            {&y, u"y"},
+            {&width, u"width"},
+            {&height, u"height"},
+            {&minSizes, u"minSizes"},
+            {&w, u"w"},
+            {&h, u"h"},
+            {&tree, u"tree"},
+            {&leafCount, u"leafCount"},
+            {&splitHorizontal, u"splitHorizontal"},
+            {&windowId, u"windowId"},
+            {&isLeaf, u"isLeaf"},
+            {&first, u"first"},
+            {&second, u"second"},
+            {&windows, u"windows"},
+            {&appId, u"appId"},
+            {&focused, u"focused"},
+            {&currentGeometries, u"currentGeometries"},
+            {&screen, u"screen"},
+            {&id, u"id"},
+            {&portrait, u"portrait"},
+            {&aspectRatio, u"aspectRatio"},
+            {&custom, u"custom"},
+            {&state, u"state"},
+        };
+        for (const auto& [key, name] : names) {
+            *key = engine.internKey(QStringView(name));
+            if (!key->isValid()) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+void writeRect(LuauStackWriter& writer, const ContextKeys& k, const QRect& r)
+{
+    writer.pushTable(0, 4);
+    writer.setInt(k.x, r.x());
+    writer.setInt(k.y, r.y());
+    writer.setInt(k.width, r.width());
+    writer.setInt(k.height, r.height());
+}
+
+// Read-only deep copy of the split tree for memory-aware scripts: fills the
+// table on top of the stack with @p node's fields. Below MaxRuntimeTreeDepth a
+// child is omitted rather than written as an empty table — an all-nil child is
+// something the `first: SplitNode?` / `second: SplitNode?` contract says cannot
+// happen.
+void writeSplitNode(LuauStackWriter& writer, const ContextKeys& k, const SplitNode* node, int depth)
+{
+    writer.setNumber(k.splitRatio, node->splitRatio);
+    writer.setBool(k.splitHorizontal, node->splitHorizontal);
+    writer.setString(k.windowId, node->windowId);
+    writer.setBool(k.isLeaf, node->isLeaf());
+    if (depth + 1 > MaxRuntimeTreeDepth) {
+        return;
+    }
+    if (node->first) {
+        writer.pushTable(0, 6);
+        writeSplitNode(writer, k, node->first.get(), depth + 1);
+        writer.setField(k.first);
+    }
+    if (node->second) {
+        writer.pushTable(0, 6);
+        writeSplitNode(writer, k, node->second.get(), depth + 1);
+        writer.setField(k.second);
+    }
+}
+
+// Lua array-of-{x,y,width,height} on top of the stack → QRects (capped at
+// MaxZones). Reads the same values the QVariant route would see: a table with a
+// sequence part is the array, anything else (an empty table included) is not.
+QVector<QRect> readRects(LuauStackReader& reader, const ContextKeys& k, const QString& scriptId)
+{
+    QVector<QRect> zones;
+    const int n = reader.length();
+    if (n <= 0) {
+        qCWarning(PhosphorTiles::lcTilesLib)
+            << "LuauTileAlgorithm: tile() did not return an array, script=" << scriptId;
+        return zones;
+    }
+    const int cap = std::min(n, MaxZones);
+    zones.reserve(cap);
+    for (int i = 1; i <= cap; ++i) {
+        // Always emit one rect per entry to keep the zone count aligned with the
+        // window count: skipping a malformed/empty entry here would leave a
+        // window unplaced. Degenerate entries either coerce to an empty QRect
+        // (a non-table or array-like entry, missing coords, or NaN → 0), which
+        // clampZonesToArea() replaces with the full area, or to a small in-area
+        // rect after QRect normalization — either way the entry survives as one
+        // valid in-area zone and the count stays aligned. The geometry safety
+        // net is in clampZonesToArea().
+        reader.pushIndex(-1, i);
+        if (reader.isTable() && reader.length() == 0) {
+            zones.append(QRect(reader.intField(-1, k.x), reader.intField(-1, k.y), reader.intField(-1, k.width),
+                               reader.intField(-1, k.height)));
+        } else {
+            zones.append(QRect());
+        }
+        reader.pop();
+    }
+    return zones;
+}
+
 } // namespace
 
+struct LuauTileAlgorithm::MarshalKeys : ContextKeys
+{
+};
+
 LuauTileAlgorithm::LuauTileAlgorithm(const QString& filePath, std::shared_ptr<PhosphorScripting::LuauWatchdog> watchdog,
                                      QObject* parent)
     : TilingAlgorithm(parent)
@@ -392,7 +472,13 @@ bool LuauTileAlgorithm::loadScript(const QString& filePath)
         return false;
     }
 
-    m_module = m_engine->loadModule(filePath, scriptFile.readAll(), &error);
+    const QByteArray source = scriptFile.readAll();
+    // The zone cache keys on these fields only for scripts that can see them.
+    // A textual scan is enough: ctx fields are read by name, and a false
+    // positive only costs cache hits.
+    m_readsFocus = source.contains("focus");
+    m_readsCurrentGeometries = source.contains("currentGeometries");
+    m_module = m_engine->loadModule(filePath, source, &error);
     if (m_module < 0) {
         qCWarning(PhosphorTiles::lcTilesLib) << "LuauTileAlgorithm: load failed file=" << filePath << ":" << error;
         return false;
@@ -402,6 +488,13 @@ bool LuauTileAlgorithm::loadScript(const QString& filePath)
         return false;
     }
 
+    auto keys = std::make_unique<MarshalKeys>();
+    if (!keys->intern(*m_engine)) {
+        qCWarning(PhosphorTiles::lcTilesLib) << "LuauTileAlgorithm: key interning failed, file=" << filePath;
+        return false;
+    }
+    m_keys = std::move(keys);
+
     m_valid = true;
     cacheMetadataAndOverrides();
     qCInfo(PhosphorTiles::lcTilesLib) << "LuauTileAlgorithm: loaded script=" << m_scriptId << "file=" << filePath;
@@ -658,6 +751,16 @@ bool LuauTileAlgorithm::retilesOnFocusChange() const noexcept
     return m_metadata.retileOnFocus;
 }
 
+bool LuauTileAlgorithm::readsFocus() const noexcept
+{
+    return m_readsFocus;
+}
+
+bool LuauTileAlgorithm::readsCurrentGeometries() const noexcept
+{
+    return m_readsCurrentGeometries;
+}
+
 bool LuauTileAlgorithm::isScripted() const noexcept
 {
     return true;
@@ -668,81 +771,91 @@ bool LuauTileAlgorithm::isUserScript() const noexcept
     return m_isUserScript;
 }
 
-QVariantMap LuauTileAlgorithm::buildContext(const TilingParams& params, const QRect& area) const
+int LuauTileAlgorithm::writeContext(LuauStackWriter& writer, const TilingParams& params, const QRect& area) const
 {
-    QVariantMap ctx;
+    const ContextKeys& k = *m_keys;
+    // Sized for every optional field, so filling it never rehashes.
+    writer.pushTable(0, 16);
     // New ergonomic names (count/gap) plus the original names
     // (windowCount/innerGap) the faithfully-ported bundled algorithms use.
-    ctx[QStringLiteral("count")] = params.windowCount;
-    ctx[QStringLiteral("windowCount")] = params.windowCount;
-    ctx[QStringLiteral("gap")] = std::max(0, params.innerGap);
-    ctx[QStringLiteral("innerGap")] = std::max(0, params.innerGap);
-
-    QVariantMap areaMap;
-    areaMap[QStringLiteral("x")] = area.x();
-    areaMap[QStringLiteral("y")] = area.y();
-    areaMap[QStringLiteral("width")] = area.width();
-    areaMap[QStringLiteral("height")] = area.height();
-    ctx[QStringLiteral("area")] = areaMap;
+    writer.setInt(k.count, params.windowCount);
+    writer.setInt(k.windowCount, params.windowCount);
+    writer.setInt(k.gap, std::max(0, params.innerGap));
+    writer.setInt(k.innerGap, std::max(0, params.innerGap));
+
+    writeRect(writer, k, area);
+    writer.setField(k.area);
 
     if (params.state) {
-        ctx[QStringLiteral("masterCount")] = params.state->masterCount();
-        ctx[QStringLiteral("splitRatio")] = std::clamp(params.state->splitRatio(), MinSplitRatio, MaxSplitRatio);
+        writer.setInt(k.masterCount, params.state->masterCount());
+        writer.setNumber(k.splitRatio, std::clamp(params.state->splitRatio(), MinSplitRatio, MaxSplitRatio));
     } else {
-        ctx[QStringLiteral("masterCount")] = DefaultMasterCount;
-        ctx[QStringLiteral("splitRatio")] = DefaultSplitRatio;
+        writer.setInt(k.masterCount, DefaultMasterCount);
+        writer.setNumber(k.splitRatio, DefaultSplitRatio);
     }
 
-    QVariantList minSizes;
     const int minCap = std::min<int>(static_cast<int>(params.minSizes.size()), MaxZones);
+    writer.pushTable(minCap, 0);
     for (int i = 0; i < minCap; ++i) {
-        QVariantMap s;
-        s[QStringLiteral("w")] = params.minSizes[i].width();
-        s[QStringLiteral("h")] = params.minSizes[i].height();
-        minSizes.append(s);
+        writer.pushTable(0, 2);
+        writer.setInt(k.w, params.minSizes[i].width());
+        writer.setInt(k.h, params.minSizes[i].height());
+        writer.setIndex(i + 1);
     }
-    ctx[QStringLiteral("minSizes")] = minSizes;
+    writer.setField(k.minSizes);
 
     if (params.state && params.state->splitTree() && !params.state->splitTree()->isEmpty()) {
-        QVariantMap tree = splitNodeToVariant(params.state->splitTree()->root(), 0);
-        tree[QStringLiteral("leafCount")] = params.state->splitTree()->leafCount();
-        ctx[QStringLiteral("tree")] = tree;
+        const SplitTree* tree = params.state->splitTree();
+        writer.pushTable(0, 7);
+        if (const SplitNode* root = tree->root()) {
+            writeSplitNode(writer, k, root, 0);
+        }
+        writer.setInt(k.leafCount, tree->leafCount());
+        writer.setField(k.tree);
     }
 
+    // Same contract as marshalWindowList — see there for the index space.
     if (!params.windowInfos.isEmpty()) {
-        ctx[QStringLiteral("windows")] = marshalWindowList(params.windowInfos);
+        const int cap = std::min(static_cast<int>(params.windowInfos.size()), MaxZones);
+        writer.pushTable(cap, 0);
+        for (int i = 0; i < cap; ++i) {
+            const WindowInfo& info = params.windowInfos[i];
+            writer.pushTable(0, 3);
+            writer.setString(k.appId, info.appId);
+            writer.setBool(k.focused, info.focused);
+            writer.setString(k.windowId, info.windowId);
+            writer.setIndex(i + 1);
+        }
+        writer.setField(k.windows);
     }
     // The real tiled index: comparable with the indices tile() itself reasons in
     // (0 .. count - 1), and an index into ctx.windows too, because the caller
     // caps windowInfos at MaxZones before we see it.
-    ctx[QStringLiteral("focusedIndex")] = params.focusedIndex;
+    writer.setInt(k.focusedIndex, params.focusedIndex);
 
     // Last applied zones (advisory) — lets scripts read neighbour positions.
     if (!params.currentGeometries.isEmpty()) {
-        QVariantList geoms;
         const int gcap = std::min<int>(static_cast<int>(params.currentGeometries.size()), MaxZones);
+        writer.pushTable(gcap, 0);
         for (int i = 0; i < gcap; ++i) {
-            const QRect& r = params.currentGeometries[i];
-            QVariantMap g;
-            g[QStringLiteral("x")] = r.x();
-            g[QStringLiteral("y")] = r.y();
-            g[QStringLiteral("width")] = r.width();
-            g[QStringLiteral("height")] = r.height();
-            geoms.append(g);
+            writeRect(writer, k, params.currentGeometries[i]);
+            writer.setIndex(i + 1);
         }
-        ctx[QStringLiteral("currentGeometries")] = geoms;
+        writer.setField(k.currentGeometries);
     }
 
     if (!params.screenInfo.id.isEmpty()) {
-        QVariantMap screen;
-        screen[QStringLiteral("id")] = params.screenInfo.id;
-        screen[QStringLiteral("portrait")] = params.screenInfo.portrait;
-        screen[QStringLiteral("aspectRatio")] = params.screenInfo.aspectRatio;
-        ctx[QStringLiteral("screen")] = screen;
+        writer.pushTable(0, 3);
+        writer.setString(k.id, params.screenInfo.id);
+        writer.setBool(k.portrait, params.screenInfo.portrait);
+        writer.setNumber(k.aspectRatio, params.screenInfo.aspectRatio);
+        writer.setField(k.screen);
     }
 
+    // Free-form values: rare and small, so these keep the generic conversion.
     if (!params.customParams.isEmpty()) {
-        ctx[QStringLiteral("custom")] = params.customParams;
+        writer.pushVariant(params.customParams);
+        writer.setField(k.custom);
     }
 
     // Persistent per-algorithm bag (ctx.state) — read view of the script's own
@@ -753,10 +866,11 @@ QVariantMap LuauTileAlgorithm::buildContext(const TilingParams& params, const QR
     if (supportsScriptState() && params.state) {
         const QJsonObject bag = params.state->scriptState();
         if (!bag.isEmpty()) {
-            ctx[QStringLiteral("state")] = bag.toVariantMap();
+            writer.pushVariant(bag.toVariantMap());
+            writer.setField(k.state);
         }
     }
-    return ctx;
+    return 1;
 }
 
 QVector<QRect> LuauTileAlgorithm::calculateZones(const TilingParams& params) const
@@ -789,15 +903,23 @@ QVector<QRect> LuauTileAlgorithm::calculateZones(const TilingParams& params) con
         return {area};
     }
 
-    const QVariantMap ctx = buildContext(params, area);
-    const auto out = m_engine->callModule(m_module, QStringLiteral("tile"), {ctx}, ScriptWatchdogTimeoutMs);
-    if (out.status != LuauEngine::CallStatus::Ok) {
+    QVector<QRect> zones;
+    QString message;
+    const auto status = m_engine->callModuleTyped(
+        m_module, m_keys->tile, ScriptWatchdogTimeoutMs,
+        [&](LuauStackWriter& writer) {
+            return writeContext(writer, params, area);
+        },
+        [&](LuauStackReader& reader) {
+            zones = readRects(reader, *m_keys, m_scriptId);
+        },
+        &message);
+    if (status != LuauEngine::CallStatus::Ok) {
         qCWarning(PhosphorTiles::lcTilesLib)
-            << "LuauTileAlgorithm: tile() failed script=" << m_scriptId << ":" << out.message;
+            << "LuauTileAlgorithm: tile() failed script=" << m_scriptId << ":" << message;
         return {};
     }
 
-    const QVector<QRect> zones = variantToRects(out.result, m_scriptId);
     return ScriptedHelpers::clampZonesToArea(zones, area, m_scriptId);
 }
 
@@ -854,7 +976,7 @@ QVariantMap LuauTileAlgorithm::buildStateMap(const TilingState* state, bool incl
 
     // Persistent bag, so a hook can read its own prior state (e.g. column widths)
     // before computing the update it returns. Gated on the same opt-in as
-    // buildContext's ctx.state, so a non-opted-in algorithm's hooks can't read
+    // writeContext's ctx.state, so a non-opted-in algorithm's hooks can't read
     // a bag left behind by a different algorithm on the same TilingState.
     if (supportsScriptState()) {
         const QJsonObject bag = state->scriptState();
@@ -939,7 +1061,7 @@ void LuauTileAlgorithm::onWindowResized(TilingState* state, const ResizeEvent& r
     //
     //   * the persistent state bag: opt-in via metadata.supportsScriptState — a
     //     script that reacts to resize without declaring it gets no stored bag
-    //     (and no ctx.state, see buildContext), keeping each algorithm's bag its
+    //     (and no ctx.state, see writeContext), keeping each algorithm's bag its
     //     own. Sanitized at this trust boundary, then stored so the engine's
     //     follow-up retile lays the windows out from the updated state.
     if (out.result.typeId() == QMetaType::QVariantMap) {
@@ -17,6 +17,7 @@
 #include <QCryptographicHash>
 #include <QDateTime>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
 #include <QRegularExpression>
@@ -297,6 +298,9 @@ QStringList ScriptedAlgorithmLoader::performScan(const QStringList& directoriesI
         qCWarning(PhosphorTiles::lcTilesLib) << "ScriptedAlgorithmLoader::performScan: no registry, skipping scan";
         return {};
     }
+    // Scan wall time is the reload-latency figure the bytecode cache targets.
+    QElapsedTimer scanTimer;
+    scanTimer.start();
 
     // Track which script IDs we register in this scan
     QSet<QString> newScriptIds;
@@ -399,7 +403,8 @@ QStringList ScriptedAlgorithmLoader::performScan(const QStringList& directoriesI
 
     // qCDebug here, qCInfo only on the changed branch below: this line runs on
     // every inotify wake, including the ones that changed nothing.
-    qCDebug(PhosphorTiles::lcTilesLib) << "Scripted algorithms loaded:" << m_scriptIdToPath.size();
+    qCDebug(PhosphorTiles::lcTilesLib) << "Scripted algorithms loaded:" << m_scriptIdToPath.size() << "in"
+                                       << scanTimer.elapsed() << "ms";
 
     // Emit only when the registered script set — id, path, size, mtime —
     // actually differs from the last scan. Suppresses redundant emissions
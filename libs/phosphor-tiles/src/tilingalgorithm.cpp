@@ -98,6 +98,16 @@ bool TilingAlgorithm::retilesOnFocusChange() const noexcept
     return false;
 }
 
+bool TilingAlgorithm::readsFocus() const noexcept
+{
+    return true;
+}
+
+bool TilingAlgorithm::readsCurrentGeometries() const noexcept
+{
+    return true;
+}
+
 bool TilingAlgorithm::isScripted() const noexcept
 {
     return false;
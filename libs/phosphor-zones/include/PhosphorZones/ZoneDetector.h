@@ -7,6 +7,7 @@
 #include <PhosphorZones/Layout.h>
 #include <PhosphorZones/Zone.h>
 #include <PhosphorZones/ZoneDefaults.h>
+#include <PhosphorZones/ZoneSpatialIndex.h>
 #include <QPointF>
 #include <QRectF>
 #include <QVector>
@@ -68,7 +69,11 @@ public:
      */
     void setAdjacentThreshold(int px)
     {
-        m_adjacentThreshold = px;
+        if (m_adjacentThreshold != px) {
+            m_adjacentThreshold = px;
+            // The index's neighbour graph is built at this tolerance.
+            m_indexDirty = true;
+        }
     }
     int adjacentThreshold() const
     {
@@ -87,6 +92,17 @@ public:
     Q_INVOKABLE Zone* zoneAtPoint(const QPointF& point) const override;
     Q_INVOKABLE Zone* nearestZone(const QPointF& point) const override;
 
+    /**
+     * @brief Spatial index over the current layout's absolute zone geometry.
+     *
+     * Rebuilt lazily on the first query after the zone set, any zone's
+     * absolute geometry (e.g. a LayoutComputeService result being applied) or
+     * the adjacency threshold changes. Exposed so callers needing
+     * neighbour lookups can use the precomputed adjacency graph instead of
+     * testing zone pairs themselves.
+     */
+    const ZoneSpatialIndex& spatialIndex() const;
+
     // Note: Highlighting methods removed - use ZoneHighlighter instead
     // These methods are kept for backward compatibility but delegate to ZoneHighlighter
     Q_INVOKABLE void highlightZone(Zone* zone) override;
@@ -105,10 +121,21 @@ private:
     bool areZonesAdjacent(Zone* zone1, Zone* zone2) const;
     qreal distanceToZoneEdge(const QPointF& point, Zone* zone) const;
     Zone* resolveOverlappingZone(const QPointF& point) const;
+    void watchZone(Zone* zone);
+    void invalidateIndex()
+    {
+        m_indexDirty = true;
+    }
 
     Layout* m_layout = nullptr;
     int m_adjacentThreshold = ::PhosphorZones::ZoneDefaults::AdjacentThreshold;
 
+    // Lazily rebuilt from m_layout — see spatialIndex(). Mutable because the
+    // rebuild happens inside const query methods; ZoneDetector is a GUI-thread
+    // object, so the lazy rebuild needs no locking.
+    mutable ZoneSpatialIndex m_index;
+    mutable bool m_indexDirty = true;
+
     // UI state management
     std::unique_ptr<class ZoneHighlighter> m_highlighter;
 };
@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+#include <phosphorzones_export.h>
+
+#include <QHash>
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+
+#include <vector>
+
+namespace PhosphorZones {
+
+class Zone;
+
+/**
+ * @brief Uniform-grid spatial index over a layout's absolute zone geometry.
+ *
+ * Built from a snapshot of a layout's zones and their current absolute
+ * rects. Point, radius and rect queries only visit the grid cells the query
+ * touches, so per-drag-sample hit-testing stays proportional to the local
+ * zone density instead of the layout's total zone count.
+ *
+ * The index also precomputes the edge-adjacency graph (zones sharing an edge
+ * within the adjacency tolerance, with at least 10% perpendicular overlap —
+ * the same test ZoneDetector has always used), so neighbour lookups are a
+ * slice read instead of a pairwise scan.
+ *
+ * Every query result is returned in layout order, so heuristics that break
+ * ties by "first zone in the layout wins" behave exactly as a linear scan
+ * over Layout::zones() would.
+ *
+ * The index holds raw Zone pointers and does not observe them: the owner
+ * must rebuild (or clear) it whenever the zone set or any zone's absolute
+ * geometry changes. ZoneDetector does this lazily off the layout's
+ * zonesChanged and each zone's geometryChanged signal.
+ */
+class PHOSPHORZONES_EXPORT ZoneSpatialIndex
+{
+public:
+    /// Rebuild the grid and adjacency graph from @p zones (null entries are
+    /// skipped). @p adjacencyTolerance is the max edge gap, in pixels, for
+    /// two zones to count as neighbours.
+    void rebuild(const QVector<Zone*>& zones, qreal adjacencyTolerance);
+    void clear();
+
+    bool isEmpty() const
+    {
+        return m_entries.empty();
+    }
+    int zoneCount() const
+    {
+        return static_cast<int>(m_entries.size());
+    }
+    qreal adjacencyTolerance() const
+    {
+        return m_adjacencyTolerance;
+    }
+
+    /// Zones whose geometry contains @p point.
+    QVector<Zone*> zonesContaining(const QPointF& point) const;
+    /// Zones whose Zone::distanceToPoint(@p point) is <= @p radius
+    /// (containing zones included, at distance 0).
+    QVector<Zone*> zonesNear(const QPointF& point, qreal radius) const;
+    /// Zones whose geometry intersects @p rect (QRectF::intersects semantics).
+    QVector<Zone*> zonesIntersecting(const QRectF& rect) const;
+
+    /// Smallest-area zone containing @p point — same contract as
+    /// Layout::zoneAtPoint.
+    Zone* zoneAtPoint(const QPointF& point) const;
+    /// Zone with the smallest distanceToPoint — same contract as
+    /// Layout::nearestZone without a distance cap.
+    Zone* nearestZone(const QPointF& point) const;
+
+    /// Edge-adjacent neighbours of @p zone, in layout order. Empty for a
+    /// zone the index does not know.
+    QVector<Zone*> neighbours(Zone* zone) const;
+    bool areAdjacent(Zone* a, Zone* b) const;
+
+private:
+    struct Entry
+    {
+        Zone* zone = nullptr;
+        QRectF rect; ///< normalized absolute geometry at build time
+    };
+
+    int cellColumn(qreal x) const;
+    int cellRow(qreal y) const;
+    /// Append the indices of every entry bucketed in a cell overlapping
+    /// @p rect to @p out, sorted and de-duplicated.
+    void collectCandidates(const QRectF& rect, std::vector<int>& out) const;
+
+    std::vector<Entry> m_entries;
+    QHash<Zone*, int> m_indexOf;
+
+    // Grid: m_columns x m_rows cells covering m_bounds. Cell contents are
+    // stored CSR-style — cell c owns m_cellItems[m_cellStart[c] .. m_cellStart[c + 1]).
+    QRectF m_bounds;
+    int m_columns = 0;
+    int m_rows = 0;
+    qreal m_cellWidth = 1.0;
+    qreal m_cellHeight = 1.0;
+    std::vector<int> m_cellStart;
+    std::vector<int> m_cellItems;
+
+    // Adjacency graph, CSR-style over entry indices.
+    qreal m_adjacencyTolerance = 0.0;
+    std::vector<int> m_adjacencyStart;
+    std::vector<int> m_adjacency;
+};
+
+} // namespace PhosphorZones
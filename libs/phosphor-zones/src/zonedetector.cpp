@@ -25,12 +25,20 @@ ZoneDetector::~ZoneDetector() = default; // Defined here so ZoneHighlighter is f
 void ZoneDetector::setLayout(Layout* layout)
 {
     if (m_layout != layout) {
-        // Disconnect from old layout's destroyed signal
+        // Disconnect from the old layout and its zones (destroyed + the
+        // index-invalidation hooks installed below)
         if (m_layout) {
             qCDebug(PhosphorZones::lcZonesLib) << "Disconnecting from previous layout";
-            disconnect(m_layout, &QObject::destroyed, this, nullptr);
+            disconnect(m_layout, nullptr, this, nullptr);
+            for (auto* zone : m_layout->zones()) {
+                if (zone) {
+                    disconnect(zone, nullptr, this, nullptr);
+                }
+            }
         }
         m_layout = layout;
+        m_index.clear();
+        m_indexDirty = true;
         // Connect to new layout's destroyed signal to prevent dangling pointer
         if (m_layout) {
             qCInfo(PhosphorZones::lcZonesLib) << "Layout set with" << m_layout->zones().size() << "zones";
@@ -41,9 +49,21 @@ void ZoneDetector::setLayout(Layout* layout)
             connect(m_layout, &QObject::destroyed, this, [this]() {
                 qCDebug(PhosphorZones::lcZonesLib) << "Layout destroyed, clearing";
                 m_layout = nullptr;
+                m_index.clear();
+                m_indexDirty = true;
                 m_highlighter->clearHighlights();
                 Q_EMIT layoutChanged();
             });
+            // Keep the spatial index honest: any zone-set edit or absolute
+            // geometry change (LayoutComputeService applying a worker result,
+            // a sync recalc, an editor drag) marks it for a lazy rebuild on
+            // the next query. Removed zones need no disconnect — they are
+            // deleteLater'd, which severs the connection.
+            connect(m_layout, &Layout::zonesChanged, this, &ZoneDetector::invalidateIndex);
+            connect(m_layout, &Layout::zoneAdded, this, &ZoneDetector::watchZone);
+            for (auto* zone : m_layout->zones()) {
+                watchZone(zone);
+            }
         } else {
             qCDebug(PhosphorZones::lcZonesLib) << "Layout cleared (set to null)";
         }
@@ -52,6 +72,28 @@ void ZoneDetector::setLayout(Layout* layout)
     }
 }
 
+void ZoneDetector::watchZone(Zone* zone)
+{
+    if (!zone) {
+        return;
+    }
+    connect(zone, &Zone::geometryChanged, this, &ZoneDetector::invalidateIndex, Qt::UniqueConnection);
+    m_indexDirty = true;
+}
+
+const ZoneSpatialIndex& ZoneDetector::spatialIndex() const
+{
+    if (m_indexDirty) {
+        if (m_layout) {
+            m_index.rebuild(m_layout->zones(), m_adjacentThreshold);
+        } else {
+            m_index.clear();
+        }
+        m_indexDirty = false;
+    }
+    return m_index;
+}
+
 ZoneDetectionResult ZoneDetector::detectZone(const QPointF& cursorPos) const
 {
     ZoneDetectionResult result;
@@ -90,28 +132,6 @@ ZoneDetectionResult ZoneDetector::detectZone(const QPointF& cursorPos) const
 
 namespace {
 
-// Check if two rects share an edge (left↔right or top↔bottom) within tolerance,
-// with perpendicular overlap > 0. Used by both expandZonesByIntersection and areZonesAdjacent.
-// minOverlapFraction: minimum perpendicular overlap as fraction of the smaller dimension (0.0–1.0).
-bool sharesEdge(const QRectF& r1, const QRectF& r2, qreal tolerance, qreal minOverlapFraction = 0.0)
-{
-    // Left-Right adjacency (r1.right ≈ r2.left or r2.right ≈ r1.left)
-    if (qAbs(r1.right() - r2.left()) <= tolerance || qAbs(r2.right() - r1.left()) <= tolerance) {
-        qreal overlap = qMin(r1.bottom(), r2.bottom()) - qMax(r1.top(), r2.top());
-        if (overlap > 0 && overlap >= qMin(r1.height(), r2.height()) * minOverlapFraction) {
-            return true;
-        }
-    }
-    // Top-Bottom adjacency (r1.bottom ≈ r2.top or r2.bottom ≈ r1.top)
-    if (qAbs(r1.bottom() - r2.top()) <= tolerance || qAbs(r2.bottom() - r1.top()) <= tolerance) {
-        qreal overlap = qMin(r1.right(), r2.right()) - qMax(r1.left(), r2.left());
-        if (overlap > 0 && overlap >= qMin(r1.width(), r2.width()) * minOverlapFraction) {
-            return true;
-        }
-    }
-    return false;
-}
-
 // Minimum fraction of a zone's area that must lie within the bounding rect for
 // the zone to be included during expansion.  A gap-filler zone that sits entirely
 // between the seed zones has ratio 1.0; a large background zone that merely
@@ -126,12 +146,13 @@ constexpr qreal kExpansionOverlapThreshold = 0.5;
 // The bounding rect grows iteratively so transitive gaps get filled
 // (e.g. painting zones 2 and 4 in dwindle fills zone 5 via zone 3).
 //
-// Complexity: O(n²) where n = layout zone count. The selectedZones set
-// grows monotonically — each iteration that finds a new zone adds at
-// least one entry and no zone can be re-added, so the loop is bounded
-// by the number of layout zones. Each iteration re-scans every zone in
-// @p layout against the growing bounding rect.
-QVector<Zone*> expandZonesByIntersection(Layout* layout, const QVector<Zone*>& seedZones)
+// The selectedZones set grows monotonically — each iteration that finds a
+// new zone adds at least one entry and no zone can be re-added, so the loop
+// is bounded by the number of layout zones. Each iteration only visits the
+// zones @p index buckets under the growing bounding rect, so the cost tracks
+// the size of the span rather than the size of the layout.
+QVector<Zone*> expandZonesByIntersection(Layout* layout, const ZoneSpatialIndex& index,
+                                         const QVector<Zone*>& seedZones)
 {
     if (!layout || seedZones.isEmpty()) {
         return seedZones;
@@ -172,24 +193,22 @@ QVector<Zone*> expandZonesByIntersection(Layout* layout, const QVector<Zone*>& s
         ++iterations;
         QRectF currentRect = boundingRect;
 
-        for (auto* zone : allZones) {
-            if (!zone || selectedZones.contains(zone)) {
+        for (auto* zone : index.zonesIntersecting(currentRect)) {
+            if (selectedZones.contains(zone)) {
                 continue;
             }
+            // Only include zones that are substantially within the bounding rect.
+            // This prevents large background/overlay zones from being pulled in
+            // when spanning adjacent sub-zones (e.g. zones 7 & 9 should not
+            // pull in a larger zone 2 underneath them).
             QRectF zoneGeom = zone->geometry();
-            if (zoneGeom.intersects(currentRect)) {
-                // Only include zones that are substantially within the bounding rect.
-                // This prevents large background/overlay zones from being pulled in
-                // when spanning adjacent sub-zones (e.g. zones 7 & 9 should not
-                // pull in a larger zone 2 underneath them).
-                QRectF intersection = zoneGeom.intersected(currentRect);
-                qreal intersectionArea = intersection.width() * intersection.height();
-                qreal zoneArea = zoneGeom.width() * zoneGeom.height();
-                if (zoneArea > 0 && intersectionArea / zoneArea > kExpansionOverlapThreshold) {
-                    selectedZones.insert(zone);
-                    boundingRect = boundingRect.united(zoneGeom);
-                    foundNew = true;
-                }
+            QRectF intersection = zoneGeom.intersected(currentRect);
+            qreal intersectionArea = intersection.width() * intersection.height();
+            qreal zoneArea = zoneGeom.width() * zoneGeom.height();
+            if (zoneArea > 0 && intersectionArea / zoneArea > kExpansionOverlapThreshold) {
+                selectedZones.insert(zone);
+                boundingRect = boundingRect.united(zoneGeom);
+                foundNew = true;
             }
         }
 
@@ -223,12 +242,7 @@ Zone* ZoneDetector::resolveOverlappingZone(const QPointF& point) const
     }
 
     // Collect all zones containing the point
-    QVector<Zone*> containing;
-    for (auto* zone : m_layout->zones()) {
-        if (zone && zone->containsPoint(point)) {
-            containing.append(zone);
-        }
-    }
+    const QVector<Zone*> containing = spatialIndex().zonesContaining(point);
 
     if (containing.isEmpty()) {
         return nullptr;
@@ -284,18 +298,15 @@ ZoneDetectionResult ZoneDetector::detectMultiZone(const QPointF& cursorPos) cons
         return detectZone(cursorPos);
     }
 
-    const auto& allZones = m_layout->zones();
     const qreal adjacentThreshold = m_adjacentThreshold;
 
     // Separate overlapping zones (cursor inside) from edge-adjacent zones
     // (cursor outside but within threshold). Only edge-adjacent zones trigger multi-zone.
+    // The index returns only zones within reach of the cursor, in layout order.
     QVector<Zone*> overlappingZones;
     QVector<Zone*> edgeAdjacentZones;
 
-    for (auto* zone : allZones) {
-        if (!zone) {
-            continue;
-        }
+    for (auto* zone : spatialIndex().zonesNear(cursorPos, qMax(0.0, adjacentThreshold))) {
         if (zone->containsPoint(cursorPos)) {
             overlappingZones.append(zone);
         } else {
@@ -368,7 +379,7 @@ ZoneDetectionResult ZoneDetector::detectMultiZone(const QPointF& cursorPos) cons
 
 QVector<Zone*> ZoneDetector::expandPaintedZonesToRect(const QVector<Zone*>& seedZones) const
 {
-    return expandZonesByIntersection(m_layout, seedZones);
+    return expandZonesByIntersection(m_layout, spatialIndex(), seedZones);
 }
 
 Zone* ZoneDetector::zoneAtPoint(const QPointF& point) const
@@ -377,7 +388,7 @@ Zone* ZoneDetector::zoneAtPoint(const QPointF& point) const
         return nullptr;
     }
 
-    return m_layout->zoneAtPoint(point);
+    return spatialIndex().zoneAtPoint(point);
 }
 
 Zone* ZoneDetector::nearestZone(const QPointF& point) const
@@ -386,7 +397,7 @@ Zone* ZoneDetector::nearestZone(const QPointF& point) const
         return nullptr;
     }
 
-    return m_layout->nearestZone(point);
+    return spatialIndex().nearestZone(point);
 }
 
 QRectF ZoneDetector::combineZoneGeometries(const QVector<Zone*>& zones) const
@@ -431,7 +442,7 @@ bool ZoneDetector::areZonesAdjacent(Zone* zone1, Zone* zone2) const
         return false;
     }
 
-    return sharesEdge(zone1->geometry(), zone2->geometry(), m_adjacentThreshold, 0.1);
+    return spatialIndex().areAdjacent(zone1, zone2);
 }
 
 qreal ZoneDetector::distanceToZoneEdge(const QPointF& point, Zone* zone) const
@@ -0,0 +1,354 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <PhosphorZones/ZoneSpatialIndex.h>
+#include <PhosphorZones/Zone.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace PhosphorZones {
+
+namespace {
+
+// Upper bound on grid dimensions. Cell count tracks zone count (roughly one
+// zone per cell), so this only bites on pathological layouts; it keeps the
+// CSR offset table small regardless.
+constexpr int kMaxGridDimension = 64;
+
+// Minimum perpendicular overlap, as a fraction of the smaller zone's extent,
+// for two zones to count as edge-adjacent in the neighbour graph.
+constexpr qreal kAdjacencyMinOverlapFraction = 0.1;
+
+// Check if two rects share an edge (left↔right or top↔bottom) within tolerance,
+// with perpendicular overlap > 0.
+// minOverlapFraction: minimum perpendicular overlap as fraction of the smaller dimension (0.0–1.0).
+bool sharesEdge(const QRectF& r1, const QRectF& r2, qreal tolerance, qreal minOverlapFraction)
+{
+    // Left-Right adjacency (r1.right ≈ r2.left or r2.right ≈ r1.left)
+    if (qAbs(r1.right() - r2.left()) <= tolerance || qAbs(r2.right() - r1.left()) <= tolerance) {
+        qreal overlap = qMin(r1.bottom(), r2.bottom()) - qMax(r1.top(), r2.top());
+        if (overlap > 0 && overlap >= qMin(r1.height(), r2.height()) * minOverlapFraction) {
+            return true;
+        }
+    }
+    // Top-Bottom adjacency (r1.bottom ≈ r2.top or r2.bottom ≈ r1.top)
+    if (qAbs(r1.bottom() - r2.top()) <= tolerance || qAbs(r2.bottom() - r1.top()) <= tolerance) {
+        qreal overlap = qMin(r1.right(), r2.right()) - qMax(r1.left(), r2.left());
+        if (overlap > 0 && overlap >= qMin(r1.width(), r2.width()) * minOverlapFraction) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool isFiniteRect(const QRectF& r)
+{
+    return std::isfinite(r.x()) && std::isfinite(r.y()) && std::isfinite(r.width()) && std::isfinite(r.height());
+}
+
+} // namespace
+
+void ZoneSpatialIndex::clear()
+{
+    m_entries.clear();
+    m_indexOf.clear();
+    m_bounds = QRectF();
+    m_columns = 0;
+    m_rows = 0;
+    m_cellWidth = 1.0;
+    m_cellHeight = 1.0;
+    m_cellStart.clear();
+    m_cellItems.clear();
+    m_adjacencyTolerance = 0.0;
+    m_adjacencyStart.clear();
+    m_adjacency.clear();
+}
+
+void ZoneSpatialIndex::rebuild(const QVector<Zone*>& zones, qreal adjacencyTolerance)
+{
+    clear();
+    m_adjacencyTolerance = qMax(0.0, adjacencyTolerance);
+
+    m_entries.reserve(zones.size());
+    for (auto* zone : zones) {
+        if (!zone) {
+            continue;
+        }
+        Entry entry;
+        entry.zone = zone;
+        entry.rect = zone->geometry().normalized();
+        if (!isFiniteRect(entry.rect)) {
+            // A non-finite rect can't be bucketed; park it at the origin so
+            // the zone stays reachable by the (always-failing) predicates
+            // instead of poisoning the bounds.
+            entry.rect = QRectF();
+        }
+        m_indexOf.insert(zone, static_cast<int>(m_entries.size()));
+        m_entries.push_back(entry);
+    }
+
+    if (m_entries.empty()) {
+        return;
+    }
+
+    // Bounds cover every zone (including degenerate ones) so the cell lookup
+    // below never has to special-case an out-of-range zone.
+    qreal left = std::numeric_limits<qreal>::max();
+    qreal top = std::numeric_limits<qreal>::max();
+    qreal right = std::numeric_limits<qreal>::lowest();
+    qreal bottom = std::numeric_limits<qreal>::lowest();
+    for (const auto& entry : m_entries) {
+        left = qMin(left, entry.rect.left());
+        top = qMin(top, entry.rect.top());
+        right = qMax(right, entry.rect.right());
+        bottom = qMax(bottom, entry.rect.bottom());
+    }
+    m_bounds = QRectF(QPointF(left, top), QPointF(right, bottom));
+
+    // Aim for about one zone per cell, shaped to the bounds' aspect ratio so
+    // a row of columns on an ultrawide doesn't collapse into a single cell.
+    const qreal count = static_cast<qreal>(m_entries.size());
+    const qreal aspect = m_bounds.height() > 0 ? m_bounds.width() / m_bounds.height() : 1.0;
+    m_columns = std::clamp(static_cast<int>(std::ceil(std::sqrt(count * aspect))), 1, kMaxGridDimension);
+    m_rows = std::clamp(static_cast<int>(std::ceil(count / m_columns)), 1, kMaxGridDimension);
+    m_cellWidth = qMax(1.0, m_bounds.width() / m_columns);
+    m_cellHeight = qMax(1.0, m_bounds.height() / m_rows);
+
+    // Counting pass, prefix sum, then scatter — each cell's slice ends up in
+    // layout order because entries are scattered in layout order.
+    const int cellCount = m_columns * m_rows;
+    m_cellStart.assign(cellCount + 1, 0);
+    for (const auto& entry : m_entries) {
+        const int c0 = cellColumn(entry.rect.left());
+        const int c1 = cellColumn(entry.rect.right());
+        const int r0 = cellRow(entry.rect.top());
+        const int r1 = cellRow(entry.rect.bottom());
+        for (int r = r0; r <= r1; ++r) {
+            for (int c = c0; c <= c1; ++c) {
+                ++m_cellStart[r * m_columns + c + 1];
+            }
+        }
+    }
+    for (int i = 0; i < cellCount; ++i) {
+        m_cellStart[i + 1] += m_cellStart[i];
+    }
+    m_cellItems.resize(m_cellStart[cellCount]);
+    std::vector<int> cursor(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (int i = 0; i < static_cast<int>(m_entries.size()); ++i) {
+        const QRectF& rect = m_entries[i].rect;
+        const int c0 = cellColumn(rect.left());
+        const int c1 = cellColumn(rect.right());
+        const int r0 = cellRow(rect.top());
+        const int r1 = cellRow(rect.bottom());
+        for (int r = r0; r <= r1; ++r) {
+            for (int c = c0; c <= c1; ++c) {
+                m_cellItems[cursor[r * m_columns + c]++] = i;
+            }
+        }
+    }
+
+    // Adjacency graph. Only zones bucketed near each other (within the
+    // tolerance) can share an edge, so each zone tests its local candidates
+    // rather than every other zone in the layout.
+    m_adjacencyStart.assign(m_entries.size() + 1, 0);
+    std::vector<int> candidates;
+    for (int i = 0; i < static_cast<int>(m_entries.size()); ++i) {
+        const QRectF& rect = m_entries[i].rect;
+        candidates.clear();
+        collectCandidates(rect.adjusted(-m_adjacencyTolerance, -m_adjacencyTolerance, m_adjacencyTolerance,
+                                        m_adjacencyTolerance),
+                          candidates);
+        for (int j : candidates) {
+            if (j != i && sharesEdge(rect, m_entries[j].rect, m_adjacencyTolerance, kAdjacencyMinOverlapFraction)) {
+                m_adjacency.push_back(j);
+            }
+        }
+        m_adjacencyStart[i + 1] = static_cast<int>(m_adjacency.size());
+    }
+}
+
+int ZoneSpatialIndex::cellColumn(qreal x) const
+{
+    const qreal offset = std::floor((x - m_bounds.left()) / m_cellWidth);
+    if (!(offset > 0)) {
+        return 0; // also catches NaN
+    }
+    return offset >= m_columns ? m_columns - 1 : static_cast<int>(offset);
+}
+
+int ZoneSpatialIndex::cellRow(qreal y) const
+{
+    const qreal offset = std::floor((y - m_bounds.top()) / m_cellHeight);
+    if (!(offset > 0)) {
+        return 0;
+    }
+    return offset >= m_rows ? m_rows - 1 : static_cast<int>(offset);
+}
+
+void ZoneSpatialIndex::collectCandidates(const QRectF& rect, std::vector<int>& out) const
+{
+    if (m_entries.empty()) {
+        return;
+    }
+    const QRectF query = rect.normalized();
+    const int c0 = cellColumn(query.left());
+    const int c1 = cellColumn(query.right());
+    const int r0 = cellRow(query.top());
+    const int r1 = cellRow(query.bottom());
+    const size_t first = out.size();
+    for (int r = r0; r <= r1; ++r) {
+        for (int c = c0; c <= c1; ++c) {
+            const int cell = r * m_columns + c;
+            out.insert(out.end(), m_cellItems.begin() + m_cellStart[cell], m_cellItems.begin() + m_cellStart[cell + 1]);
+        }
+    }
+    // A zone spanning several cells is bucketed in each; sorting by entry
+    // index both removes the duplicates and restores layout order.
+    if (r0 != r1 || c0 != c1) {
+        std::sort(out.begin() + first, out.end());
+        out.erase(std::unique(out.begin() + first, out.end()), out.end());
+    }
+}
+
+QVector<Zone*> ZoneSpatialIndex::zonesContaining(const QPointF& point) const
+{
+    QVector<Zone*> result;
+    if (m_entries.empty()) {
+        return result;
+    }
+    // A single point maps to a single cell — no de-duplication needed.
+    const int cell = cellRow(point.y()) * m_columns + cellColumn(point.x());
+    for (int k = m_cellStart[cell]; k < m_cellStart[cell + 1]; ++k) {
+        Zone* zone = m_entries[m_cellItems[k]].zone;
+        if (zone->containsPoint(point)) {
+            result.append(zone);
+        }
+    }
+    return result;
+}
+
+QVector<Zone*> ZoneSpatialIndex::zonesNear(const QPointF& point, qreal radius) const
+{
+    QVector<Zone*> result;
+    if (m_entries.empty() || !(radius >= 0)) {
+        return result;
+    }
+    std::vector<int> candidates;
+    collectCandidates(QRectF(point.x() - radius, point.y() - radius, radius * 2, radius * 2), candidates);
+    for (int i : candidates) {
+        Zone* zone = m_entries[i].zone;
+        if (zone->distanceToPoint(point) <= radius) {
+            result.append(zone);
+        }
+    }
+    return result;
+}
+
+QVector<Zone*> ZoneSpatialIndex::zonesIntersecting(const QRectF& rect) const
+{
+    QVector<Zone*> result;
+    if (m_entries.empty()) {
+        return result;
+    }
+    std::vector<int> candidates;
+    collectCandidates(rect, candidates);
+    for (int i : candidates) {
+        Zone* zone = m_entries[i].zone;
+        if (zone->geometry().intersects(rect)) {
+            result.append(zone);
+        }
+    }
+    return result;
+}
+
+Zone* ZoneSpatialIndex::zoneAtPoint(const QPointF& point) const
+{
+    // Smallest-area-wins, first-in-layout-order on ties — mirrors
+    // Layout::zoneAtPoint, which zonesContaining's ordering preserves.
+    Zone* best = nullptr;
+    qreal bestArea = std::numeric_limits<qreal>::max();
+    for (auto* zone : zonesContaining(point)) {
+        const QRectF& geom = zone->geometry();
+        const qreal area = geom.width() * geom.height();
+        if (area < bestArea) {
+            bestArea = area;
+            best = zone;
+        }
+    }
+    return best;
+}
+
+Zone* ZoneSpatialIndex::nearestZone(const QPointF& point) const
+{
+    if (m_entries.empty()) {
+        return nullptr;
+    }
+
+    // Grow the search radius geometrically from one cell until a query
+    // returns something. Every zone at distance <= radius is in the result,
+    // so the minimum over it is the global minimum. The cap is a radius that
+    // reaches every zone, at which point the query degenerates to a full scan.
+    const qreal dx = qMax(qMax(m_bounds.left() - point.x(), point.x() - m_bounds.right()), 0.0);
+    const qreal dy = qMax(qMax(m_bounds.top() - point.y(), point.y() - m_bounds.bottom()), 0.0);
+    const qreal maxRadius = std::hypot(dx, dy) + std::hypot(m_bounds.width(), m_bounds.height()) + 1.0;
+    if (!std::isfinite(maxRadius)) {
+        return nullptr;
+    }
+
+    qreal radius = qMax(m_cellWidth, m_cellHeight);
+    for (;;) {
+        const bool lastPass = radius >= maxRadius;
+        const QVector<Zone*> candidates = zonesNear(point, lastPass ? maxRadius : radius);
+        if (!candidates.isEmpty()) {
+            Zone* nearest = nullptr;
+            qreal minDistance = std::numeric_limits<qreal>::max();
+            for (auto* zone : candidates) {
+                const qreal distance = zone->distanceToPoint(point);
+                if (distance < minDistance) {
+                    minDistance = distance;
+                    nearest = zone;
+                }
+            }
+            return nearest;
+        }
+        if (lastPass) {
+            return nullptr;
+        }
+        radius *= 2;
+    }
+}
+
+QVector<Zone*> ZoneSpatialIndex::neighbours(Zone* zone) const
+{
+    QVector<Zone*> result;
+    const auto it = m_indexOf.constFind(zone);
+    if (it == m_indexOf.constEnd()) {
+        return result;
+    }
+    const int i = *it;
+    result.reserve(m_adjacencyStart[i + 1] - m_adjacencyStart[i]);
+    for (int k = m_adjacencyStart[i]; k < m_adjacencyStart[i + 1]; ++k) {
+        result.append(m_entries[m_adjacency[k]].zone);
+    }
+    return result;
+}
+
+bool ZoneSpatialIndex::areAdjacent(Zone* a, Zone* b) const
+{
+    if (!a || !b || a == b) {
+        return false;
+    }
+    const auto itA = m_indexOf.constFind(a);
+    const auto itB = m_indexOf.constFind(b);
+    if (itA == m_indexOf.constEnd() || itB == m_indexOf.constEnd()) {
+        return false;
+    }
+    const auto begin = m_adjacency.begin() + m_adjacencyStart[*itA];
+    const auto end = m_adjacency.begin() + m_adjacencyStart[*itA + 1];
+    // Neighbour slices are in ascending entry order (candidates are sorted).
+    return std::binary_search(begin, end, *itB);
+}
+
+} // namespace PhosphorZones
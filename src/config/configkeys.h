@@ -186,6 +186,10 @@ public:
     // the SOLE persisted per-window restore key for both snap and autotile.
     P_CONFIG_KEY(windowPlacementsKey, "WindowPlacements")
 
+    // Generation of the session journal (session.json.journal) this snapshot
+    // was compacted with; a journal carrying any other generation is stale.
+    P_CONFIG_KEY(sessionJournalGenerationKey, "JournalGeneration")
+
     // Legacy per-window restore keys — superseded by WindowPlacements. Retained
     // ONLY so saveState() can deleteKey() them, scrubbing them from any session.json
     // written by an older build. Never written, never read.
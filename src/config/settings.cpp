@@ -208,6 +208,9 @@ void Settings::load()
     }
 
     m_configBackend->reparseConfiguration();
+    // The Store's handle cache (the P_STORE_GET fast path) only tracks writes
+    // made through the Store; tell it the whole backend just moved.
+    m_store->refresh();
 
     // Per-mode disable lists live in rules.json, a separate file the
     // config backend's reparseConfiguration() does not touch. Reload the
@@ -911,6 +914,8 @@ void Settings::reset()
     }
     m_configBackend->deleteGroup(ConfigDefaults::updatesGroup());
     deletePerScreenGroups(m_configBackend);
+    // Raw group deletes bypass the Store, so drop its cached reads.
+    m_store->refresh();
     // commit(), not sync(), for the same reason save() uses it: sync() is
     // allowed to return true for a write it merely scheduled (JsonBackend's
     // Deferred policy debounces it), and the result gates whether the other two
@@ -936,6 +941,9 @@ void Settings::reset()
     if (!QFile::remove(ConfigDefaults::sessionFilePath()) && QFile::exists(ConfigDefaults::sessionFilePath())) {
         qCWarning(lcConfig) << "Failed to remove session file:" << ConfigDefaults::sessionFilePath();
     }
+    // Its journal would be ignored anyway (its generation no longer matches
+    // any snapshot); remove it so it does not linger.
+    QFile::remove(ConfigDefaults::sessionFilePath() + QStringLiteral(".journal"));
 
     // Per-mode disable lists live in rules.json as DisableEngine
     // context rules — drop every such rule from the store (assignment /
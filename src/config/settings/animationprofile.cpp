@@ -247,6 +247,7 @@ void Settings::refreshCleanBackendFromDisk()
         return;
     }
     m_configBackend->reparseConfiguration();
+    m_store->refresh();
     // A clean backend means no local uncommitted writes, so before the
     // reparse the live store matched m_baseline. The reparse may adopt
     // externally-committed changes to ANY key; without advancing the
@@ -28,9 +28,18 @@
 #include <QString>
 #include <QStringList>
 
+// The getter resolves its key to a typed Store handle once per process (slot
+// numbering depends only on the schema, and every Settings instance is built
+// from buildSettingsSchema()), then reads the cached, already-converted value.
+// A key whose declared type differs from readType has no handle and keeps the
+// plain read<readType>() path.
 #define P_STORE_GET(retType, fn, group, key, readType)                                                                 \
     retType Settings::fn() const                                                                                       \
     {                                                                                                                  \
+        static const auto handle = m_store->handle<readType>(ConfigDefaults::group(), ConfigDefaults::key());          \
+        if (handle.isValid()) {                                                                                        \
+            return m_store->get(handle);                                                                               \
+        }                                                                                                              \
         return m_store->read<readType>(ConfigDefaults::group(), ConfigDefaults::key());                                \
     }
 
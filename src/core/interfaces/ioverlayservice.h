@@ -12,6 +12,7 @@
 
 #include "plasmazones_export.h"
 #include "core/types/dmabufthumbnail.h"
+#include "core/types/memfdthumbnail.h"
 
 #include <PhosphorProtocol/ZoneTypes.h>
 
@@ -95,6 +96,10 @@ public:
 
     // Mouse position for shader effects (updated during window drag)
     virtual void updateMousePosition(int cursorX, int cursorY) = 0;
+    // Whether updateMousePosition has a visible effect on this screen (a
+    // shader overlay samples the cursor). Lets drag callers skip forwarding
+    // cursor samples that cannot change the zone pick.
+    virtual bool consumesMousePosition(const QString& screenId) const = 0;
 
     // Filtered layout count (matches what the zone selector actually displays)
     virtual int visibleLayoutCount(const QString& screenId) const = 0;
@@ -148,6 +153,16 @@ public:
     ///         preview still appears.
     virtual bool setWindowThumbnailDmabuf(const QString& compositorHandle, const DmabufThumbnailDesc& desc) = 0;
 
+    /// Deliver a raw ARGB32 thumbnail through a sealed memfd instead of a
+    /// D-Bus byte array. @p desc carries a borrowed fd valid for this call
+    /// only; the implementation maps it read-only and stores the image
+    /// without copying the pixels.
+    ///
+    /// @return true iff the thumbnail was stored. Same dedup contract as
+    ///         @ref setSnapAssistThumbnail: false keeps the handle eligible
+    ///         for re-capture.
+    virtual bool setSnapAssistThumbnailMemfd(const QString& compositorHandle, const MemfdThumbnailDesc& desc) = 0;
+
     // Layout picker overlay (interactive layout browser)
     virtual void hideLayoutPicker() = 0;
     virtual bool isLayoutPickerVisible() const = 0;
@@ -223,6 +223,12 @@ QString SupportReport::sectionAutotile(const Snapshot& snapshot)
         out += QStringLiteral("**Active screens:** %1\n").arg(snapshot.autotileScreens.join(QStringLiteral(", ")));
     }
 
+    if (snapshot.hasZoneCacheStats) {
+        out += QStringLiteral("**Layout cache:** %1 hits, %2 misses\n")
+                   .arg(snapshot.zoneCacheHits)
+                   .arg(snapshot.zoneCacheMisses);
+    }
+
     return out;
 }
 
@@ -70,6 +70,12 @@ public:
         bool autotileEnabled = false;
         QStringList autotileScreens;
         bool hasAutotileEngine = false;
+        // Zone-cache counters of the concrete AutotileEngine. IPlacementEngine
+        // does not expose them, so ControlAdaptor fills these in, like the
+        // bridge fields below.
+        bool hasZoneCacheStats = false;
+        quint64 zoneCacheHits = 0;
+        quint64 zoneCacheMisses = 0;
 
         // Compositor bridge (KWin effect) state. The bridge adaptor lives in
         // the dbus layer, which core/ must not depend on, so these fields are
@@ -0,0 +1,32 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+namespace PlasmaZones {
+
+/**
+ * @brief Sealed-memfd descriptor for a raw ARGB32 window thumbnail.
+ *
+ * Handed from the kwin-effect to the daemon as the shared-memory alternative
+ * to the byte-array path in @c IOverlayService::setSnapAssistThumbnail: the
+ * effect writes the pixels once into an anonymous memfd, seals it against
+ * any further write/resize, and passes only the fd over D-Bus. The daemon
+ * maps the pages read-only and wraps them in a QImage without copying.
+ *
+ * Pixel layout matches the byte-array path: Format_ARGB32 (non-premultiplied),
+ * @ref height rows of @ref stride bytes starting at offset 0.
+ *
+ * Lifetime: @ref fd is BORROWED for the duration of the receiving call only.
+ * A mapping made from it outlives the fd, so the receiver does not need to
+ * @c dup() it.
+ */
+struct MemfdThumbnailDesc
+{
+    int fd = -1; ///< Borrowed memfd, sealed against write/grow/shrink.
+    int width = 0; ///< Image width in pixels.
+    int height = 0; ///< Image height in pixels.
+    int stride = 0; ///< Row stride in bytes (>= width * 4).
+};
+
+} // namespace PlasmaZones
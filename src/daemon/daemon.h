@@ -1196,8 +1196,9 @@ private:
     QTimer m_previewNotifyTimer;
     PhosphorTiles::AlgorithmPreviewParams m_preRetilePreviewParams;
 
-    // Single-threaded pool for shader baking — QShaderBaker/glslang is not
-    // thread-safe for concurrent compilation (SIGSEGV in QSpirvCompiler).
+    // Pool for shader warm-bakes, sized by ShaderBakeService::parallelism():
+    // one thread per bake-worker process, or a single thread when bakes run
+    // in-process (glslang is not thread-safe — SIGSEGV in QSpirvCompiler).
     QThreadPool m_shaderBakePool;
     /// Zone-path shadersChanged → warm-bake wiring, held so a stop() → init()
     /// cycle disconnects the prior handler instead of stacking a second one
@@ -221,6 +221,18 @@ void Daemon::initCoreAdaptors()
     // PhosphorZones::Zone selector methods are called directly from WindowDragAdaptor; QDBusAbstractAdaptor
     // signals are for D-Bus, not Qt connections.
 
+    // Publish the plugin's zone-hit snapshot once per layout compute. Results
+    // superseded by a newer request for the same screen are dropped here; the
+    // adaptor itself drops results for a layout the screen no longer shows.
+    connect(m_layoutComputeService.get(), &PhosphorZones::LayoutComputeService::geometriesComputedForGeneration,
+            m_windowDragAdaptor,
+            [this](const QString& screenId, const QUuid&, PhosphorZones::Layout* layout, uint64_t generation) {
+                if (generation < m_layoutComputeService->currentGeneration(screenId)) {
+                    return;
+                }
+                m_windowDragAdaptor->publishZoneHitSnapshot(screenId, layout, generation);
+            });
+
     // Give the window drag adaptor access to the shortcut manager for
     // registering/unregistering the Escape cancel shortcut during drags.
     // Routed through the PhosphorShortcutsIntegration::IAdhocRegistrar interface so the underlying
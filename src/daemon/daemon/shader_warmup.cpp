@@ -13,6 +13,7 @@
 
 #include <PhosphorAnimation/AnimationShaderEffect.h>
 #include <PhosphorAnimation/AnimationShaderRegistry.h>
+#include <PhosphorRendering/ShaderBakeService.h>
 #include <PhosphorShaders/ShaderEntryPoint.h>
 #include <PhosphorSurface/SurfaceShaderEffect.h>
 #include <PhosphorSurface/SurfaceShaderRegistry.h>
@@ -111,9 +112,11 @@ void Daemon::setupSurfaceShaderEffects()
 void Daemon::setupShaderWarmBakes()
 {
     // QShaderBaker/glslang is not thread-safe — concurrent bake() calls crash
-    // in QSpirvCompiler::compileToSpirv(). Limit to 1 thread so bakes are
-    // sequential but still off the main thread.
-    m_shaderBakePool.setMaxThreadCount(1);
+    // in QSpirvCompiler::compileToSpirv(). With the phosphor-shader-baker
+    // helper installed each miss bakes in its own process, so the pool can
+    // feed one miss per worker; without it ShaderCompiler serializes bakes
+    // in-process and parallelism() is 1 — sequential, but off the main thread.
+    m_shaderBakePool.setMaxThreadCount(PhosphorRendering::ShaderBakeService::parallelism());
 
     // Re-init guard: m_shaderRegistry is ctor-owned and survives stop(), so a
     // stop() → init() cycle would stack a second shadersChanged handler here
@@ -126,7 +129,7 @@ void Daemon::setupShaderWarmBakes()
 
     // Skip-unchanged gate shared by all three categories below. A registry
     // emit reports the whole catalog, but re-queuing a pack whose bake inputs
-    // are unchanged is pure wasted work on the single-threaded pool — one user
+    // are unchanged is pure wasted work on the bake pool — one user
     // pack edit used to re-queue N bakes, and any UI listening to the zone
     // path's started/finished relays saw the entire catalog flip to
     // "compiling" on every one-file change. Returns true when the entry was
@@ -189,8 +192,17 @@ void Daemon::setupShaderWarmBakes()
             }
             const QString shaderId = info.id;
             // Computed here (rather than at the capture below) because it is
-            // part of the skip-unchanged fingerprint.
-            const QString paramPreamble = ShaderRegistry::paramPreamble(info);
+            // part of the skip-unchanged fingerprint. On a storage-buffer
+            // backend the live node splices its zone-storage defines ahead of
+            // the param preamble, and the bake-cache key covers both, so the
+            // warm entry has to carry them too or it is never hit. Such a
+            // source only bakes for SPIR-V, which the warm bake must be told.
+            QString paramPreamble = ShaderRegistry::paramPreamble(info);
+            auto fragmentTargets = PhosphorRendering::ShaderCompiler::Targets::All;
+            if (PhosphorRendering::ZoneShaderNodeRhi::zoneStorageAvailable()) {
+                paramPreamble.prepend(PhosphorRendering::ZoneShaderNodeRhi::zoneStorageDefines());
+                fragmentTargets = PhosphorRendering::ZoneShaderNodeRhi::zoneStorageTargets();
+            }
             if (!shouldScheduleBake(QStringLiteral("zone:") + shaderId,
                                     bakeFingerprint(zoneVertPath, info.sourcePath, paramPreamble))) {
                 return;
@@ -234,10 +246,10 @@ void Daemon::setupShaderWarmBakes()
             // fingerprinting the cache key on the wrong include content.
             watcher->setFuture(QtConcurrent::run(&m_shaderBakePool,
                                                  [vertPath = zoneVertPath, fragPath = info.sourcePath, includePaths,
-                                                  paramPreamble, entryPrologue, entryCandidates]() {
-                                                     return warmShaderBakeCacheForPaths(vertPath, fragPath,
-                                                                                        includePaths, paramPreamble,
-                                                                                        entryPrologue, entryCandidates);
+                                                  paramPreamble, entryPrologue, entryCandidates, fragmentTargets]() {
+                                                     return warmShaderBakeCacheForPaths(
+                                                         vertPath, fragPath, includePaths, paramPreamble,
+                                                         entryPrologue, entryCandidates, fragmentTargets);
                                                  }));
         };
     m_zoneWarmBakeConnection =
@@ -263,8 +275,9 @@ void Daemon::setupShaderWarmBakes()
     // because the cache is now warm.
     //
     // Shares m_shaderBakePool with the zone-shader warm-bake. The
-    // pool is single-threaded (QShaderBaker / glslang isn't thread-
-    // safe), so animation and zone bakes serialise without interfering.
+    // pool is sized to the bake-worker count (one thread when baking
+    // in-process, since glslang isn't thread-safe), so animation and
+    // zone bakes share one budget without interfering.
     //
     // Include-path resolution mirrors `SurfaceAnimator::runLeg`
     // (surfaceanimator.cpp): every animation search-path's `/shared`
@@ -371,8 +384,8 @@ void Daemon::setupShaderWarmBakes()
 
     // Warm-bake SURFACE shaders (window border / rounded corners / glow) the
     // same way zone + animation shaders are warmed above, so the first surface
-    // paint never blocks the render thread on a cold glslang compile. Shares the
-    // single-threaded m_shaderBakePool, so all three categories serialise.
+    // paint never blocks the render thread on a cold glslang compile. Shares
+    // m_shaderBakePool, so all three categories draw on one bake budget.
     //
     // Like the zone/animation warm-bakes, the surface bake installs the same
     // fragment entry-point scaffold the live loader uses (the
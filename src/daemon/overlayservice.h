@@ -241,6 +241,7 @@ public:
 
     // Mouse position for shader effects
     void updateMousePosition(int cursorX, int cursorY) override;
+    bool consumesMousePosition(const QString& screenId) const override;
 
     // Filtered layout count for trigger edge computation
     int visibleLayoutCount(const QString& screenId) const override;
@@ -356,6 +357,7 @@ public:
     bool setSnapAssistThumbnail(const QString& compositorHandle, int width, int height,
                                 const QByteArray& pixels) override;
     bool setWindowThumbnailDmabuf(const QString& compositorHandle, const DmabufThumbnailDesc& desc) override;
+    bool setSnapAssistThumbnailMemfd(const QString& compositorHandle, const MemfdThumbnailDesc& desc) override;
 
     // PhosphorZones::Layout Picker overlay (interactive layout browser + resnap)
     void showLayoutPicker(const QString& screenId = QString());
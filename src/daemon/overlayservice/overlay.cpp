@@ -455,6 +455,13 @@ void OverlayService::updateMousePosition(int cursorX, int cursorY)
     }
 }
 
+bool OverlayService::consumesMousePosition(const QString& screenId) const
+{
+    // Only the shader path binds mousePosition (iMouse); the plain QML
+    // overlay ignores it.
+    return useShaderForScreen(screenId);
+}
+
 void OverlayService::createOverlayWindow(QScreen* screen)
 {
     const QString screenId = PhosphorScreens::ScreenIdentity::identifierFor(screen);
@@ -13,6 +13,7 @@
 #include <PhosphorScreens/Manager.h>
 #include <PhosphorScreens/VirtualScreen.h>
 #include "daemon/rendering/snapassistthumbnailprovider.h"
+#include "daemon/rendering/memfdthumbnailimage.h"
 #include "daemon/rendering/dmabuftextureprovider.h"
 #include "daemon/rendering/dmabuffencewaiter.h"
 #include <QGuiApplication>
@@ -304,6 +305,21 @@ bool OverlayService::setSnapAssistThumbnail(const QString& compositorHandle, int
     return updateSnapAssistCandidateThumbnail(compositorHandle, std::move(image));
 }
 
+bool OverlayService::setSnapAssistThumbnailMemfd(const QString& compositorHandle, const MemfdThumbnailDesc& desc)
+{
+    // Shared-memory variant of setSnapAssistThumbnail: same pixel format and
+    // bounds, but the pixels arrive as a sealed memfd rather than a marshalled
+    // byte array. mapMemfdThumbnail validates the shape and the seals and
+    // wraps the read-only mapping directly, so the cache entry references the
+    // sender's pages and they are unmapped when the provider evicts it.
+    QImage image = mapMemfdThumbnail(desc);
+    if (image.isNull()) {
+        qCDebug(lcOverlay) << "setSnapAssistThumbnailMemfd: rejected memfd for" << compositorHandle;
+        return false;
+    }
+    return updateSnapAssistCandidateThumbnail(compositorHandle, std::move(image));
+}
+
 bool OverlayService::setWindowThumbnailDmabuf(const QString& compositorHandle, const DmabufThumbnailDesc& desc)
 {
     // Experimental zero-copy GPU thumbnail path (Phase-0 spike). Gated behind
@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "memfdthumbnailimage.h"
+
+#include "core/platform/logging.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace PlasmaZones {
+
+namespace {
+
+constexpr int RequiredSeals = F_SEAL_WRITE | F_SEAL_SHRINK;
+
+// Same ceiling as the byte-array path in OverlayService::setSnapAssistThumbnail.
+constexpr int MaxDimension = 1024;
+// Row padding beyond width * 4 that a sender may use (QImage aligns rows to
+// 4 bytes, so real senders use none); bounds the mapping for a given size.
+constexpr int MaxStridePadding = 256;
+
+struct Mapping
+{
+    void* address;
+    size_t length;
+};
+
+void unmapThumbnail(void* info)
+{
+    auto* mapping = static_cast<Mapping*>(info);
+    ::munmap(mapping->address, mapping->length);
+    delete mapping;
+}
+
+} // namespace
+
+QImage mapMemfdThumbnail(const MemfdThumbnailDesc& desc)
+{
+    if (desc.fd < 0 || desc.width <= 0 || desc.height <= 0 || desc.width > MaxDimension
+        || desc.height > MaxDimension) {
+        qCDebug(lcOverlay) << "mapMemfdThumbnail: invalid descriptor" << desc.width << "x" << desc.height;
+        return {};
+    }
+    const qsizetype minStride = qsizetype(desc.width) * 4;
+    if (desc.stride < minStride || desc.stride > minStride + MaxStridePadding || desc.stride % 4 != 0) {
+        qCDebug(lcOverlay) << "mapMemfdThumbnail: invalid stride" << desc.stride << "for width" << desc.width;
+        return {};
+    }
+    const int seals = ::fcntl(desc.fd, F_GET_SEALS);
+    if (seals < 0 || (seals & RequiredSeals) != RequiredSeals) {
+        qCDebug(lcOverlay) << "mapMemfdThumbnail: memfd not sealed (seals=" << seals << ")";
+        return {};
+    }
+    const size_t length = size_t(desc.stride) * size_t(desc.height);
+    struct stat st;
+    if (::fstat(desc.fd, &st) != 0 || st.st_size < 0 || size_t(st.st_size) < length) {
+        qCDebug(lcOverlay) << "mapMemfdThumbnail: memfd smaller than" << length << "bytes";
+        return {};
+    }
+    void* address = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, desc.fd, 0);
+    if (address == MAP_FAILED) {
+        qCWarning(lcOverlay) << "mapMemfdThumbnail: mmap failed:" << strerror(errno);
+        return {};
+    }
+    // The const-uchar* constructor keeps the image read-only: a mutating
+    // access detaches into an owned copy instead of writing through.
+    auto* mapping = new Mapping{address, length};
+    QImage image(static_cast<const uchar*>(address), desc.width, desc.height, desc.stride, QImage::Format_ARGB32,
+                 unmapThumbnail, mapping);
+    if (image.isNull()) {
+        unmapThumbnail(mapping);
+    }
+    return image;
+}
+
+} // namespace PlasmaZones
@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "core/types/memfdthumbnail.h"
+
+#include <QImage>
+
+namespace PlasmaZones {
+
+/**
+ * @brief Map a sealed thumbnail memfd read-only and wrap it in a QImage.
+ *
+ * The returned image points straight at the shared pages — no pixel copy —
+ * and unmaps them when its last implicitly-shared copy is destroyed (e.g.
+ * when SnapAssistThumbnailProvider evicts the entry). Because the image was
+ * built over const data, any mutating access detaches into an owned copy
+ * first, so the read-only mapping is never written through.
+ *
+ * The memfd must carry F_SEAL_WRITE (the mapped pixels stay immutable for as
+ * long as the image lives, so zero-copy is safe against a sender that keeps
+ * its fd) and F_SEAL_SHRINK (a truncate by the sender can't SIGBUS a reader
+ * of the mapping). Returns a null QImage if the descriptor is malformed, a
+ * seal is missing, the file is smaller than stride × height, or mmap fails.
+ * Does not take ownership of @c desc.fd.
+ */
+QImage mapMemfdThumbnail(const MemfdThumbnailDesc& desc);
+
+} // namespace PlasmaZones
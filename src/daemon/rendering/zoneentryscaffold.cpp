@@ -31,7 +31,7 @@ QList<PhosphorShaders::EntryCandidate> zoneEntryCandidates()
         "void main() {\n"
         "    if (zoneCount == 0) { fragColor = vec4(0.0); return; }\n"
         "    vec4 p_accum = vec4(0.0);\n"
-        "    for (int p_i = 0; p_i < zoneCount && p_i < 64; p_i++) {\n"
+        "    for (int p_i = 0; p_i < zoneCount && p_i < PZ_MAX_ZONES; p_i++) {\n"
         "        vec4 p_rect = zoneRects[p_i];\n"
         "        if (p_rect.z <= 0.0 || p_rect.w <= 0.0) continue;\n"
         "        ZoneCtx p_z;\n"
@@ -471,7 +471,8 @@ QSGNode* ZoneShaderItem::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData*
     // Three things happen together:
     //   1. Convert our thread-safe ZoneDataSnapshot into the wire-format
     //      ZoneData vector the extension's writer expects.
-    //   2. Push zone contents into m_zoneExtension (writes the UBO region).
+    //   2. Push zone contents into m_zoneExtension (writes the UBO region,
+    //      plus the storage copy a storage-mode node uploads).
     //   3. Tell the node the new counts so it can update appField0/appField1
     //      for the shader's per-zone loops / highlight gating.
     //
@@ -483,24 +484,25 @@ QSGNode* ZoneShaderItem::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData*
             m_zoneDataDirty.store(false);
             PhosphorRendering::ZoneDataSnapshot snapshot = getZoneDataSnapshot();
 
-            // The UBO's zone arrays are fixed at MaxZones, and both the
-            // extension writer and setZoneCounts clamp to it, so an oversized
-            // layout truncates rather than corrupting. Truncation is silent
-            // everywhere else in the chain though, and the symptom is zones
-            // that simply do not appear, so say so once.
-            if (snapshot.zoneCount > PhosphorRendering::MaxZones && !m_loggedZoneOverflow) {
+            // The shader sees at most zoneCapacity() zones: the UBO's
+            // MaxZones, or MaxStorageZones where the node reads zone data from
+            // storage buffers. The extension writer and setZoneCounts both
+            // clamp, so an oversized layout truncates rather than corrupting.
+            // Truncation is silent everywhere else in the chain though, and
+            // the symptom is zones that simply do not appear, so say so once.
+            const int zoneCapacity = node->zoneCapacity();
+            if (snapshot.zoneCount > zoneCapacity && !m_loggedZoneOverflow) {
                 m_loggedZoneOverflow = true;
                 qCWarning(PlasmaZones::lcOverlay)
-                    << "ZoneShaderItem: layout has" << snapshot.zoneCount << "zones but the shader UBO holds"
-                    << PhosphorRendering::MaxZones << "- the excess will not be rendered.";
+                    << "ZoneShaderItem: layout has" << snapshot.zoneCount << "zones but the shader holds"
+                    << zoneCapacity << "- the excess will not be rendered.";
             }
 
-            // Clamped: everything past MaxZones is discarded by
-            // updateFromZones() anyway, so building it (two QColor conversions
-            // apiece) is pure waste on an oversized layout. The raw count still
-            // goes to setZoneCounts and to the warning above, both of which
-            // want the true number.
-            const int syncCount = qMin(snapshot.zoneCount, PhosphorRendering::MaxZones);
+            // Clamped: nothing past the capacity can reach the shader, so
+            // building it (two QColor conversions apiece) is pure waste on an
+            // oversized layout. The raw count still goes to setZoneCounts and
+            // to the warning above, both of which want the true number.
+            const int syncCount = qMin(snapshot.zoneCount, zoneCapacity);
             QVector<PhosphorRendering::ZoneData> zoneDataVec;
             zoneDataVec.reserve(syncCount);
 
@@ -536,7 +538,7 @@ QSGNode* ZoneShaderItem::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData*
             m_zoneExtension->updateFromZones(zoneDataVec);
             // Highlight count is the count AMONG THE UPLOADED zones, not among
             // all of them: on an oversized layout the shader can only see the
-            // first MaxZones, so a snapshot-wide count would make appField1
+            // first zoneCapacity, so a snapshot-wide count would make appField1
             // claim more highlights than the shader has zones for.
             node->setZoneCounts(snapshot.zoneCount, uploadedHighlighted);
         }
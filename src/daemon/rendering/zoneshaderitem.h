@@ -219,7 +219,7 @@ private:
     // is enough.
     bool m_loggedBadScale = false;
 
-    // Same latch, for a layout with more zones than the UBO can hold.
+    // Same latch, for a layout with more zones than the shader can hold.
     bool m_loggedZoneOverflow = false;
 };
 
@@ -15,7 +15,8 @@ namespace PlasmaZones {
 PhosphorRendering::WarmShaderBakeResult
 warmShaderBakeCacheForPaths(const QString& vertexPath, const QString& fragmentPath, const QStringList& includePaths,
                             const QString& paramPreamble, const QString& entryPrologue,
-                            const QList<PhosphorShaders::EntryCandidate>& entryCandidates)
+                            const QList<PhosphorShaders::EntryCandidate>& entryCandidates,
+                            PhosphorRendering::ShaderCompiler::Targets fragmentTargets)
 {
     if (vertexPath.isEmpty() || fragmentPath.isEmpty()) {
         PhosphorRendering::WarmShaderBakeResult result;
@@ -26,7 +27,7 @@ warmShaderBakeCacheForPaths(const QString& vertexPath, const QString& fragmentPa
     const QStringList expandedPaths = expandShaderIncludePaths(includePaths);
 
     return PhosphorRendering::warmShaderBakeCacheForPaths(vertexPath, fragmentPath, expandedPaths, paramPreamble,
-                                                          entryPrologue, entryCandidates);
+                                                          entryPrologue, entryCandidates, fragmentTargets);
 }
 
 } // namespace PlasmaZones
@@ -137,12 +137,16 @@ inline QString resolveZoneVertexPath(const QString& fragmentPath, const QStringL
  *                        rendering-library warm bake. MUST match what ZoneShaderItem
  *                        installs via setEntryScaffold so warm + live agree on the
  *                        assembled source and the bake-cache key. Empty = no assembly.
+ * @param fragmentTargets fragment bake targets, forwarded likewise; SpirvOnly when
+ *                        @p paramPreamble carries the zone-storage defines.
  * @return success and error message (e.g. from QShaderBaker) for UI reporting
  */
 PLASMAZONES_RENDERING_EXPORT PhosphorRendering::WarmShaderBakeResult
 warmShaderBakeCacheForPaths(const QString& vertexPath, const QString& fragmentPath,
                             const QStringList& includePaths = {}, const QString& paramPreamble = {},
                             const QString& entryPrologue = {},
-                            const QList<PhosphorShaders::EntryCandidate>& entryCandidates = {});
+                            const QList<PhosphorShaders::EntryCandidate>& entryCandidates = {},
+                            PhosphorRendering::ShaderCompiler::Targets fragmentTargets =
+                                PhosphorRendering::ShaderCompiler::Targets::All);
 
 } // namespace PlasmaZones
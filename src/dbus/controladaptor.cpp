@@ -15,6 +15,7 @@
 #include <PhosphorScreens/ScreenIdentity.h>
 #include "core/platform/supportreport.h"
 #include <PhosphorEngine/IPlacementEngine.h>
+#include <PhosphorTileEngine/AutotileEngine.h>
 #include <PhosphorProtocol/ServiceConstants.h>
 
 #include <QDBusConnection>
@@ -223,6 +224,15 @@ QString ControlAdaptor::generateSupportReport(int sinceMinutes, const QDBusMessa
         snapshot.bridgeCapabilities = m_compositorBridge->bridgeCapabilities();
     }
 
+    // The zone-cache counters live on the concrete engine, not on the
+    // IPlacementEngine interface SupportReport takes.
+    if (auto* engine = dynamic_cast<PhosphorTileEngine::AutotileEngine*>(m_autotileEngine)) {
+        const auto stats = engine->zoneCacheStats();
+        snapshot.hasZoneCacheStats = true;
+        snapshot.zoneCacheHits = stats.hits;
+        snapshot.zoneCacheMisses = stats.misses;
+    }
+
     // Run blocking work (file I/O, journalctl) off the main thread.
     // No parent — lifetime managed explicitly by the two signal handlers below.
     // Parenting to `this` would cause Qt to auto-delete the watcher during ~QObject,
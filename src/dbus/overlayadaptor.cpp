@@ -5,6 +5,7 @@
 #include "dbushelpers.h"
 #include "core/interfaces/interfaces.h"
 #include "core/types/dmabufthumbnail.h"
+#include "core/types/memfdthumbnail.h"
 #include "core/interfaces/ioverlayservice.h"
 #include <PhosphorZones/IZoneLayoutRegistry.h>
 #include <PhosphorZones/Layout.h>
@@ -356,6 +357,33 @@ bool OverlayAdaptor::setWindowThumbnailDmabuf(const QString& compositorHandle, i
     return m_overlayService->setWindowThumbnailDmabuf(compositorHandle, desc);
 }
 
+bool OverlayAdaptor::setSnapAssistThumbnailMemfd(const QString& compositorHandle, int width, int height, int stride,
+                                                 const QDBusUnixFileDescriptor& fd)
+{
+    if (!m_overlayService) {
+        return false;
+    }
+    // Like the dma-buf path there is no inline payload to bound, so
+    // authenticate first. Shape, seals and file size are validated by the
+    // service before anything is mapped.
+    if (!authenticateKwinSender()) {
+        return false;
+    }
+    if (!fd.isValid()) {
+        qCWarning(lcDbus) << "setSnapAssistThumbnailMemfd: invalid memfd (handle len=" << compositorHandle.size()
+                          << ")";
+        return false;
+    }
+    // fd is BORROWED (closed when this call returns); the service's mapping
+    // outlives it, so nothing needs to dup() it.
+    MemfdThumbnailDesc desc;
+    desc.fd = fd.fileDescriptor();
+    desc.width = width;
+    desc.height = height;
+    desc.stride = stride;
+    return m_overlayService->setSnapAssistThumbnailMemfd(compositorHandle, desc);
+}
+
 bool OverlayAdaptor::authenticateKwinSender()
 {
     // Resolve the sender's bus name via QDBusContext. Direct (non-D-Bus) calls
@@ -91,6 +91,8 @@ public Q_SLOTS:
     bool setWindowThumbnailDmabuf(const QString& compositorHandle, int width, int height, uint drmFormat,
                                   qulonglong modifier, uint stride, uint offset, const QDBusUnixFileDescriptor& fd,
                                   const QDBusUnixFileDescriptor& fenceFd);
+    bool setSnapAssistThumbnailMemfd(const QString& compositorHandle, int width, int height, int stride,
+                                     const QDBusUnixFileDescriptor& fd);
 
 Q_SIGNALS:
     void overlayVisibilityChanged(bool visible);
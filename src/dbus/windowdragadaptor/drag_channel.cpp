@@ -0,0 +1,154 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Shared-memory drag channel — the opt-in replacement for the per-sample
+// updateDragCursor D-Bus call. The compositor plugin owns the ring and
+// publishes every cursor sample; this side only ever looks at the newest
+// one, at most once per display frame, and routes it through the same
+// updateDragCursor entry point the D-Bus path uses, so zone detection and
+// the policy-flip logic see no difference between the two transports.
+
+#include "windowdragadaptor.h"
+#include "core/platform/logging.h"
+#include <QGuiApplication>
+#include <QScreen>
+#include <QSocketNotifier>
+#include <QTimer>
+#include <cmath>
+#include <limits>
+
+namespace PlasmaZones {
+
+bool WindowDragAdaptor::attachDragChannel(const QDBusUnixFileDescriptor& memFd,
+                                          const QDBusUnixFileDescriptor& doorbellFd)
+{
+    detachDragChannel();
+
+    if (!memFd.isValid() || !doorbellFd.isValid()) {
+        qCWarning(lcDbusWindow) << "attachDragChannel: invalid file descriptors";
+        return false;
+    }
+
+    auto channel = PhosphorProtocol::DragSampleChannel::attach(memFd.fileDescriptor(), doorbellFd.fileDescriptor());
+    if (!channel) {
+        qCWarning(lcDbusWindow) << "attachDragChannel: rejected channel, plugin stays on updateDragCursor";
+        return false;
+    }
+
+    m_dragChannel = std::move(channel);
+    m_dragChannelConsumed = m_dragChannel->writeSequence();
+
+    m_dragChannelNotifier = new QSocketNotifier(m_dragChannel->doorbellFd(), QSocketNotifier::Read, this);
+    connect(m_dragChannelNotifier, &QSocketNotifier::activated, this, &WindowDragAdaptor::onDragChannelDoorbell);
+
+    m_dragChannelTick = new QTimer(this);
+    m_dragChannelTick->setSingleShot(true);
+    m_dragChannelTick->setTimerType(Qt::PreciseTimer);
+    connect(m_dragChannelTick, &QTimer::timeout, this, &WindowDragAdaptor::consumeDragChannel);
+
+    // Samples already in the ring predate this attach; arm for the next one.
+    m_dragChannel->rearmDoorbell();
+    qCInfo(lcDbusWindow) << "attachDragChannel: shared-memory drag channel attached";
+    return true;
+}
+
+void WindowDragAdaptor::detachDragChannel()
+{
+    // deleteLater: detach can run from inside the notifier's own activated
+    // signal (a reconnect racing a wake-up), where deleting it is unsafe.
+    if (m_dragChannelNotifier) {
+        m_dragChannelNotifier->setEnabled(false);
+        m_dragChannelNotifier->deleteLater();
+        m_dragChannelNotifier = nullptr;
+    }
+    if (m_dragChannelTick) {
+        m_dragChannelTick->stop();
+        m_dragChannelTick->deleteLater();
+        m_dragChannelTick = nullptr;
+    }
+    m_dragChannel.reset();
+    m_dragChannelConsumed = 0;
+}
+
+void WindowDragAdaptor::resetDragChannelBaseline()
+{
+    if (m_dragChannel) {
+        m_dragChannelConsumed = m_dragChannel->writeSequence();
+    }
+}
+
+void WindowDragAdaptor::resumeDragChannel()
+{
+    if (m_dragChannel && m_dragChannelTick && !m_dragChannelTick->isActive()
+        && m_dragChannel->writeSequence() > m_dragChannelConsumed) {
+        m_dragChannelTick->start(0);
+    }
+}
+
+int WindowDragAdaptor::dragChannelFrameIntervalMs() const
+{
+    // Pace to the fastest connected display: the drag overlay repaints at
+    // most that often, so consuming more often than this is wasted work and
+    // consuming less often adds visible latency.
+    qreal maxRefresh = 60.0;
+    for (const QScreen* screen : QGuiApplication::screens()) {
+        maxRefresh = std::max(maxRefresh, screen->refreshRate());
+    }
+    return std::max(1, static_cast<int>(std::floor(1000.0 / maxRefresh)));
+}
+
+void WindowDragAdaptor::onDragChannelDoorbell()
+{
+    if (!m_dragChannel || !m_dragChannelTick) {
+        return;
+    }
+    // The eventfd stays readable until consumeDragChannel drains it; mute the
+    // notifier until then so the event loop doesn't spin on it.
+    m_dragChannelNotifier->setEnabled(false);
+    if (m_dragChannelTick->isActive()) {
+        return;
+    }
+    // First sample after an idle period is handled immediately; follow-ups
+    // land no sooner than one frame after the previous consume.
+    const int interval = dragChannelFrameIntervalMs();
+    const qint64 sinceLast =
+        m_dragChannelLastConsume.isValid() ? m_dragChannelLastConsume.elapsed() : std::numeric_limits<qint64>::max();
+    m_dragChannelTick->start(sinceLast >= interval ? 0 : static_cast<int>(interval - sinceLast));
+}
+
+void WindowDragAdaptor::consumeDragChannel()
+{
+    if (!m_dragChannel) {
+        return;
+    }
+    m_dragChannelLastConsume.start();
+
+    // The ring carries no window id: the drag in flight is fixed by
+    // beginDrag. A pending (not yet activated) snap drag is addressed by its
+    // pending id, exactly as the D-Bus path would. With no drag in flight the
+    // samples are left unconsumed: they precede a beginDrag still in transit,
+    // which picks them up through resumeDragChannel.
+    const QString windowId = !m_draggedWindowId.isEmpty() ? m_draggedWindowId : m_pendingSnapDragWindowId;
+    PhosphorProtocol::DragSample sample;
+    quint64 sequence = 0;
+    if (!windowId.isEmpty() && m_dragChannel->readLatest(sample, &sequence) && sequence > m_dragChannelConsumed) {
+        m_dragChannelConsumed = sequence;
+        updateDragCursor(windowId, sample.cursorX, sample.cursorY, sample.modifiers, sample.mouseButtons);
+    }
+
+    // updateDragCursor may have torn the channel down (reconnect re-entrancy).
+    if (!m_dragChannel) {
+        return;
+    }
+    m_dragChannel->rearmDoorbell();
+    if (m_dragChannelNotifier) {
+        m_dragChannelNotifier->setEnabled(true);
+    }
+    // A sample published between readLatest and the re-arm did not ring —
+    // catch it on the next frame instead of waiting for the one after it.
+    if (!windowId.isEmpty() && m_dragChannel->writeSequence() > m_dragChannelConsumed && m_dragChannelTick) {
+        m_dragChannelTick->start(dragChannelFrameIntervalMs());
+    }
+}
+
+} // namespace PlasmaZones
@@ -182,6 +182,14 @@ PhosphorProtocol::DragPolicy WindowDragAdaptor::beginDrag(const QString& windowI
     // cancels any leftover drag-insert preview so a new drag always starts
     // from a clean slate.
     clearPendingSnapDragState();
+    // The plugin starts publishing into the shared-memory drag channel as
+    // soon as its drag starts, which can be before this call lands. Those
+    // samples belong to this drag (endDrag already retired the previous
+    // drag's), so consume whatever is waiting.
+    resumeDragChannel();
+    // Shader overlay / autotile state may have flipped since the snapshots
+    // were computed; the plugin's filter must see the current verdict.
+    republishZoneHitSnapshots(false);
 
     // Reset autotile drag-insert toggle state on every drag start. This runs
     // before branching so it covers both the bypass path (drag starts on an
@@ -405,6 +413,11 @@ PhosphorProtocol::DragOutcome WindowDragAdaptor::endDrag(const QString& windowId
     PhosphorProtocol::DragOutcome outcome;
     outcome.windowId = windowId;
 
+    // Every sample the plugin wrote for this drag is in the ring before its
+    // endDrag call was sent. Retire them here, so none can reach the next
+    // drag, and so beginDrag can keep the samples that precede it.
+    resetDragChannelBaseline();
+
     if (windowId.isEmpty()) {
         qCWarning(lcDbusWindow) << "endDrag: empty windowId";
         return outcome;
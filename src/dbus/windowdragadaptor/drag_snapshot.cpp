@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Zone-hit snapshots for effect-side drag filtering. Once per layout compute
+// the daemon publishes the absolute zone rects it hit-tests drags against;
+// the compositor plugin runs the same hit test locally and only sends
+// updateDragCursor when a sample could change the zone pick. The daemon
+// stays authoritative — the snapshot only decides which samples are worth
+// the round trip.
+
+#include "windowdragadaptor.h"
+#include "core/interfaces/interfaces.h"
+#include "core/interfaces/settings_interfaces.h"
+#include <PhosphorEngine/IPlacementEngine.h>
+#include <PhosphorScreens/Manager.h>
+#include <PhosphorZones/Layout.h>
+#include <PhosphorZones/LayoutRegistry.h>
+#include <PhosphorZones/Zone.h>
+
+namespace PlasmaZones {
+
+bool WindowDragAdaptor::tracksCursorOnScreen(const QString& screenId) const
+{
+    if (m_overlayService && m_overlayService->consumesMousePosition(screenId)) {
+        return true;
+    }
+    return m_autotileEngine && m_autotileEngine->isActiveOnScreen(screenId);
+}
+
+void WindowDragAdaptor::publishZoneHitSnapshot(const QString& screenId, PhosphorZones::Layout* layout,
+                                               quint64 generation)
+{
+    if (screenId.isEmpty() || !m_layoutManager || !m_settings) {
+        return;
+    }
+
+    // A compute for a layout the screen does not display (e.g. a preview or
+    // a layout switched away from mid-flight) says nothing about drags.
+    const bool suppressed =
+        isActiveLayoutSuppressedForScreen(screenId, m_layoutManager->currentVirtualDesktopForScreen(screenId));
+    PhosphorZones::Layout* active = suppressed ? nullptr : m_layoutManager->resolveLayoutForScreen(screenId);
+    if (layout && layout != active) {
+        return;
+    }
+
+    const auto previous = m_zoneHitSnapshots.constFind(screenId);
+    if (previous != m_zoneHitSnapshots.constEnd() && previous->generation > generation) {
+        return;
+    }
+
+    PhosphorProtocol::ZoneHitSnapshot snapshot;
+    snapshot.screenId = screenId;
+    snapshot.generation = generation;
+    snapshot.adjacencyThreshold = m_settings->adjacentThreshold();
+    snapshot.tracksCursor = tracksCursorOnScreen(screenId);
+    if (m_screenManager) {
+        snapshot.screenGeometry =
+            PhosphorProtocol::ZoneGeometryRect::fromRect(m_screenManager->screenGeometry(screenId));
+    }
+    // Suppressed screen: an empty snapshot is accurate — the daemon hit-tests
+    // nothing there.
+    if (active) {
+        snapshot.layoutId = active->id().toString();
+        const auto zones = active->zones();
+        snapshot.zones.reserve(zones.size());
+        for (const PhosphorZones::Zone* zone : zones) {
+            // Rounded outward so the plugin's integer rect never claims less
+            // than the daemon's float one; stableHitAt's slack covers the rest.
+            const QRect rect = zone->geometry().toAlignedRect();
+            PhosphorProtocol::NamedZoneGeometry entry;
+            entry.zoneId = zone->id().toString();
+            entry.x = rect.x();
+            entry.y = rect.y();
+            entry.width = rect.width();
+            entry.height = rect.height();
+            snapshot.zones.append(entry);
+        }
+    }
+
+    m_zoneHitSnapshots.insert(screenId, snapshot);
+    Q_EMIT zoneHitSnapshotChanged(snapshot);
+}
+
+void WindowDragAdaptor::republishZoneHitSnapshots(bool invalidate)
+{
+    const int threshold = m_settings ? m_settings->adjacentThreshold() : 0;
+    for (auto it = m_zoneHitSnapshots.begin(); it != m_zoneHitSnapshots.end(); ++it) {
+        const bool tracks = invalidate || tracksCursorOnScreen(it.key());
+        if (tracks == it->tracksCursor && threshold == it->adjacencyThreshold) {
+            continue;
+        }
+        it->tracksCursor = tracks;
+        it->adjacencyThreshold = threshold;
+        Q_EMIT zoneHitSnapshotChanged(it.value());
+    }
+}
+
+PhosphorProtocol::ZoneHitSnapshotList WindowDragAdaptor::getZoneHitSnapshots() const
+{
+    return m_zoneHitSnapshots.values();
+}
+
+} // namespace PlasmaZones
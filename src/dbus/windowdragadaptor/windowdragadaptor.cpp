@@ -77,6 +77,13 @@ WindowDragAdaptor::WindowDragAdaptor(IOverlayService* overlay, PhosphorZones::IZ
                 onLayoutChanged();
             });
 
+    // The zone-hit snapshots carry the adjacency threshold; the plugin's
+    // filter keys on it, so a change must reach the plugin before the next
+    // layout compute does.
+    connect(m_settings, &ISettings::adjacentThresholdChanged, this, [this]() {
+        republishZoneHitSnapshots(false);
+    });
+
     // Escape-to-cancel during a drag is handled by the kwin-effect's keyboard
     // grab (grabbedKeyboardEvent -> callCancelSnap), not by a KGlobalAccel
     // binding — binding one per drag forced kwin to fsync kglobalshortcutsrc
@@ -709,6 +716,9 @@ void WindowDragAdaptor::clearForCompositorReconnect()
     // reconnect path can leave a window where the next beginDrag has
     // not yet fired.
     m_lastLoggedActivationActive = false;
+    // The shared-memory drag channel belongs to the effect instance that is
+    // going away; a fresh one re-attaches its own after registering.
+    detachDragChannel();
     // Drop any picker-nav lambda registrations: their captures
     // include OverlayService* which the compositor-reconnect path
     // may tear down before the next picker-show re-registers.
@@ -789,6 +799,10 @@ void WindowDragAdaptor::onLayoutChanged()
     m_suppressMemoActivity.clear();
     m_suppressMemoValue = false;
 
+    // The published rects belong to the old layout; make the plugin forward
+    // every sample until the recompute republishes them.
+    republishZoneHitSnapshots(true);
+
     // Clear cached zone state when layout changes mid-drag to prevent stale geometry
     // This handles the case where user changes layout via hotkey/GUI while dragging
     // On next dragMoved(), fresh geometry will be calculated from the new layout
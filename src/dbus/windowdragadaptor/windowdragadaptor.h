@@ -5,17 +5,23 @@
 
 #include "plasmazones_export.h"
 #include <PhosphorProtocol/DragMarshalling.h>
+#include <PhosphorProtocol/DragSampleChannel.h>
 #include <PhosphorProtocol/ZoneMarshalling.h>
 #include <QDBusAbstractAdaptor>
+#include <QDBusUnixFileDescriptor>
+#include <QElapsedTimer>
 #include <QObject>
 #include <QString>
 #include <QRect>
 #include <QUuid>
+#include <QHash>
 #include <QSet>
 #include <QVector>
 #include <memory>
 
 class QScreen;
+class QSocketNotifier;
+class QTimer;
 
 namespace PhosphorScreens {
 class ScreenManager;
@@ -211,7 +217,9 @@ public Q_SLOTS:
     /**
      * Update drag cursor position — fire-and-forget counterpart to
      * beginDrag / endDrag. Replaces dragMoved as the canonical hot-path
-     * entry point during a drag. Throttled 30Hz by the compositor plugin.
+     * entry point during a drag. Throttled 30Hz by the compositor plugin;
+     * bypassed entirely while a shared-memory drag channel is attached
+     * (attachDragChannel), which drives this method from the ring instead.
      *
      * For snap-path drags: delegates to legacy dragMoved internally to
      * keep overlay/zone-detection state current.
@@ -224,6 +232,30 @@ public Q_SLOTS:
      */
     void updateDragCursor(const QString& windowId, int cursorX, int cursorY, int modifiers, int mouseButtons);
 
+    /**
+     * Attach the compositor plugin's shared-memory drag channel (opt-in fast
+     * path, see PhosphorProtocol::DragSampleChannel). While attached, the
+     * plugin stops sending updateDragCursor and instead publishes every
+     * cursor sample into the ring; the daemon reads the newest one at most
+     * once per display frame and feeds it through updateDragCursor for the
+     * window of the drag in flight.
+     *
+     * Replaces any previously attached channel. Returns false when the fds
+     * fail validation (unsealed memfd, wrong size or layout version) — the
+     * plugin then stays on the D-Bus path.
+     */
+    bool attachDragChannel(const QDBusUnixFileDescriptor& memFd, const QDBusUnixFileDescriptor& doorbellFd);
+
+    /** Drop the shared-memory drag channel; the plugin is back on updateDragCursor. */
+    void detachDragChannel();
+
+    /**
+     * Current zone-hit snapshot for every screen the daemon has computed a
+     * layout for (see PhosphorProtocol::ZoneHitSnapshot). The plugin fetches
+     * this once at bring-up and then follows zoneHitSnapshotChanged.
+     */
+    PhosphorProtocol::ZoneHitSnapshotList getZoneHitSnapshots() const;
+
     /** Forward mouse wheel delta to zone selector for scrolling during drag. */
     void selectorScrollWheel(int angleDeltaY);
 
@@ -294,6 +326,16 @@ public:
         return !m_draggedWindowId.isEmpty();
     }
 
+    /**
+     * Publish the zone-hit snapshot for @p screenId from @p layout's freshly
+     * computed absolute zone geometry. Wired by the daemon to
+     * LayoutComputeService::geometriesComputedForGeneration — i.e. once per
+     * layout compute, never per drag sample. Results for a layout that is
+     * not the screen's active one are ignored. Plain member (NOT a Q_SLOT):
+     * in-process only, must not surface on the bus.
+     */
+    void publishZoneHitSnapshot(const QString& screenId, PhosphorZones::Layout* layout, quint64 generation);
+
 Q_SIGNALS:
     /**
      * Emitted when the zone geometry under the cursor changes during drag.
@@ -328,6 +370,14 @@ Q_SIGNALS:
     void snapAssistReady(const QString& windowId, const QString& releaseScreenId,
                          const PhosphorProtocol::EmptyZoneList& emptyZones);
 
+    /**
+     * The computed zone rects for a screen changed (layout compute landed,
+     * or a layout switch invalidated them). The plugin hit-tests drag
+     * samples against the snapshot and only forwards updateDragCursor when
+     * the sample could change the daemon's zone pick.
+     */
+    void zoneHitSnapshotChanged(const PhosphorProtocol::ZoneHitSnapshot& snapshot);
+
 private:
     // Tolerance constants for geometry matching (fallback detection)
     // Position tolerance is generous due to KWin window decoration/shadow offsets
@@ -648,6 +698,37 @@ private:
     // overwritten by the snap commit by the time this runs.
     void tryStorePreSnapGeometry(const QString& windowId, const QRect& originalGeometry);
 
+    // Shared-memory drag channel (attachDragChannel). The doorbell notifier
+    // wakes us on the first sample after each re-arm; consumption is then
+    // deferred to a single-shot tick so a burst of samples inside one display
+    // frame collapses into one updateDragCursor call on the newest sample.
+    void onDragChannelDoorbell();
+    void consumeDragChannel();
+    /// Mark every sample already in the ring as consumed. endDrag calls this
+    /// so a stale sample from a finished drag never reaches the next one.
+    void resetDragChannelBaseline();
+    /// Schedule a consume if samples arrived before a drag was in flight.
+    /// beginDrag calls this: the plugin may publish before the call lands.
+    void resumeDragChannel();
+    int dragChannelFrameIntervalMs() const;
+
+    /// Whether the daemon consumes the raw cursor on @p screenId beyond the
+    /// zone pick (shader overlay mouse uniform, autotile insert preview).
+    bool tracksCursorOnScreen(const QString& screenId) const;
+    /// Re-emit stored snapshots whose tracksCursor flag or adjacency
+    /// threshold is stale. With @p invalidate every snapshot is forced to
+    /// tracksCursor=true until the next compute replaces it (layout switch:
+    /// the rects are no longer trustworthy).
+    void republishZoneHitSnapshots(bool invalidate);
+    // Last published zone-hit snapshot per screen (getZoneHitSnapshots).
+    QHash<QString, PhosphorProtocol::ZoneHitSnapshot> m_zoneHitSnapshots;
+
+    std::unique_ptr<PhosphorProtocol::DragSampleChannel> m_dragChannel;
+    QSocketNotifier* m_dragChannelNotifier = nullptr;
+    QTimer* m_dragChannelTick = nullptr;
+    QElapsedTimer m_dragChannelLastConsume;
+    quint64 m_dragChannelConsumed = 0;
+
 private Q_SLOTS:
     /**
      * Called when the active layout changes mid-drag
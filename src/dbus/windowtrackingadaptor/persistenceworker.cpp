@@ -2,11 +2,15 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "persistenceworker.h"
+#include "sessionjournal.h"
 
 #include "config/configbackends.h"
 #include "core/platform/logging.h"
 
 #include <QThread>
+#include <QTimer>
+
+#include <unistd.h>
 
 namespace PlasmaZones {
 
@@ -27,6 +31,85 @@ void PersistenceIO::processWrite(const QString& filePath, const QJsonObject& roo
     Q_EMIT writeCompleted(filePath, ok);
 }
 
+void PersistenceIO::processAppend(const QString& journalPath, const QByteArray& records)
+{
+    if (m_journal.fileName() != journalPath || !m_journal.isOpen()) {
+        m_journal.close();
+        m_journal.setFileName(journalPath);
+        // Append-only: the header was laid down by processCompact, and a
+        // journal that does not exist yet means no compaction succeeded, so
+        // there is nothing valid to append to.
+        if (!m_journal.exists() || !m_journal.open(QIODevice::WriteOnly | QIODevice::Append)) {
+            qCWarning(lcDbusWindow) << "PersistenceIO: cannot open journal" << journalPath;
+            Q_EMIT writeCompleted(journalPath, false);
+            return;
+        }
+    }
+    // One write() call per batch keeps the torn-record window to the tail of
+    // a single append; flush() hands it to the kernel so a daemon crash
+    // cannot lose it.
+    const bool ok = m_journal.write(records) == records.size() && m_journal.flush();
+    if (!ok) {
+        qCWarning(lcDbusWindow) << "PersistenceIO: journal append failed for" << journalPath
+                                << m_journal.errorString();
+        m_journal.close();
+        Q_EMIT writeCompleted(journalPath, false);
+        return;
+    }
+
+    if (!m_sinceSync.isValid() || m_sinceSync.elapsed() >= PersistenceWorker::JournalSyncIntervalMs) {
+        syncJournal();
+    } else if (!m_syncPending) {
+        if (!m_syncTimer) {
+            m_syncTimer = new QTimer(this);
+            m_syncTimer->setSingleShot(true);
+            connect(m_syncTimer, &QTimer::timeout, this, &PersistenceIO::syncJournal);
+        }
+        m_syncPending = true;
+        m_syncTimer->start(int(PersistenceWorker::JournalSyncIntervalMs - m_sinceSync.elapsed()));
+    }
+    Q_EMIT writeCompleted(journalPath, true);
+}
+
+void PersistenceIO::processCompact(const QString& filePath, const QJsonObject& root, const QString& journalPath,
+                                   const QString& generation)
+{
+    // The snapshot goes first. Until the journal is replaced, the old journal
+    // carries the old generation and is ignored against the new snapshot,
+    // which already contains everything it recorded.
+    bool ok = PhosphorConfig::JsonBackend::writeJsonAtomically(filePath, root);
+    if (ok) {
+        m_journal.close();
+        if (m_syncTimer) {
+            m_syncTimer->stop();
+        }
+        m_syncPending = false;
+        ok = SessionJournal::reset(journalPath, generation);
+        m_sinceSync.start();
+    }
+    if (!ok) {
+        qCWarning(lcDbusWindow) << "PersistenceIO: compaction failed for" << filePath;
+    }
+    Q_EMIT writeCompleted(filePath, ok);
+}
+
+void PersistenceIO::closeJournal()
+{
+    if (m_journal.isOpen()) {
+        syncJournal();
+        m_journal.close();
+    }
+}
+
+void PersistenceIO::syncJournal()
+{
+    m_syncPending = false;
+    m_sinceSync.start();
+    if (m_journal.isOpen() && ::fdatasync(m_journal.handle()) != 0) {
+        qCWarning(lcDbusWindow) << "PersistenceIO: fdatasync failed for" << m_journal.fileName();
+    }
+}
+
 // ═══════════════════════════════════════════════════════════════════════════════
 // PersistenceWorker — main-thread coordinator
 // ═══════════════════════════════════════════════════════════════════════════════
@@ -40,6 +123,8 @@ PersistenceWorker::PersistenceWorker(QObject* parent)
     m_io->moveToThread(m_thread);
 
     connect(this, &PersistenceWorker::requestWrite, m_io, &PersistenceIO::processWrite);
+    connect(this, &PersistenceWorker::requestAppend, m_io, &PersistenceIO::processAppend);
+    connect(this, &PersistenceWorker::requestCompact, m_io, &PersistenceIO::processCompact);
     // Forward completion back to main thread so callers (e.g. saveState)
     // can react to success/failure without touching the I/O thread.
     connect(m_io, &PersistenceIO::writeCompleted, this, &PersistenceWorker::writeCompleted);
@@ -50,6 +135,9 @@ PersistenceWorker::PersistenceWorker(QObject* parent)
 
 PersistenceWorker::~PersistenceWorker()
 {
+    // Blocking, so every request queued ahead of it has been processed and
+    // the journal's last batch is on disk before the thread is told to quit.
+    QMetaObject::invokeMethod(m_io, &PersistenceIO::closeJournal, Qt::BlockingQueuedConnection);
     m_thread->quit();
     m_thread->wait(5000);
 }
@@ -59,6 +147,17 @@ void PersistenceWorker::enqueueWrite(const QString& filePath, const QJsonObject&
     Q_EMIT requestWrite(filePath, root);
 }
 
+void PersistenceWorker::enqueueAppend(const QString& journalPath, const QByteArray& records)
+{
+    Q_EMIT requestAppend(journalPath, records);
+}
+
+void PersistenceWorker::enqueueCompact(const QString& filePath, const QJsonObject& root, const QString& journalPath,
+                                       const QString& generation)
+{
+    Q_EMIT requestCompact(filePath, root, journalPath, generation);
+}
+
 bool PersistenceWorker::writeSync(const QString& filePath, const QJsonObject& root)
 {
     return PhosphorConfig::JsonBackend::writeJsonAtomically(filePath, root);
@@ -4,10 +4,13 @@
 #pragma once
 
 #include "plasmazones_export.h"
+#include <QElapsedTimer>
+#include <QFile>
 #include <QJsonObject>
 #include <QObject>
 
 class QThread;
+class QTimer;
 
 namespace PlasmaZones {
 
@@ -24,17 +27,40 @@ public:
 public Q_SLOTS:
     void processWrite(const QString& filePath, const QJsonObject& root);
 
+    /// Append pre-encoded SessionJournal records. fdatasync is batched: at
+    /// most one per JournalSyncIntervalMs, with a trailing sync armed for
+    /// whatever landed inside the window.
+    void processAppend(const QString& journalPath, const QByteArray& records);
+
+    /// Write the full snapshot, then start a fresh journal of @p generation.
+    /// Ordering matters — see SessionJournal for why a crash between the
+    /// two steps is safe.
+    void processCompact(const QString& filePath, const QJsonObject& root, const QString& journalPath,
+                        const QString& generation);
+
+    /// Flush and close the journal; run before the thread quits.
+    void closeJournal();
+
 Q_SIGNALS:
     /// Emitted on the I/O thread after each write attempt. The filePath
     /// identifies which request completed (distinguishes coalesced writes).
     void writeCompleted(const QString& filePath, bool success);
+
+private:
+    void syncJournal();
+
+    QFile m_journal;
+    QTimer* m_syncTimer = nullptr; // created lazily so it lives on the I/O thread
+    QElapsedTimer m_sinceSync;
+    bool m_syncPending = false;
 };
 
 /**
  * @brief Main-thread coordinator for async JSON config writes.
  *
- * Owns a dedicated QThread + PersistenceIO worker. Call enqueueWrite()
- * from the main thread; the actual QSaveFile I/O runs off-thread.
+ * Owns a dedicated QThread + PersistenceIO worker. Call enqueueWrite(),
+ * enqueueAppend() or enqueueCompact() from the main thread; the actual
+ * I/O runs off-thread, strictly in enqueue order across all three.
  * QJsonObject is implicitly shared (COW) so the copy is cheap.
  *
  * For shutdown, call writeSync() which runs inline on the calling thread.
@@ -47,12 +73,24 @@ public:
     explicit PersistenceWorker(QObject* parent = nullptr);
     ~PersistenceWorker() override;
 
+    /// Upper bound on how often journal appends are fdatasync'ed. A crash of
+    /// the daemon alone loses nothing (the page cache survives it); this only
+    /// bounds what a power loss can take, in exchange for not syncing on
+    /// every debounced save.
+    static constexpr int JournalSyncIntervalMs = 2000;
+
     void enqueueWrite(const QString& filePath, const QJsonObject& root);
+    void enqueueAppend(const QString& journalPath, const QByteArray& records);
+    void enqueueCompact(const QString& filePath, const QJsonObject& root, const QString& journalPath,
+                        const QString& generation);
 
     static bool writeSync(const QString& filePath, const QJsonObject& root);
 
 Q_SIGNALS:
     void requestWrite(const QString& filePath, const QJsonObject& root);
+    void requestAppend(const QString& journalPath, const QByteArray& records);
+    void requestCompact(const QString& filePath, const QJsonObject& root, const QString& journalPath,
+                        const QString& generation);
 
     /// Forwarded from PersistenceIO, delivered on the main thread via
     /// QueuedConnection. Connect here to react to write outcome (e.g.
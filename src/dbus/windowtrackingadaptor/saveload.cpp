@@ -3,6 +3,7 @@
 
 #include "windowtrackingadaptor.h"
 #include "persistenceworker.h"
+#include "sessionjournal.h"
 #include <PhosphorSnapEngine/SnapEngine.h>
 #include "config/configbackends.h"
 #include "core/interfaces/interfaces.h"
@@ -26,6 +27,36 @@
 
 namespace PlasmaZones {
 
+namespace {
+
+// Compaction bounds for the session journal. Between compactions a save
+// appends only the keys and placement buckets it changed, so these cap both
+// replay cost on load and the journal's size relative to the snapshot it is
+// folded into — one full rewrite per this many records / bytes instead of
+// one per save.
+constexpr int JournalCompactRecords = 512;
+constexpr qint64 JournalCompactBytes = 256 * 1024;
+
+// A structured tracking value: the native JSON node, or — for a session.json
+// written before these keys were stored natively — the escaped string parsed
+// back into one.
+QJsonValue readStructured(const PhosphorConfig::IGroup& group, const QString& key)
+{
+    const QJsonValue value = group.readJson(key);
+    if (!value.isString()) {
+        return value;
+    }
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(value.toString().toUtf8(), &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        qCWarning(lcDbusWindow) << "Failed to parse saved" << key << ":" << parseError.errorString();
+        return {};
+    }
+    return doc.isArray() ? QJsonValue(doc.array()) : QJsonValue(doc.object());
+}
+
+} // namespace
+
 bool WindowTrackingAdaptor::isPersistedContextDisabled(const QString& screenId, int virtualDesktop,
                                                        const QString& activity) const
 {
@@ -80,11 +111,17 @@ void WindowTrackingAdaptor::saveState()
 
     auto tracking = m_sessionBackend->group(ConfigKeys::windowTrackingGroup());
 
+    // Every value written below also goes into this batch of SessionJournal
+    // records, which is all a non-compacting save puts on disk.
+    QByteArray journalBatch;
+
     // Save active layout ID so we can restore it after daemon restart.
     // Gated on DirtyActiveLayoutId — only rewrites when the layout manager
     // signal fired since the last save.
     if ((dirty & D::DirtyActiveLayoutId) && m_layoutManager && m_layoutManager->activeLayout()) {
-        tracking->writeString(ConfigKeys::activeLayoutIdKey(), m_layoutManager->activeLayout()->id().toString());
+        const QString layoutId = m_layoutManager->activeLayout()->id().toString();
+        tracking->writeString(ConfigKeys::activeLayoutIdKey(), layoutId);
+        journalBatch += SessionJournal::encodeKey(ConfigKeys::activeLayoutIdKey(), layoutId);
     }
 
     // Snap zone assignments and pending-restore queues are no longer persisted
@@ -98,7 +135,9 @@ void WindowTrackingAdaptor::saveState()
     // least one dirty bit is set (the DirtyNone early-return above
     // skips this path), so we always flush the deletions along with
     // the rest of the write. On subsequent saves the keys are already
-    // gone so deleteKey is a cheap no-op.
+    // gone so deleteKey is a cheap no-op. None of these deletions is
+    // journaled: the first save of a session always compacts (there is
+    // no journal generation yet), and that snapshot carries them.
     tracking->deleteKey(ConfigKeys::obsoletePendingWindowScreenAssignmentsKey());
     tracking->deleteKey(ConfigKeys::obsoletePendingWindowDesktopAssignmentsKey());
     tracking->deleteKey(ConfigKeys::obsoletePendingWindowLayoutAssignmentsKey());
@@ -116,6 +155,7 @@ void WindowTrackingAdaptor::saveState()
     // Save last used zone info (from service)
     if (dirty & D::DirtyLastUsedZone) {
         tracking->writeString(ConfigKeys::lastUsedZoneIdKey(), m_service->lastUsedZoneId());
+        journalBatch += SessionJournal::encodeKey(ConfigKeys::lastUsedZoneIdKey(), m_service->lastUsedZoneId());
         // lastUsedZoneClass, lastUsedScreenName, and lastUsedDesktop are
         // exposed on PhosphorPlacement::WindowTrackingService but are
         // intentionally NOT persisted here: each is a transient hint used
@@ -151,6 +191,7 @@ void WindowTrackingAdaptor::saveState()
             userSnappedArray.append(windowClass);
         }
         tracking->writeJson(ConfigKeys::userSnappedClassesKey(), userSnappedArray);
+        journalBatch += SessionJournal::encodeKey(ConfigKeys::userSnappedClassesKey(), userSnappedArray);
     }
 
     // Autotile window orders and pending restores are no longer persisted as
@@ -186,25 +227,62 @@ void WindowTrackingAdaptor::saveState()
         } else {
             tracking->deleteKey(ConfigKeys::windowPlacementsKey());
         }
+        // Only the appId buckets whose serialized form changed are journaled —
+        // one window moving rewrites its app's bucket, not every placement.
+        journalBatch += SessionJournal::encodePlacementDelta(m_persistedPlacements, placements);
+        m_persistedPlacements = placements;
+    }
+
+    // Journal or compact. A compaction rewrites the whole snapshot under a
+    // fresh generation and starts an empty journal; it is due when no
+    // journal is established yet (first save of the session, or loadState
+    // found none matching), after a failed write or a torn replay, once the
+    // journal outgrows its bounds, and on the synchronous shutdown save —
+    // which leaves nothing behind to replay.
+    auto* jsonBackend = dynamic_cast<PhosphorConfig::JsonBackend*>(m_sessionBackend.get());
+    const bool async = jsonBackend && m_persistenceWorker;
+    const int batchRecords = int(journalBatch.count('\n'));
+    const bool compact = jsonBackend
+        && (!async || m_journalGeneration.isEmpty() || m_journalCompactionDue
+            || m_journalRecords + batchRecords > JournalCompactRecords
+            || m_journalBytes + journalBatch.size() > JournalCompactBytes);
+    QString generation;
+    if (compact) {
+        generation = SessionJournal::newGeneration();
+        tracking->writeString(ConfigKeys::sessionJournalGenerationKey(), generation);
     }
 
     tracking.reset(); // release group before write
 
-    // Async I/O: snapshot the in-memory JSON root (COW copy) and hand off
-    // to the persistence worker thread. The main thread returns immediately.
-    // The dirty flag is cleared asynchronously when the worker's
-    // writeCompleted(success=true) signal lands (see ctor wiring) — so a
-    // failed write is retried on the next timer tick instead of silently
-    // losing state.
+    // Async I/O: hand the journal batch — or, when compacting, a snapshot of
+    // the in-memory JSON root (COW copy) — off to the persistence worker
+    // thread. The main thread returns immediately. The dirty flag is cleared
+    // asynchronously when the worker's writeCompleted(success=true) signal
+    // lands (see ctor wiring) — so a failed write is retried on the next
+    // timer tick instead of silently losing state.
     //
     // Push the committed mask onto the pending-writes FIFO at the exact
-    // hand-off point: the worker processes requestWrite signals in queued
+    // hand-off point: the worker processes appends and compactions in queued
     // order, so dequeueing from the head in writeCompleted correctly
     // matches masks to completions even with multiple writes in flight.
-    auto* jsonBackend = dynamic_cast<PhosphorConfig::JsonBackend*>(m_sessionBackend.get());
-    if (jsonBackend && m_persistenceWorker) {
-        m_pendingWriteMasks.enqueue(dirty);
-        m_persistenceWorker->enqueueWrite(jsonBackend->filePath(), jsonBackend->jsonRootSnapshot());
+    if (async) {
+        const QString journalPath = SessionJournal::journalPath(jsonBackend->filePath());
+        if (compact) {
+            m_pendingWriteMasks.enqueue(dirty);
+            m_persistenceWorker->enqueueCompact(jsonBackend->filePath(), jsonBackend->jsonRootSnapshot(), journalPath,
+                                                generation);
+            m_journalGeneration = generation;
+            m_journalRecords = 0;
+            m_journalBytes = 0;
+            m_journalCompactionDue = false;
+        } else if (!journalBatch.isEmpty()) {
+            m_pendingWriteMasks.enqueue(dirty);
+            m_persistenceWorker->enqueueAppend(journalPath, journalBatch);
+            m_journalRecords += batchRecords;
+            m_journalBytes += journalBatch.size();
+        }
+        // Otherwise the dirty fields serialized to what is already on disk
+        // (e.g. only filtered-out placements changed): nothing to write.
     } else {
         // Fallback synchronous path.
         //
@@ -227,11 +305,32 @@ void WindowTrackingAdaptor::saveState()
                                        "(expected for the one shutdown save and for unit tests with a memory backend)";
             m_syncFallbackWarned = true;
         }
-        m_sessionBackend->sync();
+        // A compaction must know the snapshot is on disk before it retires
+        // the journal: sync() may only have accepted the write (a debounced
+        // backend flushes later), and a crash in between would lose both.
+        const bool written = compact ? m_sessionBackend->commit() : m_sessionBackend->sync();
+        if (compact && written) {
+            // The snapshot now holds everything; retire the journal so its
+            // records are not replayed over the newer state.
+            if (SessionJournal::reset(SessionJournal::journalPath(jsonBackend->filePath()), generation)) {
+                m_journalGeneration = generation;
+                m_journalRecords = 0;
+                m_journalBytes = 0;
+                m_journalCompactionDue = false;
+            } else {
+                // The old journal stays, but its generation no longer
+                // matches the snapshot, so load ignores it. Compact again
+                // next time rather than append behind a stale header.
+                qCWarning(lcDbusWindow) << "saveState: failed to reset the session journal after compaction";
+                m_journalGeneration.clear();
+                m_journalCompactionDue = true;
+            }
+        }
     }
     qCInfo(lcDbusWindow) << "Saved state: dirty=" << Qt::hex << dirty << Qt::dec
                          << "placements=" << m_service->placementStore().size()
-                         << "userSnapped=" << userSnappedArray.size();
+                         << "userSnapped=" << userSnappedArray.size() << "compacted=" << compact
+                         << "journalRecords=" << m_journalRecords;
 }
 
 void WindowTrackingAdaptor::requestReapplyWindowGeometries()
@@ -265,11 +364,10 @@ void WindowTrackingAdaptor::saveStateOnShutdown()
 
 void WindowTrackingAdaptor::loadState()
 {
-    // Read config via the PhosphorConfig::IBackend group API (readString/readInt).
-    // This correctly handles values stored as native JSON objects/arrays
-    // (UserSnappedClasses, WindowPlacements) — the group's readString()
-    // serializes them back to compact JSON strings, so the same fromJson parse
-    // below also reads a pre-native session.json where these were escaped strings.
+    // Read config via the PhosphorConfig::IBackend group API. Structured values
+    // (UserSnappedClasses, WindowPlacements) come back as native JSON nodes
+    // through readJson(); readStructured() still parses the escaped strings of
+    // a pre-native session.json.
     //
     // The previous approach used readJsonConfigFromDisk() which flattened the
     // entire config into a QMap. Its flattener recursed into native JSON objects
@@ -285,6 +383,30 @@ void WindowTrackingAdaptor::loadState()
         return tracking->readString(key, def);
     };
 
+    // Replay the session journal over the snapshot before anything is read,
+    // so every value below is the latest one persisted. Only a journal of the
+    // snapshot's own generation applies — see SessionJournal.
+    m_journalGeneration.clear();
+    m_journalRecords = 0;
+    m_journalBytes = 0;
+    m_journalCompactionDue = false;
+    if (auto* jsonBackend = dynamic_cast<PhosphorConfig::JsonBackend*>(m_sessionBackend.get())) {
+        const SessionJournal::Replay replay =
+            SessionJournal::replay(SessionJournal::journalPath(jsonBackend->filePath()), *tracking);
+        if (replay.applied) {
+            m_journalGeneration = replay.generation;
+            m_journalRecords = int(replay.records.size());
+            m_journalBytes = replay.validBytes;
+            // Appending after a torn tail would glue the next record onto
+            // the fragment; compact it away on the first save instead.
+            m_journalCompactionDue = replay.isTorn();
+            qCInfo(lcDbusWindow) << "Replayed session journal: records=" << replay.records.size()
+                                 << "torn=" << replay.isTorn();
+        } else if (replay.fileBytes > 0) {
+            qCDebug(lcDbusWindow) << "Ignoring session journal of another generation:" << replay.generation;
+        }
+    }
+
     // Snap zone assignments and pending-restore queues are no longer loaded from
     // disk — the unified WindowPlacementStore (loaded below) is the sole source of
     // per-window restore state. resolveWindowRestore re-commits snapped records into
@@ -315,16 +437,10 @@ void WindowTrackingAdaptor::loadState()
 
     // Load user-snapped classes
     QSet<QString> userSnappedClasses;
-    QString userSnappedJson = readVal(ConfigKeys::userSnappedClassesKey(), QString());
-    if (!userSnappedJson.isEmpty()) {
-        QJsonDocument doc = QJsonDocument::fromJson(userSnappedJson.toUtf8());
-        if (doc.isArray()) {
-            QJsonArray arr = doc.array();
-            for (const QJsonValue& val : arr) {
-                if (val.isString()) {
-                    userSnappedClasses.insert(val.toString());
-                }
-            }
+    const QJsonArray userSnappedArray = readStructured(*tracking, ConfigKeys::userSnappedClassesKey()).toArray();
+    for (const QJsonValue& val : userSnappedArray) {
+        if (val.isString()) {
+            userSnappedClasses.insert(val.toString());
         }
     }
     m_service->setUserSnappedClasses(userSnappedClasses);
@@ -335,17 +451,11 @@ void WindowTrackingAdaptor::loadState()
 
     // Restore the unified WindowPlacementStore — the single source of truth for
     // per-window restore state.
-    {
-        const QString placementsStr = readVal(ConfigKeys::windowPlacementsKey(), QString());
-        if (!placementsStr.isEmpty()) {
-            QJsonParseError parseError;
-            const QJsonDocument doc = QJsonDocument::fromJson(placementsStr.toUtf8(), &parseError);
-            if (parseError.error == QJsonParseError::NoError && doc.isObject()) {
-                m_service->placementStore().deserialize(doc.object());
-            } else {
-                qCWarning(lcDbusWindow) << "Failed to parse saved window placements:" << parseError.errorString();
-            }
-        }
+    // m_persistedPlacements keeps the on-disk form as the baseline the next
+    // save's journal delta is computed against.
+    m_persistedPlacements = readStructured(*tracking, ConfigKeys::windowPlacementsKey()).toObject();
+    if (!m_persistedPlacements.isEmpty()) {
+        m_service->placementStore().deserialize(m_persistedPlacements);
     }
 
     // No engine float-back cache to re-seed: the unified record's freeGeometryByScreen
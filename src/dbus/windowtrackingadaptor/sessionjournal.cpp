@@ -0,0 +1,198 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "sessionjournal.h"
+
+#include "config/configkeys.h"
+#include "core/platform/logging.h"
+
+#include <PhosphorConfig/IBackend.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QRandomGenerator>
+#include <QSaveFile>
+
+namespace PlasmaZones {
+
+namespace {
+
+const QString kGenerationField = QStringLiteral("g");
+const QString kKeyField = QStringLiteral("k");
+const QString kPlacementField = QStringLiteral("p");
+const QString kValueField = QStringLiteral("v");
+
+QByteArray encodeLine(const QJsonObject& record)
+{
+    return QJsonDocument(record).toJson(QJsonDocument::Compact) + '\n';
+}
+
+bool isWellFormedRecord(const QJsonObject& record)
+{
+    const QJsonValue value = record.value(kValueField);
+    if (record.value(kKeyField).isString()) {
+        return true;
+    }
+    return record.value(kPlacementField).isString() && (value.isArray() || value.isNull());
+}
+
+} // namespace
+
+QString SessionJournal::journalPath(const QString& snapshotPath)
+{
+    return snapshotPath + QStringLiteral(".journal");
+}
+
+QString SessionJournal::newGeneration()
+{
+    return QString::number(QRandomGenerator::global()->generate64(), 16);
+}
+
+QByteArray SessionJournal::encodeHeader(const QString& generation)
+{
+    return encodeLine(QJsonObject{{kGenerationField, generation}});
+}
+
+QByteArray SessionJournal::encodeKey(const QString& key, const QJsonValue& value)
+{
+    return encodeLine(QJsonObject{{kKeyField, key}, {kValueField, value.isUndefined() ? QJsonValue() : value}});
+}
+
+QByteArray SessionJournal::encodePlacements(const QString& appId, const QJsonArray& records)
+{
+    return encodeLine(
+        QJsonObject{{kPlacementField, appId}, {kValueField, records.isEmpty() ? QJsonValue() : QJsonValue(records)}});
+}
+
+QByteArray SessionJournal::encodePlacementDelta(const QJsonObject& before, const QJsonObject& after)
+{
+    QByteArray out;
+    for (auto it = after.constBegin(); it != after.constEnd(); ++it) {
+        if (before.value(it.key()) != it.value()) {
+            out += encodePlacements(it.key(), it.value().toArray());
+        }
+    }
+    for (auto it = before.constBegin(); it != before.constEnd(); ++it) {
+        if (!after.contains(it.key())) {
+            out += encodePlacements(it.key(), {});
+        }
+    }
+    return out;
+}
+
+SessionJournal::Replay SessionJournal::read(const QString& path)
+{
+    Replay replay;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return replay;
+    }
+    const QByteArray bytes = file.readAll();
+    replay.fileBytes = bytes.size();
+
+    qsizetype pos = 0;
+    bool header = true;
+    while (pos < bytes.size()) {
+        const qsizetype end = bytes.indexOf('\n', pos);
+        if (end < 0) {
+            break; // unterminated: the append was cut short
+        }
+        QJsonParseError error;
+        const QJsonDocument doc = QJsonDocument::fromJson(bytes.sliced(pos, end - pos), &error);
+        if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+            break;
+        }
+        const QJsonObject record = doc.object();
+        if (header) {
+            if (!record.value(kGenerationField).isString()) {
+                break;
+            }
+            replay.generation = record.value(kGenerationField).toString();
+            header = false;
+        } else {
+            if (!isWellFormedRecord(record)) {
+                break;
+            }
+            replay.records.append(record);
+        }
+        pos = end + 1;
+        replay.validBytes = pos;
+    }
+    if (replay.isTorn()) {
+        qCWarning(lcDbusWindow) << "SessionJournal: discarding" << (replay.fileBytes - replay.validBytes)
+                                << "trailing bytes of" << path;
+    }
+    return replay;
+}
+
+void SessionJournal::apply(const QList<QJsonObject>& records, PhosphorConfig::IGroup& tracking)
+{
+    const QString placementsKey = ConfigKeys::windowPlacementsKey();
+    // Placement records are folded into one object and written back once, so
+    // replaying N bucket records costs one group write rather than N.
+    QJsonObject placements;
+    bool placementsLoaded = false;
+    bool placementsChanged = false;
+    for (const QJsonObject& record : records) {
+        const QJsonValue value = record.value(kValueField);
+        if (record.contains(kKeyField)) {
+            const QString key = record.value(kKeyField).toString();
+            if (value.isNull()) {
+                tracking.deleteKey(key);
+            } else if (value.isString()) {
+                tracking.writeString(key, value.toString());
+            } else {
+                tracking.writeJson(key, value);
+            }
+            continue;
+        }
+        if (!placementsLoaded) {
+            placements = tracking.readJson(placementsKey).toObject();
+            placementsLoaded = true;
+        }
+        const QString appId = record.value(kPlacementField).toString();
+        if (value.isNull()) {
+            placements.remove(appId);
+        } else {
+            placements.insert(appId, value);
+        }
+        placementsChanged = true;
+    }
+    if (placementsChanged) {
+        if (placements.isEmpty()) {
+            tracking.deleteKey(placementsKey);
+        } else {
+            tracking.writeJson(placementsKey, placements);
+        }
+    }
+}
+
+SessionJournal::Replay SessionJournal::replay(const QString& path, PhosphorConfig::IGroup& tracking)
+{
+    Replay out = read(path);
+    const QString snapshotGeneration = tracking.readString(ConfigKeys::sessionJournalGenerationKey());
+    if (snapshotGeneration.isEmpty() || out.generation != snapshotGeneration) {
+        return out;
+    }
+    apply(out.records, tracking);
+    out.applied = true;
+    return out;
+}
+
+bool SessionJournal::reset(const QString& path, const QString& generation)
+{
+    if (!QDir().mkpath(QFileInfo(path).absolutePath())) {
+        return false;
+    }
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(lcDbusWindow) << "SessionJournal: cannot open" << path << file.errorString();
+        return false;
+    }
+    file.write(encodeHeader(generation));
+    return file.commit();
+}
+
+} // namespace PlasmaZones
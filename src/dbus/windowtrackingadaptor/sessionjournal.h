@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "plasmazones_export.h"
+#include <QByteArray>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QList>
+#include <QString>
+
+namespace PhosphorConfig {
+class IGroup;
+}
+
+namespace PlasmaZones {
+
+/**
+ * @brief Append-only delta log that sits next to session.json.
+ *
+ * saveState() used to rewrite the whole session file on every debounced
+ * change. With the journal it appends only what changed since the last
+ * persisted state — one NDJSON line per written key and one per
+ * WindowPlacementStore appId bucket — and the full snapshot is rewritten
+ * ("compacted") only once the journal grows past a bound.
+ *
+ * File layout: a header line `{"g":"<generation>"}` followed by records
+ * `{"k":key,"v":value}` (a tracking-group key; null value = deleted) and
+ * `{"p":appId,"v":[records]}` (one placement bucket; null = bucket dropped).
+ *
+ * Crash consistency rests on two rules:
+ *   - Every record is a full overwrite of its key / bucket, so replay is
+ *     idempotent and a record that made it to disk is either wholly applied
+ *     or, if torn, dropped together with everything after it.
+ *   - Compaction stamps a fresh random generation into the snapshot before
+ *     writing it, then replaces the journal with an empty one carrying the
+ *     same generation. A journal whose header does not match the snapshot
+ *     predates it (a crash between the two steps, or a session.json removed
+ *     by Settings::reset) and is ignored on load.
+ */
+class PLASMAZONES_EXPORT SessionJournal
+{
+public:
+    /// Result of reading a journal file back.
+    struct Replay
+    {
+        QString generation; ///< header generation; empty if missing/unreadable
+        QList<QJsonObject> records; ///< well-formed records, in append order
+        qint64 validBytes = 0; ///< bytes up to the end of the last good record
+        qint64 fileBytes = 0; ///< total file size
+        bool applied = false; ///< set by replay(): generation matched, records applied
+
+        /// True when trailing bytes were discarded (torn or garbled tail).
+        bool isTorn() const
+        {
+            return validBytes < fileBytes;
+        }
+    };
+
+    /// `<snapshotPath>.journal`.
+    static QString journalPath(const QString& snapshotPath);
+
+    /// A fresh, practically unique generation id.
+    static QString newGeneration();
+
+    static QByteArray encodeHeader(const QString& generation);
+    /// An undefined/null @p value records a deletion.
+    static QByteArray encodeKey(const QString& key, const QJsonValue& value);
+    /// An empty @p records array records the bucket being dropped.
+    static QByteArray encodePlacements(const QString& appId, const QJsonArray& records);
+
+    /// Diff two WindowPlacementStore::serialize() results bucket by bucket and
+    /// encode one placement record per appId whose content changed.
+    static QByteArray encodePlacementDelta(const QJsonObject& before, const QJsonObject& after);
+
+    /// Read @p path, stopping at the first line that is unterminated or does
+    /// not parse as a record. A missing file yields an empty Replay.
+    static Replay read(const QString& path);
+
+    /// Apply @p records to the WindowTracking group. Placement records are
+    /// merged into the WindowPlacements object.
+    static void apply(const QList<QJsonObject>& records, PhosphorConfig::IGroup& tracking);
+
+    /// Load-side entry point: read the journal at @p path and apply it to
+    /// @p tracking if its generation matches the one the snapshot in
+    /// @p tracking was compacted with. A stale journal is left untouched and
+    /// reported with applied = false.
+    static Replay replay(const QString& path, PhosphorConfig::IGroup& tracking);
+
+    /// Atomically replace @p path with an empty journal of @p generation.
+    static bool reset(const QString& path, const QString& generation);
+};
+
+} // namespace PlasmaZones
@@ -148,6 +148,9 @@ WindowTrackingAdaptor::WindowTrackingAdaptor(PhosphorZones::LayoutRegistry* layo
                 if (!success) {
                     qCWarning(lcDbusWindow) << "session state write failed for" << filePath
                                             << "— restoring dirty mask and retrying on next tick";
+                    // The placement baseline already moved past what reached
+                    // disk, so a delta retry could miss it; snapshot instead.
+                    m_journalCompactionDue = true;
                     if (m_service && committed != PhosphorPlacement::WindowTrackingService::DirtyNone) {
                         // markDirty emits stateChanged, which is wired to
                         // scheduleSaveState() above — the retry lands on
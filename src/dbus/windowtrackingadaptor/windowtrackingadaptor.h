@@ -26,6 +26,7 @@
 #include <QHash>
 #include <QVariantMap>
 #include <QJsonArray>
+#include <QJsonObject>
 #include <QQueue>
 #include <QRect>
 #include <QTimer>
@@ -1376,6 +1377,19 @@ private:
     // harness or an unexpected misconfiguration.
     bool m_syncFallbackWarned = false;
 
+    // Session journal bookkeeping (see SessionJournal). m_journalGeneration is
+    // the generation appends currently land in — empty until a compaction or
+    // a matching journal found by loadState() establishes one, which makes
+    // the next save compact. m_persistedPlacements is the placement object as
+    // it stands on disk (snapshot + journal): the baseline the next save
+    // diffs against. The counters size the journal against the compaction
+    // bounds in saveload.cpp.
+    QString m_journalGeneration;
+    QJsonObject m_persistedPlacements;
+    qint64 m_journalBytes = 0;
+    int m_journalRecords = 0;
+    bool m_journalCompactionDue = false;
+
     // ═══════════════════════════════════════════════════════════════════════════════
     // Startup timing coordination
     // ═══════════════════════════════════════════════════════════════════════════════
@@ -26,9 +26,17 @@
 //     passes, and the shared vertex stage on the daemon Qt-RHI path — see
 //     validateSurfacePack.
 //
+// Every bake goes through ShaderCompiler, so validating doubles as a cache
+// warm-up: --prebake <datadir> points the shader disk cache at
+// <datadir>/phosphor-shadercache, the read-only tier the runtime consults after
+// the user cache, and is what the PLASMAZONES_PREBAKE_SHADERS install step runs.
+// --jobs N validates N packs at once; it defaults to the shader-bake worker
+// count, since bakes only run in parallel when they go to helper processes.
+//
 // Usage:
 //   plasmazones-shader-validate [--quiet] [--overlay|--animation|--surface]
-//                               [--emit-preamble] [--] <path> [<path> ...]
+//                               [--emit-preamble] [--prebake <datadir>]
+//                               [--jobs N] [--] <path> [<path> ...]
 // where each <path> is either a pack directory (contains metadata.json) or a
 // root that holds pack subdirectories. Exits non-zero if any pack has an error.
 
@@ -36,6 +44,7 @@
 
 #include <PhosphorAnimation/AnimationShaderEffect.h>
 #include <PhosphorAnimation/AnimationShaderRegistry.h>
+#include <PhosphorRendering/ShaderBakeService.h>
 #include <PhosphorShaders/ShaderIncludeResolver.h>
 #include <PhosphorShaders/ShaderRegistry.h>
 #include <PhosphorSurface/SurfaceShaderEffect.h>
@@ -49,6 +58,8 @@
 #include <QString>
 #include <QStringList>
 #include <QTextStream>
+#include <QThreadPool>
+#include <QtConcurrent>
 
 using PhosphorAnimationShaders::AnimationShaderEffect;
 using PhosphorAnimationShaders::AnimationShaderRegistry;
@@ -181,6 +192,11 @@ int main(int argc, char** argv)
     // --emit-preamble: don't validate — write each pack's `p_<id>` autocomplete
     // sidecar (T2.2) for editor tooling.
     bool emitMode = false;
+    // --prebake <datadir>: write bakes to <datadir>/phosphor-shadercache
+    // instead of the user's cache dir.
+    QString prebakeDir;
+    // --jobs/-j N: packs validated concurrently (0 = bake-worker count).
+    int jobs = 0;
     bool endOfOptions = false;
     for (int i = 1; i < argc; ++i) {
         const QString a = QString::fromLocal8Bit(argv[i]);
@@ -205,17 +221,35 @@ int main(int argc, char** argv)
             surfaceMode = false;
         } else if (a == QLatin1String("--emit-preamble")) {
             emitMode = true;
+        } else if (a == QLatin1String("--prebake") || a == QLatin1String("--jobs") || a == QLatin1String("-j")) {
+            if (i + 1 >= argc) {
+                errStream << a << " needs an argument\n";
+                return 2;
+            }
+            const QString value = QString::fromLocal8Bit(argv[++i]);
+            if (a == QLatin1String("--prebake")) {
+                prebakeDir = QFileInfo(value).absoluteFilePath();
+            } else {
+                bool ok = false;
+                jobs = value.toInt(&ok);
+                if (!ok || jobs < 1) {
+                    errStream << "--jobs expects a positive number, got " << value << "\n";
+                    return 2;
+                }
+            }
         } else {
             args << a;
         }
     }
     if (args.isEmpty()) {
         errStream << "usage: plasmazones-shader-validate [--quiet] [--overlay|--animation|--surface] "
-                     "[--emit-preamble] [--] <pack-dir-or-root> [...]\n"
+                     "[--emit-preamble] [--prebake <datadir>] [--jobs N] [--] <pack-dir-or-root> [...]\n"
                   << "  --overlay         zone/overlay packs (data/overlays/*)        [default]\n"
                   << "  --animation       transition/animation packs (data/animations/*)\n"
                   << "  --surface         surface-layer packs (data/surface/*)\n"
-                  << "  --emit-preamble   write each pack's p_generated.glsl autocomplete sidecar (no validation)\n";
+                  << "  --emit-preamble   write each pack's p_generated.glsl autocomplete sidecar (no validation)\n"
+                  << "  --prebake <dir>   store baked shaders in <dir>/phosphor-shadercache (system cache tier)\n"
+                  << "  -j, --jobs N      validate N packs concurrently [default: shader-bake worker count]\n";
         return 2;
     }
 
@@ -263,22 +297,42 @@ int main(int argc, char** argv)
         return 0;
     }
 
+    // Must be set before the first compile: ShaderCompiler resolves its cache
+    // directory once, and bake workers inherit it from our environment.
+    if (!prebakeDir.isEmpty()) {
+        qputenv("PHOSPHOR_SHADER_CACHE_DIR", QFile::encodeName(prebakeDir));
+    }
+
+    // Packs validate independently, each into its own report; reports are
+    // printed afterwards in pack order so -j output matches a serial run.
+    struct PackReport
+    {
+        QString text;
+        int errors = 0;
+    };
+    const auto validateOne = [animationMode, surfaceMode](const QString& pack) {
+        PackReport r;
+        QTextStream reportStream(&r.text);
+        r.errors = surfaceMode ? validateSurfacePack(pack, reportStream)
+            : animationMode    ? validateAnimationPack(pack, reportStream)
+                               : validatePack(pack, reportStream);
+        reportStream.flush();
+        return r;
+    };
+    QThreadPool pool;
+    pool.setMaxThreadCount(jobs > 0 ? jobs : PhosphorRendering::ShaderBakeService::parallelism());
+    const QList<PackReport> reports = QtConcurrent::blockingMapped<QList<PackReport>>(&pool, packs, validateOne);
+
     int totalErrors = 0;
     int failedPacks = 0;
-    for (const QString& pack : packs) {
-        QString report;
-        QTextStream reportStream(&report);
-        const int e = surfaceMode ? validateSurfacePack(pack, reportStream)
-            : animationMode       ? validateAnimationPack(pack, reportStream)
-                                  : validatePack(pack, reportStream);
-        reportStream.flush();
-        totalErrors += e;
-        if (e > 0) {
+    for (const PackReport& r : reports) {
+        totalErrors += r.errors;
+        if (r.errors > 0) {
             ++failedPacks;
         }
         // In quiet mode only failing packs are printed — the rest is summarized.
-        if (!quiet || e > 0) {
-            out << report;
+        if (!quiet || r.errors > 0) {
+            out << r.text;
         }
     }
     out.flush();
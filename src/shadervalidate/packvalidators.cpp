@@ -15,6 +15,7 @@
 #include <PhosphorAnimation/AnimationShaderRegistry.h>
 #include <PhosphorAnimation/ProfilePaths.h>
 #include <PhosphorRendering/ShaderCompiler.h>
+#include <PhosphorRendering/ZoneShaderNodeRhi.h>
 #include <PhosphorShaders/CustomParamsKey.h>
 #include <PhosphorShaders/ShaderEntryPoint.h>
 #include <PhosphorShaders/ShaderParamPreamble.h>
@@ -292,6 +293,13 @@ int validatePack(const QString& packDir, QTextStream& out)
         // tracks the real file rather than assuming effect.frag.
         errors += compileStage(out, QFileInfo(info.sourcePath).fileName(), info.sourcePath, QShader::FragmentStage,
                                includePaths, /*useScaffold=*/true, preamble, info);
+        // Again as a storage-mode ZoneShaderNodeRhi builds it on Vulkan, with
+        // the zone arrays read from storage buffers. Checked regardless of
+        // backend: CI has none to ask, and --prebake must fill the cache with
+        // the variant a Vulkan session will look up.
+        errors += compileStage(out, QStringLiteral("storage"), info.sourcePath, QShader::FragmentStage,
+                               includePaths, /*useScaffold=*/true,
+                               PhosphorRendering::ZoneShaderNodeRhi::zoneStorageDefines() + preamble, info);
     }
     // Only multipass packs bake buffer passes — parseShaderMetadata clears
     // buffer state for single-pass packs and only keeps an implicit
@@ -186,6 +186,96 @@ private Q_SLOTS:
 
         QCOMPARE(tilingSpy.count(), 0);
     }
+
+    // =========================================================================
+    // Per-screen zone cache: unchanged input skips the algorithm
+    // =========================================================================
+
+    void testRetile_unchangedInput_hitsZoneCache()
+    {
+        AutotileEngine engine(nullptr, nullptr, nullptr, PlasmaZones::TestHelpers::testRegistry());
+        const QString screenName = QStringLiteral("TestScreen");
+
+        QSet<QString> screens{screenName};
+        engine.setAutotileScreens(screens);
+        engine.windowOpened(QStringLiteral("win-cache-1"), screenName, 0, 0);
+        engine.windowOpened(QStringLiteral("win-cache-2"), screenName, 0, 0);
+        QCoreApplication::processEvents();
+
+        // Settle once so currentGeometries carries the applied layout.
+        engine.retile(screenName);
+        const QVector<QRect> zones = engine.tilingStateForScreen(screenName)->calculatedZones();
+        QCOMPARE(zones.size(), 2);
+
+        const auto before = engine.zoneCacheStats();
+        engine.retile(screenName);
+        engine.retile(screenName);
+        QCOMPARE(engine.zoneCacheStats().hits, before.hits + 2);
+        QCOMPARE(engine.zoneCacheStats().misses, before.misses);
+        QCOMPARE(engine.tilingStateForScreen(screenName)->calculatedZones(), zones);
+    }
+
+    void testRetile_changedInput_missesZoneCache()
+    {
+        AutotileEngine engine(nullptr, nullptr, nullptr, PlasmaZones::TestHelpers::testRegistry());
+        const QString screenName = QStringLiteral("TestScreen");
+
+        QSet<QString> screens{screenName};
+        engine.setAutotileScreens(screens);
+        engine.windowOpened(QStringLiteral("win-cache-1"), screenName, 0, 0);
+        engine.windowOpened(QStringLiteral("win-cache-2"), screenName, 0, 0);
+        QCoreApplication::processEvents();
+        engine.retile(screenName);
+
+        // The split ratio is part of the key whether or not the algorithm
+        // happens to use it, so the next retile must call the algorithm.
+        PhosphorTiles::TilingState* state = engine.tilingStateForScreen(screenName);
+        const auto before = engine.zoneCacheStats();
+        state->setSplitRatio(state->splitRatio() == 0.7 ? 0.4 : 0.7);
+        QCoreApplication::processEvents();
+        engine.retile(screenName);
+        QVERIFY(engine.zoneCacheStats().misses > before.misses);
+
+        // A new window changes the input too.
+        const auto beforeOpen = engine.zoneCacheStats();
+        engine.windowOpened(QStringLiteral("win-cache-3"), screenName, 0, 0);
+        QCoreApplication::processEvents();
+        QVERIFY(engine.zoneCacheStats().misses > beforeOpen.misses);
+        QCOMPARE(state->calculatedZones().size(), 3);
+    }
+
+    void testRetile_changeMissesOnce_focusOnlyHits()
+    {
+        // The default algorithm reads neither focus nor ctx.currentGeometries,
+        // so neither may leak into its cache key.
+        AutotileEngine engine(nullptr, nullptr, nullptr, PlasmaZones::TestHelpers::testRegistry());
+        const QString screenName = QStringLiteral("TestScreen");
+
+        QSet<QString> screens{screenName};
+        engine.setAutotileScreens(screens);
+        engine.windowOpened(QStringLiteral("win-cache-1"), screenName, 0, 0);
+        engine.windowOpened(QStringLiteral("win-cache-2"), screenName, 0, 0);
+        QCoreApplication::processEvents();
+        engine.retile(screenName);
+
+        // A change is one miss. The retile after it sees its own output as
+        // currentGeometries, which must not count as another change.
+        PhosphorTiles::TilingState* state = engine.tilingStateForScreen(screenName);
+        state->setSplitRatio(state->splitRatio() == 0.7 ? 0.4 : 0.7);
+        QCoreApplication::processEvents();
+        engine.retile(screenName);
+        const auto afterChange = engine.zoneCacheStats();
+        engine.retile(screenName);
+        QCOMPARE(engine.zoneCacheStats().misses, afterChange.misses);
+        QCOMPARE(engine.zoneCacheStats().hits, afterChange.hits + 1);
+
+        // Moving focus between tiled windows changes nothing this layout sees.
+        engine.setFocusedWindow(QStringLiteral("win-cache-2"));
+        QCoreApplication::processEvents();
+        const auto afterFocus = engine.zoneCacheStats();
+        engine.retile(screenName);
+        QCOMPARE(engine.zoneCacheStats().misses, afterFocus.misses);
+    }
 };
 
 QTEST_MAIN(TestAutotileEngineRetry)
@@ -14,6 +14,8 @@
  * - Unsatisfiable constraints (proportional fallback)
  * - Size mismatch early-return guard
  * - Gap threshold adjacency detection
+ * - Non-grid arrangements (misaligned row dividers, spanning zones) and
+ *   repeated applies while a divider is dragged
  */
 
 #include <QTest>
@@ -303,6 +305,78 @@ private Q_SLOTS:
                      qPrintable(QStringLiteral("Zone[%1] width = %2, must be > 0").arg(i).arg(zones[i].width())));
         }
     }
+
+    void test_nonGrid_misalignedRows()
+    {
+        // Top row split at 500, bottom row at 700: no column model fits, so
+        // this used to fall through to pairwise stealing.
+        QVector<QRect> zones = {
+            QRect(0, 0, 500, 500),
+            QRect(500, 0, 500, 500),
+            QRect(0, 500, 700, 500),
+            QRect(700, 500, 300, 500),
+        };
+        const QVector<QSize> minSizes = {QSize(), QSize(), QSize(800, 1), QSize()};
+
+        GeometryUtils::enforceMinSizes(zones, minSizes, 5);
+
+        QVERIFY2(zones[2].width() >= 800,
+                 qPrintable(QStringLiteral("Zone[2] width = %1, expected >= 800").arg(zones[2].width())));
+        QCOMPARE(zones[3].left() + zones[3].width(), 1000);
+        // The top row's divider is independent of the bottom one.
+        QCOMPARE(zones[0], QRect(0, 0, 500, 500));
+        QCOMPARE(zones[1], QRect(500, 0, 500, 500));
+    }
+
+    void test_nonGrid_spanningZoneKeepsItsEdges()
+    {
+        // Three columns above one full-width zone: the middle column needs
+        // room, and only the dividers it shares with its row may move.
+        QVector<QRect> zones = {
+            QRect(0, 0, 300, 500),
+            QRect(300, 0, 300, 500),
+            QRect(600, 0, 300, 500),
+            QRect(0, 500, 900, 500),
+        };
+        const QVector<QSize> minSizes = {QSize(), QSize(500, 1), QSize(), QSize()};
+
+        GeometryUtils::enforceMinSizes(zones, minSizes, 5);
+
+        QVERIFY(zones[1].width() >= 500);
+        QVERIFY(zones[0].width() >= 50);
+        QVERIFY(zones[2].width() >= 50);
+        QCOMPARE(zones[0].left(), 0);
+        QCOMPARE(zones[2].left() + zones[2].width(), 900);
+        QCOMPARE(zones[3], QRect(0, 500, 900, 500));
+        for (int i = 0; i < zones.size(); ++i) {
+            for (int j = i + 1; j < zones.size(); ++j) {
+                QVERIFY2(!zones[i].intersects(zones[j]),
+                         qPrintable(QStringLiteral("Zones %1 and %2 overlap").arg(i).arg(j)));
+            }
+        }
+    }
+
+    void test_nonGrid_dividerDrag()
+    {
+        // Re-applying one arrangement with the top divider at successive
+        // positions: every frame must honour the bottom-left minimum and
+        // leave the dragged divider where the user put it.
+        const QVector<QSize> minSizes = {QSize(), QSize(), QSize(800, 1), QSize()};
+        for (int x = 450; x <= 650; x += 25) {
+            QVector<QRect> zones = {
+                QRect(0, 0, x, 500),
+                QRect(x, 0, 1000 - x, 500),
+                QRect(0, 500, 700, 500),
+                QRect(700, 500, 300, 500),
+            };
+
+            GeometryUtils::enforceMinSizes(zones, minSizes, 5);
+
+            QCOMPARE(zones[0].width(), x);
+            QCOMPARE(zones[2].width(), 800);
+            QCOMPARE(zones[3].width(), 200);
+        }
+    }
 };
 
 QTEST_MAIN(TestGeometryUtilsMinSizes)
@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file test_zone_spatial_index.cpp
+ * @brief Unit tests for PhosphorZones::ZoneSpatialIndex and its use by ZoneDetector
+ *
+ * The index must be a drop-in for the linear scans it replaces: every query is
+ * checked against the equivalent Layout method over a dense grid with a
+ * background zone overlapping it, and the detector must rebuild the index when
+ * the zone set or the absolute geometry changes underneath it.
+ */
+
+#include <QTest>
+#include <QRectF>
+#include <QPointF>
+#include <QVector>
+
+#include <PhosphorZones/Layout.h>
+#include <PhosphorZones/LayoutComputeService.h>
+#include <PhosphorZones/Zone.h>
+#include <PhosphorZones/ZoneDetector.h>
+#include <PhosphorZones/ZoneSpatialIndex.h>
+
+class TestZoneSpatialIndex : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init()
+    {
+        m_layout = new PhosphorZones::Layout(QStringLiteral("SpatialIndexTest"), nullptr);
+    }
+
+    void cleanup()
+    {
+        delete m_layout;
+        m_layout = nullptr;
+    }
+
+    void testEmptyIndex()
+    {
+        PhosphorZones::ZoneSpatialIndex index;
+        index.rebuild({}, 10);
+        QVERIFY(index.isEmpty());
+        QCOMPARE(index.zoneAtPoint(QPointF(5, 5)), nullptr);
+        QCOMPARE(index.nearestZone(QPointF(5, 5)), nullptr);
+        QVERIFY(index.zonesNear(QPointF(5, 5), 100).isEmpty());
+    }
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Parity with the linear Layout scans on a dense 8x8 grid with gaps and
+    // a background zone underneath the top-left quadrant
+    // ═══════════════════════════════════════════════════════════════════════
+
+    void testQueriesMatchLinearScan()
+    {
+        buildGrid(8, 8, 0.004);
+        auto* background = new PhosphorZones::Zone(m_layout);
+        background->setRelativeGeometry(QRectF(0.0, 0.0, 0.5, 0.5));
+        m_layout->addZone(background);
+        PhosphorZones::LayoutComputeService::recalculateSync(m_layout, QRectF(0, 0, 7680, 4320));
+
+        PhosphorZones::ZoneSpatialIndex index;
+        index.rebuild(m_layout->zones(), 10);
+        QCOMPARE(index.zoneCount(), 65);
+
+        // Sweep inside, on gaps, and well outside the screen
+        for (qreal y = -500; y <= 4820; y += 97) {
+            for (qreal x = -500; x <= 8180; x += 113) {
+                const QPointF p(x, y);
+                QCOMPARE(index.zoneAtPoint(p), m_layout->zoneAtPoint(p));
+                QCOMPARE(index.nearestZone(p), m_layout->nearestZone(p));
+                QCOMPARE(index.zonesNear(p, 10), m_layout->adjacentZones(p, 10));
+            }
+        }
+
+        const QRectF probe(1000, 700, 1500, 900);
+        QCOMPARE(index.zonesIntersecting(probe), m_layout->zonesInRect(probe));
+    }
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Adjacency graph: edge-sharing only, corners excluded
+    // ═══════════════════════════════════════════════════════════════════════
+
+    void testNeighboursInGrid()
+    {
+        const QVector<PhosphorZones::Zone*> zones = buildGrid(3, 3, 0.0);
+        PhosphorZones::LayoutComputeService::recalculateSync(m_layout, QRectF(0, 0, 900, 900));
+
+        PhosphorZones::ZoneSpatialIndex index;
+        index.rebuild(m_layout->zones(), 5);
+
+        // Row-major: zones[4] is the centre cell
+        const QVector<PhosphorZones::Zone*> centre = index.neighbours(zones[4]);
+        QCOMPARE(centre, (QVector<PhosphorZones::Zone*>{zones[1], zones[3], zones[5], zones[7]}));
+        QCOMPARE(index.neighbours(zones[0]), (QVector<PhosphorZones::Zone*>{zones[1], zones[3]}));
+
+        QVERIFY(index.areAdjacent(zones[0], zones[1]));
+        QVERIFY(!index.areAdjacent(zones[0], zones[4]));
+        QVERIFY(!index.areAdjacent(zones[0], zones[0]));
+        QVERIFY(!index.areAdjacent(zones[0], nullptr));
+    }
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // ZoneDetector invalidation
+    // ═══════════════════════════════════════════════════════════════════════
+
+    void testDetectorRebuildsOnGeometryChange()
+    {
+        auto* zone = new PhosphorZones::Zone(m_layout);
+        zone->setRelativeGeometry(QRectF(0.0, 0.0, 0.5, 1.0));
+        m_layout->addZone(zone);
+        PhosphorZones::LayoutComputeService::recalculateSync(m_layout, QRectF(0, 0, 1000, 1000));
+
+        PhosphorZones::ZoneDetector detector;
+        detector.setLayout(m_layout);
+        QCOMPARE(detector.zoneAtPoint(QPointF(250, 500)), zone);
+        QCOMPARE(detector.zoneAtPoint(QPointF(2250, 500)), nullptr);
+
+        // Same layout moved to a second monitor: the absolute rects change
+        // and the detector must not answer from the stale grid.
+        PhosphorZones::LayoutComputeService::recalculateSync(m_layout, QRectF(2000, 0, 1000, 1000));
+        QCOMPARE(detector.zoneAtPoint(QPointF(250, 500)), nullptr);
+        QCOMPARE(detector.zoneAtPoint(QPointF(2250, 500)), zone);
+    }
+
+    void testDetectorRebuildsOnZoneAdded()
+    {
+        auto* left = new PhosphorZones::Zone(m_layout);
+        left->setRelativeGeometry(QRectF(0.0, 0.0, 0.5, 1.0));
+        m_layout->addZone(left);
+        PhosphorZones::LayoutComputeService::recalculateSync(m_layout, QRectF(0, 0, 1000, 1000));
+
+        PhosphorZones::ZoneDetector detector;
+        detector.setLayout(m_layout);
+        QCOMPARE(detector.spatialIndex().zoneCount(), 1);
+
+        auto* right = new PhosphorZones::Zone(m_layout);
+        right->setRelativeGeometry(QRectF(0.5, 0.0, 0.5, 1.0));
+        m_layout->addZone(right);
+        PhosphorZones::LayoutComputeService::recalculateSync(m_layout, QRectF(0, 0, 1000, 1000));
+
+        QCOMPARE(detector.spatialIndex().zoneCount(), 2);
+        QCOMPARE(detector.zoneAtPoint(QPointF(750, 500)), right);
+        QVERIFY(detector.spatialIndex().areAdjacent(left, right));
+    }
+
+private:
+    QVector<PhosphorZones::Zone*> buildGrid(int columns, int rows, qreal gap)
+    {
+        QVector<PhosphorZones::Zone*> zones;
+        const qreal w = 1.0 / columns;
+        const qreal h = 1.0 / rows;
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < columns; ++c) {
+                auto* zone = new PhosphorZones::Zone(m_layout);
+                zone->setRelativeGeometry(QRectF(c * w + gap / 2, r * h + gap / 2, w - gap, h - gap));
+                m_layout->addZone(zone);
+                zones.append(zone);
+            }
+        }
+        return zones;
+    }
+
+    PhosphorZones::Layout* m_layout = nullptr;
+};
+
+QTEST_MAIN(TestZoneSpatialIndex)
+#include "test_zone_spatial_index.moc"
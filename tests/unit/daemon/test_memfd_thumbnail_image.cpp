@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Pins the mapMemfdThumbnail contract: a sealed memfd maps into a QImage
+// without copying, the mapping outlives the fd, and unsealed / undersized /
+// malformed descriptors are refused before anything is mapped.
+
+#include "daemon/rendering/memfdthumbnailimage.h"
+
+#include <QtTest/QtTest>
+#include <QImage>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using PlasmaZones::MemfdThumbnailDesc;
+using PlasmaZones::mapMemfdThumbnail;
+
+namespace {
+
+constexpr int AllSeals = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL;
+
+// Fill a memfd with @p image's bytes at its own stride and apply @p seals.
+int memfdFor(const QImage& image, int seals)
+{
+    const int fd = ::memfd_create("test-thumbnail", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) {
+        return -1;
+    }
+    const qsizetype length = image.sizeInBytes();
+    if (::ftruncate(fd, length) != 0 || ::pwrite(fd, image.constBits(), length, 0) != length
+        || (seals && ::fcntl(fd, F_ADD_SEALS, seals) != 0)) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+QImage gradient(int w, int h)
+{
+    QImage img(w, h, QImage::Format_ARGB32);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            img.setPixel(x, y, qRgba(x % 256, y % 256, (x + y) % 256, 200));
+        }
+    }
+    return img;
+}
+
+MemfdThumbnailDesc descFor(int fd, const QImage& image)
+{
+    MemfdThumbnailDesc desc;
+    desc.fd = fd;
+    desc.width = image.width();
+    desc.height = image.height();
+    desc.stride = int(image.bytesPerLine());
+    return desc;
+}
+
+} // namespace
+
+class TestMemfdThumbnailImage : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void sealedMemfdRoundTrips();
+    void mappingOutlivesFd();
+    void mutationDetaches();
+    void unsealedMemfdRejected();
+    void undersizedMemfdRejected();
+    void malformedDescriptorRejected();
+};
+
+void TestMemfdThumbnailImage::sealedMemfdRoundTrips()
+{
+    const QImage in = gradient(64, 48);
+    const int fd = memfdFor(in, AllSeals);
+    QVERIFY(fd >= 0);
+    const QImage out = mapMemfdThumbnail(descFor(fd, in));
+    ::close(fd);
+    QVERIFY(!out.isNull());
+    QCOMPARE(out.format(), QImage::Format_ARGB32);
+    QCOMPARE(out, in);
+}
+
+void TestMemfdThumbnailImage::mappingOutlivesFd()
+{
+    // The D-Bus layer closes the borrowed fd as soon as the call returns;
+    // the cached image must stay readable after that.
+    const QImage in = gradient(32, 32);
+    const int fd = memfdFor(in, AllSeals);
+    QVERIFY(fd >= 0);
+    QImage out = mapMemfdThumbnail(descFor(fd, in));
+    ::close(fd);
+    QVERIFY(!out.isNull());
+    QCOMPARE(out.pixel(31, 31), in.pixel(31, 31));
+}
+
+void TestMemfdThumbnailImage::mutationDetaches()
+{
+    // The mapping is PROT_READ: writing through it would fault. A mutating
+    // access must detach into an owned copy instead.
+    const QImage in = gradient(16, 16);
+    const int fd = memfdFor(in, AllSeals);
+    QVERIFY(fd >= 0);
+    QImage out = mapMemfdThumbnail(descFor(fd, in));
+    ::close(fd);
+    QVERIFY(!out.isNull());
+    const uchar* mapped = out.constBits();
+    out.setPixel(0, 0, qRgba(1, 2, 3, 4));
+    QVERIFY(out.constBits() != mapped);
+    QCOMPARE(out.pixel(0, 0), qRgba(1, 2, 3, 4));
+}
+
+void TestMemfdThumbnailImage::unsealedMemfdRejected()
+{
+    const QImage in = gradient(16, 16);
+    for (const int seals : {0, int(F_SEAL_SHRINK), int(F_SEAL_WRITE)}) {
+        const int fd = memfdFor(in, seals);
+        QVERIFY(fd >= 0);
+        QVERIFY2(mapMemfdThumbnail(descFor(fd, in)).isNull(), qPrintable(QString::number(seals)));
+        ::close(fd);
+    }
+}
+
+void TestMemfdThumbnailImage::undersizedMemfdRejected()
+{
+    const QImage in = gradient(16, 16);
+    const int fd = memfdFor(in, AllSeals);
+    QVERIFY(fd >= 0);
+    MemfdThumbnailDesc desc = descFor(fd, in);
+    desc.height = 17;
+    QVERIFY(mapMemfdThumbnail(desc).isNull());
+    ::close(fd);
+}
+
+void TestMemfdThumbnailImage::malformedDescriptorRejected()
+{
+    const QImage in = gradient(16, 16);
+    const int fd = memfdFor(in, AllSeals);
+    QVERIFY(fd >= 0);
+    const MemfdThumbnailDesc good = descFor(fd, in);
+
+    MemfdThumbnailDesc desc = good;
+    desc.fd = -1;
+    QVERIFY(mapMemfdThumbnail(desc).isNull());
+    desc = good;
+    desc.width = 0;
+    QVERIFY(mapMemfdThumbnail(desc).isNull());
+    desc = good;
+    desc.height = 2048;
+    QVERIFY(mapMemfdThumbnail(desc).isNull());
+    desc = good;
+    desc.stride = good.width * 4 - 4;
+    QVERIFY(mapMemfdThumbnail(desc).isNull());
+    desc = good;
+    desc.stride = good.width * 4 + 2;
+    QVERIFY(mapMemfdThumbnail(desc).isNull());
+    ::close(fd);
+}
+
+QTEST_MAIN(TestMemfdThumbnailImage)
+#include "test_memfd_thumbnail_image.moc"
@@ -0,0 +1,274 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file test_session_journal.cpp
+ * @brief Crash-consistency tests for the window-tracking session journal.
+ *
+ * The journal is only safe if every way a write can be cut short leaves a
+ * state that loads as some prefix of what was saved:
+ *   - a torn or garbled tail drops that record and everything after it,
+ *     never the records before it;
+ *   - replay is idempotent, so loading twice (or replaying records already
+ *     folded into a snapshot) changes nothing;
+ *   - a crash between a compaction's snapshot write and its journal reset
+ *     leaves a journal whose generation no longer matches, and it is ignored.
+ */
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "config/configbackends.h"
+#include "config/configkeys.h"
+#include "dbus/windowtrackingadaptor/persistenceworker.h"
+#include "dbus/windowtrackingadaptor/sessionjournal.h"
+
+using namespace PlasmaZones;
+
+namespace {
+
+QJsonArray bucket(const QString& windowId, int x)
+{
+    return QJsonArray{QJsonObject{{QStringLiteral("windowId"), windowId}, {QStringLiteral("x"), x}}};
+}
+
+void appendRaw(const QString& path, const QByteArray& bytes)
+{
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Append));
+    QCOMPARE(file.write(bytes), static_cast<qint64>(bytes.size()));
+}
+
+QJsonObject readTracking(const QString& snapshotPath)
+{
+    QFile file(snapshotPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    return QJsonDocument::fromJson(file.readAll()).object().value(ConfigKeys::windowTrackingGroup()).toObject();
+}
+
+} // namespace
+
+class TestSessionJournal : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void testRoundTrip()
+    {
+        QTemporaryDir dir;
+        const QString path = dir.filePath(QStringLiteral("session.json.journal"));
+        QVERIFY(SessionJournal::reset(path, QStringLiteral("g1")));
+        appendRaw(path, SessionJournal::encodeKey(ConfigKeys::lastUsedZoneIdKey(), QStringLiteral("zone-a")));
+        appendRaw(path, SessionJournal::encodePlacements(QStringLiteral("firefox"), bucket(QStringLiteral("w1"), 10)));
+        appendRaw(path, SessionJournal::encodePlacements(QStringLiteral("kate"), {}));
+
+        const SessionJournal::Replay replay = SessionJournal::read(path);
+        QCOMPARE(replay.generation, QStringLiteral("g1"));
+        QCOMPARE(replay.records.size(), 3);
+        QVERIFY(!replay.isTorn());
+        QCOMPARE(replay.validBytes, replay.fileBytes);
+    }
+
+    void testMissingJournalIsEmpty()
+    {
+        QTemporaryDir dir;
+        const SessionJournal::Replay replay = SessionJournal::read(dir.filePath(QStringLiteral("absent.journal")));
+        QVERIFY(replay.generation.isEmpty());
+        QVERIFY(replay.records.isEmpty());
+        QVERIFY(!replay.isTorn());
+    }
+
+    void testTornTailIsDiscarded_data()
+    {
+        QTest::addColumn<int>("cut");
+        // Every possible cut point inside the final record, including the
+        // one that loses only its terminating newline.
+        const QByteArray last =
+            SessionJournal::encodePlacements(QStringLiteral("firefox"), bucket(QStringLiteral("w1"), 20));
+        for (int cut = 1; cut < last.size(); ++cut) {
+            QTest::addRow("cut-%d", cut) << cut;
+        }
+    }
+
+    void testTornTailIsDiscarded()
+    {
+        QFETCH(int, cut);
+        QTemporaryDir dir;
+        const QString path = dir.filePath(QStringLiteral("session.json.journal"));
+        QVERIFY(SessionJournal::reset(path, QStringLiteral("g1")));
+        const QByteArray first =
+            SessionJournal::encodePlacements(QStringLiteral("firefox"), bucket(QStringLiteral("w1"), 10));
+        const QByteArray last =
+            SessionJournal::encodePlacements(QStringLiteral("firefox"), bucket(QStringLiteral("w1"), 20));
+        appendRaw(path, first);
+        appendRaw(path, last.left(cut));
+
+        const SessionJournal::Replay replay = SessionJournal::read(path);
+        QCOMPARE(replay.generation, QStringLiteral("g1"));
+        QCOMPARE(replay.records.size(), 1);
+        QVERIFY(replay.isTorn());
+        QCOMPARE(replay.records.first().value(QStringLiteral("v")).toArray(), bucket(QStringLiteral("w1"), 10));
+    }
+
+    void testGarbledRecordStopsReplay()
+    {
+        QTemporaryDir dir;
+        const QString path = dir.filePath(QStringLiteral("session.json.journal"));
+        QVERIFY(SessionJournal::reset(path, QStringLiteral("g1")));
+        appendRaw(path, SessionJournal::encodeKey(ConfigKeys::lastUsedZoneIdKey(), QStringLiteral("zone-a")));
+        // A complete line that is not a record (e.g. zero-filled blocks after
+        // a power cut), followed by a well-formed record that must NOT apply:
+        // its predecessors are unknown, so it cannot be trusted.
+        appendRaw(path, QByteArray(16, '\0') + '\n');
+        appendRaw(path, SessionJournal::encodeKey(ConfigKeys::lastUsedZoneIdKey(), QStringLiteral("zone-b")));
+
+        const SessionJournal::Replay replay = SessionJournal::read(path);
+        QCOMPARE(replay.records.size(), 1);
+        QVERIFY(replay.isTorn());
+    }
+
+    void testHeaderlessJournalHasNoGeneration()
+    {
+        QTemporaryDir dir;
+        const QString path = dir.filePath(QStringLiteral("session.json.journal"));
+        appendRaw(path, SessionJournal::encodeKey(ConfigKeys::lastUsedZoneIdKey(), QStringLiteral("zone-a")));
+        const SessionJournal::Replay replay = SessionJournal::read(path);
+        QVERIFY(replay.generation.isEmpty());
+        QVERIFY(replay.records.isEmpty());
+    }
+
+    void testReplayIsIdempotent()
+    {
+        QTemporaryDir dir;
+        const QString path = dir.filePath(QStringLiteral("session.json.journal"));
+        QVERIFY(SessionJournal::reset(path, QStringLiteral("g1")));
+        appendRaw(path, SessionJournal::encodePlacements(QStringLiteral("firefox"), bucket(QStringLiteral("w1"), 10)));
+        appendRaw(path, SessionJournal::encodePlacements(QStringLiteral("kate"), bucket(QStringLiteral("w2"), 5)));
+        appendRaw(path, SessionJournal::encodePlacements(QStringLiteral("firefox"), bucket(QStringLiteral("w1"), 30)));
+        appendRaw(path, SessionJournal::encodePlacements(QStringLiteral("kate"), {}));
+        appendRaw(path, SessionJournal::encodeKey(ConfigKeys::lastUsedZoneIdKey(), QStringLiteral("zone-a")));
+        const SessionJournal::Replay replay = SessionJournal::read(path);
+        QCOMPARE(replay.records.size(), 5);
+
+        PhosphorConfig::JsonBackend backend(dir.filePath(QStringLiteral("session.json")));
+        auto tracking = backend.group(ConfigKeys::windowTrackingGroup());
+        SessionJournal::apply(replay.records, *tracking);
+        const QJsonObject once = tracking->readJson(ConfigKeys::windowPlacementsKey()).toObject();
+        SessionJournal::apply(replay.records, *tracking);
+        const QJsonObject twice = tracking->readJson(ConfigKeys::windowPlacementsKey()).toObject();
+
+        QCOMPARE(twice, once);
+        QCOMPARE(once, QJsonObject({{QStringLiteral("firefox"), bucket(QStringLiteral("w1"), 30)}}));
+        QCOMPARE(tracking->readString(ConfigKeys::lastUsedZoneIdKey()), QStringLiteral("zone-a"));
+    }
+
+    void testPlacementDeltaCoversOnlyChangedBuckets()
+    {
+        const QJsonObject before{{QStringLiteral("firefox"), bucket(QStringLiteral("w1"), 10)},
+                                 {QStringLiteral("kate"), bucket(QStringLiteral("w2"), 5)},
+                                 {QStringLiteral("konsole"), bucket(QStringLiteral("w3"), 1)}};
+        QJsonObject after = before;
+        after.insert(QStringLiteral("firefox"), bucket(QStringLiteral("w1"), 11));
+        after.remove(QStringLiteral("konsole"));
+        after.insert(QStringLiteral("dolphin"), bucket(QStringLiteral("w4"), 2));
+
+        const QByteArray delta = SessionJournal::encodePlacementDelta(before, after);
+        QCOMPARE(delta.count('\n'), 3); // firefox changed, dolphin added, konsole dropped
+        QVERIFY(!delta.contains("kate"));
+        QVERIFY(SessionJournal::encodePlacementDelta(after, after).isEmpty());
+
+        // Folding the delta over the old state reproduces the new one.
+        QTemporaryDir dir;
+        const QString path = dir.filePath(QStringLiteral("session.json.journal"));
+        QVERIFY(SessionJournal::reset(path, QStringLiteral("g1")));
+        appendRaw(path, delta);
+        PhosphorConfig::JsonBackend backend(dir.filePath(QStringLiteral("session.json")));
+        auto tracking = backend.group(ConfigKeys::windowTrackingGroup());
+        tracking->writeJson(ConfigKeys::windowPlacementsKey(), before);
+        SessionJournal::apply(SessionJournal::read(path).records, *tracking);
+        QCOMPARE(tracking->readJson(ConfigKeys::windowPlacementsKey()).toObject(), after);
+    }
+
+    void testCompactionThenAppendThroughWorker()
+    {
+        QTemporaryDir dir;
+        const QString snapshotPath = dir.filePath(QStringLiteral("session.json"));
+        const QString journalPath = SessionJournal::journalPath(snapshotPath);
+        QJsonObject tracking{{ConfigKeys::sessionJournalGenerationKey(), QStringLiteral("g2")}};
+        const QJsonObject root{{ConfigKeys::windowTrackingGroup(), tracking}};
+
+        PersistenceWorker worker;
+        QSignalSpy completed(&worker, &PersistenceWorker::writeCompleted);
+        worker.enqueueCompact(snapshotPath, root, journalPath, QStringLiteral("g2"));
+        worker.enqueueAppend(journalPath, SessionJournal::encodePlacements(QStringLiteral("firefox"),
+                                                                           bucket(QStringLiteral("w1"), 10)));
+        QTRY_COMPARE(completed.size(), 2);
+        QCOMPARE(completed.at(0).at(0).toString(), snapshotPath);
+        QVERIFY(completed.at(0).at(1).toBool());
+        QCOMPARE(completed.at(1).at(0).toString(), journalPath);
+        QVERIFY(completed.at(1).at(1).toBool());
+
+        QCOMPARE(readTracking(snapshotPath).value(ConfigKeys::sessionJournalGenerationKey()).toString(),
+                 QStringLiteral("g2"));
+        const SessionJournal::Replay replay = SessionJournal::read(journalPath);
+        QCOMPARE(replay.generation, QStringLiteral("g2"));
+        QCOMPARE(replay.records.size(), 1);
+    }
+
+    void testCrashBetweenSnapshotAndJournalResetIgnoresJournal()
+    {
+        QTemporaryDir dir;
+        const QString snapshotPath = dir.filePath(QStringLiteral("session.json"));
+        const QString journalPath = SessionJournal::journalPath(snapshotPath);
+
+        // Generation g1 with one journaled change...
+        QVERIFY(SessionJournal::reset(journalPath, QStringLiteral("g1")));
+        appendRaw(journalPath, SessionJournal::encodePlacements(QStringLiteral("firefox"),
+                                                                bucket(QStringLiteral("w1"), 10)));
+        // ...then a compaction wrote the g2 snapshot (which already holds a
+        // newer firefox bucket) and the daemon died before the journal reset.
+        const QJsonObject placements{{QStringLiteral("firefox"), bucket(QStringLiteral("w1"), 40)}};
+        const QJsonObject tracking{{ConfigKeys::sessionJournalGenerationKey(), QStringLiteral("g2")},
+                                   {ConfigKeys::windowPlacementsKey(), placements}};
+        QVERIFY(PersistenceWorker::writeSync(snapshotPath, QJsonObject{{ConfigKeys::windowTrackingGroup(), tracking}}));
+
+        PhosphorConfig::JsonBackend backend(snapshotPath);
+        auto group = backend.group(ConfigKeys::windowTrackingGroup());
+        const SessionJournal::Replay replay = SessionJournal::replay(journalPath, *group);
+        QCOMPARE(replay.generation, QStringLiteral("g1"));
+        QVERIFY(!replay.applied);
+        QCOMPARE(group->readJson(ConfigKeys::windowPlacementsKey()).toObject(), placements);
+    }
+
+    void testMatchingJournalReplaysOverSnapshot()
+    {
+        QTemporaryDir dir;
+        const QString snapshotPath = dir.filePath(QStringLiteral("session.json"));
+        const QString journalPath = SessionJournal::journalPath(snapshotPath);
+        const QJsonObject placements{{QStringLiteral("firefox"), bucket(QStringLiteral("w1"), 40)}};
+        const QJsonObject tracking{{ConfigKeys::sessionJournalGenerationKey(), QStringLiteral("g2")},
+                                   {ConfigKeys::windowPlacementsKey(), placements}};
+        QVERIFY(PersistenceWorker::writeSync(snapshotPath, QJsonObject{{ConfigKeys::windowTrackingGroup(), tracking}}));
+        QVERIFY(SessionJournal::reset(journalPath, QStringLiteral("g2")));
+        appendRaw(journalPath, SessionJournal::encodePlacements(QStringLiteral("firefox"),
+                                                                bucket(QStringLiteral("w1"), 50)));
+
+        PhosphorConfig::JsonBackend backend(snapshotPath);
+        auto group = backend.group(ConfigKeys::windowTrackingGroup());
+        const SessionJournal::Replay replay = SessionJournal::replay(journalPath, *group);
+        QVERIFY(replay.applied);
+        QCOMPARE(group->readJson(ConfigKeys::windowPlacementsKey()).toObject(),
+                 QJsonObject({{QStringLiteral("firefox"), bucket(QStringLiteral("w1"), 50)}}));
+    }
+};
+
+QTEST_MAIN(TestSessionJournal)
+#include "test_session_journal.moc"
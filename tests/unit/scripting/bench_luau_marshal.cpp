@@ -0,0 +1,337 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file bench_luau_marshal.cpp
+ * @brief Per-retile cost of marshalling a tile() call into a bundled algorithm.
+ *
+ * Compares the two ways a TilingParams can reach a script's tile():
+ *
+ *   - **variant** — the generic LuauEngine::callModule path: ctx built as a
+ *     nested QVariantMap (a faithful copy of the builder LuauTileAlgorithm
+ *     used before the typed surface), result converted back through a
+ *     QVariantList of QVariantMaps;
+ *   - **typed** — LuauTileAlgorithm::calculateZones, which writes ctx through
+ *     interned keys and reads the rects straight off the VM stack.
+ *
+ * Both run the same bundled script on the same params. Latency comes from
+ * QBENCHMARK; `allocations` counts heap allocations per retile (Qt containers,
+ * Lua strings/tables, everything) via malloc interposition on glibc, and
+ * checks the two paths agree on the resulting zones. Run with:
+ *
+ *   ctest --test-dir build -R bench_luau_marshal --output-on-failure
+ */
+
+#include <QtTest>
+
+#include <QFile>
+#include <QVariantList>
+#include <QVariantMap>
+
+#include <PhosphorTiles/AutotileConstants.h>
+#include <PhosphorTiles/LuauTileAlgorithm.h>
+#include <PhosphorTiles/TileScriptMetadata.h>
+#include <PhosphorTiles/TilingParams.h>
+#include <PhosphorTiles/TilingState.h>
+
+#include <PhosphorScripting/LuauEngine.h>
+#include <PhosphorScripting/LuauWatchdog.h>
+
+#include <atomic>
+#include <memory>
+
+#if defined(__GLIBC__)
+#include <cstdlib>
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+}
+
+namespace {
+std::atomic<bool> g_counting{false};
+std::atomic<quint64> g_allocations{0};
+
+inline void countAllocation()
+{
+    if (g_counting.load(std::memory_order_relaxed)) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+} // namespace
+
+// Interpose the allocation entry points; free() is left to libc.
+extern "C" void* malloc(size_t size) noexcept
+{
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size) noexcept
+{
+    countAllocation();
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* ptr, size_t size) noexcept
+{
+    countAllocation();
+    return __libc_realloc(ptr, size);
+}
+
+#define P_COUNT_ALLOCATIONS 1
+#endif
+
+using namespace PhosphorTiles;
+using PhosphorScripting::LuauEngine;
+
+namespace {
+
+constexpr int Iterations = 2000;
+
+QString luaPath(const QString& name)
+{
+    return QStringLiteral(P_SOURCE_DIR "/data/algorithms/") + name + QStringLiteral(".luau");
+}
+
+// The pre-typed-surface ctx builder, restricted to the fields the fixture sets.
+QVariantMap buildVariantContext(const TilingParams& params, const QRect& area)
+{
+    QVariantMap ctx;
+    ctx[QStringLiteral("count")] = params.windowCount;
+    ctx[QStringLiteral("windowCount")] = params.windowCount;
+    ctx[QStringLiteral("gap")] = std::max(0, params.innerGap);
+    ctx[QStringLiteral("innerGap")] = std::max(0, params.innerGap);
+
+    QVariantMap areaMap;
+    areaMap[QStringLiteral("x")] = area.x();
+    areaMap[QStringLiteral("y")] = area.y();
+    areaMap[QStringLiteral("width")] = area.width();
+    areaMap[QStringLiteral("height")] = area.height();
+    ctx[QStringLiteral("area")] = areaMap;
+
+    ctx[QStringLiteral("masterCount")] = params.state->masterCount();
+    ctx[QStringLiteral("splitRatio")] =
+        std::clamp(params.state->splitRatio(), AutotileDefaults::MinSplitRatio, AutotileDefaults::MaxSplitRatio);
+
+    QVariantList minSizes;
+    for (const QSize& s : params.minSizes) {
+        QVariantMap m;
+        m[QStringLiteral("w")] = s.width();
+        m[QStringLiteral("h")] = s.height();
+        minSizes.append(m);
+    }
+    ctx[QStringLiteral("minSizes")] = minSizes;
+
+    QVariantList windows;
+    for (const WindowInfo& info : params.windowInfos) {
+        QVariantMap w;
+        w[QStringLiteral("appId")] = info.appId;
+        w[QStringLiteral("focused")] = info.focused;
+        w[QStringLiteral("windowId")] = info.windowId;
+        windows.append(w);
+    }
+    ctx[QStringLiteral("windows")] = windows;
+    ctx[QStringLiteral("focusedIndex")] = params.focusedIndex;
+
+    QVariantList geoms;
+    for (const QRect& r : params.currentGeometries) {
+        QVariantMap g;
+        g[QStringLiteral("x")] = r.x();
+        g[QStringLiteral("y")] = r.y();
+        g[QStringLiteral("width")] = r.width();
+        g[QStringLiteral("height")] = r.height();
+        geoms.append(g);
+    }
+    ctx[QStringLiteral("currentGeometries")] = geoms;
+
+    QVariantMap screen;
+    screen[QStringLiteral("id")] = params.screenInfo.id;
+    screen[QStringLiteral("portrait")] = params.screenInfo.portrait;
+    screen[QStringLiteral("aspectRatio")] = params.screenInfo.aspectRatio;
+    ctx[QStringLiteral("screen")] = screen;
+    return ctx;
+}
+
+QVector<QRect> variantToRects(const QVariant& v)
+{
+    QVector<QRect> zones;
+    const QVariantList list = v.toList();
+    zones.reserve(list.size());
+    for (const QVariant& entry : list) {
+        const QVariantMap z = entry.toMap();
+        zones.append(QRect(z.value(QStringLiteral("x")).toInt(), z.value(QStringLiteral("y")).toInt(),
+                           z.value(QStringLiteral("width")).toInt(), z.value(QStringLiteral("height")).toInt()));
+    }
+    return zones;
+}
+
+} // namespace
+
+class BenchLuauMarshal : public QObject
+{
+    Q_OBJECT
+
+private:
+    // One algorithm under test, driven both ways against the same params.
+    struct Fixture
+    {
+        std::unique_ptr<TilingState> state;
+        TilingParams params;
+        std::unique_ptr<LuauTileAlgorithm> typed;
+        std::shared_ptr<LuauEngine> engine;
+        int module = -1;
+    };
+
+    std::shared_ptr<PhosphorScripting::LuauWatchdog> m_watchdog;
+
+    std::unique_ptr<Fixture> makeFixture(const QString& name, int count)
+    {
+        auto f = std::make_unique<Fixture>();
+        f->state = std::make_unique<TilingState>(QStringLiteral("screen-1"));
+        for (int i = 0; i < count; ++i) {
+            f->state->addWindow(QStringLiteral("w%1").arg(i));
+        }
+        f->state->setSplitRatio(0.6);
+        f->state->setMasterCount(1);
+        // No split tree: the variant builder below doesn't marshal one.
+        f->state->clearSplitTree();
+
+        TilingParams& p = f->params;
+        p.windowCount = count;
+        p.screenGeometry = QRect(0, 0, 2560, 1440);
+        p.state = f->state.get();
+        p.innerGap = 8;
+        p.outerGaps = EdgeGaps::uniform(0);
+        p.focusedIndex = 0;
+        p.screenInfo = {QStringLiteral("DP-1"), false, 2560.0 / 1440.0};
+        for (int i = 0; i < count; ++i) {
+            p.minSizes.append(QSize(200, 150));
+            p.windowInfos.append({QStringLiteral("org.kde.app%1").arg(i), i == 0, QStringLiteral("w%1").arg(i)});
+        }
+
+        f->typed = std::make_unique<LuauTileAlgorithm>(luaPath(name), m_watchdog);
+        if (!f->typed->isValid()) {
+            return nullptr;
+        }
+        // Seed currentGeometries from a first layout, as a live retile would.
+        p.currentGeometries = f->typed->calculateZones(p);
+
+        f->engine = LuauTileAlgorithm::createSandboxedEngine(m_watchdog);
+        QFile file(luaPath(name));
+        if (!f->engine || !file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            return nullptr;
+        }
+        f->module = f->engine->loadModule(luaPath(name), file.readAll());
+        if (f->module < 0) {
+            return nullptr;
+        }
+        return f;
+    }
+
+    static QVector<QRect> variantRetile(Fixture& f)
+    {
+        const QRect area = f.params.screenGeometry;
+        const auto out = f.engine->callModule(f.module, QStringLiteral("tile"), {buildVariantContext(f.params, area)},
+                                              AutotileDefaults::ScriptWatchdogTimeoutMs);
+        return ScriptedHelpers::clampZonesToArea(variantToRects(out.result), area, QStringLiteral("bench"));
+    }
+
+    static void addRows()
+    {
+        QTest::addColumn<QString>("algorithm");
+        QTest::addColumn<int>("count");
+        const QStringList algorithms = {QStringLiteral("master-stack"), QStringLiteral("dwindle"),
+                                        QStringLiteral("grid"), QStringLiteral("columns"), QStringLiteral("bsp")};
+        for (const QString& name : algorithms) {
+            for (int count : {4, 12}) {
+                QTest::addRow("%s/%d", qPrintable(name), count) << name << count;
+            }
+        }
+    }
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        m_watchdog = std::make_shared<PhosphorScripting::LuauWatchdog>();
+    }
+
+    void variant_data()
+    {
+        addRows();
+    }
+    void variant()
+    {
+        QFETCH(QString, algorithm);
+        QFETCH(int, count);
+        auto f = makeFixture(algorithm, count);
+        QVERIFY(f);
+        QVector<QRect> zones;
+        QBENCHMARK {
+            zones = variantRetile(*f);
+        }
+        QCOMPARE(zones.size(), count);
+    }
+
+    void typed_data()
+    {
+        addRows();
+    }
+    void typed()
+    {
+        QFETCH(QString, algorithm);
+        QFETCH(int, count);
+        auto f = makeFixture(algorithm, count);
+        QVERIFY(f);
+        QVector<QRect> zones;
+        QBENCHMARK {
+            zones = f->typed->calculateZones(f->params);
+        }
+        QCOMPARE(zones.size(), count);
+    }
+
+    void allocations_data()
+    {
+        addRows();
+    }
+    void allocations()
+    {
+        QFETCH(QString, algorithm);
+        QFETCH(int, count);
+        auto f = makeFixture(algorithm, count);
+        QVERIFY(f);
+
+        // Same input, same script: the two paths must agree exactly.
+        QCOMPARE(f->typed->calculateZones(f->params), variantRetile(*f));
+
+#ifdef P_COUNT_ALLOCATIONS
+        const auto perRetile = [](auto&& retile) {
+            g_allocations.store(0);
+            g_counting.store(true);
+            for (int i = 0; i < Iterations; ++i) {
+                retile();
+            }
+            g_counting.store(false);
+            return double(g_allocations.load()) / Iterations;
+        };
+        const double before = perRetile([&] {
+            variantRetile(*f);
+        });
+        const double after = perRetile([&] {
+            f->typed->calculateZones(f->params);
+        });
+        qInfo().noquote() << QStringLiteral("%1/%2: allocations per retile variant=%3 typed=%4")
+                                 .arg(algorithm)
+                                 .arg(count)
+                                 .arg(before, 0, 'f', 1)
+                                 .arg(after, 0, 'f', 1);
+        QVERIFY(after < before);
+#else
+        QSKIP("allocation counting needs glibc malloc interposition");
+#endif
+    }
+};
+
+QTEST_GUILESS_MAIN(BenchLuauMarshal)
+#include "bench_luau_marshal.moc"
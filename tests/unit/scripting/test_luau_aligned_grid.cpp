@@ -57,6 +57,8 @@ private Q_SLOTS:
         QVERIFY(algo.supportsResizeHook());
         QVERIFY(!algo.supportsMemory()); // it's script-state, not a SplitTree
         QVERIFY(algo.supportsScriptState()); // opts into the persistent ctx.state bag
+        // Index-placed: a focus move is not a zone-cache miss for it.
+        QVERIFY(!algo.readsFocus());
     }
 
     // Default (no stored state) → an equal 2x2 grid with aligned columns.
@@ -2,7 +2,8 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 // Unit tests for the PhosphorScripting Luau host: happy-path module calls +
-// QVariant marshalling, prelude globals, the interrupt watchdog, compile-error
+// QVariant marshalling, the typed call surface, prelude globals, the bytecode
+// cache, the interrupt watchdog, compile-error
 // surfacing, and the sandbox guarantees.
 
 #include <QtTest>
@@ -25,10 +26,12 @@ private Q_SLOTS:
     void happyPathAndMarshalling();
     void marshalRoundTrip();
     void marshalDeepNesting();
+    void typedCallMatchesVariantCall();
     void preludeGlobals();
     void preludeCompileErrorSurfaces();
     void watchdogKillsInfiniteLoopAndRecovers();
     void compileErrorSurfaces();
+    void cachedBytecodeReloads();
     void sandboxHolds();
     void sandboxBlocksEscapeVectors();
     void runtimeErrorSurfaces();
@@ -154,6 +157,102 @@ void TestLuauEngine::marshalDeepNesting()
     engine.releaseModule(handle);
 }
 
+void TestLuauEngine::typedCallMatchesVariantCall()
+{
+    LuauEngine engine;
+    QVERIFY(engine.init());
+    engine.sandbox();
+
+    const int handle = engine.loadModule(QStringLiteral("echo"), R"LUA(
+        return {
+            tile = function(ctx)
+                local out = {}
+                for i, s in ctx.sizes do
+                    out[i] = { x = ctx.x + i, width = s, height = 2.6, label = ctx.name }
+                end
+                return out
+            end,
+        }
+    )LUA");
+    QVERIFY(handle >= 0);
+
+    const LuauKey tile = engine.internKey(u"tile");
+    const LuauKey x = engine.internKey(u"x");
+    const LuauKey name = engine.internKey(u"name");
+    const LuauKey sizes = engine.internKey(u"sizes");
+    const LuauKey width = engine.internKey(u"width");
+    const LuauKey height = engine.internKey(u"height");
+    QVERIFY(tile.isValid());
+    // Interning is idempotent.
+    QCOMPARE(engine.internKey(u"x").ref, x.ref);
+
+    QList<QRect> typed;
+    QString message;
+    const auto status = engine.callModuleTyped(
+        handle, tile, 200,
+        [&](LuauStackWriter& w) {
+            w.pushTable(0, 3);
+            w.setInt(x, 100);
+            w.setString(name, u"m\u00e4ster");
+            w.pushTable(3, 0);
+            for (int i = 1; i <= 3; ++i) {
+                w.pushInt(i * 10);
+                w.setIndex(i);
+            }
+            w.setField(sizes);
+            return 1;
+        },
+        [&](LuauStackReader& r) {
+            for (int i = 1; i <= r.length(); ++i) {
+                r.pushIndex(-1, i);
+                typed.append(QRect(r.intField(-1, x), 0, r.intField(-1, width), r.intField(-1, height)));
+                r.pop();
+            }
+        },
+        &message);
+    QCOMPARE(status, LuauEngine::CallStatus::Ok);
+
+    // The variant surface must see exactly the same values, rounding included.
+    QVariantMap ctx;
+    ctx[QStringLiteral("x")] = 100;
+    ctx[QStringLiteral("name")] = QStringLiteral("m\u00e4ster");
+    ctx[QStringLiteral("sizes")] = QVariantList{10, 20, 30};
+    const auto out = engine.callModule(handle, QStringLiteral("tile"), {ctx}, 200);
+    QCOMPARE(out.status, LuauEngine::CallStatus::Ok);
+    QList<QRect> variant;
+    for (const QVariant& v : out.result.toList()) {
+        const QVariantMap z = v.toMap();
+        variant.append(QRect(z.value(QStringLiteral("x")).toInt(), 0, z.value(QStringLiteral("width")).toInt(),
+                             z.value(QStringLiteral("height")).toInt()));
+    }
+    QCOMPARE(typed.size(), 3);
+    QCOMPARE(typed, variant);
+
+    // A miscounted argument write is rejected without running the script.
+    const auto bad = engine.callModuleTyped(
+        handle, tile, 200,
+        [&](LuauStackWriter& w) {
+            w.pushNil();
+            return 2;
+        },
+        [](LuauStackReader&) {
+            QFAIL("reader must not run on a failed call");
+        },
+        &message);
+    QCOMPARE(bad, LuauEngine::CallStatus::Error);
+
+    // A missing function fails like callModule does, and the VM stays usable.
+    const auto missing = engine.callModuleTyped(
+        handle, engine.internKey(u"nope"), 200,
+        [](LuauStackWriter&) {
+            return 0;
+        },
+        [](LuauStackReader&) {}, &message);
+    QCOMPARE(missing, LuauEngine::CallStatus::Error);
+    QVERIFY(message.contains(QStringLiteral("nope")));
+    QCOMPARE(engine.callModule(handle, QStringLiteral("tile"), {ctx}, 200).status, LuauEngine::CallStatus::Ok);
+}
+
 void TestLuauEngine::preludeGlobals()
 {
     LuauEngine engine;
@@ -217,6 +316,40 @@ void TestLuauEngine::compileErrorSurfaces()
     QVERIFY(!err.isEmpty());
 }
 
+void TestLuauEngine::cachedBytecodeReloads()
+{
+    // Repeat loads of the same source hit the bytecode cache; every load must
+    // still behave exactly like a fresh compile.
+    const QByteArray mod = "return { run = function() return helper() end }";
+    const auto runWith = [&](const QByteArray& prelude) -> QVariant {
+        LuauEngine engine;
+        if (!engine.init() || !engine.runPrelude(QStringLiteral("pre"), prelude)) {
+            return {};
+        }
+        engine.sandbox();
+        const int handle = engine.loadModule(QStringLiteral("m"), mod);
+        if (handle < 0) {
+            return {};
+        }
+        return engine.callModule(handle, QStringLiteral("run"), {}, 200).result;
+    };
+    for (int i = 0; i < 2; ++i) {
+        QCOMPARE(runWith("function helper() return 1 end").toInt(), 1);
+        // Same module source under a different prelude: its own cache key.
+        QCOMPARE(runWith("function helper() return 2 end").toInt(), 2);
+    }
+
+    // A compile error is never cached — it surfaces on every load.
+    for (int i = 0; i < 2; ++i) {
+        LuauEngine engine;
+        QVERIFY(engine.init());
+        engine.sandbox();
+        QString err;
+        QCOMPARE(engine.loadModule(QStringLiteral("bad"), "return { this is not lua }", &err), -1);
+        QVERIFY(!err.isEmpty());
+    }
+}
+
 void TestLuauEngine::sandboxHolds()
 {
     LuauEngine engine;
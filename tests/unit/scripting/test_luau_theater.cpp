@@ -80,6 +80,8 @@ private Q_SLOTS:
         QVERIFY(algo.supportsSingleWindow());
         QVERIFY(algo.supportsResizeHook());
         QVERIFY(algo.retilesOnFocusChange());
+        QVERIFY(algo.readsFocus());
+        QVERIFY(!algo.readsCurrentGeometries());
     }
 
     void singleWindow_centered()
@@ -30,7 +30,7 @@ class TestZoneEntryScaffold : public QObject
 {
     Q_OBJECT
 
-    static bool bakeAssembled(const QString& rawBody, QString* errOut)
+    static QString expandAssembled(const QString& rawBody, QString* errOut)
     {
         const QString assembled = PlasmaZones::assembleZoneEntrySource(rawBody);
         const QStringList includePaths = {QStringLiteral(PLASMAZONES_SOURCE_DIR "/data/overlays/shared"),
@@ -38,10 +38,16 @@ class TestZoneEntryScaffold : public QObject
         QString err;
         const QString expanded = PhosphorShaders::ShaderIncludeResolver::expandIncludes(
             assembled, QStringLiteral(PLASMAZONES_SOURCE_DIR "/data/overlays/shared"), includePaths, &err);
+        if (expanded.isEmpty() && errOut) {
+            *errOut = QStringLiteral("include expand failed: ") + err;
+        }
+        return expanded;
+    }
+
+    static bool bakeAssembled(const QString& rawBody, QString* errOut)
+    {
+        const QString expanded = expandAssembled(rawBody, errOut);
         if (expanded.isEmpty()) {
-            if (errOut) {
-                *errOut = QStringLiteral("include expand failed: ") + err;
-            }
             return false;
         }
         const auto result = PhosphorRendering::ShaderCompiler::compile(expanded.toUtf8(), QShader::FragmentStage);
@@ -79,6 +85,32 @@ private Q_SLOTS:
         QVERIFY2(bakeAssembled(body, &err), qPrintable(err));
     }
 
+    // common.glsl names the storage-buffer macro in its own text, so every
+    // expanded zone source mentions it. Only the caller's explicit targets may
+    // drop the GLSL variants: without them the OpenGL backend has no shader.
+    void testCommonGlslBakesGlslUnlessSpirvOnlyIsAsked()
+    {
+        using PhosphorRendering::ShaderCompiler;
+        const QString body = QStringLiteral("vec4 pZone(ZoneCtx z) { return z.fillColor; }\n");
+        QString err;
+        const QString expanded = expandAssembled(body, &err);
+        QVERIFY2(!expanded.isEmpty(), qPrintable(err));
+        QVERIFY(expanded.contains(QLatin1String(ShaderCompiler::kStorageBufferDefine)));
+
+        const QShaderKey glsl330(QShader::GlslShader, QShaderVersion(330));
+        const auto full = ShaderCompiler::compile(expanded.toUtf8(), QShader::FragmentStage);
+        QVERIFY2(full.success, qPrintable(full.error));
+        QVERIFY(full.shader.availableShaders().contains(glsl330));
+
+        const QString storage = PhosphorShaders::spliceAfterVersion(
+            expanded, QStringLiteral("#define %1 1\n").arg(QLatin1String(ShaderCompiler::kStorageBufferDefine)));
+        const auto spirvOnly =
+            ShaderCompiler::compile(storage.toUtf8(), QShader::FragmentStage, ShaderCompiler::Targets::SpirvOnly);
+        QVERIFY2(spirvOnly.success, qPrintable(spirvOnly.error));
+        QVERIFY(!spirvOnly.shader.availableShaders().contains(glsl330));
+        QVERIFY(spirvOnly.shader.availableShaders().contains(QShaderKey(QShader::SpirvShader, QShaderVersion(100))));
+    }
+
     void testTraditionalMainPassedThroughUnchanged()
     {
         // A pack with its own #version + main() is the traditional form and
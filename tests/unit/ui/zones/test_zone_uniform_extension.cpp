@@ -17,6 +17,8 @@
 #include <PhosphorRendering/ZoneUniformExtension.h>
 
 using PhosphorRendering::MaxZones;
+using PhosphorRendering::kZoneStorageArrayBytes;
+using PhosphorRendering::kZoneStorageBytes;
 using PhosphorRendering::ZoneData;
 using PhosphorRendering::ZoneShaderUniforms;
 using PhosphorRendering::ZoneUniformExtension;
@@ -57,6 +59,12 @@ private Q_SLOTS:
     void layout_matchesZoneShaderUniformsOffsets();
     void layout_matchesGlslUboDeclaration();
     void scaleHelpers_matchTheirDocumentedGuards();
+    void dirtyRanges_firstTakeIsWhole();
+    void dirtyRanges_highlightChangeIsOneParamsEntry();
+    void dirtyRanges_unchangedUpdateIsEmpty();
+    void dirtyRanges_scaleChangeIsTailScalar();
+    void storage_holdsZonesPastUboCeiling();
+    void storage_everythingReportsPopulatedPrefixes();
 };
 
 namespace {
@@ -840,5 +848,124 @@ void TestZoneUniformExtension::scaleHelpers_matchTheirDocumentedGuards()
              "zoneFillHue() must guard the un-premultiply against a zero alpha");
 }
 
+namespace {
+
+using DirtyRange = PhosphorShaders::IUniformExtension::DirtyRange;
+
+QVector<ZoneData> makeZones(int count)
+{
+    QVector<ZoneData> zones;
+    for (int i = 0; i < count; ++i) {
+        zones.append(makeZone(i, 0.0, 1.0, 1.0, QColor::fromRgbF(0.2f, 0.4f, 0.6f, 1.0f),
+                              QColor::fromRgbF(1.0f, 1.0f, 1.0f, 1.0f),
+                              /*radius*/ 8.0f, /*width*/ 2.0f, /*highlighted*/ false, /*number*/ i + 1));
+    }
+    return zones;
+}
+
+} // namespace
+
+void TestZoneUniformExtension::dirtyRanges_firstTakeIsWhole()
+{
+    // A fresh node's UBO holds nothing yet, so the first upload must be whole
+    // no matter how little the first update touched.
+    ZoneUniformExtension ext;
+    ext.updateFromZones(makeZones(1));
+    DirtyRange ranges[16];
+    QCOMPARE(ext.takeDirtyRanges(ranges, 16), -1);
+    QVERIFY(!ext.isDirty());
+}
+
+void TestZoneUniformExtension::dirtyRanges_highlightChangeIsOneParamsEntry()
+{
+    ZoneUniformExtension ext;
+    auto zones = makeZones(8);
+    ext.updateFromZones(zones);
+    DirtyRange ranges[16];
+    ext.takeDirtyRanges(ranges, 16);
+
+    // Hovering zone 5 flips one flag in one vec4: the upload must be that
+    // 16-byte zoneParams entry, not the 4 KiB zone block.
+    zones[5].isHighlighted = true;
+    ext.updateFromZones(zones);
+    QCOMPARE(ext.takeDirtyRanges(ranges, 16), 1);
+    QCOMPARE(ranges[0].offset, (3 * MaxZones + 5) * kBytesPerVec4);
+    QCOMPARE(ranges[0].size, kBytesPerVec4);
+}
+
+void TestZoneUniformExtension::dirtyRanges_unchangedUpdateIsEmpty()
+{
+    // The item re-pushes the same zones on every sync. isDirty() still reports
+    // the update, but nothing may cross the bus for it.
+    ZoneUniformExtension ext;
+    const auto zones = makeZones(4);
+    ext.updateFromZones(zones);
+    DirtyRange ranges[16];
+    ext.takeDirtyRanges(ranges, 16);
+
+    ext.updateFromZones(zones);
+    QVERIFY(ext.isDirty());
+    QCOMPARE(ext.takeDirtyRanges(ranges, 16), 0);
+}
+
+void TestZoneUniformExtension::dirtyRanges_scaleChangeIsTailScalar()
+{
+    ZoneUniformExtension ext;
+    DirtyRange ranges[16];
+    ext.takeDirtyRanges(ranges, 16);
+
+    QVERIFY(ext.setScale(2.0f));
+    QCOMPARE(ext.takeDirtyRanges(ranges, 16), 1);
+    QCOMPARE(ranges[0].offset, MaxZones * kArraysPerZone * kBytesPerVec4);
+    QCOMPARE(ranges[0].size, static_cast<int>(sizeof(float)));
+}
+
+void TestZoneUniformExtension::storage_holdsZonesPastUboCeiling()
+{
+    ZoneUniformExtension ext;
+    auto zones = makeZones(MaxZones + 36);
+    ext.updateFromZones(zones);
+    std::vector<char> storage(kZoneStorageBytes, 0);
+    DirtyRange ranges[16];
+    ext.takeStorageUpdate(storage.data(), ranges, 16, /*everything*/ true);
+    DirtyRange uboRanges[16];
+    ext.takeDirtyRanges(uboRanges, 16);
+
+    // Zone 90 has no UBO slot. Highlighting it must still reach the storage
+    // copy as its own 16-byte span, and leave the UBO with nothing to send.
+    constexpr int zone = MaxZones + 26;
+    zones[zone].isHighlighted = true;
+    ext.updateFromZones(zones);
+    QCOMPARE(ext.takeDirtyRanges(uboRanges, 16), 0);
+
+    QCOMPARE(ext.takeStorageUpdate(storage.data(), ranges, 16, /*everything*/ false), 1);
+    QCOMPARE(ranges[0].offset, 3 * kZoneStorageArrayBytes + zone * kBytesPerVec4);
+    QCOMPARE(ranges[0].size, kBytesPerVec4);
+
+    Vec4 params{};
+    std::memcpy(&params, storage.data() + ranges[0].offset, sizeof(Vec4));
+    QCOMPARE(params.z, 1.0f);
+    QCOMPARE(params.w, static_cast<float>(zone + 1));
+}
+
+void TestZoneUniformExtension::storage_everythingReportsPopulatedPrefixes()
+{
+    // A freshly created GPU buffer is undefined, so the first upload covers
+    // every zone index ever written in each of the four sections.
+    ZoneUniformExtension ext;
+    ext.updateFromZones(makeZones(100));
+    ext.updateFromZones(makeZones(10));
+    std::vector<char> storage(kZoneStorageBytes, 0);
+    DirtyRange ranges[16];
+    QCOMPARE(ext.takeStorageUpdate(storage.data(), ranges, 16, /*everything*/ true), 4);
+    for (int a = 0; a < 4; ++a) {
+        QCOMPARE(ranges[a].offset, a * kZoneStorageArrayBytes);
+        QCOMPARE(ranges[a].size, 100 * kBytesPerVec4);
+    }
+
+    // Nothing changed since: the next incremental take is empty.
+    QCOMPARE(ext.takeStorageUpdate(storage.data(), ranges, 16, /*everything*/ false), 0);
+}
+
 QTEST_APPLESS_MAIN(TestZoneUniformExtension)
 #include "test_zone_uniform_extension.moc"
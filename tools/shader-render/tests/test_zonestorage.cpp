@@ -0,0 +1,317 @@
+// SPDX-FileCopyrightText: 2026 fuddlesworth
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Renders through the built plasmazones-shader-render binary and compares the
+// frames of the storage-buffer zone path against the 64-zone UBO path
+// (PHOSPHOR_ZONE_STORAGE=0) and against OpenGL. Needs lavapipe and a display
+// session the tool can initialize against; skips when either is missing.
+
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QProcess>
+#include <QProcessEnvironment>
+#include <QRect>
+#include <QString>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+// Single pass and no buffer feedback, so frame N depends only on iTime and
+// the zone arrays. Loops to PZ_MAX_ZONES and reads zoneParams for the
+// highlight flag.
+constexpr auto kPack = "neon-drift";
+constexpr int kFps = 30;
+const QSize kResolution(320, 180);
+
+// 10 x 8 grid: 80 zones, 16 of them past the UBO path's 64.
+constexpr int kGridColumns = 10;
+constexpr int kGridRows = 8;
+
+enum class Backend {
+    VulkanStorage,
+    VulkanUbo,
+    OpenGl,
+};
+
+struct RenderResult
+{
+    bool ok = false;
+    bool noSession = false;
+    QString log;
+    QString dir;
+};
+
+QString lavapipeIcd()
+{
+    const QDir icdDir(QStringLiteral("/usr/share/vulkan/icd.d"));
+    const QStringList icds = icdDir.entryList({QStringLiteral("lvp_icd*.json")}, QDir::Files, QDir::Name);
+    return icds.isEmpty() ? QString() : icdDir.filePath(icds.first());
+}
+
+QString writeGridLayout(const QTemporaryDir& dir)
+{
+    QString zones;
+    for (int row = 0; row < kGridRows; ++row) {
+        for (int col = 0; col < kGridColumns; ++col) {
+            if (!zones.isEmpty())
+                zones += QLatin1Char(',');
+            zones += QStringLiteral(R"({"zoneNumber": %1, "relativeGeometry": )"
+                                    R"({"x": %2, "y": %3, "width": %4, "height": %5}})")
+                         .arg(row * kGridColumns + col + 1)
+                         .arg(static_cast<double>(col) / kGridColumns)
+                         .arg(static_cast<double>(row) / kGridRows)
+                         .arg(1.0 / kGridColumns)
+                         .arg(1.0 / kGridRows);
+        }
+    }
+    const QString path = QDir(dir.path()).filePath(QStringLiteral("grid-10x8.json"));
+    QFile f(path);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qFatal("writeGridLayout: failed to open %s: %s", qPrintable(path), qPrintable(f.errorString()));
+    }
+    f.write(QStringLiteral(R"({"zones": [%1]})").arg(zones).toUtf8());
+    return path;
+}
+
+/// Interior of grid zone @p zoneNumber in pixels, inset so the border and
+/// any glow bleeding from neighbours stay out of the comparison.
+QRect gridZoneInterior(int zoneNumber)
+{
+    const int idx = zoneNumber - 1;
+    const int w = kResolution.width() / kGridColumns;
+    const int h = kResolution.height() / kGridRows;
+    const QRect cell((idx % kGridColumns) * w, (idx / kGridColumns) * h, w, h);
+    return cell.adjusted(w / 4, h / 4, -w / 4, -h / 4);
+}
+
+/// Largest per-channel difference between @p a and @p b inside @p area.
+int maxChannelDiff(const QImage& a, const QImage& b, const QRect& area)
+{
+    const QImage ia = a.convertToFormat(QImage::Format_RGBA8888);
+    const QImage ib = b.convertToFormat(QImage::Format_RGBA8888);
+    int worst = 0;
+    for (int y = area.top(); y <= area.bottom(); ++y) {
+        const uchar* ra = ia.constScanLine(y);
+        const uchar* rb = ib.constScanLine(y);
+        for (int x = area.left() * 4; x < (area.right() + 1) * 4; ++x)
+            worst = std::max(worst, std::abs(ra[x] - rb[x]));
+    }
+    return worst;
+}
+
+/// Fraction of pixels inside @p area where some channel differs by more
+/// than @p tolerance.
+double fractionOver(const QImage& a, const QImage& b, const QRect& area, int tolerance)
+{
+    const QImage ia = a.convertToFormat(QImage::Format_RGBA8888);
+    const QImage ib = b.convertToFormat(QImage::Format_RGBA8888);
+    qint64 over = 0;
+    for (int y = area.top(); y <= area.bottom(); ++y) {
+        const uchar* ra = ia.constScanLine(y);
+        const uchar* rb = ib.constScanLine(y);
+        for (int x = area.left(); x <= area.right(); ++x) {
+            for (int c = 0; c < 4; ++c) {
+                if (std::abs(ra[x * 4 + c] - rb[x * 4 + c]) > tolerance) {
+                    ++over;
+                    break;
+                }
+            }
+        }
+    }
+    return static_cast<double>(over) / (static_cast<qint64>(area.width()) * area.height());
+}
+
+} // namespace
+
+class TestZoneStorage : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        m_icd = lavapipeIcd();
+        if (m_icd.isEmpty())
+            QSKIP("lavapipe ICD not installed (/usr/share/vulkan/icd.d/lvp_icd*.json)");
+        QVERIFY2(QFile::exists(QStringLiteral(SHADER_RENDER_BIN)), SHADER_RENDER_BIN);
+        QVERIFY(m_work.isValid());
+        m_gridLayout = writeGridLayout(m_work);
+
+        const RenderResult probe = render(Backend::VulkanStorage, QStringLiteral(PZ_LAYOUT_DIR "/grid-3x2.json"), 1, 0,
+                                          QStringLiteral("probe"));
+        if (probe.noSession)
+            QSKIP("Vulkan RHI could not initialize in this session");
+        QVERIFY2(probe.ok, qPrintable(probe.log));
+    }
+
+    /// Every frame of the cycling schedule matches between the two zone
+    /// paths. Every slice change rewrites only the zoneParams entries whose
+    /// highlight flag flipped, so each frame after the first goes through
+    /// the dirty-range uploads.
+    void storageMatchesUboPath()
+    {
+        const QString layout = QStringLiteral(PZ_LAYOUT_DIR "/grid-3x2.json");
+        const RenderResult storage = render(Backend::VulkanStorage, layout, 7, 0, QStringLiteral("cycle-storage"));
+        const RenderResult ubo = render(Backend::VulkanUbo, layout, 7, 0, QStringLiteral("cycle-ubo"));
+        QVERIFY2(storage.ok, qPrintable(storage.log));
+        QVERIFY2(ubo.ok, qPrintable(ubo.log));
+
+        for (int i = 0; i < 7; ++i) {
+            const QImage a = frame(storage, i);
+            const QImage b = frame(ubo, i);
+            QVERIFY(!a.isNull() && !b.isNull());
+            QVERIFY2(maxChannelDiff(a, b, a.rect()) <= 1, qPrintable(QStringLiteral("frame %1").arg(i)));
+        }
+    }
+
+    /// The storage path on Vulkan agrees with the UBO path on OpenGL. The two
+    /// backends compile the pack through different bake targets, so this
+    /// allows rounding noise on a small share of pixels.
+    void vulkanStorageMatchesOpenGl()
+    {
+        const QString layout = QStringLiteral(PZ_LAYOUT_DIR "/grid-3x2.json");
+        const RenderResult vulkan = render(Backend::VulkanStorage, layout, 7, 0, QStringLiteral("gl-vulkan"));
+        const RenderResult gl = render(Backend::OpenGl, layout, 7, 0, QStringLiteral("gl-opengl"));
+        QVERIFY2(vulkan.ok, qPrintable(vulkan.log));
+        if (gl.noSession)
+            QSKIP("OpenGL RHI could not initialize in this session");
+        QVERIFY2(gl.ok, qPrintable(gl.log));
+
+        for (int i = 0; i < 7; ++i) {
+            const QImage a = frame(vulkan, i);
+            const QImage b = frame(gl, i);
+            QVERIFY(!a.isNull() && !b.isNull());
+            const double share = fractionOver(a, b, a.rect(), 4);
+            QVERIFY2(share < 0.001, qPrintable(QStringLiteral("frame %1: %2 of pixels differ").arg(i).arg(share)));
+        }
+    }
+
+    void hoverUpdateMatchesFullUpload_data()
+    {
+        QTest::addColumn<int>("backend");
+        QTest::addColumn<bool>("grid");
+        QTest::addColumn<int>("zoneNumber");
+
+        QTest::newRow("storage, 6 zones") << int(Backend::VulkanStorage) << false << 4;
+        QTest::newRow("ubo, 6 zones") << int(Backend::VulkanUbo) << false << 4;
+        QTest::newRow("storage, 80 zones, zone 70") << int(Backend::VulkanStorage) << true << 70;
+    }
+
+    /// Frame K of the cycling schedule highlights zone K after K-1 hover
+    /// moves, each uploaded as dirty ranges. Pinning zone K with
+    /// --still-highlight uploads the same state once, in full. iTime comes
+    /// from the frame index, so the two frames must be identical.
+    void hoverUpdateMatchesFullUpload()
+    {
+        QFETCH(int, backend);
+        QFETCH(bool, grid);
+        QFETCH(int, zoneNumber);
+
+        const QString layout = grid ? m_gridLayout : QStringLiteral(PZ_LAYOUT_DIR "/grid-3x2.json");
+        const int zoneCount = grid ? kGridColumns * kGridRows : 6;
+        const auto mode = static_cast<Backend>(backend);
+        const QString tag = QStringLiteral("hover-%1-%2").arg(backend).arg(zoneNumber);
+
+        // zoneCount + 1 frames puts slice K on frame K.
+        const RenderResult cycled = render(mode, layout, zoneCount + 1, 0, tag + QStringLiteral("-cycle"));
+        const RenderResult pinned = render(mode, layout, zoneNumber + 1, zoneNumber, tag + QStringLiteral("-pin"));
+        QVERIFY2(cycled.ok, qPrintable(cycled.log));
+        QVERIFY2(pinned.ok, qPrintable(pinned.log));
+
+        const QImage a = frame(cycled, zoneNumber);
+        const QImage b = frame(pinned, zoneNumber);
+        QVERIFY(!a.isNull() && !b.isNull());
+        const int diff = maxChannelDiff(a, b, a.rect());
+        QVERIFY2(diff <= 1, qPrintable(QStringLiteral("max channel difference %1").arg(diff)));
+    }
+
+    /// A zone past the UBO path's 64 reaches the shader on the storage
+    /// path: pinning the highlight on zone 70 changes zone 70's pixels.
+    /// Without this, the 80-zone row above would also pass if zones past 64
+    /// were dropped on both sides.
+    void zonePastUboCapTakesHighlight()
+    {
+        const RenderResult on = render(Backend::VulkanStorage, m_gridLayout, 2, 70, QStringLiteral("cap-on"));
+        const RenderResult off = render(Backend::VulkanStorage, m_gridLayout, 2, 1, QStringLiteral("cap-off"));
+        QVERIFY2(on.ok, qPrintable(on.log));
+        QVERIFY2(off.ok, qPrintable(off.log));
+
+        const QImage a = frame(on, 1);
+        const QImage b = frame(off, 1);
+        QVERIFY(!a.isNull() && !b.isNull());
+        QVERIFY(maxChannelDiff(a, b, gridZoneInterior(70)) > 8);
+    }
+
+private:
+    RenderResult render(Backend backend, const QString& layout, int frames, int stillHighlight, const QString& tag)
+    {
+        RenderResult result;
+        result.dir = QDir(m_work.path()).filePath(tag);
+        QDir().mkpath(result.dir);
+
+        QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+        env.remove(QStringLiteral("PHOSPHOR_ZONE_STORAGE"));
+        if (backend == Backend::OpenGl) {
+            env.insert(QStringLiteral("QSG_RHI_BACKEND"), QStringLiteral("opengl"));
+        } else {
+            env.insert(QStringLiteral("QSG_RHI_BACKEND"), QStringLiteral("vulkan"));
+            env.insert(QStringLiteral("VK_ICD_FILENAMES"), m_icd);
+            if (backend == Backend::VulkanUbo)
+                env.insert(QStringLiteral("PHOSPHOR_ZONE_STORAGE"), QStringLiteral("0"));
+        }
+
+        const QStringList args = {
+            QStringLiteral("--shader"),
+            QStringLiteral(PZ_OVERLAY_DIR "/%1/metadata.json").arg(QLatin1String(kPack)),
+            QStringLiteral("--layout"),
+            layout,
+            QStringLiteral("--resolution"),
+            QStringLiteral("%1x%2").arg(kResolution.width()).arg(kResolution.height()),
+            QStringLiteral("--frames"),
+            QString::number(frames),
+            QStringLiteral("--fps"),
+            QString::number(kFps),
+            QStringLiteral("--audio-mode"),
+            QStringLiteral("silent"),
+            QStringLiteral("--still-highlight"),
+            QString::number(stillHighlight),
+            QStringLiteral("--out"),
+            QDir(result.dir).filePath(QStringLiteral("frame.png")),
+        };
+
+        QProcess proc;
+        proc.setProcessEnvironment(env);
+        proc.setProcessChannelMode(QProcess::MergedChannels);
+        proc.start(QStringLiteral(SHADER_RENDER_BIN), args);
+        if (!proc.waitForFinished(300000)) {
+            proc.kill();
+            proc.waitForFinished();
+            result.log = QStringLiteral("%1: timed out").arg(tag);
+            return result;
+        }
+        result.log = QStringLiteral("%1: %2").arg(tag, QString::fromLocal8Bit(proc.readAll()));
+        result.ok = proc.exitStatus() == QProcess::NormalExit && proc.exitCode() == 0;
+        result.noSession = result.log.contains(QLatin1String("initialize() failed"));
+        return result;
+    }
+
+    static QImage frame(const RenderResult& result, int index)
+    {
+        // PngSequenceSink numbers frames from 1, six digits wide.
+        return QImage(
+            QDir(result.dir).filePath(QStringLiteral("frame_%1.png").arg(index + 1, 6, 10, QLatin1Char('0'))));
+    }
+
+    QTemporaryDir m_work;
+    QString m_icd;
+    QString m_gridLayout;
+};
+
+QTEST_GUILESS_MAIN(TestZoneStorage)
+#include "test_zonestorage.moc"